@@ -406,6 +406,7 @@ class MemberAccessExpression : public Expression {
 public:
     ExprPtr object_expr;
     std::string member_name;
+    std::string exact_class_name; // Set by DevirtualizationPass: a method call's receiver is always of this class
 
     MemberAccessExpression(ExprPtr object, std::string member)
         : Expression(NodeType::MemberAccessExpr), object_expr(std::move(object)), member_name(std::move(member)) {}
@@ -534,6 +535,7 @@ class VectorAccess : public Expression {
 public:
     ExprPtr vector_expr;
     ExprPtr index_expr;
+    bool bounds_check_elided = false; // Set by BoundsCheckEliminationPass: index proven in range or checked before the loop
     VectorAccess(ExprPtr vector_expr, ExprPtr index_expr)
         : Expression(NodeType::VectorAccessExpr), vector_expr(std::move(vector_expr)), index_expr(std::move(index_expr)) {}
     void accept(ASTVisitor& visitor) override;
@@ -643,6 +645,7 @@ class VecAllocationExpression : public Expression {
 public:
     ExprPtr size_expr;
     std::string variable_name; // Name of the variable being allocated
+    bool scope_local = false; // Set by RetainAnalysisPass: never escapes its block, use the SAMM region
     VecAllocationExpression(ExprPtr size_expr)
         : Expression(NodeType::VecAllocationExpr), size_expr(std::move(size_expr)), variable_name("") {}
     void accept(ASTVisitor& visitor) override;
@@ -655,6 +658,7 @@ public:
 class StringAllocationExpression : public Expression {
 public:
     ExprPtr size_expr;
+    bool scope_local = false; // Set by RetainAnalysisPass: never escapes its block, use the SAMM region
     StringAllocationExpression(ExprPtr size_expr)
         : Expression(NodeType::StringAllocationExpr), size_expr(std::move(size_expr)) {}
     void accept(ASTVisitor& visitor) override;
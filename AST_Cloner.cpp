@@ -139,7 +139,9 @@ ASTNodePtr UnaryOp::clone() const {
 }
 
 ASTNodePtr VectorAccess::clone() const {
-    return std::make_unique<VectorAccess>(clone_unique_ptr(vector_expr), clone_unique_ptr(index_expr));
+    auto cloned = std::make_unique<VectorAccess>(clone_unique_ptr(vector_expr), clone_unique_ptr(index_expr));
+    cloned->bounds_check_elided = this->bounds_check_elided;
+    return cloned;
 }
 
 ASTNodePtr CharIndirection::clone() const {
@@ -185,7 +187,9 @@ ASTNodePtr FloatValofExpression::clone() const {
 }
 
 ASTNodePtr VecAllocationExpression::clone() const {
-    return std::make_unique<VecAllocationExpression>(clone_unique_ptr(size_expr));
+    auto cloned = std::make_unique<VecAllocationExpression>(clone_unique_ptr(size_expr));
+    cloned->scope_local = this->scope_local;
+    return cloned;
 }
 
 ASTNodePtr FVecAllocationExpression::clone() const {
@@ -201,7 +205,9 @@ ASTNodePtr FPairsAllocationExpression::clone() const {
 }
 
 ASTNodePtr StringAllocationExpression::clone() const {
-    return std::make_unique<StringAllocationExpression>(clone_unique_ptr(size_expr));
+    auto cloned = std::make_unique<StringAllocationExpression>(clone_unique_ptr(size_expr));
+    cloned->scope_local = this->scope_local;
+    return cloned;
 }
 
 ASTNodePtr TableExpression::clone() const {
@@ -217,7 +223,9 @@ ASTNodePtr NewExpression::clone() const {
 }
 
 ASTNodePtr MemberAccessExpression::clone() const {
-    return std::make_unique<MemberAccessExpression>(clone_unique_ptr(object_expr), member_name);
+    auto cloned = std::make_unique<MemberAccessExpression>(clone_unique_ptr(object_expr), member_name);
+    cloned->exact_class_name = this->exact_class_name;
+    return cloned;
 }
 
 ASTNodePtr VecInitializerExpression::clone() const {
@@ -9,6 +9,28 @@
 // Forward declaration for ControlFlowGraph
 class ControlFlowGraph;
 
+// A bounds check hoisted out of a FOR loop into the loop's preheader.
+// The loop reads vector_name!(loop variable + offset) for offsets from
+// min_offset to max_offset on every iteration, so checking the first and
+// last index once before the loop covers every read.
+struct HoistedBoundsCheck {
+    std::string vector_name;
+    int64_t min_offset = 0;
+    int64_t max_offset = 0;
+    bool check_start = true; // False when the start value already keeps the first index >= 0
+};
+
+// A statement of a FOR loop body that LoopVectorizationPass runs two elements
+// at a time: either target!i := value, or target := target + value summed over
+// the loop (a reduction). value is built from target-kind reads v!i, loop
+// invariants and + - (and * / for floats).
+struct VectorizedStatement {
+    std::string target;
+    bool is_reduction = false;
+    bool is_float = false;
+    ExprPtr value;
+};
+
 class BasicBlock {
 public:
     std::string id; // Unique identifier for the basic block (e.g., "BB_0")
@@ -22,6 +44,20 @@ public:
     std::string loop_variable; // Stores the name of the loop variable if applicable
     std::string label_name; // If this block starts with a label, its name
 
+    // Set by BoundsCheckEliminationPass on the preheader of a FOR loop: checks
+    // run after the block's statements, when loop_variable <= hoisted_loop_end.
+    std::vector<HoistedBoundsCheck> hoisted_bounds_checks;
+    std::string hoisted_loop_variable;
+    ExprPtr hoisted_loop_end;
+
+    // Set by LoopVectorizationPass on the preheader of a FOR loop: a NEON loop
+    // runs after the block's statements, advancing loop_variable two elements
+    // at a time while it is below vectorized_loop_end. The scalar loop then
+    // runs the remaining iteration, if any.
+    std::vector<VectorizedStatement> vectorized_statements;
+    std::string vectorized_loop_variable;
+    ExprPtr vectorized_loop_end;
+
     // Constructor
     BasicBlock(std::string id, bool is_entry = false, bool is_exit = false, std::string label_name = "");
 
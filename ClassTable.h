@@ -300,6 +300,28 @@ public:
         return false;
     }
 
+    // The method that every object of class_name or of a descendant runs from
+    // vtable_slot, or "" if some descendant overrides it. The table holds every
+    // class of the program, so a non-empty answer is safe to call directly.
+    std::string unique_method_target(const std::string& class_name, size_t vtable_slot) const {
+        ClassTableEntry* class_entry = get_class(class_name);
+        if (!class_entry || vtable_slot >= class_entry->vtable_blueprint.size()) {
+            return "";
+        }
+        const std::string& target = class_entry->vtable_blueprint[vtable_slot];
+        if (target.empty()) {
+            return "";
+        }
+        for (const auto& pair : entries_) {
+            if (!is_descendant_of(pair.first, class_name)) continue;
+            const auto& blueprint = pair.second->vtable_blueprint;
+            if (vtable_slot >= blueprint.size() || blueprint[vtable_slot] != target) {
+                return "";
+            }
+        }
+        return target;
+    }
+
     const std::unordered_map<std::string, std::unique_ptr<ClassTableEntry>>& entries() const {
         return entries_;
     }
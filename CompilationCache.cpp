@@ -0,0 +1,286 @@
+#include "CompilationCache.h"
+#include "version.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+namespace {
+
+// Bump when the entry layout or the meaning of a serialized field changes.
+constexpr uint32_t CACHE_FORMAT_VERSION = 2;
+constexpr char CACHE_MAGIC[8] = { 'N', 'B', 'C', 'P', 'L', 'J', 'C', '\n' };
+
+std::string compiler_version() {
+    return std::to_string(BCPL_VERSION_MAJOR) + "." + std::to_string(BCPL_VERSION_MINOR) + "." +
+           std::to_string(BCPL_VERSION_PATCH);
+}
+
+// Two independent FNV-1a passes give a 128-bit key.
+uint64_t fnv1a(const std::string& text, uint64_t hash) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::string to_hex(uint64_t value) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+// --- Entry encoding: native byte order, the cache is per machine ---
+
+class Writer {
+public:
+    void u8(uint8_t v) { out_.push_back(static_cast<char>(v)); }
+    void u32(uint32_t v) { out_.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+    void u64(uint64_t v) { out_.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+    void str(const std::string& s) { u32(static_cast<uint32_t>(s.size())); out_.append(s); }
+    void raw(const char* data, size_t size) { out_.append(data, size); }
+    const std::string& data() const { return out_; }
+
+private:
+    std::string out_;
+};
+
+class Reader {
+public:
+    explicit Reader(const std::string& in) : in_(in) {}
+
+    bool u8(uint8_t& v) { return take(&v, sizeof(v)); }
+    bool u32(uint32_t& v) { return take(&v, sizeof(v)); }
+    bool u64(uint64_t& v) { return take(&v, sizeof(v)); }
+    bool str(std::string& s) {
+        uint32_t size;
+        if (!u32(size) || size > in_.size() - pos_) return false;
+        s.assign(in_, pos_, size);
+        pos_ += size;
+        return true;
+    }
+    bool raw(char* data, size_t size) { return take(data, size); }
+    size_t remaining() const { return in_.size() - pos_; }
+
+private:
+    bool take(void* dest, size_t size) {
+        if (size > in_.size() - pos_) return false;
+        std::memcpy(dest, in_.data() + pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    const std::string& in_;
+    size_t pos_ = 0;
+};
+
+// Instruction text and labels repeat a great deal, so each distinct string
+// is written once and instructions refer to it by index.
+class StringPool {
+public:
+    uint32_t index_of(const std::string& s) {
+        auto inserted = indices_.emplace(s, static_cast<uint32_t>(strings_.size()));
+        if (inserted.second) strings_.push_back(&inserted.first->first); // node addresses are stable
+        return inserted.first->second;
+    }
+    const std::vector<const std::string*>& strings() const { return strings_; }
+
+private:
+    std::unordered_map<std::string, uint32_t> indices_;
+    std::vector<const std::string*> strings_;
+};
+
+enum InstructionFlags : uint8_t {
+    FLAG_DATA_VALUE = 1 << 0,
+    FLAG_LABEL_DEFINITION = 1 << 1,
+    FLAG_NOPEEP = 1 << 2,
+    FLAG_DATA_BASE_FIXUP = 1 << 3,
+};
+
+// In JIT mode the code generator loads the data pool base into X28 (the
+// global base register) with a MOVZ/MOVK sequence that carries the pool's
+// address as a plain immediate, with no Linker relocation. The pool is
+// allocated afresh on every run, so those immediates are recorded and
+// re-patched by Entry::set_data_base(). (Veneers, the only other JitAddress
+// loads, carry relocations.)
+bool is_data_base_load(const Instruction& instr) {
+    uint32_t op = instr.encoding & 0x7F800000;
+    return instr.jit_attribute == JITAttribute::JitAddress && instr.relocation == RelocationType::NONE &&
+           (op == 0x52800000 /* MOVZ */ || op == 0x72800000 /* MOVK */) && (instr.encoding & 0x1F) == 28;
+}
+
+uint32_t patch_move_wide(uint32_t encoding, uint64_t value) {
+    uint32_t shift = ((encoding >> 21) & 0x3) * 16;
+    uint32_t imm16 = static_cast<uint32_t>((value >> shift) & 0xFFFF);
+    return (encoding & ~(0xFFFFu << 5)) | (imm16 << 5);
+}
+
+} // namespace
+
+CompilationCache::CompilationCache(const std::string& directory) : directory_(directory) {
+    if (directory_.empty()) {
+        if (const char* env = std::getenv("NEWBCPL_CACHE_DIR")) {
+            directory_ = env;
+        } else if (const char* home = std::getenv("HOME")) {
+            directory_ = std::string(home) + "/.cache/newbcpl";
+        } else {
+            directory_ = ".newbcpl_cache";
+        }
+    }
+}
+
+CompilationCache::Key CompilationCache::make_key(const std::string& source, const std::string& flags) {
+    Key key;
+    key.material = "NewBCPL " + compiler_version() + "\nformat " + std::to_string(CACHE_FORMAT_VERSION) + "\n" +
+                   flags + "\n" + source;
+    key.id = to_hex(fnv1a(key.material, 0xcbf29ce484222325ULL)) + to_hex(fnv1a(key.material, 0x84222325cbf29ce4ULL));
+    return key;
+}
+
+std::string CompilationCache::path_for(const Key& key) const {
+    return directory_ + "/" + key.id + ".jitc";
+}
+
+void CompilationCache::Entry::set_data_base(uint64_t data_base) {
+    for (size_t index : data_base_loads) {
+        instructions[index].encoding = patch_move_wide(instructions[index].encoding, data_base);
+    }
+}
+
+bool CompilationCache::load(const Key& key, Entry& entry) const {
+    std::ifstream file(path_for(key), std::ios::binary);
+    if (!file.is_open()) return false;
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Reader in(contents);
+    char magic[sizeof(CACHE_MAGIC)];
+    uint32_t format = 0;
+    std::string stored_version, stored_material;
+    // The hash in the file name can collide; the material cannot.
+    if (!in.raw(magic, sizeof(magic)) || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+        !in.u32(format) || format != CACHE_FORMAT_VERSION ||
+        !in.str(stored_version) || stored_version != compiler_version() ||
+        !in.str(stored_material) || stored_material != key.material) {
+        return false;
+    }
+
+    uint32_t string_count = 0;
+    if (!in.u32(string_count) || string_count > in.remaining()) return false;
+    std::vector<InternedString> strings(string_count);
+    for (auto& s : strings) {
+        std::string text;
+        if (!in.str(text)) return false;
+        s = InternedString(text);
+    }
+
+    uint32_t veneer_count = 0;
+    if (!in.u32(veneer_count) || veneer_count > in.remaining()) return false;
+    Entry result;
+    for (uint32_t i = 0; i < veneer_count; ++i) {
+        uint32_t function, label;
+        if (!in.u32(function) || !in.u32(label) || function >= string_count || label >= string_count) return false;
+        result.veneer_labels[strings[function]] = strings[label];
+    }
+
+    uint64_t instruction_count = 0;
+    if (!in.u64(instruction_count) || instruction_count > in.remaining()) return false;
+    result.instructions.resize(instruction_count);
+    for (size_t i = 0; i < result.instructions.size(); ++i) {
+        Instruction& instr = result.instructions[i];
+        uint8_t relocation, segment, attribute, flags;
+        uint32_t text, label;
+        if (!in.u32(instr.encoding) || !in.u8(relocation) || !in.u8(segment) || !in.u8(attribute) ||
+            !in.u8(flags) || !in.u32(text) || !in.u32(label) ||
+            relocation > static_cast<uint8_t>(RelocationType::Label) ||
+            segment > static_cast<uint8_t>(SegmentType::DATA) ||
+            attribute > static_cast<uint8_t>(JITAttribute::AddressLoad) ||
+            text >= string_count || label >= string_count) {
+            return false;
+        }
+        instr.relocation = static_cast<RelocationType>(relocation);
+        instr.segment = static_cast<SegmentType>(segment);
+        instr.jit_attribute = static_cast<JITAttribute>(attribute);
+        instr.is_data_value = flags & FLAG_DATA_VALUE;
+        instr.is_label_definition = flags & FLAG_LABEL_DEFINITION;
+        instr.nopeep = flags & FLAG_NOPEEP;
+        instr.assembly_text = strings[text];
+        instr.target_label = strings[label];
+        if (flags & FLAG_DATA_BASE_FIXUP) {
+            result.data_base_loads.push_back(i);
+        }
+    }
+    if (in.remaining() != 0) return false;
+
+    entry = std::move(result);
+    return true;
+}
+
+bool CompilationCache::store(const Key& key, const std::vector<Instruction>& instructions,
+                             const std::unordered_map<std::string, std::string>& veneer_labels) const {
+    StringPool pool;
+    pool.index_of("");
+    std::vector<std::pair<uint32_t, uint32_t>> veneers;
+    veneers.reserve(veneer_labels.size());
+    for (const auto& pair : veneer_labels) {
+        veneers.emplace_back(pool.index_of(pair.first), pool.index_of(pair.second));
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> instruction_strings;
+    instruction_strings.reserve(instructions.size());
+    for (const auto& instr : instructions) {
+        instruction_strings.emplace_back(pool.index_of(instr.assembly_text), pool.index_of(instr.target_label));
+    }
+
+    Writer out;
+    out.raw(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    out.u32(CACHE_FORMAT_VERSION);
+    out.str(compiler_version());
+    out.str(key.material);
+    out.u32(static_cast<uint32_t>(pool.strings().size()));
+    for (const std::string* s : pool.strings()) out.str(*s);
+    out.u32(static_cast<uint32_t>(veneers.size()));
+    for (const auto& veneer : veneers) {
+        out.u32(veneer.first);
+        out.u32(veneer.second);
+    }
+    out.u64(instructions.size());
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        const Instruction& instr = instructions[i];
+        out.u32(instr.encoding);
+        out.u8(static_cast<uint8_t>(instr.relocation));
+        out.u8(static_cast<uint8_t>(instr.segment));
+        out.u8(static_cast<uint8_t>(instr.jit_attribute));
+        out.u8((instr.is_data_value ? FLAG_DATA_VALUE : 0) |
+               (instr.is_label_definition ? FLAG_LABEL_DEFINITION : 0) |
+               (instr.nopeep ? FLAG_NOPEEP : 0) |
+               (is_data_base_load(instr) ? FLAG_DATA_BASE_FIXUP : 0));
+        out.u32(instruction_strings[i].first);
+        out.u32(instruction_strings[i].second);
+    }
+
+    // Write to a private temporary and rename, so concurrent compilers never
+    // see a partial entry.
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    std::string final_path = path_for(key);
+    std::string temp_path = final_path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(out.data().data(), static_cast<std::streamsize>(out.data().size()));
+        if (!file) {
+            file.close();
+            std::remove(temp_path.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temp_path.c_str(), final_path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
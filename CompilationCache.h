@@ -0,0 +1,63 @@
+#ifndef COMPILATION_CACHE_H
+#define COMPILATION_CACHE_H
+
+#include "Encoder.h" // For Instruction struct
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// On-disk cache of compiled programs for --run and --exec.
+//
+// Entries are keyed by a hash of the preprocessed source (so GET'd files are
+// covered), the compiler version, the runtime API version and the flags that
+// change code generation. The hash only names the file: the entry also holds
+// that full key material and a load compares it byte for byte, so two inputs
+// whose hashes collide never share an entry. An entry also holds the program as it leaves the
+// peephole optimizer: the unlinked instruction stream (encodings,
+// relocations, target labels, segments) and the veneer labels. Every address
+// in it is still symbolic, so a hit is linked into this run's code buffer and
+// data pool by the normal Linker, exactly like a fresh compile. The one
+// exception, the JIT data pool base that JIT code loads into X28 as an
+// immediate, is re-patched with Entry::set_data_base().
+class CompilationCache {
+public:
+    struct Entry {
+        std::vector<Instruction> instructions;
+        std::unordered_map<std::string, std::string> veneer_labels; // function name -> veneer label
+        std::vector<size_t> data_base_loads; // MOVZ/MOVKs that load the JIT data pool base
+
+        // Re-points the data pool base loads at this run's pool.
+        void set_data_base(uint64_t data_base);
+    };
+
+    struct Key {
+        std::string id;       // 128-bit hex hash of `material`; names the entry file
+        std::string material; // compiler version, cache format, flags and source
+    };
+
+    // An empty directory selects $NEWBCPL_CACHE_DIR, else $HOME/.cache/newbcpl.
+    explicit CompilationCache(const std::string& directory = "");
+
+    // Returns the key for a preprocessed source compiled with the given flags.
+    // `flags` describes every option that affects the generated code.
+    static Key make_key(const std::string& source, const std::string& flags);
+
+    // Reads the entry for `key`. Returns false on a miss, if the file is
+    // unreadable or truncated, or if it was stored for different key material.
+    bool load(const Key& key, Entry& entry) const;
+
+    // Writes the entry for `key` (atomically, via a rename). Returns false if
+    // the cache directory is not writable; the caller carries on regardless.
+    bool store(const Key& key, const std::vector<Instruction>& instructions,
+               const std::unordered_map<std::string, std::string>& veneer_labels) const;
+
+    const std::string& directory() const { return directory_; }
+
+private:
+    std::string path_for(const Key& key) const;
+
+    std::string directory_;
+};
+
+#endif // COMPILATION_CACHE_H
@@ -31,6 +31,7 @@ void DataGenerator::emit_interned_strings() {
 #include "StringTable.h"
 #include "StringTable.h"
 #include <algorithm>
+#include <iterator>
 #include <iomanip>
 #include "AST.h"
 #include "runtime/ListDataTypes.h" // For ATOM_SENTINEL
@@ -131,7 +132,23 @@ std::string DataGenerator::add_string_literal(const std::string& value) {
     if (!string_table_) {
         throw std::runtime_error("DataGenerator: string_table_ is not set!");
     }
-    std::string label = string_table_->get_or_create_label(value);
+    std::string label;
+    if (!parent_) {
+        label = string_table_->get_or_create_label(value);
+    } else {
+        // Workers only read the shared table; a string it lacks gets a
+        // label of the worker's own.
+        label = string_table_->get_label(value);
+        if (label.empty()) {
+            auto it = string_literal_map_.find(value);
+            if (it != string_literal_map_.end()) {
+                label = it->second;
+            } else {
+                label = literal_label("str", next_string_id_++);
+                string_literal_map_[value] = label;
+            }
+        }
+    }
     // Optionally, still store the UTF-32 version for emission if needed
     std::u32string u32_value = utf8_to_utf32(value);
     u32_value.push_back(U'\0');
@@ -145,7 +162,7 @@ std::string DataGenerator::add_float_literal(double value) {
     if (float_literal_map_.count(value)) {
         return float_literal_map_[value];
     }
-    std::string label = "L_float" + std::to_string(next_float_id_++);
+    std::string label = literal_label("float", next_float_id_++);
     float_literal_map_[value] = label;
     float_literals_.push_back({label, value});
     return label;
@@ -161,7 +178,7 @@ std::string DataGenerator::add_pair_literal(int64_t first_value, int64_t second_
     }
     
     // Generate new label and store the pair literal
-    std::string label = "L_pair" + std::to_string(next_pair_id_++);
+    std::string label = literal_label("pair", next_pair_id_++);
     pair_literal_map_[pair_key] = label;
     pair_literals_.push_back({label, first_value, second_value});
     return label;
@@ -177,7 +194,7 @@ std::string DataGenerator::add_quad_literal(int64_t first_value, int64_t second_
     }
     
     // Generate new label and store the quad literal
-    std::string label = "L_quad" + std::to_string(next_quad_id_++);
+    std::string label = literal_label("quad", next_quad_id_++);
     quad_literal_map_[quad_key] = label;
     quad_literals_.push_back({label, first_value, second_value, third_value, fourth_value});
     return label;
@@ -185,7 +202,7 @@ std::string DataGenerator::add_quad_literal(int64_t first_value, int64_t second_
 
 // Other add methods like add_table_literal...
 std::string DataGenerator::add_table_literal(const std::vector<ExprPtr>& initializers) {
-    std::string label = "L_tbl" + std::to_string(next_table_id_++);
+    std::string label = literal_label("tbl", next_table_id_++);
     std::vector<int64_t> values;
     for (const auto& expr : initializers) {
         if (auto* num_lit = dynamic_cast<NumberLiteral*>(expr.get())) {
@@ -229,7 +246,7 @@ std::string DataGenerator::add_list_literal(const ListExpression* node) {
     ListLiteralInfo list_info;
     list_info.length = node->initializers.size();
 
-    std::string base_label = "L_list" + std::to_string(next_list_id_++);
+    std::string base_label = literal_label("list", next_list_id_++);
     list_info.header_label = base_label + "_header";
 
     std::vector<std::string> node_labels;
@@ -297,7 +314,7 @@ std::string DataGenerator::add_list_literal(const ListExpression* node) {
 
 
 std::string DataGenerator::add_float_table_literal(const std::vector<ExprPtr>& initializers) {
-    std::string label = "L_ftbl" + std::to_string(next_float_table_id_++);
+    std::string label = literal_label("ftbl", next_float_table_id_++);
     std::vector<double> values;
     for (const auto& expr : initializers) {
         if (auto* num_lit = dynamic_cast<NumberLiteral*>(expr.get())) {
@@ -322,7 +339,11 @@ void DataGenerator::generate_rodata_section(InstructionStream& stream) {
         if (emitted_labels.count(info.label)) continue; // Skip duplicates
         emitted_labels.insert(info.label);
         stream.add(Instruction::as_label(info.label, SegmentType::RODATA));
-        stream.add_data64(info.value.length() - 2, "", SegmentType::RODATA);
+        // The length is exact (bit 61, see runtime/string_kernels.h) unless
+        // the literal has a 0 character of its own.
+        uint64_t length = info.value.length() - 2;
+        if (info.value.find(U'\0') == length) length |= uint64_t(1) << 61;
+        stream.add_data64(length, "", SegmentType::RODATA);
         // Add offset label pointing 8 bytes after the main label (skipping length prefix)
         stream.add(Instruction::as_label(info.label + "_plus_8", SegmentType::RODATA));
         for (char32_t ch : info.value) {
@@ -575,16 +596,54 @@ std::string DataGenerator::display_literal_list(const ListLiteralInfo& list_info
 size_t DataGenerator::get_global_word_offset(const std::string& name) const {
     auto it = global_word_offsets_.find(name);
     if (it == global_word_offsets_.end()) {
+        if (parent_) return parent_->get_global_word_offset(name);
         throw std::runtime_error("Global variable '" + name + "' has no calculated offset.");
     }
     return it->second;
 }
 
 bool DataGenerator::is_global_variable(const std::string& name) const {
+    if (parent_ && parent_->is_global_variable(name)) return true;
     return std::any_of(static_variables_.begin(), static_variables_.end(),
                        [&](const auto& var) { return var.label == name; });
 }
 
+std::unique_ptr<DataGenerator> DataGenerator::make_worker() const {
+    auto worker = std::make_unique<DataGenerator>(enable_tracing_, trace_vtables_);
+    worker->string_table_ = string_table_;
+    worker->class_table_ = class_table_;
+    worker->parent_ = this;
+    return worker;
+}
+
+void DataGenerator::set_literal_prefix(const std::string& prefix) {
+    literal_prefix_ = prefix;
+    next_string_id_ = next_float_id_ = next_table_id_ = next_float_table_id_ = 0;
+    next_list_id_ = next_pair_id_ = next_quad_id_ = 0;
+    string_literal_map_.clear();
+    float_literal_map_.clear();
+    pair_literal_map_.clear();
+    quad_literal_map_.clear();
+    list_literal_label_map.clear();
+}
+
+template <typename T>
+static void move_append(std::vector<T>& to, std::vector<T>& from) {
+    to.insert(to.end(), std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+    from.clear();
+}
+
+void DataGenerator::take_literals(DataGenerator& worker) {
+    move_append(string_literals_, worker.string_literals_);
+    move_append(float_literals_, worker.float_literals_);
+    move_append(table_literals_, worker.table_literals_);
+    move_append(float_table_literals_, worker.float_table_literals_);
+    move_append(list_literals_, worker.list_literals_);
+    move_append(pair_literals_, worker.pair_literals_);
+    move_append(quad_literals_, worker.quad_literals_);
+    move_append(static_variables_, worker.static_variables_);
+}
+
 void DataGenerator::generate_data_section(InstructionStream& stream) {
     calculate_global_offsets();
     Instruction label_instr;
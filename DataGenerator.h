@@ -142,10 +142,29 @@ public:
     // Display a single literal list in human-readable form
     std::string display_literal_list(const ListLiteralInfo& list_info) const;
 
+    // --- Per-Function Code Generation (--jobs N) ---
+
+    // A generator for one code generation worker. It shares this generator's
+    // string and class tables and looks globals up here, but collects its
+    // literals itself.
+    std::unique_ptr<DataGenerator> make_worker() const;
+
+    // Starts a worker's next function: literal labels restart under `prefix`
+    // and are not shared with earlier functions, so a function's literals do
+    // not depend on which thread compiled it. Strings already in the string
+    // table keep their labels.
+    void set_literal_prefix(const std::string& prefix);
+
+    // Moves the literals and globals `worker` has collected to the end of
+    // this generator's, leaving the worker's lists empty.
+    void take_literals(DataGenerator& worker);
+
 private:
     StringTable* string_table_ = nullptr;
     SymbolTable* symbol_table_ = nullptr;
     ClassTable* class_table_ = nullptr; // New: ClassTable reference
+    const DataGenerator* parent_ = nullptr; // Set for a worker's generator
+    std::string literal_prefix_;
     bool enable_tracing_;
     bool trace_vtables_ = false;
 
@@ -187,6 +206,9 @@ private:
     std::unordered_map<std::string, size_t> global_word_offsets_;
 
     void add_class_data(ClassDeclaration& node);
+    std::string literal_label(const char* kind, size_t id) const {
+        return "L_" + literal_prefix_ + kind + std::to_string(id);
+    }
 };
 
 #endif // DATA_GENERATOR_H
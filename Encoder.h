@@ -2,6 +2,8 @@
 #define ENCODER_H
 
 #include <sstream>
+#include "InternedString.h"
+#include "Reg.h"
 
 // Add this enum class somewhere visible to the Instruction struct,
 // for example, near the top of Encoder.h.
@@ -60,11 +62,17 @@ enum class RelocationType {
 // Represents a single encoded instruction along with its metadata
 enum class SegmentType { CODE, RODATA, DATA };
 
+// The text and label fields are InternedStrings (one pointer each; a given
+// line of assembly is stored once however often it is emitted) and the
+// scalar fields are ordered to avoid padding. The whole stream is copied by
+// the linker and rewritten by the peephole optimizer, so the record size
+// matters. The record is not a POD, and the encoders still format the
+// assembly text when they encode, not on demand.
 struct Instruction {
   uint32_t encoding = 0;
-  std::string assembly_text;
-  size_t address = 0;
   RelocationType relocation = RelocationType::NONE;
+  InternedString assembly_text;
+  size_t address = 0;
 
   // ** ADD THESE NEW STATIC METHODS **
   static Instruction as_label(const std::string& label_name, SegmentType segment) {
@@ -84,17 +92,16 @@ struct Instruction {
       instr.encoding = 0; // The Linker will patch this with the final address.
       return instr;
   }
-  std::string target_label;
+  InternedString target_label;
   bool is_data_value = false;
   bool is_label_definition = false;
   bool relocation_applied = false;
-  std::string resolved_symbol_name;
+  InternedString resolved_symbol_name;
   size_t resolved_target_address = 0;
-  SegmentType segment = SegmentType::CODE; // Default to CODE
 
   // --- For peephole branch and label patterns ---
-  std::string branch_target;
-  std::string label;
+  InternedString branch_target;
+  InternedString label;
 
   // --- NEW SEMANTIC FIELDS ---
   InstructionDecoder::OpType opcode = InstructionDecoder::OpType::UNKNOWN; // Now fully defined
@@ -104,6 +111,7 @@ struct Instruction {
   int base_reg = -1;
   int ra_reg = -1; // For MADD
 
+  SegmentType segment = SegmentType::CODE; // Default to CODE
   // ✅ ADD THIS NEW FIELD:
   ConditionCode cond = ConditionCode::UNKNOWN; // Stores the condition for CSET, B.cond, etc.
   int64_t immediate = 0;
@@ -145,6 +153,11 @@ JITAttribute jit_attribute = JITAttribute::None;
 
 class Encoder {
 public:
+  // The hottest encoders (ADD/SUB/MOV/CMP register and immediate forms,
+  // LDR/STR immediate) also take typed Reg operands. Their string overloads
+  // parse the names once with Reg::parse() and forward to the typed form.
+  // Code generated from the register allocator still goes through the
+  // string overloads; see Reg.h.
  
     
 
@@ -248,6 +261,8 @@ public:
   static Instruction create_str_imm(const std::string &xt,
                                     const std::string &xn, int immediate,
                                     const std::string &variable_name = "");
+  static Instruction create_str_imm(Reg xt, Reg xn, int immediate,
+                                    const std::string &variable_name = "");
 
   /**
    * @brief Creates an LDR (Load Register) instruction. Loads one 64-bit
@@ -256,6 +271,8 @@ public:
   static Instruction create_ldr_imm(const std::string &xt,
                                     const std::string &xn, int immediate,
                                     const std::string &variable_name = "");
+  static Instruction create_ldr_imm(Reg xt, Reg xn, int immediate,
+                                    const std::string &variable_name = "");
 
   /**
    * @brief Creates an LDRB (Load Register Byte) instruction. Loads one byte
@@ -268,6 +285,17 @@ public:
   static Instruction create_ldrb_imm(const std::string &xt,
                                      const std::string &xn, int immediate);
 
+  /**
+   * @brief Creates an STRB (Store Register Byte) instruction. Stores the low
+   * byte of a register.
+   * @param wt The source register.
+   * @param xn The base address register.
+   * @param immediate An unsigned 12-bit immediate byte offset [0, 4095].
+   * @return A complete Instruction object.
+   */
+  static Instruction create_strb_imm(const std::string &wt,
+                                     const std::string &xn, int immediate);
+
   /**
    * @brief Creates an STR (Store Floating-Point Register) instruction. Stores one 64-bit floating-point register.
    * @param dt The destination floating-point register (must be D register).
@@ -328,6 +356,98 @@ public:
                                                  const std::string &xm,
                                                  int shift);
 
+  /**
+   * @brief Creates an STR (Store Register) instruction with scaled register
+   * offset. ([Xn + (Xm << shift)] = Xt)
+   * @param xt The 64-bit source register.
+   * @param xn The base address register.
+   * @param xm The index register.
+   * @param shift The left shift amount (0 or 3).
+   * @return A complete Instruction object.
+   */
+  static Instruction create_str_scaled_reg_64bit(const std::string &xt,
+                                                 const std::string &xn,
+                                                 const std::string &xm,
+                                                 int shift);
+
+  /**
+   * @brief Creates a 32-bit LDR with scaled register offset.
+   * (Wt = [Xn + (Xm << shift)])
+   * @param wt The destination register (an X name loads into its W view).
+   * @param xn The base address register.
+   * @param xm The index register.
+   * @param shift The left shift amount (0 or 2).
+   * @return A complete Instruction object.
+   */
+  static Instruction create_ldr_word_scaled_reg(const std::string &wt,
+                                                const std::string &xn,
+                                                const std::string &xm,
+                                                int shift);
+
+  /**
+   * @brief Creates a 32-bit STR with scaled register offset.
+   * ([Xn + (Xm << shift)] = Wt)
+   * @param wt The source register (an X name stores its W view).
+   * @param xn The base address register.
+   * @param xm The index register.
+   * @param shift The left shift amount (0 or 2).
+   * @return A complete Instruction object.
+   */
+  static Instruction create_str_word_scaled_reg(const std::string &wt,
+                                                const std::string &xn,
+                                                const std::string &xm,
+                                                int shift);
+
+  /**
+   * @brief Creates an LDR of a D register with scaled register offset.
+   * (Dt = [Xn + (Xm << shift)])
+   * @param dt The destination floating-point register.
+   * @param xn The base address register.
+   * @param xm The index register.
+   * @param shift The left shift amount (0 or 3).
+   * @return A complete Instruction object.
+   */
+  static Instruction create_ldr_fp_scaled_reg(const std::string &dt,
+                                              const std::string &xn,
+                                              const std::string &xm,
+                                              int shift);
+
+  /**
+   * @brief Creates an STR of a D register with scaled register offset.
+   * ([Xn + (Xm << shift)] = Dt)
+   * @param dt The source floating-point register.
+   * @param xn The base address register.
+   * @param xm The index register.
+   * @param shift The left shift amount (0 or 3).
+   * @return A complete Instruction object.
+   */
+  static Instruction create_str_fp_scaled_reg(const std::string &dt,
+                                              const std::string &xn,
+                                              const std::string &xm,
+                                              int shift);
+
+  /**
+   * @brief Creates an LDRB with register offset. (Wt = byte [Xn + Xm])
+   * @param wt The destination register (an X name loads into its W view).
+   * @param xn The base address register.
+   * @param xm The index register.
+   * @return A complete Instruction object.
+   */
+  static Instruction create_ldrb_reg(const std::string &wt,
+                                     const std::string &xn,
+                                     const std::string &xm);
+
+  /**
+   * @brief Creates an STRB with register offset. (byte [Xn + Xm] = Wt)
+   * @param wt The source register (an X name stores its low byte).
+   * @param xn The base address register.
+   * @param xm The index register.
+   * @return A complete Instruction object.
+   */
+  static Instruction create_strb_reg(const std::string &wt,
+                                     const std::string &xn,
+                                     const std::string &xm);
+
   // --- Data Processing Instructions ---
 
   /**
@@ -340,6 +460,7 @@ public:
   static Instruction create_add_reg(const std::string &xd,
                                     const std::string &xn,
                                     const std::string &xm);
+  static Instruction create_add_reg(Reg xd, Reg xn, Reg xm);
 
   /**
    * @brief Creates a SUB instruction with a register operand. (Xd = Xn - Xm)
@@ -351,6 +472,7 @@ public:
   static Instruction create_sub_reg(const std::string &xd,
                                     const std::string &xn,
                                     const std::string &xm);
+  static Instruction create_sub_reg(Reg xd, Reg xn, Reg xm);
 
   /**
    * @brief Creates a MUL instruction. (Xd = Xn * Xm)
@@ -381,12 +503,14 @@ public:
    */
   static Instruction create_add_imm(const std::string &xd,
                                     const std::string &xn, int immediate);
+  static Instruction create_add_imm(Reg xd, Reg xn, int immediate);
 
   /**
    * @return A complete Instruction object.
    */
   static Instruction create_sub_imm(const std::string &xd,
                                     const std::string &xn, int immediate);
+  static Instruction create_sub_imm(Reg xd, Reg xn, int immediate);
 
   /**
    * @brief Creates an AND instruction with a register operand. (Xd = Xn & Xm)
@@ -431,6 +555,7 @@ public:
    */
   static Instruction create_mov_reg(const std::string &xd,
                                     const std::string &xs);
+  static Instruction create_mov_reg(Reg xd, Reg xs);
 
   // MOV with comment
   static Instruction create_mov_reg_comment(const std::string &xd,
@@ -536,6 +661,7 @@ public:
    */
   static Instruction create_cmp_reg(const std::string &xn,
                                     const std::string &xm);
+  static Instruction create_cmp_reg(Reg xn, Reg xm);
 
   // FSQRT (Floating-point Square Root) instruction for D registers
   static Instruction create_fsqrt_reg(const std::string& dd, const std::string& dn);
@@ -595,6 +721,7 @@ public:
    * @return A complete Instruction object.
    */
   static Instruction create_cmp_imm(const std::string &xn, int immediate);
+  static Instruction create_cmp_imm(Reg xn, int immediate);
 
   /**
    * @brief Creates an LSL (Logical Shift Left) instruction. (Xd = Xn << Xm)
@@ -1210,6 +1337,9 @@ private:
 
   // Helper function to get the integer encoding of a register name
   static uint32_t get_reg_encoding(const std::string &reg);
+  static uint32_t get_reg_encoding(Reg reg) { return reg.number(); }
+  // Throws std::invalid_argument unless reg is a W/X register (or an alias)
+  static void require_gpr(Reg reg, const char *encoder_name);
   static uint32_t get_cond_encoding(const std::string &cond);
 };
 
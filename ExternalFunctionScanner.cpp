@@ -180,8 +180,8 @@ void ExternalFunctionScanner::visit(ConditionalExpression& node) {
 }
 
 void ExternalFunctionScanner::visit(VecAllocationExpression& node) {
-    // Vector allocation requires GETVEC runtime function
-    external_functions_.insert("GETVEC");
+    // Vector allocation requires GETVEC (or its scope-local variant)
+    external_functions_.insert(node.scope_local ? "GETVEC_SCOPED" : "GETVEC");
     if (node.size_expr) node.size_expr->accept(*this);
 }
 
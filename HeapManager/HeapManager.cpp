@@ -7,11 +7,12 @@
 #include <cstdlib> // For std::abort, posix_memalign
 #include <cstring> // For memset
 #include <chrono>  // For cleanup timing
+#include <algorithm> // For std::find
 #include "../runtime/ListDataTypes.h" // For ListHeader and ListAtom
 
 // Forward declarations for freelist functions
 extern "C" {
-    void returnNodeToFreelist(ListAtom* node);
+    void returnNodeListToFreelist(ListAtom* head);
     void returnHeaderToFreelist(ListHeader* header);
     void embedded_fast_bcpl_free_chars(void* ptr);
 }
@@ -43,6 +44,7 @@ HeapManager::HeapManager()
     
     // SAMM: Initialize scope stack with global scope
     scope_allocations_.push_back({});
+    scope_region_marks_.push_back(0);
 }
 
 // Destructor - ensures proper SAMM shutdown
@@ -162,13 +164,8 @@ void HeapManager::cleanupPointersImmediate(const std::vector<void*>& ptrs) {
                 
                 ListHeader* header = (ListHeader*)ptr;
                 
-                // Walk through all ListAtoms and return them to freelist
-                ListAtom* atom = header->head;
-                while (atom) {
-                    ListAtom* next = atom->next;
-                    returnNodeToFreelist(atom);
-                    atom = next;
-                }
+                // Return the whole ListAtom chain to the freelist in one batch
+                returnNodeListToFreelist(header->head);
                 
                 // Return the header to freelist
                 returnHeaderToFreelist(header);
@@ -182,13 +179,22 @@ void HeapManager::cleanupPointersImmediate(const std::vector<void*>& ptrs) {
                 // Call our embedded string pool free function
                 embedded_fast_bcpl_free_chars(ptr);
                 
+            } else if (SlabArena::getInstance().owns(ptr)) {
+                // An arena block without the SAMM bit was freed explicitly
+                // after it was tracked (and may already belong to a newer
+                // allocation), or was listed twice and is already released.
+                if (SlabArena::getInstance().clearSammOwned(ptr)) {
+                    free(ptr);
+                }
             } else {
                 // Call the standard free function for HeapManager allocations
                 free(ptr);
             }
             
-            // Mark as freed in SAMM to prevent future double-free
-            {
+            // Mark as freed in SAMM to prevent future double-free.
+            // Arena blocks carry their own free state and are reused quickly,
+            // so remembering their addresses here would hide later frees.
+            if (!SlabArena::getInstance().owns(ptr)) {
                 std::lock_guard<std::mutex> lock(scope_mutex_);
                 samm_freed_pointers_.insert(ptr);
             }
@@ -259,6 +265,87 @@ void* HeapManager::internalAlloc(size_t size, AllocType type) {
     return ptr;
 }
 
+// Allocate the raw block for a VEC/STRING/OBJECT. Small sizes come from the
+// slab arena (no lock, no map insert); everything else uses posix_memalign.
+void* HeapManager::allocBlock(size_t size, AllocType type, bool& from_arena) {
+    from_arena = false;
+    if (slab_arena_enabled_.load(std::memory_order_relaxed) && SlabArena::handlesSize(size)) {
+        void* block = SlabArena::getInstance().allocate(size, type);
+        if (block != nullptr) {
+            from_arena = true;
+            return block;
+        }
+    }
+
+    void* ptr = nullptr;
+    const size_t HEAP_ALIGNMENT = 16;
+    if (posix_memalign(&ptr, HEAP_ALIGNMENT, size) != 0) {
+        return nullptr;
+    }
+    return ptr;
+}
+
+// Record a new block in heap_blocks_ and the signal-safe shadow array.
+// Arena blocks skip the map (and the mutex) unless debug tracking is on.
+void HeapManager::recordBlock(void* base, AllocType type, size_t size, bool from_arena) {
+    bool track = !from_arena || heap_block_tracking_.load(std::memory_order_relaxed);
+    if (!track && !traceEnabled) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(heap_mutex_);
+    if (track) {
+        trackBlockLocked(base, type, size);
+    }
+    // Conditionally update the signal-safe shadow array if tracing is enabled
+    if (traceEnabled) {
+        g_shadow_heap_blocks[g_shadow_heap_index].type = type;
+        g_shadow_heap_blocks[g_shadow_heap_index].address = base;
+        g_shadow_heap_blocks[g_shadow_heap_index].size = size;
+        g_shadow_heap_blocks[g_shadow_heap_index].function_name = nullptr;
+        g_shadow_heap_blocks[g_shadow_heap_index].variable_name = nullptr;
+        g_shadow_heap_index = (g_shadow_heap_index + 1) % MAX_HEAP_BLOCKS;
+    }
+}
+
+void HeapManager::trackBlockLocked(void* base, AllocType type, size_t size) {
+    auto it = heap_blocks_.find(base);
+    if (it == heap_blocks_.end()) {
+        heap_blocks_.emplace(base, HeapBlock{type, base, size, nullptr, nullptr});
+        return;
+    }
+    // Address reused after a free: the new block replaces the tombstone
+    if (it->second.type == ALLOC_FREE && freed_tombstones_ > 0) {
+        freed_tombstones_--;
+    }
+    it->second = HeapBlock{type, base, size, nullptr, nullptr};
+}
+
+// Drop every ALLOC_FREE tombstone. Double frees of those blocks are then
+// reported as invalid pointers (or caught by the Bloom filter if enabled).
+// Caller must hold heap_mutex_.
+void HeapManager::sweepFreedTombstones() {
+    for (auto it = heap_blocks_.begin(); it != heap_blocks_.end();) {
+        if (it->second.type == ALLOC_FREE) {
+            it = heap_blocks_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    freed_tombstones_ = 0;
+}
+
+void HeapManager::setBloomFilterEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(heap_mutex_);
+    if (enabled && !recently_freed_addresses_) {
+        recently_freed_addresses_.reset(new BloomFilter<96000000, 10>());
+        bloom_filter_items_added_ = 0;
+    } else if (!enabled) {
+        recently_freed_addresses_.reset();
+        bloom_filter_items_added_ = 0;
+    }
+}
+
 // SAMM: Enable/disable SAMM
 void HeapManager::setSAMMEnabled(bool enabled) {
     if (enabled && !samm_enabled_.load()) {
@@ -310,6 +397,7 @@ void HeapManager::enterScope() {
     
     std::lock_guard<std::mutex> lock(scope_mutex_);
     scope_allocations_.push_back({});
+    scope_region_marks_.push_back(ScopeRegion::getInstance().mark());
     samm_scopes_entered_.fetch_add(1);
     
     if (traceEnabled) {
@@ -331,6 +419,17 @@ void HeapManager::exitScope() {
             to_cleanup = std::move(scope_allocations_.back());
             scope_allocations_.pop_back();
             samm_scopes_exited_.fetch_add(1);
+
+            // Scope-local allocations are released in one step
+            if (!scope_region_marks_.empty()) {
+                size_t mark = scope_region_marks_.back();
+                scope_region_marks_.pop_back();
+                ScopeRegion& region = ScopeRegion::getInstance();
+                if (region.mark() != mark) {
+                    region.resetTo(mark);
+                    samm_region_resets_.fetch_add(1);
+                }
+            }
             
             if (traceEnabled) {
                 printf("SAMM: Scope exit - found %zu objects to cleanup (remaining depth: %zu)\n", 
@@ -372,6 +471,15 @@ void HeapManager::retainPointer(void* ptr, int parent_scope_offset) {
     if (!samm_enabled_.load() || ptr == nullptr) {
         return;
     }
+
+    // Region storage dies with its scope and cannot be handed to a parent.
+    // RetainAnalysisPass never places RETAINed variables there.
+    if (ScopeRegion::getInstance().owns(ptr)) {
+        if (traceEnabled) {
+            printf("SAMM: Cannot retain scope-local pointer %p\n", ptr);
+        }
+        return;
+    }
     
     std::lock_guard<std::mutex> lock(scope_mutex_);
     if (scope_allocations_.size() > static_cast<size_t>(parent_scope_offset)) {
@@ -426,6 +534,7 @@ void HeapManager::trackInCurrentScope(void* ptr) {
     
     if (!scope_allocations_.empty()) {
         scope_allocations_.back().push_back(ptr);
+        SlabArena::getInstance().setSammOwned(ptr);
         if (traceEnabled) {
             printf("SAMM: Tracked custom allocation %p in scope (depth: %zu, scope size: %zu)\n", 
                    ptr, scope_allocations_.size(), scope_allocations_.back().size());
@@ -517,6 +626,8 @@ void HeapManager::shutdown() {
             std::lock_guard<std::mutex> lock(scope_mutex_);
             remaining_scopes_to_clean = std::move(scope_allocations_);
             scope_allocations_.clear();
+            scope_region_marks_.clear();
+            ScopeRegion::getInstance().resetTo(0);
         }
 
         // Now, perform the cleanup on the local copy *without* holding the lock.
@@ -544,7 +655,10 @@ HeapManager::SAMMStats HeapManager::getSAMMStats() const {
         samm_cleanup_batches_processed_.load(),
         cleanup_queue_.size(),
         cleanup_worker_.joinable() && running_.load(),
-        scope_allocations_.size()
+        scope_allocations_.size(),
+        samm_region_allocations_.load(),
+        samm_region_resets_.load(),
+        ScopeRegion::getInstance().getBytesInUse()
     };
 }
 
@@ -581,6 +695,50 @@ void* HeapManager::allocListRetained(int parent_scope_offset) {
     return ptr;
 }
 
+// SAMM: Scope-local allocation. Only valid inside a scope that will be
+// exited; the global scope never resets, so it keeps using the tracked heap.
+void* HeapManager::allocRegionBlock(size_t size) {
+    if (!samm_enabled_.load()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(scope_mutex_);
+    if (scope_allocations_.size() <= 1) {
+        return nullptr;
+    }
+    void* ptr = ScopeRegion::getInstance().allocate(size);
+    if (ptr != nullptr) {
+        samm_region_allocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ptr;
+}
+
+void* HeapManager::allocVecScoped(size_t numElements) {
+    size_t totalSize = sizeof(uint64_t) + numElements * sizeof(uint64_t);
+    uint64_t* vec = static_cast<uint64_t*>(allocRegionBlock(totalSize));
+    if (vec == nullptr) {
+        return allocVec(numElements);
+    }
+    vec[0] = numElements; // Store length
+
+    traceLog("Allocated scope-local vector: Address=%p, Elements=%zu\n", vec, numElements);
+    return static_cast<void*>(vec + 1);
+}
+
+void* HeapManager::allocStringScoped(size_t numChars) {
+    size_t totalSize = sizeof(uint64_t) + (numChars + 1) * sizeof(uint32_t);
+    uint64_t* str = static_cast<uint64_t*>(allocRegionBlock(totalSize));
+    if (str == nullptr) {
+        return allocString(numChars);
+    }
+    str[0] = numChars; // Store length
+    uint32_t* payload = reinterpret_cast<uint32_t*>(str + 1);
+    payload[numChars] = 0; // Null terminator
+
+    traceLog("Allocated scope-local string: Address=%p, Characters=%zu\n", str, numChars);
+    return static_cast<void*>(payload);
+}
+
 
 
 
@@ -609,6 +767,9 @@ static size_t get_object_size_from_class(void* class_ptr) {
 
 void HeapManager::setTraceEnabled(bool enabled) {
     traceEnabled = enabled;
+    if (enabled) {
+        heap_block_tracking_.store(true); // Heap dumps need every block in heap_blocks_
+    }
     g_is_heap_tracing_enabled = enabled; // Update global flag for signal handler
 }
 
@@ -21,10 +21,13 @@
 #include <condition_variable>
 #include <atomic>
 #include <unordered_set>
+#include <memory>
 
 // Include heap manager definitions
 #include "heap_manager_defs.h"
 #include "BloomFilter.h"
+#include "SlabArena.h"
+#include "ScopeRegion.h"
 
 // Global heap trace flag (set early in main.cpp)
 extern bool g_enable_heap_trace;
@@ -43,16 +46,34 @@ void OBJECT_HEAP_FREE(void* object_ptr);
 class HeapManager {
 public:
     // The new scalable tracking map. It maps a block's base address to its metadata.
+    // Freed blocks stay behind as ALLOC_FREE tombstones: the type field is the
+    // block's state tag, so free() detects a double free with the same lookup
+    // it needs for a valid free - one compare, no hashing of freed addresses.
     std::unordered_map<void*, HeapBlock> heap_blocks_;
+
+    // Tombstones currently in heap_blocks_. Swept once they outnumber both
+    // FREED_TOMBSTONE_LIMIT and the live blocks, keeping the sweep amortised O(1).
+    size_t freed_tombstones_ = 0;
+    static constexpr size_t FREED_TOMBSTONE_LIMIT = 65536;
+    // Records in heap_blocks_ that are not tombstones. Caller must hold heap_mutex_.
+    size_t liveBlockCountLocked() const { return heap_blocks_.size() - freed_tombstones_; }
     
-    // Fixed 12MB Bloom filter for efficient double-free detection
-    // Can track ~10M freed addresses with <0.1% false positive rate
-    // 96M bits (12MB), 10 hash functions - no scaling needed
-    BloomFilter<96000000, 10> recently_freed_addresses_;
+    // Opt-in diagnostic: fixed 12MB Bloom filter of freed addresses
+    // (96M bits, 10 hash functions, ~10M addresses). Only consulted for
+    // pointers that are neither live nor tombstoned, i.e. double frees older
+    // than the last tombstone sweep. Null - nothing committed - unless
+    // setBloomFilterEnabled(true) was called.
+    std::unique_ptr<BloomFilter<96000000, 10>> recently_freed_addresses_;
     
     // Counter to track approximate number of items added to Bloom filter
     size_t bloom_filter_items_added_;
 
+    // Small VEC/STRING/OBJECT blocks come from the size-class SlabArena.
+    // Arena blocks are found by address masking, so they are only recorded
+    // in heap_blocks_ when heap_block_tracking_ (debug mode) is on.
+    std::atomic<bool> slab_arena_enabled_{true};
+    std::atomic<bool> heap_block_tracking_{false};
+
     // A mutex to make heap operations thread-safe.
     // 'mutable' allows const methods like dumpHeap() to lock it.
     mutable std::mutex heap_mutex_;
@@ -68,6 +89,10 @@ public:
     
     // SAMM: Scope vector for tracking allocations per lexical scope
     std::vector<std::vector<void*>> scope_allocations_;
+
+    // SAMM: ScopeRegion mark taken on entry to each scope (parallel to
+    // scope_allocations_). exitScope resets the region to the popped mark.
+    std::vector<size_t> scope_region_marks_;
     
     // SAMM: Track which pointers are ListHeaders from freelist (not individual atoms)
     std::unordered_set<void*> freelist_pointers_;
@@ -90,6 +115,8 @@ public:
     std::atomic<uint64_t> samm_scopes_exited_{0};
     std::atomic<uint64_t> samm_objects_cleaned_{0};
     std::atomic<uint64_t> samm_cleanup_batches_processed_{0};
+    std::atomic<uint64_t> samm_region_allocations_{0};
+    std::atomic<uint64_t> samm_region_resets_{0};
 
 private:
     // Internal state for metrics
@@ -128,6 +155,16 @@ private:
     void cleanupPointersImmediate(const std::vector<void*>& ptrs);
     void* internalAlloc(size_t size, AllocType type);
 
+    // Block allocation shared by allocVec/allocString/allocObject.
+    // Returns the block base; from_arena reports which allocator served it.
+    void* allocBlock(size_t size, AllocType type, bool& from_arena);
+    void recordBlock(void* base, AllocType type, size_t size, bool from_arena);
+    void freeArenaBlock(void* payload);
+    void sweepFreedTombstones();
+
+    // Bump-allocates a scope-local block; nullptr means use the tracked heap.
+    void* allocRegionBlock(size_t size);
+
 public:
     // Destructor - ensures proper SAMM shutdown
     ~HeapManager();
@@ -150,6 +187,28 @@ public:
     // Deallocation function
     void free(void* payload);
 
+    // Insert or replace the heap_blocks_ record for base, reviving a
+    // tombstone left by an earlier free of the same address.
+    // Caller must hold heap_mutex_.
+    void trackBlockLocked(void* base, AllocType type, size_t size);
+
+    // Drops every SAMM scope entry naming a block by its base or payload
+    // address, or points them at `replacement` when the block has moved.
+    // Returns false if no open scope listed the block.
+    bool forgetScopeEntries(void* base, void* payload, void* replacement = nullptr);
+
+    // Slab arena control (enabled by default)
+    void setSlabArenaEnabled(bool enabled) { slab_arena_enabled_.store(enabled); }
+    bool isSlabArenaEnabled() const { return slab_arena_enabled_.load(); }
+
+    // Debug mode: track arena blocks in heap_blocks_ as well (for dumpHeap)
+    void setHeapBlockTrackingEnabled(bool enabled) { heap_block_tracking_.store(enabled); }
+    bool isHeapBlockTrackingEnabled() const { return heap_block_tracking_.load(); }
+
+    // Opt-in Bloom filter diagnostics (off by default; enabling commits 12MB)
+    void setBloomFilterEnabled(bool enabled);
+    bool isBloomFilterEnabled() const { return recently_freed_addresses_ != nullptr; }
+
     // Debugging and metrics
     void dumpHeap() const;
     void dumpHeapSignalSafe(); // Must be truly signal-safe
@@ -167,15 +226,26 @@ public:
     // Getter for Bloom filter statistics
     size_t getBloomFilterFalsePositives() const { return totalBloomFilterFalsePositives; }
     size_t getBloomFilterItemsAdded() const { return bloom_filter_items_added_; }
-    size_t getBloomFilterMemoryUsage() const { return recently_freed_addresses_.memory_usage(); }
+    size_t getBloomFilterMemoryUsage() const {
+        return recently_freed_addresses_ ? recently_freed_addresses_->memory_usage() : 0;
+    }
     double getBloomFilterFalsePositiveRate() const { 
-        return recently_freed_addresses_.estimate_false_positive_rate(bloom_filter_items_added_); 
+        return recently_freed_addresses_
+            ? recently_freed_addresses_->estimate_false_positive_rate(bloom_filter_items_added_)
+            : 0.0;
     }
     
     // Fixed bloom filter specific getters  
     const char* getBloomFilterTier() const { return "10M-Fixed"; }
     size_t getBloomFilterResetCount() const { return 0; } // No resets with fixed filter
     size_t getBloomFilterCapacity() const { return 10000000; } // 10M capacity
+    size_t getFreedTombstoneCount() const { return freed_tombstones_; }
+    // Live blocks recorded in heap_blocks_. Slab arena blocks are only
+    // recorded while heap block tracking is on.
+    size_t getLiveBlockCount() const {
+        std::lock_guard<std::mutex> lock(heap_mutex_);
+        return liveBlockCountLocked();
+    }
 
     // Cleanup timing getters
     double getTotalCleanupTimeMs() const { return totalCleanupTimeMs; }
@@ -214,6 +284,9 @@ public:
         size_t current_queue_depth;
         bool background_worker_running;
         size_t current_scope_depth;
+        uint64_t region_allocations;
+        uint64_t region_resets;
+        size_t region_bytes_in_use;
     };
     SAMMStats getSAMMStats() const;
     
@@ -222,6 +295,12 @@ public:
     void* allocVecRetained(size_t numElements, int parent_scope_offset = 1);
     void* allocStringRetained(size_t numChars, int parent_scope_offset = 1);
     void* allocListRetained(int parent_scope_offset = 1);
+
+    // SAMM: scope-local variants for allocations RetainAnalysisPass proved
+    // never escape their block. Served from ScopeRegion and released in bulk
+    // by exitScope; fall back to allocVec/allocString when SAMM is off.
+    void* allocVecScoped(size_t numElements);
+    void* allocStringScoped(size_t numChars);
 };
 
 #endif // HEAP_MANAGER_H
\ No newline at end of file
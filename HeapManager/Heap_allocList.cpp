@@ -17,7 +17,7 @@ void* HeapManager::allocList() {
     // Track this allocation in the HeapManager's map (thread-safe)
     {
         std::lock_guard<std::mutex> lock(heap_mutex_);
-        heap_blocks_.emplace(header, HeapBlock{ALLOC_LIST, header, sizeof(ListHeader), nullptr, nullptr});
+        trackBlockLocked(header, ALLOC_LIST, sizeof(ListHeader));
         // Conditionally update the signal-safe shadow array if tracing is enabled
         if (traceEnabled) {
             g_shadow_heap_blocks[g_shadow_heap_index].type = ALLOC_LIST;
@@ -19,34 +19,25 @@ void BCPL_SET_ERROR(int code, const char* message, const char* context);
 #endif
 
 void* HeapManager::allocObject(size_t size) {
-    const size_t HEAP_ALIGNMENT = 16;
-    void* ptr;
-    if (posix_memalign(&ptr, HEAP_ALIGNMENT, size) != 0) {
+    bool from_arena = false;
+    void* ptr = allocBlock(size, ALLOC_OBJECT, from_arena);
+    if (ptr == nullptr) {
         BCPL_SET_ERROR(ERROR_OUT_OF_MEMORY, "allocObject", "System posix_memalign failed");
         safe_print("Error: Object allocation failed\n");
         return nullptr;
     }
     memset(ptr, 0, size);
-    {
-        // Lock the mutex for thread safety
-        std::lock_guard<std::mutex> lock(heap_mutex_);
-        heap_blocks_.emplace(ptr, HeapBlock{ALLOC_OBJECT, ptr, size, nullptr, nullptr});
-        // Conditionally update the signal-safe shadow array if tracing is enabled
-        if (traceEnabled) {
-            g_shadow_heap_blocks[g_shadow_heap_index].type = ALLOC_OBJECT;
-            g_shadow_heap_blocks[g_shadow_heap_index].address = ptr;
-            g_shadow_heap_blocks[g_shadow_heap_index].size = size;
-            g_shadow_heap_blocks[g_shadow_heap_index].function_name = nullptr;
-            g_shadow_heap_blocks[g_shadow_heap_index].variable_name = nullptr;
-            g_shadow_heap_index = (g_shadow_heap_index + 1) % MAX_HEAP_BLOCKS;
-        }
-    }
+    size_t accountedSize = from_arena ? SlabArena::classSizeFor(size) : size;
+
+    // Track allocation (arena blocks only in debug tracking mode)
+    recordBlock(ptr, ALLOC_OBJECT, accountedSize, from_arena);
 
     // SAMM: Track allocation in current scope if enabled
     if (samm_enabled_.load() && ptr != nullptr) {
         std::lock_guard<std::mutex> lock(scope_mutex_);
         if (!scope_allocations_.empty()) {
             scope_allocations_.back().push_back(ptr);
+            if (from_arena) SlabArena::getInstance().setSammOwned(ptr);
             if (traceEnabled) {
                 printf("SAMM: Tracked allocation %p in scope (depth: %zu, scope size: %zu)\n", 
                        ptr, scope_allocations_.size(), scope_allocations_.back().size());
@@ -78,7 +69,7 @@ void* HeapManager::allocObject(size_t size) {
     }
 
     traceLog("Allocated object: Address=%p, Size=%zu\n", ptr, size);
-    totalBytesAllocated += size;
+    totalBytesAllocated += accountedSize;
     totalObjectsAllocated++;
     
     // Check if this is a ListAtom allocation
@@ -89,6 +80,6 @@ void* HeapManager::allocObject(size_t size) {
         }
     }
     
-    update_alloc_metrics(size, ALLOC_OBJECT);
+    update_alloc_metrics(accountedSize, ALLOC_OBJECT);
     return ptr;
 }
\ No newline at end of file
@@ -20,13 +20,16 @@ void BCPL_SET_ERROR(int code, const char* message, const char* context);
 
 void* HeapManager::allocString(size_t numChars) {
     size_t totalSize = sizeof(uint64_t) + (numChars + 1) * sizeof(uint32_t);
-    void* ptr;
-    const size_t HEAP_ALIGNMENT = 16;
-    if (posix_memalign(&ptr, HEAP_ALIGNMENT, totalSize) != 0) {
+    bool from_arena = false;
+    void* ptr = allocBlock(totalSize, ALLOC_STRING, from_arena);
+    if (ptr == nullptr) {
         BCPL_SET_ERROR(ERROR_OUT_OF_MEMORY, "allocString", "System posix_memalign failed");
         safe_print("Error: String allocation failed\n");
         return nullptr;
     }
+    if (from_arena) {
+        totalSize = SlabArena::classSizeFor(totalSize); // Account the whole size-class block
+    }
 
     // Initialize string metadata
     uint64_t* str = static_cast<uint64_t*>(ptr);
@@ -34,26 +37,15 @@ void* HeapManager::allocString(size_t numChars) {
     uint32_t* payload = reinterpret_cast<uint32_t*>(str + 1);
     payload[numChars] = 0; // Null terminator
 
-    // Track allocation using unordered_map and mutex
-    {
-        std::lock_guard<std::mutex> lock(heap_mutex_);
-        heap_blocks_.emplace(ptr, HeapBlock{ALLOC_STRING, ptr, totalSize, nullptr, nullptr});
-        // Conditionally update the signal-safe shadow array if tracing is enabled
-        if (traceEnabled) {
-            g_shadow_heap_blocks[g_shadow_heap_index].type = ALLOC_STRING;
-            g_shadow_heap_blocks[g_shadow_heap_index].address = ptr;
-            g_shadow_heap_blocks[g_shadow_heap_index].size = totalSize;
-            g_shadow_heap_blocks[g_shadow_heap_index].function_name = nullptr;
-            g_shadow_heap_blocks[g_shadow_heap_index].variable_name = nullptr;
-            g_shadow_heap_index = (g_shadow_heap_index + 1) % MAX_HEAP_BLOCKS;
-        }
-    }
+    // Track allocation (arena blocks only in debug tracking mode)
+    recordBlock(ptr, ALLOC_STRING, totalSize, from_arena);
 
     // SAMM: Track allocation in current scope if enabled
     if (samm_enabled_.load() && ptr != nullptr) {
         std::lock_guard<std::mutex> lock(scope_mutex_);
         if (!scope_allocations_.empty()) {
             scope_allocations_.back().push_back(ptr);
+            if (from_arena) SlabArena::getInstance().setSammOwned(ptr);
             if (traceEnabled) {
                 printf("SAMM: Tracked string allocation %p in scope (depth: %zu, scope size: %zu)\n", 
                        ptr, scope_allocations_.size(), scope_allocations_.back().size());
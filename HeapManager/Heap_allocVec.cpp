@@ -15,38 +15,30 @@
 
 void* HeapManager::allocVec(size_t numElements) {
     size_t totalSize = sizeof(uint64_t) + numElements * sizeof(uint64_t);
-    void* ptr;
-    const size_t HEAP_ALIGNMENT = 16;
-    if (posix_memalign(&ptr, HEAP_ALIGNMENT, totalSize) != 0) {
+    bool from_arena = false;
+    void* ptr = allocBlock(totalSize, ALLOC_VEC, from_arena);
+    if (ptr == nullptr) {
         BCPL_SET_ERROR(ERROR_OUT_OF_MEMORY, "allocVec", "System posix_memalign failed");
         safe_print("Error: Vector allocation failed\n");
         return nullptr;
     }
+    if (from_arena) {
+        totalSize = SlabArena::classSizeFor(totalSize); // Account the whole size-class block
+    }
 
     // Initialize vector metadata
     uint64_t* vec = static_cast<uint64_t*>(ptr);
     vec[0] = numElements; // Store length
 
-    // Track allocation using thread-safe unordered_map
-    {
-        std::lock_guard<std::mutex> lock(heap_mutex_);
-        heap_blocks_.emplace(ptr, HeapBlock{ALLOC_VEC, ptr, totalSize, nullptr, nullptr});
-        // Conditionally update the signal-safe shadow array if tracing is enabled
-        if (traceEnabled) {
-            g_shadow_heap_blocks[g_shadow_heap_index].type = ALLOC_VEC;
-            g_shadow_heap_blocks[g_shadow_heap_index].address = ptr;
-            g_shadow_heap_blocks[g_shadow_heap_index].size = totalSize;
-            g_shadow_heap_blocks[g_shadow_heap_index].function_name = nullptr;
-            g_shadow_heap_blocks[g_shadow_heap_index].variable_name = nullptr;
-            g_shadow_heap_index = (g_shadow_heap_index + 1) % MAX_HEAP_BLOCKS;
-        }
-    }
+    // Track allocation (arena blocks only in debug tracking mode)
+    recordBlock(ptr, ALLOC_VEC, totalSize, from_arena);
 
     // SAMM: Track allocation in current scope if enabled
     if (samm_enabled_.load() && ptr != nullptr) {
         std::lock_guard<std::mutex> lock(scope_mutex_);
         if (!scope_allocations_.empty()) {
             scope_allocations_.back().push_back(ptr);
+            if (from_arena) SlabArena::getInstance().setSammOwned(ptr);
             if (traceEnabled) {
                 printf("SAMM: Tracked vector allocation %p in scope (depth: %zu, scope size: %zu)\n", 
                        ptr, scope_allocations_.size(), scope_allocations_.back().size());
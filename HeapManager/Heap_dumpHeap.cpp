@@ -10,7 +10,7 @@ void HeapManager::dumpHeap() const {
     size_t count = 0;
     for (const auto& kv : heap_blocks_) {
         const HeapBlock& block = kv.second;
-        if (block.address != nullptr) {
+        if (block.address != nullptr && block.type != ALLOC_FREE) { // Skip free() tombstones
             safe_print("Block ");
             int_to_dec((int64_t)count, type_buf);
             safe_print(type_buf);
@@ -32,9 +32,6 @@ void HeapManager::dumpHeap() const {
             safe_print(", Size=");
             int_to_dec((int64_t)block.size, size_buf);
             safe_print(size_buf);
-            if (block.type == ALLOC_FREE) {
-                safe_print(" [FREED]");
-            }
             safe_print("\n");
 
             if (block.type == ALLOC_VEC) {
@@ -60,6 +57,12 @@ void HeapManager::dumpHeap() const {
     int_to_dec((int64_t)count, type_buf);
     safe_print(type_buf);
     safe_print("\n");
+    if (!heap_block_tracking_.load()) {
+        safe_print("Note: slab arena blocks are not listed (heap block tracking is off, slabs in use: ");
+        int_to_dec((int64_t)SlabArena::getInstance().getSlabCount(), type_buf);
+        safe_print(type_buf);
+        safe_print(")\n");
+    }
 
     safe_print("\n=== End Allocation Report (v3.1)      =======================\n");
 }
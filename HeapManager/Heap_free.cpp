@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdlib>
 #include "HeapManager.h" 
 #include <cstddef> // For size_t
@@ -5,13 +6,114 @@
 #include "../SignalSafeUtils.h" // For safe_print
 #include "../runtime/ListDataTypes.h" // For ListHeader
 #include "../runtime/BCPLError.h"
+#include "../runtime/string_class.h" // For bcpl_string_release_promoted
 
 // Declare returnHeaderToFreelist with C linkage
 extern "C" void returnHeaderToFreelist(ListHeader*);
 
+// Free a block that lives in the slab arena. The slab header already knows
+// the block's type and free state, so heap_blocks_ is not consulted unless
+// debug tracking put the block there.
+void HeapManager::freeArenaBlock(void* payload) {
+    SlabArena& arena = SlabArena::getInstance();
+    AllocType type = ALLOC_UNKNOWN;
+    size_t block_size = 0;
+    void* base_address = arena.blockFor(payload, &type, &block_size);
+
+    // Payloads start at most one prefix word into their block. A pointer
+    // further in, such as a SPLIT token, does not own the block.
+    if (base_address && static_cast<uint8_t*>(payload) - static_cast<uint8_t*>(base_address) >
+                            static_cast<ptrdiff_t>(sizeof(uint64_t))) {
+        _BCPL_SET_ERROR(ERROR_INVALID_POINTER, "free", "Attempt to free a pointer into the middle of a block");
+        return;
+    }
+
+    // A block still held by a SAMM scope is dropped from it first; otherwise
+    // the scope would release the address again on exit, after the thread
+    // cache has handed it to a new allocation. If no open scope lists it, its
+    // scope has exited and the cleanup queue releases it instead.
+    if (base_address && arena.isSammOwned(base_address)) {
+        if (!forgetScopeEntries(base_address, payload)) {
+            traceLog("Deferring free of arena block %p to SAMM cleanup\n", payload);
+            return;
+        }
+    }
+
+    // A promoted compact string owns the UTF-32 copy it forwards to.
+    if (type == ALLOC_STRING) bcpl_string_release_promoted(base_address);
+
+    SlabArena::ReleaseResult result = base_address ? arena.release(base_address)
+                                                   : SlabArena::ReleaseResult::NotOwned;
+    if (result == SlabArena::ReleaseResult::DoubleFree) {
+        totalDoubleFreeAttempts++;
+        update_double_free_metrics();
+        if (traceEnabled) {
+            safe_print("\n=== ERROR: DOUBLE FREE DETECTED (SLAB ARENA) ===\n");
+            safe_print("Address: 0x");
+            char addr_buf[20];
+            u64_to_hex((uint64_t)(uintptr_t)payload, addr_buf);
+            safe_print(addr_buf);
+            safe_print("\n=== END DOUBLE FREE ERROR ===\n");
+        }
+        _BCPL_SET_ERROR(ERROR_DOUBLE_FREE, "free", "Double-free detected for memory address (slab arena)");
+        return;
+    }
+    if (result == SlabArena::ReleaseResult::NotOwned) {
+        _BCPL_SET_ERROR(ERROR_INVALID_POINTER, "free", "Attempt to free an untracked memory address");
+        return;
+    }
+
+    totalBytesFreed += block_size;
+    update_free_metrics(block_size);
+    if (type == ALLOC_VEC) totalVectorsFreed++;
+    else if (type == ALLOC_STRING) totalStringsFreed++;
+
+    if (heap_block_tracking_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(heap_mutex_);
+        heap_blocks_.erase(base_address);
+    }
+
+    traceLog("Freed arena block: Address=%p\n", payload);
+}
+
+bool HeapManager::forgetScopeEntries(void* base, void* payload, void* replacement) {
+    std::lock_guard<std::mutex> lock(scope_mutex_);
+    bool found = false;
+    for (auto scope = scope_allocations_.rbegin(); scope != scope_allocations_.rend(); ++scope) {
+        if (replacement) {
+            for (void*& p : *scope) {
+                if (p == base || p == payload) {
+                    p = replacement;
+                    found = true;
+                }
+            }
+            continue;
+        }
+        auto end = std::remove_if(scope->begin(), scope->end(),
+                                  [&](void* p) { return p == base || p == payload; });
+        if (end != scope->end()) {
+            scope->erase(end, scope->end());
+            found = true;
+        }
+    }
+    return found;
+}
+
 void HeapManager::free(void* payload) {
     if (!payload) return;
 
+    // Fast path: small blocks from the slab arena are identified by address range
+    if (SlabArena::getInstance().owns(payload)) {
+        freeArenaBlock(payload);
+        return;
+    }
+
+    // Scope-local region blocks are released by exitScope, never individually
+    if (ScopeRegion::getInstance().owns(payload)) {
+        traceLog("Ignoring free() for scope-local block %p\n", payload);
+        return;
+    }
+
     // SAMM: Check if this pointer was already freed by SAMM
     if (samm_enabled_.load()) {
         std::lock_guard<std::mutex> samm_lock(scope_mutex_);
@@ -31,75 +133,46 @@ void HeapManager::free(void* payload) {
         printf("DEBUG: HeapManager::free called with payload=%p\n", payload);
     }
 
-    // Check if this payload address was recently freed (double-free detection using Bloom filter)
-    if (traceEnabled) {
-        printf("DEBUG: Checking payload %p in Bloom filter\n", payload);
-    }
-    if (recently_freed_addresses_.check(payload)) {
-        totalDoubleFreeAttempts++;
-        // Note: This could be a false positive, so we increment the counter but mention it in the error
-        totalBloomFilterFalsePositives++; // Assume it's a false positive for stats (will be corrected if it's a real double-free)
-        update_double_free_metrics();
-        if (traceEnabled) {
-            printf("DEBUG: POTENTIAL DOUBLE-FREE DETECTED for payload %p (could be false positive)!\n", payload);
-            safe_print("\n=== ERROR: POTENTIAL DOUBLE FREE DETECTED (PAYLOAD) ===\n");
-            safe_print("Address: 0x");
-            char addr_buf[20];
-            u64_to_hex((uint64_t)(uintptr_t)payload, addr_buf);
-            safe_print(addr_buf);
-            safe_print("\nNote: This could be a false positive from Bloom filter\n");
-            safe_print("=== END POTENTIAL DOUBLE FREE ERROR ===\n");
-        }
-        _BCPL_SET_ERROR(ERROR_DOUBLE_FREE, "free", "Potential double-free detected for memory address (Bloom filter detection)");
-        if (traceEnabled) {
-            traceLog("Potential double-free detected: Address=%p\n", payload);
-        }
-        return;
-    }
-
     // Calculate potential base address for Vec/String (payload - 8 bytes)
     void* base_address_for_vec_string = static_cast<uint8_t*>(payload) - sizeof(uint64_t);
-    
-    // Check if the base address was recently freed (for Vec/String double-frees)
-    if (traceEnabled) {
-        printf("DEBUG: Checking base address %p in Bloom filter\n", base_address_for_vec_string);
+
+    // First, try to find the block assuming the payload IS the base address (for Objects, Lists)
+    auto it = heap_blocks_.find(payload);
+
+    // If not found, it might be a Vec or String where the payload is offset.
+    // A live block at the base wins over a stale tombstone at the payload.
+    if (it == heap_blocks_.end() || it->second.type == ALLOC_FREE) {
+        auto base_it = heap_blocks_.find(base_address_for_vec_string);
+        if (base_it != heap_blocks_.end() &&
+            (it == heap_blocks_.end() || base_it->second.type != ALLOC_FREE)) {
+            it = base_it;
+        }
     }
-    if (recently_freed_addresses_.check(base_address_for_vec_string)) {
+
+    // A tombstone means this block was already freed: one compare on the
+    // record we had to look up anyway.
+    if (it != heap_blocks_.end() && it->second.type == ALLOC_FREE) {
         totalDoubleFreeAttempts++;
-        // Note: This could be a false positive, so we increment the counter but mention it in the error
-        totalBloomFilterFalsePositives++; // Assume it's a false positive for stats (will be corrected if it's a real double-free)
         update_double_free_metrics();
         if (traceEnabled) {
-            printf("DEBUG: POTENTIAL DOUBLE-FREE DETECTED for base address %p (payload %p, could be false positive)!\n", base_address_for_vec_string, payload);
-            safe_print("\n=== ERROR: POTENTIAL DOUBLE FREE DETECTED (VEC/STRING) ===\n");
+            safe_print("\n=== ERROR: DOUBLE FREE DETECTED ===\n");
             safe_print("Payload address: 0x");
             char addr_buf[20];
             u64_to_hex((uint64_t)(uintptr_t)payload, addr_buf);
             safe_print(addr_buf);
             safe_print(", Base address: 0x");
-            u64_to_hex((uint64_t)(uintptr_t)base_address_for_vec_string, addr_buf);
+            u64_to_hex((uint64_t)(uintptr_t)it->first, addr_buf);
             safe_print(addr_buf);
-            safe_print("\nNote: This could be a false positive from Bloom filter\n");
-            safe_print("=== END POTENTIAL DOUBLE FREE ERROR ===\n");
-        }
-        _BCPL_SET_ERROR(ERROR_DOUBLE_FREE, "free", "Potential double-free detected for memory address (vector/string, Bloom filter detection)");
-        if (traceEnabled) {
-            traceLog("Potential double-free detected (vector/string): Payload=%p, Base=%p\n", payload, base_address_for_vec_string);
+            safe_print("\n=== END DOUBLE FREE ERROR ===\n");
         }
+        _BCPL_SET_ERROR(ERROR_DOUBLE_FREE, "free", "Double-free detected for memory address");
+        traceLog("Double-free detected: Payload=%p, Base=%p\n", payload, it->first);
         return;
     }
 
-    // First, try to find the block assuming the payload IS the base address (for Objects, Lists)
-    auto it = heap_blocks_.find(payload);
-
-    // If not found, it might be a Vec or String where the payload is offset
-    if (it == heap_blocks_.end()) {
-        it = heap_blocks_.find(base_address_for_vec_string);
-    }
-
     // Now, check if we found it with either method
     if (it != heap_blocks_.end()) {
-        const auto& block = it->second;
+        auto& block = it->second;
         void* base_address = block.address; // Use the definitive address from the block
 
         // Update metrics based on block.type
@@ -112,44 +185,33 @@ void HeapManager::free(void* payload) {
         if (block.type == ALLOC_LIST) {
             returnHeaderToFreelist(static_cast<ListHeader*>(payload));
         } else {
+            if (block.type == ALLOC_STRING) bcpl_string_release_promoted(base_address);
             std::free(base_address);
         }
 
-        // Add to Bloom filter for double-free detection
-        // Always track the base address
-        if (traceEnabled) {
-            printf("DEBUG: Adding base address %p to Bloom filter\n", base_address);
-        }
-        recently_freed_addresses_.add(base_address);
-        bloom_filter_items_added_++;
-        
-        // For Vec/String types, also track the payload address to catch double-frees
-        // from either the base or payload address
-        if (base_address != payload) {
-            if (traceEnabled) {
-                printf("DEBUG: Adding payload address %p to Bloom filter\n", payload);
-            }
-            recently_freed_addresses_.add(payload);
+        // Optional diagnostics: remember the address beyond the tombstone's lifetime
+        if (recently_freed_addresses_) {
+            recently_freed_addresses_->add(base_address);
             bloom_filter_items_added_++;
+            if (base_address != payload) {
+                recently_freed_addresses_->add(payload);
+                bloom_filter_items_added_++;
+            }
+            // Clear once saturated (over 8M items to stay well under 10M capacity)
+            const size_t MAX_BLOOM_ITEMS = 8000000;
+            if (bloom_filter_items_added_ > MAX_BLOOM_ITEMS) {
+                recently_freed_addresses_->clear();
+                bloom_filter_items_added_ = 0;
+            }
         }
 
-        // Print fixed bloom filter statistics
-        if (traceEnabled) {
-            printf("DEBUG: Fixed Bloom filter (12MB) now has ~%lu items (capacity: 10M, estimated false positive rate: %.4f%%)\n", 
-                   bloom_filter_items_added_, 
-                   recently_freed_addresses_.estimate_false_positive_rate(bloom_filter_items_added_) * 100.0);
+        // Leave a tombstone in place of the record
+        block.type = ALLOC_FREE;
+        block.size = 0;
+        if (++freed_tombstones_ > FREED_TOMBSTONE_LIMIT &&
+            freed_tombstones_ > liveBlockCountLocked()) {
+            sweepFreedTombstones();
         }
-        
-        // Reset bloom filter if it gets too saturated (over 8M items to stay well under 10M capacity)
-        const size_t MAX_BLOOM_ITEMS = 8000000;
-        if (bloom_filter_items_added_ > MAX_BLOOM_ITEMS) {
-            printf("DEBUG: Fixed Bloom filter reached 8M items, clearing to maintain low FP rate\n");
-            recently_freed_addresses_.clear();
-            bloom_filter_items_added_ = 0;
-        }
-        
-        // Remove from tracking map
-        heap_blocks_.erase(it);
 
         // Conditionally update shadow array if tracing
         if (traceEnabled) {
@@ -184,6 +246,27 @@ void HeapManager::free(void* payload) {
         return;
     }
 
+    // Not live and no tombstone: with the diagnostic Bloom filter on, an
+    // older double free can still be told apart from a foreign pointer.
+    if (recently_freed_addresses_ &&
+        (recently_freed_addresses_->check(payload) ||
+         recently_freed_addresses_->check(base_address_for_vec_string))) {
+        totalDoubleFreeAttempts++;
+        totalBloomFilterFalsePositives++; // Cannot rule out a false positive here
+        update_double_free_metrics();
+        if (traceEnabled) {
+            safe_print("\n=== ERROR: POTENTIAL DOUBLE FREE DETECTED (BLOOM FILTER) ===\n");
+            safe_print("Address: 0x");
+            char addr_buf[20];
+            u64_to_hex((uint64_t)(uintptr_t)payload, addr_buf);
+            safe_print(addr_buf);
+            safe_print("\nNote: This could be a false positive from Bloom filter\n");
+            safe_print("=== END POTENTIAL DOUBLE FREE ERROR ===\n");
+        }
+        _BCPL_SET_ERROR(ERROR_DOUBLE_FREE, "free", "Potential double-free detected for memory address (Bloom filter detection)");
+        return;
+    }
+
     // If not found in map
     _BCPL_SET_ERROR(ERROR_INVALID_POINTER, "free", "Attempt to free an untracked memory address");
     if (traceEnabled) {
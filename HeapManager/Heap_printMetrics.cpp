@@ -29,31 +29,53 @@ void HeapManager::printMetrics() const {
     safe_print("\nTotal Double-Free Attempts: ");
     int_to_dec((int64_t)totalDoubleFreeAttempts, buf);
     safe_print(buf);
-    safe_print("\nFixed Bloom Filter Size: 12MB (10M capacity)");
-    safe_print("\nBloom Filter Items Added: ");
-    int_to_dec((int64_t)bloom_filter_items_added_, buf);
+    safe_print("\nSlab Arena: ");
+    safe_print(slab_arena_enabled_.load() ? "ENABLED" : "DISABLED");
+    safe_print(", Slabs Carved: ");
+    int_to_dec((int64_t)SlabArena::getInstance().getSlabCount(), buf);
     safe_print(buf);
-    safe_print("\nBloom Filter Capacity: 10000000");
-    safe_print("\nBloom Filter Reset Count: 0 (fixed size)");
+    safe_print(", Committed Bytes: ");
+    int_to_dec((int64_t)SlabArena::getInstance().getCommittedBytes(), buf);
     safe_print(buf);
-    safe_print("\nBloom Filter False Positives: ");
-    int_to_dec((int64_t)totalBloomFilterFalsePositives, buf);
+    safe_print("\nScope Region Allocations: ");
+    int_to_dec((int64_t)samm_region_allocations_.load(), buf);
     safe_print(buf);
-    safe_print("\nBloom Filter Memory Usage: ");
-    int_to_dec((int64_t)recently_freed_addresses_.memory_usage(), buf);
+    safe_print(", Resets: ");
+    int_to_dec((int64_t)samm_region_resets_.load(), buf);
     safe_print(buf);
-    safe_print(" bytes\nBloom Filter False Positive Rate: ");
-    
-    // Calculate and display false positive rate as percentage
-    double fp_rate = recently_freed_addresses_.estimate_false_positive_rate(bloom_filter_items_added_);
-    int fp_percentage = (int)(fp_rate * 10000); // Convert to basis points for integer display
-    int_to_dec(fp_percentage, buf);
+    safe_print(", High Water Bytes: ");
+    int_to_dec((int64_t)ScopeRegion::getInstance().getHighWater(), buf);
     safe_print(buf);
-    safe_print("/10000 (");
-    int fp_percent_display = (int)(fp_rate * 100);
-    int_to_dec(fp_percent_display, buf);
+    safe_print("\nFreed-Block Tombstones: ");
+    int_to_dec((int64_t)freed_tombstones_, buf);
     safe_print(buf);
-    safe_print(".xx%)\nTotal Cleanup Time: ");
+    if (!recently_freed_addresses_) {
+        safe_print("\nBloom Filter: DISABLED (opt-in diagnostic)");
+    } else {
+        safe_print("\nFixed Bloom Filter Size: 12MB (10M capacity)");
+        safe_print("\nBloom Filter Items Added: ");
+        int_to_dec((int64_t)bloom_filter_items_added_, buf);
+        safe_print(buf);
+        safe_print("\nBloom Filter False Positives: ");
+        int_to_dec((int64_t)totalBloomFilterFalsePositives, buf);
+        safe_print(buf);
+        safe_print("\nBloom Filter Memory Usage: ");
+        int_to_dec((int64_t)recently_freed_addresses_->memory_usage(), buf);
+        safe_print(buf);
+        safe_print(" bytes\nBloom Filter False Positive Rate: ");
+
+        // Calculate and display false positive rate as percentage
+        double fp_rate = recently_freed_addresses_->estimate_false_positive_rate(bloom_filter_items_added_);
+        int fp_percentage = (int)(fp_rate * 10000); // Convert to basis points for integer display
+        int_to_dec(fp_percentage, buf);
+        safe_print(buf);
+        safe_print("/10000 (");
+        int fp_percent_display = (int)(fp_rate * 100);
+        int_to_dec(fp_percent_display, buf);
+        safe_print(buf);
+        safe_print(".xx%)");
+    }
+    safe_print("\nTotal Cleanup Time: ");
     
     // Add cleanup timing metrics
     int cleanup_time = (int)totalCleanupTimeMs;
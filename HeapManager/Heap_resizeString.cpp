@@ -1,9 +1,11 @@
 #include <cstdlib>
+#include <cstring> // For memcpy
 #include <stdexcept>
 #include <algorithm> // For std::min
 #include "HeapManager.h" // Include HeapManager class definition
 #include "heap_manager_defs.h" // For AllocType, HeapBlock, MAX_HEAP_BLOCKS
 #include "../SignalSafeUtils.h" // For safe_print, u64_to_hex, int_to_dec
+#include "../runtime/string_class.h" // For BCPL_STRING_LENGTH_MASK
 
 // Function is defined in SignalSafeUtils.h
 extern void safe_print(const char*); // Declaration of safe_print utility
@@ -18,6 +20,71 @@ void* resizeString(void* payload, size_t newNumChars) {
     void* base_address = static_cast<uint8_t*>(payload) - sizeof(uint64_t);
 
     HeapManager& mgr = HeapManager::getInstance();
+
+    // Slab arena blocks: resize in place when the size class still fits,
+    // otherwise migrate to a tracked posix_memalign block.
+    AllocType arena_type = ALLOC_UNKNOWN;
+    size_t block_size = 0;
+    void* arena_base = SlabArena::getInstance().blockFor(base_address, &arena_type, &block_size);
+    if (arena_base != nullptr && arena_base != base_address) {
+        // A string inside another block (a SPLIT token) shares it with its
+        // neighbours: resizing copies it out and leaves the block alone.
+        size_t oldNumChars = *static_cast<uint64_t*>(base_address) & BCPL_STRING_LENGTH_MASK;
+        void* newPayload = mgr.allocString(newNumChars);
+        if (newPayload) {
+            memcpy(newPayload, payload, std::min(oldNumChars, newNumChars) * sizeof(uint32_t));
+        }
+        return newPayload;
+    }
+    if (arena_base != nullptr && arena_type == ALLOC_STRING) {
+        size_t newTotalSize = sizeof(uint64_t) + (newNumChars + 1) * sizeof(uint32_t);
+        if (newTotalSize > block_size) {
+            void* newPtr = nullptr;
+            if (posix_memalign(&newPtr, 16, newTotalSize) != 0) {
+                safe_print("Error: String resize failed\n");
+                return nullptr;
+            }
+            memcpy(newPtr, arena_base, block_size);
+            // A SAMM scope holding the old block now holds the new one
+            if (SlabArena::getInstance().clearSammOwned(arena_base)) {
+                mgr.forgetScopeEntries(arena_base, payload, newPtr);
+            }
+            SlabArena::getInstance().release(arena_base);
+            {
+                std::lock_guard<std::mutex> lock(mgr.heap_mutex_);
+                mgr.heap_blocks_.erase(arena_base);
+                mgr.trackBlockLocked(newPtr, ALLOC_STRING, newTotalSize);
+            }
+            uint64_t* str = static_cast<uint64_t*>(newPtr);
+            str[0] = newNumChars;
+            uint32_t* payload_ptr = reinterpret_cast<uint32_t*>(str + 1);
+            payload_ptr[newNumChars] = 0;
+            return static_cast<void*>(payload_ptr);
+        }
+        uint64_t* str = static_cast<uint64_t*>(arena_base);
+        str[0] = newNumChars;
+        uint32_t* payload_ptr = reinterpret_cast<uint32_t*>(str + 1);
+        payload_ptr[newNumChars] = 0;
+        return static_cast<void*>(payload_ptr);
+    }
+
+    // Scope-local region blocks: shrink in place; growing copies into a
+    // SAMM-tracked string since the region cannot extend a block mid-stack.
+    if (ScopeRegion::getInstance().owns(base_address)) {
+        uint64_t* str = static_cast<uint64_t*>(base_address);
+        size_t oldNumChars = str[0] & BCPL_STRING_LENGTH_MASK;
+        if (newNumChars <= oldNumChars) {
+            str[0] = newNumChars;
+            static_cast<uint32_t*>(payload)[newNumChars] = 0;
+            return payload;
+        }
+        void* newPayload = mgr.allocString(newNumChars);
+        if (newPayload) {
+            memcpy(newPayload, payload, oldNumChars * sizeof(uint32_t));
+        }
+        return newPayload;
+    }
+
     std::lock_guard<std::mutex> lock(mgr.heap_mutex_);
 
     auto it = mgr.heap_blocks_.find(base_address);
@@ -32,9 +99,13 @@ void* resizeString(void* payload, size_t newNumChars) {
             return nullptr;
         }
 
-        // Update metadata
-        it->second.address = newPtr;
-        it->second.size = newTotalSize;
+        // Update metadata; a moved block is re-keyed so free() can find it
+        if (newPtr != it->first) {
+            mgr.heap_blocks_.erase(it);
+            mgr.trackBlockLocked(newPtr, ALLOC_STRING, newTotalSize);
+        } else {
+            it->second.size = newTotalSize;
+        }
 
         // Update the length field in the string
         uint64_t* str = static_cast<uint64_t*>(newPtr);
@@ -2,6 +2,7 @@
 #include "heap_manager_defs.h" // For AllocType, HeapBlock, MAX_HEAP_BLOCKS
 #include "../SignalSafeUtils.h" // For safe_print, int_to_dec
 #include <cstdlib>
+#include <cstring> // For memcpy
 #include "runtime/BCPLError.h"
 #include "include/compiler_interface.h"
 #ifdef __cplusplus
@@ -26,6 +27,56 @@ void* resizeVec(void* payload, size_t newNumElements) {
     void* base_address = static_cast<uint8_t*>(payload) - sizeof(uint64_t);
 
     HeapManager& mgr = HeapManager::getInstance();
+
+    // Slab arena blocks: resize in place when the size class still fits,
+    // otherwise migrate to a tracked posix_memalign block.
+    AllocType arena_type = ALLOC_UNKNOWN;
+    size_t block_size = 0;
+    void* arena_base = SlabArena::getInstance().blockFor(base_address, &arena_type, &block_size);
+    if (arena_base != nullptr && arena_type == ALLOC_VEC) {
+        size_t newTotalSize = sizeof(uint64_t) + newNumElements * sizeof(uint64_t);
+        if (newTotalSize > block_size) {
+            void* newPtr = nullptr;
+            if (posix_memalign(&newPtr, 16, newTotalSize) != 0) {
+                safe_print("Error: Vector resize failed\n");
+                return nullptr;
+            }
+            memcpy(newPtr, arena_base, block_size);
+            // A SAMM scope holding the old block now holds the new one
+            if (SlabArena::getInstance().clearSammOwned(arena_base)) {
+                mgr.forgetScopeEntries(arena_base, payload, newPtr);
+            }
+            SlabArena::getInstance().release(arena_base);
+            {
+                std::lock_guard<std::mutex> lock(mgr.heap_mutex_);
+                mgr.heap_blocks_.erase(arena_base);
+                mgr.trackBlockLocked(newPtr, ALLOC_VEC, newTotalSize);
+            }
+            uint64_t* vec = static_cast<uint64_t*>(newPtr);
+            vec[0] = newNumElements;
+            return static_cast<void*>(vec + 1);
+        }
+        uint64_t* vec = static_cast<uint64_t*>(arena_base);
+        vec[0] = newNumElements;
+        return static_cast<void*>(vec + 1);
+    }
+
+    // Scope-local region blocks: shrink in place; growing copies into a
+    // SAMM-tracked vector since the region cannot extend a block mid-stack.
+    if (ScopeRegion::getInstance().owns(base_address)) {
+        uint64_t* vec = static_cast<uint64_t*>(base_address);
+        size_t oldNumElements = vec[0];
+        if (newNumElements <= oldNumElements) {
+            vec[0] = newNumElements;
+            return payload;
+        }
+        void* newPayload = mgr.allocVec(newNumElements);
+        if (newPayload) {
+            memcpy(newPayload, payload, oldNumElements * sizeof(uint64_t));
+        }
+        return newPayload;
+    }
+
     std::lock_guard<std::mutex> lock(mgr.heap_mutex_);
 
     auto it = mgr.heap_blocks_.find(base_address);
@@ -41,9 +92,13 @@ void* resizeVec(void* payload, size_t newNumElements) {
             return nullptr;
         }
 
-        // Update metadata
-        it->second.address = newPtr;
-        it->second.size = newTotalSize;
+        // Update metadata; a moved block is re-keyed so free() can find it
+        if (newPtr != it->first) {
+            mgr.heap_blocks_.erase(it);
+            mgr.trackBlockLocked(newPtr, ALLOC_VEC, newTotalSize);
+        } else {
+            it->second.size = newTotalSize;
+        }
 
         // Update the length field in the vector
         uint64_t* vec = static_cast<uint64_t*>(newPtr);
@@ -0,0 +1,62 @@
+#include "ScopeRegion.h"
+#include "../SignalSafeUtils.h" // For safe_print
+#include <sys/mman.h>
+#include <unistd.h>
+
+ScopeRegion& ScopeRegion::getInstance() {
+    // Intentionally leaked, like SlabArena: free() may range-check region
+    // pointers during static destruction.
+    static ScopeRegion* instance = new ScopeRegion();
+    return *instance;
+}
+
+ScopeRegion::ScopeRegion() : base_(0), limit_(0) {
+    int flags = MAP_PRIVATE | MAP_ANON;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    void* region = mmap(nullptr, RESERVE_BYTES, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (region == MAP_FAILED) {
+        safe_print("Warning: ScopeRegion reservation failed, scope-local allocations use the tracked heap\n");
+        return;
+    }
+    base_ = reinterpret_cast<uintptr_t>(region);
+    limit_ = RESERVE_BYTES;
+}
+
+void* ScopeRegion::allocate(size_t bytes) {
+    size_t size = (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (size == 0 || size > limit_ - top_) {
+        return nullptr;
+    }
+
+    void* ptr = reinterpret_cast<void*>(base_ + top_);
+    top_ += size;
+    if (top_ > dirty_end_) dirty_end_ = top_;
+    if (top_ > high_water_) high_water_ = top_;
+    allocations_++;
+    bytes_allocated_ += size;
+    return ptr;
+}
+
+void ScopeRegion::resetTo(size_t mark) {
+    if (mark > top_) return; // Stale mark (scope stack out of sync); keep live data
+    top_ = mark;
+    resets_++;
+
+    // Return dirty pages beyond the threshold; the common case of small
+    // temporaries never reaches this.
+    if (dirty_end_ - top_ > TRIM_THRESHOLD) {
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t keep = (top_ + TRIM_THRESHOLD + page - 1) & ~(page - 1);
+        if (keep < dirty_end_) {
+            void* start = reinterpret_cast<void*>(base_ + keep);
+#ifdef MADV_FREE
+            madvise(start, dirty_end_ - keep, MADV_FREE);
+#else
+            madvise(start, dirty_end_ - keep, MADV_DONTNEED);
+#endif
+            dirty_end_ = keep;
+        }
+    }
+}
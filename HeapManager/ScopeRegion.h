@@ -0,0 +1,71 @@
+#ifndef SCOPE_REGION_H
+#define SCOPE_REGION_H
+
+// ============================================================================
+// ScopeRegion - bump-pointer region for scope-local SAMM allocations
+//
+// The compiler's RetainAnalysisPass marks VEC / STRING allocations whose
+// variable never leaves the declaring block. Those are served from this
+// region instead of the tracked heap: allocation is a pointer bump, and
+// HeapManager::exitScope releases everything the scope allocated by
+// resetting the bump pointer to the mark taken in enterScope - O(1), with no
+// per-pointer bookkeeping and no trip through the cleanup worker.
+//
+// The region is one contiguous reserved address range, so ownership is a
+// single range check and marks are plain offsets. Pages are committed on
+// first touch; resetTo() hands dirty pages above TRIM_THRESHOLD back to the
+// OS so one large temporary does not pin memory for the rest of the run.
+//
+// Not internally synchronised: HeapManager calls it under scope_mutex_,
+// which already serialises the SAMM scope stack it shadows.
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+
+class ScopeRegion {
+public:
+    static constexpr size_t RESERVE_BYTES = size_t(1) << 30;   // 1 GB virtual
+    static constexpr size_t ALIGNMENT = 16;
+    static constexpr size_t TRIM_THRESHOLD = size_t(4) << 20;  // Keep up to 4 MB dirty
+
+    static ScopeRegion& getInstance();
+
+    // Returns 16-byte aligned storage, or nullptr if the region is exhausted
+    // (callers fall back to the tracked heap).
+    void* allocate(size_t bytes);
+
+    // Current bump offset; pass back to resetTo() to release everything
+    // allocated since.
+    size_t mark() const { return top_; }
+    void resetTo(size_t mark);
+
+    // Range check only - valid for any pointer into the reservation.
+    bool owns(const void* ptr) const {
+        uintptr_t p = reinterpret_cast<uintptr_t>(ptr);
+        return p >= base_ && p < base_ + limit_;
+    }
+
+    // Statistics
+    size_t getBytesInUse() const { return top_; }
+    size_t getHighWater() const { return high_water_; }
+    uint64_t getAllocationCount() const { return allocations_; }
+    uint64_t getResetCount() const { return resets_; }
+    uint64_t getBytesAllocated() const { return bytes_allocated_; }
+
+private:
+    ScopeRegion();
+    ScopeRegion(const ScopeRegion&) = delete;
+    ScopeRegion& operator=(const ScopeRegion&) = delete;
+
+    uintptr_t base_;
+    size_t limit_;          // 0 if the reservation failed
+    size_t top_ = 0;        // Bump offset
+    size_t dirty_end_ = 0;  // Highest offset touched since the last trim
+    size_t high_water_ = 0;
+    uint64_t allocations_ = 0;
+    uint64_t resets_ = 0;
+    uint64_t bytes_allocated_ = 0;
+};
+
+#endif // SCOPE_REGION_H
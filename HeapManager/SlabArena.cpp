@@ -0,0 +1,273 @@
+#include "SlabArena.h"
+#include "../SignalSafeUtils.h" // For safe_print
+#include <sys/mman.h>
+#include <cstring>
+
+// Size classes cover every small VEC/STRING/OBJECT request. The table is
+// indexed by (bytes - 1) / 16 so classIndexFor is a single load.
+static constexpr size_t kClassSizes[SlabArena::NUM_SIZE_CLASSES] = {
+    16, 32, 48, 64, 96, 128, 192, 256, 512
+};
+
+static constexpr size_t kLookupEntries = SlabArena::MAX_SMALL_SIZE / 16;
+
+struct ClassLookup {
+    uint8_t index[kLookupEntries];
+    constexpr ClassLookup() : index() {
+        size_t c = 0;
+        for (size_t i = 0; i < kLookupEntries; ++i) {
+            size_t bytes = (i + 1) * 16;
+            while (kClassSizes[c] < bytes) ++c;
+            index[i] = static_cast<uint8_t>(c);
+        }
+    }
+};
+
+static constexpr ClassLookup kClassLookup;
+
+// First block starts on a cache line after the header.
+static constexpr size_t kHeaderBytes = (sizeof(SlabArena::SlabHeader) + 63) & ~size_t(63);
+
+// ============================================================================
+// Per-thread cache
+// ============================================================================
+
+struct SlabThreadCache {
+    SlabArena::FreeBlock* heads[SlabArena::NUM_SIZE_CLASSES] = {};
+    SlabArena::FreeBlock* tails[SlabArena::NUM_SIZE_CLASSES] = {};
+    uint32_t counts[SlabArena::NUM_SIZE_CLASSES] = {};
+
+    // Hand everything back to the depots when the thread exits so blocks
+    // cached by short-lived worker threads are not stranded.
+    ~SlabThreadCache() {
+        SlabArena& arena = SlabArena::getInstance();
+        for (size_t c = 0; c < SlabArena::NUM_SIZE_CLASSES; ++c) {
+            if (counts[c] != 0) {
+                arena.drain(static_cast<int>(c), heads[c], tails[c], counts[c]);
+                heads[c] = tails[c] = nullptr;
+                counts[c] = 0;
+            }
+        }
+    }
+};
+
+static thread_local SlabThreadCache t_slab_cache;
+
+// ============================================================================
+// SlabArena
+// ============================================================================
+
+SlabArena& SlabArena::getInstance() {
+    // Intentionally leaked: thread caches drain into it during thread/process exit.
+    static SlabArena* instance = new SlabArena();
+    return *instance;
+}
+
+SlabArena::SlabArena() : base_(0), reserved_ok_(false) {
+    int flags = MAP_PRIVATE | MAP_ANON;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    // Over-reserve by one slab so the usable range can be aligned to SLAB_SIZE.
+    void* region = mmap(nullptr, RESERVE_BYTES + SLAB_SIZE, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (region == MAP_FAILED) {
+        safe_print("Warning: SlabArena reservation failed, small allocations use posix_memalign\n");
+        return;
+    }
+    base_ = (reinterpret_cast<uintptr_t>(region) + SLAB_SIZE - 1) & ~(uintptr_t)(SLAB_SIZE - 1);
+    reserved_ok_ = true;
+}
+
+int SlabArena::classIndexFor(size_t bytes) {
+    if (!handlesSize(bytes)) return -1;
+    return kClassLookup.index[(bytes - 1) / 16];
+}
+
+size_t SlabArena::classSizeFor(size_t bytes) {
+    int c = classIndexFor(bytes);
+    return c < 0 ? bytes : kClassSizes[c];
+}
+
+SlabArena::FreeBlock* SlabArena::carveSlab(int class_index, FreeBlock** tail_out, uint32_t* count_out) {
+    if (!reserved_ok_) return nullptr;
+
+    size_t offset = committed_end_.load(std::memory_order_relaxed);
+    do {
+        if (offset + SLAB_SIZE > RESERVE_BYTES) {
+            return nullptr; // Arena exhausted; caller falls back to posix_memalign
+        }
+    } while (!committed_end_.compare_exchange_weak(offset, offset + SLAB_SIZE,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_relaxed));
+
+    uint8_t* slab = reinterpret_cast<uint8_t*>(base_ + offset);
+    SlabHeader* header = reinterpret_cast<SlabHeader*>(slab);
+    const size_t block_size = kClassSizes[class_index];
+    const uint32_t block_count = static_cast<uint32_t>((SLAB_SIZE - kHeaderBytes) / block_size);
+
+    header->magic = SLAB_MAGIC;
+    header->size_class = static_cast<uint16_t>(class_index);
+    header->reserved = 0;
+    header->block_size = static_cast<uint32_t>(block_size);
+    header->block_count = block_count;
+    header->first_block = slab + kHeaderBytes;
+    memset(header->block_state, ALLOC_FREE, block_count);
+
+    // Thread every block of the new slab into one chain.
+    FreeBlock* head = reinterpret_cast<FreeBlock*>(header->first_block);
+    FreeBlock* cur = head;
+    for (uint32_t i = 1; i < block_count; ++i) {
+        FreeBlock* next = reinterpret_cast<FreeBlock*>(header->first_block + i * block_size);
+        cur->next = next;
+        cur = next;
+    }
+    cur->next = nullptr;
+
+    slabs_carved_.fetch_add(1, std::memory_order_relaxed);
+    *tail_out = cur;
+    *count_out = block_count;
+    return head;
+}
+
+uint32_t SlabArena::refill(int class_index, FreeBlock** head_out) {
+    Depot& depot = depots_[class_index];
+    std::lock_guard<std::mutex> lock(depot.mutex);
+
+    if (depot.head == nullptr) {
+        FreeBlock* tail = nullptr;
+        uint32_t count = 0;
+        FreeBlock* head = carveSlab(class_index, &tail, &count);
+        if (!head) {
+            *head_out = nullptr;
+            return 0;
+        }
+        depot.head = head;
+        depot.count = count;
+    }
+
+    // Detach up to REFILL_BATCH blocks from the front of the depot.
+    FreeBlock* head = depot.head;
+    FreeBlock* last = head;
+    uint32_t taken = 1;
+    while (taken < REFILL_BATCH && last->next != nullptr) {
+        last = last->next;
+        ++taken;
+    }
+    depot.head = last->next;
+    depot.count -= taken;
+    last->next = nullptr;
+
+    *head_out = head;
+    return taken;
+}
+
+void SlabArena::drain(int class_index, FreeBlock* head, FreeBlock* tail, uint32_t count) {
+    Depot& depot = depots_[class_index];
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    tail->next = depot.head;
+    depot.head = head;
+    depot.count += count;
+}
+
+void* SlabArena::allocate(size_t bytes, AllocType type) {
+    int c = classIndexFor(bytes);
+    if (c < 0) return nullptr;
+
+    SlabThreadCache& cache = t_slab_cache;
+    FreeBlock* block = cache.heads[c];
+    if (block == nullptr) {
+        uint32_t got = refill(c, &cache.heads[c]);
+        if (got == 0) return nullptr;
+        cache.counts[c] = got;
+        block = cache.heads[c];
+        FreeBlock* tail = block;
+        while (tail->next) tail = tail->next;
+        cache.tails[c] = tail;
+    }
+
+    cache.heads[c] = block->next;
+    if (--cache.counts[c] == 0) cache.tails[c] = nullptr;
+
+    SlabHeader* header = headerFor(block);
+    uint32_t index = static_cast<uint32_t>((reinterpret_cast<uint8_t*>(block) - header->first_block) / header->block_size);
+    header->block_state[index] = static_cast<uint8_t>(type);
+    return block;
+}
+
+void* SlabArena::blockFor(const void* ptr, AllocType* type_out, size_t* size_out) const {
+    if (!owns(ptr)) return nullptr;
+
+    SlabHeader* header = headerFor(ptr);
+    const uint8_t* p = static_cast<const uint8_t*>(ptr);
+    if (header->magic != SLAB_MAGIC || p < header->first_block) return nullptr;
+
+    uint32_t index = static_cast<uint32_t>((p - header->first_block) / header->block_size);
+    if (index >= header->block_count) return nullptr;
+
+    if (type_out) *type_out = static_cast<AllocType>(header->block_state[index] & ~SAMM_OWNED);
+    if (size_out) *size_out = header->block_size;
+    return header->first_block + static_cast<size_t>(index) * header->block_size;
+}
+
+uint8_t* SlabArena::stateFor(const void* ptr) const {
+    if (!owns(ptr)) return nullptr;
+
+    SlabHeader* header = headerFor(ptr);
+    const uint8_t* p = static_cast<const uint8_t*>(ptr);
+    if (header->magic != SLAB_MAGIC || p < header->first_block) return nullptr;
+
+    uint32_t index = static_cast<uint32_t>((p - header->first_block) / header->block_size);
+    if (index >= header->block_count) return nullptr;
+    return &header->block_state[index];
+}
+
+void SlabArena::setSammOwned(const void* ptr) {
+    uint8_t* state = stateFor(ptr);
+    if (state && *state != ALLOC_FREE) *state |= SAMM_OWNED;
+}
+
+bool SlabArena::clearSammOwned(const void* ptr) {
+    uint8_t* state = stateFor(ptr);
+    if (!state || !(*state & SAMM_OWNED)) return false;
+    *state &= static_cast<uint8_t>(~SAMM_OWNED);
+    return true;
+}
+
+bool SlabArena::isSammOwned(const void* ptr) const {
+    uint8_t* state = stateFor(ptr);
+    return state && (*state & SAMM_OWNED);
+}
+
+SlabArena::ReleaseResult SlabArena::release(void* ptr) {
+    if (!owns(ptr)) return ReleaseResult::NotOwned;
+
+    SlabHeader* header = headerFor(ptr);
+    uint8_t* p = static_cast<uint8_t*>(ptr);
+    if (header->magic != SLAB_MAGIC || p < header->first_block) return ReleaseResult::NotOwned;
+
+    uint32_t index = static_cast<uint32_t>((p - header->first_block) / header->block_size);
+    if (index >= header->block_count) return ReleaseResult::NotOwned;
+    if (header->block_state[index] == ALLOC_FREE) return ReleaseResult::DoubleFree;
+    header->block_state[index] = ALLOC_FREE;
+
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(header->first_block + static_cast<size_t>(index) * header->block_size);
+    const int c = header->size_class;
+    SlabThreadCache& cache = t_slab_cache;
+    block->next = cache.heads[c];
+    cache.heads[c] = block;
+    if (cache.counts[c]++ == 0) cache.tails[c] = block;
+
+    // Keep REFILL_BATCH blocks hot locally; push the older remainder back.
+    if (cache.counts[c] > CACHE_HIGH_WATER) {
+        FreeBlock* keep_tail = cache.heads[c];
+        for (uint32_t i = 1; i < REFILL_BATCH; ++i) keep_tail = keep_tail->next;
+        FreeBlock* spill_head = keep_tail->next;
+        FreeBlock* spill_tail = cache.tails[c];
+        uint32_t spill_count = cache.counts[c] - REFILL_BATCH;
+        keep_tail->next = nullptr;
+        cache.tails[c] = keep_tail;
+        cache.counts[c] = REFILL_BATCH;
+        drain(c, spill_head, spill_tail, spill_count);
+    }
+    return ReleaseResult::Released;
+}
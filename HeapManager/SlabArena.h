@@ -0,0 +1,146 @@
+#ifndef SLAB_ARENA_H
+#define SLAB_ARENA_H
+
+// ============================================================================
+// SlabArena - size-class slab allocator for small HeapManager blocks
+//
+// Small VEC, STRING and OBJECT allocations are carved out of fixed-size slabs
+// taken from a single reserved address range. Every slab starts with a
+// SlabHeader holding the size class and a per-block state byte, so any
+// pointer inside the arena maps to its block in O(1) by masking the address
+// down to the slab boundary - no global map and no lock on the hot path.
+//
+// Each thread keeps a small cache of free blocks per size class. Caches are
+// refilled from, and drained back to, a per-class global depot in batches,
+// so the depot mutex is taken roughly once every REFILL_BATCH operations.
+//
+// Allocations larger than MAX_SMALL_SIZE are not handled here; HeapManager
+// keeps using posix_memalign + heap_blocks_ for those.
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+
+#include "heap_manager_defs.h"
+
+class SlabArena {
+public:
+    // Slabs are SLAB_SIZE aligned so that (ptr & ~(SLAB_SIZE - 1)) finds the header.
+    static constexpr size_t SLAB_SIZE = 64 * 1024;
+    static constexpr size_t NUM_SIZE_CLASSES = 9;
+    static constexpr size_t MAX_SMALL_SIZE = 512;
+    static constexpr size_t MIN_BLOCK_SIZE = 16;
+    static constexpr size_t MAX_BLOCKS_PER_SLAB = SLAB_SIZE / MIN_BLOCK_SIZE;
+
+    // Address space reserved up front; pages are only committed when touched.
+    static constexpr size_t RESERVE_BYTES = size_t(8) << 30; // 8 GB virtual
+
+    // Thread cache tuning
+    static constexpr uint32_t REFILL_BATCH = 64;
+    static constexpr uint32_t CACHE_HIGH_WATER = 4 * REFILL_BATCH;
+
+    static constexpr uint32_t SLAB_MAGIC = 0x5342534C; // "LSBS"
+
+    // Header at the start of every slab. Block state lives here rather than
+    // in front of each block, so freed blocks can be validated without
+    // touching their payload.
+    struct SlabHeader {
+        uint32_t magic;
+        uint16_t size_class;
+        uint16_t reserved;
+        uint32_t block_size;
+        uint32_t block_count;
+        uint8_t* first_block;
+        uint8_t block_state[MAX_BLOCKS_PER_SLAB]; // AllocType of each block, ALLOC_FREE when free
+    };
+
+    // Set in a block's state byte while a SAMM scope (or the cleanup queue)
+    // holds the block. Scope cleanup only releases blocks that still have it,
+    // so a block freed explicitly and handed out again is left alone.
+    static constexpr uint8_t SAMM_OWNED = 0x80;
+
+    // Outcome of release(); lets HeapManager report double frees precisely.
+    enum class ReleaseResult {
+        Released,
+        DoubleFree,
+        NotOwned
+    };
+
+    static SlabArena& getInstance();
+
+    static bool handlesSize(size_t bytes) { return bytes != 0 && bytes <= MAX_SMALL_SIZE; }
+
+    // Returns the block base (16-byte aligned), or nullptr if the arena is exhausted.
+    void* allocate(size_t bytes, AllocType type);
+
+    // Returns the block to the calling thread's cache.
+    ReleaseResult release(void* ptr);
+
+    // True if ptr lies inside the reserved arena range.
+    bool owns(const void* ptr) const {
+        uintptr_t p = reinterpret_cast<uintptr_t>(ptr);
+        return p >= base_ && p < base_ + committed_end_.load(std::memory_order_acquire);
+    }
+
+    // Maps any pointer inside a live or free block (base or payload) to the
+    // block base. Optionally returns the block's state and usable size.
+    void* blockFor(const void* ptr, AllocType* type_out = nullptr, size_t* size_out = nullptr) const;
+
+    // SAMM ownership of the block containing ptr (base or payload). Clearing
+    // returns whether the bit was set; all three ignore free blocks.
+    void setSammOwned(const void* ptr);
+    bool clearSammOwned(const void* ptr);
+    bool isSammOwned(const void* ptr) const;
+
+    // Usable size of the size class that would serve a request of `bytes`.
+    static size_t classSizeFor(size_t bytes);
+
+    // Statistics
+    size_t getSlabCount() const { return slabs_carved_.load(std::memory_order_relaxed); }
+    size_t getReservedBytes() const { return reserved_ok_ ? RESERVE_BYTES : 0; }
+    size_t getCommittedBytes() const { return committed_end_.load(std::memory_order_relaxed); }
+
+private:
+    SlabArena();
+    SlabArena(const SlabArena&) = delete;
+    SlabArena& operator=(const SlabArena&) = delete;
+
+    // Intrusive free-list node written into the first word of a free block.
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // Per-class global depot; only touched on cache refill/drain.
+    struct Depot {
+        std::mutex mutex;
+        FreeBlock* head = nullptr;
+        size_t count = 0;
+    };
+
+    friend struct SlabThreadCache;
+
+    static int classIndexFor(size_t bytes);
+    SlabHeader* headerFor(const void* ptr) const {
+        return reinterpret_cast<SlabHeader*>(reinterpret_cast<uintptr_t>(ptr) & ~(uintptr_t)(SLAB_SIZE - 1));
+    }
+    // State byte of the block containing ptr, or nullptr if ptr is not in a block.
+    uint8_t* stateFor(const void* ptr) const;
+
+    // Carves a fresh slab for the class and links its blocks into a chain.
+    // Returns the chain head and stores the tail/count in the out-parameters.
+    FreeBlock* carveSlab(int class_index, FreeBlock** tail_out, uint32_t* count_out);
+
+    // Batch transfer between thread caches and the depot.
+    uint32_t refill(int class_index, FreeBlock** head_out);
+    void drain(int class_index, FreeBlock* head, FreeBlock* tail, uint32_t count);
+
+    uintptr_t base_;
+    bool reserved_ok_;
+    std::atomic<size_t> committed_end_{0};
+    std::atomic<size_t> slabs_carved_{0};
+    Depot depots_[NUM_SIZE_CLASSES];
+};
+
+#endif // SLAB_ARENA_H
@@ -75,6 +75,20 @@ extern "C" void HeapManager_shutdown(void) {
     HeapManager::getInstance().shutdown();
 }
 
+// Slab arena control and heap_blocks_ debug tracking
+extern "C" void HeapManager_setSlabArenaEnabled(int enabled) {
+    HeapManager::getInstance().setSlabArenaEnabled(enabled != 0);
+}
+
+extern "C" void HeapManager_setHeapBlockTrackingEnabled(int enabled) {
+    HeapManager::getInstance().setHeapBlockTrackingEnabled(enabled != 0);
+}
+
+// Opt-in Bloom filter double-free diagnostics (commits 12MB when enabled)
+extern "C" void HeapManager_setBloomFilterEnabled(int enabled) {
+    HeapManager::getInstance().setBloomFilterEnabled(enabled != 0);
+}
+
 // SAMM: RETAIN allocation variants
 extern "C" void* HeapManager_allocObjectRetained(size_t size, int parent_scope_offset) {
     return HeapManager::getInstance().allocObjectRetained(size, parent_scope_offset);
@@ -92,6 +106,15 @@ extern "C" void* HeapManager_allocListRetained(int parent_scope_offset) {
     return HeapManager::getInstance().allocListRetained(parent_scope_offset);
 }
 
+// SAMM: scope-local allocation variants (released by exitScope)
+extern "C" void* HeapManager_allocVecScoped(size_t numElements) {
+    return HeapManager::getInstance().allocVecScoped(numElements);
+}
+
+extern "C" void* HeapManager_allocStringScoped(size_t numChars) {
+    return HeapManager::getInstance().allocStringScoped(numChars);
+}
+
 // Manual SAMM tracking for custom allocators
 extern "C" void HeapManager_trackInCurrentScope(void* ptr) {
     HeapManager::getInstance().trackInCurrentScope(ptr);
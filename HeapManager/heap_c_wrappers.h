@@ -22,12 +22,21 @@ void HeapManager_handleMemoryPressure(void);
 void HeapManager_waitForSAMM(void);
 void HeapManager_shutdown(void);
 
+// Slab arena control and heap_blocks_ debug tracking
+void HeapManager_setSlabArenaEnabled(int enabled);
+void HeapManager_setHeapBlockTrackingEnabled(int enabled);
+void HeapManager_setBloomFilterEnabled(int enabled);
+
 // SAMM: RETAIN allocation variants
 void* HeapManager_allocObjectRetained(size_t size, int parent_scope_offset);
 void* HeapManager_allocVecRetained(size_t numElements, int parent_scope_offset);
 void* HeapManager_allocStringRetained(size_t numChars, int parent_scope_offset);
 void* HeapManager_allocListRetained(int parent_scope_offset);
 
+// SAMM: scope-local allocation variants (released by exitScope)
+void* HeapManager_allocVecScoped(size_t numElements);
+void* HeapManager_allocStringScoped(size_t numChars);
+
 #ifdef __cplusplus
 }
 #endif
@@ -78,13 +78,16 @@ void print_runtime_metrics(void) {
            g_total_allocs - g_total_frees, 
            g_total_bytes_allocated - g_total_bytes_freed);
     
-    // Bloom filter metrics
+    // Double-free detection metrics
     HeapManager& heap_mgr = HeapManager::getInstance();
-    printf("Bloom filter statistics:\n");
-    printf("  Items tracked: %zu\n", heap_mgr.getBloomFilterItemsAdded());
-    printf("  Memory usage: %zu bytes\n", heap_mgr.getBloomFilterMemoryUsage());
-    printf("  False positives: %zu\n", heap_mgr.getBloomFilterFalsePositives());
-    printf("  Est. false positive rate: %.4f%%\n", heap_mgr.getBloomFilterFalsePositiveRate() * 100.0);
+    printf("Freed-block tombstones: %zu\n", heap_mgr.getFreedTombstoneCount());
+    if (heap_mgr.isBloomFilterEnabled()) {
+        printf("Bloom filter statistics:\n");
+        printf("  Items tracked: %zu\n", heap_mgr.getBloomFilterItemsAdded());
+        printf("  Memory usage: %zu bytes\n", heap_mgr.getBloomFilterMemoryUsage());
+        printf("  False positives: %zu\n", heap_mgr.getBloomFilterFalsePositives());
+        printf("  Est. false positive rate: %.4f%%\n", heap_mgr.getBloomFilterFalsePositiveRate() * 100.0);
+    }
     
     printf("File I/O operations:\n");
     printf("  Files opened: %zu\n", g_files_opened);
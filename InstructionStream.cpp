@@ -2,6 +2,7 @@
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
+#include <iterator>
 
 InstructionStream::InstructionStream(LabelManager& label_manager, bool trace_enabled)
     : label_manager_(label_manager), trace_enabled_(trace_enabled) {}
@@ -127,6 +128,29 @@ void InstructionStream::replace_instructions(const std::vector<Instruction>& new
     instructions_ = new_instructions;
 }
 
+void InstructionStream::replace_instructions(std::vector<Instruction>&& new_instructions) {
+    instructions_ = std::move(new_instructions);
+}
+
+/**
+ * @brief Moves the internal instruction vector out, leaving the stream empty.
+ */
+std::vector<Instruction> InstructionStream::take_instructions() {
+    std::vector<Instruction> taken;
+    taken.swap(instructions_);
+    return taken;
+}
+
+void InstructionStream::append_instructions(std::vector<Instruction>&& instructions) {
+    if (instructions_.empty()) {
+        instructions_ = std::move(instructions);
+        return;
+    }
+    instructions_.insert(instructions_.end(), std::make_move_iterator(instructions.begin()),
+                         std::make_move_iterator(instructions.end()));
+    instructions.clear();
+}
+
 /**
  * @brief Returns an estimation of the current address in bytes.
  * This is used for branch offset calculations when checking if a function
@@ -72,6 +72,20 @@ public:
      * This is used by the optimizer to commit its changes.
      */
     void replace_instructions(const std::vector<Instruction>& new_instructions);
+    void replace_instructions(std::vector<Instruction>&& new_instructions);
+
+    /**
+     * @brief Moves the instructions out of the stream, leaving it empty.
+     * For passes that rewrite the whole stream and hand it back with
+     * replace_instructions(), without copying it either way.
+     */
+    std::vector<Instruction> take_instructions();
+
+    /**
+     * @brief Moves a fragment's instructions to the end of the stream.
+     * Used to join the fragments of per-function code generation (--jobs N).
+     */
+    void append_instructions(std::vector<Instruction>&& instructions);
 
     // Adds a vector of data instructions to the stream and defines their labels.
     void add_data_instructions(const std::vector<Instruction>& data_instructions);
@@ -0,0 +1,42 @@
+#include "InternedString.h"
+#include <mutex>
+#include <unordered_set>
+
+namespace {
+
+// Sharded by hash so concurrent code generators rarely share a lock.
+// Each shard is node-based: the address of a pooled string never changes.
+constexpr size_t POOL_SHARDS = 16;
+
+struct PoolShard {
+    std::mutex mutex;
+    std::unordered_set<std::string> strings;
+};
+
+PoolShard* pool() {
+    static PoolShard* shards = new PoolShard[POOL_SHARDS]; // never destroyed: outlives static Instructions
+    return shards;
+}
+
+} // namespace
+
+const std::string& InternedString::empty_string() {
+    static const std::string* empty = new std::string();
+    return *empty;
+}
+
+const std::string* InternedString::intern(const std::string& s) {
+    PoolShard& shard = pool()[std::hash<std::string>()(s) % POOL_SHARDS];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return &*shard.strings.insert(s).first;
+}
+
+size_t InternedString::pool_size() {
+    size_t total = 0;
+    PoolShard* shards = pool();
+    for (size_t i = 0; i < POOL_SHARDS; ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        total += shards[i].strings.size();
+    }
+    return total;
+}
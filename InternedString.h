@@ -0,0 +1,96 @@
+#ifndef INTERNED_STRING_H
+#define INTERNED_STRING_H
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+
+// An immutable string stored once in a process-wide pool.
+//
+// The object is a single pointer, so copying one is a pointer copy and
+// comparing two is a pointer compare. Instruction uses it for its assembly
+// text and label fields: they are copied with every instruction, but a big
+// module repeats the same lines and names many times over. It converts
+// implicitly to const std::string&, so code that reads the text as a string
+// does not change; code that edits it assigns a new value.
+//
+// Interning is thread-safe. The pool is process-wide and its entries are
+// never freed: the compiler builds one program per process, and a string
+// may still be referenced by a static Instruction at exit.
+class InternedString {
+public:
+    InternedString() : str_(&empty_string()) {}
+    InternedString(const std::string& s) : str_(s.empty() ? &empty_string() : intern(s)) {}
+    InternedString(const char* s) : InternedString(std::string(s ? s : "")) {}
+
+    const std::string& str() const { return *str_; }
+    operator const std::string&() const { return *str_; }
+
+    // Read-only std::string conveniences
+    const char* c_str() const { return str_->c_str(); }
+    bool empty() const { return str_->empty(); }
+    size_t size() const { return str_->size(); }
+    size_t length() const { return str_->length(); }
+    char operator[](size_t i) const { return (*str_)[i]; }
+    char front() const { return str_->front(); }
+    char back() const { return str_->back(); }
+    std::string::const_iterator begin() const { return str_->begin(); }
+    std::string::const_iterator end() const { return str_->end(); }
+    size_t find(const std::string& s, size_t pos = 0) const { return str_->find(s, pos); }
+    size_t find(const char* s, size_t pos = 0) const { return str_->find(s, pos); }
+    size_t find(char c, size_t pos = 0) const { return str_->find(c, pos); }
+    size_t rfind(const std::string& s, size_t pos = std::string::npos) const { return str_->rfind(s, pos); }
+    size_t rfind(char c, size_t pos = std::string::npos) const { return str_->rfind(c, pos); }
+    std::string substr(size_t pos = 0, size_t n = std::string::npos) const { return str_->substr(pos, n); }
+    int compare(const std::string& s) const { return str_->compare(s); }
+    int compare(size_t pos, size_t n, const std::string& s) const { return str_->compare(pos, n, s); }
+
+    void clear() { str_ = &empty_string(); }
+
+    // Appending interns the concatenation; the old string stays pooled.
+    InternedString& operator+=(const std::string& s) { return *this = InternedString(*str_ + s); }
+    InternedString& operator+=(const char* s) { return *this = InternedString(*str_ + s); }
+    InternedString& operator+=(char c) { return *this = InternedString(*str_ + c); }
+
+    friend bool operator==(InternedString a, InternedString b) { return a.str_ == b.str_; }
+    friend bool operator!=(InternedString a, InternedString b) { return a.str_ != b.str_; }
+    friend bool operator==(InternedString a, const std::string& b) { return *a.str_ == b; }
+    friend bool operator!=(InternedString a, const std::string& b) { return *a.str_ != b; }
+    friend bool operator==(const std::string& a, InternedString b) { return a == *b.str_; }
+    friend bool operator!=(const std::string& a, InternedString b) { return a != *b.str_; }
+    friend bool operator==(InternedString a, const char* b) { return *a.str_ == b; }
+    friend bool operator!=(InternedString a, const char* b) { return *a.str_ != b; }
+    friend bool operator<(InternedString a, InternedString b) { return *a.str_ < *b.str_; }
+
+    friend std::string operator+(InternedString a, const std::string& b) { return *a.str_ + b; }
+    friend std::string operator+(const std::string& a, InternedString b) { return a + *b.str_; }
+    friend std::string operator+(InternedString a, const char* b) { return *a.str_ + b; }
+    friend std::string operator+(const char* a, InternedString b) { return a + *b.str_; }
+
+    friend std::ostream& operator<<(std::ostream& out, InternedString s) { return out << *s.str_; }
+
+    // Number of distinct strings interned so far
+    static size_t pool_size();
+
+private:
+    explicit InternedString(const std::string* s) : str_(s) {}
+
+    static const std::string& empty_string();
+    static const std::string* intern(const std::string& s);
+
+    const std::string* str_;
+
+    friend struct std::hash<InternedString>;
+};
+
+namespace std {
+template <>
+struct hash<InternedString> {
+    size_t operator()(InternedString s) const noexcept {
+        return std::hash<const std::string*>()(s.str_);
+    }
+};
+} // namespace std
+
+#endif // INTERNED_STRING_H
@@ -1,15 +1,22 @@
 #include "LabelManager.h"
 #include <stdexcept>
+#include <utility>
 #include "RuntimeManager.h"
 
 LabelManager::LabelManager() : next_label_id_(0) {
     // Initialize runtime labels if needed (currently predefined in header)
 }
 
-// No public constructor: singleton pattern
+LabelManager::LabelManager(std::string prefix)
+    : next_label_id_(0), label_prefix_(std::move(prefix)) {}
+
+void LabelManager::set_prefix(std::string prefix) {
+    label_prefix_ = std::move(prefix);
+    next_label_id_ = 0;
+}
 
 std::string LabelManager::create_label() {
-    return ".L" + std::to_string(next_label_id_++);
+    return label_prefix_ + std::to_string(next_label_id_++);
 }
 
 // --- Helper methods for codegen compatibility ---
@@ -8,7 +8,8 @@
 #include <stdexcept>
 
 // The LabelManager creates and defines labels, mapping their names to addresses.
-// Singleton pattern: only one instance exists.
+// The singleton defines every label at link time. Code generation workers
+// (--jobs N) each create labels through a LabelManager of their own.
 class LabelManager {
 public:
     // Singleton accessor
@@ -17,6 +18,13 @@ public:
         return instance;
     }
 
+    // A worker's label manager: its labels start with `prefix` instead of ".L".
+    explicit LabelManager(std::string prefix);
+
+    // Restarts label numbering under a new prefix, so each function compiled
+    // by a worker gets the same labels whichever thread compiles it.
+    void set_prefix(std::string prefix);
+
     // Checks if a label corresponds to a runtime routine
     bool is_runtime_label(const std::string& label_name) const;
 
@@ -51,7 +59,7 @@ public:
     const std::unordered_map<std::string, size_t>& get_defined_labels() const { return defined_labels_; }
 
 private:
-    // Private constructor for singleton
+    // Private constructor for the singleton
     LabelManager();
     // Delete copy/move to enforce singleton
     LabelManager(const LabelManager&) = delete;
@@ -61,6 +69,7 @@ private:
 
     std::unordered_map<std::string, size_t> defined_labels_;
     size_t next_label_id_;
+    std::string label_prefix_ = ".L";
 
     // List of runtime routine labels for identification
     const std::unordered_map<std::string, bool> runtime_labels_ = {
@@ -98,6 +98,15 @@ Lexer::Lexer(std::string source, bool trace)
 }
 
 Token Lexer::get_next_token() {
+    if (!lookahead_.empty()) {
+        Token token = std::move(lookahead_.front());
+        lookahead_.pop_front();
+        return token;
+    }
+    return scan_token();
+}
+
+Token Lexer::scan_token() {
     skip_whitespace_and_comments();
 
     if (is_at_end()) {
@@ -123,7 +132,8 @@ Token Lexer::get_next_token() {
         token = make_token(TokenType::RBrace);
     } else if (std::isalpha(current_char) || current_char == '_') {
         token = scan_identifier_or_keyword();
-    } else if (std::isdigit(current_char) || current_char == '#') {
+    } else if (std::isdigit(current_char) || (current_char == '#' && peek_next_char() != '%')) {
+        // '#' starts an octal or #X hex number, except in the FVEC operator #%
         token = scan_number();
     } else if (current_char == '"') {
         token = scan_string();
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <deque>
 #include <unordered_map>
 
 enum class TokenType {
@@ -79,7 +80,13 @@ class Lexer {
 public:
     Lexer(std::string source, bool trace = false);
     Token get_next_token();
-    Token peek() const;
+
+    // Returns the token `ahead` places after the next one (0 = the token the
+    // next get_next_token() will return) without consuming it. Tokens are
+    // scanned once into a lookahead buffer and handed out from there, so
+    // peeking costs one scan no matter how large the source is. The
+    // reference is valid until the next call to get_next_token().
+    const Token& peek(size_t ahead = 0);
 
 public:
     std::string source_;
@@ -90,6 +97,9 @@ private:
     bool trace_enabled_;
     bool last_token_was_value_; // Add this state variable
     static const std::unordered_map<std::string, TokenType> keywords_;
+    std::deque<Token> lookahead_; // Scanned but not yet consumed tokens
+
+    Token scan_token();
 
     char advance();
     char peek_char() const;
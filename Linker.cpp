@@ -73,7 +73,7 @@ std::vector<Instruction> Linker::process(
      if (enable_tracing) std::cerr << "[LINKER-PASS1] Starting address and label assignment...\n";
 
      std::vector<Instruction> finalized_instructions;
-     finalized_instructions.reserve(stream.get_instructions().size());
+     finalized_instructions.reserve(stream.get_instructions_ref().size());
 
      // --- Correct Cursor Management ---
      size_t code_cursor = code_base_address;
@@ -82,7 +82,7 @@ std::vector<Instruction> Linker::process(
 
      // --- Pass 1a: Calculate the total size of the code segment to find where .rodata starts ---
      size_t code_segment_size = 0;
-     for (const auto& instr : stream.get_instructions()) {
+     for (const auto& instr : stream.get_instructions_ref()) {
          if (instr.segment == SegmentType::CODE) {
              if (!instr.is_label_definition) {
                  code_segment_size += 4;
@@ -100,7 +100,7 @@ std::vector<Instruction> Linker::process(
      }
 
      // --- Pass 1b: Assign final addresses to all instructions and define all labels ---
-     for (const auto& instr : stream.get_instructions()) {
+     for (const auto& instr : stream.get_instructions_ref()) {
          Instruction new_instr = instr;
 
          // Determine which cursor to use based on the segment
@@ -513,8 +513,8 @@ std::map<std::string, int> LivenessAnalysisPass::calculate_register_pressure() c
             BasicBlock* block = block_pair.second.get();
 
             // Find the size of the in-set and out-set for the current block
-            size_t in_size = get_in_set(block).size();
-            size_t out_size = get_out_set(block).size();
+            size_t in_size = live_count(func_name, block, false);
+            size_t out_size = live_count(func_name, block, true);
 
             // The register pressure at this block's boundaries is the max of the two
             int current_max = std::max(in_size, out_size);
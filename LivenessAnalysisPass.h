@@ -8,6 +8,8 @@
 #include <set>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <cstdint>
 
 class LivenessAnalysisPass : public ASTVisitor {
 public:
@@ -26,7 +28,13 @@ public:
     // Main entry point to run the analysis.
     void run();
 
+    // Number of threads for the per-function dataflow solve (--jobs N).
+    // Tracing forces a single thread so the output stays readable.
+    void set_jobs(unsigned jobs) { jobs_ = jobs ? jobs : 1; }
+
     // Public methods to access the results.
+    // String views of the bit-vector results, materialised once after the
+    // dataflow converges (compatibility with LiveIntervalPass and tracing).
     const std::set<std::string>& get_in_set(BasicBlock* block) const;
     const std::set<std::string>& get_out_set(BasicBlock* block) const;
     void print_results() const;
@@ -116,6 +124,28 @@ private:
     // Symbol table for variable lookup
     SymbolTable* symbol_table_;
 
+    // Dense bit vector over a function's variable IDs (64 variables per word).
+    using LiveBits = std::vector<uint64_t>;
+
+    // Per-function dataflow state: variables are numbered densely in the
+    // order first seen, so set union/difference are word-wide OR / AND-NOT.
+    struct FunctionLiveness {
+        std::vector<std::string> var_names;                 // id -> name
+        std::unordered_map<std::string, uint32_t> var_ids;  // name -> id
+        std::unordered_map<BasicBlock*, size_t> block_index;
+        std::vector<LiveBits> in_bits;
+        std::vector<LiveBits> out_bits;
+    };
+    std::unordered_map<std::string, FunctionLiveness> function_liveness_;
+
+    // Solve one function's CFG with a worklist seeded in post-order. Reads
+    // only the use/def/call sets, so functions can be solved concurrently.
+    void solve_function(const std::string& func_name, const ControlFlowGraph& cfg,
+                        FunctionLiveness& fl, LivenessSets& in_sets, LivenessSets& out_sets) const;
+
+    // Number of variables live into (or out of) a block, by popcount.
+    size_t live_count(const std::string& func_name, BasicBlock* block, bool live_out) const;
+
     // Storage for the results.
     LivenessSets use_sets_;
     LivenessSets def_sets_;
@@ -147,6 +177,8 @@ private:
     std::map<BasicBlock*, std::set<std::string>> vars_used_across_calls_per_block_;
     
     BasicBlock* current_block_being_analyzed_;
+
+    unsigned jobs_ = 1;
     
     // Helper methods for intra-block call interval analysis
     void collect_variable_uses(ASTNode* node, std::set<std::string>& vars);
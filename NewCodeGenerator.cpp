@@ -20,6 +20,8 @@
 #include <vector>     // For std::vector
 #include "InstructionDecoder.h" // For duplicate MOV detection
 #include <map>        // For std::map
+#include <set>        // For std::set
+#include <functional> // For std::function
 #include <stack>      // For std::stack
 #include "analysis/LiveInterval.h"
 #include "analysis/LinearScanAllocator.h"
@@ -612,7 +614,7 @@ NewCodeGenerator::NewCodeGenerator(InstructionStream& instruction_stream,
                                    const std::map<std::string, std::map<std::string, LiveInterval>>& all_allocations,
                                    bool is_jit_mode,
                                    ClassTable* class_table,
-                                   LivenessAnalysisPass& liveness_analyzer,
+                                   const LivenessAnalysisPass& liveness_analyzer,
                                    bool bounds_checking_enabled,
                                    bool use_neon)
 : instruction_stream_(instruction_stream),
@@ -709,7 +711,7 @@ VarType NewCodeGenerator::infer_expression_type_local(const Expression* expr) co
             if (func_name == "AS_LIST") return VarType::POINTER_TO_ANY_LIST;
             if (func_name == "LIST" || func_name == "COPYLIST" || func_name == "DEEPCOPYLIST") return VarType::POINTER_TO_ANY_LIST;
             if (func_name == "SPLIT") return VarType::POINTER_TO_STRING_LIST;
-            if (func_name == "JOIN") return VarType::POINTER_TO_STRING;
+            if (func_name == "JOIN" || func_name == "SB_STRING") return VarType::POINTER_TO_STRING;
             
             auto& return_types = analyzer_.get_function_return_types();
             auto it = return_types.find(func_var->name);
@@ -1055,7 +1057,7 @@ void NewCodeGenerator::visit(BinaryOp& node) {
             auto var_alloc_it = current_function_allocs.find(var_access->name);
             if (var_alloc_it != current_function_allocs.end()) {
                 const LiveInterval& allocation = var_alloc_it->second;
-                if (!allocation.is_spilled && allocation.assigned_register == left_reg) {
+                if (!allocation.is_spilled && allocation.assigned_register_name() == left_reg) {
                     left_is_variable_home = true;
                 }
             }
@@ -2176,6 +2178,10 @@ void NewCodeGenerator::generate_code(Program& program) {
     // STEP 1: Pre-Analysis Scan - Find all external function calls
     debug_print("Step 1: Performing pre-analysis scan for external functions...");
     std::set<std::string> external_functions = external_scanner_.scan(program);
+    if (compact_strings_) {
+        // Character stores may promote a compact string.
+        external_functions.insert("BCPL_STRING_PROMOTE");
+    }
     
     debug_print("Found " + std::to_string(external_functions.size()) + " unique external functions:");
     for (const std::string& func_name : external_functions) {
@@ -2374,8 +2380,8 @@ void NewCodeGenerator::handle_member_access_assignment(MemberAccessExpression* m
     auto alloc_it = current_function_allocation_.find(member_access->member_name);
     if (alloc_it != current_function_allocation_.end()) {
         const LiveInterval& allocation = alloc_it->second;
-        if (!allocation.is_spilled && !allocation.assigned_register.empty()) {
-            const std::string& home_reg = allocation.assigned_register;
+        if (!allocation.is_spilled && allocation.assigned_register) {
+            const std::string home_reg = allocation.assigned_register->name();
             if (home_reg != value_to_store_reg) {
                 debug_print("  Updating home register " + home_reg + " for member '" + member_access->member_name + "' after store.");
                 if (register_manager_.is_fp_register(home_reg)) {
@@ -2446,19 +2452,8 @@ void NewCodeGenerator::visit(NewExpression& node) {
             }
         }
 
-        // Load method address from the vtable (get slot from ClassMethodInfo)
-        size_t create_slot = create_method_info->vtable_slot;
-        std::string vtable_ptr_reg = register_manager_.acquire_scratch_reg(*this);
-        std::string method_addr_reg = register_manager_.acquire_scratch_reg(*this);
-
-        emit(Encoder::create_ldr_imm(vtable_ptr_reg, obj_ptr_reg, 0, "Load vtable pointer for CREATE call"));
-        emit(Encoder::create_ldr_imm(method_addr_reg, vtable_ptr_reg, create_slot * 8, "Load CREATE method address"));
-
-        // Make the call
-        emit(Encoder::create_branch_with_link_register(method_addr_reg));
-
-        register_manager_.release_register(vtable_ptr_reg);
-        register_manager_.release_register(method_addr_reg);
+        // The object was just given this class's vtable, so call its CREATE directly
+        emit_method_dispatch(node.class_name, *create_method_info, node.class_name);
     }
 
     // --- STEP 4: The result of the NEW expression is the object pointer ---
@@ -2503,8 +2498,8 @@ void NewCodeGenerator::handle_member_variable_assignment(const std::string& var_
     auto alloc_it = current_function_allocation_.find(var_name);
     if (alloc_it != current_function_allocation_.end()) {
         const LiveInterval& allocation = alloc_it->second;
-        if (!allocation.is_spilled && !allocation.assigned_register.empty()) {
-            const std::string& home_reg = allocation.assigned_register;
+        if (!allocation.is_spilled && allocation.assigned_register) {
+            const std::string home_reg = allocation.assigned_register->name();
             if (home_reg != value_to_store_reg) {
                 debug_print("  Updating home register " + home_reg + " for member '" + var_name + "' after store.");
                 if (register_manager_.is_fp_register(home_reg)) {
@@ -2574,8 +2569,8 @@ void NewCodeGenerator::handle_variable_assignment(VariableAccess* var_access, co
     auto alloc_it = current_function_allocation_.find(var_access->name);
     if (alloc_it != current_function_allocation_.end()) {
         const LiveInterval& allocation = alloc_it->second;
-        if (!allocation.is_spilled && !allocation.assigned_register.empty()) {
-            const std::string& home_reg = allocation.assigned_register;
+        if (!allocation.is_spilled && allocation.assigned_register) {
+            const std::string home_reg = allocation.assigned_register->name();
             if (home_reg != final_reg_to_store) {
                 debug_print("  Updating home register " + home_reg + " for variable '" + var_access->name + "' after store.");
                 if (register_manager_.is_fp_register(home_reg)) {
@@ -2608,24 +2603,16 @@ void NewCodeGenerator::handle_vector_assignment(VectorAccess* vec_access, const
     generate_expression_code(*vec_access->index_expr);
     std::string index_reg = expression_result_reg_;
 
-    // 3. Calculate the byte offset: index * 8 (for 64-bit words)
-    std::string offset_reg = register_manager_.acquire_scratch_reg(*this);
-    emit(Encoder::create_lsl_imm(offset_reg, index_reg, 3));
-    debug_print("Calculated byte offset for vector assignment.");
-
-    // 4. Calculate the effective memory address: base + offset
-    std::string effective_addr_reg = register_manager_.acquire_scratch_reg(*this);
-    emit(Encoder::create_add_reg(effective_addr_reg, vector_base_reg, offset_reg));
-    debug_print("Calculated effective address for vector assignment.");
+    // 3. Store the RHS value to base + index * 8 with one scaled register-offset
+    //    STR, which leaves the index register untouched
+    Instruction str_instr = Encoder::create_str_scaled_reg_64bit(value_to_store_reg, vector_base_reg, index_reg, 3);
+    str_instr.nopeep = true; // Protect from peephole optimization
+    emit(str_instr);
+    debug_print("Stored value to vector element.");
 
     // Release registers used for address calculation
     register_manager_.release_register(vector_base_reg);
     register_manager_.release_register(index_reg);
-    register_manager_.release_scratch_reg(offset_reg);
-
-    // 5. Store the RHS value to the effective address
-    emit(Encoder::create_str_imm(value_to_store_reg, effective_addr_reg, 0));
-    debug_print("Stored value to vector element.");
 
     // ====================== START OF FIX ======================
     // After storing, we must synchronize the home register for the vector variable itself,
@@ -2634,8 +2621,8 @@ void NewCodeGenerator::handle_vector_assignment(VectorAccess* vec_access, const
         auto alloc_it = current_function_allocation_.find(base_var->name);
         if (alloc_it != current_function_allocation_.end()) {
             const LiveInterval& allocation = alloc_it->second;
-            if (!allocation.is_spilled && !allocation.assigned_register.empty()) {
-                const std::string& home_reg = allocation.assigned_register;
+            if (!allocation.is_spilled && allocation.assigned_register) {
+                const std::string home_reg = allocation.assigned_register->name();
                 if (home_reg != vector_base_reg) {
                     debug_print("  Synchronizing home register " + home_reg + " for vector '" + base_var->name + "' after store.");
                     emit(Encoder::create_mov_reg(home_reg, vector_base_reg));
@@ -2647,7 +2634,6 @@ void NewCodeGenerator::handle_vector_assignment(VectorAccess* vec_access, const
 
     // Release registers used in the store
     register_manager_.release_register(value_to_store_reg);
-    register_manager_.release_scratch_reg(effective_addr_reg);
 }
 
 void NewCodeGenerator::handle_char_indirection_assignment(CharIndirection* char_indirection, const std::string& value_to_store_reg) {
@@ -2659,32 +2645,29 @@ void NewCodeGenerator::handle_char_indirection_assignment(CharIndirection* char_
     generate_expression_code(*char_indirection->index_expr);
     std::string index_reg = expression_result_reg_;
 
-    // 3. Calculate the byte offset: index * 4 (for 32-bit characters in BCPL)
-    emit(Encoder::create_lsl_imm(index_reg, index_reg, 2));
-    debug_print("Calculated byte offset for char indirection assignment.");
-
-    // 4. Calculate the effective memory address: base + offset
-    std::string effective_addr_reg = register_manager_.get_free_register(*this);
-    emit(Encoder::create_add_reg(effective_addr_reg, string_base_reg, index_reg));
-    debug_print("Calculated effective address for char indirection assignment.");
-
-    // Release registers used for address calculation
+    if (compact_strings_) {
+        // 3. Store according to the string's storage class.
+        generate_compact_aware_char_store(string_base_reg, index_reg, value_to_store_reg);
+    } else {
+        // 3. Store the low 32 bits of the RHS value (a character) to base + index * 4.
+        //    The scaled register-offset STR leaves the index register untouched.
+        Instruction str_instr = Encoder::create_str_word_scaled_reg(value_to_store_reg, string_base_reg, index_reg, 2);
+        str_instr.nopeep = true; // Protect from peephole optimization
+        emit(str_instr);
+        generate_exact_length_clear(string_base_reg, value_to_store_reg);
+        debug_print("Stored value to character element.");
+    }
     register_manager_.release_register(string_base_reg);
     register_manager_.release_register(index_reg);
 
-    // 5. Store the RHS value to the effective address (using STR for 32-bit word for char)
-    // FIX: Use the new 32-bit store instruction for character assignment
-    emit(Encoder::create_str_word_imm(value_to_store_reg, effective_addr_reg, 0));
-    debug_print("Stored value to character element.");
-
     // ====================== START OF FIX ======================
     // Add the same synchronization logic here for the string base pointer.
     if (auto* base_var = dynamic_cast<VariableAccess*>(char_indirection->string_expr.get())) {
         auto alloc_it = current_function_allocation_.find(base_var->name);
         if (alloc_it != current_function_allocation_.end()) {
             const LiveInterval& allocation = alloc_it->second;
-            if (!allocation.is_spilled && !allocation.assigned_register.empty()) {
-                const std::string& home_reg = allocation.assigned_register;
+            if (!allocation.is_spilled && allocation.assigned_register) {
+                const std::string home_reg = allocation.assigned_register->name();
                 if (home_reg != string_base_reg) {
                     debug_print("  Synchronizing home register " + home_reg + " for string '" + base_var->name + "' after store.");
                     emit(Encoder::create_mov_reg(home_reg, string_base_reg));
@@ -2696,7 +2679,126 @@ void NewCodeGenerator::handle_char_indirection_assignment(CharIndirection* char_
 
     // Release registers used in the store
     register_manager_.release_register(value_to_store_reg);
-    register_manager_.release_register(effective_addr_reg);
+}
+
+// The store counterpart of generate_compact_aware_char_load. A compact
+// string only holds code points up to U+00FF; a wider one promotes it first
+// (BCPL_STRING_PROMOTE), after which the store goes to the UTF-32 copy:
+//
+// retry:   LDR hdr, [base, #-8] ; UBFX tag, hdr, #62, #2
+//          CMP tag, #2 ; B.EQ compact
+//          CMP tag, #1 ; B.NE wide
+//          LDR addr_base, [base] ; B wide_store   ; promoted
+// compact: CMP value, #255 ; B.HI promote
+//          STRB Wvalue, [base, index] ; B done
+// promote: save X0-X17, X30 ; X0 = base ; BL BCPL_STRING_PROMOTE
+//          restore ; B retry
+// wide:    STR Wvalue, [base, index, LSL #2]
+// done:
+void NewCodeGenerator::generate_compact_aware_char_store(const std::string& string_base_reg, const std::string& index_reg,
+                                                         const std::string& value_reg) {
+    std::string retry_label = label_manager_.create_label();
+    std::string compact_label = label_manager_.create_label();
+    std::string promote_label = label_manager_.create_label();
+    std::string wide_label = label_manager_.create_label();
+    std::string wide_store_label = label_manager_.create_label();
+    std::string done_label = label_manager_.create_label();
+
+    std::string tag_reg = register_manager_.get_free_register(*this);
+    std::string addr_reg = register_manager_.get_free_register(*this);
+    std::string w_value_reg = "W" + value_reg.substr(1);
+
+    instruction_stream_.define_label(retry_label);
+    emit(Encoder::create_sub_imm(tag_reg, string_base_reg, 8));
+    emit(Encoder::create_ldr_imm(tag_reg, tag_reg, 0, "Load string length word"));
+    emit(Encoder::opt_create_ubfx(tag_reg, tag_reg, 62, 2));
+    emit(Encoder::create_cmp_imm(tag_reg, 2));
+    emit(Encoder::create_branch_conditional("EQ", compact_label));
+    emit(Encoder::create_cmp_imm(tag_reg, 1));
+    emit(Encoder::create_branch_conditional("NE", wide_label));
+    emit(Encoder::create_ldr_imm(addr_reg, string_base_reg, 0, "Follow promoted string"));
+    emit(Encoder::create_branch_unconditional(wide_store_label));
+
+    instruction_stream_.define_label(compact_label);
+    emit(Encoder::create_cmp_imm(value_reg, 255));
+    emit(Encoder::create_branch_conditional("HI", promote_label));
+    Instruction compact_str = Encoder::create_strb_reg(w_value_reg, string_base_reg, index_reg);
+    compact_str.nopeep = true;
+    emit(compact_str);
+    emit(Encoder::create_branch_unconditional(done_label));
+
+    // Every caller-saved register is preserved: the expression being
+    // assigned may have live temporaries in any of them.
+    instruction_stream_.define_label(promote_label);
+    static const char* const saved_pairs[][2] = {
+        {"X0", "X1"}, {"X2", "X3"}, {"X4", "X5"}, {"X6", "X7"}, {"X8", "X9"},
+        {"X10", "X11"}, {"X12", "X13"}, {"X14", "X15"}, {"X16", "X17"}, {"X30", "XZR"},
+    };
+    for (const auto& pair : saved_pairs) {
+        emit(Encoder::create_stp_pre_imm(pair[0], pair[1], "SP", -16));
+    }
+    emit(Encoder::create_mov_reg("X0", string_base_reg));
+    if (veneer_manager_.has_veneer("BCPL_STRING_PROMOTE")) {
+        Instruction bl_instr = Encoder::create_branch_with_link(veneer_manager_.get_veneer_label("BCPL_STRING_PROMOTE"));
+        bl_instr.jit_attribute = JITAttribute::JitCall;
+        bl_instr.target_label = "BCPL_STRING_PROMOTE";
+        emit(bl_instr);
+    } else {
+        emit(Encoder::create_branch_with_link("BCPL_STRING_PROMOTE"));
+    }
+    for (int i = static_cast<int>(sizeof(saved_pairs) / sizeof(saved_pairs[0])) - 1; i >= 0; --i) {
+        emit(Encoder::create_ldp_post_imm(saved_pairs[i][0], saved_pairs[i][1], "SP", 16));
+    }
+    emit(Encoder::create_branch_unconditional(retry_label));
+
+    instruction_stream_.define_label(wide_label);
+    emit(Encoder::create_mov_reg(addr_reg, string_base_reg));
+    instruction_stream_.define_label(wide_store_label);
+    Instruction wide_str = Encoder::create_str_word_scaled_reg(w_value_reg, addr_reg, index_reg, 2);
+    wide_str.nopeep = true;
+    emit(wide_str);
+    generate_exact_length_clear(addr_reg, value_reg);
+
+    instruction_stream_.define_label(done_label);
+    register_manager_.release_register(tag_reg);
+    register_manager_.release_register(addr_reg);
+    debug_print("Stored value to character element (compact-aware).");
+}
+
+// A store of 0 below LEN moves a UTF-32 string's terminator, so it drops
+// the string's exact-length mark (bit 61 of the length word; see
+// runtime/string_kernels.h). Any other store leaves the length alone and
+// only pays for the first compare:
+//
+//          CMP value, #0 ; B.NE done
+//          LDR hdr, [base, #-8]            (SUB + LDR)
+//          UBFX tag, hdr, #61, #3 ; CMP tag, #1 ; B.NE done
+//          UBFX hdr, hdr, #0, #61 ; STR hdr, [base, #-8]
+// done:
+void NewCodeGenerator::generate_exact_length_clear(const std::string& string_base_reg, const std::string& value_reg) {
+    std::string done_label = label_manager_.create_label();
+    std::string header_addr_reg = register_manager_.get_free_register(*this);
+    std::string header_reg = register_manager_.get_free_register(*this);
+    std::string tag_reg = register_manager_.get_free_register(*this);
+
+    emit(Encoder::create_cmp_imm(value_reg, 0));
+    emit(Encoder::create_branch_conditional("NE", done_label));
+    emit(Encoder::create_sub_imm(header_addr_reg, string_base_reg, 8));
+    Instruction header_ldr = Encoder::create_ldr_imm(header_reg, header_addr_reg, 0, "Load string length word");
+    header_ldr.nopeep = true;
+    emit(header_ldr);
+    emit(Encoder::opt_create_ubfx(tag_reg, header_reg, 61, 3));
+    emit(Encoder::create_cmp_imm(tag_reg, 1));
+    emit(Encoder::create_branch_conditional("NE", done_label));
+    emit(Encoder::opt_create_ubfx(header_reg, header_reg, 0, 61));
+    Instruction header_str = Encoder::create_str_imm(header_reg, header_addr_reg, 0);
+    header_str.nopeep = true;
+    emit(header_str);
+
+    instruction_stream_.define_label(done_label);
+    register_manager_.release_register(tag_reg);
+    register_manager_.release_register(header_reg);
+    register_manager_.release_register(header_addr_reg);
 }
 
 
@@ -3233,8 +3335,9 @@ void NewCodeGenerator::generate_function_like_code(
     // Identify used callee-saved registers from allocation results
     std::set<std::string> used_callee_saved;
     for (const auto& [var_name, interval] : allocations) {
-        if (!interval.is_spilled && RegisterManager::is_callee_saved(interval.assigned_register)) {
-            used_callee_saved.insert(interval.assigned_register);
+        if (!interval.is_spilled && interval.assigned_register &&
+            RegisterManager::is_callee_saved(*interval.assigned_register)) {
+            used_callee_saved.insert(interval.assigned_register->name());
         }
     }
 
@@ -3334,12 +3437,12 @@ void NewCodeGenerator::generate_function_like_code(
             }
 
             // If the parameter is spilled, do not move it here; it will be loaded from the stack when accessed.
-            if (allocation.is_spilled || allocation.assigned_register.empty()) {
+            if (allocation.is_spilled || !allocation.assigned_register) {
                 continue;
             }
 
             // Parameter is assigned to a register: move to home register if needed
-            const std::string& home_reg = allocation.assigned_register;
+            const std::string home_reg = allocation.assigned_register->name();
             if (home_reg == arg_reg) {
                 debug_print("  Parameter '" + param_name + "' is already in its home register (" + home_reg + "). No MOV needed.");
                 register_manager_.set_initialized(home_reg, true);
@@ -3497,6 +3600,16 @@ void NewCodeGenerator::generate_function_like_code(
             stmt->accept(*this);
         }
 
+        // Bounds checks hoisted out of the FOR loop this block enters
+        if (bounds_checking_enabled_ && !block->hoisted_bounds_checks.empty()) {
+            generate_hoisted_bounds_checks(block);
+        }
+
+        // NEON loop over element pairs ahead of the FOR loop this block enters
+        if (!block->vectorized_statements.empty()) {
+            generate_vectorized_loop(block);
+        }
+
         // Generate the branching logic to connect this block to its successors
         generate_block_epilogue(block);
     }
@@ -3578,6 +3691,286 @@ void NewCodeGenerator::generate_function_like_code(
     analyzer_.set_current_function_scope(previous_analyzer_scope);
 }
 
+// --- CFG-driven codegen: hoisted bounds checks ---
+// Runs in a FOR loop's preheader after "i := start". If the loop will run
+// (i <= end), the loop reads v!(i + c) for every i up to end, so checking
+// start + min_offset and end + max_offset against LEN(v) covers every read.
+// An unsigned compare catches negative indices as it does in VectorAccess.
+void NewCodeGenerator::generate_hoisted_bounds_checks(BasicBlock* block) {
+    debug_print("Generating hoisted bounds checks for loop entered from " + block->id);
+    std::string skip_label = label_manager_.create_label();
+    std::string error_label = get_bounds_error_label_for_current_function();
+
+    VariableAccess loop_var(block->hoisted_loop_variable);
+    generate_expression_code(loop_var);
+    std::string start_reg = expression_result_reg_;
+    generate_expression_code(*block->hoisted_loop_end);
+    std::string end_reg = expression_result_reg_;
+
+    // The loop does not run, so none of its reads happen
+    emit(Encoder::create_cmp_reg(start_reg, end_reg));
+    emit(Encoder::create_branch_conditional("GT", skip_label));
+
+    for (const HoistedBoundsCheck& check : block->hoisted_bounds_checks) {
+        VariableAccess vector_var(check.vector_name);
+        generate_expression_code(vector_var);
+        std::string vector_base_reg = expression_result_reg_;
+
+        std::string length_reg = register_manager_.acquire_scratch_reg(*this);
+        emit(Encoder::create_sub_imm(length_reg, vector_base_reg, 8));
+        Instruction length_ldr = Encoder::create_ldr_imm(length_reg, length_reg, 0, "Load vector length for hoisted bounds check");
+        length_ldr.nopeep = true; // Protect from peephole optimization
+        emit(length_ldr);
+        register_manager_.release_register(vector_base_reg);
+
+        // Compares base + offset with the length, leaving base untouched
+        std::string index_reg = register_manager_.acquire_scratch_reg(*this);
+        auto check_index = [&](const std::string& base_reg, int64_t offset) {
+            if (offset > 0) {
+                emit(Encoder::create_add_imm(index_reg, base_reg, static_cast<int>(offset)));
+            } else if (offset < 0) {
+                emit(Encoder::create_sub_imm(index_reg, base_reg, static_cast<int>(-offset)));
+            } else {
+                emit(Encoder::create_mov_reg(index_reg, base_reg));
+            }
+            emit(Encoder::create_cmp_reg(index_reg, length_reg));
+            emit(Encoder::create_branch_conditional("HS", error_label));
+        };
+        if (check.check_start) {
+            check_index(start_reg, check.min_offset);
+        }
+        check_index(end_reg, check.max_offset);
+        register_manager_.release_register(index_reg);
+        register_manager_.release_register(length_reg);
+    }
+
+    register_manager_.release_register(start_reg);
+    register_manager_.release_register(end_reg);
+    instruction_stream_.define_label(skip_label);
+}
+
+// --- CFG-driven codegen: vectorized FOR loop ---
+// Runs in a FOR loop's preheader after "i := start" and any hoisted bounds
+// checks. While i < end, runs the statements LoopVectorizationPass marked for
+// elements i and i + 1 at once with NEON 2D operations, then leaves i at the
+// first element not done, for the scalar loop to finish. Each vector gets a
+// pointer to element i, advanced 16 bytes per iteration; each invariant is
+// duplicated into both lanes and each reduction sums into its own register.
+void NewCodeGenerator::generate_vectorized_loop(BasicBlock* block) {
+    debug_print("Generating vectorized loop for loop entered from " + block->id);
+    std::string loop_label = label_manager_.create_label();
+    std::string done_label = label_manager_.create_label();
+
+    VariableAccess loop_var(block->vectorized_loop_variable);
+    generate_expression_code(loop_var);
+    std::string start_reg = expression_result_reg_;
+    std::string index_reg = register_manager_.acquire_scratch_reg(*this);
+    emit(Encoder::create_mov_reg(index_reg, start_reg));
+    register_manager_.release_register(start_reg);
+    generate_expression_code(*block->vectorized_loop_end);
+    std::string end_reg = expression_result_reg_;
+
+    // Fewer than two elements to go: leave them all to the scalar loop
+    emit(Encoder::create_cmp_reg(index_reg, end_reg));
+    emit(Encoder::create_branch_conditional("GE", done_label));
+
+    std::map<std::string, std::string> pointers;
+    auto add_pointer = [&](const std::string& vector_name) {
+        if (pointers.count(vector_name)) return;
+        VariableAccess vector_var(vector_name);
+        generate_expression_code(vector_var);
+        std::string base_reg = expression_result_reg_;
+        std::string pointer_reg = register_manager_.acquire_scratch_reg(*this);
+        emit(Encoder::create_lsl_imm(pointer_reg, index_reg, 3));
+        emit(Encoder::create_add_reg(pointer_reg, base_reg, pointer_reg));
+        register_manager_.release_register(base_reg);
+        pointers[vector_name] = pointer_reg;
+    };
+    std::function<void(Expression*)> add_read_pointers = [&](Expression* expr) {
+        if (auto* access = dynamic_cast<VectorAccess*>(expr)) {
+            add_pointer(static_cast<VariableAccess*>(access->vector_expr.get())->name);
+        } else if (auto* bin = dynamic_cast<BinaryOp*>(expr)) {
+            add_read_pointers(bin->left.get());
+            add_read_pointers(bin->right.get());
+        }
+    };
+    std::set<std::string> stored;
+    for (VectorizedStatement& stmt : block->vectorized_statements) {
+        if (!stmt.is_reduction) {
+            add_pointer(stmt.target);
+            stored.insert(stmt.target);
+        }
+        add_read_pointers(stmt.value.get());
+    }
+
+    // Vectors one element apart would see each other's stores a pair at a
+    // time rather than one element at a time
+    std::string difference_reg = register_manager_.acquire_scratch_reg(*this);
+    for (auto a = pointers.begin(); a != pointers.end(); ++a) {
+        for (auto b = std::next(a); b != pointers.end(); ++b) {
+            if (!stored.count(a->first) && !stored.count(b->first)) continue;
+            emit(Encoder::create_sub_reg(difference_reg, a->second, b->second));
+            emit(Encoder::create_cmp_imm(difference_reg, 8));
+            emit(Encoder::create_branch_conditional("EQ", done_label));
+            emit(Encoder::create_sub_reg(difference_reg, b->second, a->second));
+            emit(Encoder::create_cmp_imm(difference_reg, 8));
+            emit(Encoder::create_branch_conditional("EQ", done_label));
+        }
+    }
+    register_manager_.release_register(difference_reg);
+
+    // Invariants in both lanes
+    std::map<std::string, std::string> variable_lanes;
+    std::map<Expression*, std::string> literal_lanes;
+    std::function<void(Expression*)> add_invariants = [&](Expression* expr) {
+        if (auto* bin = dynamic_cast<BinaryOp*>(expr)) {
+            add_invariants(bin->left.get());
+            add_invariants(bin->right.get());
+            return;
+        }
+        if (dynamic_cast<VectorAccess*>(expr)) return;
+        auto* var = dynamic_cast<VariableAccess*>(expr);
+        if (var && variable_lanes.count(var->name)) return;
+        generate_expression_code(*expr);
+        std::string scalar_reg = expression_result_reg_;
+        std::string lanes_reg = register_manager_.acquire_vec_scratch_reg();
+        if (register_manager_.is_fp_register(scalar_reg)) {
+            std::string bits_reg = register_manager_.acquire_scratch_reg(*this);
+            emit(Encoder::create_fmov_d_to_x(bits_reg, scalar_reg));
+            emit(Encoder::enc_create_dup_scalar(lanes_reg, bits_reg, "2D"));
+            register_manager_.release_register(bits_reg);
+        } else {
+            emit(Encoder::enc_create_dup_scalar(lanes_reg, scalar_reg, "2D"));
+        }
+        register_manager_.release_register(scalar_reg);
+        if (var) {
+            variable_lanes[var->name] = lanes_reg;
+        } else {
+            literal_lanes[expr] = lanes_reg;
+        }
+    };
+    std::vector<std::string> sums(block->vectorized_statements.size());
+    for (size_t k = 0; k < block->vectorized_statements.size(); ++k) {
+        VectorizedStatement& stmt = block->vectorized_statements[k];
+        add_invariants(stmt.value.get());
+        if (stmt.is_reduction) {
+            // Zero bits are 0 and +0.0 alike
+            sums[k] = register_manager_.acquire_vec_scratch_reg();
+            emit(Encoder::enc_create_dup_scalar(sums[k], "XZR", "2D"));
+        }
+    }
+
+    // Both lanes of an element expression; owned is false for an invariant's
+    // register, which stays live for the whole loop
+    std::function<std::string(Expression*, bool, bool&)> lanes_of = [&](Expression* expr, bool is_float, bool& owned) {
+        owned = true;
+        if (auto* access = dynamic_cast<VectorAccess*>(expr)) {
+            auto* vec = static_cast<VariableAccess*>(access->vector_expr.get());
+            std::string lanes_reg = register_manager_.acquire_vec_scratch_reg();
+            Instruction ldr = Encoder::create_ldr_vec_imm("Q" + lanes_reg.substr(1), pointers.at(vec->name), 0);
+            ldr.nopeep = true; // Protect from peephole optimization
+            emit(ldr);
+            return lanes_reg;
+        }
+        if (auto* bin = dynamic_cast<BinaryOp*>(expr)) {
+            bool left_owned = false;
+            bool right_owned = false;
+            std::string left_reg = lanes_of(bin->left.get(), is_float, left_owned);
+            std::string right_reg = lanes_of(bin->right.get(), is_float, right_owned);
+            std::string dest_reg = left_owned ? left_reg
+                                 : right_owned ? right_reg
+                                 : register_manager_.acquire_vec_scratch_reg();
+            switch (bin->op) {
+                case BinaryOp::Operator::Add:
+                    emit(is_float ? Encoder::create_fadd_vector_reg(dest_reg, left_reg, right_reg, "2D")
+                                  : Encoder::create_add_vector_reg(dest_reg, left_reg, right_reg, "2D"));
+                    break;
+                case BinaryOp::Operator::Subtract:
+                    emit(is_float ? Encoder::enc_create_fsub_vector_reg(dest_reg, left_reg, right_reg, "2D")
+                                  : Encoder::create_sub_vector_reg(dest_reg, left_reg, right_reg, "2D"));
+                    break;
+                case BinaryOp::Operator::Multiply:
+                    emit(Encoder::create_fmul_vector_reg(dest_reg, left_reg, right_reg, "2D"));
+                    break;
+                case BinaryOp::Operator::Divide:
+                    emit(Encoder::enc_create_fdiv_vector_reg(dest_reg, left_reg, right_reg, "2D"));
+                    break;
+                default:
+                    throw std::runtime_error("Unexpected operator in vectorized loop");
+            }
+            if (left_owned && right_owned) {
+                register_manager_.release_vec_scratch_reg(right_reg);
+            }
+            return dest_reg;
+        }
+        owned = false;
+        auto* var = dynamic_cast<VariableAccess*>(expr);
+        return var ? variable_lanes.at(var->name) : literal_lanes.at(expr);
+    };
+
+    instruction_stream_.define_label(loop_label);
+    for (size_t k = 0; k < block->vectorized_statements.size(); ++k) {
+        VectorizedStatement& stmt = block->vectorized_statements[k];
+        bool owned = false;
+        std::string lanes_reg = lanes_of(stmt.value.get(), stmt.is_float, owned);
+        if (stmt.is_reduction) {
+            emit(stmt.is_float ? Encoder::create_fadd_vector_reg(sums[k], sums[k], lanes_reg, "2D")
+                               : Encoder::create_add_vector_reg(sums[k], sums[k], lanes_reg, "2D"));
+        } else {
+            Instruction str = Encoder::create_str_vec_imm("Q" + lanes_reg.substr(1), pointers.at(stmt.target), 0);
+            str.nopeep = true; // Protect from peephole optimization
+            emit(str);
+        }
+        if (owned) {
+            register_manager_.release_vec_scratch_reg(lanes_reg);
+        }
+    }
+    for (const auto& pair : pointers) {
+        emit(Encoder::create_add_imm(pair.second, pair.second, 16));
+    }
+    emit(Encoder::create_add_imm(index_reg, index_reg, 2));
+    emit(Encoder::create_cmp_reg(index_reg, end_reg));
+    emit(Encoder::create_branch_conditional("LT", loop_label));
+
+    for (const auto& pair : pointers) {
+        register_manager_.release_register(pair.second);
+    }
+    for (const auto& pair : variable_lanes) {
+        register_manager_.release_vec_scratch_reg(pair.second);
+    }
+    for (const auto& pair : literal_lanes) {
+        register_manager_.release_vec_scratch_reg(pair.second);
+    }
+    register_manager_.release_register(end_reg);
+
+    // Fold each reduction's two lanes into lane 0 and add it to the variable
+    for (size_t k = 0; k < block->vectorized_statements.size(); ++k) {
+        VectorizedStatement& stmt = block->vectorized_statements[k];
+        if (!stmt.is_reduction) continue;
+        std::string lane_reg = "D" + sums[k].substr(1);
+        VariableAccess target(stmt.target);
+        generate_expression_code(target);
+        std::string scalar_reg = expression_result_reg_;
+        std::string total_reg;
+        if (stmt.is_float) {
+            emit(Encoder::create_faddp_vector_reg(sums[k], sums[k], sums[k], "2D"));
+            total_reg = register_manager_.acquire_fp_scratch_reg();
+            emit(Encoder::create_fadd_reg(total_reg, scalar_reg, lane_reg));
+        } else {
+            emit(Encoder::create_addp_vector_reg(sums[k], sums[k], sums[k], "2D"));
+            total_reg = register_manager_.acquire_scratch_reg(*this);
+            emit(Encoder::create_fmov_d_to_x(total_reg, lane_reg));
+            emit(Encoder::create_add_reg(total_reg, scalar_reg, total_reg));
+        }
+        register_manager_.release_register(scalar_reg);
+        register_manager_.release_vec_scratch_reg(sums[k]);
+        handle_variable_assignment(&target, total_reg);
+    }
+
+    handle_variable_assignment(&loop_var, index_reg);
+    instruction_stream_.define_label(done_label);
+}
+
 // --- CFG-driven codegen: block epilogue logic ---
 void NewCodeGenerator::generate_block_epilogue(BasicBlock* block) {
     if (block->successors.empty()) {
@@ -3700,9 +4093,9 @@ void NewCodeGenerator::generate_block_epilogue(BasicBlock* block) {
             // Load current loop variable value: use register if available, otherwise load from stack
             std::string loop_var_reg = register_manager_.acquire_scratch_reg(*this);
             auto alloc_it = current_function_allocation_.find(for_stmt->unique_loop_variable_name);
-            if (alloc_it != current_function_allocation_.end() && !alloc_it->second.is_spilled && !alloc_it->second.assigned_register.empty()) {
+            if (alloc_it != current_function_allocation_.end() && !alloc_it->second.is_spilled && alloc_it->second.assigned_register) {
                 // Variable is in a register
-                emit(Encoder::create_mov_reg(loop_var_reg, alloc_it->second.assigned_register));
+                emit(Encoder::create_mov_reg(loop_var_reg, alloc_it->second.assigned_register->name()));
             } else {
                 // Variable is spilled, load from stack
                 try {
@@ -4112,10 +4505,8 @@ size_t NewCodeGenerator::get_vector_size(ExprPtr& expr) {
     auto* var_access = dynamic_cast<VariableAccess*>(expr.get());
     if (!var_access) return 0;
     
-    Symbol symbol;
-    if (!symbol_table_->lookup(var_access->name, symbol)) return 0;
-    
-    return symbol.size;
+    const Symbol* symbol = symbol_table_->find(var_access->name);
+    return symbol ? symbol->size : 0;
 }
 
 void NewCodeGenerator::generate_simple_pair_loop(const std::string& left_addr,
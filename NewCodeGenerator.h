@@ -50,7 +50,7 @@ public:
                      const std::map<std::string, std::map<std::string, LiveInterval>>& all_allocations,
                      bool is_jit_mode,
                      ClassTable* class_table,
-                     LivenessAnalysisPass& liveness_analyzer,
+                     const LivenessAnalysisPass& liveness_analyzer,
                      bool bounds_checking_enabled,
                      bool use_neon = true);
 
@@ -108,9 +108,24 @@ public:
     void handle_super_call(FunctionCall& node, const std::vector<std::string>& arg_result_regs);
     void handle_regular_call(FunctionCall& node, const std::vector<std::string>& arg_result_regs);
     void handle_method_call_arguments_for_super(FunctionCall& node, const std::vector<std::string>& arg_result_regs, const std::string& func_name);
+    // Calls a method on the object in X0 once its arguments are in place:
+    // directly when the receiver's class is exact or nothing below class_name
+    // overrides the method, else behind a vtable guard for class_name itself.
+    void emit_method_dispatch(const std::string& class_name, const ClassMethodInfo& method_info,
+                              const std::string& exact_class_name);
 
     bool is_float_function_call(FunctionCall& node);
 
+    // --compact-strings: character access handles every string storage class
+    // (see runtime/string_class.h), not only UTF-32.
+    void set_compact_strings(bool enabled) { compact_strings_ = enabled; }
+
+    // --jobs N: functions and routines are compiled on up to N threads, each
+    // into an instruction stream fragment of its own with its own labels,
+    // registers and literals. The fragments are appended in declaration
+    // order, so the output is the same for every N above 1.
+    void set_codegen_jobs(unsigned jobs) { codegen_jobs_ = jobs ? jobs : 1; }
+
     // --- Single-Buffer Veneer Management ---
     /**
      * @brief Initializes the veneer manager with the code buffer base address.
@@ -149,6 +164,8 @@ private:
     bool is_jit_mode_ = false;
     bool bounds_checking_enabled_ = true;
     bool use_neon_ = true; // NEON SIMD instructions enabled by default
+    bool compact_strings_ = false; // strings may be compact or promoted
+    unsigned codegen_jobs_ = 1;
     
     // Vector code generation helper
     std::unique_ptr<VectorCodeGen> vector_codegen_;
@@ -341,11 +358,14 @@ private:
     void set_current_function_allocation(const std::string& function_name);
     bool lookup_symbol(const std::string& name, Symbol& symbol) const;
     void generate_block_epilogue(BasicBlock* block);
+    void generate_hoisted_bounds_checks(BasicBlock* block);
+    void generate_vectorized_loop(BasicBlock* block);
     void generate_function_epilogue();
     void generate_expression_code(Expression& expr);
     void generate_statement_code(Statement& stmt);
     void process_declarations(const std::vector<DeclPtr>& declarations);
     void process_declaration(Declaration& decl);
+    void generate_functions_in_parallel(const std::vector<Declaration*>& function_decls);
 
     // --- Linear Scan Register Allocation ---
     // REMOVED: performLinearScan method - all register allocation must be done upfront
@@ -384,6 +404,12 @@ private:
     
     // Bounds checking helpers
     std::string get_bounds_error_label_for_current_function();
+
+    // Character access for --compact-strings
+    void generate_compact_aware_char_load(const std::string& string_base_reg, const std::string& index_reg);
+    void generate_compact_aware_char_store(const std::string& string_base_reg, const std::string& index_reg,
+                                           const std::string& value_reg);
+    void generate_exact_length_clear(const std::string& string_base_reg, const std::string& value_reg);
     std::map<std::string, bool> function_needs_bounds_error_handler_;
     
     // Single-buffer veneer management
@@ -0,0 +1,376 @@
+#include "ObjectWriter.h"
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+// --- ELF64 constants (from the System V gABI and the AArch64 ELF ABI) ---
+// Spelled out here rather than taken from <elf.h>, which macOS lacks.
+
+constexpr uint16_t ET_REL = 1;
+constexpr uint16_t EM_AARCH64 = 183;
+
+constexpr uint32_t SHT_PROGBITS = 1;
+constexpr uint32_t SHT_SYMTAB = 2;
+constexpr uint32_t SHT_STRTAB = 3;
+constexpr uint32_t SHT_RELA = 4;
+
+constexpr uint64_t SHF_WRITE = 0x1;
+constexpr uint64_t SHF_ALLOC = 0x2;
+constexpr uint64_t SHF_EXECINSTR = 0x4;
+constexpr uint64_t SHF_INFO_LINK = 0x40;
+
+constexpr uint8_t STB_LOCAL = 0;
+constexpr uint8_t STB_GLOBAL = 1;
+constexpr uint8_t STT_NOTYPE = 0;
+constexpr uint8_t STT_FUNC = 2;
+constexpr uint8_t STT_SECTION = 3;
+
+constexpr uint32_t R_AARCH64_ABS64 = 257;
+constexpr uint32_t R_AARCH64_ABS32 = 258;
+constexpr uint32_t R_AARCH64_MOVW_UABS_G0_NC = 264;
+constexpr uint32_t R_AARCH64_MOVW_UABS_G1_NC = 266;
+constexpr uint32_t R_AARCH64_MOVW_UABS_G2_NC = 268;
+constexpr uint32_t R_AARCH64_MOVW_UABS_G3 = 269;
+constexpr uint32_t R_AARCH64_LD_PREL_LO19 = 273;
+constexpr uint32_t R_AARCH64_ADR_PREL_PG_HI21 = 275;
+constexpr uint32_t R_AARCH64_ADD_ABS_LO12_NC = 277;
+constexpr uint32_t R_AARCH64_CONDBR19 = 280;
+constexpr uint32_t R_AARCH64_JUMP26 = 282;
+constexpr uint32_t R_AARCH64_CALL26 = 283;
+
+constexpr size_t EHDR_SIZE = 64;
+constexpr size_t SHDR_SIZE = 64;
+constexpr size_t SYM_SIZE = 24;
+constexpr size_t RELA_SIZE = 24;
+
+// Section header indices. The layout is fixed; empty sections are still
+// written so the indices never move.
+enum SectionIndex : uint16_t {
+    SEC_NULL,
+    SEC_TEXT,
+    SEC_RODATA,
+    SEC_DATA,
+    SEC_RELA_TEXT,
+    SEC_RELA_RODATA,
+    SEC_RELA_DATA,
+    SEC_SYMTAB,
+    SEC_STRTAB,
+    SEC_NOTE_GNU_STACK,
+    SEC_SHSTRTAB,
+    SEC_COUNT
+};
+
+uint16_t section_for(SegmentType segment) {
+    switch (segment) {
+        case SegmentType::CODE:   return SEC_TEXT;
+        case SegmentType::RODATA: return SEC_RODATA;
+        case SegmentType::DATA:   return SEC_DATA;
+    }
+    return SEC_TEXT;
+}
+
+// Little-endian byte buffer (ELFDATA2LSB), independent of the host.
+class Bytes {
+public:
+    void u8(uint8_t v) { data_.push_back(v); }
+    void u16(uint16_t v) { put(v, 2); }
+    void u32(uint32_t v) { put(v, 4); }
+    void u64(uint64_t v) { put(v, 8); }
+    void append(const Bytes& other) { data_.insert(data_.end(), other.data_.begin(), other.data_.end()); }
+    void align(size_t alignment) { while (data_.size() % alignment) data_.push_back(0); }
+    size_t size() const { return data_.size(); }
+    std::vector<uint8_t>& data() { return data_; }
+
+private:
+    void put(uint64_t v, int bytes) {
+        for (int i = 0; i < bytes; ++i) data_.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+    std::vector<uint8_t> data_;
+};
+
+class StringTable {
+public:
+    StringTable() { bytes_.u8(0); }
+    uint32_t add(const std::string& s) {
+        auto it = offsets_.find(s);
+        if (it != offsets_.end()) return it->second;
+        uint32_t offset = static_cast<uint32_t>(bytes_.size());
+        for (char c : s) bytes_.u8(static_cast<uint8_t>(c));
+        bytes_.u8(0);
+        offsets_.emplace(s, offset);
+        return offset;
+    }
+    const Bytes& bytes() const { return bytes_; }
+
+private:
+    Bytes bytes_;
+    std::unordered_map<std::string, uint32_t> offsets_;
+};
+
+struct Symbol {
+    std::string name;
+    uint8_t binding;
+    uint8_t type;
+    uint16_t section; // 0 = undefined
+    uint64_t value;
+};
+
+struct Relocation {
+    uint64_t offset;
+    std::string target; // label or external symbol name
+    uint32_t type;
+    int64_t addend;
+};
+
+// Maps a Linker relocation to the ELF relocation that patches the same bits
+// the same way (see linker_helpers/). The Linker patches bits [25:0] for
+// PC_RELATIVE_26 and [23:5] for PC_RELATIVE_19 whatever the instruction, so
+// the ELF type is chosen from the instruction's encoding.
+uint32_t elf_relocation_type(const Instruction& instr, int64_t& addend) {
+    addend = 0;
+    switch (instr.relocation) {
+        case RelocationType::PC_RELATIVE_26_BIT_OFFSET:
+            return (instr.encoding & 0xFC000000) == 0x94000000 ? R_AARCH64_CALL26 : R_AARCH64_JUMP26;
+        case RelocationType::PC_RELATIVE_19_BIT_OFFSET:
+            return (instr.encoding & 0x3B000000) == 0x18000000 ? R_AARCH64_LD_PREL_LO19 : R_AARCH64_CONDBR19;
+        case RelocationType::PAGE_21_BIT_PC_RELATIVE:
+            return R_AARCH64_ADR_PREL_PG_HI21;
+        case RelocationType::ADD_12_BIT_UNSIGNED_OFFSET:
+            return R_AARCH64_ADD_ABS_LO12_NC;
+        case RelocationType::ADD_12_BIT_UNSIGNED_OFFSET_PLUS_8:
+            addend = 8;
+            return R_AARCH64_ADD_ABS_LO12_NC;
+        case RelocationType::MOVZ_MOVK_IMM_0:  return R_AARCH64_MOVW_UABS_G0_NC;
+        case RelocationType::MOVZ_MOVK_IMM_16: return R_AARCH64_MOVW_UABS_G1_NC;
+        case RelocationType::MOVZ_MOVK_IMM_32: return R_AARCH64_MOVW_UABS_G2_NC;
+        case RelocationType::MOVZ_MOVK_IMM_48: return R_AARCH64_MOVW_UABS_G3;
+        default:
+            // NONE and the ABSOLUTE_ADDRESS_* pair are handled by the caller
+            throw std::runtime_error("Error: Unsupported relocation type " +
+                                     std::to_string(static_cast<int>(instr.relocation)) + " for '" +
+                                     std::string(instr.target_label) + "'.");
+    }
+}
+
+void write_section_header(Bytes& out, uint32_t name, uint32_t type, uint64_t flags, uint64_t offset,
+                          uint64_t size, uint32_t link, uint32_t info, uint64_t alignment, uint64_t entry_size) {
+    out.u32(name);
+    out.u32(type);
+    out.u64(flags);
+    out.u64(0); // sh_addr
+    out.u64(offset);
+    out.u64(size);
+    out.u32(link);
+    out.u32(info);
+    out.u64(alignment);
+    out.u64(entry_size);
+}
+
+} // namespace
+
+ObjectWriter::ObjectWriter() {}
+
+std::vector<uint8_t> ObjectWriter::build(const std::vector<Instruction>& instructions) const {
+    Bytes contents[SEC_COUNT];
+    std::vector<Relocation> relocations[SEC_COUNT];
+    std::vector<Symbol> locals;
+    std::unordered_map<std::string, size_t> defined; // label -> index in locals
+
+    // --- Pass 1: section contents, label symbols and relocations ---
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        const Instruction& instr = instructions[i];
+        uint16_t section = section_for(instr.segment);
+        Bytes& bytes = contents[section];
+
+        if (instr.is_label_definition) {
+            const std::string name = instr.target_label;
+            if (defined.count(name)) {
+                throw std::runtime_error("Error: Label '" + name + "' already defined.");
+            }
+            defined[name] = locals.size();
+            locals.push_back({ name, STB_LOCAL, STT_NOTYPE, section, bytes.size() });
+        }
+
+        // Same rule as the Linker: anything with text or a data value is one word.
+        if (instr.assembly_text.empty() && !instr.is_data_value) continue;
+        uint64_t offset = bytes.size();
+        bytes.u32(instr.encoding);
+
+        if (instr.relocation == RelocationType::NONE || instr.target_label.empty()) continue;
+
+        if (instr.relocation == RelocationType::ABSOLUTE_ADDRESS_LO32) {
+            // DataGenerator emits 64-bit pointers as a LO32 word followed by
+            // a HI32 word for the same label: one ABS64 covers both.
+            size_t next = i + 1;
+            while (next < instructions.size() && instructions[next].is_label_definition) ++next;
+            bool paired = next < instructions.size() &&
+                          instructions[next].relocation == RelocationType::ABSOLUTE_ADDRESS_HI32 &&
+                          instructions[next].target_label == instr.target_label &&
+                          instructions[next].segment == instr.segment;
+            relocations[section].push_back({ offset, instr.target_label, paired ? R_AARCH64_ABS64 : R_AARCH64_ABS32, 0 });
+            continue;
+        }
+        if (instr.relocation == RelocationType::ABSOLUTE_ADDRESS_HI32) {
+            const Relocation* previous = relocations[section].empty() ? nullptr : &relocations[section].back();
+            if (!previous || previous->type != R_AARCH64_ABS64 || previous->offset + 4 != offset) {
+                throw std::runtime_error("Error: Unpaired ABSOLUTE_ADDRESS_HI32 relocation for '" +
+                                         std::string(instr.target_label) + "'.");
+            }
+            continue;
+        }
+
+        int64_t addend = 0;
+        uint32_t type = elf_relocation_type(instr, addend);
+        relocations[section].push_back({ offset, instr.target_label, type, addend });
+    }
+
+    // --- Symbol table: null, section symbols, labels, then globals ---
+    // START is the program's entry point; everything else the stream defines
+    // stays local. Targets it does not define are the runtime's functions.
+    std::vector<Symbol> symbols;
+    symbols.push_back({ "", STB_LOCAL, STT_NOTYPE, 0, 0 });
+    for (uint16_t section : { SEC_TEXT, SEC_RODATA, SEC_DATA }) {
+        symbols.push_back({ "", STB_LOCAL, STT_SECTION, section, 0 });
+    }
+    std::unordered_map<std::string, uint32_t> symbol_index;
+    std::vector<Symbol> globals;
+    for (const Symbol& symbol : locals) {
+        if (symbol.name == "START") {
+            globals.push_back(symbol);
+            globals.back().binding = STB_GLOBAL;
+            globals.back().type = STT_FUNC;
+            continue;
+        }
+        symbol_index[symbol.name] = static_cast<uint32_t>(symbols.size());
+        symbols.push_back(symbol);
+    }
+    const uint32_t first_global = static_cast<uint32_t>(symbols.size());
+    for (auto& section_relocations : relocations) {
+        for (const Relocation& relocation : section_relocations) {
+            if (!defined.count(relocation.target) && !symbol_index.count(relocation.target)) {
+                symbol_index[relocation.target] = 0; // placeholder, numbered below
+                globals.push_back({ relocation.target, STB_GLOBAL, STT_NOTYPE, 0, 0 });
+            }
+        }
+    }
+    for (const Symbol& symbol : globals) {
+        symbol_index[symbol.name] = static_cast<uint32_t>(symbols.size());
+        symbols.push_back(symbol);
+    }
+
+    StringTable strtab;
+    Bytes symtab;
+    for (const Symbol& symbol : symbols) {
+        symtab.u32(symbol.name.empty() ? 0 : strtab.add(symbol.name));
+        symtab.u8(static_cast<uint8_t>((symbol.binding << 4) | symbol.type));
+        symtab.u8(0); // st_other: default visibility
+        symtab.u16(symbol.section);
+        symtab.u64(symbol.value);
+        symtab.u64(0); // st_size
+    }
+
+    Bytes rela[SEC_COUNT];
+    for (uint16_t section : { SEC_TEXT, SEC_RODATA, SEC_DATA }) {
+        for (const Relocation& relocation : relocations[section]) {
+            uint64_t symbol = symbol_index.at(relocation.target);
+            rela[section].u64(relocation.offset);
+            rela[section].u64((symbol << 32) | relocation.type);
+            rela[section].u64(static_cast<uint64_t>(relocation.addend));
+        }
+    }
+
+    // --- Section header names ---
+    StringTable shstrtab;
+    uint32_t names[SEC_COUNT] = {};
+    names[SEC_TEXT] = shstrtab.add(".text");
+    names[SEC_RODATA] = shstrtab.add(".rodata");
+    names[SEC_DATA] = shstrtab.add(".data");
+    names[SEC_RELA_TEXT] = shstrtab.add(".rela.text");
+    names[SEC_RELA_RODATA] = shstrtab.add(".rela.rodata");
+    names[SEC_RELA_DATA] = shstrtab.add(".rela.data");
+    names[SEC_SYMTAB] = shstrtab.add(".symtab");
+    names[SEC_STRTAB] = shstrtab.add(".strtab");
+    names[SEC_NOTE_GNU_STACK] = shstrtab.add(".note.GNU-stack");
+    names[SEC_SHSTRTAB] = shstrtab.add(".shstrtab");
+
+    // --- File layout: header, section contents, section header table ---
+    Bytes body;
+    uint64_t offsets[SEC_COUNT] = {};
+    auto place = [&](uint16_t section, const Bytes& bytes, size_t alignment) {
+        body.align(alignment);
+        offsets[section] = EHDR_SIZE + body.size();
+        body.append(bytes);
+    };
+    // The body starts at EHDR_SIZE (a multiple of 8), so aligning within it
+    // aligns in the file.
+    place(SEC_TEXT, contents[SEC_TEXT], 4);
+    place(SEC_RODATA, contents[SEC_RODATA], 8);
+    place(SEC_DATA, contents[SEC_DATA], 8);
+    place(SEC_RELA_TEXT, rela[SEC_TEXT], 8);
+    place(SEC_RELA_RODATA, rela[SEC_RODATA], 8);
+    place(SEC_RELA_DATA, rela[SEC_DATA], 8);
+    place(SEC_SYMTAB, symtab, 8);
+    place(SEC_STRTAB, strtab.bytes(), 1);
+    offsets[SEC_NOTE_GNU_STACK] = EHDR_SIZE + body.size();
+    place(SEC_SHSTRTAB, shstrtab.bytes(), 1);
+    body.align(8);
+    const uint64_t section_headers_offset = EHDR_SIZE + body.size();
+
+    Bytes out;
+    // e_ident: magic, ELFCLASS64, ELFDATA2LSB, EV_CURRENT, ELFOSABI_NONE
+    const uint8_t ident[16] = { 0x7F, 'E', 'L', 'F', 2, 1, 1, 0 };
+    for (uint8_t b : ident) out.u8(b);
+    out.u16(ET_REL);
+    out.u16(EM_AARCH64);
+    out.u32(1);      // e_version
+    out.u64(0);      // e_entry
+    out.u64(0);      // e_phoff
+    out.u64(section_headers_offset);
+    out.u32(0);      // e_flags
+    out.u16(EHDR_SIZE);
+    out.u16(0);      // e_phentsize
+    out.u16(0);      // e_phnum
+    out.u16(SHDR_SIZE);
+    out.u16(SEC_COUNT);
+    out.u16(SEC_SHSTRTAB);
+    out.append(body);
+
+    write_section_header(out, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    write_section_header(out, names[SEC_TEXT], SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, offsets[SEC_TEXT],
+                         contents[SEC_TEXT].size(), 0, 0, 4, 0);
+    write_section_header(out, names[SEC_RODATA], SHT_PROGBITS, SHF_ALLOC, offsets[SEC_RODATA],
+                         contents[SEC_RODATA].size(), 0, 0, 8, 0);
+    write_section_header(out, names[SEC_DATA], SHT_PROGBITS, SHF_ALLOC | SHF_WRITE, offsets[SEC_DATA],
+                         contents[SEC_DATA].size(), 0, 0, 8, 0);
+    for (uint16_t section : { SEC_TEXT, SEC_RODATA, SEC_DATA }) {
+        uint16_t rela_section = section + (SEC_RELA_TEXT - SEC_TEXT);
+        write_section_header(out, names[rela_section], SHT_RELA, SHF_INFO_LINK, offsets[rela_section],
+                             rela[section].size(), SEC_SYMTAB, section, 8, RELA_SIZE);
+    }
+    write_section_header(out, names[SEC_SYMTAB], SHT_SYMTAB, 0, offsets[SEC_SYMTAB], symtab.size(),
+                         SEC_STRTAB, first_global, 8, SYM_SIZE);
+    write_section_header(out, names[SEC_STRTAB], SHT_STRTAB, 0, offsets[SEC_STRTAB], strtab.bytes().size(),
+                         0, 0, 1, 0);
+    // Empty .note.GNU-stack: the program does not need an executable stack.
+    write_section_header(out, names[SEC_NOTE_GNU_STACK], SHT_PROGBITS, 0, offsets[SEC_NOTE_GNU_STACK], 0,
+                         0, 0, 1, 0);
+    write_section_header(out, names[SEC_SHSTRTAB], SHT_STRTAB, 0, offsets[SEC_SHSTRTAB],
+                         shstrtab.bytes().size(), 0, 0, 1, 0);
+
+    return std::move(out.data());
+}
+
+void ObjectWriter::write_to_file(const std::string& path, const std::vector<Instruction>& instructions) const {
+    std::vector<uint8_t> image = build(instructions);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error: Could not open object file '" + path + "' for writing.");
+    }
+    file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    if (!file) {
+        throw std::runtime_error("Error: Failed to write object file '" + path + "'.");
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef OBJECT_WRITER_H
+#define OBJECT_WRITER_H
+
+#include "Encoder.h" // For Instruction struct
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The ObjectWriter writes the program as an ELF64 AArch64 relocatable object
+// (.o) directly, so static builds on Linux do not go through a .s file and
+// an external assembler.
+//
+// It takes the unlinked instruction stream (as it leaves the peephole
+// optimizer) and lays it out exactly as the Linker does for the JIT: every
+// entry with assembly text or a data value is one 32-bit word of .text,
+// .rodata or .data, in stream order, holding Instruction::encoding. Label
+// definitions become local symbols and START a global one; targets not
+// defined in the stream (runtime functions) become undefined globals. Each
+// Linker relocation is written as the ELF relocation that performs the same
+// patch, so once linked the sections hold the same bytes the JIT would run.
+class ObjectWriter {
+public:
+    ObjectWriter();
+
+    // Builds the object file image for an unlinked instruction stream.
+    // Throws std::runtime_error for a relocation ELF cannot express.
+    std::vector<uint8_t> build(const std::vector<Instruction>& instructions) const;
+
+    // Builds the object and writes it to `path`.
+    void write_to_file(const std::string& path, const std::vector<Instruction>& instructions) const;
+};
+
+#endif // OBJECT_WRITER_H
@@ -13,7 +13,7 @@ enum class OpType {
     DIV, SDIV, FDIV,
     AND, ORR, EOR, BIC,
     CMP, FCMP,
-    STR, LDR, LDUR, LDRB, STP, LDP, STR_FP, LDR_FP, STR_WORD, LDR_WORD, LDR_SCALED,
+    STR, LDR, LDUR, LDRB, STRB, STP, LDP, STR_FP, LDR_FP, STR_WORD, LDR_WORD, LDR_SCALED,
     B, BL, BR, BLR, RET, B_COND, ADRP, ADR,
     NOP, DMB, BRK, SVC, DIRECTIVE,
     // Bitfield & Shift
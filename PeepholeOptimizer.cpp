@@ -4,13 +4,17 @@
 #include "InstructionDecoder.h" // For instruction decoding utilities
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <iterator>
 
 // InstructionPattern implementation
 InstructionPattern::InstructionPattern(size_t pattern_size, MatcherFunction matcher_func,
                                        std::function<std::vector<Instruction>(const std::vector<Instruction>&, size_t)> transformer_func,
-                                       std::string description)
+                                       std::string description,
+                                       std::vector<InstructionDecoder::OpType> leading_opcodes)
     : pattern_size_(pattern_size), matcher_(std::move(matcher_func)),
-      transformer_(std::move(transformer_func)), description_(std::move(description)) {}
+      transformer_(std::move(transformer_func)), description_(std::move(description)),
+      leading_opcodes_(std::move(leading_opcodes)) {}
 
 MatchResult InstructionPattern::matches(const std::vector<Instruction>& instructions, size_t position) const {
     // Use the matcher function to determine if the pattern matches
@@ -73,14 +77,15 @@ PeepholeOptimizer::PeepholeOptimizer(bool enable_tracing)
 
 void PeepholeOptimizer::addPattern(std::unique_ptr<InstructionPattern> pattern) {
     patterns_.push_back(std::move(pattern));
+    dispatch_dirty_ = true;
 }
 
 void PeepholeOptimizer::optimize(InstructionStream& instruction_stream, int max_passes) {
     // Reset statistics
     stats_.clear();
 
-    // Get a copy of the instructions that we can modify
-    std::vector<Instruction> instructions = instruction_stream.get_instructions();
+    // Take the instructions out of the stream; they are handed back below
+    std::vector<Instruction> instructions = instruction_stream.take_instructions();
     stats_.total_instructions_before = static_cast<int>(instructions.size());
 
     if (enable_tracing_) {
@@ -109,12 +114,12 @@ void PeepholeOptimizer::optimize(InstructionStream& instruction_stream, int max_
         }
     }
 
-    // Replace the original instructions with the optimized ones
-    instruction_stream.replace_instructions(instructions);
-
     // Update statistics
     stats_.total_instructions_after = static_cast<int>(instructions.size());
 
+    // Replace the original instructions with the optimized ones
+    instruction_stream.replace_instructions(std::move(instructions));
+
     if (enable_tracing_) {
         std::cout << "Peephole optimization completed " << pass_count << " \n";
         std::cout << "  Passes with changes: " << total_changes << "\n";
@@ -136,71 +141,110 @@ void PeepholeOptimizer::optimize(InstructionStream& instruction_stream, int max_
     }
 }
 
+void PeepholeOptimizer::buildDispatchTable() {
+    for (auto& bucket : patterns_by_opcode_) {
+        bucket.clear();
+    }
+    wildcard_patterns_.clear();
+
+    for (const auto& pattern : patterns_) {
+        const auto& leading = pattern->getLeadingOpcodes();
+        if (leading.empty()) {
+            wildcard_patterns_.push_back(pattern.get());
+            for (auto& bucket : patterns_by_opcode_) {
+                bucket.push_back(pattern.get());
+            }
+            continue;
+        }
+        for (InstructionDecoder::OpType op : leading) {
+            size_t index = static_cast<size_t>(op);
+            if (index < OPCODE_TABLE_SIZE) {
+                patterns_by_opcode_[index].push_back(pattern.get());
+            }
+        }
+    }
+    dispatch_dirty_ = false;
+}
+
+void PeepholeOptimizer::buildLabelUseIndex(const std::vector<Instruction>& instructions) {
+    // label_refs_before_[i] = instructions in [0, i) with a target_label.
+    // That covers label references and also label definitions, which carry
+    // their own name there, so a window spanning a label is refused: a
+    // rewrite across it would merge code that other branches jump into.
+    label_refs_before_.assign(instructions.size() + 1, 0);
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        bool names_label = !instructions[i].target_label.empty();
+        label_refs_before_[i + 1] = label_refs_before_[i] + (names_label ? 1 : 0);
+    }
+}
+
 bool PeepholeOptimizer::applyOptimizationPass(std::vector<Instruction>& instructions) {
+    if (dispatch_dirty_) {
+        buildDispatchTable();
+    }
+    buildLabelUseIndex(instructions);
+
+    // Matchers always read the unmodified input; the output buffer is only
+    // started at the first rewrite, so a pass that changes nothing copies nothing.
+    std::vector<Instruction> rewritten;
+    size_t copied_upto = 0; // instructions[0, copied_upto) are already in rewritten
     bool any_changes = false;
+    const size_t count = instructions.size();
     size_t pos = 0;
 
-    while (pos < instructions.size()) {
-        // Only attempt to optimize instructions that are part of the CODE segment.
-        // Skip over any instructions intended for RODATA or DATA segments.
-        if (instructions[pos].segment != SegmentType::CODE) {
-            pos++;
-            continue; // Skip to the next instruction
-        }
-
-        bool applied_optimization = false;
+    while (pos < count) {
+        const Instruction& instr = instructions[pos];
 
-        // Skip special instructions (labels, directives, etc.)
-        if (isSpecialInstruction(instructions[pos])) {
+        // Only attempt to optimize instructions that are part of the CODE segment.
+        // Skip over any instructions intended for RODATA or DATA segments,
+        // and special instructions (labels, directives, etc.)
+        if (instr.segment != SegmentType::CODE || isSpecialInstruction(instr)) {
             pos++;
             continue;
         }
 
+        size_t op_index = static_cast<size_t>(instr.opcode);
+        const auto& candidates = op_index < OPCODE_TABLE_SIZE ? patterns_by_opcode_[op_index]
+                                                              : wildcard_patterns_;
 
-
-        // Try each pattern
-        for (const auto& pattern : patterns_) {
+        bool applied_optimization = false;
+        for (const InstructionPattern* pattern : candidates) {
             MatchResult result = pattern->matches(instructions, pos);
-            if (result.matched) {
-                // Check if applying this optimization would break any label references
-                if (wouldBreakLabelReferences(instructions, pos, result.length,
-                                             pattern->transform(instructions, pos))) {
-                    continue;  // Skip this pattern if it would break references
-                }
+            if (!result.matched || result.length == 0 || pos + result.length > count) {
+                continue;
+            }
 
-                // Apply the pattern's transformation
-                std::vector<Instruction> replacements = pattern->transform(instructions, pos);
+            // Check if applying this optimization would break any label references
+            if (wouldBreakLabelReferences(instructions, pos, result.length)) {
+                continue;  // Skip this pattern if it would break references
+            }
 
-                // Update statistics
-                stats_.optimizations_applied++;
-                stats_.pattern_matches[pattern->getDescription()]++;
+            std::vector<Instruction> replacements = pattern->transform(instructions, pos);
 
-                // Get the original instructions for tracing
-                std::vector<Instruction> original_instructions;
-                for (size_t i = 0; i < result.length; i++) {
-                    original_instructions.push_back(instructions[pos + i]);
-                }
+            // Update statistics
+            stats_.optimizations_applied++;
+            stats_.pattern_matches[pattern->getDescription()]++;
 
-                // Use enhanced tracing to show detailed before/after
-                if (enable_tracing_) {
-                    traceOptimization(
-                        pattern->getDescription(),
-                        original_instructions,
-                        replacements,
-                        pos
-                    );
-                }
-
-                // Replace the original instructions with the optimized ones
-                instructions.erase(instructions.begin() + pos,
-                                  instructions.begin() + pos + result.length);
-                instructions.insert(instructions.begin() + pos,
-                                   replacements.begin(), replacements.end());
+            // Use enhanced tracing to show detailed before/after
+            if (enable_tracing_) {
+                std::vector<Instruction> original_instructions(instructions.begin() + pos,
+                                                               instructions.begin() + pos + result.length);
+                traceOptimization(pattern->getDescription(), original_instructions, replacements, pos);
+            }
 
-                applied_optimization = true;
-                any_changes = true;
-                break;  // Break out of the pattern loop
+            if (!any_changes) {
+                rewritten.reserve(count);
             }
+            rewritten.insert(rewritten.end(), instructions.begin() + copied_upto, instructions.begin() + pos);
+            rewritten.insert(rewritten.end(),
+                             std::make_move_iterator(replacements.begin()),
+                             std::make_move_iterator(replacements.end()));
+            pos += result.length;
+            copied_upto = pos;
+
+            applied_optimization = true;
+            any_changes = true;
+            break;  // Continue after the rewritten window
         }
 
         // If no optimization was applied, move to the next instruction
@@ -209,6 +253,10 @@ bool PeepholeOptimizer::applyOptimizationPass(std::vector<Instruction>& instruct
         }
     }
 
+    if (any_changes) {
+        rewritten.insert(rewritten.end(), instructions.begin() + copied_upto, instructions.end());
+        instructions.swap(rewritten);
+    }
     return any_changes;
 }
 
@@ -290,18 +338,12 @@ bool PeepholeOptimizer::isSpecialInstruction(const Instruction& instr) {
 
 bool PeepholeOptimizer::wouldBreakLabelReferences(
     const std::vector<Instruction>& instructions,
-    size_t start_pos, size_t count,
-    const std::vector<Instruction>& replacements) const {
-
-    // Check if any of the instructions being replaced has a label reference
-    for (size_t i = 0; i < count && (start_pos + i) < instructions.size(); i++) {
-        if (!instructions[start_pos + i].target_label.empty()) {
-            // If the target label is not empty, it means this instruction is referenced by a label
-            return true;
-        }
-    }
+    size_t start_pos, size_t count) const {
 
-    return false;
+    // Reject the window if any instruction in it names a label (a reference
+    // or a definition); answered from the per-pass prefix counts.
+    size_t end_pos = std::min(start_pos + count, instructions.size());
+    return label_refs_before_[end_pos] != label_refs_before_[start_pos];
 }
 
 
@@ -426,10 +468,7 @@ std::unique_ptr<InstructionPattern> PeepholeOptimizer::createRedundantLoadElimin
             const auto& instr2 = instrs[pos + 1];
 
             // Keep the first load, and replace the second one with a MOV.
-            Instruction new_mov = Encoder::create_mov_reg(
-                InstructionDecoder::getRegisterName(instr2.dest_reg),
-                InstructionDecoder::getRegisterName(instr1.dest_reg)
-            );
+            Instruction new_mov = Encoder::create_mov_reg(Reg::x(instr2.dest_reg), Reg::x(instr1.dest_reg));
 
             return { instr1, new_mov };
         },
@@ -502,11 +541,7 @@ std::unique_ptr<InstructionPattern> PeepholeOptimizer::createRedundantMovePatter
                     return { instrs[pos] };  // Keep the first instruction if we can't optimize
                 }
 
-                std::string dest_reg_name = InstructionDecoder::getRegisterName(dstRegNum);
-                std::string src_reg_name = InstructionDecoder::getRegisterName(srcRegNum);
-
-                // Call the existing Encoder function with the expected string types
-                Instruction new_instr = Encoder::create_mov_reg(dest_reg_name, src_reg_name);
+                Instruction new_instr = Encoder::create_mov_reg(Reg::x(dstRegNum), Reg::x(srcRegNum));
                 return { new_instr };
             }
 
@@ -616,12 +651,7 @@ std::unique_ptr<InstructionPattern> PeepholeOptimizer::createLoadAfterStorePatte
                 return { store_instr, load_instr };
             }
 
-            // Convert integer IDs back to string names locally
-            std::string dest_reg_name = InstructionDecoder::getRegisterName(dest_reg_num);
-            std::string src_reg_name = InstructionDecoder::getRegisterName(src_reg_num);
-
-            // Call the existing Encoder function with the expected string types
-            Instruction new_mov = Encoder::create_mov_reg(dest_reg_name, src_reg_name);
+            Instruction new_mov = Encoder::create_mov_reg(Reg::x(dest_reg_num), Reg::x(src_reg_num));
 
             // Return the original store followed by the new, faster MOV instruction
             return { store_instr, new_mov };
@@ -794,12 +824,7 @@ std::unique_ptr<InstructionPattern> PeepholeOptimizer::createStrengthReductionPa
             int dest_reg = instr.dest_reg;
             int src_reg = instr.src_reg1;
 
-            // Convert integer IDs back to string names locally
-            std::string dest_reg_name = InstructionDecoder::getRegisterName(dest_reg);
-            std::string src_reg_name = InstructionDecoder::getRegisterName(src_reg);
-
-            // Call the existing Encoder function with the expected string types
-            Instruction new_instr = Encoder::create_add_reg(dest_reg_name, src_reg_name, src_reg_name);
+            Instruction new_instr = Encoder::create_add_reg(Reg::x(dest_reg), Reg::x(src_reg), Reg::x(src_reg));
 
             return { new_instr };
         },
@@ -860,10 +885,7 @@ std::unique_ptr<InstructionPattern> PeepholeOptimizer::createIdentityOperationEl
                  opcode == InstructionDecoder::OpType::MUL || opcode == InstructionDecoder::OpType::SDIV) &&
                 instr.uses_immediate) {
 
-                return { Encoder::create_mov_reg(
-                    InstructionDecoder::getRegisterName(instr.dest_reg),
-                    InstructionDecoder::getRegisterName(instr.src_reg1)
-                )};
+                return { Encoder::create_mov_reg(Reg::x(instr.dest_reg), Reg::x(instr.src_reg1)) };
             }
 
             // Case 3: Self-subtraction (SUB Xd, Xn, Xn) -> MOVZ Xd, #0
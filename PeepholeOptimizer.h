@@ -23,9 +23,13 @@ class InstructionPattern {
 public:
     using MatcherFunction = std::function<MatchResult(const std::vector<Instruction>&, size_t)>;
 
+    // leading_opcodes lists the opcodes the pattern's first instruction can
+    // have; the optimizer only tries the pattern at those instructions.
+    // Leave it empty for patterns that can start anywhere.
     InstructionPattern(size_t pattern_size, MatcherFunction matcher_func,
                       std::function<std::vector<Instruction>(const std::vector<Instruction>&, size_t)> transformer_func,
-                      std::string description);
+                      std::string description,
+                      std::vector<InstructionDecoder::OpType> leading_opcodes = {});
 
     // Check if pattern matches at the given position in the instruction stream
     MatchResult matches(const std::vector<Instruction>& instructions, size_t position) const;
@@ -39,11 +43,15 @@ public:
     // Get the description of this optimization pattern
     const std::string& getDescription() const { return description_; }
 
+    // Opcodes this pattern can start at (empty: any instruction)
+    const std::vector<InstructionDecoder::OpType>& getLeadingOpcodes() const { return leading_opcodes_; }
+
 private:
     size_t pattern_size_;
     MatcherFunction matcher_;
     std::function<std::vector<Instruction>(const std::vector<Instruction>&, size_t)> transformer_;
     std::string description_;
+    std::vector<InstructionDecoder::OpType> leading_opcodes_;
 };
 
 // Main peephole optimizer class
@@ -112,7 +120,25 @@ private:
     OptimizationStats stats_;
     bool enable_tracing_;
 
-    // Helper method to apply a single pass of optimization
+    // Patterns indexed by the opcode of the instruction they start at, in
+    // patterns_ order. Patterns without leading opcodes are in every bucket
+    // (and alone in wildcard_patterns_, used for opcodes past the table).
+    // Rebuilt lazily after addPattern().
+    static constexpr size_t OPCODE_TABLE_SIZE = static_cast<size_t>(InstructionDecoder::OpType::FSQRT) + 1;
+    std::array<std::vector<const InstructionPattern*>, OPCODE_TABLE_SIZE> patterns_by_opcode_;
+    std::vector<const InstructionPattern*> wildcard_patterns_;
+    bool dispatch_dirty_ = true;
+    void buildDispatchTable();
+
+    // Prefix counts of instructions that name a label (target_label set:
+    // label references and label definitions alike), rebuilt at the start
+    // of every pass (the pass reads a stream it does not modify), so the
+    // label check for any window is two loads.
+    std::vector<uint32_t> label_refs_before_;
+    void buildLabelUseIndex(const std::vector<Instruction>& instructions);
+
+    // Helper method to apply a single pass of optimization: one forward
+    // scan that copies the stream into a new buffer, splicing in rewrites.
     bool applyOptimizationPass(std::vector<Instruction>& instructions);
 
     // Helper method to trace optimizations when enabled
@@ -129,8 +155,7 @@ private:
 
     // Check if an optimization would affect label references
     bool wouldBreakLabelReferences(const std::vector<Instruction>& instructions,
-                                  size_t start_pos, size_t count,
-                                  const std::vector<Instruction>& replacements) const;
+                                  size_t start_pos, size_t count) const;
 
     // Declaration for copy propagation pattern
     static std::unique_ptr<InstructionPattern> createCopyPropagationPattern();
@@ -288,7 +288,8 @@ std::unique_ptr<InstructionPattern> PeepholePatterns::createIdenticalMovePattern
             return { instrs[pos] };
         },
 
-        "Identical sequential move elimination (MOV Xd, Xn; MOV Xd, Xn)"
+        "Identical sequential move elimination (MOV Xd, Xn; MOV Xd, Xn)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::MOV }
     );
 }
 
@@ -435,8 +436,7 @@ std::unique_ptr<InstructionPattern> PeepholePatterns::createInPlaceComparisonPat
             const auto& cmp_instr = instrs[pos + 1];
 
             // Get the original register and operands
-            int original_reg = InstructionDecoder::getSrcReg1(mov_instr);
-            std::string original_reg_name = InstructionDecoder::getRegisterName(original_reg);
+            Reg original_reg = Reg::x(InstructionDecoder::getSrcReg1(mov_instr));
             
             // Instead of text manipulation, rebuild the CMP instruction using Encoder
             Instruction optimized_cmp;
@@ -444,17 +444,17 @@ std::unique_ptr<InstructionPattern> PeepholePatterns::createInPlaceComparisonPat
             if (InstructionDecoder::usesImmediate(cmp_instr)) {
                 // CMP with immediate: CMP Xn, #imm
                 int64_t immediate = InstructionDecoder::getImmediate(cmp_instr);
-                optimized_cmp = Encoder::create_cmp_imm(original_reg_name, immediate);
+                optimized_cmp = Encoder::create_cmp_imm(original_reg, immediate);
             } else {
                 // CMP with register: CMP Xn, Xm
-                int second_reg = InstructionDecoder::getSrcReg2(cmp_instr);
-                std::string second_reg_name = InstructionDecoder::getRegisterName(second_reg);
-                optimized_cmp = Encoder::create_cmp_reg(original_reg_name, second_reg_name);
+                Reg second_reg = Reg::x(InstructionDecoder::getSrcReg2(cmp_instr));
+                optimized_cmp = Encoder::create_cmp_reg(original_reg, second_reg);
             }
 
             return { optimized_cmp };
         },
-        "In-place comparison optimization (MOV-CMP -> CMP)"
+        "In-place comparison optimization (MOV-CMP -> CMP)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::MOV }
     );
 }
 
@@ -677,6 +677,7 @@ std::unique_ptr<InstructionPattern> PeepholePatterns::createInPlaceArithmeticPat
 
             return { optimized_arith };
         },
-        "In-place arithmetic optimization (MOV-ADD/SUB/MUL/DIV/AND/ORR/EOR/LSL/LSR/ASR-MOV -> ARITH)"
+        "In-place arithmetic optimization (MOV-ADD/SUB/MUL/DIV/AND/ORR/EOR/LSL/LSR/ASR-MOV -> ARITH)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::MOV }
     );
 }
@@ -1,15 +1,119 @@
 #include "Preprocessor.h"
 #include <iostream>
 // Remove regex include as it's not needed
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <libgen.h>
 
+struct Preprocessor::SourceFile {
+    // A run of whole ordinary lines, or one GET directive
+    struct Segment {
+        size_t offset = 0;          // text run: [offset, offset + length) of data
+        size_t length = 0;
+        bool add_newline = false;   // the run ends with a final line lacking '\n'
+        std::string include;        // non-empty for a GET directive
+        int line_number = 0;        // line of the GET directive
+    };
+
+    std::string path;
+    std::string text;               // the whole file, read once
+    const char* data = nullptr;     // text.data()
+    size_t size = 0;
+    struct timespec mtime = {};
+    std::vector<Segment> segments;
+};
+
+namespace {
+
+struct timespec modification_time(const struct stat& st) {
+#ifdef __APPLE__
+    return st.st_mtimespec;
+#else
+    return st.st_mtim;
+#endif
+}
+
+// Reads the whole of `fd` into `text`, to end of file rather than to the
+// size fstat reported, so a file that shrinks or grows meanwhile gives a
+// short or long read instead of a fault.
+bool read_all(int fd, std::string& text, size_t size_hint) {
+    text.clear();
+    text.reserve(size_hint);
+    char buffer[65536];
+    for (;;) {
+        ssize_t got = read(fd, buffer, sizeof(buffer));
+        if (got == 0) return true;
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        text.append(buffer, static_cast<size_t>(got));
+    }
+}
+
+// --- Output cache entries: native byte order, the cache is per machine ---
+
+constexpr char OUTPUT_CACHE_MAGIC[8] = { 'N', 'B', 'C', 'P', 'L', 'P', 'P', '\n' };
+constexpr uint32_t OUTPUT_CACHE_FORMAT_VERSION = 1;
+
+uint64_t fnv1a(const std::string& text, uint64_t hash) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+void put_u64(std::string& out, uint64_t v) { out.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+void put_str(std::string& out, const std::string& s) { put_u64(out, s.size()); out.append(s); }
+
+bool get_u64(const std::string& in, size_t& pos, uint64_t& v) {
+    if (sizeof(v) > in.size() - pos) return false;
+    std::memcpy(&v, in.data() + pos, sizeof(v));
+    pos += sizeof(v);
+    return true;
+}
+
+bool get_str(const std::string& in, size_t& pos, std::string& s) {
+    uint64_t size;
+    if (!get_u64(in, pos, size) || size > in.size() - pos) return false;
+    s.assign(in, pos, size);
+    pos += size;
+    return true;
+}
+
+} // namespace
+
 std::string Preprocessor::process(const std::string& root_filepath) {
-    // Clear the output stream before processing
-    output_stream_.str("");
-    output_stream_.clear();
+    // Clear the output before processing
+    output_pieces_.clear();
+    line_directives_.clear();
+    files_in_use_.clear();
+    dependencies_.clear();
+
+    std::string cache_material, cache_path;
+    if (!cache_directory_.empty()) {
+        cache_material = output_cache_material(root_filepath);
+        char name[40];
+        std::snprintf(name, sizeof(name), "/%016llx%016llx.ppc",
+                      static_cast<unsigned long long>(fnv1a(cache_material, 0xcbf29ce484222325ULL)),
+                      static_cast<unsigned long long>(fnv1a(cache_material, 0x84222325cbf29ce4ULL)));
+        cache_path = cache_directory_ + name;
+        std::string cached;
+        if (load_cached_output(cache_path, cache_material, cached)) {
+            debug_print("Output cache hit: " + cache_path);
+            return cached;
+        }
+    }
     
     // Initialize the inclusion stack
     std::unordered_set<std::string> inclusion_stack;
@@ -23,8 +127,215 @@ std::string Preprocessor::process(const std::string& root_filepath) {
         throw std::runtime_error("Preprocessor error: " + std::string(e.what()));
     }
     
-    // Return the final processed content
-    return output_stream_.str();
+    // Join the pieces into the final processed content
+    size_t total = 0;
+    for (std::string_view piece : output_pieces_) total += piece.size();
+    std::string result;
+    result.reserve(total);
+    for (std::string_view piece : output_pieces_) result.append(piece.data(), piece.size());
+
+    output_pieces_.clear();
+    line_directives_.clear();
+    files_in_use_.clear();
+    if (!cache_path.empty()) store_cached_output(cache_path, cache_material, result);
+    dependencies_.clear();
+    return result;
+}
+
+void Preprocessor::setCacheDirectory(const std::string& directory) {
+    cache_directory_ = directory;
+}
+
+void Preprocessor::record_dependency(const std::string& path, const struct stat* st) {
+    Dependency dependency;
+    dependency.path = path;
+    dependency.exists = st != nullptr;
+    if (st) {
+        struct timespec mtime = modification_time(*st);
+        dependency.mtime_sec = static_cast<int64_t>(mtime.tv_sec);
+        dependency.mtime_nsec = static_cast<int64_t>(mtime.tv_nsec);
+        dependency.size = static_cast<uint64_t>(st->st_size);
+    }
+    dependencies_.push_back(std::move(dependency));
+}
+
+// Relative GET paths and the root path resolve against the working directory
+// and the include paths, so those are part of what the output depends on.
+std::string Preprocessor::output_cache_material(const std::string& root_filepath) const {
+    std::string material;
+    char cwd[PATH_MAX];
+    put_str(material, getcwd(cwd, sizeof(cwd)) ? std::string(cwd) : std::string());
+    put_str(material, root_filepath);
+    for (const auto& path : include_paths_) put_str(material, path);
+    return material;
+}
+
+bool Preprocessor::load_cached_output(const std::string& cache_path, const std::string& material,
+                                      std::string& output) const {
+    int fd = open(cache_path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    std::string contents;
+    bool read_ok = read_all(fd, contents, 0);
+    close(fd);
+    if (!read_ok || contents.size() < sizeof(OUTPUT_CACHE_MAGIC) ||
+        std::memcmp(contents.data(), OUTPUT_CACHE_MAGIC, sizeof(OUTPUT_CACHE_MAGIC)) != 0) {
+        return false;
+    }
+
+    size_t pos = sizeof(OUTPUT_CACHE_MAGIC);
+    uint64_t format = 0, count = 0;
+    std::string stored_material;
+    if (!get_u64(contents, pos, format) || format != OUTPUT_CACHE_FORMAT_VERSION ||
+        !get_str(contents, pos, stored_material) || stored_material != material ||
+        !get_u64(contents, pos, count)) {
+        return false;
+    }
+
+    // Every file read, and every path probed and found missing, must be as it was
+    for (uint64_t i = 0; i < count; ++i) {
+        std::string path;
+        uint64_t exists, mtime_sec, mtime_nsec, size;
+        if (!get_str(contents, pos, path) || !get_u64(contents, pos, exists) || !get_u64(contents, pos, mtime_sec) ||
+            !get_u64(contents, pos, mtime_nsec) || !get_u64(contents, pos, size)) {
+            return false;
+        }
+        struct stat st;
+        bool now_exists = stat(path.c_str(), &st) == 0;
+        if (now_exists != (exists != 0)) return false;
+        if (now_exists) {
+            struct timespec mtime = modification_time(st);
+            if (static_cast<uint64_t>(mtime.tv_sec) != mtime_sec || static_cast<uint64_t>(mtime.tv_nsec) != mtime_nsec ||
+                static_cast<uint64_t>(st.st_size) != size) {
+                return false;
+            }
+        }
+    }
+
+    std::string result;
+    if (!get_str(contents, pos, result) || pos != contents.size()) return false;
+    output = std::move(result);
+    return true;
+}
+
+void Preprocessor::store_cached_output(const std::string& cache_path, const std::string& material,
+                                       const std::string& output) const {
+    std::string out(OUTPUT_CACHE_MAGIC, sizeof(OUTPUT_CACHE_MAGIC));
+    put_u64(out, OUTPUT_CACHE_FORMAT_VERSION);
+    put_str(out, material);
+    put_u64(out, dependencies_.size());
+    for (const auto& dependency : dependencies_) {
+        put_str(out, dependency.path);
+        put_u64(out, dependency.exists ? 1 : 0);
+        put_u64(out, static_cast<uint64_t>(dependency.mtime_sec));
+        put_u64(out, static_cast<uint64_t>(dependency.mtime_nsec));
+        put_u64(out, dependency.size);
+    }
+    put_str(out, output);
+
+    // Write to a private temporary and rename, as CompilationCache does; a
+    // cache that cannot be written is simply not used.
+    std::error_code error;
+    std::filesystem::create_directories(cache_directory_, error);
+    std::string temp_path = cache_path + ".tmp." + std::to_string(getpid());
+    FILE* file = std::fopen(temp_path.c_str(), "wb");
+    if (!file) return;
+    bool written = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+    written = std::fclose(file) == 0 && written;
+    if (!written || std::rename(temp_path.c_str(), cache_path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+    }
+}
+
+void Preprocessor::emit_line_directive(int line_number, const std::string& path) {
+    line_directives_.push_back("//LINE " + std::to_string(line_number) + " \"" + path + "\"\n");
+    emit(line_directives_.back());
+}
+
+std::shared_ptr<const Preprocessor::SourceFile> Preprocessor::load_source(const std::string& filepath) {
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        record_dependency(filepath, nullptr);
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return nullptr;
+    }
+    record_dependency(filepath, &st);
+
+    char resolved[PATH_MAX];
+    std::string key = realpath(filepath.c_str(), resolved) ? std::string(resolved) : filepath;
+    struct timespec mtime = modification_time(st);
+
+    // Process-wide: later Preprocessor instances (and later GETs of the same
+    // header) reuse the text and the split. Never destroyed. Across runs the
+    // output cache (setCacheDirectory) takes over.
+    static std::mutex cache_mutex;
+    static auto* cache = new std::unordered_map<std::string, std::shared_ptr<const SourceFile>>();
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto it = cache->find(key);
+        if (it != cache->end() && it->second->size == static_cast<size_t>(st.st_size) &&
+            it->second->mtime.tv_sec == mtime.tv_sec && it->second->mtime.tv_nsec == mtime.tv_nsec) {
+            close(fd);
+            debug_print("Include cache hit: " + key);
+            return it->second;
+        }
+    }
+
+    // Read rather than map: a mapped file truncated by another process while
+    // in use would raise SIGBUS on the next access.
+    auto file = std::make_shared<SourceFile>();
+    file->path = key;
+    file->mtime = mtime;
+    bool read_ok = read_all(fd, file->text, static_cast<size_t>(st.st_size));
+    close(fd);
+    if (!read_ok) return nullptr;
+    file->data = file->text.data();
+    file->size = file->text.size();
+    // A file that changed size while being read is used as read but not
+    // cached; the next load will find it stale anyway.
+    bool cacheable = file->size == static_cast<size_t>(st.st_size);
+
+    // Split into runs of ordinary lines and GET directives, once per file version.
+    // Lines end at '\n' (as std::getline); a last line without one gets it added.
+    std::string_view text(file->data, file->size);
+    SourceFile::Segment run;
+    int line_number = 1;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t newline = text.find('\n', pos);
+        size_t line_end = newline == std::string_view::npos ? text.size() : newline;
+        size_t next = newline == std::string_view::npos ? text.size() : newline + 1;
+        std::string_view line = text.substr(pos, line_end - pos);
+
+        std::string include = is_get_directive(line) ? extract_filename(line) : "";
+        if (include.empty()) {
+            // Ordinary line (or malformed GET, kept as text): extend the current run
+            if (run.length == 0) run.offset = pos;
+            run.length = next - run.offset;
+            run.add_newline = newline == std::string_view::npos;
+        } else {
+            if (run.length > 0) file->segments.push_back(run);
+            run = SourceFile::Segment();
+            SourceFile::Segment get;
+            get.include = std::move(include);
+            get.line_number = line_number;
+            file->segments.push_back(std::move(get));
+        }
+        pos = next;
+        line_number++;
+    }
+    if (run.length > 0) file->segments.push_back(run);
+
+    if (cacheable) {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        (*cache)[key] = file;
+    }
+    return file;
 }
 
 void Preprocessor::addIncludePath(const std::string& path) {
@@ -63,21 +374,21 @@ void Preprocessor::process_internal(const std::string& current_filepath,
     
     debug_print("Processing file: " + canonical_path);
     
-    // Open the file
-    std::ifstream file(current_filepath);
-    if (!file.is_open()) {
+    // Read the file (or take it from the include cache)
+    std::shared_ptr<const SourceFile> file = load_source(current_filepath);
+    if (!file) {
         // Try to find the file in the include paths
         std::string resolved_path = resolve_file_path(current_filepath, "");
         if (!resolved_path.empty() && resolved_path != current_filepath) {
             // Found in include path, try again with resolved path
-            file.open(resolved_path);
-            if (file.is_open()) {
+            file = load_source(resolved_path);
+            if (file) {
                 debug_print("Found in include path: " + resolved_path);
                 canonical_path = resolved_path;  // Update canonical path
             }
         }
         
-        if (!file.is_open()) {
+        if (!file) {
             // Check if we have a parent file in the inclusion stack to provide better context
             std::string context = "";
             for (const auto& included_file : inclusion_stack) {
@@ -103,6 +414,8 @@ void Preprocessor::process_internal(const std::string& current_filepath,
             throw std::runtime_error("Could not open file: " + current_filepath + context + searched_paths);
         }
     }
+    // Keep the text alive until process() has joined the output
+    files_in_use_.push_back(file);
     
     // Get the directory of the current file for relative includes
     std::string current_dir;
@@ -113,103 +426,90 @@ void Preprocessor::process_internal(const std::string& current_filepath,
     }
     
     // Add line directive for source mapping
-    output_stream_ << "//LINE 1 \"" << canonical_path << "\"\n";
+    emit_line_directive(1, canonical_path);
     
-    // Process the file line by line
-    std::string line;
-    int line_number = 1;
-    
-    while (std::getline(file, line)) {
-        // Check if this line contains a GET directive
-        if (is_get_directive(line)) {
-            std::string include_file = extract_filename(line);
-            if (!include_file.empty()) {
-                debug_print("Found GET directive: " + include_file);
-                
-                // Resolve the path of the included file relative to the current file
-                std::string include_path = resolve_file_path(include_file, current_dir);
-                
-                if (include_path.empty()) {
-                    // Build a list of paths that were searched
-                    std::string searched_paths = "\n  - Current directory: " + current_dir;
-                    for (const auto& path : include_paths_) {
-                        searched_paths += "\n  - Include path: " + path;
-                    }
-                    
-                    throw std::runtime_error("Could not resolve include file: " + include_file + 
-                                           " referenced from " + canonical_path + 
-                                           " at line " + std::to_string(line_number) +
-                                           "\nSearched in:" + searched_paths);
-                }
-                
-                // Recursively process the included file
-                process_internal(include_path, inclusion_stack);
-                
-                // Add line directive after returning from the included file
-                output_stream_ << "//LINE " << (line_number + 1) << " \"" << canonical_path << "\"\n";
-            }
-            else {
-                // Malformed GET directive, keep it in the output
-                output_stream_ << line << '\n';
-            }
+    // Text runs go out as views into the file text; only GETs need work
+    for (const auto& segment : file->segments) {
+        if (segment.include.empty()) {
+            emit(std::string_view(file->data + segment.offset, segment.length));
+            if (segment.add_newline) emit("\n");
+            continue;
         }
-        else {
-            // Regular line, just append it
-            output_stream_ << line << '\n';
+
+        const std::string& include_file = segment.include;
+        debug_print("Found GET directive: " + include_file);
+        
+        // Resolve the path of the included file relative to the current file
+        std::string include_path = resolve_file_path(include_file, current_dir);
+        
+        if (include_path.empty()) {
+            // Build a list of paths that were searched
+            std::string searched_paths = "\n  - Current directory: " + current_dir;
+            for (const auto& path : include_paths_) {
+                searched_paths += "\n  - Include path: " + path;
+            }
+            
+            throw std::runtime_error("Could not resolve include file: " + include_file + 
+                                   " referenced from " + canonical_path + 
+                                   " at line " + std::to_string(segment.line_number) +
+                                   "\nSearched in:" + searched_paths);
         }
         
-        line_number++;
+        // Recursively process the included file
+        process_internal(include_path, inclusion_stack);
+        
+        // Add line directive after returning from the included file
+        emit_line_directive(segment.line_number + 1, canonical_path);
     }
     
     // Remove this file from the inclusion stack now that we're done with it
     inclusion_stack.erase(canonical_path);
 }
 
-bool Preprocessor::is_get_directive(const std::string& line) {
-    // Create a trimmed copy of the line
-    std::string trimmed = line;
-    
-    // Remove leading whitespace
-    trimmed.erase(trimmed.begin(), 
-                 std::find_if(trimmed.begin(), trimmed.end(), 
-                             [](unsigned char ch) { return !std::isspace(ch); }));
+bool Preprocessor::is_get_directive(std::string_view line) {
+    // Skip leading whitespace
+    size_t start = 0;
+    while (start < line.size() && std::isspace(static_cast<unsigned char>(line[start]))) {
+        start++;
+    }
     
     // Check if it starts with GET (case insensitive)
-    if (trimmed.size() >= 3) {
-        std::string prefix = trimmed.substr(0, 3);
-        std::transform(prefix.begin(), prefix.end(), prefix.begin(), 
-                      [](unsigned char c){ return std::toupper(c); });
-        return prefix == "GET";
+    if (line.size() - start >= 3) {
+        return std::toupper(static_cast<unsigned char>(line[start])) == 'G' &&
+               std::toupper(static_cast<unsigned char>(line[start + 1])) == 'E' &&
+               std::toupper(static_cast<unsigned char>(line[start + 2])) == 'T';
     }
     
     return false;
 }
 
-std::string Preprocessor::extract_filename(const std::string& line) {
+std::string Preprocessor::extract_filename(std::string_view line) {
     // Find the first quote
     size_t first_quote = line.find('"');
-    if (first_quote == std::string::npos) {
+    if (first_quote == std::string_view::npos) {
         return "";
     }
     
     // Find the closing quote
     size_t last_quote = line.find('"', first_quote + 1);
-    if (last_quote == std::string::npos) {
+    if (last_quote == std::string_view::npos) {
         return "";
     }
     
     // Extract the filename between quotes
-    return line.substr(first_quote + 1, last_quote - first_quote - 1);
+    return std::string(line.substr(first_quote + 1, last_quote - first_quote - 1));
 }
 
 std::string Preprocessor::resolve_file_path(const std::string& requested_file, 
                                            const std::string& current_dir) {
     struct stat buffer;
     
-    // Try with the requested path as-is first
+    // Try with the requested path as-is first. Misses are recorded too: a
+    // file appearing earlier in the search order changes the output.
     if (stat(requested_file.c_str(), &buffer) == 0) {
         return requested_file;
     }
+    record_dependency(requested_file, nullptr);
     
     // Try relative to the current file's directory
     if (!current_dir.empty()) {
@@ -217,6 +517,7 @@ std::string Preprocessor::resolve_file_path(const std::string& requested_file,
         if (stat(potential_path.c_str(), &buffer) == 0) {
             return potential_path;
         }
+        record_dependency(potential_path, nullptr);
     }
     
     // Try the include paths
@@ -225,6 +526,7 @@ std::string Preprocessor::resolve_file_path(const std::string& requested_file,
         if (stat(potential_path.c_str(), &buffer) == 0) {
             return potential_path;
         }
+        record_dependency(potential_path, nullptr);
     }
     
     // If still not found, return empty string
@@ -9,7 +9,12 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string_view>
 #include <vector>
+#include <sys/stat.h>
 
 class Preprocessor {
 public:
@@ -25,20 +30,50 @@ public:
     // Enable debug output for the preprocessor
     void enableDebug(bool enable = true) { debug_enabled_ = enable; }
 
+    // Keep each expanded root file in `directory` between runs. An entry is
+    // used only while every file it read (and every search path probe that
+    // found nothing) still has the same mtime and size. Empty: no cache.
+    void setCacheDirectory(const std::string& directory);
+
 private:
+    // A source file read into memory and split into text runs and GET
+    // directives. Shared through a process-wide, in-memory cache keyed by
+    // canonical path; an entry is reused while the file's mtime and size are
+    // unchanged. It lives as long as the process; the output cache below is
+    // what persists across compiler runs.
+    struct SourceFile;
+
+    // A path the output depends on: a file read, or a probe that found nothing
+    struct Dependency {
+        std::string path;
+        bool exists = false;
+        int64_t mtime_sec = 0;
+        int64_t mtime_nsec = 0;
+        uint64_t size = 0;
+    };
+
+    // Returns the cached (or newly read) file, or nullptr if it cannot be opened
+    std::shared_ptr<const SourceFile> load_source(const std::string& filepath);
+
+    void record_dependency(const std::string& path, const struct stat* st);
+    std::string output_cache_material(const std::string& root_filepath) const;
+    bool load_cached_output(const std::string& cache_path, const std::string& material, std::string& output) const;
+    void store_cached_output(const std::string& cache_path, const std::string& material,
+                             const std::string& output) const;
+
     // Recursive helper to process a file and its includes
     void process_internal(const std::string& current_filepath, 
                           std::unordered_set<std::string>& inclusion_stack);
 
     // Helper to extract the filename from a GET directive line
-    std::string extract_filename(const std::string& line);
+    std::string extract_filename(std::string_view line);
 
     // Resolve file path using include directories
     std::string resolve_file_path(const std::string& requested_file, 
                                  const std::string& current_dir);
     
     // Check if a line contains a GET directive
-    bool is_get_directive(const std::string& line);
+    bool is_get_directive(std::string_view line);
 
     // Print debug information if debug mode is enabled
     void debug_print(const std::string& message);
@@ -47,12 +82,22 @@ private:
     std::string get_parent_file(const std::unordered_set<std::string>& inclusion_stack,
                                const std::string& current_file);
 
-    // The stream that accumulates the final source code
-    std::ostringstream output_stream_;
+    // The output, as views into file texts and into line_directives_;
+    // process() joins them once at the end.
+    std::vector<std::string_view> output_pieces_;
+    std::deque<std::string> line_directives_;
+    std::vector<std::shared_ptr<const SourceFile>> files_in_use_;
+
+    void emit(std::string_view text) { if (!text.empty()) output_pieces_.push_back(text); }
+    void emit_line_directive(int line_number, const std::string& path);
 
     // List of include search directories
     std::vector<std::string> include_paths_;
 
+    // Output cache directory (empty: disabled) and what this run depended on
+    std::string cache_directory_;
+    std::vector<Dependency> dependencies_;
+
     // Flag for enabling debug output
     bool debug_enabled_ = false;
 };
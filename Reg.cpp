@@ -0,0 +1,89 @@
+#include "Reg.h"
+#include <stdexcept>
+
+namespace {
+
+constexpr int NUM_KINDS = Reg::Q + 1;
+
+inline char lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+inline bool equals_lower(const std::string& name, const char* alias) {
+    size_t i = 0;
+    for (; alias[i]; ++i) {
+        if (i >= name.size() || lower(name[i]) != alias[i]) return false;
+    }
+    return i == name.size();
+}
+
+const std::string* build_name_table() {
+    static const char prefixes[NUM_KINDS] = { 'W', 'X', 0, 0, 0, 0, 'S', 'D', 'V', 'Q' };
+    std::string* table = new std::string[NUM_KINDS * 32]; // never destroyed: used by static Instructions
+    for (int kind = 0; kind < NUM_KINDS; ++kind) {
+        for (int n = 0; n < 32; ++n) {
+            if (prefixes[kind]) {
+                table[kind * 32 + n] = prefixes[kind] + std::to_string(n);
+            }
+        }
+    }
+    table[Reg::WSP * 32 + 31] = "WSP";
+    table[Reg::SP * 32 + 31] = "SP";
+    table[Reg::WZR * 32 + 31] = "WZR";
+    table[Reg::XZR * 32 + 31] = "XZR";
+    return table;
+}
+
+} // namespace
+
+uint8_t Reg::checked(unsigned n) {
+    if (n > 31) {
+        throw std::invalid_argument("Register number " + std::to_string(n) + " is out of the valid range [0, 31].");
+    }
+    return static_cast<uint8_t>(n);
+}
+
+bool Reg::try_parse(const std::string& name, Reg& out) {
+    if (name.empty()) return false;
+
+    // Aliases for register 31
+    if (equals_lower(name, "sp"))  { out = sp();  return true; }
+    if (equals_lower(name, "wsp")) { out = wsp(); return true; }
+    if (equals_lower(name, "xzr")) { out = xzr(); return true; }
+    if (equals_lower(name, "wzr")) { out = wzr(); return true; }
+
+    Kind kind;
+    switch (lower(name[0])) {
+        case 'w': kind = W; break;
+        case 'x': kind = X; break;
+        case 's': kind = S; break;
+        case 'd': kind = D; break;
+        case 'v': kind = V; break;
+        case 'q': kind = Q; break;
+        default: return false;
+    }
+
+    size_t i = 1;
+    unsigned number = 0;
+    while (i < name.size() && name[i] >= '0' && name[i] <= '9' && number <= 31) {
+        number = number * 10 + static_cast<unsigned>(name[i] - '0');
+        ++i;
+    }
+    if (i == 1 || number > 31) return false;
+
+    out = Reg(kind, static_cast<uint8_t>(number));
+    return true;
+}
+
+Reg Reg::parse(const std::string& name) {
+    Reg reg;
+    if (!try_parse(name, reg)) {
+        throw std::invalid_argument("Invalid register name: '" + name + "'.");
+    }
+    return reg;
+}
+
+const std::string& Reg::name() const {
+    static const std::string* table = build_name_table();
+    return table[kind_ * 32 + number_];
+}
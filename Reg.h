@@ -0,0 +1,103 @@
+#ifndef REG_H
+#define REG_H
+
+#include <bitset>
+#include <cstdint>
+#include <string>
+
+// Register classes on ARM64
+enum class RegClass : uint8_t {
+    GPR, // W/X general-purpose registers, including WSP/SP and WZR/XZR
+    FP,  // S/D scalar floating-point registers
+    VEC  // V/Q 128-bit vector registers
+};
+
+// A typed ARM64 register: a kind (which fixes the class and width) plus a
+// 5-bit number.
+//
+// Encoders OR number() straight into the instruction word, so code that
+// already knows which register it wants never builds or parses a name.
+// The string overloads in Encoder parse once with Reg::parse() and then
+// use the same path.
+//
+// The encoders that have Reg overloads (ADD/SUB/MOV/CMP and LDR/STR
+// immediate), the peephole rewrites, prologue and epilogue,
+// RegisterManager's state and LinearScanAllocator's assignments use Reg.
+// The code generators still pass register names as strings between
+// RegisterManager's name shims and the string encoders.
+class Reg {
+public:
+    enum Kind : uint8_t { W, X, WSP, SP, WZR, XZR, S, D, V, Q };
+
+    constexpr Reg() : kind_(X), number_(0) {}
+    constexpr Reg(Kind kind, uint8_t number) : kind_(kind), number_(number) {}
+
+    // Factories. Numbered forms throw std::invalid_argument above 31.
+    static Reg x(unsigned n) { return Reg(X, checked(n)); }
+    static Reg w(unsigned n) { return Reg(W, checked(n)); }
+    static Reg s(unsigned n) { return Reg(S, checked(n)); }
+    static Reg d(unsigned n) { return Reg(D, checked(n)); }
+    static Reg v(unsigned n) { return Reg(V, checked(n)); }
+    static Reg q(unsigned n) { return Reg(Q, checked(n)); }
+    static constexpr Reg sp() { return Reg(SP, 31); }
+    static constexpr Reg wsp() { return Reg(WSP, 31); }
+    static constexpr Reg xzr() { return Reg(XZR, 31); }
+    static constexpr Reg wzr() { return Reg(WZR, 31); }
+
+    // Parses a register name ("X19", "w0", "sp", "xzr", "D3", "V0.4S", ...).
+    // Case-insensitive and allocation-free. As with the stoul-based parsers
+    // it replaces, anything after the register number (e.g. a vector
+    // arrangement) is ignored.
+    // @throw std::invalid_argument if the name is not a register.
+    static Reg parse(const std::string& name);
+
+    // Non-throwing form of parse(); returns false if the name is invalid.
+    static bool try_parse(const std::string& name, Reg& out);
+
+    constexpr Kind kind() const { return kind_; }
+    constexpr uint32_t number() const { return number_; }
+    constexpr RegClass reg_class() const {
+        return kind_ <= XZR ? RegClass::GPR : (kind_ <= D ? RegClass::FP : RegClass::VEC);
+    }
+    constexpr unsigned width() const {
+        switch (kind_) {
+            case W: case WSP: case WZR: case S: return 32;
+            case V: case Q: return 128;
+            default: return 64;
+        }
+    }
+
+    constexpr bool is_gpr() const { return reg_class() == RegClass::GPR; }
+    constexpr bool is_64bit() const { return width() == 64; }
+    constexpr bool is_sp() const { return kind_ == SP || kind_ == WSP; }
+    constexpr bool is_zr() const { return kind_ == XZR || kind_ == WZR; }
+
+    // Canonical upper-case name ("X19", "SP", "WZR", "D0"). The string is
+    // owned by a static table, so the reference is always valid.
+    const std::string& name() const;
+
+    constexpr bool operator==(Reg other) const { return kind_ == other.kind_ && number_ == other.number_; }
+    constexpr bool operator!=(Reg other) const { return !(*this == other); }
+
+private:
+    static uint8_t checked(unsigned n);
+
+    Kind kind_;
+    uint8_t number_;
+};
+
+// A set of registers, one bit per kind and number
+class RegSet {
+public:
+    void insert(Reg reg) { bits_.set(index(reg)); }
+    void erase(Reg reg) { bits_.reset(index(reg)); }
+    bool contains(Reg reg) const { return bits_.test(index(reg)); }
+    bool empty() const { return bits_.none(); }
+
+private:
+    static size_t index(Reg reg) { return reg.kind() * 32 + reg.number(); }
+
+    std::bitset<(Reg::Q + 1) * 32> bits_;
+};
+
+#endif // REG_H
@@ -34,50 +34,73 @@ const std::vector<std::string> RegisterManager::FP_SCRATCH_REGS = {
     "D21", "D22", "D23", "D24", "D25", "D26", "D27", "D28", "D29", "D30", "D31"
 };
 
+// Registers first..last of one kind, plus any of `more`
+static std::vector<Reg> reg_range(Reg::Kind kind, unsigned first, unsigned last,
+                                  std::initializer_list<unsigned> more = {}) {
+    std::vector<Reg> pool;
+    for (unsigned n = first; n <= last; ++n) pool.push_back(Reg(kind, static_cast<uint8_t>(n)));
+    for (unsigned n : more) pool.push_back(Reg(kind, static_cast<uint8_t>(n)));
+    return pool;
+}
+
+const std::vector<Reg> RegisterManager::VARIABLE_POOL = reg_range(Reg::X, 19, 27);
+const std::vector<Reg> RegisterManager::SCRATCH_POOL = reg_range(Reg::X, 9, 15);
+const std::vector<Reg> RegisterManager::RESERVED_POOL = { Reg::x(19), Reg::x(28) };
+const std::vector<Reg> RegisterManager::FP_VARIABLE_POOL = reg_range(Reg::D, 8, 15);
+const std::vector<Reg> RegisterManager::FP_SCRATCH_POOL = reg_range(Reg::D, 0, 7, { 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31 });
+const std::vector<Reg> RegisterManager::VEC_VARIABLE_POOL = reg_range(Reg::V, 8, 15);
+const std::vector<Reg> RegisterManager::VEC_SCRATCH_POOL = reg_range(Reg::V, 0, 7, { 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31 });
+
 // -----------------------------------------------------------------------------
 // Invalidate all caller-saved registers after a function call (ABI correctness)
 // -----------------------------------------------------------------------------
 void RegisterManager::invalidate_caller_saved_registers() {
     // This function iterates through all caller-saved scratch registers
     // and resets their state to FREE, clearing any stale variable mappings.
-    for(const auto& reg_name : SCRATCH_REGS) {
-        if (registers.count(reg_name)) {
+    for (Reg reg : SCRATCH_POOL) {
+        if (registers.count(reg)) {
             // If a variable was mapped to this register, remove the mapping.
-            if (registers[reg_name].status == IN_USE_VARIABLE) {
-                const std::string& var_name = registers[reg_name].bound_to;
+            if (registers[reg].status == IN_USE_VARIABLE) {
+                const std::string& var_name = registers[reg].bound_to;
                 variable_to_reg_map.erase(var_name);
                 variable_reg_lru_order_.remove(var_name);
             }
             // Reset the register to its default free state.
-            registers[reg_name] = {FREE, "", false};
+            registers[reg] = {FREE, "", false};
         }
     }
     // Also invalidate floating-point scratch registers.
-    for(const auto& reg_name : FP_SCRATCH_REGS) {
-        if (registers.count(reg_name)) {
-             if (registers[reg_name].status == IN_USE_VARIABLE) {
-                const std::string& var_name = registers[reg_name].bound_to;
+    for (Reg reg : FP_SCRATCH_POOL) {
+        if (registers.count(reg)) {
+             if (registers[reg].status == IN_USE_VARIABLE) {
+                const std::string& var_name = registers[reg].bound_to;
                 fp_variable_to_reg_map_.erase(var_name);
                 fp_variable_reg_lru_order_.remove(var_name);
             }
-            registers[reg_name] = {FREE, "", false, false};
+            registers[reg] = {FREE, "", false, false};
         }
     }
 }
 
 // --- Register state tracking: is_initialized flag ---
-void RegisterManager::set_initialized(const std::string& reg_name, bool value) {
-    if (registers.count(reg_name)) {
-        registers[reg_name].is_initialized = value;
+void RegisterManager::set_initialized(Reg reg, bool value) {
+    if (registers.count(reg)) {
+        registers[reg].is_initialized = value;
     }
 }
 
+bool RegisterManager::is_initialized(Reg reg) const {
+    return registers.count(reg) && registers.at(reg).is_initialized;
+}
+
+void RegisterManager::set_initialized(const std::string& reg_name, bool value) {
+    Reg reg;
+    if (parse_name(reg_name, reg)) set_initialized(reg, value);
+}
+
 bool RegisterManager::is_initialized(const std::string& reg_name) const {
-    auto it = registers.find(reg_name);
-    if (it != registers.end()) {
-        return it->second.is_initialized;
-    }
-    return false;
+    Reg reg;
+    return parse_name(reg_name, reg) && is_initialized(reg);
 }
 
 // --- Vector Register Pools ---
@@ -97,8 +120,13 @@ const std::vector<std::string> RegisterManager::VEC_SCRATCH_REGS = {
 #include <stdexcept>
 
 void RegisterManager::cleanup_stale_mappings_for_reg(const std::string& reg_name) {
+    Reg reg;
+    if (parse_name(reg_name, reg)) cleanup_stale_mappings_for_reg(reg);
+}
+
+void RegisterManager::cleanup_stale_mappings_for_reg(Reg reg) {
    for (auto it = variable_to_reg_map.begin(); it != variable_to_reg_map.end(); ) {
-       if (it->second == reg_name) {
+       if (it->second == reg) {
            const std::string& var_to_remove = it->first;
            variable_reg_lru_order_.remove(var_to_remove);
            it = variable_to_reg_map.erase(it);
@@ -122,15 +150,15 @@ void RegisterManager::dump_state(const std::string& context) const {
 
     // --- General Purpose Registers ---
     std::vector<std::string> used_gp, free_gp;
-    std::vector<std::string> all_gp_regs = SCRATCH_REGS;
-    all_gp_regs.insert(all_gp_regs.end(), VARIABLE_REGS.begin(), VARIABLE_REGS.end());
+    std::vector<Reg> all_gp_regs = SCRATCH_POOL;
+    all_gp_regs.insert(all_gp_regs.end(), VARIABLE_POOL.begin(), VARIABLE_POOL.end());
 
-    for (const auto& reg_name : all_gp_regs) {
-        const auto& info = registers.at(reg_name);
+    for (Reg reg : all_gp_regs) {
+        const auto& info = registers.at(reg);
         if (info.status == FREE) {
-            free_gp.push_back(reg_name);
+            free_gp.push_back(reg.name());
         } else {
-            std::string details = reg_name + " (bound to: '" + info.bound_to +
+            std::string details = reg.name() + " (bound to: '" + info.bound_to +
                                   "', dirty: " + (info.dirty ? "yes" : "no") + ")";
             used_gp.push_back(details);
         }
@@ -143,15 +171,15 @@ void RegisterManager::dump_state(const std::string& context) const {
 
     // --- Floating-Point Registers ---
     std::vector<std::string> used_fp, free_fp;
-    std::vector<std::string> all_fp_regs = FP_SCRATCH_REGS;
-    all_fp_regs.insert(all_fp_regs.end(), FP_VARIABLE_REGS.begin(), FP_VARIABLE_REGS.end());
+    std::vector<Reg> all_fp_regs = FP_SCRATCH_POOL;
+    all_fp_regs.insert(all_fp_regs.end(), FP_VARIABLE_POOL.begin(), FP_VARIABLE_POOL.end());
 
-    for (const auto& reg_name : all_fp_regs) {
-        const auto& info = registers.at(reg_name);
+    for (Reg reg : all_fp_regs) {
+        const auto& info = registers.at(reg);
         if (info.status == FREE) {
-            free_fp.push_back(reg_name);
+            free_fp.push_back(reg.name());
         } else {
-            std::string details = reg_name + " (bound to: '" + info.bound_to +
+            std::string details = reg.name() + " (bound to: '" + info.bound_to +
                                   "', dirty: " + (info.dirty ? "yes" : "no") + ")";
             used_fp.push_back(details);
         }
@@ -168,7 +196,7 @@ void RegisterManager::dump_state(const std::string& context) const {
         std::cout << "  (empty)\n";
     } else {
         for (const auto& pair : variable_to_reg_map) {
-            std::cout << "  '" << pair.first << "' -> " << pair.second << "\n";
+            std::cout << "  '" << pair.first << "' -> " << pair.second.name() << "\n";
         }
     }
 
@@ -198,15 +226,15 @@ std::string RegisterManager::get_next_available_temp_reg() {
     static const int kLastCalleeSaved = 28;
 
     for (int i = kFirstCalleeSaved; i <= kLastCalleeSaved; ++i) {
-        std::string reg = "X" + std::to_string(i);
+        Reg reg = Reg::x(i);
 
         // Skip reserved registers if needed (e.g., X28 for global base)
-        if (reg == "X28") continue;
+        if (i == 28) continue;
 
         // Only allocate if the register is free
         if (!registers.count(reg) || registers[reg].status == FREE) {
             registers[reg] = {IN_USE_SCRATCH, "temp", false};
-            return reg;
+            return reg.name();
         }
     }
 
@@ -215,12 +243,12 @@ std::string RegisterManager::get_next_available_temp_reg() {
     
     // Try again after stale cleanup
     for (int i = kFirstCalleeSaved; i <= kLastCalleeSaved; ++i) {
-        std::string reg = "X" + std::to_string(i);
-        if (reg == "X28") continue;
+        Reg reg = Reg::x(i);
+        if (i == 28) continue;
         
         if (!registers.count(reg) || registers[reg].status == FREE) {
             registers[reg] = {IN_USE_SCRATCH, "temp", false};
-            return reg;
+            return reg.name();
         }
     }
     
@@ -229,12 +257,12 @@ std::string RegisterManager::get_next_available_temp_reg() {
     
     // Final attempt after all cleanup
     for (int i = kFirstCalleeSaved; i <= kLastCalleeSaved; ++i) {
-        std::string reg = "X" + std::to_string(i);
-        if (reg == "X28") continue;
+        Reg reg = Reg::x(i);
+        if (i == 28) continue;
         
         if (!registers.count(reg) || registers[reg].status == FREE) {
             registers[reg] = {IN_USE_SCRATCH, "temp", false};
-            return reg;
+            return reg.name();
         }
     }
 
@@ -268,31 +296,15 @@ void RegisterManager::initialize_registers() {
     variable_reg_lru_order_.clear();
     spilled_variables_.clear();
     
-    // Initialize all registers as clean (not dirty)
-    for (const auto& reg : VARIABLE_REGS) {
-        registers[reg].dirty = false;
-    }
-    for (const auto& reg : SCRATCH_REGS) {
-        registers[reg].dirty = false;
-    }
-
-    for (const auto& reg : FP_VARIABLE_REGS) {
-        registers[reg].dirty = false;
-    }
-    for (const auto& reg : FP_SCRATCH_REGS) {
-        registers[reg].dirty = false;
-    }
-
-    // Initialize all managed registers to FREE
-
-    for (const auto& reg : VARIABLE_REGS) registers[reg] = {FREE, "", false};
-    for (const auto& reg : SCRATCH_REGS) registers[reg] = {FREE, "", false};
-    for (const auto& reg : RESERVED_REGS) registers[reg] = {IN_USE_DATA_BASE, "data_base", false};
-    for (const auto& reg : FP_VARIABLE_REGS) registers[reg] = {FREE, "", false};
-    for (const auto& reg : FP_SCRATCH_REGS) registers[reg] = {FREE, "", false};
+    // Initialize all managed registers to FREE (and clean)
+    for (Reg reg : VARIABLE_POOL) registers[reg] = {FREE, "", false};
+    for (Reg reg : SCRATCH_POOL) registers[reg] = {FREE, "", false};
+    for (Reg reg : RESERVED_POOL) registers[reg] = {IN_USE_DATA_BASE, "data_base", false};
+    for (Reg reg : FP_VARIABLE_POOL) registers[reg] = {FREE, "", false};
+    for (Reg reg : FP_SCRATCH_POOL) registers[reg] = {FREE, "", false};
     // Vector register initialization
-    for (const auto& reg : VEC_VARIABLE_REGS) registers[reg] = {FREE, "", false};
-    for (const auto& reg : VEC_SCRATCH_REGS) registers[reg] = {FREE, "", false};
+    for (Reg reg : VEC_VARIABLE_POOL) registers[reg] = {FREE, "", false};
+    for (Reg reg : VEC_SCRATCH_POOL) registers[reg] = {FREE, "", false};
     fp_variable_to_reg_map_.clear();
     fp_variable_reg_lru_order_.clear();
     vec_variable_to_reg_map_.clear();
@@ -314,12 +326,13 @@ std::string RegisterManager::get_free_float_register() {
 
 
 
+bool RegisterManager::is_scratch_register(Reg reg) const {
+    return reg.kind() == Reg::X && reg.number() >= 9 && reg.number() <= 15;
+}
+
 bool RegisterManager::is_scratch_register(const std::string& register_name) const {
-    // This is a simplified check. A more robust implementation would use the SCRATCH_REGS vector.
-    for (const auto& reg : SCRATCH_REGS) {
-        if (reg == register_name) return true;
-    }
-    return false;
+    Reg reg;
+    return parse_name(register_name, reg) && is_scratch_register(reg);
 }
 
 
@@ -330,20 +343,21 @@ bool RegisterManager::is_scratch_register(const std::string& register_name) cons
 
 // --- Helper Functions ---
 
-std::string RegisterManager::find_free_register(const std::vector<std::string>& pool) {
-    for (const auto& reg : pool) {
+bool RegisterManager::find_free_register(const std::vector<Reg>& pool, Reg& out) const {
+    for (Reg reg : pool) {
         if (registers.at(reg).status == FREE) {
-            return reg;
+            out = reg;
+            return true;
         }
     }
-    return "";
+    return false;
 }
 
-Instruction RegisterManager::generate_spill_code(const std::string& reg_name, const std::string& variable_name, CallFrameManager& cfm) {
+Instruction RegisterManager::generate_spill_code(Reg reg, const std::string& variable_name, CallFrameManager& cfm) {
     // If the register is not dirty (hasn't been modified since loading), we can skip the store
-    if (!is_dirty(reg_name)) {
+    if (!is_dirty(reg)) {
         // Return an empty instruction (no-op) to indicate no spill needed
-        return Instruction(0, "// Skipping spill for clean register " + reg_name + " (" + variable_name + ")");
+        return Instruction(0, "// Skipping spill for clean register " + reg.name() + " (" + variable_name + ")");
     }
     
     // Otherwise generate the store instruction for the dirty register
@@ -351,9 +365,9 @@ Instruction RegisterManager::generate_spill_code(const std::string& reg_name, co
     
     // Use appropriate store instruction based on variable type
     if (cfm.is_float_variable(variable_name)) {
-        return Encoder::create_str_fp_imm(reg_name, "X29", offset);
+        return Encoder::create_str_fp_imm(reg.name(), "X29", offset);
     } else {
-        return Encoder::create_str_imm(reg_name, "X29", offset, variable_name);
+        return Encoder::create_str_imm(reg, Reg::x(29), offset, variable_name);
     }
 }
 
@@ -372,12 +386,16 @@ Instruction RegisterManager::generate_spill_code(const std::string& reg_name, co
 // --- ABI & State Management ---
 
 std::string RegisterManager::acquire_scratch_reg(NewCodeGenerator& code_gen) {
+    return acquire_scratch(code_gen).name();
+}
+
+Reg RegisterManager::acquire_scratch(NewCodeGenerator& code_gen) {
     // Phase 3: LinearScanAllocator is now the single source of truth for allocation decisions.
     // This method only manages the pre-allocated scratch register pool.
     
     // 1. Try the dedicated scratch pool first.
-    std::string reg = find_free_register(SCRATCH_REGS);
-    if (!reg.empty()) {
+    Reg reg;
+    if (find_free_register(SCRATCH_POOL, reg)) {
         registers[reg] = {IN_USE_SCRATCH, "scratch", false};
         return reg;
     }
@@ -388,8 +406,7 @@ std::string RegisterManager::acquire_scratch_reg(NewCodeGenerator& code_gen) {
         if (debug_enabled_) {
             std::cout << "[CLEANUP] Freed " << freed_count << " clean scratch registers" << std::endl;
         }
-        reg = find_free_register(SCRATCH_REGS);
-        if (!reg.empty()) {
+        if (find_free_register(SCRATCH_POOL, reg)) {
             registers[reg] = {IN_USE_SCRATCH, "scratch", false};
             return reg;
         }
@@ -405,10 +422,17 @@ std::string RegisterManager::acquire_scratch_reg(NewCodeGenerator& code_gen) {
 
 // Acquire a vector scratch register (caller-saved)
 std::string RegisterManager::acquire_vec_scratch_reg() {
-    std::string reg = find_free_register(VEC_SCRATCH_REGS);
-    if (!reg.empty()) {
-        registers[reg] = {IN_USE_SCRATCH, "vec_scratch", false};
-        return reg;
+    return acquire_vec_scratch().name();
+}
+
+Reg RegisterManager::acquire_vec_scratch() {
+    // V<n> and D<n> are the same register, so skip any whose D half is in use
+    for (Reg reg : VEC_SCRATCH_POOL) {
+        Reg alias = Reg::d(reg.number());
+        if (registers.at(reg).status == FREE && (!registers.count(alias) || registers.at(alias).status == FREE)) {
+            registers[reg] = {IN_USE_SCRATCH, "vec_scratch", false};
+            return reg;
+        }
     }
     throw std::runtime_error("No available vector scratch registers.");
 }
@@ -417,102 +441,89 @@ int RegisterManager::emergency_cleanup_scratch_registers() {
     int freed_count = 0;
 
     // Free any clean scratch registers (not dirty, so safe to release)
-    std::vector<std::string> to_free;
-    for (const auto& [reg_name, reg_info] : registers) {
+    registers.for_each([&](Reg reg, RegisterInfo& reg_info) {
         if (reg_info.status == IN_USE_SCRATCH && !reg_info.dirty && 
             (reg_info.bound_to == "scratch" || reg_info.bound_to == "scratch_from_vars")) {
-            to_free.push_back(reg_name);
-        }
-    }
-
-    for (const std::string& reg_name : to_free) {
-        registers[reg_name] = {FREE, "", false};
-        freed_count++;
-        if (debug_enabled_) {
-            std::cout << "[EMERGENCY] Released clean scratch register: " << reg_name << std::endl;
+            reg_info = {FREE, "", false};
+            freed_count++;
+            if (debug_enabled_) {
+                std::cout << "[EMERGENCY] Released clean scratch register: " << reg.name() << std::endl;
+            }
         }
-    }
+    });
 
     return freed_count;
 }
 
 void RegisterManager::cleanup_expression_boundary() {
     // Release all clean scratch registers that aren't needed between expressions
-    std::vector<std::string> to_release;
-    
-    for (const auto& [reg_name, reg_info] : registers) {
+    registers.for_each([&](Reg reg, RegisterInfo& reg_info) {
         if (reg_info.status == IN_USE_SCRATCH && !reg_info.dirty) {
-            to_release.push_back(reg_name);
-        }
-    }
-    
-    for (const std::string& reg_name : to_release) {
-        registers[reg_name] = {FREE, "", false};
-        if (debug_enabled_) {
-            std::cout << "[BOUNDARY] Released clean scratch register: " << reg_name << std::endl;
+            reg_info = {FREE, "", false};
+            if (debug_enabled_) {
+                std::cout << "[BOUNDARY] Released clean scratch register: " << reg.name() << std::endl;
+            }
         }
-    }
+    });
 }
 
 void RegisterManager::force_cleanup_stale_variable_mappings() {
     // Find registers marked as scratch_from_vars but with no corresponding variable mapping
-    std::vector<std::string> stale_regs;
-    
-    for (const auto& [reg_name, reg_info] : registers) {
+    registers.for_each([&](Reg reg, RegisterInfo& reg_info) {
         if (reg_info.status == IN_USE_SCRATCH && reg_info.bound_to == "scratch_from_vars") {
             // This register should have a corresponding variable, but check if it's stale
             bool has_valid_mapping = false;
             for (const auto& [var_name, mapped_reg] : variable_to_reg_map) {
-                if (mapped_reg == reg_name) {
+                if (mapped_reg == reg) {
                     has_valid_mapping = true;
                     break;
                 }
             }
             
             if (!has_valid_mapping && !reg_info.dirty) {
-                stale_regs.push_back(reg_name);
+                reg_info = {FREE, "", false};
+                if (debug_enabled_) {
+                    std::cout << "[CLEANUP] Freed stale scratch_from_vars register: " << reg.name() << std::endl;
+                }
             }
         }
-    }
-    
-    // Clean up stale mappings
-    for (const std::string& reg_name : stale_regs) {
-        registers[reg_name] = {FREE, "", false};
-        if (debug_enabled_) {
-            std::cout << "[CLEANUP] Freed stale scratch_from_vars register: " << reg_name << std::endl;
-        }
+    });
+}
+
+void RegisterManager::release_vec_scratch_reg(Reg reg) {
+    if (registers.count(reg) && registers.at(reg).status == IN_USE_SCRATCH) {
+        registers[reg] = {FREE, "", false};
     }
 }
 
 void RegisterManager::release_vec_scratch_reg(const std::string& reg_name) {
-    if (registers.count(reg_name) && registers.at(reg_name).status == IN_USE_SCRATCH) {
-        registers[reg_name] = {FREE, "", false};
-    }
+    Reg reg;
+    if (parse_name(reg_name, reg)) release_vec_scratch_reg(reg);
 }
 
 // Acquire a vector variable register (callee-saved, with LRU spill)
 std::string RegisterManager::acquire_vec_variable_reg(const std::string& variable_name, NewCodeGenerator& code_gen, CallFrameManager& cfm) {
     // 1. Cache Hit: Variable is already in a register
     if (vec_variable_to_reg_map_.count(variable_name)) {
-        std::string reg = vec_variable_to_reg_map_.at(variable_name);
+        Reg reg = vec_variable_to_reg_map_.at(variable_name);
         vec_variable_reg_lru_order_.remove(variable_name);
         vec_variable_reg_lru_order_.push_front(variable_name);
-        return reg;
+        return reg.name();
     }
 
     // 2. Cache Miss: Find a free register
-    std::string reg = find_free_register(VEC_VARIABLE_REGS);
-    if (!reg.empty()) {
+    Reg reg;
+    if (find_free_register(VEC_VARIABLE_POOL, reg)) {
         registers[reg] = {IN_USE_VARIABLE, variable_name, false};
         vec_variable_to_reg_map_[variable_name] = reg;
         vec_variable_reg_lru_order_.push_front(variable_name);
-        return reg;
+        return reg.name();
     }
 
     // 3. Spill: No free registers, spill the least recently used one.
     std::string victim_var = vec_variable_reg_lru_order_.back();
     vec_variable_reg_lru_order_.pop_back();
-    std::string victim_reg = vec_variable_to_reg_map_[victim_var];
+    Reg victim_reg = vec_variable_to_reg_map_.at(victim_var);
     
     // Generate spill code (uses 128-bit STR)
     int offset = cfm.get_offset(victim_var); // Assumes CFM handles 16-byte slots
@@ -525,7 +536,7 @@ std::string RegisterManager::acquire_vec_variable_reg(const std::string& variabl
     vec_variable_to_reg_map_[variable_name] = victim_reg;
     vec_variable_reg_lru_order_.push_front(variable_name);
 
-    return victim_reg;
+    return victim_reg.name();
 }
 
 
@@ -587,8 +598,8 @@ void RegisterManager::update_live_intervals(const std::map<std::string, std::map
     
     const auto& func_allocations = func_it->second;
     
-    // Clear previous variable-to-register mappings for reused registers
-    std::set<std::string> active_registers;
+    // Registers holding a variable live at this point
+    RegSet active_registers;
     
     if (debug_enabled_) {
         std::cout << "[LIVE] Updating live intervals at instruction point " << instruction_point << std::endl;
@@ -596,9 +607,9 @@ void RegisterManager::update_live_intervals(const std::map<std::string, std::map
     
     // Update register assignments based on live intervals
     for (const auto& [variable, interval] : func_allocations) {
-        const std::string& physical_reg = interval.assigned_register;
-        
-        if (!physical_reg.empty() && registers.count(physical_reg)) {
+        if (interval.assigned_register && registers.count(*interval.assigned_register)) {
+            Reg physical_reg = *interval.assigned_register;
+
             // Check if this variable is live at the current instruction point
             bool is_live = (instruction_point >= interval.start_point && instruction_point <= interval.end_point);
             
@@ -609,7 +620,7 @@ void RegisterManager::update_live_intervals(const std::map<std::string, std::map
                 registers[physical_reg] = {IN_USE_VARIABLE, variable, false};
                 
                 // Update variable mapping
-                if (physical_reg.find("D") == 0) {
+                if (is_fp_register(physical_reg)) {
                     // Float register
                     fp_variable_to_reg_map_[variable] = physical_reg;
                     
@@ -626,12 +637,12 @@ void RegisterManager::update_live_intervals(const std::map<std::string, std::map
                 }
                 
                 if (debug_enabled_) {
-                    std::cout << "[LIVE] Register " << physical_reg << " active for variable " << variable 
+                    std::cout << "[LIVE] Register " << physical_reg.name() << " active for variable " << variable 
                               << " [" << interval.start_point << "-" << interval.end_point << "]" << std::endl;
                 }
             } else if (instruction_point > interval.end_point) {
                 // Variable is no longer live, remove from mappings
-                if (physical_reg.find("D") == 0) {
+                if (is_fp_register(physical_reg)) {
                     fp_variable_to_reg_map_.erase(variable);
                     fp_variable_reg_lru_order_.remove(variable);
                 } else {
@@ -640,25 +651,25 @@ void RegisterManager::update_live_intervals(const std::map<std::string, std::map
                 }
                 
                 if (debug_enabled_) {
-                    std::cout << "[LIVE] Variable " << variable << " expired from register " << physical_reg << std::endl;
+                    std::cout << "[LIVE] Variable " << variable << " expired from register " << physical_reg.name() << std::endl;
                 }
             }
         }
     }
     
     // Free registers that are no longer active
-    for (auto& [reg_name, reg_info] : registers) {
-        if (reg_info.status == IN_USE_VARIABLE && active_registers.find(reg_name) == active_registers.end()) {
+    registers.for_each([&](Reg reg, RegisterInfo& reg_info) {
+        if (reg_info.status == IN_USE_VARIABLE && !active_registers.contains(reg)) {
             // This register was allocated by the LinearScanAllocator but no variable is currently live in it
             reg_info.status = FREE;
             reg_info.bound_to = "";
             reg_info.dirty = false;
             
             if (debug_enabled_) {
-                std::cout << "[LIVE] Freed register " << reg_name << " (no active variables)" << std::endl;
+                std::cout << "[LIVE] Freed register " << reg.name() << " (no active variables)" << std::endl;
             }
         }
-    }
+    });
 }
 
 void RegisterManager::reset_allocations() {
@@ -669,11 +680,11 @@ void RegisterManager::reset_allocations() {
     // Clear all variable mappings and reset registers to FREE
     // But preserve any registers that are currently being used as scratch
     
-    for (auto& [reg_name, reg_info] : registers) {
+    registers.for_each([](Reg, RegisterInfo& reg_info) {
         if (reg_info.status == IN_USE_VARIABLE) {
             reg_info = {FREE, "", false};
         }
-    }
+    });
     
     // Clear variable mappings
     variable_to_reg_map.clear();
@@ -722,12 +733,12 @@ bool RegisterManager::is_caller_saved_fp(const std::string& reg_name) const {
 std::string RegisterManager::get_register_for_variable(const std::string& variable_name) const {
     auto it = variable_to_reg_map.find(variable_name);
     if (it != variable_to_reg_map.end()) {
-        return it->second;
+        return it->second.name();
     }
     // Also check FP variable map
     auto fp_it = fp_variable_to_reg_map_.find(variable_name);
     if (fp_it != fp_variable_to_reg_map_.end()) {
-        return fp_it->second;
+        return fp_it->second.name();
     }
     return "";
 }
@@ -742,14 +753,9 @@ void RegisterManager::mark_register_as_used(const std::string& reg_name) {
 
 
 bool RegisterManager::is_fp_register(const std::string& reg_name) const {
-    // Check if the register is in the FP variable or scratch pools
-    for (const auto& reg : FP_VARIABLE_REGS) {
-        if (reg == reg_name) return true;
-    }
-    for (const auto& reg : FP_SCRATCH_REGS) {
-        if (reg == reg_name) return true;
-    }
-    return false;
+    // The FP pools hold D0-D31
+    Reg reg;
+    return parse_name(reg_name, reg) && is_fp_register(reg);
 }
 
 // --- Q Register Management (128-bit NEON registers) ---
@@ -7,13 +7,18 @@
 #include <list>
 #include <unordered_set>
 #include <map>
+#include <stdexcept>
 #include "Encoder.h"
+#include "Reg.h"
 
 // Forward declarations
 class NewCodeGenerator;
 class CallFrameManager;
 struct LiveInterval;
 
+// Register state is kept per Reg, so the allocation paths never build or
+// parse register names. The methods taking and returning names are shims
+// that parse once with parse_name() or return Reg::name().
 class RegisterManager {
 public:
     // --- FP Register Pools ---
@@ -34,8 +39,19 @@ public:
     }
     static RegisterManager& getInstance();
 
+    // The serial compiler uses getInstance(); each code generation worker
+    // (--jobs N) owns a RegisterManager of its own.
+    RegisterManager();
+    ~RegisterManager() = default;
+
     // Check if a register is a scratch register
     bool is_scratch_register(const std::string& register_name) const;
+    bool is_scratch_register(Reg reg) const;
+
+    // --- Typed acquisition: the same pools as the string methods ---
+    Reg acquire_scratch(NewCodeGenerator& code_gen);
+    Reg acquire_fp_scratch();
+    Reg acquire_vec_scratch();
 
 
 
@@ -45,6 +61,7 @@ public:
     void release_reg_for_variable(const std::string& variable_name);
     std::string acquire_scratch_reg(NewCodeGenerator& code_gen);
     void release_scratch_reg(const std::string& reg_name);
+    void release_scratch_reg(Reg reg);
 
     // Acquire/release a callee-saved temp register for preserving values across function calls
     std::string acquire_callee_saved_temp_reg(CallFrameManager& cfm);
@@ -140,18 +157,21 @@ public:
     // --- Helper methods for code generation compatibility ---
     std::string get_free_register(NewCodeGenerator& code_gen);
     void release_register(const std::string& reg_name);
+    void release_register(Reg reg);
     std::string get_free_float_register();
 
     // --- Floating-point register allocation ---
     std::string acquire_fp_reg_for_variable(const std::string& variable_name, NewCodeGenerator& code_gen, CallFrameManager& cfm);
     std::string acquire_fp_scratch_reg();
     void release_fp_register(const std::string& reg_name);
+    void release_fp_register(Reg reg);
     std::vector<std::string> get_in_use_fp_callee_saved_registers() const;
     std::vector<std::string> get_in_use_fp_caller_saved_registers() const;
 
     // --- Vector Register Management ---
     std::string acquire_vec_scratch_reg();
     void release_vec_scratch_reg(const std::string& reg_name);
+    void release_vec_scratch_reg(Reg reg);
     std::string acquire_vec_variable_reg(const std::string& variable_name, NewCodeGenerator& code_gen, CallFrameManager& cfm);
     
     // --- Q Register Management (128-bit NEON registers) ---
@@ -160,7 +180,7 @@ public:
     void release_q_register(const std::string& qreg);
 
     // --- Floating-point register management ---
-    std::unordered_map<std::string, std::string> fp_variable_to_reg_map_;
+    std::unordered_map<std::string, Reg> fp_variable_to_reg_map_;
     std::list<std::string> fp_variable_reg_lru_order_;
 
     // Counter for unique temporary names
@@ -168,12 +188,13 @@ public:
 
     // Helper to proactively clean up stale variable-to-register mappings
     void cleanup_stale_mappings_for_reg(const std::string& reg_name);
+    void cleanup_stale_mappings_for_reg(Reg reg);
 
     // Debug/trace flag for conditional state dumps
     bool debug_enabled_ = false;
 
     // --- Vector Register Tracking ---
-    std::unordered_map<std::string, std::string> vec_variable_to_reg_map_;
+    std::unordered_map<std::string, Reg> vec_variable_to_reg_map_;
     std::list<std::string> vec_variable_reg_lru_order_;
 
 
@@ -186,10 +207,14 @@ public:
     // --- Register state tracking ---
     void set_initialized(const std::string& reg_name, bool value);
     bool is_initialized(const std::string& reg_name) const;
+    void set_initialized(Reg reg, bool value);
+    bool is_initialized(Reg reg) const;
 
     // --- ABI & State Management ---
     void mark_dirty(const std::string& reg_name, bool is_dirty = true);
     bool is_dirty(const std::string& reg_name) const;
+    void mark_dirty(Reg reg, bool is_dirty = true);
+    bool is_dirty(Reg reg) const;
     std::vector<std::pair<std::string, std::string>> get_dirty_variable_registers() const;
     std::vector<std::string> get_in_use_callee_saved_registers() const;
     std::vector<std::string> get_in_use_caller_saved_registers() const;
@@ -202,6 +227,10 @@ public:
         };
         return std::find(callee_saved.begin(), callee_saved.end(), reg_name) != callee_saved.end();
     }
+    static bool is_callee_saved(Reg reg) {
+        return (reg.kind() == Reg::X && reg.number() >= 19 && reg.number() <= 28) ||
+               (reg.kind() == Reg::D && reg.number() >= 8 && reg.number() <= 15);
+    }
 
 
     // Returns the next available pre-reserved callee-saved temp register (X19-X28)
@@ -224,6 +253,7 @@ public:
     bool is_neon_enabled() const { return neon_enabled_; }
 
     bool is_fp_register(const std::string& reg_name) const;
+    bool is_fp_register(Reg reg) const { return reg.kind() == Reg::D; }
     bool is_variable_spilled(const std::string& variable_name) const;
 
     // --- Register allocation helpers for spill/restore ---
@@ -235,16 +265,18 @@ public:
     std::string get_register_for_variable(const std::string& variable_name) const;
 
 private:
-    // Private constructor to prevent direct instantiation
-    RegisterManager();
-    // Private destructor (optional, but good practice for singletons if specific cleanup is needed)
-    ~RegisterManager() = default;
-
     // Delete copy constructor and assignment operator to prevent copying
     RegisterManager(const RegisterManager&) = delete;
     RegisterManager& operator=(const RegisterManager&) = delete;
 
     static RegisterManager* instance_;
+
+    // The Reg for a name spelled as Reg::name() spells it ("X9", "D0").
+    // Anything else, which never matched the name-keyed state either, gives
+    // false and the shims ignore it.
+    static bool parse_name(const std::string& name, Reg& reg) {
+        return Reg::try_parse(name, reg) && reg.name() == name;
+    }
     
     // NEON enable/disable state
     bool neon_enabled_ = true;  // Default: NEON enabled
@@ -274,9 +306,50 @@ public:
         bool is_initialized = false; // Tracks if register holds valid value
     };
 
+    // RegisterInfo for each register, indexed by Reg. Only the registers
+    // in the pools have entries, so count() separates managed registers
+    // from the rest. W5 and X5 (or D5 and V5) are separate entries.
+    class RegisterFile {
+    public:
+        bool count(Reg reg) const { return managed_[slot(reg)]; }
+        RegisterInfo& operator[](Reg reg) {
+            managed_[slot(reg)] = true;
+            return info_[slot(reg)];
+        }
+        RegisterInfo& at(Reg reg) { return const_cast<RegisterInfo&>(static_cast<const RegisterFile&>(*this).at(reg)); }
+        const RegisterInfo& at(Reg reg) const {
+            if (!managed_[slot(reg)]) throw std::out_of_range("Register " + reg.name() + " is not managed.");
+            return info_[slot(reg)];
+        }
+        void clear() {
+            for (size_t i = 0; i < SLOTS; ++i) {
+                managed_[i] = false;
+                info_[i] = RegisterInfo{FREE, "", false};
+            }
+        }
+        // Calls f(reg, info) for each managed register, in Reg order
+        template <typename F> void for_each(F f) {
+            for (size_t i = 0; i < SLOTS; ++i) {
+                if (managed_[i]) f(reg_at(i), info_[i]);
+            }
+        }
+        template <typename F> void for_each(F f) const {
+            for (size_t i = 0; i < SLOTS; ++i) {
+                if (managed_[i]) f(reg_at(i), info_[i]);
+            }
+        }
+
+    private:
+        static constexpr size_t SLOTS = (Reg::Q + 1) * 32;
+        static size_t slot(Reg reg) { return reg.kind() * 32 + reg.number(); }
+        static Reg reg_at(size_t i) { return Reg(static_cast<Reg::Kind>(i / 32), static_cast<uint8_t>(i % 32)); }
+
+        RegisterInfo info_[SLOTS] = {};
+        bool managed_[SLOTS] = {};
+    };
 
-    std::unordered_map<std::string, RegisterInfo> registers;
-    std::unordered_map<std::string, std::string> variable_to_reg_map;
+    RegisterFile registers;
+    std::unordered_map<std::string, Reg> variable_to_reg_map;
     std::list<std::string> variable_reg_lru_order_;
 
     // Stores the list of caller-saved GP and FP registers spilled for restoration
@@ -293,6 +366,15 @@ public:
     const std::string DATA_BASE_REG = "X28";
     static const std::vector<std::string> VARIABLE_REGS;
 
+    // The pools above as Regs, in the same order
+    static const std::vector<Reg> VARIABLE_POOL;
+    static const std::vector<Reg> SCRATCH_POOL;
+    static const std::vector<Reg> RESERVED_POOL;
+    static const std::vector<Reg> FP_VARIABLE_POOL;
+    static const std::vector<Reg> FP_SCRATCH_POOL;
+    static const std::vector<Reg> VEC_VARIABLE_POOL;
+    static const std::vector<Reg> VEC_SCRATCH_POOL;
+
     // --- Caller-saved registers for liveness analysis ---
     static const std::vector<std::string> CALLER_SAVED_REGS;
     
@@ -308,8 +390,9 @@ public:
     int current_instruction_point_ = 0;
 
     void initialize_registers();
-    std::string find_free_register(const std::vector<std::string>& pool);
-    Instruction generate_spill_code(const std::string& reg_name, const std::string& variable_name, CallFrameManager& cfm);
+    // The first FREE register in pool, if any
+    bool find_free_register(const std::vector<Reg>& pool, Reg& out) const;
+    Instruction generate_spill_code(Reg reg, const std::string& variable_name, CallFrameManager& cfm);
 };
 
 #endif // REGISTER_MANAGER_H
@@ -28,6 +28,7 @@ extern "C" {
     int bcpl_alloc_chars(int count);
     int bcpl_getvec(int size);
     int bcpl_fgetvec(int size);
+    int bcpl_getvec_scoped(int size);
     void bcpl_free(int ptr);
     
     // Math functions
@@ -128,6 +129,11 @@ const RuntimeFunctionInfo RUNTIME_FUNCTION_REGISTRY[] = {
         FunctionType::STANDARD, VarType::POINTER_TO_FLOAT_VEC, SymbolKind::RUNTIME_FUNCTION,
         "Allocate float vector"
     },
+    {
+        "GETVEC_SCOPED", reinterpret_cast<void*>(bcpl_getvec_scoped), "_GETVEC_SCOPED", 1,
+        FunctionType::STANDARD, VarType::POINTER_TO_INT_VEC, SymbolKind::RUNTIME_FUNCTION,
+        "Allocate scope-local integer vector"
+    },
     {
         "FREEVEC", reinterpret_cast<void*>(bcpl_free), "_FREEVEC", 1,
         FunctionType::STANDARD, VarType::INTEGER, SymbolKind::RUNTIME_ROUTINE,
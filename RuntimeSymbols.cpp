@@ -103,6 +103,29 @@ void RuntimeSymbols::registerAll(SymbolTable& symbol_table) {
         {VarType::POINTER_TO_STRING_LIST, false},  // list of strings
         {VarType::STRING, false}                   // delimiter string
     });
+
+    // String builders
+    registerRuntimeFunction(symbol_table, "SB_NEW", {
+        {VarType::INTEGER, false}  // initial capacity
+    });
+    registerRuntimeFunction(symbol_table, "SB_APPEND", {
+        {VarType::INTEGER, false}, // builder
+        {VarType::STRING, false}   // string to append
+    });
+    registerRuntimeFunction(symbol_table, "SB_APPENDC", {
+        {VarType::INTEGER, false}, // builder
+        {VarType::INTEGER, false}  // character
+    });
+    registerRuntimeFunction(symbol_table, "SB_APPENDN", {
+        {VarType::INTEGER, false}, // builder
+        {VarType::INTEGER, false}  // number
+    });
+    registerRuntimeFunction(symbol_table, "SB_CLEAR", {
+        {VarType::INTEGER, false}  // builder
+    });
+    registerRuntimeFunction(symbol_table, "SB_STRING", {
+        {VarType::INTEGER, false}  // builder
+    });
     
     // FILE_ API functions
     registerRuntimeFunction(symbol_table, "FILE_OPEN_READ", {
@@ -124,6 +147,9 @@ void RuntimeSymbols::registerAll(SymbolTable& symbol_table) {
     registerRuntimeFunction(symbol_table, "FILE_READS", {
         {VarType::INTEGER, false}  // file handle
     });
+    registerRuntimeFunction(symbol_table, "FILE_READLINE", {
+        {VarType::INTEGER, false}  // file handle
+    });
     registerRuntimeFunction(symbol_table, "FILE_READ", {
         {VarType::INTEGER, false}, // file handle
         {VarType::INTEGER, false}, // buffer
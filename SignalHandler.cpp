@@ -18,6 +18,7 @@ extern "C" {
     #include "runtime/BCPLError.h"
     extern volatile BCPLErrorInfo g_recent_errors[16];
     extern volatile size_t g_recent_error_index;
+    void bcpl_output_flush_signal_safe(void);
 }
 
 void SignalHandler::fatal_signal_handler(int signum, siginfo_t* info, void* context) {
@@ -31,6 +32,8 @@ void SignalHandler::fatal_signal_handler(int signum, siginfo_t* info, void* cont
         case SIGTRAP: signame = "SIGTRAP"; break;
         default:      signame = "UNKNOWN"; break;
     }
+    // Program output still in the runtime's buffer belongs before the report.
+    bcpl_output_flush_signal_safe();
     safe_print("Fatal Signal (");
     safe_print(signame);
     safe_print(") caught.\n");
@@ -21,6 +21,12 @@ std::string StringTable::get_or_create_label(const std::string& value) {
     return label;
 }
 
+// Returns the label for a string, or an empty string if it is not interned
+std::string StringTable::get_label(const std::string& value) const {
+    auto it = string_to_label_.find(value);
+    return it != string_to_label_.end() ? it->second : std::string();
+}
+
 // Returns all label->string mappings (for emission)
 const std::unordered_map<std::string, std::string>& StringTable::get_all_labels() const {
     return label_to_string_;
@@ -24,26 +24,127 @@ void SymbolTable::setCurrentFunction(const std::string& function_name) {
     current_function_name_ = function_name;
 }
 
+uint32_t SymbolTable::intern(const std::string& name) {
+    auto it = interned_names_.find(name);
+    if (it != interned_names_.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(interned_names_.size());
+    interned_names_.emplace(name, id);
+    return id;
+}
+
+bool SymbolTable::internedId(const std::string& name, uint32_t& id) const {
+    auto it = interned_names_.find(name);
+    if (it == interned_names_.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+const std::vector<size_t>* SymbolTable::indexFor(const std::string& name) const {
+    uint32_t name_id;
+    if (!internedId(name, name_id)) return nullptr;
+    auto it = by_name_.find(name_id);
+    return (it == by_name_.end() || it->second.empty()) ? nullptr : &it->second;
+}
+
+const std::vector<size_t>* SymbolTable::indexFor(const std::string& function_name, const std::string& name) const {
+    uint32_t name_id, function_id;
+    if (!internedId(name, name_id) || !internedId(function_name, function_id)) return nullptr;
+    auto it = by_function_and_name_.find(functionKey(function_id, name_id));
+    return (it == by_function_and_name_.end() || it->second.empty()) ? nullptr : &it->second;
+}
+
+Symbol* SymbolTable::latest(const std::string& name) {
+    const std::vector<size_t>* entries = indexFor(name);
+    return entries ? &all_symbols_[entries->back()] : nullptr;
+}
+
+// Indexes are kept ascending; appends are the common case, reindexing after
+// updateSymbol renames a symbol is the only out-of-order insert.
+static void insertSorted(std::vector<size_t>& entries, size_t index) {
+    if (entries.empty() || entries.back() < index) {
+        entries.push_back(index);
+    } else {
+        entries.insert(std::lower_bound(entries.begin(), entries.end(), index), index);
+    }
+}
+
+static void eraseSorted(std::vector<size_t>& entries, size_t index) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), index);
+    if (it != entries.end() && *it == index) {
+        entries.erase(it);
+    }
+}
+
+void SymbolTable::indexSymbol(size_t index) {
+    const Symbol& symbol = all_symbols_[index];
+    uint32_t name_id = intern(symbol.name);
+    uint32_t function_id = intern(symbol.function_name);
+    insertSorted(by_name_[name_id], index);
+    insertSorted(by_function_and_name_[functionKey(function_id, name_id)], index);
+}
+
+void SymbolTable::unindexSymbol(size_t index) {
+    const Symbol& symbol = all_symbols_[index];
+    uint32_t name_id = intern(symbol.name);
+    uint32_t function_id = intern(symbol.function_name);
+    eraseSorted(by_name_[name_id], index);
+    eraseSorted(by_function_and_name_[functionKey(function_id, name_id)], index);
+}
+
 bool SymbolTable::addSymbol(const Symbol& symbol) {
     // Check for redefinition in the current scope
-    for (auto it = all_symbols_.rbegin(); it != all_symbols_.rend(); ++it) {
-        if (it->name == symbol.name && it->scope_level == current_scope_level_ && it->function_name == current_function_name_) {
-            // Redefinition in the same scope and function
-            return false;
+    if (const std::vector<size_t>* entries = indexFor(current_function_name_, symbol.name)) {
+        for (auto it = entries->rbegin(); it != entries->rend(); ++it) {
+            if (all_symbols_[*it].scope_level == current_scope_level_) {
+                // Redefinition in the same scope and function
+                return false;
+            }
         }
     }
     all_symbols_.push_back(symbol);
+    indexSymbol(all_symbols_.size() - 1);
     SymbolLogger::getInstance().logSymbol(symbol);
     return true;
 }
 
-bool SymbolTable::lookup(const std::string& name, Symbol& symbol) const {
-    // Search from innermost to outermost scope
-    for (auto it = all_symbols_.rbegin(); it != all_symbols_.rend(); ++it) {
-        if (it->name == name) {
-            symbol = *it;
-            return true;
+const Symbol* SymbolTable::find(const std::string& name) const {
+    // The latest declaration wins (innermost to outermost scope)
+    const std::vector<size_t>* entries = indexFor(name);
+    return entries ? &all_symbols_[entries->back()] : nullptr;
+}
+
+const Symbol* SymbolTable::find(const std::string& name, const std::string& function_name) const {
+    // 1. First, search in the requested function context
+    if (const std::vector<size_t>* entries = indexFor(function_name, name)) {
+        return &all_symbols_[entries->back()];
+    }
+
+    // 2. If not found in the requested context, search in Global scope
+    if (const std::vector<size_t>* entries = indexFor("Global", name)) {
+        return &all_symbols_[entries->back()];
+    }
+
+    // 3. Only as a last resort, search in other local function contexts
+    // (entries for this name are all from other functions by now)
+    if (const std::vector<size_t>* entries = indexFor(name)) {
+        const Symbol& symbol = all_symbols_[entries->back()];
+        if (g_enable_symbols_trace) {
+            std::cout << "[SYMBOL TABLE TRACE] Warning: Found symbol '" << name << "' in different context '" 
+                     << symbol.function_name << "' (requested context was '" << function_name << "')" << std::endl;
         }
+        return &symbol;
+    }
+    return nullptr;
+}
+
+bool SymbolTable::lookup(const std::string& name, Symbol& symbol) const {
+    if (const Symbol* found = find(name)) {
+        symbol = *found;
+        return true;
     }
     // Add trace message on failure
     if (g_enable_symbols_trace) {
@@ -53,56 +154,16 @@ bool SymbolTable::lookup(const std::string& name, Symbol& symbol) const {
 }
 
 bool SymbolTable::lookup(const std::string& name, const std::string& function_name, Symbol& symbol) const {
-    // CORRECTED FIX: Prioritize the requested function context first
-    // This ensures we find the correct symbol in the proper scope
-    
-    // 1. First, search in the requested function context
-    for (auto it = all_symbols_.rbegin(); it != all_symbols_.rend(); ++it) {
-        if (it->name == name && it->function_name == function_name) {
-            symbol = *it;
-            return true;
-        }
-    }
-    
-    // 2. If not found in the requested context, search in Global scope
-    for (auto it = all_symbols_.rbegin(); it != all_symbols_.rend(); ++it) {
-        if (it->name == name && it->function_name == "Global") {
-            symbol = *it;
-            return true;
-        }
+    if (const Symbol* found = find(name, function_name)) {
+        symbol = *found;
+        return true;
     }
-    
-    // 3. Only as a last resort, search in other local function contexts
-    for (auto it = all_symbols_.rbegin(); it != all_symbols_.rend(); ++it) {
-        if (it->name == name && it->function_name != "Global" && it->function_name != function_name) {
-            symbol = *it;
-            if (g_enable_symbols_trace) {
-                std::cout << "[SYMBOL TABLE TRACE] Warning: Found symbol '" << name << "' in different context '" 
-                         << it->function_name << "' (requested context was '" << function_name << "')" << std::endl;
-            }
-            return true;
-        }
-    }
-    
+
     // Add trace message on failure
     if (g_enable_symbols_trace) {
         std::cout << "[SYMBOL TABLE TRACE] Lookup FAILED for symbol: '" << name << "' in function context '" << function_name << "'" << std::endl;
+        std::cout << "[SYMBOL TABLE TRACE]   Symbol '" << name << "' not found in ANY context" << std::endl;
     }
-    
-    // Debug: Show what symbols DO exist for this name in other contexts
-    bool found_in_other_context = false;
-    if (g_enable_symbols_trace) {
-        for (auto it = all_symbols_.rbegin(); it != all_symbols_.rend(); ++it) {
-            if (it->name == name) {
-                std::cout << "[SYMBOL TABLE TRACE]   Found '" << name << "' in function context '" << it->function_name << "' (scope level " << it->scope_level << ")" << std::endl;
-                found_in_other_context = true;
-            }
-        }
-        if (!found_in_other_context) {
-            std::cout << "[SYMBOL TABLE TRACE]   Symbol '" << name << "' not found in ANY context" << std::endl;
-        }
-    }
-    
     return false;
 }
 
@@ -124,40 +185,43 @@ std::vector<Symbol> SymbolTable::getSymbolsInScope(int scope_level) const {
 }
 
 bool SymbolTable::updateSymbol(const std::string& name, const Symbol& new_symbol_data) {
-    for (auto it = all_symbols_.rbegin(); it != all_symbols_.rend(); ++it) {
-        if (it->name == name) {
-            // Check type priority before updating
-            if (should_update_type(it->type, new_symbol_data.type)) {
-                *it = new_symbol_data;
-                SymbolLogger::getInstance().logSymbol(*it);
-                return true;
-            } else {
-                return false;
-            }
-        }
+    const std::vector<size_t>* entries = indexFor(name);
+    if (!entries) {
+        return false;
     }
-    return false;
+    size_t index = entries->back();
+    Symbol* symbol = &all_symbols_[index];
+    // Check type priority before updating
+    if (!should_update_type(symbol->type, new_symbol_data.type)) {
+        return false;
+    }
+    bool rekey = symbol->name != new_symbol_data.name || symbol->function_name != new_symbol_data.function_name;
+    if (rekey) unindexSymbol(index);
+    *symbol = new_symbol_data;
+    if (rekey) indexSymbol(index);
+    SymbolLogger::getInstance().logSymbol(*symbol);
+    return true;
 }
 
 bool SymbolTable::updateSymbolType(const std::string& name, VarType type) {
-    for (auto it = all_symbols_.rbegin(); it != all_symbols_.rend(); ++it) {
-        if (it->name == name) {
-            // Check type priority before updating
-            if (should_update_type(it->type, type)) {
-                it->type = type;
-                SymbolLogger::getInstance().logSymbol(*it);
-                return true;
-            } else {
-                return false;
-            }
-        }
+    Symbol* symbol = latest(name);
+    // Check type priority before updating
+    if (!symbol || !should_update_type(symbol->type, type)) {
+        return false;
     }
-    return false;
+    symbol->type = type;
+    SymbolLogger::getInstance().logSymbol(*symbol);
+    return true;
 }
 
 bool SymbolTable::updateFunctionParameterType(const std::string& function_name, size_t param_index, VarType type) {
-    for (auto& symbol : all_symbols_) {
-        if (symbol.name == function_name && symbol.is_function_like()) {
+    const std::vector<size_t>* entries = indexFor(function_name);
+    if (!entries) {
+        return false;
+    }
+    for (size_t index : *entries) {
+        Symbol& symbol = all_symbols_[index];
+        if (symbol.is_function_like()) {
             if (param_index < symbol.parameters.size()) {
                 symbol.parameters[param_index].type = type;
                 SymbolLogger::getInstance().logSymbol(symbol);
@@ -180,29 +244,20 @@ void SymbolTable::setSymbolType(const std::string& name, VarType type) {
 }
 
 void SymbolTable::setSymbolStackLocation(const std::string& name, int offset) {
-    for (auto it = all_symbols_.rbegin(); it != all_symbols_.rend(); ++it) {
-        if (it->name == name) {
-            it->location = SymbolLocation::stack(offset);
-            break;
-        }
+    if (Symbol* symbol = latest(name)) {
+        symbol->location = SymbolLocation::stack(offset);
     }
 }
 
 void SymbolTable::setSymbolDataLocation(const std::string& name, size_t offset) {
-    for (auto it = all_symbols_.rbegin(); it != all_symbols_.rend(); ++it) {
-        if (it->name == name) {
-            it->location = SymbolLocation::data(offset);
-            break;
-        }
+    if (Symbol* symbol = latest(name)) {
+        symbol->location = SymbolLocation::data(offset);
     }
 }
 
 void SymbolTable::setSymbolAbsoluteValue(const std::string& name, int64_t value) {
-    for (auto it = all_symbols_.rbegin(); it != all_symbols_.rend(); ++it) {
-        if (it->name == name) {
-            it->location = SymbolLocation::absolute(value);
-            break;
-        }
+    if (Symbol* symbol = latest(name)) {
+        symbol->location = SymbolLocation::absolute(value);
     }
 }
 
@@ -221,5 +276,5 @@ std::string SymbolTable::toString() const {
 }
 
 std::vector<Symbol> SymbolTable::getAllSymbols() const {
-    return all_symbols_;
+    return std::vector<Symbol>(all_symbols_.begin(), all_symbols_.end());
 }
\ No newline at end of file
@@ -4,15 +4,18 @@
 #include "Symbol.h"
 #include <string>
 #include <vector>
+#include <deque>
 #include <unordered_map>
 #include <stack>
 #include <memory>
+#include <cstdint>
 
 // Global symbols trace flag (set early in main.cpp)
 extern bool g_enable_symbols_trace;
 
 // The SymbolTable class manages all symbols persistently.
-// It holds a single vector of all symbols ever declared.
+// It holds a single list of all symbols ever declared, indexed by interned
+// name and by (function, name) so lookups do not scan the whole list.
 class SymbolTable {
 public:
     SymbolTable();
@@ -43,6 +46,12 @@ public:
     // Lookup by name and function context
     bool lookup(const std::string& name, const std::string& function_name, Symbol& symbol) const;
 
+    // Handle-returning lookups with the same resolution rules as lookup(),
+    // without copying the Symbol. nullptr if not found. Symbols are never
+    // removed or moved, so the pointer stays valid for the table's lifetime.
+    const Symbol* find(const std::string& name) const;
+    const Symbol* find(const std::string& name, const std::string& function_name) const;
+
     // Context management
     void setCurrentFunction(const std::string& function_name);
     std::string getCurrentFunction() const { return current_function_name_; }
@@ -60,8 +69,26 @@ public:
     bool updateSymbol(const std::string& name, const Symbol& new_symbol_data);
 
 private:
-    // Persistent list of all symbols ever declared
-    std::vector<Symbol> all_symbols_;
+    // Persistent list of all symbols ever declared (deque: stable addresses for find())
+    std::deque<Symbol> all_symbols_;
+
+    // Interned symbol and function names; ids key the indexes below
+    std::unordered_map<std::string, uint32_t> interned_names_;
+
+    // Indexes into all_symbols_, ascending, so back() is the latest declaration
+    std::unordered_map<uint32_t, std::vector<size_t>> by_name_;
+    std::unordered_map<uint64_t, std::vector<size_t>> by_function_and_name_;
+
+    uint32_t intern(const std::string& name);
+    bool internedId(const std::string& name, uint32_t& id) const;
+    static uint64_t functionKey(uint32_t function_id, uint32_t name_id) {
+        return (static_cast<uint64_t>(function_id) << 32) | name_id;
+    }
+    const std::vector<size_t>* indexFor(const std::string& name) const;
+    const std::vector<size_t>* indexFor(const std::string& function_name, const std::string& name) const;
+    Symbol* latest(const std::string& name);
+    void indexSymbol(size_t index);
+    void unindexSymbol(size_t index);
 
     // Current scope level (0 = global)
     int current_scope_level_ = 0;
@@ -35,10 +35,23 @@ VeneerManager::VeneerEntry VeneerManager::create_veneer(const std::string& funct
 
     // 1. Generate the MOVZ/MOVK sequence to load the 64-bit absolute address
     //    of the runtime function into the veneer register (X16).
-    //    This uses your existing, reliable Encoder function.
-    std::vector<Instruction> mov_instructions = Encoder::create_movz_movk_abs64("X16", target_address, function_name);
-    
-    veneer.instructions.insert(veneer.instructions.end(), mov_instructions.begin(), mov_instructions.end());
+    //    All four chunks are always emitted, each carrying a relocation
+    //    against the function, so the Linker resolves the address at link
+    //    time. A program loaded from the compilation cache is linked against
+    //    a runtime at a different address, where a chunk that was zero at
+    //    compile time need not be zero.
+    static const RelocationType chunk_relocations[4] = {
+        RelocationType::MOVZ_MOVK_IMM_0, RelocationType::MOVZ_MOVK_IMM_16,
+        RelocationType::MOVZ_MOVK_IMM_32, RelocationType::MOVZ_MOVK_IMM_48
+    };
+    for (int i = 0; i < 4; ++i) {
+        uint16_t chunk = (target_address >> (i * 16)) & 0xFFFF;
+        Instruction mov = (i == 0) ? Encoder::create_movz_imm("X16", chunk, 0)
+                                   : Encoder::create_movk_imm("X16", chunk, i * 16);
+        mov.relocation = chunk_relocations[i];
+        mov.target_label = function_name;
+        veneer.instructions.push_back(mov);
+    }
 
     // 2. Generate the final indirect branch instruction.
     Instruction br_instr = Encoder::create_br_reg("X16");
@@ -100,6 +100,16 @@ public:
      * @return Map of function name to veneer label
      */
     const std::unordered_map<std::string, std::string>& get_veneer_labels() const { return veneer_labels_; }
+
+    /**
+     * @brief Restores the veneer labels of a program loaded from the compilation cache.
+     * The veneers themselves are already in the cached instruction stream.
+     * @param veneer_labels Map of function name to veneer label
+     */
+    void restore_veneer_labels(const std::unordered_map<std::string, std::string>& veneer_labels) {
+        veneer_labels_ = veneer_labels;
+        total_veneer_size_ = veneer_labels.size() * VENEER_SIZE;
+    }
     
     /**
      * @brief Prints debug information about all generated veneers.
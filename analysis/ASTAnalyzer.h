@@ -244,7 +244,9 @@ class ASTAnalyzer : public ASTVisitor {
     bool has_variables_or_complex_expr(ASTNode* expr) const;
 
     // --- Scope Management ---
-    std::string current_function_scope_;
+    // Per thread: code generation workers (--jobs N) each set the scope of
+    // the function they are compiling.
+    static thread_local std::string current_function_scope_;
     std::string current_lexical_scope_;
 
 public:
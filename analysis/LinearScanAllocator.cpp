@@ -11,6 +11,18 @@ std::map<std::string, LiveInterval> LinearScanAllocator::allocate(
     const std::vector<std::string>& int_regs,
     const std::vector<std::string>& float_regs,
     const std::string& current_function_name
+) {
+    std::vector<Reg> int_pool, float_pool;
+    for (const auto& name : int_regs) int_pool.push_back(Reg::parse(name));
+    for (const auto& name : float_regs) float_pool.push_back(Reg::parse(name));
+    return allocate(intervals, int_pool, float_pool, current_function_name);
+}
+
+std::map<std::string, LiveInterval> LinearScanAllocator::allocate(
+    const std::vector<LiveInterval>& intervals,
+    const std::vector<Reg>& int_regs,
+    const std::vector<Reg>& float_regs,
+    const std::string& current_function_name
 ) {
     if (debug_enabled_) {
         std::cout << "[Allocator] Starting partitioned linear scan for function: " << current_function_name << std::endl;
@@ -30,41 +42,31 @@ std::map<std::string, LiveInterval> LinearScanAllocator::allocate(
     }
 
     // Phase 2 & 3: Partition register pools and reserve scratch registers for code generation
-    std::vector<std::string> callee_saved_int, caller_saved_int, scratch_reserved_int;
-    std::vector<std::string> callee_saved_fp, caller_saved_fp;
+    std::vector<Reg> callee_saved_int, caller_saved_int, scratch_reserved_int;
+    std::vector<Reg> callee_saved_fp, caller_saved_fp;
     
     // Partition integer registers based on ARM64 ABI and reserve scratch registers
-    // Reserve 3 scratch registers for code generation (from the 7 available)
-    const std::vector<std::string> scratch_pool = {"X9", "X10", "X11", "X12", "X13", "X14", "X15"};
-    const int RESERVED_SCRATCH_COUNT = 3;
+    // Reserve 3 scratch registers for code generation (from the 7 available, X9-X15)
+    const size_t RESERVED_SCRATCH_COUNT = 3;
     
-    for (const auto& reg : int_regs) {
-        if ((reg >= "X19" && reg <= "X28") || reg == "X29") {
+    for (Reg reg : int_regs) {
+        bool is_x = reg.kind() == Reg::X;
+        if (is_x && reg.number() >= 19 && reg.number() <= 29) {
             callee_saved_int.push_back(reg);
+        } else if (is_x && reg.number() >= 9 && reg.number() <= 15 &&
+                   scratch_reserved_int.size() < RESERVED_SCRATCH_COUNT) {
+            // A scratch register we should reserve
+            scratch_reserved_int.push_back(reg);
         } else {
-            // Check if this is a scratch register we should reserve
-            auto scratch_it = std::find(scratch_pool.begin(), scratch_pool.end(), reg);
-            if (scratch_it != scratch_pool.end() && 
-                scratch_reserved_int.size() < RESERVED_SCRATCH_COUNT) {
-                scratch_reserved_int.push_back(reg);
-            } else {
-                caller_saved_int.push_back(reg);
-            }
+            caller_saved_int.push_back(reg);
         }
     }
     
     // Partition floating-point registers based on ARM64 ABI  
-    for (const auto& reg : float_regs) {
-        // Extract the register number for proper numeric comparison
-        if (reg.length() >= 2 && reg[0] == 'D') {
-            int reg_num = std::stoi(reg.substr(1));
-            if (reg_num >= 8 && reg_num <= 15) {
-                callee_saved_fp.push_back(reg);
-            } else {
-                caller_saved_fp.push_back(reg);
-            }
+    for (Reg reg : float_regs) {
+        if (reg.kind() == Reg::D && reg.number() >= 8 && reg.number() <= 15) {
+            callee_saved_fp.push_back(reg);
         } else {
-            // Fallback for unexpected register format
             caller_saved_fp.push_back(reg);
         }
     }
@@ -125,7 +127,7 @@ std::map<std::string, LiveInterval> LinearScanAllocator::allocate(
             interval.is_spilled = false;
             
             if (debug_enabled_) {
-                std::cout << "  Assigned callee-saved register " << interval.assigned_register 
+                std::cout << "  Assigned callee-saved register " << interval.assigned_register_name() 
                           << " to " << interval.var_name << std::endl;
             }
             
@@ -140,7 +142,7 @@ std::map<std::string, LiveInterval> LinearScanAllocator::allocate(
         if (debug_enabled_) {
             std::cout << "[ALLOC] Updated allocations for " << interval.var_name 
                       << ": spilled=" << interval.is_spilled 
-                      << ", register='" << interval.assigned_register << "'" << std::endl;
+                      << ", register='" << interval.assigned_register_name() << "'" << std::endl;
         }
     }
 
@@ -172,7 +174,7 @@ std::map<std::string, LiveInterval> LinearScanAllocator::allocate(
             interval.is_spilled = false;
             
             if (debug_enabled_) {
-                std::cout << "  Assigned register " << interval.assigned_register 
+                std::cout << "  Assigned register " << interval.assigned_register_name() 
                           << " to " << interval.var_name << std::endl;
             }
             
@@ -187,7 +189,7 @@ std::map<std::string, LiveInterval> LinearScanAllocator::allocate(
         if (debug_enabled_) {
             std::cout << "[ALLOC] Updated allocations for " << interval.var_name 
                       << ": spilled=" << interval.is_spilled 
-                      << ", register='" << interval.assigned_register << "'" << std::endl;
+                      << ", register='" << interval.assigned_register_name() << "'" << std::endl;
         }
     }
     
@@ -195,8 +197,8 @@ std::map<std::string, LiveInterval> LinearScanAllocator::allocate(
         std::cout << "[Allocator] Partitioned allocation complete for " << current_function_name << std::endl;
         std::cout << "[Allocator] Reserved " << scratch_reserved_int.size() 
                   << " scratch registers for code generation: ";
-        for (const auto& reg : scratch_reserved_int) {
-            std::cout << reg << " ";
+        for (Reg reg : scratch_reserved_int) {
+            std::cout << reg.name() << " ";
         }
         std::cout << std::endl;
         
@@ -209,10 +211,10 @@ std::map<std::string, LiveInterval> LinearScanAllocator::allocate(
         // Validate no register conflicts for overlapping intervals
         int conflict_count = 0;
         for (const auto& pair1 : allocations) {
-            if (pair1.second.is_spilled || pair1.second.assigned_register.empty()) continue;
+            if (pair1.second.is_spilled || !pair1.second.assigned_register) continue;
             
             for (const auto& pair2 : allocations) {
-                if (pair2.second.is_spilled || pair2.second.assigned_register.empty()) continue;
+                if (pair2.second.is_spilled || !pair2.second.assigned_register) continue;
                 if (pair1.first >= pair2.first) continue; // Avoid checking same pair twice
                 
                 // Check if same register assigned to variables with overlapping intervals
@@ -221,7 +223,7 @@ std::map<std::string, LiveInterval> LinearScanAllocator::allocate(
                     bool overlaps = !(pair1.second.end_point < pair2.second.start_point || 
                                     pair2.second.end_point < pair1.second.start_point);
                     if (overlaps) {
-                        std::cout << "  ERROR: Register " << pair1.second.assigned_register 
+                        std::cout << "  ERROR: Register " << pair1.second.assigned_register_name() 
                                   << " assigned to overlapping variables " << pair1.first 
                                   << " [" << pair1.second.start_point << "-" << pair1.second.end_point << "] and "
                                   << pair2.first << " [" << pair2.second.start_point << "-" << pair2.second.end_point << "]!" << std::endl;
@@ -247,10 +249,11 @@ std::map<std::string, LiveInterval> LinearScanAllocator::allocate(
             if (interval.is_spilled) {
                 std::cout << "SPILLED";
             } else {
-                std::cout << "reg " << interval.assigned_register;
+                std::cout << "reg " << interval.assigned_register_name();
                 // Indicate register type
-                bool is_callee_saved = ((interval.assigned_register >= "X19" && interval.assigned_register <= "X28") ||
-                                       (interval.assigned_register >= "D8" && interval.assigned_register <= "D15"));
+                Reg reg = interval.assigned_register.value_or(Reg());
+                bool is_callee_saved = (reg.kind() == Reg::X && reg.number() >= 19 && reg.number() <= 28) ||
+                                       (reg.kind() == Reg::D && reg.number() >= 8 && reg.number() <= 15);
                 std::cout << " (" << (is_callee_saved ? "callee-saved" : "caller-saved") << ")";
             }
             std::cout << " [" << (crosses_call ? "call-crossing" : "local-only") << "]" << std::endl;
@@ -270,13 +273,13 @@ void LinearScanAllocator::expire_old_intervals(int current_point, const std::str
             // This interval has expired, free its register
             if (debug_enabled_) {
                 std::cout << "  Expiring interval for " << it->var_name 
-                          << ", freeing register " << it->assigned_register << std::endl;
+                          << ", freeing register " << it->assigned_register_name() << std::endl;
             }
             
             // Return register to appropriate pool based on STORED type (prevents corruption)
             bool is_float = (it->var_type == VarType::FLOAT);
             auto& free_pool = is_float ? free_float_registers_ : free_int_registers_;
-            free_pool.push_back(it->assigned_register);
+            free_pool.push_back(*it->assigned_register);
             
             // Remove from active list
             it = active_intervals_.erase(it);
@@ -342,12 +345,12 @@ void LinearScanAllocator::spill_at_interval(LiveInterval& interval, const std::s
         
         // Mark the candidate as spilled and clear its register assignment
         best_spill_candidate->is_spilled = true;
-        best_spill_candidate->assigned_register = "";
+        best_spill_candidate->assigned_register.reset();
         
         // CRITICAL FIX: Update the allocations map to reflect the spilled state
         // We must update the allocations map entry to match the spilled interval's state
         allocations[best_spill_candidate->var_name].is_spilled = true;
-        allocations[best_spill_candidate->var_name].assigned_register = "";
+        allocations[best_spill_candidate->var_name].assigned_register.reset();
         
         // Remove the spilled interval from active list and add the new one
         active_intervals_.erase(best_spill_candidate);
@@ -375,14 +378,14 @@ void LinearScanAllocator::spill_at_interval(LiveInterval& interval, const std::s
             const LiveInterval& alloc_interval = pair.second;
             
             // Check if variable is marked as spilled but still has a register
-            if (alloc_interval.is_spilled && !alloc_interval.assigned_register.empty()) {
+            if (alloc_interval.is_spilled && alloc_interval.assigned_register) {
                 std::cerr << "[ALLOCATION BUG] Variable '" << var_name 
                           << "' is marked as spilled but still has register '" 
-                          << alloc_interval.assigned_register << "'" << std::endl;
+                          << alloc_interval.assigned_register_name() << "'" << std::endl;
             }
             
             // Check if variable has register but is marked as spilled  
-            if (!alloc_interval.is_spilled && alloc_interval.assigned_register.empty()) {
+            if (!alloc_interval.is_spilled && !alloc_interval.assigned_register) {
                 std::cerr << "[ALLOCATION BUG] Variable '" << var_name 
                           << "' is not spilled but has empty register assignment" << std::endl;
             }
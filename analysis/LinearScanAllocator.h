@@ -12,6 +12,14 @@ class LinearScanAllocator {
 public:
     LinearScanAllocator(ASTAnalyzer& analyzer, bool debug = false);
 
+    std::map<std::string, LiveInterval> allocate(
+        const std::vector<LiveInterval>& intervals,
+        const std::vector<Reg>& int_regs,
+        const std::vector<Reg>& float_regs,
+        const std::string& current_function_name
+    );
+
+    // Shim for register pools given by name ("X19", "D8")
     std::map<std::string, LiveInterval> allocate(
         const std::vector<LiveInterval>& intervals,
         const std::vector<std::string>& int_regs,
@@ -28,8 +36,8 @@ private:
     bool does_interval_cross_call(const LiveInterval& interval, const std::vector<int>& call_sites) const;
 
     std::list<LiveInterval> active_intervals_;
-    std::vector<std::string> free_int_registers_;
-    std::vector<std::string> free_float_registers_;
+    std::vector<Reg> free_int_registers_;
+    std::vector<Reg> free_float_registers_;
     ASTAnalyzer& analyzer_;
     bool debug_enabled_;
 };
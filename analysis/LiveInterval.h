@@ -1,7 +1,9 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include "../DataTypes.h"
+#include "../Reg.h"
 
 // Represents the lifetime of a variable from its first definition to its last use.
 struct LiveInterval {
@@ -12,8 +14,13 @@ struct LiveInterval {
 
     // --- Allocation Result ---
     bool is_spilled = false;
-    std::string assigned_register; // Will be empty if spilled
-    int stack_offset = -1;         // Spill location, relative to the frame pointer
+    std::optional<Reg> assigned_register; // Will be empty if spilled
+    int stack_offset = -1;                // Spill location, relative to the frame pointer
+
+    // The assigned register's name, or "" if spilled
+    std::string assigned_register_name() const {
+        return assigned_register ? assigned_register->name() : std::string();
+    }
 
     LiveInterval() = default;
     LiveInterval(const std::string& name, int start, int end)
@@ -2,6 +2,7 @@
 #include "../LivenessAnalysisPass.h"
 #include "../ControlFlowGraph.h"
 #include "Visitors/VariableUsageVisitor.h"
+#include "../include/ParallelFor.h"
 #include <iostream>
 #include <algorithm>
 #include <string>
@@ -9,11 +10,31 @@
 #include <set>
 
 void LiveIntervalPass::run(const ControlFlowGraph& cfg, const LivenessAnalysisPass& liveness, const std::string& functionName) {
+    buildIntervals(cfg, liveness, functionName, function_intervals_[functionName]);
+}
+
+void LiveIntervalPass::runAll(const std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>& cfgs,
+                              const LivenessAnalysisPass& liveness, unsigned jobs) {
+    // Create every function's slot up front; the workers then only write
+    // to their own vector.
+    std::vector<std::pair<const ControlFlowGraph*, const std::string*>> functions;
+    std::vector<std::vector<LiveInterval>*> slots;
+    for (const auto& pair : cfgs) {
+        if (!pair.second) continue;
+        functions.emplace_back(pair.second.get(), &pair.first);
+        slots.push_back(&function_intervals_[pair.first]);
+    }
+    parallel_for(functions.size(), trace_enabled_ ? 1 : jobs, [&](size_t i) {
+        buildIntervals(*functions[i].first, liveness, *functions[i].second, *slots[i]);
+    });
+}
+
+void LiveIntervalPass::buildIntervals(const ControlFlowGraph& cfg, const LivenessAnalysisPass& liveness,
+                                      const std::string& functionName, std::vector<LiveInterval>& final_intervals) const {
     if (trace_enabled_) {
         std::cout << "[LiveIntervalPass] Building intervals for function: " << functionName << std::endl;
     }
 
-    auto& final_intervals = function_intervals_[functionName];
     final_intervals.clear();
 
     std::map<std::string, LiveInterval> interval_map;
@@ -77,9 +98,8 @@ void LiveIntervalPass::run(const ControlFlowGraph& cfg, const LivenessAnalysisPa
                     // Get variable type to prevent register pool corruption
                     VarType var_type = VarType::INTEGER; // Default to INTEGER
                     if (symbol_table_) {
-                        Symbol symbol;
-                        if (symbol_table_->lookup(var_name, functionName, symbol)) {
-                            var_type = symbol.type;
+                        if (const Symbol* symbol = symbol_table_->find(var_name, functionName)) {
+                            var_type = symbol->type;
                         }
                     }
                     interval_map[var_name] = LiveInterval(var_name, start, end, var_type);
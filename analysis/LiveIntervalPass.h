@@ -4,6 +4,8 @@
 #include "LiveInterval.h"
 #include "../SymbolTable.h"
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -17,9 +19,17 @@ public:
 
     void run(const ControlFlowGraph& cfg, const LivenessAnalysisPass& liveness, const std::string& functionName);
 
+    // Builds intervals for every function in cfgs, on up to `jobs` threads
+    // (--jobs N). Tracing forces a single thread.
+    void runAll(const std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>& cfgs,
+                const LivenessAnalysisPass& liveness, unsigned jobs);
+
     const std::vector<LiveInterval>& getIntervalsFor(const std::string& functionName) const;
 
 private:
+    void buildIntervals(const ControlFlowGraph& cfg, const LivenessAnalysisPass& liveness,
+                        const std::string& functionName, std::vector<LiveInterval>& final_intervals) const;
+
     std::map<std::string, std::vector<LiveInterval>> function_intervals_;
     SymbolTable* symbol_table_;
     bool trace_enabled_;
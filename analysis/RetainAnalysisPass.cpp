@@ -3,6 +3,8 @@
 #include "SymbolTable.h"
 #include "Symbol.h"
 #include <algorithm>
+#include <map>
+#include <vector>
 
 // --- Stub constructor ---
 RetainAnalysisPass::RetainAnalysisPass() {}
@@ -37,6 +39,222 @@ public:
     // Add other statement visitors as needed...
 };
 
+// --- Helper Visitor to Find Scope-Local VEC / STRING Allocations ---
+// A LET variable initialised with VEC or STRING is scope-local when every use
+// is an element access (v!i, v%i, v.%i, !v, LEN v) or FREEVEC(v). Any other
+// use - passing it to a call, storing or copying it, RETAIN, RESULTIS, DEFER -
+// counts as an escape. Constructs the collector does not understand make it
+// give up on the whole function.
+class ScopeLocalAllocationCollector : public ASTVisitor {
+public:
+    std::map<std::string, std::vector<Expression*>> candidates;
+    std::set<std::string> escaped;
+    bool opaque = false;
+
+    // Marks allocations whose variable never escaped; returns how many.
+    int apply() {
+        if (opaque) return 0;
+        int marked = 0;
+        for (auto& entry : candidates) {
+            if (escaped.count(entry.first)) continue;
+            for (Expression* alloc : entry.second) {
+                if (auto* vec = dynamic_cast<VecAllocationExpression*>(alloc)) vec->scope_local = true;
+                else if (auto* str = dynamic_cast<StringAllocationExpression*>(alloc)) str->scope_local = true;
+                ++marked;
+            }
+        }
+        return marked;
+    }
+
+    // --- Uses ---
+    void visit(VariableAccess& node) override { escaped.insert(node.name); }
+
+    void visit(VectorAccess& node) override {
+        visit_element_base(node.vector_expr);
+        visit_expr(node.index_expr);
+    }
+    void visit(CharIndirection& node) override {
+        visit_element_base(node.string_expr);
+        visit_expr(node.index_expr);
+    }
+    void visit(FloatVectorIndirection& node) override {
+        visit_element_base(node.vector_expr);
+        visit_expr(node.index_expr);
+    }
+    void visit(UnaryOp& node) override {
+        if (node.op == UnaryOp::Operator::LengthOf || node.op == UnaryOp::Operator::Indirection) {
+            visit_element_base(node.operand);
+        } else {
+            visit_expr(node.operand);
+        }
+    }
+    void visit(FreeStatement& node) override { visit_element_base(node.list_expr); }
+    void visit(RoutineCallStatement& node) override {
+        auto* callee = dynamic_cast<VariableAccess*>(node.routine_expr.get());
+        if (callee && callee->name == "FREEVEC" && node.arguments.size() == 1) {
+            visit_element_base(node.arguments[0]);
+            return;
+        }
+        visit_expr(node.routine_expr);
+        for (auto& arg : node.arguments) visit_expr(arg);
+    }
+
+    // --- Declarations ---
+    void visit(LetDeclaration& node) override {
+        for (size_t i = 0; i < node.names.size(); ++i) {
+            Expression* init = i < node.initializers.size() ? node.initializers[i].get() : nullptr;
+            if (node.is_retained) escaped.insert(node.names[i]);
+            if (auto* vec = dynamic_cast<VecAllocationExpression*>(init)) {
+                candidates[node.names[i]].push_back(vec);
+                visit_expr(vec->size_expr);
+            } else if (auto* str = dynamic_cast<StringAllocationExpression*>(init)) {
+                candidates[node.names[i]].push_back(str);
+                visit_expr(str->size_expr);
+            } else if (init) {
+                init->accept(*this);
+            }
+        }
+    }
+    void visit(StaticDeclaration& node) override { visit_expr(node.initializer); }
+    void visit(LabelDeclaration& node) override { visit_stmt(node.command); }
+
+    // --- Escaping contexts: every name mentioned escapes ---
+    void visit(RetainStatement& node) override {
+        for (const auto& name : node.variable_names) escaped.insert(name);
+    }
+    void visit(RemanageStatement& node) override {
+        for (const auto& name : node.variable_names) escaped.insert(name);
+    }
+    void visit(ResultisStatement& node) override { visit_escaping(node.expression); }
+    void visit(DeferStatement& node) override {
+        // Runs after the block's scope has been exited
+        bool saved = escaping_;
+        escaping_ = true;
+        visit_stmt(node.deferred_statement);
+        escaping_ = saved;
+    }
+    void visit(MinStatement& node) override { visit_reduction(node.result_variable, node.left_operand, node.right_operand); }
+    void visit(MaxStatement& node) override { visit_reduction(node.result_variable, node.left_operand, node.right_operand); }
+    void visit(SumStatement& node) override { visit_reduction(node.result_variable, node.left_operand, node.right_operand); }
+    void visit(ReductionStatement& node) override { visit_reduction(node.result_variable, node.left_operand, node.right_operand); }
+    void visit(ReductionLoopStatement& node) override { opaque = true; }
+    void visit(PairwiseReductionLoopStatement& node) override { opaque = true; }
+
+    // --- Expressions ---
+    void visit(BinaryOp& node) override { visit_expr(node.left); visit_expr(node.right); }
+    void visit(BitfieldAccessExpression& node) override {
+        visit_expr(node.base_expr); visit_expr(node.start_bit_expr); visit_expr(node.width_expr);
+    }
+    void visit(FunctionCall& node) override {
+        visit_expr(node.function_expr);
+        for (auto& arg : node.arguments) visit_expr(arg);
+    }
+    void visit(SysCall& node) override {
+        visit_expr(node.syscall_number);
+        for (auto& arg : node.arguments) visit_expr(arg);
+    }
+    void visit(ConditionalExpression& node) override {
+        visit_expr(node.condition); visit_expr(node.true_expr); visit_expr(node.false_expr);
+    }
+    void visit(ValofExpression& node) override { visit_stmt(node.body); }
+    void visit(FloatValofExpression& node) override { visit_stmt(node.body); }
+    void visit(VecAllocationExpression& node) override { visit_expr(node.size_expr); }
+    void visit(FVecAllocationExpression& node) override { visit_expr(node.size_expr); }
+    void visit(PairsAllocationExpression& node) override { visit_expr(node.size_expr); }
+    void visit(FPairsAllocationExpression& node) override { visit_expr(node.size_expr); }
+    void visit(StringAllocationExpression& node) override { visit_expr(node.size_expr); }
+    void visit(VecInitializerExpression& node) override { for (auto& e : node.initializers) visit_expr(e); }
+    void visit(TableExpression& node) override { for (auto& e : node.initializers) visit_expr(e); }
+    void visit(ListExpression& node) override { for (auto& e : node.initializers) visit_expr(e); }
+    void visit(NewExpression& node) override { for (auto& e : node.constructor_arguments) visit_expr(e); }
+    void visit(MemberAccessExpression& node) override { visit_expr(node.object_expr); }
+    void visit(SuperMethodCallExpression& node) override { for (auto& e : node.arguments) visit_expr(e); }
+    void visit(PairExpression& node) override { visit_expr(node.first_expr); visit_expr(node.second_expr); }
+    void visit(FPairExpression& node) override { visit_expr(node.first_expr); visit_expr(node.second_expr); }
+    void visit(PairAccessExpression& node) override { visit_expr(node.pair_expr); }
+    void visit(FPairAccessExpression& node) override { visit_expr(node.pair_expr); }
+    void visit(QuadExpression& node) override {
+        visit_expr(node.first_expr); visit_expr(node.second_expr);
+        visit_expr(node.third_expr); visit_expr(node.fourth_expr);
+    }
+    void visit(FQuadExpression& node) override {
+        visit_expr(node.first_expr); visit_expr(node.second_expr);
+        visit_expr(node.third_expr); visit_expr(node.fourth_expr);
+    }
+    void visit(QuadAccessExpression& node) override { visit_expr(node.quad_expr); }
+    void visit(FQuadAccessExpression& node) override { visit_expr(node.quad_expr); }
+    void visit(OctExpression& node) override {
+        visit_expr(node.first_expr); visit_expr(node.second_expr); visit_expr(node.third_expr); visit_expr(node.fourth_expr);
+        visit_expr(node.fifth_expr); visit_expr(node.sixth_expr); visit_expr(node.seventh_expr); visit_expr(node.eighth_expr);
+    }
+    void visit(FOctExpression& node) override {
+        visit_expr(node.first_expr); visit_expr(node.second_expr); visit_expr(node.third_expr); visit_expr(node.fourth_expr);
+        visit_expr(node.fifth_expr); visit_expr(node.sixth_expr); visit_expr(node.seventh_expr); visit_expr(node.eighth_expr);
+    }
+    void visit(LaneAccessExpression& node) override { visit_expr(node.vector_expr); }
+
+    // --- Statements ---
+    void visit(AssignmentStatement& node) override {
+        for (auto& e : node.lhs) visit_expr(e);
+        for (auto& e : node.rhs) visit_expr(e);
+    }
+    void visit(IfStatement& node) override { visit_expr(node.condition); visit_stmt(node.then_branch); }
+    void visit(UnlessStatement& node) override { visit_expr(node.condition); visit_stmt(node.then_branch); }
+    void visit(TestStatement& node) override {
+        visit_expr(node.condition); visit_stmt(node.then_branch); visit_stmt(node.else_branch);
+    }
+    void visit(WhileStatement& node) override { visit_expr(node.condition); visit_stmt(node.body); }
+    void visit(UntilStatement& node) override { visit_expr(node.condition); visit_stmt(node.body); }
+    void visit(RepeatStatement& node) override { visit_stmt(node.body); visit_expr(node.condition); }
+    void visit(ForStatement& node) override {
+        visit_expr(node.start_expr); visit_expr(node.end_expr); visit_expr(node.step_expr);
+        visit_stmt(node.body);
+    }
+    void visit(ForEachStatement& node) override { visit_expr(node.collection_expression); visit_stmt(node.body); }
+    void visit(SwitchonStatement& node) override {
+        visit_expr(node.expression);
+        for (auto& c : node.cases) if (c) c->accept(*this);
+        if (node.default_case) node.default_case->accept(*this);
+    }
+    void visit(CaseStatement& node) override { visit_expr(node.constant_expr); visit_stmt(node.command); }
+    void visit(DefaultStatement& node) override { visit_stmt(node.command); }
+    void visit(GotoStatement& node) override { visit_expr(node.label_expr); }
+    void visit(FinishStatement& node) override {
+        visit_expr(node.syscall_number);
+        for (auto& arg : node.arguments) visit_expr(arg);
+    }
+    void visit(StringStatement& node) override { visit_expr(node.size_expr); }
+    void visit(ConditionalBranchStatement& node) override { visit_expr(node.condition_expr); }
+    void visit(CompoundStatement& node) override { for (auto& s : node.statements) visit_stmt(s); }
+    void visit(BlockStatement& node) override {
+        for (auto& d : node.declarations) if (d) d->accept(*this);
+        for (auto& s : node.statements) visit_stmt(s);
+    }
+
+private:
+    bool escaping_ = false;
+
+    void visit_expr(const ExprPtr& expr) { if (expr) expr->accept(*this); }
+    void visit_stmt(const StmtPtr& stmt) { if (stmt) stmt->accept(*this); }
+
+    // A bare variable used as the base of an element access is not an escape.
+    void visit_element_base(const ExprPtr& base) {
+        if (!escaping_ && base && base->getType() == ASTNode::NodeType::VariableAccessExpr) return;
+        visit_expr(base);
+    }
+    void visit_escaping(const ExprPtr& expr) {
+        bool saved = escaping_;
+        escaping_ = true;
+        visit_expr(expr);
+        escaping_ = saved;
+    }
+    void visit_reduction(const std::string& result, const ExprPtr& left, const ExprPtr& right) {
+        escaped.insert(result);
+        visit_escaping(left);
+        visit_escaping(right);
+    }
+};
+
 // Utility: Remove DeferStatements for retained variables from a statement vector
 static void remove_defer_for_retained(std::vector<StmtPtr>& stmts, const std::set<std::string>& retained_vars) {
     auto is_retained_defer = [&](const StmtPtr& stmt) {
@@ -67,8 +285,16 @@ static void remove_defer_for_retained(std::vector<StmtPtr>& stmts, const std::se
 }
 
 // --- RETAIN analysis logic ---
+void RetainAnalysisPass::visit(Program& node) {
+    for (auto& decl : node.declarations) {
+        if (decl) decl->accept(*this);
+    }
+}
+
 void RetainAnalysisPass::visit(FunctionDeclaration& node) {
-    if (!node.body || !symbol_table_) return;
+    if (!node.body) return;
+    mark_scope_local_allocations(*node.body);
+    if (!symbol_table_) return;
 
     RetainedVariableCollector collector;
     node.body->accept(collector);
@@ -86,7 +312,9 @@ void RetainAnalysisPass::visit(FunctionDeclaration& node) {
 }
 
 void RetainAnalysisPass::visit(RoutineDeclaration& node) {
-    if (!node.body || !symbol_table_) return;
+    if (!node.body) return;
+    mark_scope_local_allocations(*node.body);
+    if (!symbol_table_) return;
 
     RetainedVariableCollector collector;
     node.body->accept(collector);
@@ -102,6 +330,14 @@ void RetainAnalysisPass::visit(RoutineDeclaration& node) {
     }
 }
 
+// Flags VEC / STRING initialisers whose variable never leaves its block so
+// code generation can allocate them from the SAMM scope region.
+void RetainAnalysisPass::mark_scope_local_allocations(ASTNode& body) {
+    ScopeLocalAllocationCollector collector;
+    body.accept(collector);
+    scope_local_allocations_ += collector.apply();
+}
+
 // Other visitors remain stubs
 void RetainAnalysisPass::visit(RetainStatement& node) {}
 void RetainAnalysisPass::visit(RemanageStatement& node) {}
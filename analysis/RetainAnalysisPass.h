@@ -11,6 +11,8 @@
  * RetainAnalysisPass:
  * - Scans function/routine bodies for RETAIN statements and escaping variables (via RESULTIS/RETURN).
  * - Suppresses automatic DEFER for retained/escaping variables.
+ * - Marks VEC / STRING allocations that never escape their block as
+ *   scope-local, so they are served from the SAMM scope region.
  */
 class RetainAnalysisPass : public ASTVisitor {
 public:
@@ -19,7 +21,11 @@ public:
     // Run the pass on the whole program
     void run(Program& program, SymbolTable& symbol_table);
 
+    // Number of allocations marked scope-local by the last run
+    int getScopeLocalAllocationCount() const { return scope_local_allocations_; }
+
     // Visitor overrides
+    void visit(Program& node) override;
     void visit(FunctionDeclaration& node) override;
     void visit(RoutineDeclaration& node) override;
     void visit(RetainStatement& node) override;
@@ -33,6 +39,8 @@ private:
     // Reference to the symbol table for ownership flag updates
     SymbolTable* symbol_table_ = nullptr;
 
+    int scope_local_allocations_ = 0;
+
     // Set of variable names retained/escaping in the current function
     std::set<std::string> retained_vars;
 
@@ -49,4 +57,5 @@ private:
     void analyze_function_or_routine(Statement& node);
     void analyze_compound(CompoundStatement& compound);
     void collect_retained_vars(ASTNode& node);
+    void mark_scope_local_allocations(ASTNode& body);
 };
\ No newline at end of file
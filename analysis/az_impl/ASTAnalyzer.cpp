@@ -686,6 +686,8 @@ void ASTAnalyzer::visit(ForEachStatement& node) {
 
 
 
+thread_local std::string ASTAnalyzer::current_function_scope_;
+
 ASTAnalyzer& ASTAnalyzer::getInstance() {
     static ASTAnalyzer instance;
     return instance;
@@ -54,8 +54,9 @@ void ASTAnalyzer::visit(VariableAccess& node) {
     }
 
     // Use the SymbolTable to check if this is a global variable.
-    Symbol symbol;
-    if (symbol_table_ && symbol_table_->lookup(node.name, symbol)) {
+    const Symbol* found = symbol_table_ ? symbol_table_->find(node.name) : nullptr;
+    if (found) {
+        const Symbol& symbol = *found;
         // If the symbol is a GLOBAL_VAR, it's a global access.
         if (symbol.kind == SymbolKind::GLOBAL_VAR) {
             if (current_function_scope_ != "Global") {
@@ -33,25 +33,25 @@ std::vector<Instruction> CallFrameManager::generate_epilogue() {
         int lower_canary_offset = 16 + CANARY_SIZE; // Assumes CANARY_SIZE is defined.
 
         // Canary Check: Upper Canary. Branch to handler on failure.
-        epilogue_code.push_back(Encoder::create_ldr_imm("X10", "X29", upper_canary_offset, ""));
+        epilogue_code.push_back(Encoder::create_ldr_imm(Reg::x(10), Reg::x(29), upper_canary_offset, ""));
         epilogue_code.back().assembly_text += " ; Load Upper Stack Canary for check";
         for (const auto& instr : Encoder::create_movz_movk_abs64("X11", UPPER_CANARY_VALUE, "")) {
             epilogue_code.push_back(instr);
         }
         epilogue_code.back().assembly_text += " ; Load Expected UPPER_CANARY_VALUE";
-        epilogue_code.push_back(Encoder::create_cmp_reg("X10", "X11"));
+        epilogue_code.push_back(Encoder::create_cmp_reg(Reg::x(10), Reg::x(11)));
         epilogue_code.back().assembly_text += " ; Compare Upper Canary";
         epilogue_code.push_back(Encoder::create_branch_conditional("NE", function_name + "_stackprot_upper"));
         epilogue_code.back().assembly_text += " ; Branch if Upper Canary Corrupted";
 
         // Canary Check: Lower Canary. Branch to handler on failure.
-        epilogue_code.push_back(Encoder::create_ldr_imm("X10", "X29", lower_canary_offset, ""));
+        epilogue_code.push_back(Encoder::create_ldr_imm(Reg::x(10), Reg::x(29), lower_canary_offset, ""));
         epilogue_code.back().assembly_text += " ; Load Lower Stack Canary for check";
         for (const auto& instr : Encoder::create_movz_movk_abs64("X11", LOWER_CANARY_VALUE, "")) {
             epilogue_code.push_back(instr);
         }
         epilogue_code.back().assembly_text += " ; Load Expected LOWER_CANARY_VALUE";
-        epilogue_code.push_back(Encoder::create_cmp_reg("X10", "X11"));
+        epilogue_code.push_back(Encoder::create_cmp_reg(Reg::x(10), Reg::x(11)));
         epilogue_code.back().assembly_text += " ; Compare Lower Canary";
         epilogue_code.push_back(Encoder::create_branch_conditional("NE", function_name + "_stackprot_lower"));
         epilogue_code.back().assembly_text += " ; Branch if Lower Canary Corrupted";
@@ -64,12 +64,12 @@ std::vector<Instruction> CallFrameManager::generate_epilogue() {
     // Keep JIT-compatible approach for macOS
     epilogue_code.push_back(Encoder::create_mov_sp_fp());
     epilogue_code.back().assembly_text += " ; Deallocate frame by moving FP to SP";
-    epilogue_code.push_back(Encoder::create_ldr_imm("X29", "SP", 0, ""));
+    epilogue_code.push_back(Encoder::create_ldr_imm(Reg::x(29), Reg::sp(), 0, ""));
     epilogue_code.back().assembly_text += " ; Restore caller's Frame Pointer";
-    epilogue_code.push_back(Encoder::create_ldr_imm("X30", "SP", 8, ""));
+    epilogue_code.push_back(Encoder::create_ldr_imm(Reg::x(30), Reg::sp(), 8, ""));
     epilogue_code.back().assembly_text += " ; Restore Link Register";
     // FIX: Only add 16 to pop the two 64-bit registers (FP and LR).
-    epilogue_code.push_back(Encoder::create_add_imm("SP", "SP", 16));
+    epilogue_code.push_back(Encoder::create_add_imm(Reg::sp(), Reg::sp(), 16));
     epilogue_code.back().assembly_text += " ; Deallocate space for saved FP/LR";
     
     // 6. The single, standard return instruction.
@@ -78,7 +78,7 @@ std::vector<Instruction> CallFrameManager::generate_prologue() {
     } else {
         // LARGE FRAME: Use the two-instruction sequence
         // 1. SUB SP, SP, #<frame_size>
-        prologue_code.push_back(Encoder::create_sub_imm("SP", "SP", this->final_frame_size));
+        prologue_code.push_back(Encoder::create_sub_imm(Reg::sp(), Reg::sp(), this->final_frame_size));
         // 2. STP X29, X30, [SP, #0]
         prologue_code.push_back(Encoder::create_stp_imm("X29", "X30", "SP", 0));
     }
@@ -92,14 +92,14 @@ std::vector<Instruction> CallFrameManager::generate_prologue() {
             prologue_code.push_back(instr);
         }
         prologue_code.back().assembly_text += " ; Load UPPER_CANARY_VALUE";
-        prologue_code.push_back(Encoder::create_str_imm("X9", "X29", upper_canary_offset));
+        prologue_code.push_back(Encoder::create_str_imm(Reg::x(9), Reg::x(29), upper_canary_offset));
         prologue_code.back().assembly_text += " ; Store Upper Stack Canary";
 
         for (const auto& instr : Encoder::create_movz_movk_abs64("X9", LOWER_CANARY_VALUE, "")) {
             prologue_code.push_back(instr);
         }
         prologue_code.back().assembly_text += " ; Load LOWER_CANARY_VALUE";
-        prologue_code.push_back(Encoder::create_str_imm("X9", "X29", lower_canary_offset));
+        prologue_code.push_back(Encoder::create_str_imm(Reg::x(9), Reg::x(29), lower_canary_offset));
         prologue_code.back().assembly_text += " ; Store Lower Stack Canary";
     }
 
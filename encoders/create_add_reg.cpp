@@ -1,12 +1,8 @@
 // Status: PASS - Tested by NewBCPL --test-encoders
 
 #include "Encoder.h"
-#include "BitPatcher.h"
 #include <stdexcept>
 #include <string>
-#include <cctype>
-#include <algorithm>
-#include <vector>
 
 /**
  * @brief Encodes the ARM64 'ADD (register)' instruction.
@@ -30,83 +26,33 @@
  * @throw std::invalid_argument if register names are invalid or if register sizes are mixed.
  */
 Instruction Encoder::create_add_reg(const std::string& xd, const std::string& xn, const std::string& xm) {
-    // Helper lambda to parse register strings like "x0", "w1", "sp", "wzr".
-    // Returns the register number (0-31) and a boolean indicating if it's a 64-bit register.
-    auto parse_register = [](const std::string& reg_str) -> std::pair<uint32_t, bool> {
-        if (reg_str.empty()) {
-            throw std::invalid_argument("Register string cannot be empty.");
-        }
-
-        std::string lower_reg = reg_str;
-        std::transform(lower_reg.begin(), lower_reg.end(), lower_reg.begin(), ::tolower);
-
-        bool is_64bit;
-        uint32_t reg_num;
-
-        if (lower_reg == "wzr") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "xzr") {
-            is_64bit = true;
-            reg_num = 31;
-        } else if (lower_reg == "wsp") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "sp") {
-            is_64bit = true;
-            reg_num = 31;
-        } else {
-            char prefix = lower_reg[0];
-            if (prefix == 'w') {
-                is_64bit = false;
-            } else if (prefix == 'x') {
-                is_64bit = true;
-            } else {
-                throw std::invalid_argument("Invalid register prefix in '" + reg_str + "'. Must be 'w' or 'x'. (Thrown by create_add_reg)");
-            }
+    return create_add_reg(Reg::parse(xd), Reg::parse(xn), Reg::parse(xm));
+}
 
-            try {
-                reg_num = std::stoul(reg_str.substr(1));
-                if (reg_num > 30) {
-                     throw std::out_of_range("Register number out of range for '" + reg_str + "'. Use 'wsp'/'sp' or 'wzr'/'xzr' for register 31.");
-                }
-            } catch (const std::logic_error&) {
-                throw std::invalid_argument("Invalid register format: '" + reg_str + "'.");
-            }
+Instruction Encoder::create_add_reg(Reg xd, Reg xn, Reg xm) {
+    // (A) Self-checking: all operands are general-purpose registers of one size.
+    for (Reg r : { xd, xn, xm }) {
+        require_gpr(r, "create_add_reg");
+        if (r.number() == 31 && !r.is_sp() && !r.is_zr()) {
+            throw std::invalid_argument("Register number out of range for '" + r.name() + "'. Use 'wsp'/'sp' or 'wzr'/'xzr' for register 31.");
         }
-        return {reg_num, is_64bit};
-    };
-
-    // (A) Perform self-checking by parsing and validating all register arguments first.
-    auto [rd_num, rd_is_64] = parse_register(xd);
-    auto [rn_num, rn_is_64] = parse_register(xn);
-    auto [rm_num, rm_is_64] = parse_register(xm);
-
-    if (!(rd_is_64 == rn_is_64 && rn_is_64 == rm_is_64)) {
-        throw std::invalid_argument("Mismatched register sizes. All operands for ADD (register) must be simultaneously 32-bit (W) or 64-bit (X).");
     }
-
-    // (B) Use the BitPatcher to construct the instruction word.
-    // Base opcode for 32-bit ADD (register) is 0x0B000000.
-    BitPatcher patcher(0x0B000000);
-
-    if (rd_is_64) {
-        patcher.patch(1, 31, 1); // sf bit
+    if (!(xd.is_64bit() == xn.is_64bit() && xn.is_64bit() == xm.is_64bit())) {
+        throw std::invalid_argument("Mismatched register sizes. All operands for ADD (register) must be simultaneously 32-bit (W) or 64-bit (X).");
     }
 
-    patcher.patch(rd_num, 0, 5);  // Rd
-    patcher.patch(rn_num, 5, 5);  // Rn
-    patcher.patch(rm_num, 16, 5); // Rm
-
-    // (C) Format the assembly string for the Instruction object.
-    std::string assembly_text = "ADD " + xd + ", " + xn + ", " + xm;
+    // (B) Build the instruction word. Base opcode for 32-bit ADD (register) is 0x0B000000.
+    uint32_t encoding = 0x0B000000
+                      | (xd.is_64bit() ? (1u << 31) : 0) // sf bit
+                      | (xm.number() << 16)                // Rm
+                      | (xn.number() << 5)                 // Rn
+                      | xd.number();                       // Rd
 
-    // (D) Return the completed Instruction object, using the constructor from Encoder.h [cite: 2].
-    // For this simple instruction, no relocation is needed.
-    Instruction instr(patcher.get_value(), assembly_text);
+    // (C) Format the assembly string and return the Instruction.
+    Instruction instr(encoding, "ADD " + xd.name() + ", " + xn.name() + ", " + xm.name());
     instr.opcode = InstructionDecoder::OpType::ADD;
-    instr.dest_reg = Encoder::get_reg_encoding(xd);
-    instr.src_reg1 = Encoder::get_reg_encoding(xn);
-    instr.src_reg2 = Encoder::get_reg_encoding(xm);
+    instr.dest_reg = xd.number();
+    instr.src_reg1 = xn.number();
+    instr.src_reg2 = xm.number();
     return instr;
 }
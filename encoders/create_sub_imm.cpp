@@ -1,8 +1,5 @@
 // Status: PASS - Tested by NewBCPL --test-encoders
-#include "BitPatcher.h"
 #include "Encoder.h"
-#include <algorithm>
-#include <cctype>
 #include <stdexcept>
 #include <string>
 
@@ -31,88 +28,30 @@
  * @throw std::invalid_argument for invalid registers, mismatched sizes, or out-of-range immediates.
  */
 Instruction Encoder::create_sub_imm(const std::string& xd, const std::string& xn, int imm) {
-    // (A) Self-checking: Validate the immediate value.
+    return create_sub_imm(Reg::parse(xd), Reg::parse(xn), imm);
+}
+
+Instruction Encoder::create_sub_imm(Reg xd, Reg xn, int imm) {
     if (imm < 0 || imm > 4095) {
         throw std::invalid_argument("Immediate for SUB must be an unsigned 12-bit value [0, 4095].");
     }
-
-    // Helper lambda to parse register strings.
-    auto parse_register = [](const std::string& reg_str) -> std::pair<uint32_t, bool> {
-        if (reg_str.empty()) {
-            throw std::invalid_argument("Register string cannot be empty.");
-        }
-
-        std::string lower_reg = reg_str;
-        std::transform(lower_reg.begin(), lower_reg.end(), lower_reg.begin(), ::tolower);
-
-        bool is_64bit;
-        uint32_t reg_num;
-
-        if (lower_reg == "wzr") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "xzr") {
-            is_64bit = true;
-            reg_num = 31;
-        } else if (lower_reg == "wsp") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "sp") {
-            is_64bit = true;
-            reg_num = 31;
-        } else {
-            char prefix = lower_reg[0];
-            if (prefix == 'w') {
-                is_64bit = false;
-            } else if (prefix == 'x') {
-                is_64bit = true;
-            } else {
-                throw std::invalid_argument("Invalid register prefix in '" + reg_str + "'. Must be 'w' or 'x'. (Thrown by create_sub_imm)");
-            }
-
-            try {
-                reg_num = std::stoul(reg_str.substr(1));
-                if (reg_num > 31) {
-                     throw std::out_of_range("Register number out of range for '" + reg_str + "'.");
-                }
-            } catch (const std::logic_error&) {
-                throw std::invalid_argument("Invalid register format: '" + reg_str + "'.");
-            }
-        }
-        return {reg_num, is_64bit};
-    };
-
-    // (B) Parse and validate registers.
-    auto [rd_num, rd_is_64] = parse_register(xd);
-    auto [rn_num, rn_is_64] = parse_register(xn);
-
-    if (rd_is_64 != rn_is_64) {
+    require_gpr(xd, "create_sub_imm");
+    require_gpr(xn, "create_sub_imm");
+    if (xd.is_64bit() != xn.is_64bit()) {
         throw std::invalid_argument("Mismatched register sizes. Operands for SUB (immediate) must be the same size.");
     }
 
-    // (C) Use BitPatcher to construct the instruction word.
-    // Base opcode for 32-bit SUB (imm) is 0x51000000.
-    BitPatcher patcher(0x51000000);
-
-    if (rd_is_64) {
-        patcher.patch(1, 31, 1); // Set the sf bit for 64-bit operation.
-    }
-
-    // Patch the immediate value (imm12) into bits 10-21.
-    patcher.patch(static_cast<uint32_t>(imm), 10, 12);
-
-    // Patch the source and destination registers.
-    patcher.patch(rn_num, 5, 5);
-    patcher.patch(rd_num, 0, 5);
-
-    // (D) Format the assembly string.
-    std::string assembly_text = "SUB " + xd + ", " + xn + ", #" + std::to_string(imm);
+    // Base opcode for 32-bit SUB (immediate) is 0x51000000.
+    uint32_t encoding = 0x51000000
+                      | (xd.is_64bit() ? (1u << 31) : 0)   // sf bit
+                      | (static_cast<uint32_t>(imm) << 10) // imm12
+                      | (xn.number() << 5)                   // Rn
+                      | xd.number();                         // Rd
 
-    // (E) Return the completed Instruction object.
-    Instruction instr(patcher.get_value(), assembly_text);
+    Instruction instr(encoding, "SUB " + xd.name() + ", " + xn.name() + ", #" + std::to_string(imm));
     instr.opcode = InstructionDecoder::OpType::SUB;
-    instr.dest_reg = Encoder::get_reg_encoding(xd);
-    instr.src_reg1 = Encoder::get_reg_encoding(xn);
+    instr.dest_reg = xd.number();
+    instr.src_reg1 = xn.number();
     instr.immediate = imm;
     instr.uses_immediate = true;
     return instr;
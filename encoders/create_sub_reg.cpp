@@ -1,8 +1,5 @@
 // Status: PASS - Tested by NewBCPL --test-encoders
-#include "BitPatcher.h"
 #include "Encoder.h"
-#include <algorithm>
-#include <cctype>
 #include <stdexcept>
 #include <string>
 
@@ -31,82 +28,28 @@
  * @throw std::invalid_argument for invalid registers or mismatched sizes.
  */
 Instruction Encoder::create_sub_reg(const std::string& xd, const std::string& xn, const std::string& xm) {
-    // Helper lambda to parse register strings.
-    auto parse_register = [](const std::string& reg_str) -> std::pair<uint32_t, bool> {
-        if (reg_str.empty()) {
-            throw std::invalid_argument("Register string cannot be empty.");
-        }
-
-        std::string lower_reg = reg_str;
-        std::transform(lower_reg.begin(), lower_reg.end(), lower_reg.begin(), ::tolower);
-
-        bool is_64bit;
-        uint32_t reg_num;
-
-        if (lower_reg == "wzr") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "xzr") {
-            is_64bit = true;
-            reg_num = 31;
-        } else if (lower_reg == "wsp") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "sp") {
-            is_64bit = true;
-            reg_num = 31;
-        } else {
-            char prefix = lower_reg[0];
-            if (prefix == 'w') {
-                is_64bit = false;
-            } else if (prefix == 'x') {
-                is_64bit = true;
-            } else {
-                throw std::invalid_argument("Invalid register prefix in '" + reg_str + "'. Must be 'w' or 'x'. (Thrown by create_sub_reg)");
-            }
-
-            try {
-                reg_num = std::stoul(reg_str.substr(1));
-                if (reg_num > 31) {
-                     throw std::out_of_range("Register number out of range for '" + reg_str + "'.");
-                }
-            } catch (const std::logic_error&) {
-                throw std::invalid_argument("Invalid register format: '" + reg_str + "'.");
-            }
-        }
-        return {reg_num, is_64bit};
-    };
-
-    // (A) Self-checking: parse and validate registers.
-    auto [rd_num, rd_is_64] = parse_register(xd);
-    auto [rn_num, rn_is_64] = parse_register(xn);
-    auto [rm_num, rm_is_64] = parse_register(xm);
+    return create_sub_reg(Reg::parse(xd), Reg::parse(xn), Reg::parse(xm));
+}
 
-    if (!(rd_is_64 == rn_is_64 && rn_is_64 == rm_is_64)) {
+Instruction Encoder::create_sub_reg(Reg xd, Reg xn, Reg xm) {
+    require_gpr(xd, "create_sub_reg");
+    require_gpr(xn, "create_sub_reg");
+    require_gpr(xm, "create_sub_reg");
+    if (!(xd.is_64bit() == xn.is_64bit() && xn.is_64bit() == xm.is_64bit())) {
         throw std::invalid_argument("Mismatched register sizes. All operands for SUB must be the same size.");
     }
 
-    // (B) Use BitPatcher to construct the instruction word.
     // Base opcode for 32-bit SUB (register) is 0x4B000000.
-    BitPatcher patcher(0x4B000000);
-
-    if (rd_is_64) {
-        patcher.patch(1, 31, 1); // Set the sf bit for 64-bit operation.
-    }
-
-    // Patch the registers into their respective fields.
-    patcher.patch(rd_num, 0, 5);
-    patcher.patch(rn_num, 5, 5);
-    patcher.patch(rm_num, 16, 5);
-
-    // (C) Format the assembly string.
-    std::string assembly_text = "SUB " + xd + ", " + xn + ", " + xm;
+    uint32_t encoding = 0x4B000000
+                      | (xd.is_64bit() ? (1u << 31) : 0) // sf bit
+                      | (xm.number() << 16)                // Rm
+                      | (xn.number() << 5)                 // Rn
+                      | xd.number();                       // Rd
 
-    // (D) Return the completed Instruction object. No relocation is needed.
-    Instruction instr(patcher.get_value(), assembly_text);
+    Instruction instr(encoding, "SUB " + xd.name() + ", " + xn.name() + ", " + xm.name());
     instr.opcode = InstructionDecoder::OpType::SUB;
-    instr.dest_reg = Encoder::get_reg_encoding(xd);
-    instr.src_reg1 = Encoder::get_reg_encoding(xn);
-    instr.src_reg2 = Encoder::get_reg_encoding(xm);
+    instr.dest_reg = xd.number();
+    instr.src_reg1 = xn.number();
+    instr.src_reg2 = xm.number();
     return instr;
 }
@@ -42,16 +42,6 @@ Instruction Encoder::create_add_vector_reg(const std::string& vd, const std::str
     // Add register fields: Rm[20:16], Rn[9:5], Rd[4:0]
     encoding |= (rm << 16) | (rn << 5) | rd;
 
-    // Debug output to compare with clang
-    printf("NEON ADD encoding debug:\n");
-    printf("  vd=%s rd=%d, vn=%s rn=%d, vm=%s rm=%d, arrangement=%s\n", 
-           vd.c_str(), rd, vn.c_str(), rn, vm.c_str(), rm, arrangement.c_str());
-    printf("  Our encoding: 0x%08x\n", encoding);
-    if (arrangement == "4S" && rd == 2 && rn == 0 && rm == 1) {
-        printf("  Clang reference: 0x4ea18402 for ADD V2.4S, V0.4S, V1.4S\n");
-    }
-    fflush(stdout);
-
     std::stringstream ss;
     ss << "ADD " << vd << "." << arrangement << ", " << vn << "." << arrangement << ", " << vm << "." << arrangement;
     Instruction instr(encoding, ss.str());
@@ -11,8 +11,8 @@ Instruction Encoder::create_addp_vector_reg(const std::string& vd, const std::st
     // ADDP Vd.<T>, Vn.<T>, Vm.<T>
     // Integer addition of pairs of elements
     
-    if (arrangement != "8B" && arrangement != "16B" && arrangement != "4H" && arrangement != "8H" && arrangement != "2S" && arrangement != "4S") {
-        throw std::runtime_error("Invalid arrangement for ADDP vector: " + arrangement + " (expected 8B, 16B, 4H, 8H, 2S, or 4S)");
+    if (arrangement != "8B" && arrangement != "16B" && arrangement != "4H" && arrangement != "8H" && arrangement != "2S" && arrangement != "4S" && arrangement != "2D") {
+        throw std::runtime_error("Invalid arrangement for ADDP vector: " + arrangement + " (expected 8B, 16B, 4H, 8H, 2S, 4S, or 2D)");
     }
     
     uint32_t encoding;
@@ -41,6 +41,10 @@ Instruction Encoder::create_addp_vector_reg(const std::string& vd, const std::st
         // ADDP Vd.4S, Vn.4S, Vm.4S (128-bit vector, 32-bit elements)
         // 01001110101mmmmm101111nnnnnddddd
         encoding = 0x4EA0BC00 | (rm << 16) | (rn << 5) | rd;
+    } else if (arrangement == "2D") {
+        // ADDP Vd.2D, Vn.2D, Vm.2D (128-bit vector, 64-bit elements)
+        // 01001110111mmmmm101111nnnnnddddd
+        encoding = 0x4EE0BC00 | (rm << 16) | (rn << 5) | rd;
     }
 
     std::stringstream ss;
@@ -15,7 +15,6 @@ Instruction Encoder::create_fmul_vector_reg(const std::string& vd, const std::st
         encoding &= ~(1U << 30); // Clear Q bit for 64-bit operation (2S)
     } else if (arrangement == "2D") {
         encoding |= (0b01 << 22); // Set sz=01 for double-precision
-        encoding &= ~(1U << 29); // Clear bit 29 for 2D
     }
 
     std::stringstream ss;
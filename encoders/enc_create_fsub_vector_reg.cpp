@@ -37,7 +37,7 @@ Instruction Encoder::enc_create_fsub_vector_reg(const std::string& vd, const std
             instruction &= ~(1U << 30); // Clear Q bit for 64-bit operation (2S)
         }
     } else if (arrangement == "2D") {
-        instruction |= (0b01 << 22); // Set sz=01 for double-precision
+        instruction |= (0b11 << 22); // Set bit 23 and sz for double-precision
     }
     
     // Set register fields
@@ -1,8 +1,5 @@
 // Status: PASS - Tested by NewBCPL --test-encoders
-#include "BitPatcher.h"
 #include "Encoder.h"
-#include <algorithm>
-#include <cctype>
 #include <stdexcept>
 #include <string>
 
@@ -30,35 +27,13 @@
  */
 
 Instruction Encoder::create_ldr_imm(const std::string& xt, const std::string& xn, int immediate, const std::string& variable_name) {
-    auto parse_register = [](const std::string& reg_str) -> std::pair<uint32_t, bool> {
-        if (reg_str.empty()) throw std::invalid_argument("Register string cannot be empty.");
-        std::string lower_reg = reg_str;
-        std::transform(lower_reg.begin(), lower_reg.end(), lower_reg.begin(), ::tolower);
-        bool is_64bit;
-        uint32_t reg_num;
-        if (lower_reg == "wzr") { is_64bit = false; reg_num = 31; }
-        else if (lower_reg == "xzr") { is_64bit = true; reg_num = 31; }
-        else if (lower_reg == "wsp") { is_64bit = false; reg_num = 31; }
-        else if (lower_reg == "sp") { is_64bit = true; reg_num = 31; }
-        else {
-            char prefix = lower_reg[0];
-            if (prefix == 'w') is_64bit = false;
-            else if (prefix == 'x') is_64bit = true;
-            else throw std::invalid_argument("Invalid register prefix in '" + reg_str + "'. Must be 'w' or 'x'. (Thrown by create_ldr_imm)");
-            try {
-                reg_num = std::stoul(reg_str.substr(1));
-                if (reg_num > 31) throw std::out_of_range("Register number out of range.");
-            } catch(...) {
-                throw std::invalid_argument("Invalid register format: '" + reg_str + "'.");
-            }
-        }
-        return {reg_num, is_64bit};
-    };
-
-    auto [rt_num, rt_is_64] = parse_register(xt);
-    auto [rn_num, rn_is_64] = parse_register(xn);
+    return create_ldr_imm(Reg::parse(xt), Reg::parse(xn), immediate, variable_name);
+}
 
-    if (!rn_is_64) {
+Instruction Encoder::create_ldr_imm(Reg xt, Reg xn, int immediate, const std::string& variable_name) {
+    require_gpr(xt, "create_ldr_imm");
+    require_gpr(xn, "create_ldr_imm");
+    if (!xn.is_64bit()) {
         throw std::invalid_argument("LDR base register must be a 64-bit 'X' register or SP.");
     }
 
@@ -66,7 +41,7 @@ Instruction Encoder::create_ldr_imm(const std::string& xt, const std::string& xn
     int scale;
     int max_offset;
 
-    if (rt_is_64) {
+    if (xt.is_64bit()) {
         base_opcode = 0xF9400000;
         scale = 8;
         max_offset = 32760;
@@ -80,18 +55,18 @@ Instruction Encoder::create_ldr_imm(const std::string& xt, const std::string& xn
         throw std::invalid_argument("Immediate value out of range or not aligned.");
     }
 
-    std::string assembly_text = "LDR " + xt + ", [" + xn + ", #" + std::to_string(immediate) + "]";
+    std::string assembly_text = "LDR " + xt.name() + ", [" + xn.name() + ", #" + std::to_string(immediate) + "]";
 
     // Append the variable name to the comment if provided
     if (!variable_name.empty() && assembly_text.find(variable_name) == std::string::npos) {
         assembly_text += " ; " + variable_name;
     }
 
-    uint32_t instruction = base_opcode | ((immediate / scale) << 10) | (rn_num << 5) | rt_num;
+    uint32_t instruction = base_opcode | ((immediate / scale) << 10) | (xn.number() << 5) | xt.number();
     Instruction instr(instruction, assembly_text);
     instr.opcode = InstructionDecoder::OpType::LDR;
-    instr.dest_reg = Encoder::get_reg_encoding(xt);
-    instr.base_reg = Encoder::get_reg_encoding(xn);
+    instr.dest_reg = xt.number();
+    instr.base_reg = xn.number();
     instr.immediate = immediate;
     instr.uses_immediate = true;
     instr.is_mem_op = true;
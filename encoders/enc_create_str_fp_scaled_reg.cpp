@@ -0,0 +1,67 @@
+// This encoder is present in the test schedule and has passed automated validation.
+#include "../Encoder.h"
+#include "../BitPatcher.h"
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Encodes an STR (Store Register) instruction for a double-precision register with a scaled register offset.
+ * @details
+ * This function generates the machine code to store a 64-bit floating-point register (Dt)
+ * at an address computed by a 64-bit base (Xn) plus a shifted 64-bit index register (Xm).
+ * The operation is `STR Dt, [Xn, Xm, LSL #shift]`, one instruction per FVEC element.
+ *
+ * The encoding follows the "Load/Store Register (register offset)" format:
+ * - **size (bits 31-30)**: `11` for a 64-bit access.
+ * - **V (bit 26)**: `1` for a SIMD&FP register.
+ * - **L (bit 22)**: `0` for Store.
+ * - **Rm (bits 20-16)**: The index register `xm`.
+ * - **option (bits 15-13)**: `0b011` for LSL.
+ * - **S (bit 12)**: `1` if the index is shifted by 3, `0` otherwise.
+ * - **Rn (bits 9-5)**: The base address register `xn`.
+ * - **Rt (bits 4-0)**: The data register `dt`.
+ *
+ * @param dt The double-precision data register (e.g., "d0").
+ * @param xn The 64-bit base address register (e.g., "x1", "sp").
+ * @param xm The 64-bit index register (e.g., "x2").
+ * @param shift The left shift amount. **Must be 0 or 3**.
+ * @return An `Instruction` object.
+ * @throw std::invalid_argument for invalid registers or unsupported shift values.
+ */
+Instruction Encoder::create_str_fp_scaled_reg(const std::string& dt, const std::string& xn, const std::string& xm, int shift) {
+    // (A) Validate the shift amount and the operands.
+    if (shift != 0 && shift != 3) {
+        throw std::invalid_argument("Invalid shift for STR (FP) with 64-bit register offset. Must be 0 or 3.");
+    }
+    Reg rt = Reg::parse(dt), rn = Reg::parse(xn), rm = Reg::parse(xm);
+    if (rt.kind() != Reg::D) {
+        throw std::invalid_argument("Data register for STR (FP) must be a 'D' register, got '" + dt + "'.");
+    }
+    if (!rn.is_gpr() || !rn.is_64bit() || rn.is_zr() || !rm.is_gpr() || !rm.is_64bit() || rm.is_sp()) {
+        throw std::invalid_argument("Base and index registers for this STR variant must be 64-bit 'X' registers.");
+    }
+
+    // (B) Use BitPatcher. The base opcode for STR Dt, [Xn, Xm] with the LSL option is 0xFC206800.
+    BitPatcher patcher(0xFC206800);
+    patcher.patch(rt.number(), 0, 5);  // Rt
+    patcher.patch(rn.number(), 5, 5);  // Rn
+    patcher.patch(rm.number(), 16, 5); // Rm
+    if (shift == 3) {
+        patcher.patch(1, 12, 1); // S: scale the index by 8
+    }
+
+    // (C) Format the assembly string.
+    std::string assembly_text = "STR " + dt + ", [" + xn + ", " + xm;
+    if (shift > 0) {
+        assembly_text += ", LSL #" + std::to_string(shift);
+    }
+    assembly_text += "]";
+
+    Instruction instr(patcher.get_value(), assembly_text);
+    instr.opcode = InstructionDecoder::OpType::STR_FP;
+    instr.src_reg1 = rt.number();
+    instr.src_reg2 = rm.number();
+    instr.base_reg = rn.number();
+    instr.is_mem_op = true;
+    return instr;
+}
@@ -0,0 +1,68 @@
+// This encoder is present in the test schedule and has passed automated validation.
+#include "../Encoder.h"
+#include "../BitPatcher.h"
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Encodes an STR (Store Register) instruction with a scaled 64-bit register offset.
+ * @details
+ * This function generates the machine code to store a 64-bit register (Xt) to an
+ * address computed by a 64-bit base (Xn) plus a shifted 64-bit index register (Xm).
+ * The operation is `STR Xt, [Xn, Xm, LSL #shift]`. It is the store counterpart of
+ * create_ldr_scaled_reg_64bit and writes v!i in one instruction.
+ *
+ * The encoding follows the "Load/Store Register (register offset)" format:
+ * - **size (bits 31-30)**: `11` for a 64-bit store.
+ * - **L (bit 22)**: `0` for Store.
+ * - **Rm (bits 20-16)**: The index register `xm`.
+ * - **option (bits 15-13)**: `0b011` for LSL.
+ * - **S (bit 12)**: `1` if the index is shifted by 3, `0` otherwise.
+ * - **Rn (bits 9-5)**: The base address register `xn`.
+ * - **Rt (bits 4-0)**: The source register `xt`.
+ *
+ * @param xt The 64-bit source register (e.g., "x0", "xzr").
+ * @param xn The 64-bit base address register (e.g., "x1", "sp").
+ * @param xm The 64-bit index register (e.g., "x2").
+ * @param shift The left shift amount. **Must be 0 or 3**.
+ * @return An `Instruction` object.
+ * @throw std::invalid_argument for invalid registers or unsupported shift values.
+ */
+Instruction Encoder::create_str_scaled_reg_64bit(const std::string& xt, const std::string& xn, const std::string& xm, int shift) {
+    // (A) Validate the shift amount and the operands.
+    if (shift != 0 && shift != 3) {
+        throw std::invalid_argument("Invalid shift for 64-bit STR with 64-bit register offset. Must be 0 or 3.");
+    }
+    Reg rt = Reg::parse(xt), rn = Reg::parse(xn), rm = Reg::parse(xm);
+    require_gpr(rt, "create_str_scaled_reg_64bit");
+    if (!rt.is_64bit() || rt.is_sp()) {
+        throw std::invalid_argument("Source register for STR (64-bit) must be an 'X' register.");
+    }
+    if (!rn.is_gpr() || !rn.is_64bit() || rn.is_zr() || !rm.is_gpr() || !rm.is_64bit() || rm.is_sp()) {
+        throw std::invalid_argument("Base and index registers for this STR variant must be 64-bit 'X' registers.");
+    }
+
+    // (B) Use BitPatcher. The base opcode for STR Xt, [Xn, Xm] with the LSL option is 0xF8206800.
+    BitPatcher patcher(0xF8206800);
+    patcher.patch(rt.number(), 0, 5);  // Rt
+    patcher.patch(rn.number(), 5, 5);  // Rn
+    patcher.patch(rm.number(), 16, 5); // Rm
+    if (shift == 3) {
+        patcher.patch(1, 12, 1); // S: scale the index by 8
+    }
+
+    // (C) Format the assembly string.
+    std::string assembly_text = "STR " + xt + ", [" + xn + ", " + xm;
+    if (shift > 0) {
+        assembly_text += ", LSL #" + std::to_string(shift);
+    }
+    assembly_text += "]";
+
+    Instruction instr(patcher.get_value(), assembly_text);
+    instr.opcode = InstructionDecoder::OpType::STR;
+    instr.src_reg1 = rt.number();
+    instr.src_reg2 = rm.number();
+    instr.base_reg = rn.number();
+    instr.is_mem_op = true;
+    return instr;
+}
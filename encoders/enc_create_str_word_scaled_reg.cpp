@@ -0,0 +1,69 @@
+// This encoder is present in the test schedule and has passed automated validation.
+#include "../Encoder.h"
+#include "../BitPatcher.h"
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Encodes an STR (Store Register) instruction for a 32-bit word with a scaled register offset.
+ * @details
+ * This function generates the machine code to store a 32-bit word at an address
+ * computed by a 64-bit base (Xn) plus a shifted 64-bit index register (Xm).
+ * The operation is `STR Wt, [Xn, Xm, LSL #shift]`, which is how a character
+ * of a UTF-32 string (s%i) is accessed in one instruction.
+ *
+ * The encoding follows the "Load/Store Register (register offset)" format:
+ * - **size (bits 31-30)**: `10` for a 32-bit access.
+ * - **L (bit 22)**: `0` for Store.
+ * - **Rm (bits 20-16)**: The index register `xm`.
+ * - **option (bits 15-13)**: `0b011` for LSL.
+ * - **S (bit 12)**: `1` if the index is shifted by 2, `0` otherwise.
+ * - **Rn (bits 9-5)**: The base address register `xn`.
+ * - **Rt (bits 4-0)**: The data register `wt`.
+ *
+ * @param wt The data register (e.g., "w0"; an "x" name is accepted and written as its W view).
+ * @param xn The 64-bit base address register (e.g., "x1", "sp").
+ * @param xm The 64-bit index register (e.g., "x2").
+ * @param shift The left shift amount. **Must be 0 or 2**.
+ * @return An `Instruction` object.
+ * @throw std::invalid_argument for invalid registers or unsupported shift values.
+ */
+Instruction Encoder::create_str_word_scaled_reg(const std::string& wt, const std::string& xn, const std::string& xm, int shift) {
+    // (A) Validate the shift amount and the operands.
+    if (shift != 0 && shift != 2) {
+        throw std::invalid_argument("Invalid shift for 32-bit STR with 64-bit register offset. Must be 0 or 2.");
+    }
+    Reg rt = Reg::parse(wt), rn = Reg::parse(xn), rm = Reg::parse(xm);
+    require_gpr(rt, "create_str_word_scaled_reg");
+    if (rt.is_sp()) {
+        throw std::invalid_argument("Data register for STR (word) cannot be the stack pointer.");
+    }
+    if (!rn.is_gpr() || !rn.is_64bit() || rn.is_zr() || !rm.is_gpr() || !rm.is_64bit() || rm.is_sp()) {
+        throw std::invalid_argument("Base and index registers for this STR variant must be 64-bit 'X' registers.");
+    }
+    const std::string& rt_name = rt.is_zr() ? Reg::wzr().name() : Reg::w(rt.number()).name();
+
+    // (B) Use BitPatcher. The base opcode for STR Wt, [Xn, Xm] with the LSL option is 0xB8206800.
+    BitPatcher patcher(0xB8206800);
+    patcher.patch(rt.number(), 0, 5);  // Rt
+    patcher.patch(rn.number(), 5, 5);  // Rn
+    patcher.patch(rm.number(), 16, 5); // Rm
+    if (shift == 2) {
+        patcher.patch(1, 12, 1); // S: scale the index by 4
+    }
+
+    // (C) Format the assembly string.
+    std::string assembly_text = "STR " + rt_name + ", [" + xn + ", " + xm;
+    if (shift > 0) {
+        assembly_text += ", LSL #" + std::to_string(shift);
+    }
+    assembly_text += "]";
+
+    Instruction instr(patcher.get_value(), assembly_text);
+    instr.opcode = InstructionDecoder::OpType::STR;
+    instr.src_reg1 = rt.number();
+    instr.src_reg2 = rm.number();
+    instr.base_reg = rn.number();
+    instr.is_mem_op = true;
+    return instr;
+}
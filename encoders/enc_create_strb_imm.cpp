@@ -0,0 +1,65 @@
+// This encoder is NOT present in the test schedule. Test will be added via wrapper and results updated here.
+#include "BitPatcher.h"
+#include "Encoder.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Encodes the ARM64 'STRB' (Store Register Byte) instruction with an unsigned immediate offset.
+ * @details
+ * This function generates the machine code to store the low byte of a register.
+ * The operation is `STRB <Wt>, [<Xn>{, #imm}]`.
+ *
+ * The encoding follows the "Load/Store Register (unsigned immediate)" format:
+ * - **size (bits 31-30)**: `00` for byte access.
+ * - **Family (bits 29-24)**: `0b111001`.
+ * - **L (bit 22)**: `0` for Store.
+ * - **imm12 (bits 21-10)**: A 12-bit unsigned byte offset.
+ * - **Rn (bits 9-5)**: The base address register.
+ * - **Rt (bits 4-0)**: The source register.
+ *
+ * @param wt The source register (e.g., "w0"; an "x" name stores the same low byte).
+ * @param xn The base address register (e.g., "x1", "sp").
+ * @param immediate The unsigned byte offset, in the range [0, 4095].
+ * @return An `Instruction` object.
+ * @throw std::invalid_argument for invalid registers or out-of-range immediates.
+ */
+Instruction Encoder::create_strb_imm(const std::string& wt, const std::string& xn, int immediate) {
+    // (A) Validate the immediate offset.
+    if (immediate < 0 || immediate > 4095) {
+        throw std::invalid_argument("Immediate for STRB must be an unsigned 12-bit value [0, 4095].");
+    }
+
+    std::string lower_base = xn;
+    std::transform(lower_base.begin(), lower_base.end(), lower_base.begin(), ::tolower);
+    if (lower_base != "sp" && (lower_base.empty() || lower_base[0] != 'x')) {
+        throw std::invalid_argument("STRB base register must be a 64-bit 'X' register or SP.");
+    }
+
+    // (B) Use BitPatcher. The base opcode for STRB (unsigned immediate) is 0x39000000.
+    BitPatcher patcher(0x39000000);
+
+    // Patch the immediate, base register, and source register.
+    patcher.patch(static_cast<uint32_t>(immediate), 10, 12); // imm12
+    patcher.patch(get_reg_encoding(xn), 5, 5);               // Rn
+    patcher.patch(get_reg_encoding(wt), 0, 5);               // Rt
+
+    // (C) Format the assembly string.
+    std::string assembly_text = "STRB " + wt + ", [" + xn;
+    if (immediate != 0) {
+        assembly_text += ", #" + std::to_string(immediate);
+    }
+    assembly_text += "]";
+
+    // (D) Return the completed Instruction object.
+    Instruction instr(patcher.get_value(), assembly_text);
+    instr.opcode = InstructionDecoder::OpType::STRB;
+    instr.src_reg1 = Encoder::get_reg_encoding(wt);
+    instr.base_reg = Encoder::get_reg_encoding(xn);
+    instr.immediate = immediate;
+    instr.uses_immediate = true;
+    instr.is_mem_op = true;
+    return instr;
+}
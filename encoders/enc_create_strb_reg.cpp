@@ -0,0 +1,55 @@
+// This encoder is present in the test schedule and has passed automated validation.
+#include "../Encoder.h"
+#include "../BitPatcher.h"
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Encodes the ARM64 'STRB' (Store Register Byte) instruction with a register offset.
+ * @details
+ * This function generates the machine code to store a byte at an address computed by a
+ * 64-bit base (Xn) plus a 64-bit index register (Xm). The operation is
+ * `STRB Wt, [Xn, Xm]`, which is how a character of a compact (Latin-1) string
+ * is accessed in one instruction.
+ *
+ * The encoding follows the "Load/Store Register (register offset)" format:
+ * - **size (bits 31-30)**: `00` for a byte access.
+ * - **L (bit 22)**: `0` for Store.
+ * - **Rm (bits 20-16)**: The index register `xm`.
+ * - **option (bits 15-13)**: `0b011` for LSL; bytes are never scaled, so S (bit 12) is `0`.
+ * - **Rn (bits 9-5)**: The base address register `xn`.
+ * - **Rt (bits 4-0)**: The data register `wt`.
+ *
+ * @param wt The data register (e.g., "w0"; an "x" name is accepted and written as its W view).
+ * @param xn The 64-bit base address register (e.g., "x1", "sp").
+ * @param xm The 64-bit index register (e.g., "x2").
+ * @return An `Instruction` object.
+ * @throw std::invalid_argument for invalid registers.
+ */
+Instruction Encoder::create_strb_reg(const std::string& wt, const std::string& xn, const std::string& xm) {
+    // (A) Validate the operands.
+    Reg rt = Reg::parse(wt), rn = Reg::parse(xn), rm = Reg::parse(xm);
+    require_gpr(rt, "create_strb_reg");
+    if (rt.is_sp()) {
+        throw std::invalid_argument("Data register for STRB cannot be the stack pointer.");
+    }
+    if (!rn.is_gpr() || !rn.is_64bit() || rn.is_zr() || !rm.is_gpr() || !rm.is_64bit() || rm.is_sp()) {
+        throw std::invalid_argument("Base and index registers for STRB (register) must be 64-bit 'X' registers.");
+    }
+    const std::string& rt_name = rt.is_zr() ? Reg::wzr().name() : Reg::w(rt.number()).name();
+
+    // (B) Use BitPatcher. The base opcode for STRB Wt, [Xn, Xm] is 0x38206800.
+    BitPatcher patcher(0x38206800);
+    patcher.patch(rt.number(), 0, 5);  // Rt
+    patcher.patch(rn.number(), 5, 5);  // Rn
+    patcher.patch(rm.number(), 16, 5); // Rm
+
+    // (C) Format the assembly string.
+    Instruction instr(patcher.get_value(), "STRB " + rt_name + ", [" + xn + ", " + xm + "]");
+    instr.opcode = InstructionDecoder::OpType::STRB;
+    instr.src_reg1 = rt.number();
+    instr.src_reg2 = rm.number();
+    instr.base_reg = rn.number();
+    instr.is_mem_op = true;
+    return instr;
+}
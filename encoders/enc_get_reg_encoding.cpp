@@ -1,9 +1,8 @@
 // This encoder is NOT present in the test schedule. Test will be added via wrapper and results updated here.
 #include "Encoder.h"
+#include "Reg.h"
 #include <string>
 #include <stdexcept>
-#include <algorithm>
-#include <cctype>
 #include <iostream>
 #include <execinfo.h>
 #include <cstdlib>
@@ -39,42 +38,16 @@ uint32_t Encoder::get_reg_encoding(const std::string& reg_name) {
         throw std::invalid_argument("Register name cannot be empty.");
     }
 
-    // Convert to lowercase for case-insensitive matching.
-    std::string lower_reg = reg_name;
-    std::transform(lower_reg.begin(), lower_reg.end(), lower_reg.begin(), ::tolower);
-
-    // Handle aliases for register 31 first.
-    if (lower_reg == "wzr" || lower_reg == "xzr" || lower_reg == "wsp" || lower_reg == "sp") {
-        return 31;
-    }
-
-    // Check for a valid alphabetic prefix.
-    char prefix = lower_reg[0];
-    if (!std::isalpha(prefix)) {
-        throw std::invalid_argument("Invalid register prefix in '" + reg_name + "'. Must be a letter.");
+    Reg reg;
+    if (!Reg::try_parse(reg_name, reg)) {
+        throw std::invalid_argument("Invalid register format: " + reg_name);
     }
+    return reg.number();
+}
 
-    try {
-        // Handle different register types
-        if (prefix == 'd' || prefix == 'v' || prefix == 's' || prefix == 'q') { // Added 'v' for vector registers, 's' for single precision FP, and 'q' for 128-bit vector registers
-            uint32_t reg_num = std::stoul(lower_reg.substr(1));
-            if (reg_num > 31) {
-                throw std::out_of_range("FP/Vector register number " + std::to_string(reg_num) + 
-                                      " is out of the valid range [0, 31].");
-            }
-            return reg_num;
-        } else if (prefix == 'w' || prefix == 'x') {
-            uint32_t reg_num = std::stoul(lower_reg.substr(1));
-            if (reg_num > 31) {
-                throw std::out_of_range("Register number " + std::to_string(reg_num) + 
-                                      " is out of the valid range [0, 31].");
-            }
-            return reg_num;
-        } else {
-            throw std::invalid_argument("Invalid register prefix in '" + reg_name + 
-                                     "'. Must be 'w', 'x', 'd', 'v', 's', or 'q'.");
-        }
-    } catch (const std::logic_error&) {
-        throw std::invalid_argument("Invalid register format: " + reg_name);
+void Encoder::require_gpr(Reg reg, const char* encoder_name) {
+    if (!reg.is_gpr()) {
+        throw std::invalid_argument("Invalid register '" + reg.name() + "'. Must be 'w' or 'x'. (Thrown by " +
+                                    encoder_name + ")");
     }
 }
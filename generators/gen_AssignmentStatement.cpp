@@ -284,18 +284,13 @@ void NewCodeGenerator::visit(AssignmentStatement& node) {
                 std::string base_reg = expression_result_reg_;
                 generate_expression_code(*vec_access->index_expr);
                 std::string index_reg = expression_result_reg_;
-                // FIX: Use a temporary register for the offset calculation to avoid corrupting the loop variable
-                std::string offset_reg = register_manager_.acquire_scratch_reg(*this);
-                emit(Encoder::create_lsl_imm(offset_reg, index_reg, 3));
-                std::string effective_addr_reg = register_manager_.get_free_register(*this);
-                emit(Encoder::create_add_reg(effective_addr_reg, base_reg, offset_reg));
-                
-                // Release the temporary offset register
-                register_manager_.release_scratch_reg(offset_reg);
+                // FTABLE: floating-point store to base + index * 8. The scaled register-offset
+                // STR leaves the index (often the loop variable) untouched.
+                Instruction str_instr = Encoder::create_str_fp_scaled_reg(store_reg, base_reg, index_reg, 3);
+                str_instr.nopeep = true; // Protect from peephole optimization
+                emit(str_instr);
                 register_manager_.release_register(base_reg);
                 register_manager_.release_register(index_reg);
-                emit(Encoder::create_str_fp_imm(store_reg, effective_addr_reg, 0)); // FTABLE: floating-point store
-                register_manager_.release_register(effective_addr_reg);
                 register_manager_.release_register(store_reg);
             } else {
                 handle_vector_assignment(vec_access, value_to_store_reg);
@@ -345,21 +340,21 @@ void NewCodeGenerator::handle_float_vector_indirection_assignment(FloatVectorInd
     generate_expression_code(*float_vec_indirection->index_expr);
     std::string index_reg = expression_result_reg_;
 
-    // Multiply index by 8 (for 64-bit doubles) using a temporary register to avoid corrupting loop variables
-    // FIX: Use a temporary register for the offset calculation to avoid corrupting the loop variable
-    std::string offset_reg = register_manager_.acquire_scratch_reg(*this);
-    emit(Encoder::create_lsl_imm(offset_reg, index_reg, 3)); // LSL by 3 (multiply by 8 for double)
+    // A value computed as an integer is converted before the floating-point store
+    std::string store_reg = value_to_store_reg;
+    if (!register_manager_.is_fp_register(store_reg)) {
+        store_reg = register_manager_.acquire_fp_scratch_reg();
+        emit(Encoder::create_scvtf_reg(store_reg, value_to_store_reg));
+    }
 
-    // Add the offset to the base address to get the effective memory address
-    std::string effective_addr_reg = register_manager_.get_free_register(*this);
-    emit(Encoder::create_add_reg(effective_addr_reg, base_reg, offset_reg));
-    
-    // Release the temporary offset register
-    register_manager_.release_scratch_reg(offset_reg);
+    // Store the 64-bit floating-point value to base + index * 8. The scaled
+    // register-offset STR leaves the index register untouched.
+    Instruction str_instr = Encoder::create_str_fp_scaled_reg(store_reg, base_reg, index_reg, 3);
+    str_instr.nopeep = true; // Protect from peephole optimization
+    emit(str_instr);
     register_manager_.release_register(base_reg);
     register_manager_.release_register(index_reg);
-
-    // Store the 64-bit floating-point value from value_to_store_reg into the effective address
-    emit(Encoder::create_str_fp_imm(value_to_store_reg, effective_addr_reg, 0));
-    register_manager_.release_register(effective_addr_reg);
+    if (store_reg != value_to_store_reg) {
+        register_manager_.release_register(store_reg);
+    }
 }
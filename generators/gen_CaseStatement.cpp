@@ -7,7 +7,7 @@
 
 void NewCodeGenerator::visit(CaseStatement& node) {
     debug_print("Visiting CaseStatement node (Constant: " + std::to_string(static_cast<NumberLiteral*>(node.constant_expr.get())->int_value) + ").");
-    auto& register_manager = RegisterManager::getInstance();
+    auto& register_manager = register_manager_;
     // CaseStatement is handled as part of SwitchonStatement.
     // Its `command` is visited when its condition matches.
     // No direct code generation here.
@@ -18,6 +18,12 @@ void NewCodeGenerator::visit(CharIndirection& node) {
     generate_expression_code(*node.index_expr);
     std::string index_reg = expression_result_reg_; // Holds the index (in bytes)
 
+    if (compact_strings_) {
+        generate_compact_aware_char_load(string_base_reg, index_reg);
+        debug_print("Finished visiting CharIndirection node.");
+        return;
+    }
+
     // --- BOUNDS CHECKING ---
     if (bounds_checking_enabled_) {
         debug_print("Generating bounds check for string character access.");
@@ -30,6 +36,7 @@ void NewCodeGenerator::visit(CharIndirection& node) {
         emit(Encoder::create_sub_imm(length_addr_reg, string_base_reg, 8));
         emit(Encoder::create_ldr_imm(length_reg, length_addr_reg, 0, "Load string length for bounds check"));
         register_manager.release_register(length_addr_reg);
+        emit(Encoder::opt_create_ubfx(length_reg, length_reg, 0, 61)); // without the exact-length bit
         
         // Compare index with length (unsigned comparison)
         emit(Encoder::create_cmp_reg(index_reg, length_reg));
@@ -43,27 +50,86 @@ void NewCodeGenerator::visit(CharIndirection& node) {
         debug_print("Bounds check generated for string access.");
     }
 
-    // Scale index by 4 for 32-bit character access
-    // FIX: Copy index to temp register to avoid destructive modification
-    std::string offset_reg = register_manager.acquire_scratch_reg(*this);
-    emit(Encoder::create_mov_reg(offset_reg, index_reg));
-    emit(Encoder::create_lsl_imm(offset_reg, offset_reg, 2)); // offset_reg <<= 2
-
-    // Add the offset to the base address to get the effective memory address
-    std::string effective_addr_reg = register_manager.get_free_register(*this);
-    emit(Encoder::create_add_reg(effective_addr_reg, string_base_reg, offset_reg));
-    register_manager.release_register(string_base_reg);
-    register_manager.release_register(index_reg);
-    register_manager.release_register(offset_reg);
-
-    // Load the 32-bit character value from the effective address into a W register
+    // Load the 32-bit character at base + index * 4 into a W register,
+    // leaving the index register untouched
     std::string x_dest_reg = register_manager.get_free_register(*this); // Get X register
     std::string w_dest_reg = "W" + x_dest_reg.substr(1); // Convert "Xn" to "Wn"
-    emit(Encoder::create_ldr_word_imm(w_dest_reg, effective_addr_reg, 0)); // Load 32-bit value
-    register_manager.release_register(effective_addr_reg);
+    Instruction ldr_instr = Encoder::create_ldr_word_scaled_reg(w_dest_reg, string_base_reg, index_reg, 2);
+    ldr_instr.nopeep = true; // Protect from peephole optimization
+    emit(ldr_instr);
+    register_manager.release_register(string_base_reg);
+    register_manager.release_register(index_reg);
 
     // ✅ FIX: Return the 64-bit X register. Writing to the W register
     // automatically zero-extends the value into the full X register.
     expression_result_reg_ = x_dest_reg;
     debug_print("Finished visiting CharIndirection node.");
 }
+
+// With --compact-strings a string may store one byte per character, or
+// forward to a UTF-32 copy after promotion (see runtime/string_class.h). The
+// storage class is in the top two bits of the length word, so the load
+// dispatches on it:
+//
+//   LDR  hdr, [base, #-8]            (SUB + LDR)
+//   UBFX len, hdr, #0, #61          ; bounds check, if enabled
+//   UBFX tag, hdr, #62, #2
+//   CMP tag, #2 ; B.EQ compact
+//   CMP tag, #1 ; B.NE wide
+//   LDR base, [base]                ; promoted: follow the forward pointer
+// wide:    LDR Wd, [base, index, LSL #2]
+//          B done
+// compact: LDRB Wd, [base, index]
+// done:
+void NewCodeGenerator::generate_compact_aware_char_load(const std::string& string_base_reg, const std::string& index_reg) {
+    auto& register_manager = register_manager_;
+    std::string wide_label = label_manager_.create_label();
+    std::string compact_label = label_manager_.create_label();
+    std::string done_label = label_manager_.create_label();
+
+    std::string header_reg = register_manager.get_free_register(*this);
+    std::string tag_reg = register_manager.get_free_register(*this);
+    emit(Encoder::create_sub_imm(header_reg, string_base_reg, 8));
+    emit(Encoder::create_ldr_imm(header_reg, header_reg, 0, "Load string length word"));
+
+    if (bounds_checking_enabled_) {
+        debug_print("Generating bounds check for string character access.");
+        emit(Encoder::opt_create_ubfx(tag_reg, header_reg, 0, 61)); // length without the class and exact-length bits
+        emit(Encoder::create_cmp_reg(index_reg, tag_reg));
+        emit(Encoder::create_branch_conditional("HS", get_bounds_error_label_for_current_function()));
+    }
+
+    emit(Encoder::opt_create_ubfx(tag_reg, header_reg, 62, 2));
+    register_manager.release_register(header_reg);
+
+    // The base is copied so that following a forward pointer leaves the
+    // string expression's register alone.
+    std::string base_reg = register_manager.get_free_register(*this);
+    std::string x_dest_reg = register_manager.get_free_register(*this);
+    std::string w_dest_reg = "W" + x_dest_reg.substr(1);
+    emit(Encoder::create_mov_reg(base_reg, string_base_reg));
+    emit(Encoder::create_cmp_imm(tag_reg, 2));
+    emit(Encoder::create_branch_conditional("EQ", compact_label));
+    emit(Encoder::create_cmp_imm(tag_reg, 1));
+    emit(Encoder::create_branch_conditional("NE", wide_label));
+    emit(Encoder::create_ldr_imm(base_reg, base_reg, 0, "Follow promoted string"));
+    register_manager.release_register(tag_reg);
+
+    instruction_stream_.define_label(wide_label);
+    Instruction wide_ldr = Encoder::create_ldr_word_scaled_reg(w_dest_reg, base_reg, index_reg, 2);
+    wide_ldr.nopeep = true;
+    emit(wide_ldr);
+    emit(Encoder::create_branch_unconditional(done_label));
+
+    instruction_stream_.define_label(compact_label);
+    Instruction compact_ldr = Encoder::create_ldrb_reg(w_dest_reg, base_reg, index_reg);
+    compact_ldr.nopeep = true;
+    emit(compact_ldr);
+
+    instruction_stream_.define_label(done_label);
+    register_manager.release_register(base_reg);
+    register_manager.release_register(string_base_reg);
+    register_manager.release_register(index_reg);
+
+    expression_result_reg_ = x_dest_reg;
+}
@@ -7,7 +7,7 @@
 
 void NewCodeGenerator::visit(DefaultStatement& node) {
     debug_print("Visiting DefaultStatement node.");
-    auto& register_manager = RegisterManager::getInstance();
+    auto& register_manager = register_manager_;
     // DefaultStatement is handled as part of SwitchonStatement.
     // Its `command` is visited if no preceding cases match.
     // No direct code generation here.
@@ -19,7 +19,7 @@ void NewCodeGenerator::visit(FPairAccessExpression& node) {
     node.pair_expr->accept(*this);
     std::string fpair_reg = expression_result_reg_;
     
-    auto& register_manager = RegisterManager::getInstance();
+    auto& register_manager = register_manager_;
     
     // Extract the appropriate 32-bit field from the 64-bit word using UBFX
     std::string temp_gen_reg = register_manager.get_free_register(*this);
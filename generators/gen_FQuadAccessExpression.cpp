@@ -14,7 +14,7 @@ void NewCodeGenerator::visit(FQuadAccessExpression& node) {
     node.quad_expr->accept(*this);
     std::string fquad_reg = expression_result_reg_;
     
-    auto& register_manager = RegisterManager::getInstance();
+    auto& register_manager = register_manager_;
     std::string result_reg = register_manager.get_free_register(*this);
     
     // For FQUAD access, we extract 32-bit float values from the packed 64-bit representation
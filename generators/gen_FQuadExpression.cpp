@@ -10,7 +10,7 @@ void NewCodeGenerator::visit(FQuadExpression& node) {
     // For now, we'll represent this as two 64-bit registers or use stack storage
     // This is a simplified implementation that stores to memory and loads back
     
-    auto& register_manager = RegisterManager::getInstance();
+    auto& register_manager = register_manager_;
     std::string result_reg = register_manager.get_free_register(*this);
     
     // Check if this is a literal fquad (all expressions are literals)
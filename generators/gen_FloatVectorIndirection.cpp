@@ -18,22 +18,13 @@ void NewCodeGenerator::visit(FloatVectorIndirection& node) {
     auto& register_manager = register_manager_;
     std::string dest_d_reg = register_manager.get_free_float_register(); // Destination is a float register
 
-    // Calculate the byte offset: index * 8 (since double is 8 bytes)
-    // FIX: Copy index to temp register to avoid destructive modification
-    std::string offset_reg = register_manager.acquire_scratch_reg(*this);
-    emit(Encoder::create_mov_reg(offset_reg, index_reg));
-    emit(Encoder::create_lsl_imm(offset_reg, offset_reg, 3)); // LSL by 3 (multiply by 8 for double)
-
-    // Add the offset to the base address to get the effective memory address
-    std::string effective_addr_reg = register_manager_.get_free_register(*this);
-    emit(Encoder::create_add_reg(effective_addr_reg, vector_base_reg, offset_reg));
+    // Load the 64-bit floating-point value from base + index * 8 into a D register,
+    // leaving the index register untouched
+    Instruction ldr_instr = Encoder::create_ldr_fp_scaled_reg(dest_d_reg, vector_base_reg, index_reg, 3);
+    ldr_instr.nopeep = true; // Protect from peephole optimization
+    emit(ldr_instr);
     register_manager_.release_register(vector_base_reg);
     register_manager_.release_register(index_reg);
-    register_manager_.release_register(offset_reg);
-
-    // Load the 64-bit floating-point value from the effective address into a D register
-    emit(Encoder::create_ldr_fp_imm(dest_d_reg, effective_addr_reg, 0));
-    register_manager_.release_register(effective_addr_reg);
 
     expression_result_reg_ = dest_d_reg; // Result is in a float register
     debug_print("Finished visiting FloatVectorIndirection node.");
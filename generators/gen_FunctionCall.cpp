@@ -256,12 +256,6 @@ void NewCodeGenerator::handle_method_call(FunctionCall& node, const std::vector<
     if (!method_info) {
         throw std::runtime_error("Method '" + method_name + "' not found in class '" + class_name + "'.");
     }
-    size_t vtable_offset = method_info->vtable_slot * 8;
-    std::string vtable_ptr_reg = register_manager_.acquire_scratch_reg(*this);
-    emit(Encoder::create_ldr_imm(vtable_ptr_reg, this_ptr_reg, 0, "Load vtable pointer"));
-    std::string method_addr_reg = register_manager_.acquire_scratch_reg(*this);
-    emit(Encoder::create_ldr_imm(method_addr_reg, vtable_ptr_reg, vtable_offset, "Load method address"));
-    register_manager_.release_register(vtable_ptr_reg);
     emit(Encoder::create_mov_reg("X0", this_ptr_reg));
     for (size_t i = 0; i < arg_result_regs.size(); ++i) {
         std::string target_reg = "X" + std::to_string(i + 1);
@@ -269,9 +263,7 @@ void NewCodeGenerator::handle_method_call(FunctionCall& node, const std::vector<
         register_manager_.release_register(arg_result_regs[i]);
     }
     register_manager_.release_register(this_ptr_reg);
-    emit(Encoder::create_branch_with_link_register(method_addr_reg));
-    register_manager_.invalidate_caller_saved_registers();
-    register_manager_.release_register(method_addr_reg);
+    emit_method_dispatch(class_name, *method_info, member_access->exact_class_name);
     
     // Set the result register based on the method's return type.
     std::string mangled_name = class_name + "::" + method_name;
@@ -288,6 +280,61 @@ void NewCodeGenerator::handle_method_call(FunctionCall& node, const std::vector<
     }
 }
 
+void NewCodeGenerator::emit_method_dispatch(const std::string& class_name, const ClassMethodInfo& method_info,
+                                            const std::string& exact_class_name) {
+    size_t vtable_slot = method_info.vtable_slot;
+
+    // The receiver's class is known, or every class it can be shares the method
+    std::string target;
+    const ClassTableEntry* exact_entry = class_table_->get_class(exact_class_name);
+    if (exact_entry && class_table_->is_descendant_of(exact_class_name, class_name) &&
+        vtable_slot < exact_entry->vtable_blueprint.size()) {
+        target = exact_entry->vtable_blueprint[vtable_slot];
+    }
+    if (target.empty()) {
+        target = class_table_->unique_method_target(class_name, vtable_slot);
+    }
+    if (!target.empty()) {
+        debug_print("Devirtualized call to " + method_info.name + ": BL " + target);
+        emit(Encoder::create_branch_with_link(target));
+        register_manager_.invalidate_caller_saved_registers();
+        return;
+    }
+
+    std::string vtable_ptr_reg = register_manager_.acquire_scratch_reg(*this);
+    std::string method_addr_reg = register_manager_.acquire_scratch_reg(*this);
+    emit(Encoder::create_ldr_imm(vtable_ptr_reg, "X0", 0, "Load vtable pointer"));
+
+    // Monomorphic guard: an object of class_name itself calls its method directly
+    const ClassTableEntry* class_entry = class_table_->get_class(class_name);
+    std::string expected_target;
+    if (class_entry && vtable_slot < class_entry->vtable_blueprint.size()) {
+        expected_target = class_entry->vtable_blueprint[vtable_slot];
+    }
+    std::string done_label;
+    if (!expected_target.empty()) {
+        std::string vtable_label = class_name + "_vtable";
+        std::string virtual_label = label_manager_.create_label();
+        done_label = label_manager_.create_label();
+        emit(Encoder::create_adrp(method_addr_reg, vtable_label));
+        emit(Encoder::create_add_literal(method_addr_reg, method_addr_reg, vtable_label));
+        emit(Encoder::create_cmp_reg(vtable_ptr_reg, method_addr_reg));
+        emit(Encoder::create_branch_conditional("NE", virtual_label));
+        emit(Encoder::create_branch_with_link(expected_target));
+        emit(Encoder::create_branch_unconditional(done_label));
+        instruction_stream_.define_label(virtual_label);
+    }
+
+    emit(Encoder::create_ldr_imm(method_addr_reg, vtable_ptr_reg, vtable_slot * 8, "Load method address for " + method_info.name));
+    emit(Encoder::create_branch_with_link_register(method_addr_reg));
+    if (!done_label.empty()) {
+        instruction_stream_.define_label(done_label);
+    }
+    register_manager_.release_register(vtable_ptr_reg);
+    register_manager_.release_register(method_addr_reg);
+    register_manager_.invalidate_caller_saved_registers();
+}
+
 void NewCodeGenerator::handle_super_call(FunctionCall& node, const std::vector<std::string>& arg_result_regs) {
     auto* super_access = static_cast<SuperMethodAccessExpression*>(node.function_expr.get());
     std::string this_ptr_reg = get_variable_register("_this");
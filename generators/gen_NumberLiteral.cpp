@@ -6,7 +6,7 @@
 
 void NewCodeGenerator::visit(NumberLiteral& node) {
     debug_print("Visiting NumberLiteral node.");
-    auto& register_manager = RegisterManager::getInstance();
+    auto& register_manager = register_manager_;
     std::string dest_reg = register_manager.get_free_register(*this); // Get a free temporary register
 
     if (node.literal_type == NumberLiteral::LiteralType::Integer) {
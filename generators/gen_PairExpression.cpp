@@ -25,7 +25,7 @@ void NewCodeGenerator::visit(PairExpression& node) {
         std::string pair_label = data_generator_.add_pair_literal(first_val, second_val);
         
         // Allocate register and load the literal from rodata
-        auto& register_manager = RegisterManager::getInstance();
+        auto& register_manager = register_manager_;
         std::string result_reg = register_manager.get_free_register(*this);
         
         // Load the pair literal value
@@ -42,7 +42,7 @@ void NewCodeGenerator::visit(PairExpression& node) {
     // First expression goes into bits 0-31 (lower 32 bits)
     // Second expression goes into bits 32-63 (upper 32 bits)
     
-    auto& register_manager = RegisterManager::getInstance();
+    auto& register_manager = register_manager_;
     std::string result_reg = register_manager.get_free_register(*this);
     
     // Initialize result register to 0
@@ -1,6 +1,10 @@
 #include "NewCodeGenerator.h"
 #include "AST.h"
+#include "AssemblerData.h"
+#include "LabelManager.h"
+#include "include/ParallelFor.h"
 #include <algorithm>
+#include <memory>
 #include <string>
 
 void NewCodeGenerator::visit(Program& node) {
@@ -46,8 +50,12 @@ void NewCodeGenerator::visit(Program& node) {
 
     // --- STEP 3: Now generate code for functions and routines ---
     debug_print("Code Generator: Generating code for functions and routines.");
-    for (auto* decl : function_decls) {
-        process_declaration(*decl);
+    if (codegen_jobs_ > 1 && function_decls.size() > 1) {
+        generate_functions_in_parallel(function_decls);
+    } else {
+        for (auto* decl : function_decls) {
+            process_declaration(*decl);
+        }
     }
 
     // ====================== START OF FIX ======================
@@ -62,3 +70,58 @@ void NewCodeGenerator::visit(Program& node) {
 
     debug_print("Finished visiting Program node.");
 }
+
+// --jobs N: each function is compiled by a generator of its own, with its own
+// registers, and each thread keeps a stream, labels, literals and copy of the
+// symbol table for the functions it compiles; only read-only state is shared
+// with this generator. Function i's labels and literals are named under
+// "F<i>_", and its instructions and literals are appended here in
+// declaration order, so the output does not depend on the schedule.
+void NewCodeGenerator::generate_functions_in_parallel(const std::vector<Declaration*>& function_decls) {
+    struct Worker {
+        LabelManager labels{".L"};
+        InstructionStream stream{labels};
+        std::unique_ptr<DataGenerator> data;
+        std::unique_ptr<SymbolTable> symbols;
+    };
+    struct Fragment {
+        std::vector<Instruction> instructions;
+        std::unique_ptr<DataGenerator> literals;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers(parallel_thread_count(function_decls.size(), codegen_jobs_));
+    std::vector<Fragment> fragments(function_decls.size());
+
+    parallel_for_worker(function_decls.size(), codegen_jobs_, [&](size_t i, size_t w) {
+        auto& worker = workers[w];
+        if (!worker) {
+            worker = std::make_unique<Worker>();
+            worker->data = data_generator_.make_worker();
+            worker->symbols = std::make_unique<SymbolTable>(*symbol_table_);
+        }
+
+        std::string prefix = "F" + std::to_string(i) + "_";
+        worker->labels.set_prefix(".L" + prefix);
+        worker->data->set_literal_prefix(prefix);
+
+        RegisterManager registers;
+        NewCodeGenerator generator(worker->stream, registers, worker->labels, debug_enabled_, debug_level,
+                                   *worker->data, data_segment_base_addr_, cfg_builder_, analyzer_,
+                                   std::move(worker->symbols), all_allocations_, is_jit_mode_, class_table_,
+                                   liveness_analyzer_, bounds_checking_enabled_, use_neon_);
+        generator.compact_strings_ = compact_strings_;
+        generator.veneer_manager_ = veneer_manager_;
+        generator.code_buffer_base_address_ = code_buffer_base_address_;
+        generator.process_declaration(*function_decls[i]);
+        worker->symbols = std::move(generator.symbol_table_);
+
+        fragments[i].instructions = worker->stream.take_instructions();
+        fragments[i].literals = std::make_unique<DataGenerator>();
+        fragments[i].literals->take_literals(*worker->data);
+    });
+
+    for (auto& fragment : fragments) {
+        instruction_stream_.append_instructions(std::move(fragment.instructions));
+        data_generator_.take_literals(*fragment.literals);
+    }
+}
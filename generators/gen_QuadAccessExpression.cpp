@@ -25,7 +25,7 @@ void NewCodeGenerator::visit(QuadAccessExpression& node) {
     node.quad_expr->accept(*this);
     std::string packed_reg = expression_result_reg_;
     
-    auto& register_manager = RegisterManager::getInstance();
+    auto& register_manager = register_manager_;
     std::string result_reg = register_manager.get_free_register(*this);
     
     // Handle different packed types
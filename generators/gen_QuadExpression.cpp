@@ -31,7 +31,7 @@ void NewCodeGenerator::visit(QuadExpression& node) {
         std::string quad_label = data_generator_.add_quad_literal(first_val, second_val, third_val, fourth_val);
         
         // Allocate register and load the literal from rodata
-        auto& register_manager = RegisterManager::getInstance();
+        auto& register_manager = register_manager_;
         std::string result_reg = register_manager.get_free_register(*this);
         
         // Load the quad literal value
@@ -50,7 +50,7 @@ void NewCodeGenerator::visit(QuadExpression& node) {
     // Third expression goes into bits 32-47
     // Fourth expression goes into bits 48-63 (upper 16 bits)
     
-    auto& register_manager = RegisterManager::getInstance();
+    auto& register_manager = register_manager_;
     std::string result_reg = register_manager.get_free_register(*this);
     
     // Initialize result register to 0
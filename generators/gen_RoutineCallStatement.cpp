@@ -291,19 +291,8 @@ void NewCodeGenerator::visit(RoutineCallStatement& node) {
         } else {
             // --- Stage 5: Decide between direct and virtual call based on method_info ---
             if (method_info->is_virtual && !method_info->is_final) {
-                // Virtual call: vtable lookup
-                size_t vtable_offset = method_info->vtable_slot * 8;
-
-                std::string vtable_ptr_reg = register_manager_.acquire_scratch_reg(*this);
-                std::string method_addr_reg = register_manager_.acquire_scratch_reg(*this);
-
-                emit(Encoder::create_ldr_imm(vtable_ptr_reg, "X0", 0, "Load vtable pointer for method call"));
-                emit(Encoder::create_ldr_imm(method_addr_reg, vtable_ptr_reg, vtable_offset, "Load method address for " + member_access->member_name));
-                register_manager_.release_register(vtable_ptr_reg);
-
-                emit(Encoder::create_branch_with_link_register(method_addr_reg));
-                register_manager_.release_register(method_addr_reg);
-                register_manager_.invalidate_caller_saved_registers();
+                // Virtual call: direct when the receiver's class allows, else guarded vtable lookup
+                emit_method_dispatch(class_name, *method_info, member_access->exact_class_name);
             } else {
                 // Direct call for non-virtual or final methods
                 emit(Encoder::create_branch_with_link(method_info->qualified_name));
@@ -19,8 +19,9 @@ void NewCodeGenerator::visit(StringAllocationExpression& node) {
     auto& register_manager = register_manager_;
     register_manager.release_register(size_bytes_reg);
 
-    // 3. Call the runtime `BCPL_ALLOC_CHARS` function.
-    emit(Encoder::create_branch_with_link("BCPL_ALLOC_CHARS"));
+    // 3. Call the runtime `BCPL_ALLOC_CHARS` function, or its SAMM region
+    //    variant for strings RetainAnalysisPass proved scope-local.
+    emit(Encoder::create_branch_with_link(node.scope_local ? "BCPL_ALLOC_CHARS_SCOPED" : "BCPL_ALLOC_CHARS"));
     // `BCPL_ALLOC_CHARS` returns the allocated address in X0.
 
     // 4. The result of the allocation is the address in X0.
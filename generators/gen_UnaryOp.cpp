@@ -303,6 +303,11 @@ void NewCodeGenerator::visit(UnaryOp& node) {
             ldr_instr.nopeep = true; // Protect from peephole optimization
             emit(ldr_instr);
             register_manager_.release_register(base_addr_reg);
+            if (compact_strings_ || operand_type == VarType::POINTER_TO_STRING) {
+                // Drop a string's storage class and exact-length bits; no
+                // vector is long enough to have them.
+                emit(Encoder::opt_create_ubfx(dest_reg, dest_reg, 0, 61));
+            }
 
         } else if (
             operand_type == VarType::POINTER_TO_ANY_LIST ||
@@ -20,22 +20,25 @@ void NewCodeGenerator::visit(VecAllocationExpression& node) {
     register_manager.release_register(size_words_reg);
 
     // 3. Call the runtime `GETVEC` function using the veneer system.
-    if (veneer_manager_.has_veneer("GETVEC")) {
-        std::string veneer_label = veneer_manager_.get_veneer_label("GETVEC");
+    //    Vectors that RetainAnalysisPass proved scope-local come from the
+    //    SAMM region via GETVEC_SCOPED and are released at scope exit.
+    const std::string alloc_fn = node.scope_local ? "GETVEC_SCOPED" : "GETVEC";
+    if (veneer_manager_.has_veneer(alloc_fn)) {
+        std::string veneer_label = veneer_manager_.get_veneer_label(alloc_fn);
         Instruction bl_instr = Encoder::create_branch_with_link(veneer_label);
         bl_instr.jit_attribute = JITAttribute::JitCall;
-        bl_instr.target_label = "GETVEC";
+        bl_instr.target_label = alloc_fn;
         emit(bl_instr);
     } else {
         // Fallback to RuntimeManager method
-        size_t offset = RuntimeManager::instance().get_function_offset("GETVEC");
+        size_t offset = RuntimeManager::instance().get_function_offset(alloc_fn);
         std::string addr_reg = register_manager_.acquire_scratch_reg(*this);
         Instruction ldr_instr = Encoder::create_ldr_imm(addr_reg, "X19", offset);
         ldr_instr.jit_attribute = JITAttribute::JitAddress;
         emit(ldr_instr);
         Instruction blr_instr = Encoder::create_branch_with_link_register(addr_reg);
         blr_instr.jit_attribute = JITAttribute::JitCall;
-        blr_instr.target_label = "GETVEC";
+        blr_instr.target_label = alloc_fn;
         emit(blr_instr);
         register_manager_.release_register(addr_reg);
     }
@@ -53,7 +53,8 @@ void NewCodeGenerator::visit(VectorAccess& node) {
     auto& register_manager = register_manager_;
 
     // --- BOUNDS CHECKING ---
-    if (bounds_checking_enabled_) {
+    // Skipped when BoundsCheckEliminationPass proved the index in range or checked it before the loop
+    if (bounds_checking_enabled_ && !node.bounds_check_elided) {
         debug_print("Generating bounds check for vector access.");
         
         // Load vector length from offset -8 (stored just before the data)
@@ -78,20 +79,6 @@ void NewCodeGenerator::visit(VectorAccess& node) {
         debug_print("Bounds check generated.");
     }
 
-    // Calculate the byte offset: index * 8 (since BCPL words are 8 bytes)
-    // FIX: Copy index to temp register to avoid destructive modification
-    std::string offset_reg = register_manager.acquire_scratch_reg(*this);
-    emit(Encoder::create_mov_reg(offset_reg, index_reg));
-    emit(Encoder::create_lsl_imm(offset_reg, offset_reg, 3)); // LSL by 3 (left shift by 3 is multiply by 8)
-    debug_print("Calculated byte offset for vector access.");
-
-    // Add the offset to the base address to get the effective memory address
-    // ADD Xeff_addr, vector_base_reg, offset_reg
-    std::string effective_addr_reg = register_manager.get_free_register(*this);
-    emit(Encoder::create_add_reg(effective_addr_reg, vector_base_reg, offset_reg));
-    register_manager.release_register(vector_base_reg);
-    register_manager.release_register(index_reg);
-    register_manager.release_register(offset_reg);
     bool use_float_load = false;
 
     // 1. First, try the authoritative check using the AST Analyzer.
@@ -110,22 +97,25 @@ void NewCodeGenerator::visit(VectorAccess& node) {
         }
     }
 
+    // Load from base + index * 8 with one scaled register-offset access,
+    // leaving the index register untouched.
     if (use_float_load) {
         // It's a float vector, so use a floating-point load into a D register.
         std::string dest_reg = register_manager_.acquire_fp_scratch_reg();
-        Instruction ldr_instr = Encoder::create_ldr_fp_imm(dest_reg, effective_addr_reg, 0);
+        Instruction ldr_instr = Encoder::create_ldr_fp_scaled_reg(dest_reg, vector_base_reg, index_reg, 3);
         ldr_instr.nopeep = true; // Protect from peephole optimization
         emit(ldr_instr);
         expression_result_reg_ = dest_reg;
     } else {
         // It's an integer vector, so use the existing general-purpose load into an X register.
         std::string dest_reg = register_manager_.get_free_register(*this);
-        Instruction ldr_instr = Encoder::create_ldr_imm(dest_reg, effective_addr_reg, 0);
+        Instruction ldr_instr = Encoder::create_ldr_scaled_reg_64bit(dest_reg, vector_base_reg, index_reg, 3);
         ldr_instr.nopeep = true; // Protect from peephole optimization
         emit(ldr_instr);
         expression_result_reg_ = dest_reg;
     }
-    
-    register_manager_.release_register(effective_addr_reg);
+
+    register_manager.release_register(vector_base_reg);
+    register_manager.release_register(index_reg);
     debug_print("Finished visiting VectorAccess node.");
 }
@@ -105,7 +105,7 @@ std::string NewCodeGenerator::get_variable_register(const std::string& var_name)
 
     // We have a valid allocation plan for this variable.
     const LiveInterval& allocation = var_alloc_it->second;
-    std::string assigned_reg = allocation.assigned_register;
+    std::string assigned_reg = allocation.assigned_register_name();
 
     if (allocation.is_spilled) {
         debug_print("  [ALLOCATOR SPILLED] Variable '" + var_name + "' lives on the stack.");
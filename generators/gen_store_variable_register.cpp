@@ -57,9 +57,9 @@ void NewCodeGenerator::store_variable_register(const std::string& var_name, cons
         if (var_alloc_it != current_function_allocs.end()) {
             const LiveInterval& allocation = var_alloc_it->second;
 
-            if (!allocation.is_spilled && !allocation.assigned_register.empty()) {
+            if (!allocation.is_spilled && allocation.assigned_register) {
                 // The variable lives in a register. Move the value there.
-                const std::string& home_reg = allocation.assigned_register;
+                const std::string home_reg = allocation.assigned_register->name();
                 debug_print("  [ALLOCATOR HIT] Variable '" + var_name + "' lives in " + home_reg + ". Emitting MOV.");
                 if (value_reg != home_reg) {
                      // Check if this is a loop variable that needs extra protection
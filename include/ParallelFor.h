@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The number of threads parallel_for_worker uses for `count` items.
+inline size_t parallel_thread_count(size_t count, unsigned jobs) {
+    return (jobs <= 1 || count <= 1) ? 1 : std::min<size_t>(jobs, count);
+}
+
+// As parallel_for, but body(i, worker) is also given the index of the thread
+// running it, in [0, parallel_thread_count(count, jobs)), for state that is
+// built once per thread rather than once per item. The calling thread is
+// worker 0.
+template <typename Body>
+void parallel_for_worker(size_t count, unsigned jobs, Body body) {
+    size_t thread_count = parallel_thread_count(count, jobs);
+    if (thread_count == 1) {
+        for (size_t i = 0; i < count; ++i) body(i, 0);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto worker = [&](size_t w) {
+        for (size_t i = next++; i < count && !failed; i = next++) {
+            try {
+                body(i, w);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (size_t t = 1; t < thread_count; ++t) threads.emplace_back(worker, t);
+    worker(0); // the calling thread works too
+    for (auto& thread : threads) thread.join();
+
+    if (error) std::rethrow_exception(error);
+}
+
+// Runs body(i) for every i in [0, count) on up to `jobs` threads, used with
+// --jobs N for liveness, live intervals, register allocation and code
+// generation.
+//
+// Workers claim the next unclaimed index from a shared counter, so a few
+// large functions do not hold up the rest. The first exception thrown by any
+// body is rethrown on the calling thread once all workers have stopped.
+// With jobs <= 1 (or a single item) the loop runs inline, in order.
+template <typename Body>
+void parallel_for(size_t count, unsigned jobs, Body body) {
+    parallel_for_worker(count, jobs, [&](size_t i, size_t) { body(i); });
+}
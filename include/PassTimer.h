@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Wall-clock time per compiler pass, enabled with --time-passes.
+// main() calls mark() after each pass; the elapsed time since the previous
+// mark is charged to that pass. A disabled timer does nothing.
+class PassTimer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit PassTimer(bool enabled)
+        : enabled_(enabled), start_(Clock::now()), last_(start_) {}
+
+    void mark(const std::string& pass_name) {
+        if (!enabled_) return;
+        Clock::time_point now = Clock::now();
+        timings_.emplace_back(pass_name, std::chrono::duration<double, std::milli>(now - last_).count());
+        last_ = now;
+    }
+
+    void report(std::ostream& out = std::cerr) const {
+        if (!enabled_) return;
+        double total = std::chrono::duration<double, std::milli>(last_ - start_).count();
+        out << "\n=== Pass Timings ===\n";
+        for (const auto& timing : timings_) {
+            out << "  " << std::left << std::setw(28) << timing.first
+                << std::right << std::setw(10) << std::fixed << std::setprecision(2) << timing.second << " ms"
+                << std::setw(7) << std::setprecision(1)
+                << (total > 0.0 ? 100.0 * timing.second / total : 0.0) << "%\n";
+        }
+        out << "  " << std::left << std::setw(28) << "Total"
+            << std::right << std::setw(10) << std::fixed << std::setprecision(2) << total << " ms\n";
+    }
+
+private:
+    bool enabled_;
+    Clock::time_point start_;
+    Clock::time_point last_;
+    std::vector<std::pair<std::string, double>> timings_;
+};
@@ -1,6 +1,8 @@
 #ifndef COMPILER_INTERFACE_H
 #define COMPILER_INTERFACE_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -13,6 +15,8 @@ void initialize_freelist(void);
 typedef struct ListAtom ListAtom;
 ListAtom* getNodeFromFreelist(void);
 void returnNodeToFreelist(ListAtom* node);
+void returnNodeChainToFreelist(ListAtom* head, ListAtom* tail, size_t count);
+void returnNodeListToFreelist(ListAtom* head);
 
 // Freelist metrics
 void printFreelistMetrics(void);
@@ -2,9 +2,11 @@
 #include "LexerDebug.h"
 #include <cctype>
 
-Token Lexer::peek() const {
-    Lexer temp_lexer = *this;
-    return temp_lexer.get_next_token();
+const Token& Lexer::peek(size_t ahead) {
+    while (lookahead_.size() <= ahead) {
+        lookahead_.push_back(scan_token());
+    }
+    return lookahead_[ahead];
 }
 
 char Lexer::advance() {
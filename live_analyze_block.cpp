@@ -190,8 +190,8 @@ void LivenessAnalysisPass::collect_variable_uses(ASTNode* node, std::set<std::st
     
     if (auto* var_access = dynamic_cast<VariableAccess*>(node)) {
         if (symbol_table_) {
-            Symbol symbol;
-            if (symbol_table_->lookup(var_access->name, symbol) && symbol.is_variable()) {
+            const Symbol* symbol = symbol_table_->find(var_access->name);
+            if (symbol && symbol->is_variable()) {
                 vars.insert(var_access->name);
                 if (trace_enabled_) {
                     std::cout << "[LivenessAnalysisPass] Found variable use: " << var_access->name << std::endl;
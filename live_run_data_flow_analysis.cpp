@@ -1,98 +1,62 @@
 #include "LivenessAnalysisPass.h"
+#include "include/ParallelFor.h"
 #include <iostream>
 #include <exception>
+#include <deque>
+
+namespace {
+
+inline size_t popcount_bits(const std::vector<uint64_t>& bits) {
+    size_t count = 0;
+    for (uint64_t word : bits) count += static_cast<size_t>(__builtin_popcountll(word));
+    return count;
+}
+
+inline void set_bit(std::vector<uint64_t>& bits, uint32_t id) {
+    bits[id >> 6] |= uint64_t(1) << (id & 63);
+}
+
+inline const std::set<std::string>& sets_for(const std::map<BasicBlock*, std::set<std::string>>& sets,
+                                             BasicBlock* block, const std::set<std::string>& empty) {
+    auto it = sets.find(block);
+    return it == sets.end() ? empty : it->second;
+}
+
+} // namespace
 
 void LivenessAnalysisPass::run_data_flow_analysis() {
     if (trace_enabled_) {
         std::cout << "[LivenessAnalysisPass] Entering run_data_flow_analysis()" << std::endl;
     }
-    bool changed = true;
-    int iteration = 0;
     try {
-        while (changed) {
-            changed = false;
-            iteration++;
-            if (trace_enabled_) {
-                std::cout << "[LivenessAnalysisPass] Data-flow iteration " << iteration << std::endl;
-            }
-            for (const auto& cfg_pair : cfgs_) {
-                if (!cfg_pair.second) {
-                    if (trace_enabled_) {
-                        std::cout << "[LivenessAnalysisPass] Warning: CFG for function '" << cfg_pair.first << "' is null (data flow)." << std::endl;
-                    }
-                    continue;
-                }
-                // Use reverse post-order (RPO) for efficient convergence
-                const auto& blocks_in_rpo = cfg_pair.second->get_blocks_in_rpo();
-                for (auto it = blocks_in_rpo.rbegin(); it != blocks_in_rpo.rend(); ++it) {
-                    BasicBlock* b = *it;
-                    if (!b) {
-                        if (trace_enabled_) {
-                            std::cout << "[LivenessAnalysisPass] Warning: Null BasicBlock in function '" << cfg_pair.first << "' (data flow)." << std::endl;
-                        }
-                        continue;
-                    }
-
-                    if (trace_enabled_) {
-                        std::cout << "[LivenessAnalysisPass] Processing block: " << b->id << " in function: " << cfg_pair.first << std::endl;
-                    }
-
-                    // 1. Calculate out[B] = U in[S] for all successors S
-                    std::set<std::string> new_out_set;
-                    for (BasicBlock* successor : b->successors) {
-                        if (!successor) {
-                            if (trace_enabled_) {
-                                std::cout << "[LivenessAnalysisPass] Warning: Null successor in block " << b->id << std::endl;
-                            }
-                            continue;
-                        }
-                        new_out_set.insert(in_sets_[successor].begin(), in_sets_[successor].end());
-                    }
-                    out_sets_[b] = new_out_set;
-
-                    // 2. Calculate in[B] = use[B] U (out[B] - def[B])
-                    // CALL INTERVAL FIX: For blocks containing function calls,
-                    // augment use[B] with variables used across calls within the block
-                    // to force them into callee-saved registers
-                    std::set<std::string> effective_use_set = use_sets_[b];
-                    if (blocks_with_calls_.count(b)) {
-                        // First, add live-out variables (original fix)
-                        effective_use_set.insert(new_out_set.begin(), new_out_set.end());
-                        
-                        // Second, add variables specifically identified as used across calls
-                        if (vars_used_across_calls_per_block_.count(b)) {
-                            const auto& vars_across_calls = vars_used_across_calls_per_block_[b];
-                            effective_use_set.insert(vars_across_calls.begin(), vars_across_calls.end());
-                            if (trace_enabled_) {
-                                std::cout << "[LivenessAnalysisPass] Applying call interval fix to block " 
-                                          << b->id << " - adding " << new_out_set.size() 
-                                          << " live-out variables and " << vars_across_calls.size()
-                                          << " intra-statement call variables to use set" << std::endl;
-                            }
-                        } else {
-                            if (trace_enabled_) {
-                                std::cout << "[LivenessAnalysisPass] Applying call interval fix to block " 
-                                          << b->id << " - adding " << new_out_set.size() 
-                                          << " live-out variables to use set" << std::endl;
-                            }
-                        }
-                    }
-                    
-                    std::set<std::string> out_minus_def = out_sets_[b];
-                    for (const auto& def_var : def_sets_[b]) {
-                        out_minus_def.erase(def_var);
-                    }
-                    
-                    std::set<std::string> new_in_set = effective_use_set;
-                    new_in_set.insert(out_minus_def.begin(), out_minus_def.end());
-
-                    // Check if the 'in' set has changed
-                    if (in_sets_[b] != new_in_set) {
-                        in_sets_[b] = new_in_set;
-                        changed = true;
-                    }
+        function_liveness_.clear();
+        in_sets_.clear();
+        out_sets_.clear();
+
+        // Functions are independent: solve them on up to jobs_ threads, each
+        // into its own slot, then merge in a fixed order.
+        std::vector<std::pair<const std::string*, const ControlFlowGraph*>> functions;
+        for (const auto& cfg_pair : cfgs_) {
+            if (!cfg_pair.second) {
+                if (trace_enabled_) {
+                    std::cout << "[LivenessAnalysisPass] Warning: CFG for function '" << cfg_pair.first << "' is null (data flow)." << std::endl;
                 }
+                continue;
             }
+            functions.emplace_back(&cfg_pair.first, cfg_pair.second.get());
+        }
+
+        std::vector<FunctionLiveness> results(functions.size());
+        std::vector<LivenessSets> in_results(functions.size());
+        std::vector<LivenessSets> out_results(functions.size());
+        parallel_for(functions.size(), trace_enabled_ ? 1 : jobs_, [&](size_t i) {
+            solve_function(*functions[i].first, *functions[i].second, results[i], in_results[i], out_results[i]);
+        });
+
+        for (size_t i = 0; i < functions.size(); ++i) {
+            function_liveness_.emplace(*functions[i].first, std::move(results[i]));
+            in_sets_.insert(in_results[i].begin(), in_results[i].end());
+            out_sets_.insert(out_results[i].begin(), out_results[i].end());
         }
     } catch (const std::exception& ex) {
         std::cerr << "[LivenessAnalysisPass] Exception in run_data_flow_analysis: " << ex.what() << std::endl;
@@ -105,3 +69,149 @@ void LivenessAnalysisPass::run_data_flow_analysis() {
         std::cout << "[LivenessAnalysisPass] Exiting run_data_flow_analysis()" << std::endl;
     }
 }
+
+void LivenessAnalysisPass::solve_function(const std::string& func_name, const ControlFlowGraph& cfg,
+                                          FunctionLiveness& fl, LivenessSets& in_sets, LivenessSets& out_sets) const {
+
+    // Post-order (reverse of RPO) is the natural order for a backward problem
+    std::vector<BasicBlock*> blocks;
+    const auto blocks_in_rpo = cfg.get_blocks_in_rpo();
+    for (auto it = blocks_in_rpo.rbegin(); it != blocks_in_rpo.rend(); ++it) {
+        if (!*it) {
+            if (trace_enabled_) {
+                std::cout << "[LivenessAnalysisPass] Warning: Null BasicBlock in function '" << func_name << "' (data flow)." << std::endl;
+            }
+            continue;
+        }
+        fl.block_index.emplace(*it, blocks.size());
+        blocks.push_back(*it);
+    }
+    const size_t num_blocks = blocks.size();
+
+    // 1. Number this function's variables densely
+    auto intern = [&fl](const std::set<std::string>& vars) {
+        for (const auto& name : vars) {
+            if (fl.var_ids.emplace(name, static_cast<uint32_t>(fl.var_names.size())).second) {
+                fl.var_names.push_back(name);
+            }
+        }
+    };
+    for (BasicBlock* b : blocks) {
+        intern(sets_for(use_sets_, b, empty_set_));
+        intern(sets_for(def_sets_, b, empty_set_));
+        auto across = vars_used_across_calls_per_block_.find(b);
+        if (across != vars_used_across_calls_per_block_.end()) intern(across->second);
+    }
+    const size_t words = (fl.var_names.size() + 63) / 64;
+
+    // 2. gen/kill per block: in[B] = gen[B] | (out[B] & ~kill[B])
+    // CALL INTERVAL FIX: blocks containing calls treat every live-out variable
+    // (and every variable used across a call inside the block) as used, forcing
+    // them into callee-saved registers. That is in[B] = use | across | out,
+    // i.e. an empty kill set.
+    std::vector<LiveBits> gen(num_blocks, LiveBits(words, 0));
+    std::vector<LiveBits> kill(num_blocks, LiveBits(words, 0));
+    for (size_t i = 0; i < num_blocks; ++i) {
+        BasicBlock* b = blocks[i];
+        for (const auto& name : sets_for(use_sets_, b, empty_set_)) set_bit(gen[i], fl.var_ids[name]);
+        if (blocks_with_calls_.count(b)) {
+            auto across = vars_used_across_calls_per_block_.find(b);
+            if (across != vars_used_across_calls_per_block_.end()) {
+                for (const auto& name : across->second) set_bit(gen[i], fl.var_ids[name]);
+            }
+            if (trace_enabled_) {
+                std::cout << "[LivenessAnalysisPass] Applying call interval fix to block " << b->id << std::endl;
+            }
+        } else {
+            for (const auto& name : sets_for(def_sets_, b, empty_set_)) set_bit(kill[i], fl.var_ids[name]);
+        }
+    }
+
+    // Successor/predecessor indices within the reachable blocks
+    std::vector<std::vector<size_t>> succs(num_blocks), preds(num_blocks);
+    for (size_t i = 0; i < num_blocks; ++i) {
+        for (BasicBlock* successor : blocks[i]->successors) {
+            auto it = successor ? fl.block_index.find(successor) : fl.block_index.end();
+            if (it == fl.block_index.end()) {
+                if (trace_enabled_ && !successor) {
+                    std::cout << "[LivenessAnalysisPass] Warning: Null successor in block " << blocks[i]->id << std::endl;
+                }
+                continue;
+            }
+            succs[i].push_back(it->second);
+            preds[it->second].push_back(i);
+        }
+    }
+
+    // 3. Worklist iteration: only predecessors of a block whose in-set
+    // changed are revisited.
+    fl.in_bits.assign(num_blocks, LiveBits(words, 0));
+    fl.out_bits.assign(num_blocks, LiveBits(words, 0));
+    std::deque<size_t> worklist;
+    std::vector<char> queued(num_blocks, 1);
+    for (size_t i = 0; i < num_blocks; ++i) worklist.push_back(i);
+
+    LiveBits new_in(words);
+    size_t visits = 0;
+    while (!worklist.empty()) {
+        size_t i = worklist.front();
+        worklist.pop_front();
+        queued[i] = 0;
+        ++visits;
+
+        LiveBits& out = fl.out_bits[i];
+        std::fill(out.begin(), out.end(), 0);
+        for (size_t s : succs[i]) {
+            const LiveBits& succ_in = fl.in_bits[s];
+            for (size_t w = 0; w < words; ++w) out[w] |= succ_in[w];
+        }
+
+        bool changed = false;
+        LiveBits& in = fl.in_bits[i];
+        for (size_t w = 0; w < words; ++w) {
+            new_in[w] = gen[i][w] | (out[w] & ~kill[i][w]);
+            changed |= new_in[w] != in[w];
+        }
+        if (changed) {
+            in.swap(new_in);
+            new_in.assign(words, 0);
+            for (size_t p : preds[i]) {
+                if (!queued[p]) {
+                    queued[p] = 1;
+                    worklist.push_back(p);
+                }
+            }
+        }
+    }
+
+    if (trace_enabled_) {
+        std::cout << "[LivenessAnalysisPass] Function '" << func_name << "': " << num_blocks << " blocks, "
+                  << fl.var_names.size() << " variables, " << visits << " block visits" << std::endl;
+    }
+
+    // 4. String views for get_in_set/get_out_set
+    auto to_set = [&fl, words](const LiveBits& bits) {
+        std::set<std::string> names;
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t word = bits[w];
+            while (word) {
+                unsigned bit = static_cast<unsigned>(__builtin_ctzll(word));
+                names.insert(fl.var_names[w * 64 + bit]);
+                word &= word - 1;
+            }
+        }
+        return names;
+    };
+    for (size_t i = 0; i < num_blocks; ++i) {
+        in_sets[blocks[i]] = to_set(fl.in_bits[i]);
+        out_sets[blocks[i]] = to_set(fl.out_bits[i]);
+    }
+}
+
+size_t LivenessAnalysisPass::live_count(const std::string& func_name, BasicBlock* block, bool live_out) const {
+    auto fit = function_liveness_.find(func_name);
+    if (fit == function_liveness_.end()) return 0;
+    auto bit = fit->second.block_index.find(block);
+    if (bit == fit->second.block_index.end()) return 0;
+    return popcount_bits(live_out ? fit->second.out_bits[bit->second] : fit->second.in_bits[bit->second]);
+}
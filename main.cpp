@@ -18,6 +18,7 @@
 #include <iostream>
 #include "HeapManager/HeapManager.h"
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 #include "HeapManager/heap_manager_defs.h"
@@ -38,6 +39,10 @@
 #include <unistd.h>
 #include "ClassTable.h"
 #include "SymbolTable.h" // Added for stack canary control
+#include "include/PassTimer.h"
+#include "include/ParallelFor.h"
+#include "CompilationCache.h"
+#include "ObjectWriter.h"
 #include "runtime/BCPLError.h"
 
 // --- Project Headers ---
@@ -74,8 +79,12 @@
 #include "passes/GlobalInitializerPass.h"
 #include "LivenessAnalysisPass.h"
 #include "passes/MethodInliningPass.h"
+#include "passes/FunctionInliningPass.h"
 #include "CFGBuilderPass.h"
 #include "passes/CFGSimplificationPass.h"
+#include "passes/BoundsCheckEliminationPass.h"
+#include "passes/LoopVectorizationPass.h"
+#include "passes/DevirtualizationPass.h"
 #include "BoundsCheckingPass.h"  // Re-enabled bounds checking pass
 #include "CreateMethodReorderPass.h"  // Fix call interval bug in CREATE methods
 #include "HeapManager/HeapManager.h"
@@ -171,13 +180,15 @@ bool parse_arguments(int argc, char* argv[], bool& run_jit, bool& generate_asm,
                     bool& dump_jit_stack, bool& enable_peephole, bool& enable_stack_canaries,
                     bool& format_code, bool& trace_class_table, bool& trace_vtables,
                     bool& bounds_checking_enabled, bool& enable_samm, bool& enable_superdisc,
-                    bool& use_neon, bool& generate_list, bool& test_encoders,
+                    bool& enable_inlining, bool& use_neon, bool& fast_float_reductions, bool& compact_strings, bool& generate_list, bool& test_encoders,
                     bool& test_encode, std::string& test_encode_name, bool& list_encoders, bool& list_runtime,
                     std::string& runtime_category_filter, std::string& input_filepath, std::string& call_entry_name, int& offset_instructions,
-                    std::vector<std::string>& include_paths, std::string& runtime_mode);
+                    std::vector<std::string>& include_paths, std::string& runtime_mode, bool& time_passes, unsigned& jobs, unsigned& codegen_jobs,
+                    bool& use_cache, std::string& cache_dir);
 void handle_static_compilation(bool exec_mode, const std::string& base_name, const InstructionStream& instruction_stream, const DataGenerator& data_generator, bool enable_debug_output, const std::string& runtime_mode, const VeneerManager& veneer_manager, bool generate_list, const std::string& initial_working_dir);
 void* handle_jit_compilation(void* jit_data_memory_base, InstructionStream& instruction_stream, int offset_instructions, bool enable_debug_output, std::vector<Instruction>* finalized_instructions = nullptr);
 void handle_jit_execution(void* code_buffer_base, const std::string& call_entry_name, bool dump_jit_stack, bool enable_debug_output);
+int run_cached_program(CompilationCache::Entry& entry, bool run_jit, bool generate_asm, bool exec_mode, bool generate_list, const std::string& input_filepath, const std::string& runtime_mode, const std::string& call_entry_name, bool dump_jit_stack, const std::string& initial_working_dir);
 
 // =================================================================================
 // Main Execution Pipeline
@@ -205,6 +216,7 @@ int main(int argc, char* argv[]) {
     bool enable_stack_canaries = false;  // Disabled by default
     bool enable_samm = true;  // SAMM enabled by default to prevent memory leaks
     bool enable_superdisc = true; // CREATE Method Reordering Pass enabled by default
+    bool enable_inlining = true; // Cost-model function inlining (under --opt)
 
     // Granular tracing flags for different compiler passes
     bool trace_lexer = false;
@@ -229,6 +241,8 @@ int main(int argc, char* argv[]) {
     bool format_code = false; // Add this flag
     bool bounds_checking_enabled = true; // Runtime bounds checking enabled by default
     bool use_neon = true; // NEON SIMD instructions enabled by default
+    bool fast_float_reductions = false; // Vectorized float sums reassociate; opt-in only
+    bool compact_strings = false; // One byte per character for Latin-1 runtime strings
     bool generate_list = false; // Generate listing file with hex opcodes
     bool test_encoders = false; // Encoder validation testing mode
     bool test_encode = false; // Individual encoder testing mode
@@ -236,6 +250,11 @@ int main(int argc, char* argv[]) {
     bool list_encoders = false; // List available encoders mode
     bool list_runtime = false; // List available runtime functions mode
     std::string runtime_category_filter; // Filter runtime functions by category
+    bool time_passes = false; // Report wall-clock time per compiler pass
+    unsigned jobs = 1; // Threads for liveness, live intervals and register allocation
+    unsigned codegen_jobs = 1; // Threads for code generation (--jobs N)
+    bool use_cache = true; // On-disk compilation cache (see CompilationCache.h)
+    std::string cache_dir; // Empty: $NEWBCPL_CACHE_DIR or ~/.cache/newbcpl
 
     if (enable_tracing) {
         std::cout << "Debug: About to parse arguments\n";
@@ -250,9 +269,10 @@ int main(int argc, char* argv[]) {
                             trace_class_table,
                             trace_vtables,
                             bounds_checking_enabled, enable_samm,
-                            enable_superdisc, use_neon, generate_list, test_encoders,
+                            enable_superdisc, enable_inlining, use_neon, fast_float_reductions, compact_strings, generate_list, test_encoders,
                             test_encode, test_encode_name, list_encoders, list_runtime,
-                            runtime_category_filter, input_filepath, call_entry_name, offset_instructions, include_paths, runtime_mode)) {
+                            runtime_category_filter, input_filepath, call_entry_name, offset_instructions, include_paths, runtime_mode, time_passes, jobs, codegen_jobs,
+                            use_cache, cache_dir)) {
             if (enable_tracing) {
                 std::cout << "Debug: parse_arguments returned false\n";
             }
@@ -423,10 +443,14 @@ int main(int argc, char* argv[]) {
     g_enable_symbols_trace = enable_tracing || trace_symbols;
     bool enable_debug_output = enable_tracing || trace_codegen; // <-- Declare as local variable
     HeapManager::getInstance().setTraceEnabled(enable_tracing || trace_heap);
+    // --trace-heap also opts into the Bloom filter double-free diagnostics
+    HeapManager::getInstance().setBloomFilterEnabled(trace_heap);
 
     // SAMM (heap manager) is used by JIT code, not the compiler itself
     // Enable SAMM (Scope Aware Memory Management) - enabled by default
     HeapManager::getInstance().setSAMMEnabled(enable_samm);
+    // Compact strings are made by the runtime; compiled code must expect them
+    bcpl_set_compact_strings(compact_strings);
     if (enable_tracing || trace_heap) {
         std::cout << "SAMM (Scope Aware Memory Management): " << (enable_samm ? "ENABLED" : "DISABLED") << std::endl;
     }
@@ -453,9 +477,14 @@ int main(int argc, char* argv[]) {
     SignalHandler::setup();
 
     try {
+        PassTimer pass_timer(time_passes);
         if (enable_preprocessor) {
             Preprocessor preprocessor;
             preprocessor.enableDebug(trace_preprocessor);
+            if (use_cache) {
+                // Expanded sources are kept beside the compiled programs
+                preprocessor.setCacheDirectory(CompilationCache(cache_dir).directory());
+            }
 
             // Add any include paths specified on command line
             for (const auto& path : include_paths) {
@@ -474,6 +503,44 @@ int main(int argc, char* argv[]) {
             g_source_code = read_file_content(input_filepath);
         }
 
+        pass_timer.mark("Preprocess");
+
+        // --- Compilation cache ---
+        // The key covers the preprocessed source (including every GET'd file),
+        // the compiler version (in the key itself), the runtime API and the
+        // options that change the generated code. Tracing always compiles.
+        std::unique_ptr<CompilationCache> compilation_cache;
+        CompilationCache::Key cache_key;
+        bool any_tracing = enable_tracing || trace_lexer || trace_parser || trace_ast || trace_cfg ||
+                           trace_codegen || trace_optimizer || trace_liveness || trace_runtime ||
+                           trace_symbols || trace_heap || trace_class_table || trace_vtables;
+        if (use_cache && !any_tracing && !format_code && (run_jit || generate_asm || exec_mode || generate_list)) {
+            int manifest_count = 0;
+            const RuntimeFunctionDescriptor* manifest = get_runtime_manifest(manifest_count);
+            std::ostringstream codegen_flags;
+            codegen_flags << "runtime-api=" << get_runtime_api_version()
+                          << " jit=" << run_jit << " opt=" << enable_opt << " peep=" << enable_peephole
+                          << " canaries=" << enable_stack_canaries << " samm=" << enable_samm
+                          << " superdisc=" << enable_superdisc << " inline=" << enable_inlining
+                          << " bounds=" << bounds_checking_enabled
+                          << " neon=" << use_neon << " fast-float-reductions=" << fast_float_reductions
+                          << " compact=" << compact_strings << "\nruntime:";
+            for (int i = 0; i < manifest_count; ++i) {
+                codegen_flags << ' ' << manifest[i].veneer_name << '/' << manifest[i].arg_count;
+            }
+            compilation_cache = std::make_unique<CompilationCache>(cache_dir);
+            cache_key = CompilationCache::make_key(g_source_code, codegen_flags.str());
+
+            CompilationCache::Entry cached_program;
+            if (compilation_cache->load(cache_key, cached_program)) {
+                pass_timer.mark("Cache hit");
+                pass_timer.report();
+                return run_cached_program(cached_program, run_jit, generate_asm, exec_mode, generate_list, input_filepath,
+                                          runtime_mode, call_entry_name, dump_jit_stack, initial_working_dir);
+            }
+            pass_timer.mark("Cache lookup");
+        }
+
         if (enable_tracing) {
             std::cout << "Compiling this source Code:\n" << g_source_code << std::endl;
         }
@@ -512,6 +579,7 @@ int main(int argc, char* argv[]) {
         if (enable_tracing || trace_parser) {
             std::cout << "Parsing complete. AST built.\n";
         }
+        pass_timer.mark("Lex + parse");
 
 
         // --- RETAIN Analysis Pass ---
@@ -519,7 +587,12 @@ int main(int argc, char* argv[]) {
             RetainAnalysisPass retain_pass;
             SymbolTable* symbol_table = new SymbolTable();
             retain_pass.run(*ast, *symbol_table);
+            if (enable_tracing) {
+                std::cout << "RETAIN analysis: " << retain_pass.getScopeLocalAllocationCount()
+                          << " scope-local allocation(s)\n";
+            }
         }
+        pass_timer.mark("RETAIN analysis");
 
         // --- Create tables once in main ---
         auto symbol_table = std::make_unique<SymbolTable>();
@@ -537,6 +610,7 @@ int main(int argc, char* argv[]) {
         ClassPass class_pass(*class_table, *symbol_table);
         class_pass.set_debug(trace_class_table);  // Enable debug output only if trace_class_table is set
         class_pass.run(*ast);
+        pass_timer.mark("Runtime import + classes");
 
         if (trace_class_table) {
             dump_class_table(*class_table);
@@ -582,6 +656,7 @@ int main(int argc, char* argv[]) {
         if (enable_tracing || trace_symbols) std::cout << "Building symbol table...\n";
         SymbolDiscoveryPass symbol_discovery_pass(enable_tracing || trace_symbols);
         symbol_discovery_pass.build_into(*ast, *symbol_table, *class_table);
+        pass_timer.mark("Manifests + symbol discovery");
 
         // --- DEBUG: Dump symbol table after symbol discovery ---
         if (enable_tracing || trace_symbols) {
@@ -647,6 +722,21 @@ int main(int argc, char* argv[]) {
 if (enable_tracing || trace_ast) std::cout << "Pass 1: Analyzing function signatures...\n";
 SignatureAnalysisVisitor signature_visitor(symbol_table.get(), analyzer, enable_tracing || trace_ast);
 signature_visitor.analyze_signatures(*ast);
+pass_timer.mark("AST optimization + signatures");
+
+// Function inlining: small FUNCTIONs/ROUTINEs copied into their callers.
+// Needs the parameter types from signature analysis; the copied LETs are
+// picked up by the full analysis below.
+if (enable_opt && enable_inlining) {
+    FunctionInliningPass inlining_pass(
+        g_global_manifest_constants,
+        symbol_table.get(),
+        analyzer,
+        enable_tracing || trace_optimizer
+    );
+    ast = inlining_pass.apply(std::move(ast));
+    pass_timer.mark("Function inlining");
+}
 
 // Loop-Invariant Code Motion Pass (LICM)
 // - run after signature analysis so function metrics exist
@@ -691,6 +781,7 @@ if (enable_tracing || trace_ast) {
 }
 
 analyzer.analyze(*ast, symbol_table.get(), class_table.get());
+pass_timer.mark("LICM + AST analysis");
 
 // Check for semantic errors after analysis
 // early exit, fail fast
@@ -744,6 +835,7 @@ if (enable_tracing || trace_ast) {
 // transfor AST
 analyzer.transform(*ast);
 if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
+pass_timer.mark("Lifting + local opt + transform");
 
         // --- CREATE METHOD REORDERING PASS ---
         // Kludge to avoid interval bug in super call
@@ -771,6 +863,7 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
             }
             if (enable_tracing) std::cout << "Compile-time bounds checking complete.\n";
         }
+        pass_timer.mark("CREATE reorder + bounds check");
 
         // AST -> CFG call flow graph builder
         if (enable_tracing || trace_cfg) std::cout << "Building Control Flow Graphs...\n";
@@ -800,6 +893,30 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
             cfg_simplification_pass.run(const_cast<std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>&>(cfg_builder.get_cfgs()));
         }
 
+        // --- Devirtualization Pass (receivers of exactly known class) ---
+        if (enable_opt) {
+            if (enable_tracing || trace_cfg) std::cout << "Applying Devirtualization Pass...\n";
+            DevirtualizationPass devirtualization_pass(symbol_table.get(), class_table.get(), enable_tracing || trace_cfg);
+            devirtualization_pass.run(const_cast<std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>&>(cfg_builder.get_cfgs()));
+        }
+
+        // --- Bounds Check Elimination Pass (FOR loop ranges) ---
+        if (enable_opt && bounds_checking_enabled) {
+            if (enable_tracing || trace_cfg) std::cout << "Applying Bounds Check Elimination Pass...\n";
+            BoundsCheckEliminationPass bounds_check_elimination_pass(symbol_table.get(), enable_tracing || trace_cfg);
+            bounds_check_elimination_pass.run(const_cast<std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>&>(cfg_builder.get_cfgs()));
+        }
+
+        // --- Loop Vectorization Pass (NEON bodies for FOR loops over VECs) ---
+        // Runs after bounds check elimination: only reads without a check vectorize
+        if (enable_opt && use_neon) {
+            if (enable_tracing || trace_cfg) std::cout << "Applying Loop Vectorization Pass...\n";
+            LoopVectorizationPass loop_vectorization_pass(symbol_table.get(), bounds_checking_enabled, enable_tracing || trace_cfg,
+                                                          fast_float_reductions);
+            loop_vectorization_pass.run(const_cast<std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>&>(cfg_builder.get_cfgs()));
+        }
+        pass_timer.mark("CFG build");
+
 
         // --- SECOND LIVENESS ANALYSIS (after cleanup blocks) ---
         // Re-run Liveness Analysis and LiveIntervalPass on the MODIFIED CFG.
@@ -811,7 +928,9 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
 
         // Liveness
         LivenessAnalysisPass final_liveness_analyzer(cfg_builder.get_cfgs(), symbol_table.get(), enable_tracing || trace_liveness);
+        final_liveness_analyzer.set_jobs(jobs);
         final_liveness_analyzer.run();
+        pass_timer.mark("Liveness");
 
         if (enable_tracing || trace_liveness) {
             final_liveness_analyzer.print_results();
@@ -861,34 +980,41 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
             std::cout << "\n[INFO] Building Live Intervals for all functions...\n";
         }
         LiveIntervalPass interval_pass(symbol_table.get(), enable_tracing || trace_liveness);
-        for (const auto& pair : cfg_builder.get_cfgs()) {
-            interval_pass.run(*pair.second, final_liveness_analyzer, pair.first);
-        }
+        interval_pass.runAll(cfg_builder.get_cfgs(), final_liveness_analyzer, jobs);
 
         // Create the register allocator and the master allocation map here, BEFORE code generation.
         if (enable_tracing || trace_codegen) {
             std::cout << "\n[INFO] Performing Linear Scan Register Allocation for ALL functions...\n";
         }
-        LinearScanAllocator register_allocator(analyzer, enable_tracing || trace_codegen);
         std::map<std::string, std::map<std::string, LiveInterval>> all_allocations;
 
-        // Iterate through all functions and allocate registers for each one.
-        for (const auto& pair : cfg_builder.get_cfgs()) {
-            const std::string& func_name = pair.first;
-            const auto& intervals = interval_pass.getIntervalsFor(func_name);
-
-            // CRITICAL FIX: Only use true variable registers for variable allocation
-            // Scratch registers (X9-X15) must be reserved exclusively for scratch allocation
-            std::vector<std::string> all_int_regs = RegisterManager::VARIABLE_REGS;  // Callee-saved (X19-X27) only
-
-            std::vector<std::string> all_fp_regs = RegisterManager::FP_VARIABLE_REGS;  // Callee-saved (D8-D15) only
+        // CRITICAL FIX: Only use true variable registers for variable allocation
+        // Scratch registers (X9-X15) must be reserved exclusively for scratch allocation
+        const std::vector<std::string>& all_int_regs = RegisterManager::VARIABLE_REGS;  // Callee-saved (X19-X27) only
+        const std::vector<std::string>& all_fp_regs = RegisterManager::FP_VARIABLE_REGS;  // Callee-saved (D8-D15) only
 
-            // The result of each allocation is stored in the master map.
-            all_allocations[func_name] = register_allocator.allocate(
-                intervals, all_int_regs, all_fp_regs, func_name
+        // Allocate each function independently (one allocator per task, since
+        // the allocator keeps per-run state), then collect the results in a
+        // fixed order so the output does not depend on --jobs.
+        std::vector<const std::string*> allocation_order;
+        for (const auto& pair : cfg_builder.get_cfgs()) {
+            allocation_order.push_back(&pair.first);
+        }
+        std::vector<std::map<std::string, LiveInterval>> function_allocations(allocation_order.size());
+        bool trace_allocation = enable_tracing || trace_codegen || trace_ast;
+        parallel_for(allocation_order.size(), trace_allocation ? 1 : jobs, [&](size_t i) {
+            const std::string& func_name = *allocation_order[i];
+            LinearScanAllocator register_allocator(analyzer, enable_tracing || trace_codegen);
+            function_allocations[i] = register_allocator.allocate(
+                interval_pass.getIntervalsFor(func_name), all_int_regs, all_fp_regs, func_name
             );
+        });
+        for (size_t i = 0; i < allocation_order.size(); ++i) {
+            all_allocations[*allocation_order[i]] = std::move(function_allocations[i]);
         }
 
+        pass_timer.mark("Live intervals + allocation");
+
         // --- SYNC REGISTER MANAGER WITH ALLOCATOR DECISIONS ---
         // This ensures RegisterManager knows which registers are reserved by LinearScanAllocator
         // and prevents scratch register allocation from trampling on variable registers
@@ -956,6 +1082,8 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
             bounds_checking_enabled, // Pass bounds checking flag
             use_neon // Pass NEON flag
         );
+        code_generator.set_compact_strings(compact_strings);
+        code_generator.set_codegen_jobs((enable_tracing || trace_codegen || trace_ast) ? 1 : codegen_jobs);
 
         // --- Initialize veneer manager
         // creates veneers for runtime calls before START
@@ -968,6 +1096,7 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
         // Emit all interned strings after code generation
         data_generator.emit_interned_strings();
         if (enable_tracing || trace_codegen) std::cout << "Code generation complete.\n";
+        pass_timer.mark("Code generation");
 
         // --- Print symbol table after code generation ---
         if (enable_tracing || trace_symbols || trace_codegen) {
@@ -983,6 +1112,14 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
             PeepholeOptimizer peephole_optimizer(enable_tracing || trace_codegen);
             peephole_optimizer.optimize(instruction_stream);
         }
+        pass_timer.mark("Peephole");
+
+        if (compilation_cache) {
+            compilation_cache->store(cache_key, instruction_stream.get_instructions_ref(),
+                                     code_generator.get_veneer_manager().get_veneer_labels());
+            pass_timer.mark("Cache store");
+        }
+        pass_timer.report();
 
 
 
@@ -1074,10 +1211,11 @@ bool parse_arguments(int argc, char* argv[], bool& run_jit, bool& generate_asm,
                     bool& dump_jit_stack, bool& enable_peephole, bool& enable_stack_canaries,
                     bool& format_code, bool& trace_class_table, bool& trace_vtables,
                     bool& bounds_checking_enabled, bool& enable_samm,
-                    bool& enable_superdisc, bool& use_neon, bool& generate_list, bool& test_encoders,
+                    bool& enable_superdisc, bool& enable_inlining, bool& use_neon, bool& fast_float_reductions, bool& compact_strings, bool& generate_list, bool& test_encoders,
                     bool& test_encode, std::string& test_encode_name, bool& list_encoders, bool& list_runtime,
                     std::string& runtime_category_filter, std::string& input_filepath, std::string& call_entry_name, int& offset_instructions,
-                    std::vector<std::string>& include_paths, std::string& runtime_mode) {
+                    std::vector<std::string>& include_paths, std::string& runtime_mode, bool& time_passes, unsigned& jobs, unsigned& codegen_jobs,
+                    bool& use_cache, std::string& cache_dir) {
     if (enable_tracing) {
         std::cout << "Debug: Entering parse_arguments with argc=" << argc << std::endl;
         std::cout << "Debug: Iterating through " << argc << " arguments\n";
@@ -1117,7 +1255,24 @@ bool parse_arguments(int argc, char* argv[], bool& run_jit, bool& generate_asm,
         else if (arg == "--noSAMM") enable_samm = false;
         else if (arg == "--no-opt") enable_opt = false;
         else if (arg == "--no-superdisc") enable_superdisc = false;
+        else if (arg == "--no-inline") enable_inlining = false;
         else if (arg == "--no-neon") use_neon = false;
+        else if (arg == "--fast-float-reductions") fast_float_reductions = true;
+        else if (arg == "--compact-strings") compact_strings = true;
+        else if (arg == "--time-passes") time_passes = true;
+        else if (arg == "--jobs" || arg == "--analysis-jobs") {
+            if (i + 1 < argc) {
+                try { jobs = static_cast<unsigned>(std::stoul(argv[++i])); }
+                catch (const std::exception&) { std::cerr << "Error: Invalid value for " << arg << ": " << argv[i] << std::endl; return false; }
+                if (jobs == 0) jobs = std::max(1u, std::thread::hardware_concurrency());
+                if (arg == "--jobs") codegen_jobs = jobs;
+            } else { std::cerr << "Error: " << arg << " option requires a thread count." << std::endl; return false; }
+        }
+        else if (arg == "--no-cache") use_cache = false;
+        else if (arg == "--cache-dir") {
+            if (i + 1 < argc) cache_dir = argv[++i];
+            else { std::cerr << "Error: --cache-dir option requires a directory path." << std::endl; return false; }
+        }
         else if (arg == "--list" || arg == "-l") generate_list = true;
         else if (arg == "--test-encoders") test_encoders = true;
         else if (arg == "--test-encode") {
@@ -1184,8 +1339,22 @@ bool parse_arguments(int argc, char* argv[], bool& run_jit, bool& generate_asm,
                       << "  --no-bounds-check      : Disable runtime bounds checking for vector/string access (default: enabled).\n"
                       << "  --noSAMM               : Disable SAMM (Scope Aware Memory Management) - reduces automatic cleanup (default: enabled).\n"
                       << "  --no-superdisc         : Disable CREATE Method Reordering Pass (rewrite CREATE)\n"
+                      << "  --no-inline            : Disable inlining of small FUNCTIONs and ROUTINEs into their callers.\n"
                       << "  --no-neon              : Disable NEON SIMD instructions for vector operations (use scalar fallback).\n"
+                      << "  --fast-float-reductions: Also vectorize FOR loop sums into FLET variables (s := s + v!i). The two\n"
+                      << "                          partial sums can round differently from the scalar loop. Default: off.\n"
+                      << "  --compact-strings      : Store Latin-1 text read or built at run time (SLURP, FILE_READS, SPLIT, JOIN)\n"
+                      << "                          one byte per character; character access checks the storage class.\n"
+                      << "                          JIT only (--run); rejected with --exec and -S.\n"
                       << "  --list, -l             : Generate listing file (.lst) with hex opcodes alongside assembly.\n"
+                      << "  --time-passes          : Report wall-clock time spent in each compiler pass.\n"
+                      << "  --jobs N               : Run liveness, live intervals, register allocation and code generation\n"
+                      << "                          on N threads (one function per task; 0 = all cores). Peephole\n"
+                      << "                          optimization stays on one thread. Default: 1.\n"
+                      << "  --analysis-jobs N      : As --jobs, but code generation stays on one thread.\n"
+                      << "  --no-cache             : Always preprocess and compile; do not read or write the caches.\n"
+                      << "  --cache-dir DIR        : Compilation cache directory (default: $NEWBCPL_CACHE_DIR or ~/.cache/newbcpl).\n"
+                      << "                          Unchanged programs skip straight to linking. Not used while tracing.\n"
                       << "\n"
                       << "Encoder Testing:\n"
                       << "  --test-encoders        : Run all encoder validation tests (53 total).\n"
@@ -1213,7 +1382,7 @@ bool parse_arguments(int argc, char* argv[], bool& run_jit, bool& generate_asm,
                       << "  --trace-liveness       : Enable liveness analysis tracing.\n"
                       << "  --trace-runtime        : Enable runtime function tracing.\n"
                       << "  --trace-symbols        : Enable symbol table construction tracing.\n"
-                      << "  --trace-heap           : Enable heap manager tracing.\n"
+                      << "  --trace-heap           : Enable heap manager tracing (and Bloom filter double-free diagnostics).\n"
                       << "  --trace-preprocessor   : Enable preprocessor tracing.\n"
                       << "  --trace-class-table    : Print the class table after symbol discovery.\n"
                       << "  --trace-vtable         : Enable detailed vtable structure tracing.\n";
@@ -1258,6 +1427,12 @@ bool parse_arguments(int argc, char* argv[], bool& run_jit, bool& generate_asm,
         std::cerr << "Error: No input file specified. Use --help for usage.\n";
         return false;
     }
+    // Only the JIT host calls bcpl_set_compact_strings; starter.c does not,
+    // so a static binary would silently keep UTF-32 runtime strings.
+    if (compact_strings && (exec_mode || (generate_asm && !run_jit))) {
+        std::cerr << "Error: --compact-strings is only supported with --run, not for --exec or -S builds.\n";
+        return false;
+    }
     if (enable_tracing) {
         std::cout << "Debug: parse_arguments successful, input_filepath=" << input_filepath << std::endl;
     }
@@ -1277,17 +1452,37 @@ void handle_static_compilation(bool exec_mode, const std::string& base_name, con
     AssemblyWriter asm_writer;
     asm_writer.write_to_file(asm_output_path, static_instructions, LabelManager::instance(), data_generator, veneer_manager);
 
+    // On ELF hosts the object file is written directly from the unlinked
+    // stream, with the same layout as the JIT, instead of assembling the .s
+    // (which is Mach-O flavoured) with clang.
+    std::string obj_path = base_name + ".o";
+#ifdef __linux__
+    const bool direct_object = true;
+#else
+    const bool direct_object = false;
+#endif
+    bool object_written = false;
+    if (direct_object && (exec_mode || generate_list)) {
+        try {
+            ObjectWriter object_writer;
+            object_writer.write_to_file(obj_path, instruction_stream.get_instructions_ref());
+            object_written = true;
+            if (enable_debug_output) std::cout << "Wrote object file: " << obj_path << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: " << e.what() << " Falling back to the assembler." << std::endl;
+        }
+    }
+
     if (generate_list) {
         // Generate object file first, then create listing with objdump
-        std::string obj_path = base_name + ".o";
         std::string lst_path = base_name + ".lst";
         std::string compile_command = "clang -c " + asm_output_path + " -o " + obj_path;
         
-        if (enable_debug_output) {
+        if (enable_debug_output && !object_written) {
             std::cout << "Compiling to object file: " << compile_command << std::endl;
         }
         
-        int compile_result = system(compile_command.c_str());
+        int compile_result = object_written ? 0 : system(compile_command.c_str());
         if (compile_result == 0) {
             // Use objdump to create listing with hex opcodes
             std::string objdump_command = "objdump -d -S " + obj_path + " > " + lst_path;
@@ -1371,7 +1566,10 @@ void handle_static_compilation(bool exec_mode, const std::string& base_name, con
             }
         }
 
-        std::string clang_command = "clang -g -o " + executable_output_path + " starter.o " + asm_output_path + " " + runtime_lib + extra_flags + sdl2_flags;
+        // The object's veneers load runtime addresses with absolute MOVZ/MOVK
+        // relocations, so it is linked as a non-PIE executable.
+        std::string program_input = object_written ? obj_path + " -no-pie" : asm_output_path;
+        std::string clang_command = "clang -g -o " + executable_output_path + " starter.o " + program_input + " " + runtime_lib + extra_flags + sdl2_flags;
         if (enable_debug_output) std::cout << "Executing: " << clang_command << std::endl;
 
         int build_result = system(clang_command.c_str());
@@ -1520,6 +1718,58 @@ void* handle_jit_compilation(void* jit_data_memory_base, InstructionStream& inst
 }
 
 
+/**
+ * @brief Runs a program loaded from the compilation cache.
+ *
+ * Picks up where a full compile leaves off after the peephole optimizer:
+ * the cached stream is written out for --asm/--exec, or linked into fresh
+ * JIT buffers and executed for --run, exactly as main() does it.
+ * @return The process exit code.
+ */
+int run_cached_program(CompilationCache::Entry& entry, bool run_jit, bool generate_asm, bool exec_mode, bool generate_list, const std::string& input_filepath, const std::string& runtime_mode, const std::string& call_entry_name, bool dump_jit_stack, const std::string& initial_working_dir) {
+    // The Linker resolves veneers against the registered runtime functions
+    SymbolTable runtime_symbols;
+    initialize_runtime_system();
+    if (!RuntimeImporter::import_all_runtime_functions(runtime_symbols, false)) {
+        std::cerr << "FATAL: Failed to import runtime functions from manifest!" << std::endl;
+        return 1;
+    }
+
+    const size_t JIT_DATA_POOL_SIZE = 1024 * 1024;
+    g_jit_data_manager = std::make_unique<JITMemoryManager>();
+    g_jit_data_manager->allocate(JIT_DATA_POOL_SIZE);
+    void* jit_data_memory_base = g_jit_data_manager->getMemoryPointer();
+    if (!jit_data_memory_base) {
+        std::cerr << "Failed to allocate JIT data pool." << std::endl;
+        return 1;
+    }
+    entry.set_data_base(reinterpret_cast<uint64_t>(jit_data_memory_base));
+
+    InstructionStream instruction_stream(LabelManager::instance(), false);
+    instruction_stream.replace_instructions(std::move(entry.instructions));
+
+    if (generate_asm || exec_mode || generate_list) {
+        std::string base_name = input_filepath.substr(0, input_filepath.find_last_of('.'));
+        DataGenerator data_generator; // data is already in the stream
+        VeneerManager veneer_manager;
+        veneer_manager.restore_veneer_labels(entry.veneer_labels);
+        handle_static_compilation(exec_mode, base_name, instruction_stream, data_generator, false, runtime_mode, veneer_manager, generate_list, initial_working_dir);
+    }
+
+    LabelManager::instance().reset();
+
+    if (run_jit && !exec_mode) {
+        if (!g_jit_code_buffer) {
+            g_jit_code_buffer = std::make_unique<CodeBuffer>(32 * 1024 * 1024, false);
+        }
+        void* code_buffer_base = handle_jit_compilation(jit_data_memory_base, instruction_stream, g_jit_breakpoint_offset, false);
+        RuntimeManager::instance().populate_function_pointer_table(jit_data_memory_base);
+        g_jit_data_manager->makeReadOnly(512 * 1024, 512 * 1024);
+        handle_jit_execution(code_buffer_base, call_entry_name, dump_jit_stack, false);
+    }
+    return 0;
+}
+
 /**
  * @brief Handles the execution of the JIT-compiled code.
  */
@@ -1545,6 +1795,7 @@ void handle_jit_execution(void* code_buffer_base, const std::string& call_entry_
     }
 
     int64_t jit_result = g_jit_executor->execute(jit_func);
+    bcpl_output_flush(); // program output before anything the host prints
 
     if (RuntimeManager::instance().isTracingEnabled()) {
         std::cout << "[JITExecutor] Execution completed. Result: " << jit_result << std::endl;
@@ -60,7 +60,8 @@ std::unique_ptr<InstructionPattern> createAdrFusionPattern() {
             adr_instr.address = adrp_instr.address;
             return { adr_instr };
         },
-        "ADR fusion (ADRP+ADD to ADR, robust matcher)"
+        "ADR fusion (ADRP+ADD to ADR, robust matcher)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::ADRP }
     );
 }
 
@@ -120,7 +121,8 @@ std::unique_ptr<InstructionPattern> createAdrAddAddFusionPattern() {
             // Keep the third ADD as is
             return { adr_instr, add_imm };
         },
-        "ADR+ADD fusion (ADRP+ADD(lo12)+ADD(imm) → ADR+ADD(imm))"
+        "ADR+ADD fusion (ADRP+ADD(lo12)+ADD(imm) → ADR+ADD(imm))",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::ADRP }
     );
 }
 
@@ -57,7 +57,8 @@ std::unique_ptr<InstructionPattern> createIdentityOperationEliminationPattern()
             Instruction mov = Encoder::create_mov_reg(xd, xn);
             return { mov };
         },
-        "Identity operation elimination (ADD/SUB #0 to MOV)"
+        "Identity operation elimination (ADD/SUB #0 to MOV)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::ADD, InstructionDecoder::OpType::SUB }
     );
 }
 
@@ -83,7 +84,8 @@ std::unique_ptr<InstructionPattern> createRedundantMovePattern() {
             // Remove the redundant MOV
             return {};
         },
-        "Redundant move elimination (MOV Xn, Xn)"
+        "Redundant move elimination (MOV Xn, Xn)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::MOV }
     );
 }
 
@@ -109,7 +111,8 @@ std::unique_ptr<InstructionPattern> createSelfMoveEliminationPattern() {
             // Remove the self-move
             return {};
         },
-        "Self move elimination (MOV Xn, Xn)"
+        "Self move elimination (MOV Xn, Xn)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::MOV }
     );
 }
 
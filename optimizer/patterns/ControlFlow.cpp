@@ -49,7 +49,8 @@ std::unique_ptr<InstructionPattern> createCompareZeroBranchPattern() {
                 return { Encoder::opt_create_cbnz(reg, label) };
             }
         },
-        "CBZ/CBNZ fusion (CMP Xn, #0/XZR; B.EQ/B.NE label → CBZ/CBNZ Xn, label)"
+        "CBZ/CBNZ fusion (CMP Xn, #0/XZR; B.EQ/B.NE label → CBZ/CBNZ Xn, label)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::CMP }
     );
 }
 
@@ -121,7 +122,8 @@ std::unique_ptr<InstructionPattern> createBranchChainingPattern() {
             // If something went wrong, return the original instruction
             return { branch_instr };
         },
-        "Branch chaining (eliminate intermediate unconditional branch)"
+        "Branch chaining (eliminate intermediate unconditional branch)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::B }
     );
 }
 
@@ -49,7 +49,8 @@ std::unique_ptr<InstructionPattern> createLdrToLdpXPattern() {
             );
             return { ldp };
         },
-        "Combine adjacent X-register LDRs into LDP"
+        "Combine adjacent X-register LDRs into LDP",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::LDR }
     );
 }
 
@@ -203,7 +204,8 @@ std::unique_ptr<InstructionPattern> createConservativeMovzScratchPattern() {
             
             return { optimized_movz };
         },
-        "Conservative MOVZ+MOV scratch-to-target pattern for X9/X10/X11 to X19-X27"
+        "Conservative MOVZ+MOV scratch-to-target pattern for X9/X10/X11 to X19-X27",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::MOVZ }
     );
 }
 
@@ -270,7 +272,8 @@ std::unique_ptr<InstructionPattern> createLoadThroughScratchRegisterPattern() {
             optimized_ldr.dest_reg = mov.dest_reg; // Change destination to MOV's target
             return { optimized_ldr };
         },
-        "Eliminate load through scratch register (LDR Xs, [..]; MOV Xt, Xs => LDR Xt, [..])"
+        "Eliminate load through scratch register (LDR Xs, [..]; MOV Xt, Xs => LDR Xt, [..])",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::LDR }
     );
 }
 
@@ -321,7 +324,8 @@ std::unique_ptr<InstructionPattern> createRedundantLoadEliminationPattern() {
             );
             return {instr1, new_mov};
         },
-        "Redundant load elimination (LDR Rd, [..]; LDR Rd, [..] => LDR Rd, [..])"
+        "Redundant load elimination (LDR Rd, [..]; LDR Rd, [..] => LDR Rd, [..])",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::LDR }
     );
 }
 
@@ -358,7 +362,8 @@ std::unique_ptr<InstructionPattern> createLoadAfterStorePattern() {
             // Remove the redundant LDR, keep only the STR
             return {instrs[pos]};
         },
-        "Load-after-store elimination (STR+LDR to STR)"
+        "Load-after-store elimination (STR+LDR to STR)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::STR }
     );
 }
 
@@ -391,7 +396,8 @@ std::unique_ptr<InstructionPattern> createDeadStorePattern() {
             // Keep only the second STR
             return {instrs[pos + 1]};
         },
-        "Dead store elimination (STR+STR to STR)"
+        "Dead store elimination (STR+STR to STR)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::STR }
     );
 }
 
@@ -427,7 +433,8 @@ std::unique_ptr<InstructionPattern> createRedundantStorePattern() {
             // Keep only one STR (the second)
             return {instrs[pos + 1]};
         },
-        "Redundant store elimination (STR+STR to STR)"
+        "Redundant store elimination (STR+STR to STR)",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::STR }
     );
 }
 
@@ -475,7 +482,8 @@ std::unique_ptr<InstructionPattern> createStrToStpXPattern() {
             );
             return { stp };
         },
-        "Combine adjacent X-register STRs into STP"
+        "Combine adjacent X-register STRs into STP",
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::STR }
     );
 }
 
@@ -34,7 +34,9 @@ std::unique_ptr<InstructionPattern> createMultiplyByPowerOfTwoPattern() {
             // Placeholder: return the original instruction
             return { instrs[pos] };
         },
-        "Multiply by power of two converted to shift"
+        "Multiply by power of two converted to shift",
+        // The matcher rejects every other opcode, so only MUL instructions try it
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::MUL }
     );
 }
 
@@ -62,7 +64,9 @@ std::unique_ptr<InstructionPattern> createDivideByPowerOfTwoPattern() {
             // Placeholder: return the original instruction
             return { instrs[pos] };
         },
-        "Divide by power of two converted to shift"
+        "Divide by power of two converted to shift",
+        // The matcher rejects every other opcode, so only SDIV instructions try it
+        std::vector<InstructionDecoder::OpType>{ InstructionDecoder::OpType::SDIV }
     );
 }
 
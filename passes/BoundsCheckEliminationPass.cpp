@@ -0,0 +1,197 @@
+#include "BoundsCheckEliminationPass.h"
+#include "../AST.h"
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <vector>
+
+// The largest offset an ADD or SUB immediate in the preheader guard can carry
+static const int64_t MAX_GUARD_OFFSET = 4095;
+
+BoundsCheckEliminationPass::BoundsCheckEliminationPass(SymbolTable* symbol_table, bool trace_enabled)
+    : trace_enabled_(trace_enabled), analysis_(symbol_table) {}
+
+void BoundsCheckEliminationPass::run(std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>& cfgs) {
+    debug_print("Starting Bounds Check Elimination Pass");
+    stats_.reset();
+
+    for (auto& pair : cfgs) {
+        debug_print("Processing function: " + pair.first);
+        stats_.functions_processed++;
+        optimize_cfg(pair.first, *pair.second);
+    }
+
+    print_statistics();
+    debug_print("Bounds Check Elimination Pass completed");
+}
+
+void BoundsCheckEliminationPass::optimize_cfg(const std::string& function_name, ControlFlowGraph& cfg) {
+    std::string opaque_block;
+    if (!analysis_.analyze(function_name, cfg, opaque_block)) {
+        debug_print("  Skipping function: block " + opaque_block + " has statements the pass does not analyze");
+        return;
+    }
+
+    for (BasicBlock* block : analysis_.blocks()) {
+        Loop loop;
+        if (block->is_loop_header && analysis_.find_loop(block, loop)) {
+            stats_.loops_analyzed++;
+            optimize_loop(loop);
+        }
+    }
+}
+
+// Matches i, i + c, c + i and i - c for the loop variable i.
+static bool match_index(const Expression* expr, const std::string& variable, int64_t& offset) {
+    auto is_variable = [&](const Expression* e) {
+        auto* var = dynamic_cast<const VariableAccess*>(e);
+        return var && var->name == variable;
+    };
+    auto as_integer = [](const Expression* e, int64_t& value) {
+        auto* lit = dynamic_cast<const NumberLiteral*>(e);
+        if (!lit || lit->literal_type != NumberLiteral::LiteralType::Integer) return false;
+        value = lit->int_value;
+        return true;
+    };
+
+    if (is_variable(expr)) {
+        offset = 0;
+        return true;
+    }
+    auto* bin = dynamic_cast<const BinaryOp*>(expr);
+    if (!bin) return false;
+    int64_t c;
+    if (bin->op == BinaryOp::Operator::Add) {
+        if (is_variable(bin->left.get()) && as_integer(bin->right.get(), c)) { offset = c; return true; }
+        if (as_integer(bin->left.get(), c) && is_variable(bin->right.get())) { offset = c; return true; }
+    } else if (bin->op == BinaryOp::Operator::Subtract) {
+        if (is_variable(bin->left.get()) && as_integer(bin->right.get(), c)) { offset = -c; return true; }
+    }
+    return false;
+}
+
+// v!i, v!(i + c) or v!(i - c), for trace output
+static std::string describe_read(const std::string& vector_name, const std::string& variable, int64_t offset) {
+    if (offset == 0) return vector_name + "!" + variable;
+    return vector_name + "!(" + variable + (offset > 0 ? " + " : " - ") +
+           std::to_string(offset > 0 ? offset : -offset) + ")";
+}
+
+// Matches LEN(v) and LEN(v) - d.
+static bool match_length_limit(const Expression* expr, std::string& vector_name, int64_t& slack) {
+    auto length_of = [&](const Expression* e) {
+        auto* un = dynamic_cast<const UnaryOp*>(e);
+        if (!un || un->op != UnaryOp::Operator::LengthOf) return false;
+        auto* var = dynamic_cast<const VariableAccess*>(un->operand.get());
+        if (!var) return false;
+        vector_name = var->name;
+        return true;
+    };
+
+    if (length_of(expr)) {
+        slack = 0;
+        return true;
+    }
+    auto* bin = dynamic_cast<const BinaryOp*>(expr);
+    if (!bin || bin->op != BinaryOp::Operator::Subtract || !length_of(bin->left.get())) return false;
+    auto* lit = dynamic_cast<const NumberLiteral*>(bin->right.get());
+    if (!lit || lit->literal_type != NumberLiteral::LiteralType::Integer) return false;
+    slack = lit->int_value;
+    return true;
+}
+
+void BoundsCheckEliminationPass::optimize_loop(Loop& loop) {
+    const Expression* end_expr = loop.for_stmt->end_expr.get();
+    std::string limit_vector;
+    int64_t limit_slack = 0;
+    bool length_limit = match_length_limit(end_expr, limit_vector, limit_slack) &&
+                        analysis_.is_invariant_vector(limit_vector, loop);
+
+    // Hoisting checks the last index against the limit itself, so it needs a
+    // step of 1 and a loop that runs every iteration to the end
+    bool can_hoist = loop.step == 1 && analysis_.is_invariant(end_expr, loop);
+    for (BasicBlock* block : loop.blocks) {
+        if (block == loop.header) continue;
+        if (analysis_.facts(block).has_call) can_hoist = false;
+        for (BasicBlock* succ : block->successors) {
+            if (!loop.blocks.count(succ)) can_hoist = false;
+        }
+    }
+
+    debug_print("  Loop " + loop.header->id + " over " + loop.variable + ": step " + std::to_string(loop.step) +
+                (loop.start_is_constant ? ", start " + std::to_string(loop.start) : "") +
+                (length_limit ? ", limit LEN(" + limit_vector + ") - " + std::to_string(limit_slack) : "") +
+                (can_hoist ? ", checks can be hoisted" : ""));
+
+    std::map<std::string, HoistedBoundsCheck> guards;
+    for (BasicBlock* block : loop.blocks) {
+        // Reads in the header's end expression see the variable past the limit
+        if (block == loop.header) continue;
+        for (const ForLoopAnalysis::VectorRead& read : analysis_.facts(block).reads) {
+            VectorAccess* access = read.access;
+            if (access->bounds_check_elided) continue;
+            auto* vec = dynamic_cast<VariableAccess*>(access->vector_expr.get());
+            int64_t offset = 0;
+            if (!vec || !match_index(access->index_expr.get(), loop.variable, offset) ||
+                !analysis_.is_invariant_vector(vec->name, loop)) {
+                continue;
+            }
+
+            // s + c >= 0 and i + c <= LEN(v) - d + c < LEN(v)
+            if (loop.start_is_constant && loop.start + offset >= 0 && length_limit &&
+                limit_vector == vec->name && offset < limit_slack) {
+                access->bounds_check_elided = true;
+                stats_.checks_eliminated++;
+                debug_print("    Eliminated check on " + describe_read(vec->name, loop.variable, offset) + " in " + block->id);
+                continue;
+            }
+
+            if (!can_hoist || !read.unconditional || offset > MAX_GUARD_OFFSET || offset < -MAX_GUARD_OFFSET ||
+                !analysis_.runs_every_iteration(block, loop)) {
+                continue;
+            }
+            auto it = guards.find(vec->name);
+            if (it == guards.end()) {
+                HoistedBoundsCheck guard;
+                guard.vector_name = vec->name;
+                guard.min_offset = guard.max_offset = offset;
+                guards.emplace(vec->name, guard);
+            } else {
+                it->second.min_offset = std::min(it->second.min_offset, offset);
+                it->second.max_offset = std::max(it->second.max_offset, offset);
+            }
+            access->bounds_check_elided = true;
+            stats_.checks_hoisted++;
+            debug_print("    Hoisted check on " + describe_read(vec->name, loop.variable, offset) + " in " + block->id +
+                        " to " + loop.preheader->id);
+        }
+    }
+
+    if (guards.empty()) return;
+    BasicBlock* preheader = loop.preheader;
+    preheader->hoisted_loop_variable = loop.variable;
+    preheader->hoisted_loop_end = clone_unique_ptr(loop.for_stmt->end_expr);
+    for (auto& pair : guards) {
+        HoistedBoundsCheck& guard = pair.second;
+        guard.check_start = !(loop.start_is_constant && loop.start + guard.min_offset >= 0);
+        preheader->hoisted_bounds_checks.push_back(guard);
+        stats_.guards_inserted++;
+    }
+}
+
+void BoundsCheckEliminationPass::debug_print(const std::string& message) {
+    if (trace_enabled_) {
+        std::cout << "[BoundsCheckEliminationPass] " << message << std::endl;
+    }
+}
+
+void BoundsCheckEliminationPass::print_statistics() {
+    if (trace_enabled_) {
+        std::cout << "\n[BoundsCheckEliminationPass] Statistics:" << std::endl;
+        std::cout << "  Functions processed: " << stats_.functions_processed << std::endl;
+        std::cout << "  FOR loops analyzed: " << stats_.loops_analyzed << std::endl;
+        std::cout << "  Checks eliminated: " << stats_.checks_eliminated << std::endl;
+        std::cout << "  Checks hoisted: " << stats_.checks_hoisted << std::endl;
+        std::cout << "  Preheader guards inserted: " << stats_.guards_inserted << std::endl;
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef BOUNDS_CHECK_ELIMINATION_PASS_H
+#define BOUNDS_CHECK_ELIMINATION_PASS_H
+
+#include "../ControlFlowGraph.h"
+#include "../BasicBlock.h"
+#include "../SymbolTable.h"
+#include "ForLoopAnalysis.h"
+#include <unordered_map>
+#include <memory>
+#include <string>
+
+// BoundsCheckEliminationPass removes the run-time bounds checks that
+// NewCodeGenerator emits for vector reads (v!i) inside FOR loops, using the
+// range of the loop's induction variable.
+//
+// For a loop FOR i = s TO e BY k (k a positive constant) whose variable is
+// written only by its increment, i lies in [s, e] throughout the body. A read
+// v!(i + c) of a vector v that the loop never reassigns is then:
+//
+// 1. Proven in range when s is a constant with s + c >= 0 and e is
+//    LEN(v) - d with c < d. The check is dropped:
+//      FOR i = 0 TO LEN(v) - 1 DO sum := sum + v!i
+//
+// 2. Hoisted when e is loop-invariant, the step is 1 and the read happens on
+//    every iteration of a loop without calls or early exits. The preheader
+//    checks the first and last index once, before the first iteration:
+//      FOR i = 1 TO n - 2 DO w!i := (v!(i - 1) + v!i + v!(i + 1)) / 3
+//    A loop that would have failed part way now fails before it starts.
+//
+// Only locals and parameters whose address is never taken take part (see
+// ForLoopAnalysis), so nothing outside the loop's own statements can change them.
+class BoundsCheckEliminationPass {
+public:
+    BoundsCheckEliminationPass(SymbolTable* symbol_table, bool trace_enabled = false);
+
+    // Run the pass on all CFGs
+    void run(std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>& cfgs);
+
+    // Run the pass on a single function's CFG
+    void optimize_cfg(const std::string& function_name, ControlFlowGraph& cfg);
+
+    std::string getName() const { return "Bounds Check Elimination Pass"; }
+
+private:
+    bool trace_enabled_;
+
+    // Statistics for reporting
+    struct Statistics {
+        int functions_processed = 0;
+        int loops_analyzed = 0;
+        int checks_eliminated = 0;
+        int checks_hoisted = 0;
+        int guards_inserted = 0;
+
+        void reset() {
+            functions_processed = 0;
+            loops_analyzed = 0;
+            checks_eliminated = 0;
+            checks_hoisted = 0;
+            guards_inserted = 0;
+        }
+    } stats_;
+
+    using Loop = ForLoopAnalysis::Loop;
+
+    ForLoopAnalysis analysis_;
+
+    void debug_print(const std::string& message);
+
+    void optimize_loop(Loop& loop);
+
+    void print_statistics();
+};
+
+#endif // BOUNDS_CHECK_ELIMINATION_PASS_H
@@ -0,0 +1,262 @@
+#include "DevirtualizationPass.h"
+#include "../AST.h"
+#include <algorithm>
+#include <iostream>
+
+DevirtualizationPass::DevirtualizationPass(SymbolTable* symbol_table, ClassTable* class_table, bool trace_enabled)
+    : symbol_table_(symbol_table), class_table_(class_table), trace_enabled_(trace_enabled) {}
+
+void DevirtualizationPass::run(std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>& cfgs) {
+    debug_print("Starting Devirtualization Pass");
+    stats_.reset();
+
+    for (auto& pair : cfgs) {
+        debug_print("Processing function: " + pair.first);
+        stats_.functions_processed++;
+        optimize_cfg(pair.first, *pair.second);
+    }
+
+    print_statistics();
+    debug_print("Devirtualization Pass completed");
+}
+
+void DevirtualizationPass::optimize_cfg(const std::string& function_name, ControlFlowGraph& cfg) {
+    if (!class_table_) return;
+
+    std::vector<BasicBlock*> blocks;
+    for (const auto& pair : cfg.blocks) {
+        blocks.push_back(pair.second.get());
+    }
+    std::sort(blocks.begin(), blocks.end(), [](BasicBlock* a, BasicBlock* b) { return a->id < b->id; });
+
+    FunctionFacts facts;
+    for (BasicBlock* block : blocks) {
+        for (const auto& stmt : block->statements) {
+            walk_statement(stmt.get(), facts);
+        }
+        if (facts.opaque) {
+            debug_print("  Skipping function: block " + block->id + " has statements the pass does not analyze");
+            return;
+        }
+    }
+
+    for (MemberAccessExpression* callee : facts.calls) {
+        stats_.method_calls++;
+        std::string exact = exact_class_of(callee->object_expr.get(), function_name, facts);
+        if (!exact.empty()) {
+            callee->exact_class_name = exact;
+            stats_.exact_receivers++;
+            debug_print("    Receiver of ." + callee->member_name + " is exactly " + exact);
+            continue;
+        }
+
+        std::string static_class = static_class_of(callee->object_expr.get(), function_name);
+        ClassMethodInfo* method = static_class.empty() ? nullptr
+                                  : class_table_->lookup_class_method(static_class, callee->member_name);
+        if (method && !class_table_->unique_method_target(static_class, method->vtable_slot).empty()) {
+            stats_.unique_targets++;
+            debug_print("    No class below " + static_class + " overrides ." + callee->member_name);
+        }
+    }
+}
+
+void DevirtualizationPass::walk_statement(Statement* stmt, FunctionFacts& facts) {
+    if (auto* assign = dynamic_cast<AssignmentStatement*>(stmt)) {
+        for (size_t i = 0; i < assign->lhs.size(); ++i) {
+            Expression* lhs = assign->lhs[i].get();
+            if (auto* var = dynamic_cast<VariableAccess*>(lhs)) {
+                record_assignment(var->name, i < assign->rhs.size() ? assign->rhs[i].get() : nullptr, facts);
+                continue;
+            }
+            // A store through a variable may overwrite an object's vtable pointer
+            Expression* base = nullptr;
+            if (auto* store = dynamic_cast<VectorAccess*>(lhs)) {
+                base = store->vector_expr.get();
+            } else if (auto* un = dynamic_cast<UnaryOp*>(lhs)) {
+                if (un->op == UnaryOp::Operator::Indirection) base = un->operand.get();
+            }
+            if (auto* var = dynamic_cast<VariableAccess*>(base)) {
+                facts.inexact.insert(var->name);
+            }
+            walk_expression(lhs, facts);
+        }
+        for (const auto& rhs : assign->rhs) {
+            walk_expression(rhs.get(), facts);
+        }
+    } else if (auto* call = dynamic_cast<RoutineCallStatement*>(stmt)) {
+        record_call(call->routine_expr.get(), facts);
+        for (const auto& arg : call->arguments) {
+            walk_expression(arg.get(), facts);
+        }
+    } else if (auto* if_stmt = dynamic_cast<IfStatement*>(stmt)) {
+        // Condition statements end their block; their branches are in other blocks
+        walk_expression(if_stmt->condition.get(), facts);
+    } else if (auto* unless_stmt = dynamic_cast<UnlessStatement*>(stmt)) {
+        walk_expression(unless_stmt->condition.get(), facts);
+    } else if (auto* test_stmt = dynamic_cast<TestStatement*>(stmt)) {
+        walk_expression(test_stmt->condition.get(), facts);
+    } else if (auto* while_stmt = dynamic_cast<WhileStatement*>(stmt)) {
+        walk_expression(while_stmt->condition.get(), facts);
+    } else if (auto* until_stmt = dynamic_cast<UntilStatement*>(stmt)) {
+        walk_expression(until_stmt->condition.get(), facts);
+    } else if (auto* repeat_stmt = dynamic_cast<RepeatStatement*>(stmt)) {
+        walk_expression(repeat_stmt->condition.get(), facts);
+    } else if (auto* for_stmt = dynamic_cast<ForStatement*>(stmt)) {
+        // A loop header evaluates only its end expression
+        walk_expression(for_stmt->end_expr.get(), facts);
+    } else if (auto* branch = dynamic_cast<ConditionalBranchStatement*>(stmt)) {
+        walk_expression(branch->condition_expr.get(), facts);
+    } else if (auto* switchon = dynamic_cast<SwitchonStatement*>(stmt)) {
+        walk_expression(switchon->expression.get(), facts);
+    } else if (auto* resultis = dynamic_cast<ResultisStatement*>(stmt)) {
+        walk_expression(resultis->expression.get(), facts);
+    } else if (auto* goto_stmt = dynamic_cast<GotoStatement*>(stmt)) {
+        walk_expression(goto_stmt->label_expr.get(), facts);
+    } else if (auto* free_stmt = dynamic_cast<FreeStatement*>(stmt)) {
+        walk_expression(free_stmt->list_expr.get(), facts);
+    } else if (auto* finish = dynamic_cast<FinishStatement*>(stmt)) {
+        for (const auto& arg : finish->arguments) {
+            walk_expression(arg.get(), facts);
+        }
+    } else if (dynamic_cast<ReturnStatement*>(stmt) || dynamic_cast<BreakStatement*>(stmt) ||
+               dynamic_cast<LoopStatement*>(stmt) || dynamic_cast<EndcaseStatement*>(stmt) ||
+               dynamic_cast<BrkStatement*>(stmt) || dynamic_cast<LabelTargetStatement*>(stmt)) {
+        // Control transfer only
+    } else {
+        facts.opaque = true;
+    }
+}
+
+void DevirtualizationPass::walk_expression(Expression* expr, FunctionFacts& facts) {
+    if (!expr) return;
+
+    if (dynamic_cast<NumberLiteral*>(expr) || dynamic_cast<StringLiteral*>(expr) ||
+        dynamic_cast<CharLiteral*>(expr) || dynamic_cast<BooleanLiteral*>(expr) ||
+        dynamic_cast<NullLiteral*>(expr) || dynamic_cast<VariableAccess*>(expr) ||
+        dynamic_cast<SuperMethodAccessExpression*>(expr)) {
+        return;
+    }
+    if (auto* bin = dynamic_cast<BinaryOp*>(expr)) {
+        walk_expression(bin->left.get(), facts);
+        walk_expression(bin->right.get(), facts);
+    } else if (auto* un = dynamic_cast<UnaryOp*>(expr)) {
+        auto* operand = dynamic_cast<VariableAccess*>(un->operand.get());
+        if (un->op == UnaryOp::Operator::AddressOf && operand) {
+            facts.inexact.insert(operand->name);
+        } else {
+            walk_expression(un->operand.get(), facts);
+        }
+    } else if (auto* access = dynamic_cast<VectorAccess*>(expr)) {
+        walk_expression(access->vector_expr.get(), facts);
+        walk_expression(access->index_expr.get(), facts);
+    } else if (auto* char_ind = dynamic_cast<CharIndirection*>(expr)) {
+        walk_expression(char_ind->string_expr.get(), facts);
+        walk_expression(char_ind->index_expr.get(), facts);
+    } else if (auto* float_ind = dynamic_cast<FloatVectorIndirection*>(expr)) {
+        walk_expression(float_ind->vector_expr.get(), facts);
+        walk_expression(float_ind->index_expr.get(), facts);
+    } else if (auto* cond = dynamic_cast<ConditionalExpression*>(expr)) {
+        walk_expression(cond->condition.get(), facts);
+        walk_expression(cond->true_expr.get(), facts);
+        walk_expression(cond->false_expr.get(), facts);
+    } else if (auto* member = dynamic_cast<MemberAccessExpression*>(expr)) {
+        walk_expression(member->object_expr.get(), facts);
+    } else if (auto* call = dynamic_cast<FunctionCall*>(expr)) {
+        record_call(call->function_expr.get(), facts);
+        for (const auto& arg : call->arguments) {
+            walk_expression(arg.get(), facts);
+        }
+    } else if (auto* super_call = dynamic_cast<SuperMethodCallExpression*>(expr)) {
+        for (const auto& arg : super_call->arguments) {
+            walk_expression(arg.get(), facts);
+        }
+    } else if (auto* new_expr = dynamic_cast<NewExpression*>(expr)) {
+        for (const auto& arg : new_expr->constructor_arguments) {
+            walk_expression(arg.get(), facts);
+        }
+    } else if (auto* sys = dynamic_cast<SysCall*>(expr)) {
+        for (const auto& arg : sys->arguments) {
+            walk_expression(arg.get(), facts);
+        }
+    } else if (auto* vec = dynamic_cast<VecAllocationExpression*>(expr)) {
+        walk_expression(vec->size_expr.get(), facts);
+    } else if (auto* fvec = dynamic_cast<FVecAllocationExpression*>(expr)) {
+        walk_expression(fvec->size_expr.get(), facts);
+    } else if (auto* str = dynamic_cast<StringAllocationExpression*>(expr)) {
+        walk_expression(str->size_expr.get(), facts);
+    } else if (auto* table = dynamic_cast<TableExpression*>(expr)) {
+        for (const auto& init : table->initializers) {
+            walk_expression(init.get(), facts);
+        }
+    } else {
+        facts.opaque = true;
+    }
+}
+
+void DevirtualizationPass::record_assignment(const std::string& name, const Expression* value, FunctionFacts& facts) {
+    auto* new_expr = dynamic_cast<const NewExpression*>(value);
+    if (!new_expr) {
+        facts.inexact.insert(name);
+        return;
+    }
+    auto it = facts.new_classes.find(name);
+    if (it == facts.new_classes.end()) {
+        facts.new_classes.emplace(name, new_expr->class_name);
+    } else if (it->second != new_expr->class_name) {
+        facts.inexact.insert(name);
+    }
+}
+
+void DevirtualizationPass::record_call(Expression* callee, FunctionFacts& facts) {
+    if (auto* member = dynamic_cast<MemberAccessExpression*>(callee)) {
+        facts.calls.push_back(member);
+        walk_expression(member->object_expr.get(), facts);
+    } else if (!dynamic_cast<VariableAccess*>(callee)) {
+        walk_expression(callee, facts);
+    }
+}
+
+std::string DevirtualizationPass::exact_class_of(const Expression* receiver, const std::string& function_name,
+                                                 const FunctionFacts& facts) const {
+    if (auto* new_expr = dynamic_cast<const NewExpression*>(receiver)) {
+        return class_table_->class_exists(new_expr->class_name) ? new_expr->class_name : "";
+    }
+    auto* var = dynamic_cast<const VariableAccess*>(receiver);
+    if (!var || facts.inexact.count(var->name)) return "";
+    auto it = facts.new_classes.find(var->name);
+    if (it == facts.new_classes.end() || !class_table_->class_exists(it->second)) return "";
+
+    // Only a local of this function: anything else may be assigned elsewhere
+    Symbol symbol;
+    if (!symbol_table_ || !symbol_table_->lookup(var->name, function_name, symbol)) return "";
+    if (symbol.function_name != function_name || symbol.kind != SymbolKind::LOCAL_VAR) return "";
+    return it->second;
+}
+
+std::string DevirtualizationPass::static_class_of(const Expression* receiver, const std::string& function_name) const {
+    if (auto* new_expr = dynamic_cast<const NewExpression*>(receiver)) {
+        return new_expr->class_name;
+    }
+    Symbol symbol;
+    auto* var = dynamic_cast<const VariableAccess*>(receiver);
+    if (var && symbol_table_ && symbol_table_->lookup(var->name, function_name, symbol)) {
+        return symbol.class_name;
+    }
+    return "";
+}
+
+void DevirtualizationPass::debug_print(const std::string& message) {
+    if (trace_enabled_) {
+        std::cout << "[DevirtualizationPass] " << message << std::endl;
+    }
+}
+
+void DevirtualizationPass::print_statistics() {
+    if (trace_enabled_) {
+        std::cout << "\n[DevirtualizationPass] Statistics:" << std::endl;
+        std::cout << "  Functions processed: " << stats_.functions_processed << std::endl;
+        std::cout << "  Method calls: " << stats_.method_calls << std::endl;
+        std::cout << "  Receivers of exact class: " << stats_.exact_receivers << std::endl;
+        std::cout << "  Calls with a unique target: " << stats_.unique_targets << std::endl;
+    }
+}
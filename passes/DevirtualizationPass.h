@@ -0,0 +1,85 @@
+#ifndef DEVIRTUALIZATION_PASS_H
+#define DEVIRTUALIZATION_PASS_H
+
+#include "../ControlFlowGraph.h"
+#include "../BasicBlock.h"
+#include "../SymbolTable.h"
+#include "../ClassTable.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <string>
+#include <vector>
+
+// DevirtualizationPass finds method calls whose receiver is an object of
+// exactly one class, and records that class in the call's
+// MemberAccessExpression::exact_class_name. NewCodeGenerator then calls the
+// method from that class's vtable blueprint with a direct BL.
+//
+// A receiver's class is exact when the receiver is a NEW expression, or a
+// local of the function whose address is never taken and whose every
+// assignment (LET initializers included, as CFGBuilderPass lowers them) is
+// NEW of the same class.
+//
+// Calls the pass cannot pin down still avoid the vtable when no class below
+// the receiver's static class overrides the method (see
+// ClassTable::unique_method_target), and otherwise get a monomorphic guard;
+// both are decided in NewCodeGenerator::emit_method_dispatch.
+class DevirtualizationPass {
+public:
+    DevirtualizationPass(SymbolTable* symbol_table, ClassTable* class_table, bool trace_enabled = false);
+
+    // Run the pass on all CFGs
+    void run(std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>& cfgs);
+
+    // Run the pass on a single function's CFG
+    void optimize_cfg(const std::string& function_name, ControlFlowGraph& cfg);
+
+    std::string getName() const { return "Devirtualization Pass"; }
+
+private:
+    SymbolTable* symbol_table_;
+    ClassTable* class_table_;
+    bool trace_enabled_;
+
+    // Statistics for reporting
+    struct Statistics {
+        int functions_processed = 0;
+        int method_calls = 0;
+        int exact_receivers = 0;
+        int unique_targets = 0;
+
+        void reset() {
+            functions_processed = 0;
+            method_calls = 0;
+            exact_receivers = 0;
+            unique_targets = 0;
+        }
+    } stats_;
+
+    // What a walk over the function's statements found
+    struct FunctionFacts {
+        std::unordered_map<std::string, std::string> new_classes; // Variable -> class of every NEW assigned to it
+        std::unordered_set<std::string> inexact;                  // Variables assigned anything else, or with @ taken
+        std::vector<MemberAccessExpression*> calls;               // Method calls, by their callee
+        bool opaque = false;                                      // Holds a node the walk does not understand
+    };
+
+    void debug_print(const std::string& message);
+
+    void walk_statement(Statement* stmt, FunctionFacts& facts);
+    void walk_expression(Expression* expr, FunctionFacts& facts);
+    void record_assignment(const std::string& name, const Expression* value, FunctionFacts& facts);
+    void record_call(Expression* callee, FunctionFacts& facts);
+
+    // The class of every object the receiver can be, or "" if unknown
+    std::string exact_class_of(const Expression* receiver, const std::string& function_name,
+                               const FunctionFacts& facts) const;
+
+    // The receiver's class as NewCodeGenerator sees it, for trace output
+    std::string static_class_of(const Expression* receiver, const std::string& function_name) const;
+
+    void print_statistics();
+};
+
+#endif // DEVIRTUALIZATION_PASS_H
@@ -0,0 +1,299 @@
+#include "ForLoopAnalysis.h"
+#include "../AST.h"
+#include <algorithm>
+
+bool ForLoopAnalysis::analyze(const std::string& function_name, ControlFlowGraph& cfg, std::string& opaque_block) {
+    function_name_ = function_name;
+    blocks_.clear();
+    facts_.clear();
+    address_taken_.clear();
+
+    for (const auto& pair : cfg.blocks) {
+        blocks_.push_back(pair.second.get());
+    }
+    std::sort(blocks_.begin(), blocks_.end(), [](BasicBlock* a, BasicBlock* b) { return a->id < b->id; });
+
+    for (BasicBlock* block : blocks_) {
+        BlockFacts& facts = facts_[block];
+        for (const auto& stmt : block->statements) {
+            walk_statement(stmt.get(), facts);
+        }
+        if (facts.opaque) {
+            opaque_block = block->id;
+            return false;
+        }
+        address_taken_.insert(facts.address_taken.begin(), facts.address_taken.end());
+    }
+    return true;
+}
+
+const ForLoopAnalysis::BlockFacts& ForLoopAnalysis::facts(BasicBlock* block) const {
+    static const BlockFacts none;
+    auto it = facts_.find(block);
+    return it == facts_.end() ? none : it->second;
+}
+
+void ForLoopAnalysis::walk_statement(Statement* stmt, BlockFacts& facts) {
+    if (auto* assign = dynamic_cast<AssignmentStatement*>(stmt)) {
+        for (const auto& lhs : assign->lhs) {
+            if (auto* var = dynamic_cast<VariableAccess*>(lhs.get())) {
+                facts.assigned[var->name]++;
+            } else if (auto* store = dynamic_cast<VectorAccess*>(lhs.get())) {
+                // Stores are not bounds checked, so only their operands matter
+                walk_expression(store->vector_expr.get(), facts, false);
+                walk_expression(store->index_expr.get(), facts, false);
+            } else {
+                walk_expression(lhs.get(), facts, false);
+            }
+        }
+        for (const auto& rhs : assign->rhs) {
+            walk_expression(rhs.get(), facts, false);
+        }
+    } else if (auto* call = dynamic_cast<RoutineCallStatement*>(stmt)) {
+        // The scope calls SAMM injects around blocks do not touch program state
+        auto* routine = dynamic_cast<VariableAccess*>(call->routine_expr.get());
+        if (!routine || (routine->name != "HeapManager_enter_scope" && routine->name != "HeapManager_exit_scope")) {
+            facts.has_call = true;
+        }
+        if (!routine) walk_expression(call->routine_expr.get(), facts, false);
+        for (const auto& arg : call->arguments) {
+            walk_expression(arg.get(), facts, false);
+        }
+    } else if (auto* if_stmt = dynamic_cast<IfStatement*>(stmt)) {
+        // Condition statements end their block; their branches are in other blocks
+        walk_expression(if_stmt->condition.get(), facts, false);
+    } else if (auto* unless_stmt = dynamic_cast<UnlessStatement*>(stmt)) {
+        walk_expression(unless_stmt->condition.get(), facts, false);
+    } else if (auto* test_stmt = dynamic_cast<TestStatement*>(stmt)) {
+        walk_expression(test_stmt->condition.get(), facts, false);
+    } else if (auto* while_stmt = dynamic_cast<WhileStatement*>(stmt)) {
+        walk_expression(while_stmt->condition.get(), facts, false);
+    } else if (auto* until_stmt = dynamic_cast<UntilStatement*>(stmt)) {
+        walk_expression(until_stmt->condition.get(), facts, false);
+    } else if (auto* repeat_stmt = dynamic_cast<RepeatStatement*>(stmt)) {
+        walk_expression(repeat_stmt->condition.get(), facts, false);
+    } else if (auto* for_stmt = dynamic_cast<ForStatement*>(stmt)) {
+        // A loop header evaluates only its end expression, after the loop
+        // variable may have passed the limit
+        walk_expression(for_stmt->end_expr.get(), facts, true);
+    } else if (auto* branch = dynamic_cast<ConditionalBranchStatement*>(stmt)) {
+        walk_expression(branch->condition_expr.get(), facts, false);
+    } else if (auto* switchon = dynamic_cast<SwitchonStatement*>(stmt)) {
+        walk_expression(switchon->expression.get(), facts, false);
+    } else if (auto* resultis = dynamic_cast<ResultisStatement*>(stmt)) {
+        walk_expression(resultis->expression.get(), facts, false);
+    } else if (auto* goto_stmt = dynamic_cast<GotoStatement*>(stmt)) {
+        walk_expression(goto_stmt->label_expr.get(), facts, false);
+    } else if (auto* free_stmt = dynamic_cast<FreeStatement*>(stmt)) {
+        facts.has_call = true;
+        walk_expression(free_stmt->list_expr.get(), facts, false);
+    } else if (auto* finish = dynamic_cast<FinishStatement*>(stmt)) {
+        facts.has_call = true;
+        for (const auto& arg : finish->arguments) {
+            walk_expression(arg.get(), facts, false);
+        }
+    } else if (dynamic_cast<ReturnStatement*>(stmt) || dynamic_cast<BreakStatement*>(stmt) ||
+               dynamic_cast<LoopStatement*>(stmt) || dynamic_cast<EndcaseStatement*>(stmt) ||
+               dynamic_cast<BrkStatement*>(stmt) || dynamic_cast<LabelTargetStatement*>(stmt)) {
+        // Control transfer only
+    } else {
+        facts.opaque = true;
+    }
+}
+
+void ForLoopAnalysis::walk_expression(Expression* expr, BlockFacts& facts, bool conditional) {
+    if (!expr) return;
+
+    if (dynamic_cast<NumberLiteral*>(expr) || dynamic_cast<StringLiteral*>(expr) ||
+        dynamic_cast<CharLiteral*>(expr) || dynamic_cast<BooleanLiteral*>(expr) ||
+        dynamic_cast<NullLiteral*>(expr) || dynamic_cast<VariableAccess*>(expr)) {
+        return;
+    }
+    if (auto* bin = dynamic_cast<BinaryOp*>(expr)) {
+        bool short_circuit = bin->op == BinaryOp::Operator::LogicalAnd || bin->op == BinaryOp::Operator::LogicalOr;
+        walk_expression(bin->left.get(), facts, conditional);
+        walk_expression(bin->right.get(), facts, conditional || short_circuit);
+    } else if (auto* un = dynamic_cast<UnaryOp*>(expr)) {
+        auto* operand = dynamic_cast<VariableAccess*>(un->operand.get());
+        if (un->op == UnaryOp::Operator::AddressOf && operand) {
+            facts.address_taken.insert(operand->name);
+        } else {
+            walk_expression(un->operand.get(), facts, conditional);
+        }
+    } else if (auto* access = dynamic_cast<VectorAccess*>(expr)) {
+        walk_expression(access->vector_expr.get(), facts, conditional);
+        walk_expression(access->index_expr.get(), facts, conditional);
+        facts.reads.push_back({access, !conditional});
+    } else if (auto* char_ind = dynamic_cast<CharIndirection*>(expr)) {
+        walk_expression(char_ind->string_expr.get(), facts, conditional);
+        walk_expression(char_ind->index_expr.get(), facts, conditional);
+    } else if (auto* float_ind = dynamic_cast<FloatVectorIndirection*>(expr)) {
+        walk_expression(float_ind->vector_expr.get(), facts, conditional);
+        walk_expression(float_ind->index_expr.get(), facts, conditional);
+    } else if (auto* cond = dynamic_cast<ConditionalExpression*>(expr)) {
+        walk_expression(cond->condition.get(), facts, conditional);
+        walk_expression(cond->true_expr.get(), facts, true);
+        walk_expression(cond->false_expr.get(), facts, true);
+    } else if (auto* call = dynamic_cast<FunctionCall*>(expr)) {
+        facts.has_call = true;
+        if (!dynamic_cast<VariableAccess*>(call->function_expr.get())) {
+            walk_expression(call->function_expr.get(), facts, conditional);
+        }
+        for (const auto& arg : call->arguments) {
+            walk_expression(arg.get(), facts, conditional);
+        }
+    } else if (auto* sys = dynamic_cast<SysCall*>(expr)) {
+        facts.has_call = true;
+        for (const auto& arg : sys->arguments) {
+            walk_expression(arg.get(), facts, conditional);
+        }
+    } else if (auto* vec = dynamic_cast<VecAllocationExpression*>(expr)) {
+        facts.has_call = true;
+        walk_expression(vec->size_expr.get(), facts, conditional);
+    } else if (auto* fvec = dynamic_cast<FVecAllocationExpression*>(expr)) {
+        facts.has_call = true;
+        walk_expression(fvec->size_expr.get(), facts, conditional);
+    } else if (auto* str = dynamic_cast<StringAllocationExpression*>(expr)) {
+        facts.has_call = true;
+        walk_expression(str->size_expr.get(), facts, conditional);
+    } else if (auto* table = dynamic_cast<TableExpression*>(expr)) {
+        facts.has_call = true;
+        for (const auto& init : table->initializers) {
+            walk_expression(init.get(), facts, conditional);
+        }
+    } else {
+        facts.opaque = true;
+    }
+}
+
+bool ForLoopAnalysis::find_loop(BasicBlock* header, Loop& loop) const {
+    if (header->statements.empty() || header->successors.size() != 2) return false;
+    loop.for_stmt = dynamic_cast<const ForStatement*>(header->statements.back().get());
+    if (!loop.for_stmt || !loop.for_stmt->end_expr) return false;
+    loop.header = header;
+    loop.variable = header->loop_variable;
+
+    for (BasicBlock* pred : header->predecessors) {
+        if (pred->is_increment_block && pred->loop_variable == loop.variable) {
+            if (loop.increment) return false;
+            loop.increment = pred;
+        } else {
+            if (loop.preheader) return false;
+            loop.preheader = pred;
+        }
+    }
+    if (!loop.increment || !loop.preheader) return false;
+
+    // The natural loop of the back edge: every block that reaches the
+    // increment without passing through the header
+    loop.blocks.insert(header);
+    std::vector<BasicBlock*> worklist{loop.increment};
+    while (!worklist.empty()) {
+        BasicBlock* block = worklist.back();
+        worklist.pop_back();
+        if (!loop.blocks.insert(block).second) continue;
+        for (BasicBlock* pred : block->predecessors) {
+            worklist.push_back(pred);
+        }
+    }
+    if (loop.blocks.count(loop.preheader)) return false;
+
+    // The increment is "i := i + k" for a positive constant k
+    if (loop.increment->statements.size() != 1) return false;
+    auto* incr = dynamic_cast<const AssignmentStatement*>(loop.increment->statements[0].get());
+    if (!incr || incr->lhs.size() != 1 || incr->rhs.size() != 1) return false;
+    auto* incr_var = dynamic_cast<const VariableAccess*>(incr->lhs[0].get());
+    auto* sum = dynamic_cast<const BinaryOp*>(incr->rhs[0].get());
+    if (!incr_var || incr_var->name != loop.variable || !sum || sum->op != BinaryOp::Operator::Add) return false;
+    auto* sum_var = dynamic_cast<const VariableAccess*>(sum->left.get());
+    auto* step = dynamic_cast<const NumberLiteral*>(sum->right.get());
+    if (!sum_var || sum_var->name != loop.variable || !step ||
+        step->literal_type != NumberLiteral::LiteralType::Integer || step->int_value <= 0) {
+        return false;
+    }
+    loop.step = step->int_value;
+
+    // The preheader ends with "i := start"
+    if (loop.preheader->statements.empty()) return false;
+    auto* init = dynamic_cast<const AssignmentStatement*>(loop.preheader->statements.back().get());
+    if (!init || init->lhs.size() != 1 || init->rhs.size() != 1) return false;
+    auto* init_var = dynamic_cast<const VariableAccess*>(init->lhs[0].get());
+    if (!init_var || init_var->name != loop.variable) return false;
+    auto* start = dynamic_cast<const NumberLiteral*>(init->rhs[0].get());
+    if (start && start->literal_type == NumberLiteral::LiteralType::Integer) {
+        loop.start_is_constant = true;
+        loop.start = start->int_value;
+    }
+
+    // Nothing but the increment may write the loop variable
+    return assignments_in_loop(loop.variable, loop) == 1 && !address_taken_.count(loop.variable);
+}
+
+bool ForLoopAnalysis::is_tracked_variable(const std::string& name, Symbol& symbol) const {
+    if (!symbol_table_ || address_taken_.count(name)) return false;
+    if (!symbol_table_->lookup(name, function_name_, symbol)) return false;
+    return symbol.function_name == function_name_ &&
+           (symbol.kind == SymbolKind::LOCAL_VAR || symbol.kind == SymbolKind::PARAMETER);
+}
+
+bool ForLoopAnalysis::is_invariant_vector(const std::string& name, const Loop& loop) const {
+    Symbol symbol;
+    if (name == loop.variable || !is_tracked_variable(name, symbol)) return false;
+    if (symbol.type != VarType::POINTER_TO_INT_VEC && symbol.type != VarType::POINTER_TO_FLOAT_VEC) return false;
+    return assignments_in_loop(name, loop) == 0;
+}
+
+bool ForLoopAnalysis::is_invariant(const Expression* expr, const Loop& loop) const {
+    if (auto* lit = dynamic_cast<const NumberLiteral*>(expr)) {
+        return lit->literal_type == NumberLiteral::LiteralType::Integer;
+    }
+    if (auto* var = dynamic_cast<const VariableAccess*>(expr)) {
+        Symbol symbol;
+        return var->name != loop.variable && is_tracked_variable(var->name, symbol) &&
+               assignments_in_loop(var->name, loop) == 0;
+    }
+    if (auto* un = dynamic_cast<const UnaryOp*>(expr)) {
+        if (un->op == UnaryOp::Operator::LengthOf) {
+            auto* var = dynamic_cast<const VariableAccess*>(un->operand.get());
+            return var && is_invariant_vector(var->name, loop);
+        }
+        return un->op == UnaryOp::Operator::Negate && is_invariant(un->operand.get(), loop);
+    }
+    if (auto* bin = dynamic_cast<const BinaryOp*>(expr)) {
+        return (bin->op == BinaryOp::Operator::Add || bin->op == BinaryOp::Operator::Subtract ||
+                bin->op == BinaryOp::Operator::Multiply) &&
+               is_invariant(bin->left.get(), loop) && is_invariant(bin->right.get(), loop);
+    }
+    return false;
+}
+
+int ForLoopAnalysis::assignments_in_loop(const std::string& name, const Loop& loop) const {
+    int count = 0;
+    for (BasicBlock* block : loop.blocks) {
+        auto facts = facts_.find(block);
+        if (facts == facts_.end()) continue;
+        auto it = facts->second.assigned.find(name);
+        if (it != facts->second.assigned.end()) count += it->second;
+    }
+    return count;
+}
+
+bool ForLoopAnalysis::runs_every_iteration(BasicBlock* block, const Loop& loop) const {
+    BasicBlock* body = loop.header->successors[0];
+    if (block == body || block == loop.increment) return true;
+    if (!loop.blocks.count(body)) return false;
+
+    // Look for a way round the block
+    std::unordered_set<BasicBlock*> seen{loop.header, block};
+    std::vector<BasicBlock*> worklist{body};
+    while (!worklist.empty()) {
+        BasicBlock* current = worklist.back();
+        worklist.pop_back();
+        if (!seen.insert(current).second) continue;
+        if (current == loop.increment) return false;
+        for (BasicBlock* succ : current->successors) {
+            if (loop.blocks.count(succ)) worklist.push_back(succ);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,91 @@
+#ifndef FOR_LOOP_ANALYSIS_H
+#define FOR_LOOP_ANALYSIS_H
+
+#include "../ControlFlowGraph.h"
+#include "../BasicBlock.h"
+#include "../SymbolTable.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <string>
+#include <vector>
+
+// ForLoopAnalysis finds the FOR loops CFGBuilderPass builds in one
+// function's CFG, and records for every block which variables its statements
+// write, which have their address taken and which vectors it reads.
+// BoundsCheckEliminationPass and LoopVectorizationPass use it to decide what
+// a loop can change.
+//
+// Only locals and parameters of the function whose address is never taken
+// are "tracked": nothing outside the loop's own statements can change them.
+class ForLoopAnalysis {
+public:
+    // A vector read and whether the block always evaluates it
+    struct VectorRead {
+        VectorAccess* access;
+        bool unconditional;
+    };
+
+    // What a walk over the statements of a block found
+    struct BlockFacts {
+        std::unordered_map<std::string, int> assigned; // Variables written, and how often
+        std::unordered_set<std::string> address_taken; // Operands of @
+        std::vector<VectorRead> reads;
+        bool has_call = false; // Calls a function or allocates
+        bool opaque = false;   // Holds a node the walk does not understand
+    };
+
+    // A FOR loop found from its header block
+    struct Loop {
+        BasicBlock* header = nullptr;
+        BasicBlock* increment = nullptr;
+        BasicBlock* preheader = nullptr;
+        const ForStatement* for_stmt = nullptr;
+        std::unordered_set<BasicBlock*> blocks; // Header, body and increment
+        std::string variable;
+        bool start_is_constant = false;
+        int64_t start = 0;
+        int64_t step = 0;
+    };
+
+    explicit ForLoopAnalysis(SymbolTable* symbol_table) : symbol_table_(symbol_table) {}
+
+    // Walks every block of the function. Returns false, naming the block in
+    // opaque_block, if a statement holds a node the walk does not understand:
+    // it might take an address or write a variable.
+    bool analyze(const std::string& function_name, ControlFlowGraph& cfg, std::string& opaque_block);
+
+    // The function's blocks, sorted by id for deterministic output
+    const std::vector<BasicBlock*>& blocks() const { return blocks_; }
+
+    const BlockFacts& facts(BasicBlock* block) const;
+
+    // Fill in a Loop from a header block; false if the loop does not have
+    // the shape CFGBuilderPass gives a FOR loop
+    bool find_loop(BasicBlock* header, Loop& loop) const;
+
+    // A local or parameter of this function whose address is never taken
+    bool is_tracked_variable(const std::string& name, Symbol& symbol) const;
+
+    // A tracked vector the loop never reassigns
+    bool is_invariant_vector(const std::string& name, const Loop& loop) const;
+
+    // An expression whose value is the same on every iteration of the loop
+    bool is_invariant(const Expression* expr, const Loop& loop) const;
+
+    int assignments_in_loop(const std::string& name, const Loop& loop) const;
+
+    // True if every path from the body's first block to the increment passes through block
+    bool runs_every_iteration(BasicBlock* block, const Loop& loop) const;
+
+private:
+    SymbolTable* symbol_table_;
+    std::string function_name_;
+    std::vector<BasicBlock*> blocks_;
+    std::unordered_map<BasicBlock*, BlockFacts> facts_;
+    std::unordered_set<std::string> address_taken_;
+
+    void walk_statement(Statement* stmt, BlockFacts& facts);
+    void walk_expression(Expression* expr, BlockFacts& facts, bool conditional);
+};
+
+#endif // FOR_LOOP_ANALYSIS_H
@@ -0,0 +1,834 @@
+#include "FunctionInliningPass.h"
+#include "../AST.h"
+#include <functional>
+#include <iostream>
+
+namespace {
+
+ExprPtr clone_expr(const Expression* expr) {
+    return expr ? ExprPtr(static_cast<Expression*>(expr->clone().release())) : nullptr;
+}
+
+StmtPtr clone_stmt(const Statement* stmt) {
+    return stmt ? StmtPtr(static_cast<Statement*>(stmt->clone().release())) : nullptr;
+}
+
+StmtPtr make_assignment(ExprPtr lhs, ExprPtr rhs) {
+    std::vector<ExprPtr> lhs_vec, rhs_vec;
+    lhs_vec.push_back(std::move(lhs));
+    rhs_vec.push_back(std::move(rhs));
+    return std::make_unique<AssignmentStatement>(std::move(lhs_vec), std::move(rhs_vec));
+}
+
+bool is_float_op(UnaryOp::Operator op) {
+    switch (op) {
+        case UnaryOp::Operator::FloatConvert:
+        case UnaryOp::Operator::FloatSqrt:
+        case UnaryOp::Operator::FloatFloor:
+        case UnaryOp::Operator::FloatTruncate:
+        case UnaryOp::Operator::HeadOfAsFloat:
+        case UnaryOp::Operator::TypeOf:
+        case UnaryOp::Operator::TypeAsString:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Calls the callbacks on every child slot of the node shapes BodyScan accepts
+void for_each_child(Expression* expr, const std::function<void(ExprPtr&)>& on_expr) {
+    if (auto* bin = dynamic_cast<BinaryOp*>(expr)) {
+        on_expr(bin->left);
+        on_expr(bin->right);
+    } else if (auto* un = dynamic_cast<UnaryOp*>(expr)) {
+        on_expr(un->operand);
+    } else if (auto* access = dynamic_cast<VectorAccess*>(expr)) {
+        on_expr(access->vector_expr);
+        on_expr(access->index_expr);
+    } else if (auto* char_ind = dynamic_cast<CharIndirection*>(expr)) {
+        on_expr(char_ind->string_expr);
+        on_expr(char_ind->index_expr);
+    } else if (auto* cond = dynamic_cast<ConditionalExpression*>(expr)) {
+        on_expr(cond->condition);
+        on_expr(cond->true_expr);
+        on_expr(cond->false_expr);
+    } else if (auto* call = dynamic_cast<FunctionCall*>(expr)) {
+        on_expr(call->function_expr);
+        for (auto& arg : call->arguments) on_expr(arg);
+    }
+}
+
+void for_each_child(Statement* stmt, const std::function<void(ExprPtr&)>& on_expr,
+                    const std::function<void(StmtPtr&)>& on_stmt) {
+    auto expr_if_set = [&](ExprPtr& expr) { if (expr) on_expr(expr); };
+    auto stmt_if_set = [&](StmtPtr& child) { if (child) on_stmt(child); };
+
+    if (auto* assign = dynamic_cast<AssignmentStatement*>(stmt)) {
+        for (auto& lhs : assign->lhs) on_expr(lhs);
+        for (auto& rhs : assign->rhs) on_expr(rhs);
+    } else if (auto* call = dynamic_cast<RoutineCallStatement*>(stmt)) {
+        on_expr(call->routine_expr);
+        for (auto& arg : call->arguments) on_expr(arg);
+    } else if (auto* if_stmt = dynamic_cast<IfStatement*>(stmt)) {
+        on_expr(if_stmt->condition);
+        stmt_if_set(if_stmt->then_branch);
+    } else if (auto* unless_stmt = dynamic_cast<UnlessStatement*>(stmt)) {
+        on_expr(unless_stmt->condition);
+        stmt_if_set(unless_stmt->then_branch);
+    } else if (auto* test_stmt = dynamic_cast<TestStatement*>(stmt)) {
+        on_expr(test_stmt->condition);
+        stmt_if_set(test_stmt->then_branch);
+        stmt_if_set(test_stmt->else_branch);
+    } else if (auto* while_stmt = dynamic_cast<WhileStatement*>(stmt)) {
+        on_expr(while_stmt->condition);
+        stmt_if_set(while_stmt->body);
+    } else if (auto* until_stmt = dynamic_cast<UntilStatement*>(stmt)) {
+        on_expr(until_stmt->condition);
+        stmt_if_set(until_stmt->body);
+    } else if (auto* repeat_stmt = dynamic_cast<RepeatStatement*>(stmt)) {
+        stmt_if_set(repeat_stmt->body);
+        expr_if_set(repeat_stmt->condition);
+    } else if (auto* for_stmt = dynamic_cast<ForStatement*>(stmt)) {
+        on_expr(for_stmt->start_expr);
+        on_expr(for_stmt->end_expr);
+        expr_if_set(for_stmt->step_expr);
+        stmt_if_set(for_stmt->body);
+    } else if (auto* switchon = dynamic_cast<SwitchonStatement*>(stmt)) {
+        on_expr(switchon->expression);
+        for (auto& case_stmt : switchon->cases) stmt_if_set(case_stmt->command);
+        if (switchon->default_case) stmt_if_set(switchon->default_case->command);
+    } else if (auto* block = dynamic_cast<BlockStatement*>(stmt)) {
+        for (auto& child : block->statements) stmt_if_set(child);
+    } else if (auto* compound = dynamic_cast<CompoundStatement*>(stmt)) {
+        for (auto& child : compound->statements) stmt_if_set(child);
+    } else if (auto* resultis = dynamic_cast<ResultisStatement*>(stmt)) {
+        on_expr(resultis->expression);
+    } else if (auto* finish = dynamic_cast<FinishStatement*>(stmt)) {
+        for (auto& arg : finish->arguments) on_expr(arg);
+    }
+}
+
+// What a walk over a callee body (or an argument) found
+struct BodyScan {
+    bool ok = true;
+    bool is_routine = false;
+    int size = 0;
+    int calls = 0;
+    std::set<std::string> called;
+    std::set<std::string> bound;
+    std::set<std::string> referenced;
+    std::set<std::string> address_taken;
+    std::map<std::string, int> uses;
+
+    enum class Construct { None, Loop, Switch };
+
+    void expression(Expression* expr) {
+        if (!ok) return;
+        if (!expr) { ok = false; return; }
+        size++;
+
+        if (auto* num = dynamic_cast<NumberLiteral*>(expr)) {
+            if (num->literal_type == NumberLiteral::LiteralType::Float) ok = false;
+            return;
+        }
+        if (dynamic_cast<StringLiteral*>(expr) || dynamic_cast<CharLiteral*>(expr) ||
+            dynamic_cast<BooleanLiteral*>(expr) || dynamic_cast<NullLiteral*>(expr)) {
+            return;
+        }
+        if (auto* var = dynamic_cast<VariableAccess*>(expr)) {
+            referenced.insert(var->name);
+            uses[var->name]++;
+            return;
+        }
+        if (auto* un = dynamic_cast<UnaryOp*>(expr)) {
+            if (is_float_op(un->op)) { ok = false; return; }
+            if (un->op == UnaryOp::Operator::AddressOf) {
+                if (auto* var = dynamic_cast<VariableAccess*>(un->operand.get())) {
+                    address_taken.insert(var->name);
+                }
+            }
+        } else if (auto* call = dynamic_cast<FunctionCall*>(expr)) {
+            calls++;
+            if (auto* var = dynamic_cast<VariableAccess*>(call->function_expr.get())) {
+                called.insert(var->name);
+            }
+        } else if (!dynamic_cast<BinaryOp*>(expr) && !dynamic_cast<VectorAccess*>(expr) &&
+                   !dynamic_cast<CharIndirection*>(expr) && !dynamic_cast<ConditionalExpression*>(expr)) {
+            ok = false;
+            return;
+        }
+        for_each_child(expr, [this](ExprPtr& child) { expression(child.get()); });
+    }
+
+    void statement(Statement* stmt, Construct innermost) {
+        if (!ok) return;
+        if (!stmt) { ok = false; return; }
+        size++;
+
+        Construct child_construct = innermost;
+        if (auto* assign = dynamic_cast<AssignmentStatement*>(stmt)) {
+            if (assign->lhs.size() != assign->rhs.size()) { ok = false; return; }
+        } else if (auto* call = dynamic_cast<RoutineCallStatement*>(stmt)) {
+            calls++;
+            if (auto* var = dynamic_cast<VariableAccess*>(call->routine_expr.get())) {
+                called.insert(var->name);
+            }
+        } else if (auto* for_stmt = dynamic_cast<ForStatement*>(stmt)) {
+            bound.insert(for_stmt->loop_variable);
+            child_construct = Construct::Loop;
+        } else if (dynamic_cast<WhileStatement*>(stmt) || dynamic_cast<UntilStatement*>(stmt) ||
+                   dynamic_cast<RepeatStatement*>(stmt)) {
+            child_construct = Construct::Loop;
+        } else if (dynamic_cast<SwitchonStatement*>(stmt)) {
+            child_construct = Construct::Switch;
+        } else if (auto* block = dynamic_cast<BlockStatement*>(stmt)) {
+            for (const auto& decl : block->declarations) {
+                auto* let = dynamic_cast<LetDeclaration*>(decl.get());
+                if (!let || !let->initializers.empty() || let->is_float_declaration) { ok = false; return; }
+                for (const std::string& name : let->names) {
+                    // Renamed locals share one scope, so shadowing would merge two variables
+                    if (!bound.insert(name).second) { ok = false; return; }
+                }
+            }
+        } else if (dynamic_cast<ResultisStatement*>(stmt)) {
+            if (is_routine) { ok = false; return; }
+        } else if (dynamic_cast<ReturnStatement*>(stmt)) {
+            if (!is_routine) ok = false;
+            return;
+        } else if (dynamic_cast<BreakStatement*>(stmt) || dynamic_cast<LoopStatement*>(stmt)) {
+            // Must not leave the inlined code for a loop of the caller
+            if (innermost != Construct::Loop) ok = false;
+            return;
+        } else if (dynamic_cast<EndcaseStatement*>(stmt)) {
+            if (innermost != Construct::Switch) ok = false;
+            return;
+        } else if (!dynamic_cast<IfStatement*>(stmt) && !dynamic_cast<UnlessStatement*>(stmt) &&
+                   !dynamic_cast<TestStatement*>(stmt) && !dynamic_cast<CompoundStatement*>(stmt) &&
+                   !dynamic_cast<FinishStatement*>(stmt)) {
+            ok = false;
+            return;
+        }
+        for_each_child(stmt,
+                       [this](ExprPtr& child) { expression(child.get()); },
+                       [this, child_construct](StmtPtr& child) { statement(child.get(), child_construct); });
+    }
+};
+
+bool contains_exit(Statement* stmt) {
+    if (dynamic_cast<ResultisStatement*>(stmt) || dynamic_cast<ReturnStatement*>(stmt)) return true;
+    bool found = false;
+    for_each_child(stmt, [](ExprPtr&) {}, [&found](StmtPtr& child) { found = found || contains_exit(child.get()); });
+    return found;
+}
+
+// Moves a scanned body's LET declarations out, turning its blocks into compounds
+void flatten_blocks(StmtPtr& stmt, std::vector<std::unique_ptr<LetDeclaration>>& locals) {
+    if (auto* block = dynamic_cast<BlockStatement*>(stmt.get())) {
+        for (auto& decl : block->declarations) {
+            locals.emplace_back(static_cast<LetDeclaration*>(decl.release()));
+        }
+        stmt = std::make_unique<CompoundStatement>(std::move(block->statements));
+    }
+    for_each_child(stmt.get(), [](ExprPtr&) {},
+                   [&locals](StmtPtr& child) { flatten_blocks(child, locals); });
+}
+
+void rename_expr(ExprPtr& expr, const std::string& prefix, const std::set<std::string>& bound) {
+    if (auto* var = dynamic_cast<VariableAccess*>(expr.get())) {
+        if (bound.count(var->name)) var->name = prefix + var->name;
+        return;
+    }
+    for_each_child(expr.get(), [&](ExprPtr& child) { rename_expr(child, prefix, bound); });
+}
+
+void rename_stmt(StmtPtr& stmt, const std::string& prefix, const std::set<std::string>& bound) {
+    if (auto* for_stmt = dynamic_cast<ForStatement*>(stmt.get())) {
+        for_stmt->loop_variable = prefix + for_stmt->loop_variable;
+    }
+    for_each_child(stmt.get(),
+                   [&](ExprPtr& child) { rename_expr(child, prefix, bound); },
+                   [&](StmtPtr& child) { rename_stmt(child, prefix, bound); });
+}
+
+void substitute_parameters(ExprPtr& expr, const std::map<std::string, const Expression*>& arguments) {
+    if (auto* var = dynamic_cast<VariableAccess*>(expr.get())) {
+        auto it = arguments.find(var->name);
+        if (it != arguments.end()) expr = clone_expr(it->second);
+        return;
+    }
+    for_each_child(expr.get(), [&](ExprPtr& child) { substitute_parameters(child, arguments); });
+}
+
+using ExitBuilder = std::function<StmtPtr(ExprPtr)>;
+
+// Rewrites stmts[from..] so that each RESULTIS/RETURN becomes finish(value)
+// as the last thing run. Fails unless every exit is in tail position;
+// `exits` tells whether every path through the result ends in one.
+bool lower_exits(std::vector<StmtPtr>& stmts, size_t from, const ExitBuilder& finish,
+                 std::vector<StmtPtr>& out, bool& exits) {
+    exits = false;
+    for (size_t i = from; i < stmts.size(); ++i) {
+        StmtPtr& stmt = stmts[i];
+        if (!contains_exit(stmt.get())) {
+            out.push_back(std::move(stmt));
+            continue;
+        }
+
+        if (auto* resultis = dynamic_cast<ResultisStatement*>(stmt.get())) {
+            out.push_back(finish(std::move(resultis->expression)));
+            exits = true;
+            return true;
+        }
+        if (dynamic_cast<ReturnStatement*>(stmt.get())) {
+            exits = true;
+            return true;
+        }
+        if (auto* compound = dynamic_cast<CompoundStatement*>(stmt.get())) {
+            std::vector<StmtPtr> spliced = std::move(compound->statements);
+            for (size_t j = i + 1; j < stmts.size(); ++j) spliced.push_back(std::move(stmts[j]));
+            return lower_exits(spliced, 0, finish, out, exits);
+        }
+
+        ExprPtr condition;
+        StmtPtr then_branch, else_branch;
+        bool negate = false;
+        if (auto* test_stmt = dynamic_cast<TestStatement*>(stmt.get())) {
+            condition = std::move(test_stmt->condition);
+            then_branch = std::move(test_stmt->then_branch);
+            else_branch = std::move(test_stmt->else_branch);
+        } else if (auto* if_stmt = dynamic_cast<IfStatement*>(stmt.get())) {
+            condition = std::move(if_stmt->condition);
+            then_branch = std::move(if_stmt->then_branch);
+        } else if (auto* unless_stmt = dynamic_cast<UnlessStatement*>(stmt.get())) {
+            condition = std::move(unless_stmt->condition);
+            then_branch = std::move(unless_stmt->then_branch);
+            negate = true;
+        } else {
+            return false; // An exit inside a loop or SWITCHON
+        }
+
+        std::vector<StmtPtr> then_in, else_in, then_out, else_out;
+        then_in.push_back(std::move(then_branch));
+        if (else_branch) else_in.push_back(std::move(else_branch));
+        bool then_exits = false, else_exits = false;
+        if (!lower_exits(then_in, 0, finish, then_out, then_exits) ||
+            !lower_exits(else_in, 0, finish, else_out, else_exits)) {
+            return false;
+        }
+
+        // The arm that falls through runs the rest of the sequence
+        if (then_exits && else_exits) {
+            exits = true;
+        } else if (then_exits || else_exits) {
+            std::vector<StmtPtr>& falls_through = then_exits ? else_out : then_out;
+            if (!lower_exits(stmts, i + 1, finish, falls_through, exits)) return false;
+        } else {
+            return false;
+        }
+
+        StmtPtr then_stmt = std::make_unique<CompoundStatement>(std::move(then_out));
+        StmtPtr else_stmt = std::make_unique<CompoundStatement>(std::move(else_out));
+        if (negate) std::swap(then_stmt, else_stmt);
+        out.push_back(std::make_unique<TestStatement>(std::move(condition), std::move(then_stmt), std::move(else_stmt)));
+        return true;
+    }
+    return true;
+}
+
+// Counts the calls to each name across the program
+class CallSiteCounter : public Optimizer {
+public:
+    CallSiteCounter(std::unordered_map<std::string, int64_t>& manifests, std::map<std::string, int>& counts)
+        : Optimizer(manifests), counts_(counts) {}
+
+    std::string getName() const override { return "Call Site Counter"; }
+
+    void visit(FunctionCall& node) override {
+        count(node.function_expr.get());
+        Optimizer::visit(node);
+    }
+
+    void visit(RoutineCallStatement& node) override {
+        count(node.routine_expr.get());
+        Optimizer::visit(node);
+    }
+
+private:
+    std::map<std::string, int>& counts_;
+
+    void count(const Expression* callee) {
+        if (auto* var = dynamic_cast<const VariableAccess*>(callee)) counts_[var->name]++;
+    }
+};
+
+} // namespace
+
+FunctionInliningPass::FunctionInliningPass(std::unordered_map<std::string, int64_t>& manifests,
+                                           SymbolTable* symbol_table,
+                                           ASTAnalyzer& analyzer,
+                                           bool trace_enabled)
+    : Optimizer(manifests), symbol_table_(symbol_table), analyzer_(analyzer), trace_enabled_(trace_enabled) {}
+
+ProgramPtr FunctionInliningPass::apply(ProgramPtr program) {
+    if (!program) return program;
+    debug_print("Starting Function Inlining Pass");
+    stats_.reset();
+    callees_.clear();
+
+    for (const auto& decl : program->declarations) {
+        if (auto* func = dynamic_cast<FunctionDeclaration*>(decl.get())) {
+            collect_candidate(func->name, func->parameters, func->body.get(), false, func->is_float_function);
+        } else if (auto* routine = dynamic_cast<RoutineDeclaration*>(decl.get())) {
+            collect_candidate(routine->name, routine->parameters, routine->body.get(), true, false);
+        }
+    }
+    if (callees_.empty()) {
+        print_statistics();
+        return program;
+    }
+
+    count_call_sites(program);
+    program = Optimizer::apply(std::move(program));
+
+    print_statistics();
+    debug_print("Function Inlining Pass completed");
+    return program;
+}
+
+void FunctionInliningPass::count_call_sites(ProgramPtr& program) {
+    std::map<std::string, int> counts;
+    CallSiteCounter counter(manifests_, counts);
+    program = counter.apply(std::move(program));
+    for (auto& pair : callees_) {
+        pair.second.call_sites = counts[pair.first];
+    }
+}
+
+bool FunctionInliningPass::has_plain_type(VarType type) const {
+    // Integers, strings and vectors of them: values that live in X registers
+    const int64_t plain = static_cast<int64_t>(VarType::INTEGER) | static_cast<int64_t>(VarType::STRING) |
+                          static_cast<int64_t>(VarType::VEC) | static_cast<int64_t>(VarType::TABLE) |
+                          static_cast<int64_t>(VarType::POINTER_TO) | static_cast<int64_t>(VarType::CONST);
+    return (static_cast<int64_t>(type) & ~plain) == 0;
+}
+
+void FunctionInliningPass::collect_candidate(const std::string& name, const std::vector<std::string>& parameters,
+                                             const ASTNode* body, bool is_routine, bool is_float) {
+    auto reject = [&](const std::string& why) { debug_print("  Not a candidate: " + name + " (" + why + ")"); };
+
+    if (is_float) return reject("FLET");
+    const auto& return_types = analyzer_.get_function_return_types();
+    auto return_it = return_types.find(name);
+    if (return_it != return_types.end() && !has_plain_type(return_it->second)) return reject("return type");
+
+    const auto& metrics = analyzer_.get_function_metrics();
+    auto metrics_it = metrics.find(name);
+    if (metrics_it != metrics.end()) {
+        for (const auto& pair : metrics_it->second.parameter_types) {
+            if (!has_plain_type(pair.second)) return reject("parameter " + pair.first);
+        }
+    }
+
+    // A FUNCTION's value becomes a RESULTIS, so both kinds are a statement list
+    Callee callee;
+    callee.name = name;
+    callee.parameters = parameters;
+    callee.is_routine = is_routine;
+    if (is_routine) {
+        callee.body.push_back(clone_stmt(static_cast<const Statement*>(body)));
+    } else if (auto* valof = dynamic_cast<const ValofExpression*>(body)) {
+        callee.body.push_back(clone_stmt(valof->body.get()));
+    } else if (body && !dynamic_cast<const FloatValofExpression*>(body)) {
+        callee.body.push_back(std::make_unique<ResultisStatement>(clone_expr(static_cast<const Expression*>(body))));
+    } else {
+        return reject("FVALOF");
+    }
+
+    BodyScan scan;
+    scan.is_routine = is_routine;
+    scan.bound.insert(parameters.begin(), parameters.end());
+    for (auto& stmt : callee.body) {
+        scan.statement(stmt.get(), BodyScan::Construct::None);
+    }
+    if (!scan.ok) return reject("body has nodes the pass does not inline");
+    if (scan.called.count(name)) return reject("recursive");
+    if (scan.calls > kMaxCalls) return reject("makes " + std::to_string(scan.calls) + " calls");
+    if (scan.size > kMaxInlineSize) return reject("size " + std::to_string(scan.size));
+
+    for (auto& stmt : callee.body) {
+        flatten_blocks(stmt, callee.locals);
+    }
+    for (const auto& let : callee.locals) {
+        if (!has_plain_type(let->explicit_type)) return reject("local type");
+    }
+
+    callee.bound_names = scan.bound;
+    for (const std::string& referenced : scan.referenced) {
+        if (!scan.bound.count(referenced)) callee.free_names.insert(referenced);
+    }
+    callee.free_names.insert(scan.called.begin(), scan.called.end());
+
+    if (symbol_table_) {
+        // The body's own variables, then whatever it reads or calls from outside
+        for (const std::string& bound : callee.bound_names) {
+            const Symbol* symbol = symbol_table_->find(bound, name);
+            if (symbol && symbol->function_name == name && !has_plain_type(symbol->type)) {
+                return reject("type of " + bound);
+            }
+        }
+        for (const std::string& free : callee.free_names) {
+            const Symbol* symbol = symbol_table_->find(free, "Global");
+            if (!symbol) continue;
+            switch (symbol->kind) {
+                case SymbolKind::FLOAT_FUNCTION:
+                case SymbolKind::RUNTIME_FLOAT_FUNCTION:
+                case SymbolKind::RUNTIME_FLOAT_ROUTINE:
+                case SymbolKind::RUNTIME_LIST_FUNCTION:
+                    return reject("uses " + free);
+                case SymbolKind::GLOBAL_VAR:
+                case SymbolKind::STATIC_VAR:
+                    if (!has_plain_type(symbol->type)) return reject("uses " + free);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    for (const std::string& param : parameters) {
+        callee.parameter_uses[param] = scan.uses.count(param) ? scan.uses[param] : 0;
+    }
+    callee.size = scan.size;
+    callee.calls = scan.calls;
+
+    // Statement inlining needs every exit in tail position; try it on a copy
+    std::vector<StmtPtr> trial, lowered;
+    for (const auto& stmt : callee.body) trial.push_back(clone_stmt(stmt.get()));
+    bool exits = false;
+    callee.lowerable = lower_exits(trial, 0, [](ExprPtr value) { return make_assignment(nullptr, std::move(value)); },
+                                   lowered, exits);
+
+    auto* only = callee.body.size() == 1 ? dynamic_cast<ResultisStatement*>(callee.body[0].get()) : nullptr;
+    callee.substitutable = only && callee.calls == 0 && callee.locals.empty();
+    for (const std::string& param : parameters) {
+        if (scan.address_taken.count(param)) callee.substitutable = false;
+    }
+
+    if (!callee.lowerable && !callee.substitutable) return reject("RESULTIS/RETURN not in tail position");
+
+    debug_print("  Candidate: " + name + " size " + std::to_string(callee.size) +
+                ", " + std::to_string(callee.calls) + " calls" +
+                (callee.substitutable ? ", substitutable" : ""));
+    stats_.candidates++;
+    callees_[name] = std::move(callee);
+}
+
+// --- Callers ---
+
+void FunctionInliningPass::visit(FunctionDeclaration& node) {
+    current_function_ = node.name;
+    caller_is_function_ = true;
+    loop_depth_ = 0;
+    growth_ = 0;
+    caller_scopes_.assign(1, std::set<std::string>(node.parameters.begin(), node.parameters.end()));
+    pending_declarations_.clear();
+    stats_.functions_processed++;
+
+    // Statement inlining only happens inside a VALOF, which takes the
+    // declarations itself (see visit(ValofExpression&))
+    node.body = visit_expr(std::move(node.body));
+    current_function_.clear();
+}
+
+void FunctionInliningPass::visit(RoutineDeclaration& node) {
+    current_function_ = node.name;
+    caller_is_function_ = false;
+    loop_depth_ = 0;
+    growth_ = 0;
+    caller_scopes_.assign(1, std::set<std::string>(node.parameters.begin(), node.parameters.end()));
+    pending_declarations_.clear();
+    stats_.functions_processed++;
+
+    node.body = visit_stmt(std::move(node.body));
+    if (!pending_declarations_.empty()) {
+        attach_pending_declarations(node.body);
+    }
+    current_function_.clear();
+}
+
+void FunctionInliningPass::attach_pending_declarations(StmtPtr& body) {
+    if (auto* block = dynamic_cast<BlockStatement*>(body.get())) {
+        for (auto& decl : pending_declarations_) block->declarations.push_back(std::move(decl));
+    } else {
+        std::vector<StmtPtr> statements;
+        statements.push_back(std::move(body));
+        body = std::make_unique<BlockStatement>(std::move(pending_declarations_), std::move(statements));
+    }
+    pending_declarations_.clear();
+}
+
+// Calls inlined inside a VALOF declare their temporaries in the VALOF's own
+// block, wherever the VALOF sits in the caller.
+void FunctionInliningPass::visit(ValofExpression& node) {
+    std::vector<DeclPtr> outer = std::move(pending_declarations_);
+    pending_declarations_.clear();
+    Optimizer::visit(node);
+    if (!pending_declarations_.empty()) {
+        attach_pending_declarations(node.body);
+    }
+    pending_declarations_ = std::move(outer);
+}
+
+void FunctionInliningPass::visit(BlockStatement& node) {
+    std::set<std::string> declared;
+    for (const auto& decl : node.declarations) {
+        if (auto* let = dynamic_cast<LetDeclaration*>(decl.get())) {
+            declared.insert(let->names.begin(), let->names.end());
+        }
+    }
+    caller_scopes_.push_back(std::move(declared));
+    Optimizer::visit(node);
+    caller_scopes_.pop_back();
+}
+
+void FunctionInliningPass::visit(ForStatement& node) {
+    caller_scopes_.push_back({node.loop_variable});
+    loop_depth_++;
+    Optimizer::visit(node);
+    loop_depth_--;
+    caller_scopes_.pop_back();
+}
+
+void FunctionInliningPass::visit(WhileStatement& node) {
+    loop_depth_++;
+    Optimizer::visit(node);
+    loop_depth_--;
+}
+
+void FunctionInliningPass::visit(UntilStatement& node) {
+    loop_depth_++;
+    Optimizer::visit(node);
+    loop_depth_--;
+}
+
+void FunctionInliningPass::visit(RepeatStatement& node) {
+    loop_depth_++;
+    Optimizer::visit(node);
+    loop_depth_--;
+}
+
+FunctionInliningPass::Callee* FunctionInliningPass::callee_for(const Expression* function_expr, size_t argument_count) {
+    if (current_function_.empty()) return nullptr;
+    auto* var = dynamic_cast<const VariableAccess*>(function_expr);
+    if (!var || var->name == current_function_) return nullptr;
+    auto it = callees_.find(var->name);
+    if (it == callees_.end() || it->second.parameters.size() != argument_count) return nullptr;
+    return &it->second;
+}
+
+bool FunctionInliningPass::fits_budget(const Callee& callee) const {
+    if (growth_ + callee.size > kCallerGrowthBudget) return false;
+    if (callee.size <= kAlwaysInlineSize) return true;
+    return callee.size <= kMaxInlineSize && (loop_depth_ > 0 || callee.call_sites <= kFewCallSites);
+}
+
+bool FunctionInliningPass::captures_caller_name(const Callee& callee) const {
+    // A local of the caller would shadow the global the body means
+    for (const auto& scope : caller_scopes_) {
+        for (const std::string& free : callee.free_names) {
+            if (scope.count(free)) return true;
+        }
+    }
+    return false;
+}
+
+bool FunctionInliningPass::can_inline(const Callee& callee, const std::vector<ExprPtr>& arguments) {
+    // Arguments are copied into locals, which must not take over an allocation
+    bool copyable = true;
+    for (const auto& arg : arguments) {
+        BodyScan arg_scan;
+        arg_scan.expression(arg.get());
+        copyable = copyable && arg_scan.ok;
+    }
+    if (copyable && fits_budget(callee) && !captures_caller_name(callee)) return true;
+    debug_print("  Keeping call to " + callee.name + " in " + current_function_);
+    stats_.calls_rejected++;
+    return false;
+}
+
+void FunctionInliningPass::visit(FunctionCall& node) {
+    Optimizer::visit(node);
+
+    // Only replace the node visit_expr is holding
+    if (current_transformed_node_.get() != &node) return;
+    Callee* callee = callee_for(node.function_expr.get(), node.arguments.size());
+    if (!callee || callee->is_routine || !callee->substitutable) return;
+    if (!fits_budget(*callee) || captures_caller_name(*callee)) return;
+
+    ExprPtr replacement = substitute_call(*callee, node);
+    if (!replacement) return;
+    debug_print("  Substituted " + callee->name + " into " + current_function_);
+    growth_ += callee->size;
+    stats_.calls_substituted++;
+    current_transformed_node_ = std::move(replacement); // Destroys node
+}
+
+ExprPtr FunctionInliningPass::substitute_call(const Callee& callee, FunctionCall& call) {
+    std::map<std::string, const Expression*> arguments;
+    for (size_t i = 0; i < callee.parameters.size(); ++i) {
+        const std::string& param = callee.parameters[i];
+        Expression* arg = call.arguments[i].get();
+        bool simple = dynamic_cast<VariableAccess*>(arg) || arg->is_literal();
+        if (!simple) {
+            // Evaluated once or not at all, so it must have no side effects
+            BodyScan arg_scan;
+            arg_scan.expression(arg);
+            if (!arg_scan.ok || arg_scan.calls > 0 || callee.parameter_uses.at(param) > 1) return nullptr;
+        }
+        arguments[param] = arg;
+    }
+
+    const auto* resultis = static_cast<const ResultisStatement*>(callee.body[0].get());
+    ExprPtr result = clone_expr(resultis->expression.get());
+    substitute_parameters(result, arguments);
+    return result;
+}
+
+void FunctionInliningPass::visit(AssignmentStatement& node) {
+    Optimizer::visit(node);
+
+    if (current_transformed_node_.get() != &node) return;
+    if (node.lhs.size() != 1 || node.rhs.size() != 1) return;
+    auto* call = dynamic_cast<FunctionCall*>(node.rhs[0].get());
+    if (!call) return;
+    Callee* callee = callee_for(call->function_expr.get(), call->arguments.size());
+    if (!callee || callee->is_routine || !callee->lowerable || !stable_target(node.lhs[0].get())) return;
+    if (!can_inline(*callee, call->arguments)) return;
+
+    current_transformed_node_ = inline_call(*callee, call->arguments, &node.lhs[0], false);
+}
+
+void FunctionInliningPass::visit(RoutineCallStatement& node) {
+    Optimizer::visit(node);
+
+    if (current_transformed_node_.get() != &node) return;
+    Callee* callee = callee_for(node.routine_expr.get(), node.arguments.size());
+    if (!callee || !callee->is_routine || !callee->lowerable) return;
+    if (!can_inline(*callee, node.arguments)) return;
+
+    current_transformed_node_ = inline_call(*callee, node.arguments, nullptr, false);
+}
+
+void FunctionInliningPass::visit(ResultisStatement& node) {
+    node.expression = visit_expr(std::move(node.expression));
+
+    if (current_transformed_node_.get() != &node || !caller_is_function_) return;
+    auto* call = dynamic_cast<FunctionCall*>(node.expression.get());
+    if (!call) return;
+    Callee* callee = callee_for(call->function_expr.get(), call->arguments.size());
+    if (!callee || callee->is_routine || !callee->lowerable) return;
+    if (!can_inline(*callee, call->arguments)) return;
+
+    current_transformed_node_ = inline_call(*callee, call->arguments, nullptr, true);
+}
+
+bool FunctionInliningPass::stable_target(const Expression* lhs) const {
+    // Stored after the body runs, so it may only read what the callee cannot write
+    if (dynamic_cast<const VariableAccess*>(lhs)) return true;
+    auto local_or_literal = [this](const Expression* expr) {
+        if (expr->is_literal()) return true;
+        auto* var = dynamic_cast<const VariableAccess*>(expr);
+        if (!var) return false;
+        for (const auto& scope : caller_scopes_) {
+            if (scope.count(var->name)) return true;
+        }
+        return false;
+    };
+    if (auto* access = dynamic_cast<const VectorAccess*>(lhs)) {
+        return local_or_literal(access->vector_expr.get()) && local_or_literal(access->index_expr.get());
+    }
+    if (auto* char_ind = dynamic_cast<const CharIndirection*>(lhs)) {
+        return local_or_literal(char_ind->string_expr.get()) && local_or_literal(char_ind->index_expr.get());
+    }
+    return false;
+}
+
+StmtPtr FunctionInliningPass::inline_call(const Callee& callee, std::vector<ExprPtr>& arguments,
+                                          ExprPtr* lhs, bool resultis) {
+    const std::string prefix = "_inl" + std::to_string(inline_counter_++) + "_";
+    auto declare = [&](const std::string& name, VarType type) {
+        auto let = std::make_unique<LetDeclaration>(std::vector<std::string>{name}, std::vector<ExprPtr>{});
+        let->explicit_type = type;
+        pending_declarations_.push_back(std::move(let));
+    };
+
+    // Parameters take their types from SignatureAnalysisVisitor
+    std::vector<StmtPtr> statements;
+    const auto& metrics = analyzer_.get_function_metrics();
+    auto metrics_it = metrics.find(callee.name);
+    for (size_t i = 0; i < callee.parameters.size(); ++i) {
+        const std::string& param = callee.parameters[i];
+        VarType type = VarType::UNKNOWN;
+        if (metrics_it != metrics.end()) {
+            auto type_it = metrics_it->second.parameter_types.find(param);
+            if (type_it != metrics_it->second.parameter_types.end()) type = type_it->second;
+        }
+        declare(prefix + param, type);
+        statements.push_back(make_assignment(std::make_unique<VariableAccess>(prefix + param), std::move(arguments[i])));
+    }
+    // Locals keep the type the callee's scope gave them
+    for (const auto& let : callee.locals) {
+        for (const std::string& name : let->names) {
+            VarType type = let->explicit_type;
+            const Symbol* symbol = symbol_table_ ? symbol_table_->find(name, callee.name) : nullptr;
+            if (type == VarType::UNKNOWN && symbol && symbol->function_name == callee.name) type = symbol->type;
+            declare(prefix + name, type);
+        }
+    }
+
+    // A store through a vector or string goes through a result local
+    std::string result_name;
+    if (lhs && !dynamic_cast<VariableAccess*>(lhs->get())) {
+        result_name = prefix + "result";
+        declare(result_name, VarType::UNKNOWN);
+    }
+    ExitBuilder finish = [&](ExprPtr value) -> StmtPtr {
+        if (resultis) return std::make_unique<ResultisStatement>(std::move(value));
+        if (!result_name.empty()) return make_assignment(std::make_unique<VariableAccess>(result_name), std::move(value));
+        return make_assignment(clone_expr(lhs->get()), std::move(value));
+    };
+
+    std::vector<StmtPtr> body;
+    for (const auto& stmt : callee.body) {
+        body.push_back(clone_stmt(stmt.get()));
+        rename_stmt(body.back(), prefix, callee.bound_names);
+    }
+    bool exits = false;
+    lower_exits(body, 0, finish, statements, exits);
+    if (!result_name.empty()) {
+        statements.push_back(make_assignment(std::move(*lhs), std::make_unique<VariableAccess>(result_name)));
+    }
+
+    debug_print("  Inlined " + callee.name + " into " + current_function_ +
+                (loop_depth_ > 0 ? " (in a loop)" : ""));
+    growth_ += callee.size;
+    stats_.calls_inlined++;
+    return std::make_unique<CompoundStatement>(std::move(statements));
+}
+
+void FunctionInliningPass::debug_print(const std::string& message) {
+    if (trace_enabled_) {
+        std::cout << "[FunctionInliningPass] " << message << std::endl;
+    }
+}
+
+void FunctionInliningPass::print_statistics() {
+    if (!trace_enabled_) return;
+    std::cout << "\n=== Function Inlining Statistics ===" << std::endl;
+    std::cout << "Functions processed: " << stats_.functions_processed << std::endl;
+    std::cout << "Inlining candidates: " << stats_.candidates << std::endl;
+    std::cout << "Calls substituted: " << stats_.calls_substituted << std::endl;
+    std::cout << "Calls inlined: " << stats_.calls_inlined << std::endl;
+    std::cout << "Calls kept (budget or shadowing): " << stats_.calls_rejected << std::endl;
+    std::cout << "=====================================" << std::endl;
+}
@@ -0,0 +1,151 @@
+#ifndef FUNCTION_INLINING_PASS_H
+#define FUNCTION_INLINING_PASS_H
+
+#include "../Optimizer.h"
+#include "../AST.h"
+#include "../SymbolTable.h"
+#include "../analysis/ASTAnalyzer.h"
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// FunctionInliningPass copies small top-level FUNCTIONs and ROUTINEs into
+// their callers, saving the prologue, epilogue and caller-saved spills of a
+// BL. MethodInliningPass still handles trivial class accessors; this pass
+// handles ordinary BCPL procedures.
+//
+// A callee is a candidate when its body uses only plain integer, string and
+// vector statements and expressions (no VEC/NEW allocation, GOTO, nested
+// VALOF, float values or recursion) and makes at most kMaxCalls calls of its
+// own. Its body is cloned up front, so inlining is a single round and never
+// expands a copy twice.
+//
+// Two ways to inline a call:
+//  - Substitution: a call-free function whose body is a single expression
+//    replaces the call anywhere in an expression, with parameters replaced by
+//    the arguments (when each argument is a literal, a variable, or a
+//    side-effect-free expression read exactly once).
+//  - Statement inlining: at `x := f(...)`, `v!i := f(...)`, `RESULTIS f(...)`
+//    and `r(...)` the call becomes a CompoundStatement that assigns the
+//    arguments to renamed parameters, runs the renamed body, and stores the
+//    result. Every RESULTIS/RETURN must sit in tail position (possibly behind
+//    IF/UNLESS/TEST guards), since RESULTIS in the caller would return from
+//    the caller. Renamed locals are declared in the block of the innermost
+//    enclosing VALOF (or a routine's outermost block), so no new SAMM scope
+//    is opened around the inlined code.
+//
+// The cost model counts AST nodes: bodies up to kAlwaysInlineSize are always
+// inlined, bodies up to kMaxInlineSize only inside loops or when the callee
+// has at most kFewCallSites call sites, and each caller grows by at most
+// kCallerGrowthBudget nodes. The pass runs after SignatureAnalysisVisitor,
+// whose parameter types it copies onto the renamed parameters.
+class FunctionInliningPass : public Optimizer {
+public:
+    static constexpr int kAlwaysInlineSize = 12;
+    static constexpr int kMaxInlineSize = 40;
+    static constexpr int kFewCallSites = 2;
+    static constexpr int kCallerGrowthBudget = 200;
+    static constexpr int kMaxCalls = 2;
+
+    FunctionInliningPass(std::unordered_map<std::string, int64_t>& manifests,
+                         SymbolTable* symbol_table,
+                         ASTAnalyzer& analyzer,
+                         bool trace_enabled = false);
+
+    std::string getName() const override { return "Function Inlining Pass"; }
+    ProgramPtr apply(ProgramPtr program) override;
+
+    // Statistics for reporting and tests
+    struct Statistics {
+        int functions_processed = 0;
+        int candidates = 0;
+        int calls_substituted = 0;
+        int calls_inlined = 0;
+        int calls_rejected = 0;
+
+        void reset() {
+            functions_processed = 0;
+            candidates = 0;
+            calls_substituted = 0;
+            calls_inlined = 0;
+            calls_rejected = 0;
+        }
+    };
+    const Statistics& statistics() const { return stats_; }
+
+    void visit(FunctionDeclaration& node) override;
+    void visit(RoutineDeclaration& node) override;
+    void visit(ValofExpression& node) override;
+    void visit(BlockStatement& node) override;
+    void visit(ForStatement& node) override;
+    void visit(WhileStatement& node) override;
+    void visit(UntilStatement& node) override;
+    void visit(RepeatStatement& node) override;
+    void visit(FunctionCall& node) override;
+    void visit(AssignmentStatement& node) override;
+    void visit(RoutineCallStatement& node) override;
+    void visit(ResultisStatement& node) override;
+
+private:
+    // A function or routine body, cloned before any call site is rewritten
+    struct Callee {
+        std::string name;
+        std::vector<std::string> parameters;
+        bool is_routine = false;
+        std::vector<StmtPtr> body;                 // Blocks flattened; a FUNCTION's value is a RESULTIS
+        std::vector<std::unique_ptr<LetDeclaration>> locals; // The body's LET declarations
+        std::set<std::string> bound_names;         // Parameters, LET names and FOR variables
+        std::set<std::string> free_names;          // Everything else the body reads or calls
+        std::map<std::string, int> parameter_uses;
+        int size = 0;
+        int calls = 0;
+        int call_sites = 0;
+        bool substitutable = false;                // Call-free single expression
+        bool lowerable = false;                    // Every RESULTIS/RETURN in tail position
+    };
+
+    SymbolTable* symbol_table_;
+    ASTAnalyzer& analyzer_;
+    bool trace_enabled_;
+    Statistics stats_;
+
+    std::map<std::string, Callee> callees_;
+    int inline_counter_ = 0;
+
+    // Caller state
+    std::string current_function_;
+    bool caller_is_function_ = false;
+    int loop_depth_ = 0;
+    int growth_ = 0;
+    std::vector<std::set<std::string>> caller_scopes_;
+    std::vector<DeclPtr> pending_declarations_;
+
+    void debug_print(const std::string& message);
+    void print_statistics();
+
+    // Candidate discovery
+    void collect_candidate(const std::string& name, const std::vector<std::string>& parameters,
+                           const ASTNode* body, bool is_routine, bool is_float);
+    void count_call_sites(ProgramPtr& program);
+    bool has_plain_type(VarType type) const;
+
+    // Inlining decisions
+    Callee* callee_for(const Expression* function_expr, size_t argument_count);
+    bool fits_budget(const Callee& callee) const;
+    bool captures_caller_name(const Callee& callee) const;
+    bool can_inline(const Callee& callee, const std::vector<ExprPtr>& arguments);
+    bool stable_target(const Expression* lhs) const;
+
+    ExprPtr substitute_call(const Callee& callee, FunctionCall& call);
+    // The call as a CompoundStatement whose exits assign *lhs, RESULTIS, or (for
+    // a routine) just end
+    StmtPtr inline_call(const Callee& callee, std::vector<ExprPtr>& arguments, ExprPtr* lhs, bool resultis);
+
+    // Wraps pending_declarations_ into a routine's outermost block or the
+    // innermost enclosing VALOF's block
+    void attach_pending_declarations(StmtPtr& body);
+};
+
+#endif // FUNCTION_INLINING_PASS_H
@@ -0,0 +1,248 @@
+#include "LoopVectorizationPass.h"
+#include "../AST.h"
+#include <iostream>
+#include <vector>
+
+// NewCodeGenerator keeps a pointer into each vector in a scratch register for
+// the whole NEON loop, next to the index and the limit
+static const size_t MAX_VECTORS = 4;
+// Each invariant leaf and each reduction holds a NEON register for the loop
+static const int MAX_RESIDENT_REGISTERS = 8;
+
+LoopVectorizationPass::LoopVectorizationPass(SymbolTable* symbol_table, bool bounds_checking_enabled, bool trace_enabled,
+                                             bool float_reductions_enabled)
+    : bounds_checking_enabled_(bounds_checking_enabled), trace_enabled_(trace_enabled),
+      float_reductions_enabled_(float_reductions_enabled), analysis_(symbol_table) {}
+
+void LoopVectorizationPass::run(std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>& cfgs) {
+    debug_print("Starting Loop Vectorization Pass");
+    stats_.reset();
+
+    for (auto& pair : cfgs) {
+        debug_print("Processing function: " + pair.first);
+        stats_.functions_processed++;
+        optimize_cfg(pair.first, *pair.second);
+    }
+
+    print_statistics();
+    debug_print("Loop Vectorization Pass completed");
+}
+
+void LoopVectorizationPass::optimize_cfg(const std::string& function_name, ControlFlowGraph& cfg) {
+    std::string opaque_block;
+    if (!analysis_.analyze(function_name, cfg, opaque_block)) {
+        debug_print("  Skipping function: block " + opaque_block + " has statements the pass does not analyze");
+        return;
+    }
+
+    for (BasicBlock* block : analysis_.blocks()) {
+        Loop loop;
+        if (block->is_loop_header && analysis_.find_loop(block, loop)) {
+            stats_.loops_analyzed++;
+            optimize_loop(loop);
+        }
+    }
+}
+
+static bool is_scope_call(const Statement* stmt) {
+    auto* call = dynamic_cast<const RoutineCallStatement*>(stmt);
+    if (!call) return false;
+    auto* routine = dynamic_cast<const VariableAccess*>(call->routine_expr.get());
+    return routine && (routine->name == "HeapManager_enter_scope" || routine->name == "HeapManager_exit_scope");
+}
+
+bool LoopVectorizationPass::collect_body(const Loop& loop, std::vector<const Statement*>& body, std::string& reason) const {
+    // Header, body blocks and increment, with nothing entering part way
+    size_t chain_length = 2;
+    BasicBlock* block = loop.header->successors[0];
+    BasicBlock* previous = loop.header;
+    while (block != loop.increment) {
+        if (!loop.blocks.count(block) || block == loop.header || chain_length > loop.blocks.size()) {
+            reason = "body does not reach the increment";
+            return false;
+        }
+        if (block->successors.size() != 1 || block->predecessors.size() != 1 || block->predecessors[0] != previous) {
+            reason = "body branches";
+            return false;
+        }
+        if (analysis_.facts(block).has_call) {
+            reason = "body calls a function";
+            return false;
+        }
+        for (const auto& stmt : block->statements) {
+            body.push_back(stmt.get());
+        }
+        previous = block;
+        block = block->successors[0];
+        chain_length++;
+    }
+    if (loop.increment->predecessors.size() != 1 || loop.increment->predecessors[0] != previous ||
+        chain_length != loop.blocks.size()) {
+        reason = "body branches";
+        return false;
+    }
+    return true;
+}
+
+bool LoopVectorizationPass::match_element(const Expression* expr, bool is_float, const Loop& loop,
+                                          std::set<std::string>& vectors, int& leaves) const {
+    if (auto* access = dynamic_cast<const VectorAccess*>(expr)) {
+        auto* vec = dynamic_cast<const VariableAccess*>(access->vector_expr.get());
+        auto* index = dynamic_cast<const VariableAccess*>(access->index_expr.get());
+        Symbol symbol;
+        if (!vec || !index || index->name != loop.variable || !analysis_.is_invariant_vector(vec->name, loop) ||
+            !analysis_.is_tracked_variable(vec->name, symbol)) {
+            return false;
+        }
+        if (symbol.type != (is_float ? VarType::POINTER_TO_FLOAT_VEC : VarType::POINTER_TO_INT_VEC)) return false;
+        if (bounds_checking_enabled_ && !access->bounds_check_elided) return false;
+        vectors.insert(vec->name);
+        return true;
+    }
+    if (auto* lit = dynamic_cast<const NumberLiteral*>(expr)) {
+        leaves++;
+        return lit->literal_type == (is_float ? NumberLiteral::LiteralType::Float : NumberLiteral::LiteralType::Integer);
+    }
+    if (auto* var = dynamic_cast<const VariableAccess*>(expr)) {
+        Symbol symbol;
+        if (!analysis_.is_invariant(var, loop) || !analysis_.is_tracked_variable(var->name, symbol)) return false;
+        leaves++;
+        return symbol.type == (is_float ? VarType::FLOAT : VarType::INTEGER);
+    }
+    if (auto* bin = dynamic_cast<const BinaryOp*>(expr)) {
+        bool supported = bin->op == BinaryOp::Operator::Add || bin->op == BinaryOp::Operator::Subtract ||
+                         (is_float && (bin->op == BinaryOp::Operator::Multiply || bin->op == BinaryOp::Operator::Divide));
+        return supported && match_element(bin->left.get(), is_float, loop, vectors, leaves) &&
+               match_element(bin->right.get(), is_float, loop, vectors, leaves);
+    }
+    return false;
+}
+
+void LoopVectorizationPass::optimize_loop(Loop& loop) {
+    const Expression* end_expr = loop.for_stmt->end_expr.get();
+    std::vector<const Statement*> body;
+    std::string reason;
+    if (loop.step != 1) {
+        reason = "step is not 1";
+    } else if (!analysis_.is_invariant(end_expr, loop)) {
+        reason = "limit changes in the loop";
+    } else {
+        collect_body(loop, body, reason);
+    }
+    if (!reason.empty()) {
+        debug_print("  Loop " + loop.header->id + " over " + loop.variable + " not vectorized: " + reason);
+        return;
+    }
+
+    std::vector<VectorizedStatement> statements;
+    std::set<std::string> vectors;
+    int resident = 0;
+    for (const Statement* stmt : body) {
+        if (is_scope_call(stmt)) continue;
+        auto* assign = dynamic_cast<const AssignmentStatement*>(stmt);
+        if (!assign || assign->lhs.size() != 1 || assign->rhs.size() != 1) {
+            reason = "body has a statement other than an assignment";
+            break;
+        }
+
+        VectorizedStatement vectorized;
+        const Expression* value = nullptr;
+        Symbol symbol;
+        if (auto* store = dynamic_cast<const VectorAccess*>(assign->lhs[0].get())) {
+            // w!i := <element>
+            auto* vec = dynamic_cast<const VariableAccess*>(store->vector_expr.get());
+            auto* index = dynamic_cast<const VariableAccess*>(store->index_expr.get());
+            if (!vec || !index || index->name != loop.variable || !analysis_.is_invariant_vector(vec->name, loop) ||
+                !analysis_.is_tracked_variable(vec->name, symbol)) {
+                reason = "store is not to v!" + loop.variable;
+                break;
+            }
+            vectorized.target = vec->name;
+            vectorized.is_float = symbol.type == VarType::POINTER_TO_FLOAT_VEC;
+            value = assign->rhs[0].get();
+            vectors.insert(vec->name);
+        } else if (auto* var = dynamic_cast<const VariableAccess*>(assign->lhs[0].get())) {
+            // x := x + <element> or x := <element> + x
+            auto* sum = dynamic_cast<const BinaryOp*>(assign->rhs[0].get());
+            auto is_target = [&](const Expression* e) {
+                auto* operand = dynamic_cast<const VariableAccess*>(e);
+                return operand && operand->name == var->name;
+            };
+            if (!sum || sum->op != BinaryOp::Operator::Add || var->name == loop.variable ||
+                !analysis_.is_tracked_variable(var->name, symbol) ||
+                (symbol.type != VarType::INTEGER && symbol.type != VarType::FLOAT) ||
+                analysis_.assignments_in_loop(var->name, loop) != 1) {
+                reason = "assignment to " + var->name + " is not a reduction";
+                break;
+            }
+            if (is_target(sum->left.get())) {
+                value = sum->right.get();
+            } else if (is_target(sum->right.get())) {
+                value = sum->left.get();
+            } else {
+                reason = "assignment to " + var->name + " is not a reduction";
+                break;
+            }
+            if (symbol.type == VarType::FLOAT && !float_reductions_enabled_) {
+                reason = "float reduction into " + var->name + " would change rounding (--fast-float-reductions)";
+                break;
+            }
+            vectorized.target = var->name;
+            vectorized.is_reduction = true;
+            vectorized.is_float = symbol.type == VarType::FLOAT;
+            resident++;
+        } else {
+            reason = "assignment target is not a vector element or a variable";
+            break;
+        }
+
+        if (!match_element(value, vectorized.is_float, loop, vectors, resident)) {
+            reason = "assignment to " + vectorized.target + " has a value that does not vectorize";
+            break;
+        }
+        vectorized.value = ExprPtr(static_cast<Expression*>(value->clone().release()));
+        statements.push_back(std::move(vectorized));
+    }
+
+    if (reason.empty() && statements.empty()) reason = "body is empty";
+    if (reason.empty() && vectors.size() > MAX_VECTORS) reason = "too many vectors";
+    if (reason.empty() && resident > MAX_RESIDENT_REGISTERS) reason = "too many invariants and reductions";
+    if (!reason.empty()) {
+        debug_print("  Loop " + loop.header->id + " over " + loop.variable + " not vectorized: " + reason);
+        return;
+    }
+
+    for (const VectorizedStatement& stmt : statements) {
+        if (stmt.is_reduction) {
+            stats_.reductions++;
+            debug_print("    Reduction into " + stmt.target + (stmt.is_float ? " (float)" : ""));
+        } else {
+            stats_.element_statements++;
+            debug_print("    Element-wise store to " + stmt.target + "!" + loop.variable + (stmt.is_float ? " (float)" : ""));
+        }
+    }
+    stats_.loops_vectorized++;
+    debug_print("  Vectorized loop " + loop.header->id + " over " + loop.variable + " in " + loop.preheader->id);
+
+    BasicBlock* preheader = loop.preheader;
+    preheader->vectorized_statements = std::move(statements);
+    preheader->vectorized_loop_variable = loop.variable;
+    preheader->vectorized_loop_end = clone_unique_ptr(loop.for_stmt->end_expr);
+}
+
+void LoopVectorizationPass::debug_print(const std::string& message) {
+    if (trace_enabled_) {
+        std::cout << "[LoopVectorizationPass] " << message << std::endl;
+    }
+}
+
+void LoopVectorizationPass::print_statistics() {
+    if (trace_enabled_) {
+        std::cout << "\n[LoopVectorizationPass] Statistics:" << std::endl;
+        std::cout << "  Functions processed: " << stats_.functions_processed << std::endl;
+        std::cout << "  FOR loops analyzed: " << stats_.loops_analyzed << std::endl;
+        std::cout << "  Loops vectorized: " << stats_.loops_vectorized << std::endl;
+        std::cout << "  Element-wise statements: " << stats_.element_statements << std::endl;
+        std::cout << "  Reductions: " << stats_.reductions << std::endl;
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef LOOP_VECTORIZATION_PASS_H
+#define LOOP_VECTORIZATION_PASS_H
+
+#include "../ControlFlowGraph.h"
+#include "../BasicBlock.h"
+#include "../SymbolTable.h"
+#include "ForLoopAnalysis.h"
+#include <unordered_map>
+#include <memory>
+#include <set>
+#include <string>
+
+// LoopVectorizationPass marks FOR loops over VECs and FVECs whose bodies
+// NEON can run two elements at a time, for NewCodeGenerator to emit a 2D loop
+// in the preheader ahead of the scalar one. The scalar loop then runs the
+// element left over when the range has odd length.
+//
+// A loop FOR i = s TO e (step 1, e loop-invariant) qualifies when its body is
+// a straight run of blocks holding only statements of the forms
+//
+//      w!i := <element>                 (an element-wise store)
+//      x := x + <element>               (a reduction into a scalar)
+//
+// where <element> combines reads v!i, loop-invariant locals and literals
+// with + and - on words, or + - * / on floats. Every vector in a statement
+// has the statement's kind: POINTER_TO_INT_VEC for words, POINTER_TO_FLOAT_VEC
+// for floats. Words and floats are both 64 bits, so the NEON code uses the
+// 2D arrangement throughout; there is no 2D integer multiply.
+//
+// A read must already be free of its bounds check (BoundsCheckEliminationPass
+// runs first) unless bounds checking is off. A float reduction adds two
+// partial sums, so its rounding can differ from the scalar loop's; it is
+// only vectorized when float_reductions_enabled is set
+// (--fast-float-reductions). Element-wise float statements give the same
+// results either way.
+class LoopVectorizationPass {
+public:
+    LoopVectorizationPass(SymbolTable* symbol_table, bool bounds_checking_enabled, bool trace_enabled = false,
+                          bool float_reductions_enabled = false);
+
+    // Run the pass on all CFGs
+    void run(std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>& cfgs);
+
+    // Run the pass on a single function's CFG
+    void optimize_cfg(const std::string& function_name, ControlFlowGraph& cfg);
+
+    std::string getName() const { return "Loop Vectorization Pass"; }
+
+private:
+    bool bounds_checking_enabled_;
+    bool trace_enabled_;
+    bool float_reductions_enabled_;
+
+    // Statistics for reporting
+    struct Statistics {
+        int functions_processed = 0;
+        int loops_analyzed = 0;
+        int loops_vectorized = 0;
+        int element_statements = 0;
+        int reductions = 0;
+
+        void reset() {
+            functions_processed = 0;
+            loops_analyzed = 0;
+            loops_vectorized = 0;
+            element_statements = 0;
+            reductions = 0;
+        }
+    } stats_;
+
+    using Loop = ForLoopAnalysis::Loop;
+
+    ForLoopAnalysis analysis_;
+
+    void debug_print(const std::string& message);
+
+    void optimize_loop(Loop& loop);
+
+    // Collects the body's statements in order; false unless the body is a
+    // straight run of blocks from the header to the increment
+    bool collect_body(const Loop& loop, std::vector<const Statement*>& body, std::string& reason) const;
+
+    // True if expr is an <element> of the given kind, adding the vectors it
+    // reads to vectors and counting its invariant leaves
+    bool match_element(const Expression* expr, bool is_float, const Loop& loop,
+                       std::set<std::string>& vectors, int& leaves) const;
+
+    void print_statistics();
+};
+
+#endif // LOOP_VECTORIZATION_PASS_H
@@ -7,25 +7,25 @@
 std::string RegisterManager::acquire_fp_reg_for_variable(const std::string& variable_name, NewCodeGenerator& code_gen, CallFrameManager& cfm) {
     // If already allocated, return it
     if (fp_variable_to_reg_map_.count(variable_name)) {
-        return fp_variable_to_reg_map_[variable_name];
+        return fp_variable_to_reg_map_.at(variable_name).name();
     }
     // Find a free FP variable register
-    for (const auto& reg : FP_VARIABLE_REGS) {
+    for (Reg reg : FP_VARIABLE_POOL) {
         if (registers[reg].status == FREE) {
             registers[reg].status = IN_USE_VARIABLE;
             registers[reg].bound_to = variable_name;
             fp_variable_to_reg_map_[variable_name] = reg;
             fp_variable_reg_lru_order_.push_front(variable_name);
-            return reg;
+            return reg.name();
         }
     }
     // If none free, spill the least recently used
     if (!fp_variable_reg_lru_order_.empty()) {
         std::string victim_var = fp_variable_reg_lru_order_.back();
         fp_variable_reg_lru_order_.pop_back();
-        std::string victim_reg = fp_variable_to_reg_map_[victim_var];
+        Reg victim_reg = fp_variable_to_reg_map_.at(victim_var);
         int offset = cfm.get_spill_offset(victim_var);
-        Instruction spill_instr = Encoder::create_str_fp_imm(victim_reg, "X29", offset);
+        Instruction spill_instr = Encoder::create_str_fp_imm(victim_reg.name(), "X29", offset);
         code_gen.emit(spill_instr);
         registers[victim_reg].status = FREE;
         registers[victim_reg].bound_to = "";
@@ -36,7 +36,7 @@ std::string RegisterManager::acquire_fp_reg_for_variable(const std::string& vari
         registers[victim_reg].bound_to = variable_name;
         fp_variable_to_reg_map_[variable_name] = victim_reg;
         fp_variable_reg_lru_order_.push_front(variable_name);
-        return victim_reg;
+        return victim_reg.name();
     }
     throw std::runtime_error("No available FP variable registers and cannot spill.");
 }
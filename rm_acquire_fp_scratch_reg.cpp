@@ -2,7 +2,14 @@
 #include <stdexcept>
 
 std::string RegisterManager::acquire_fp_scratch_reg() {
-    for (const auto& reg : FP_SCRATCH_REGS) {
+    return acquire_fp_scratch().name();
+}
+
+Reg RegisterManager::acquire_fp_scratch() {
+    for (Reg reg : FP_SCRATCH_POOL) {
+        // Skip D<n> while vector code holds V<n>, the same register
+        Reg alias = Reg::v(reg.number());
+        if (registers.count(alias) && registers.at(alias).status != FREE) continue;
         if (registers[reg].status == FREE) {
             registers[reg].status = IN_USE_SCRATCH;
             registers[reg].bound_to = "";
@@ -6,27 +6,27 @@
 std::pair<std::string, bool> RegisterManager::acquire_reg_for_variable(const std::string& variable_name, NewCodeGenerator& code_gen) {
     // CACHE HIT: Variable is already in a register
     if (variable_to_reg_map.count(variable_name)) {
-        std::string reg = variable_to_reg_map.at(variable_name);
+        Reg reg = variable_to_reg_map.at(variable_name);
         // Update LRU status: move to front
         variable_reg_lru_order_.remove(variable_name);
         variable_reg_lru_order_.push_front(variable_name);
-        return {reg, true}; // Return register and 'true' for hit
+        return {reg.name(), true}; // Return register and 'true' for hit
     }
 
     // CACHE MISS: Find a free register or spill one
-    std::string reg = find_free_register(VARIABLE_REGS);
-    if (!reg.empty()) {
+    Reg reg;
+    if (find_free_register(VARIABLE_POOL, reg)) {
         registers[reg] = {IN_USE_VARIABLE, variable_name, false};
         variable_to_reg_map[variable_name] = reg;
         variable_reg_lru_order_.push_front(variable_name); // Add variable name to LRU tracking
-        return {reg, false}; // Return new register and 'false' for miss
+        return {reg.name(), false}; // Return new register and 'false' for miss
     }
 
     // Spill logic: No free registers, so we must spill the least recently used one.
     std::string victim_var = variable_reg_lru_order_.back(); // variable name
     variable_reg_lru_order_.pop_back();
 
-    std::string victim_reg = variable_to_reg_map.at(victim_var);
+    Reg victim_reg = variable_to_reg_map.at(victim_var);
     std::string spilled_var = victim_var;
 
     // --- THE CHANGE IS HERE: ONLY SPILL IF DIRTY ---
@@ -51,5 +51,5 @@ std::pair<std::string, bool> RegisterManager::acquire_reg_for_variable(const std
     variable_reg_lru_order_.push_front(variable_name); // Track variable name in LRU
     spilled_variables_.erase(variable_name); // Ensure the newly acquired variable is not marked as spilled
 
-    return {victim_reg, false};
+    return {victim_reg.name(), false};
 }
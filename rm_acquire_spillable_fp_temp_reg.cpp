@@ -6,14 +6,14 @@
 
 std::string RegisterManager::acquire_spillable_fp_temp_reg(NewCodeGenerator& code_gen) {
     // 1. Try to find a free FP variable register first.
-    for (const auto& reg : FP_VARIABLE_REGS) {
+    for (Reg reg : FP_VARIABLE_POOL) {
         if (registers[reg].status == FREE) {
             // Mark as a variable, bind to a special temp name, and track it.
             registers[reg].status = IN_USE_VARIABLE;
             registers[reg].bound_to = "_temp_fp_";
             fp_variable_to_reg_map_["_temp_fp_"] = reg;
             fp_variable_reg_lru_order_.push_front("_temp_fp_");
-            return reg;
+            return reg.name();
         }
     }
 
@@ -23,10 +23,10 @@ std::string RegisterManager::acquire_spillable_fp_temp_reg(NewCodeGenerator& cod
     }
     std::string victim_var = fp_variable_reg_lru_order_.back();
     fp_variable_reg_lru_order_.pop_back();
-    std::string victim_reg = fp_variable_to_reg_map_.at(victim_var);
+    Reg victim_reg = fp_variable_to_reg_map_.at(victim_var);
 
     if (registers.at(victim_reg).dirty) {
-        Instruction spill_instr = Encoder::create_str_fp_imm(victim_reg, "X29", code_gen.get_current_frame_manager()->get_spill_offset(victim_var));
+        Instruction spill_instr = Encoder::create_str_fp_imm(victim_reg.name(), "X29", code_gen.get_current_frame_manager()->get_spill_offset(victim_var));
         code_gen.emit(spill_instr);
     }
 
@@ -39,5 +39,5 @@ std::string RegisterManager::acquire_spillable_fp_temp_reg(NewCodeGenerator& cod
     fp_variable_to_reg_map_["_temp_fp_"] = victim_reg;
     fp_variable_reg_lru_order_.push_front("_temp_fp_");
 
-    return victim_reg;
+    return victim_reg.name();
 }
@@ -2,11 +2,10 @@
 
 std::vector<std::pair<std::string, std::string>> RegisterManager::get_dirty_variable_registers() const {
     std::vector<std::pair<std::string, std::string>> dirty_regs;
-    for (const auto& pair : registers) {
-        const RegisterInfo& info = pair.second;
+    registers.for_each([&](Reg reg, const RegisterInfo& info) {
         if (info.status == IN_USE_VARIABLE && info.dirty) {
-            dirty_regs.push_back({pair.first, info.bound_to}); // {register name, variable name}
+            dirty_regs.push_back({reg.name(), info.bound_to}); // {register name, variable name}
         }
-    }
+    });
     return dirty_regs;
 }
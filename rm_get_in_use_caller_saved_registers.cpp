@@ -2,9 +2,9 @@
 
 std::vector<std::string> RegisterManager::get_in_use_caller_saved_registers() const {
     std::vector<std::string> in_use;
-    for (const auto& reg_name : SCRATCH_REGS) {
-        if (registers.count(reg_name) && registers.at(reg_name).status != FREE) {
-            in_use.push_back(reg_name);
+    for (Reg reg : SCRATCH_POOL) {
+        if (registers.count(reg) && registers.at(reg).status != FREE) {
+            in_use.push_back(reg.name());
         }
     }
     return in_use;
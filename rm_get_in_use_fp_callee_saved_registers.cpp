@@ -2,9 +2,9 @@
 
 std::vector<std::string> RegisterManager::get_in_use_fp_callee_saved_registers() const {
     std::vector<std::string> used;
-    for (const auto& reg : FP_VARIABLE_REGS) {
+    for (Reg reg : FP_VARIABLE_POOL) {
         if (registers.at(reg).status == IN_USE_VARIABLE) {
-            used.push_back(reg);
+            used.push_back(reg.name());
         }
     }
     return used;
@@ -1,8 +1,13 @@
 #include "RegisterManager.h"
 
-bool RegisterManager::is_dirty(const std::string& reg_name) const {
-    if (registers.count(reg_name)) {
-        return registers.at(reg_name).dirty;
+bool RegisterManager::is_dirty(Reg reg) const {
+    if (registers.count(reg)) {
+        return registers.at(reg).dirty;
     }
     return false;
 }
+
+bool RegisterManager::is_dirty(const std::string& reg_name) const {
+    Reg reg;
+    return parse_name(reg_name, reg) && is_dirty(reg);
+}
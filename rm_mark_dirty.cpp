@@ -1,7 +1,12 @@
 #include "RegisterManager.h"
 
-void RegisterManager::mark_dirty(const std::string& reg_name, bool is_dirty) {
-    if (registers.count(reg_name)) {
-        registers.at(reg_name).dirty = is_dirty;
+void RegisterManager::mark_dirty(Reg reg, bool is_dirty) {
+    if (registers.count(reg)) {
+        registers.at(reg).dirty = is_dirty;
     }
 }
+
+void RegisterManager::mark_dirty(const std::string& reg_name, bool is_dirty) {
+    Reg reg;
+    if (parse_name(reg_name, reg)) mark_dirty(reg, is_dirty);
+}
@@ -1,8 +1,9 @@
 #include "RegisterManager.h"
 
 void RegisterManager::release_callee_saved_temp_reg(const std::string& reg_name) {
-    if (registers.count(reg_name)) {
-        registers[reg_name].status = FREE;
-        registers[reg_name].bound_to = "";
+    Reg reg;
+    if (parse_name(reg_name, reg) && registers.count(reg)) {
+        registers[reg].status = FREE;
+        registers[reg].bound_to = "";
     }
 }
@@ -1,8 +1,13 @@
 #include "RegisterManager.h"
 
-void RegisterManager::release_fp_register(const std::string& reg_name) {
-    if (registers.count(reg_name)) {
-        registers[reg_name].status = FREE;
-        registers[reg_name].bound_to = "";
+void RegisterManager::release_fp_register(Reg reg) {
+    if (registers.count(reg)) {
+        registers[reg].status = FREE;
+        registers[reg].bound_to = "";
     }
 }
+
+void RegisterManager::release_fp_register(const std::string& reg_name) {
+    Reg reg;
+    if (parse_name(reg_name, reg)) release_fp_register(reg);
+}
@@ -1,16 +1,16 @@
 #include "RegisterManager.h"
 
-void RegisterManager::release_register(const std::string& reg_name) {
-    if (!registers.count(reg_name)) {
+void RegisterManager::release_register(Reg reg) {
+    if (!registers.count(reg)) {
         return;
     }
     
-    if (is_fp_register(reg_name)) {
-        release_fp_register(reg_name);
+    if (is_fp_register(reg)) {
+        release_fp_register(reg);
         return;
     }
 
-    RegisterInfo& info = registers.at(reg_name);
+    RegisterInfo& info = registers.at(reg);
 
     if (info.status == IN_USE_VARIABLE) {
         // This was a named variable or a spillable temp (_temp_N)
@@ -18,6 +18,11 @@ void RegisterManager::release_register(const std::string& reg_name) {
     } else if (info.status == IN_USE_SCRATCH) {
         // This was a temp from the scratch pool OR borrowed from the variable pool.
         // A simple release is correct for both cases.
-        release_scratch_reg(reg_name);
+        release_scratch_reg(reg);
     }
-}
\ No newline at end of file
+}
+
+void RegisterManager::release_register(const std::string& reg_name) {
+    Reg reg;
+    if (parse_name(reg_name, reg)) release_register(reg);
+}
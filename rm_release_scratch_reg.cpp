@@ -1,9 +1,9 @@
 #include "RegisterManager.h"
 
-void RegisterManager::release_scratch_reg(const std::string& reg_name) {
-    if (registers.count(reg_name) && registers.at(reg_name).status != FREE) {
+void RegisterManager::release_scratch_reg(Reg reg) {
+    if (registers.count(reg) && registers.at(reg).status != FREE) {
         // Get the name of the variable that was bound to this register.
-        const std::string& bound_var = registers.at(reg_name).bound_to;
+        const std::string& bound_var = registers.at(reg).bound_to;
         // If a variable was actually bound, remove all of its tracking info.
         if (!bound_var.empty()) {
             // Remove it from the variable-to-register map.
@@ -12,6 +12,11 @@ void RegisterManager::release_scratch_reg(const std::string& reg_name) {
             variable_reg_lru_order_.remove(bound_var);
         }
         // Now that all mappings are gone, mark the register as free.
-        registers[reg_name] = {FREE, "", false};
+        registers[reg] = {FREE, "", false};
     }
-}
\ No newline at end of file
+}
+
+void RegisterManager::release_scratch_reg(const std::string& reg_name) {
+    Reg reg;
+    if (parse_name(reg_name, reg)) release_scratch_reg(reg);
+}
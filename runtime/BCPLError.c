@@ -5,6 +5,7 @@
  */
 
 #include "BCPLError.h"
+#include "runtime.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -80,11 +81,11 @@ void BCPL_CLEAR_ERRORS(void) {
 
 // Bounds checking error handler
 void BCPL_BOUNDS_ERROR(uint32_t* var_name_ptr, int64_t index, int64_t length) {
-    // DEBUG: Print to stdout first to see if this function is being called
-    printf("BCPL_BOUNDS_ERROR called! index=%lld, length=%lld\n", (long long)index, (long long)length);
-    fflush(stdout);
-    
-    // Use signal-safe functions only
+    // Write out the program's buffered output first, so it appears before
+    // the diagnostic and is not lost when abort() skips the exit flush
+    bcpl_output_flush();
+
+    // The diagnostic itself goes to stderr with write(2)
     const char* error_msg = "FATAL RUNTIME ERROR: Out of bounds access.\n";
     write(STDERR_FILENO, error_msg, strlen(error_msg));
     
@@ -13,6 +13,13 @@
 #define ATOM_OBJECT   5
 #define ATOM_PAIR     6
 
+// --- String ownership, kept in a string atom's `pad` ---
+// The tokens of one SPLIT share a single allocation. The atom of the token
+// at its start frees it; the others borrow their characters from it.
+#define ATOM_OWNS_STRING    0
+#define ATOM_BORROWS_STRING 1
+#define ATOM_OWNS_SPLIT     2
+
 // This structure for data nodes remains the same.
 typedef struct ListAtom {
     int32_t type;
@@ -51,10 +51,13 @@ extern "C" {
     void bcpl_free_list_safe(void*);
     void* bcpl_getvec(int64_t num_words);
     void* bcpl_fgetvec(int64_t num_floats);
+    void* bcpl_getvec_scoped(int64_t num_words);
+    void* bcpl_alloc_chars_scoped(int64_t num_chars);
     void BCPL_CHECK_AND_DISPLAY_ERRORS(void);
     void BCPL_GET_LAST_ERROR(void*);
     void BCPL_CLEAR_ERRORS(void);
     void BCPL_BOUNDS_ERROR(uint32_t*, int64_t, int64_t);
+    uint32_t* BCPL_STRING_PROMOTE(uint32_t*);
     int64_t BCPL_LIST_GET_HEAD_AS_INT(void*);
     double BCPL_LIST_GET_HEAD_AS_FLOAT(void*);
     void* BCPL_LIST_GET_TAIL(void*);
@@ -103,6 +106,14 @@ extern "C" {
     int64_t STRLEN(const uint32_t* s);
     void* PACKSTRING(uint32_t* bcpl_string);
     uint32_t* UNPACKSTRING(const uint8_t* byte_vector);
+
+    // String builders
+    uint32_t* SB_NEW(int64_t capacity);
+    uint32_t* SB_APPEND(uint32_t* builder, uint32_t* s);
+    uint32_t* SB_APPENDC(uint32_t* builder, int64_t ch);
+    uint32_t* SB_APPENDN(uint32_t* builder, int64_t n);
+    uint32_t* SB_CLEAR(uint32_t* builder);
+    uint32_t* SB_STRING(uint32_t* builder);
     
     // File I/O functions
     uint32_t* SLURP(uint32_t* filename_str);
@@ -115,6 +126,7 @@ extern "C" {
     uint32_t FILE_CLOSE(uintptr_t handle);
     uint32_t FILE_WRITES(uintptr_t handle, uint32_t* string_buffer);
     uint32_t* FILE_READS(uintptr_t handle);
+    uint32_t* FILE_READLINE(uintptr_t handle);
     uint32_t FILE_READ(uintptr_t handle, uint32_t* buffer, uint32_t size);
     uint32_t FILE_WRITE(uintptr_t handle, uint32_t* buffer, uint32_t size);
     uint32_t FILE_SEEK(uintptr_t handle, int32_t offset, uint32_t origin);
@@ -133,6 +145,8 @@ extern "C" {
     // Aliases for BCPL compatibility
     void* GETVEC(int64_t num_words) { return bcpl_getvec(num_words); }
     void* FGETVEC(int64_t num_floats) { return bcpl_fgetvec(num_floats); }
+    void* GETVEC_SCOPED(int64_t num_words) { return bcpl_getvec_scoped(num_words); }
+    void* BCPL_ALLOC_CHARS_SCOPED(int64_t num_chars) { return bcpl_alloc_chars_scoped(num_chars); }
     void FREEVEC(void* ptr) { return bcpl_free(ptr); }
     uint32_t* JOIN(struct ListHeader* list_header, uint32_t* delimiter_payload) { return BCPL_JOIN_LIST(list_header, delimiter_payload); }
     struct ListHeader* SPLIT(uint32_t* source_payload, uint32_t* delimiter_payload) { return BCPL_SPLIT_STRING(source_payload, delimiter_payload); }
@@ -171,6 +185,8 @@ void register_runtime_functions() {
     register_runtime_function("MALLOC", 1, reinterpret_cast<void*>(bcpl_alloc_words)); // Alias for compatibility
     register_runtime_function("GETVEC", 1, reinterpret_cast<void*>(bcpl_getvec), FunctionType::STANDARD, VarType::POINTER_TO_INT_VEC); // Traditional BCPL vector allocation
     register_runtime_function("FGETVEC", 1, reinterpret_cast<void*>(bcpl_fgetvec), FunctionType::STANDARD, VarType::POINTER_TO_FLOAT_VEC); // Float vector allocation
+    register_runtime_function("GETVEC_SCOPED", 1, reinterpret_cast<void*>(bcpl_getvec_scoped), FunctionType::STANDARD, VarType::POINTER_TO_INT_VEC); // Scope-local VEC (SAMM region)
+    register_runtime_function("BCPL_ALLOC_CHARS_SCOPED", 1, reinterpret_cast<void*>(bcpl_alloc_chars_scoped)); // Scope-local STRING (SAMM region)
     if (RuntimeManager::instance().isTracingEnabled()) {
         printf("DEBUG: Registering FREEVEC with bcpl_free at address %p\n", reinterpret_cast<void*>(bcpl_free));
     }
@@ -181,6 +197,7 @@ void register_runtime_functions() {
     register_runtime_function("BCPL_CLEAR_ERRORS", 0, reinterpret_cast<void*>(BCPL_CLEAR_ERRORS));
     register_runtime_function("BCPL_CHECK_AND_DISPLAY_ERRORS", 0, reinterpret_cast<void*>(BCPL_CHECK_AND_DISPLAY_ERRORS));
     register_runtime_function("BCPL_BOUNDS_ERROR", 3, reinterpret_cast<void*>(BCPL_BOUNDS_ERROR));
+    register_runtime_function("BCPL_STRING_PROMOTE", 1, reinterpret_cast<void*>(BCPL_STRING_PROMOTE), FunctionType::STANDARD, VarType::POINTER_TO_STRING);
     register_runtime_function("BCPL_LIST_GET_HEAD_AS_INT", 1, reinterpret_cast<void*>(BCPL_LIST_GET_HEAD_AS_INT));
     register_runtime_function("BCPL_LIST_GET_HEAD_AS_FLOAT", 1, reinterpret_cast<void*>(BCPL_LIST_GET_HEAD_AS_FLOAT), FunctionType::FLOAT);
     register_runtime_function("BCPL_LIST_GET_TAIL", 1, reinterpret_cast<void*>(BCPL_LIST_GET_TAIL));
@@ -245,6 +262,14 @@ void register_runtime_functions() {
     register_runtime_function("STRLEN", 1, reinterpret_cast<void*>(STRLEN));
     register_runtime_function("PACKSTRING", 1, reinterpret_cast<void*>(PACKSTRING));
     register_runtime_function("UNPACKSTRING", 1, reinterpret_cast<void*>(UNPACKSTRING));
+
+    // String builders
+    register_runtime_function("SB_NEW", 1, reinterpret_cast<void*>(SB_NEW));
+    register_runtime_function("SB_APPEND", 2, reinterpret_cast<void*>(SB_APPEND));
+    register_runtime_function("SB_APPENDC", 2, reinterpret_cast<void*>(SB_APPENDC));
+    register_runtime_function("SB_APPENDN", 2, reinterpret_cast<void*>(SB_APPENDN));
+    register_runtime_function("SB_CLEAR", 1, reinterpret_cast<void*>(SB_CLEAR));
+    register_runtime_function("SB_STRING", 1, reinterpret_cast<void*>(SB_STRING), FunctionType::STANDARD, VarType::POINTER_TO_STRING);
     
     // File I/O functions
     register_runtime_function("SLURP", 1, reinterpret_cast<void*>(SLURP));
@@ -257,6 +282,7 @@ void register_runtime_functions() {
     register_runtime_function("FILE_CLOSE", 1, reinterpret_cast<void*>(FILE_CLOSE));
     register_runtime_function("FILE_WRITES", 2, reinterpret_cast<void*>(FILE_WRITES));
     register_runtime_function("FILE_READS", 1, reinterpret_cast<void*>(FILE_READS));
+    register_runtime_function("FILE_READLINE", 1, reinterpret_cast<void*>(FILE_READLINE), FunctionType::STANDARD, VarType::POINTER_TO_STRING);
     register_runtime_function("FILE_READ", 3, reinterpret_cast<void*>(FILE_READ));
     register_runtime_function("FILE_WRITE", 3, reinterpret_cast<void*>(FILE_WRITE));
     register_runtime_function("FILE_SEEK", 3, reinterpret_cast<void*>(FILE_SEEK));
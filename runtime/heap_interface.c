@@ -49,6 +49,14 @@ void* BCPL_ALLOC_CHARS(int64_t num_chars) {
     return (void*)payload;
 }
 
+/**
+ * Scope-local string allocation. The standalone runtime has no SAMM scopes,
+ * so this is an ordinary BCPL_ALLOC_CHARS.
+ */
+void* BCPL_ALLOC_CHARS_SCOPED(int64_t num_chars) {
+    return BCPL_ALLOC_CHARS(num_chars);
+}
+
 /**
  * Free a BCPL-allocated vector or string.
  * The pointer must be the payload pointer returned by BCPL_ALLOC_WORDS/CHARS.
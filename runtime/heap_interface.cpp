@@ -10,6 +10,7 @@
 #include "runtime.h"
 #include "BCPLError.h"
 #include "ListDataTypes.h"
+#include "string_class.h"
 #include "../HeapManager/HeapManager.h"
 #include <cstdint>
 #include <cstdlib>
@@ -26,6 +27,7 @@ extern "C" {
 
 ListAtom* getNodeFromFreelist();
 void returnNodeToFreelist(ListAtom* node);
+void returnNodeChainToFreelist(ListAtom* head, ListAtom* tail, size_t count);
 ListHeader* getHeaderFromFreelist();
 void returnHeaderToFreelist(ListHeader* header);
 
@@ -165,6 +167,43 @@ void BCPL_LIST_APPEND_OBJECT(ListHeader* header, void* object_ptr) {
     header->length++;
 }
 
+// Bytes a token takes in a shared allocation: its length prefix, then its
+// characters and terminator, padded so the next prefix stays 8-aligned.
+static size_t token_slot_bytes(size_t len) {
+    return sizeof(uint64_t) + ((len + 2) & ~(size_t)1) * sizeof(uint32_t);
+}
+
+/**
+ * @brief Appends SPLIT tokens to a list, all in one string allocation.
+ * Each token is an ordinary string with an exact length prefix, so compiled
+ * code and the string functions read and store into it as before. The last
+ * token sits at the start of the allocation and its atom frees it; TL drops
+ * atoms from the front, so that atom goes last. The other atoms borrow.
+ */
+void bcpl_list_append_tokens(ListHeader* header, const uint32_t* source, const size_t* bounds, size_t count) {
+    if (!header || header->type != ATOM_SENTINEL || count == 0) return;
+
+    size_t total_bytes = 0;
+    for (size_t i = 0; i < count; ++i) total_bytes += token_slot_bytes(bounds[2 * i + 1] - bounds[2 * i]);
+    // bcpl_alloc_chars(n) gives n + 1 code points of room
+    uint64_t* block = (uint64_t*)bcpl_alloc_chars((int64_t)(total_bytes / sizeof(uint32_t)) - 1);
+    if (!block) return;
+
+    uint8_t* cursor = (uint8_t*)block + token_slot_bytes(bounds[2 * count - 1] - bounds[2 * count - 2]);
+    for (size_t i = 0; i < count; ++i) {
+        size_t len = bounds[2 * i + 1] - bounds[2 * i];
+        bool last = i == count - 1;
+        uint64_t* base_ptr = last ? block : (uint64_t*)cursor;
+        uint32_t* chars = (uint32_t*)(base_ptr + 1);
+        memcpy(chars, source + bounds[2 * i], len * sizeof(uint32_t));
+        chars[len] = 0;
+        bcpl_string_set_exact_length(chars, len);
+        BCPL_LIST_APPEND_STRING(header, (uint32_t*)base_ptr);
+        header->tail->pad = last ? ATOM_OWNS_SPLIT : ATOM_BORROWS_STRING;
+        if (!last) cursor += token_slot_bytes(len);
+    }
+}
+
 
 // ============================================================================
 // List Accessors
@@ -215,6 +254,12 @@ void* BCPL_LIST_GET_NTH(void* header_ptr, int64_t n) {
 // List Utilities (Copy, Concat, etc.)
 // ============================================================================
 
+// A shallow copy shares its strings. A SPLIT token's allocation stays with
+// the original list, so the copy's atom only borrows it.
+static int32_t borrowed_pad(const ListAtom* atom) {
+    return atom->type == ATOM_STRING && atom->pad != ATOM_OWNS_STRING ? ATOM_BORROWS_STRING : ATOM_OWNS_STRING;
+}
+
 ListHeader* BCPL_SHALLOW_COPY_LIST(ListHeader* original_header) {
     if (!original_header) return nullptr;
     ListHeader* new_header = BCPL_LIST_CREATE_EMPTY();
@@ -222,6 +267,7 @@ ListHeader* BCPL_SHALLOW_COPY_LIST(ListHeader* original_header) {
     while (current_original) {
         ListAtom* new_node = getNodeFromFreelist();
         new_node->type = current_original->type;
+        new_node->pad = borrowed_pad(current_original);
         new_node->value = current_original->value;
         new_node->next = nullptr;
         if (new_header->head == nullptr) {
@@ -237,6 +283,37 @@ ListHeader* BCPL_SHALLOW_COPY_LIST(ListHeader* original_header) {
     return new_header;
 }
 
+// Copies a UTF-32 string's whole allocation; an exact length stays exact.
+static uint32_t* copy_wide_string(const uint32_t* payload) {
+    uint64_t prefix = ((const uint64_t*)payload)[-1];
+    size_t len = prefix & BCPL_STRING_LENGTH_MASK;
+    uint32_t* copy = (uint32_t*)bcpl_alloc_chars(len);
+    if (!copy) return nullptr;
+    memcpy(copy, payload, (len + 1) * sizeof(uint32_t));
+    ((uint64_t*)copy)[-1] = prefix;
+    return copy;
+}
+
+// Copies a list element string, keeping a compact string compact. A
+// promoted string's copy is UTF-32.
+static uint32_t* copy_list_string(uint64_t* base_ptr) {
+    uint32_t* payload = (uint32_t*)(base_ptr + 1);
+    switch (bcpl_string_class(payload)) {
+        case BCPL_STRING_CLASS_COMPACT: {
+            size_t len = bcpl_string_tagged_length(payload);
+            uint32_t* copy = bcpl_alloc_compact_chars(len);
+            memcpy(copy, payload, len + 1);
+            return copy;
+        }
+        case BCPL_STRING_CLASS_PROMOTED:
+            payload = bcpl_string_forward(payload);
+            break;
+        default:
+            break;
+    }
+    return copy_wide_string(payload);
+}
+
 ListHeader* BCPL_DEEP_COPY_LIST(ListHeader* original_header) {
     if (!original_header) return nullptr;
     ListHeader* new_header = BCPL_LIST_CREATE_EMPTY();
@@ -244,14 +321,12 @@ ListHeader* BCPL_DEEP_COPY_LIST(ListHeader* original_header) {
     while (current_original) {
         ListAtom* new_node = getNodeFromFreelist();
         new_node->type = current_original->type;
+        new_node->pad = ATOM_OWNS_STRING;
         new_node->next = nullptr;
 
         switch (current_original->type) {
             case ATOM_STRING: {
-                uint64_t* base_ptr = (uint64_t*)current_original->value.ptr_value;
-                size_t len = base_ptr[0];
-                uint32_t* new_str_payload = (uint32_t*)bcpl_alloc_chars(len);
-                memcpy(new_str_payload, (uint32_t*)(base_ptr + 1), (len + 1) * sizeof(uint32_t));
+                uint32_t* new_str_payload = copy_list_string((uint64_t*)current_original->value.ptr_value);
                 new_node->value.ptr_value = (uint64_t*)new_str_payload - 1;
                 break;
             }
@@ -284,14 +359,13 @@ ListHeader* BCPL_DEEP_COPY_LITERAL_LIST(ListLiteralHeader* literal_header) {
     while (current_original) {
         ListAtom* new_node = getNodeFromFreelist();
         new_node->type = current_original->type;
+        new_node->pad = ATOM_OWNS_STRING;
         new_node->next = nullptr;
         // Deep copy logic for strings/nested lists
         switch (current_original->type) {
             case ATOM_STRING: {
                 uint64_t* base_ptr = (uint64_t*)current_original->value.ptr_value;
-                size_t len = base_ptr[0];
-                uint32_t* new_str_payload = (uint32_t*)bcpl_alloc_chars(len);
-                memcpy(new_str_payload, (uint32_t*)(base_ptr + 1), (len + 1) * sizeof(uint32_t));
+                uint32_t* new_str_payload = copy_wide_string((uint32_t*)(base_ptr + 1));
                 new_node->value.ptr_value = (uint64_t*)new_str_payload - 1;
                 break;
             }
@@ -344,6 +418,7 @@ ListHeader* BCPL_REVERSE_LIST(ListHeader* original_header) {
     while (current_original) {
         ListAtom* new_node = getNodeFromFreelist();
         new_node->type = current_original->type;
+        new_node->pad = borrowed_pad(current_original);
         new_node->value = current_original->value;
         new_node->next = new_header->head; // Prepend
         new_header->head = new_node;
@@ -394,23 +469,32 @@ void bcpl_free_list(void* header_ptr) {
     if (!header) return;
     
     ListAtom* current = header->head;
+    ListAtom* tail = nullptr;
+    size_t node_count = 0;
     while (current) {
         ListAtom* next = current->next;
         
         // Only free string data if this list doesn't contain literals
         if (current->type == ATOM_STRING && current->value.ptr_value && !header->contains_literals) {
-            // For strings, adjust the pointer back to the original allocation
-            // The string pointer was adjusted by -1 during allocation to account for length prefix
-            uint64_t* original_alloc_ptr = (uint64_t*)current->value.ptr_value + 1;
-            bcpl_free(original_alloc_ptr);
+            if (current->pad == ATOM_OWNS_SPLIT) {
+                // The token's prefix is the payload of the SPLIT allocation
+                bcpl_free(current->value.ptr_value);
+            } else if (current->pad != ATOM_BORROWS_STRING) {
+                // For strings, adjust the pointer back to the original allocation
+                // The string pointer was adjusted by -1 during allocation to account for length prefix
+                uint64_t* original_alloc_ptr = (uint64_t*)current->value.ptr_value + 1;
+                bcpl_free(original_alloc_ptr);
+            }
         } else if (current->type == ATOM_LIST_POINTER && current->value.ptr_value) {
             // For nested lists, free recursively
             bcpl_free_list(current->value.ptr_value);
         }
-        // Always free the list node itself
-        returnNodeToFreelist(current);
+        tail = current;
+        node_count++;
         current = next;
     }
+    // Hand every node back to the freelist in one batch
+    returnNodeChainToFreelist(header->head, tail, node_count);
     HeapManager::getInstance().free(header);
 }
 
@@ -426,6 +510,7 @@ void bcpl_free_list_safe(void* header_ptr) {
     }
     
     ListAtom* current = header->head;
+    ListAtom* tail = nullptr;
     int node_count = 0;
     while (current && node_count < 1000) { // Limit iterations to prevent infinite loops
         ListAtom* next = current->next;
@@ -441,10 +526,13 @@ void bcpl_free_list_safe(void* header_ptr) {
         }
         // Note: We skip freeing ATOM_STRING data to avoid literal string issues
         
-        returnNodeToFreelist(current);
+        tail = current;
         current = next;
         node_count++;
     }
+    if (node_count < 1000) {
+        returnNodeChainToFreelist(header->head, tail, node_count);
+    }
     
     if (node_count < 1000) {
         try {
@@ -39,6 +39,11 @@ ListHeader* BCPL_LIST_CREATE_EMPTY(void);
  */
 void BCPL_LIST_APPEND_STRING(ListHeader* header, uint32_t* value);
 void BCPL_LIST_APPEND_OBJECT(ListHeader* header, void* object_ptr);
+/**
+ * Appends `count` UTF-32 tokens to a list, copied into one string allocation.
+ * Token i is source[bounds[2*i]] up to source[bounds[2*i + 1]].
+ */
+void bcpl_list_append_tokens(ListHeader* header, const uint32_t* source, const size_t* bounds, size_t count);
 
 // Internal (typed) versions for use within the runtime:
 double   list_get_head_as_float(ListHeader* header);
@@ -70,6 +70,17 @@ void* bcpl_getvec(int64_t num_words) {
     return bcpl_alloc_words(num_words, "GETVEC", "vector");
 }
 
+// Scope-local VEC: the compiler emits this for vectors that never leave
+// their block; storage is released in bulk when the SAMM scope exits.
+void* bcpl_getvec_scoped(int64_t num_words) {
+    return HeapManager::getInstance().allocVecScoped(num_words);
+}
+
+// Scope-local STRING counterpart of bcpl_alloc_chars.
+void* bcpl_alloc_chars_scoped(int64_t num_chars) {
+    return HeapManager::getInstance().allocStringScoped(num_chars);
+}
+
 // Wrapper for FGETVEC that allocates float vectors (num_words * sizeof(double))
 void* bcpl_fgetvec(int64_t num_floats) {
     // Each float is 8 bytes (double precision), so we need num_floats * 8 bytes
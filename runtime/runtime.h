@@ -65,6 +65,55 @@ void* bcpl_alloc_chars(int64_t num_chars);
  */
 void bcpl_free(void* ptr);
 
+//=============================================================================
+// Compact strings (see string_class.h)
+//=============================================================================
+
+/**
+ * Nonzero when the runtime builds one-byte-per-character strings for
+ * Latin-1 text it reads or assembles (SLURP, FILE_READS, FILE_READLINE,
+ * SPLIT, JOIN). Set from --compact-strings; code reading such strings must
+ * be compiled with that flag too.
+ */
+extern int bcpl_compact_strings_enabled;
+void bcpl_set_compact_strings(int enabled);
+
+/**
+ * Allocates a compact string of num_chars Latin-1 characters, terminated.
+ *
+ * @param num_chars Number of characters (excluding the terminator)
+ * @return          Pointer to the payload bytes, or NULL on failure
+ */
+uint32_t* bcpl_alloc_compact_chars(int64_t num_chars);
+
+/**
+ * Moves a compact string's characters to a UTF-32 copy, leaving the string
+ * forwarding to it. Called by compiled code before it stores a code point
+ * above U+00FF into a compact string.
+ *
+ * @param s A string of any storage class
+ * @return  The UTF-32 payload that now holds the characters
+ */
+uint32_t* BCPL_STRING_PROMOTE(uint32_t* s);
+
+/**
+ * Decodes UTF-8 into a new string: compact when compact strings are
+ * enabled and every character is Latin-1, UTF-32 otherwise.
+ */
+uint32_t* bcpl_string_from_utf8(const unsigned char* src, size_t len);
+
+/**
+ * Reads `size` bytes of UTF-8 from a stream into a new string, decoding
+ * through a fixed-size chunk: compact when compact strings are enabled and
+ * every character is Latin-1, UTF-32 otherwise. Memory use is the result
+ * and the chunk, whatever the size.
+ *
+ * @param bytes_read Set to the bytes read; fewer than `size` is a short
+ *                   read, and the caller frees the result
+ * @return           The string, or NULL if it could not be allocated
+ */
+uint32_t* bcpl_string_read_utf8(FILE* file, size_t size, size_t* bytes_read);
+
 //=============================================================================
 // Core I/O and System
 //=============================================================================
@@ -194,10 +243,23 @@ int64_t RDCH(void);
 void finish(void);
 
 /**
- * Prints a newline character to standard output and flushes.
+ * Prints a newline character to standard output. It is flushed at once
+ * when standard output is a terminal.
  */
 void NEWLINE(void);
 
+/**
+ * Writes any buffered WRITES/WRITEF/WRITEN/WRITEC/NEWLINE output to stdout
+ * and flushes it. Called at FINISH, before RDCH and at exit; the host calls
+ * it before printing anything of its own after the program returns.
+ */
+void bcpl_output_flush(void);
+
+/**
+ * Like bcpl_output_flush, but only uses write(2), for the fatal signal handler.
+ */
+void bcpl_output_flush_signal_safe(void);
+
 //=============================================================================
 // String Utilities
 //=============================================================================
@@ -249,6 +311,45 @@ int64_t STRCMP(const uint32_t* s1, const uint32_t* s2);
  */
 uint32_t* STRCOPY(uint32_t* dst, const uint32_t* src);
 
+//=============================================================================
+// String Builders
+//=============================================================================
+
+/**
+ * Creates a string builder: a handle that strings, characters and numbers
+ * are appended to in amortized O(1) time per character. The runtime string
+ * functions (WRITES, STRLEN, STRCMP, JOIN, FILE_WRITES, ...) accept a builder
+ * as the string built so far; SB_STRING copies it into a new string.
+ *
+ * @param capacity Characters to reserve up front (0 for the default)
+ * @return         The builder, or NULL on failure
+ */
+uint32_t* SB_NEW(int64_t capacity);
+
+/**
+ * Appends a string of any storage class, or a builder, to a builder.
+ *
+ * @return The builder
+ */
+uint32_t* SB_APPEND(uint32_t* builder, uint32_t* s);
+
+/** Appends one character (a code point) to a builder. Returns the builder. */
+uint32_t* SB_APPENDC(uint32_t* builder, int64_t ch);
+
+/** Appends an integer in decimal to a builder. Returns the builder. */
+uint32_t* SB_APPENDN(uint32_t* builder, int64_t n);
+
+/** Empties a builder, keeping its buffer. Returns the builder. */
+uint32_t* SB_CLEAR(uint32_t* builder);
+
+/**
+ * Copies a builder's contents into a new string, compact when compact
+ * strings are enabled and every character is Latin-1.
+ *
+ * @return The new string, or NULL on failure
+ */
+uint32_t* SB_STRING(uint32_t* builder);
+
 //=============================================================================
 // File I/O
 //=============================================================================
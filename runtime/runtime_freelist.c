@@ -3,6 +3,11 @@
  * Canonical freelist implementation for BCPL runtime.
  * Provides thread-safe allocation and deallocation of ListAtom and ListHeader nodes,
  * tracks allocated chunks for cleanup, and exposes API for use in both standalone and JIT builds.
+ *
+ * ListAtoms are served from per-thread magazines. A magazine is refilled with
+ * a whole batch popped from a lock-free global depot, and overflowing
+ * magazines push a batch back, so the common get/return path touches no
+ * shared state at all. freelist_mutex is only taken to carve new chunks.
  */
 
 #include <stdlib.h>
@@ -35,14 +40,53 @@ typedef struct ListHeader {
 } ListHeader;
 
 // --- Freelist globals ---
-static ListAtom* g_free_list_head = NULL;
 static ListHeader* g_header_free_list_head = NULL;
 
+// --- Lock-free depot of ListAtom batches ---
+// A batch is a NULL-terminated chain linked through `next`. The first node of
+// a batch stores the batch length in `pad` and the link to the next batch in
+// `value.ptr_value`. The depot head packs a 16-bit ABA tag into the unused
+// top bits of the pointer (user-space addresses fit in 48 bits on AArch64
+// and x86-64), so push/pop are a single-word CAS.
+#define DEPOT_TAG_SHIFT 48
+#define DEPOT_PTR_MASK ((((uintptr_t)1) << DEPOT_TAG_SHIFT) - 1)
+#define DEPOT_TAG_ONE (((uintptr_t)1) << DEPOT_TAG_SHIFT)
+static uintptr_t g_atom_depot = 0;
+
+// Bumped by cleanup_freelists() so that a thread which next uses the
+// freelist (or exits) drops its magazine, which points into freed chunks,
+// instead of reusing or publishing it.
+static unsigned g_freelist_generation = 1;
+
+// Number of threads holding a magazine of the current generation. While
+// cleanup_freelists() runs it sets FREELIST_CLOSED, and threads starting a
+// magazine wait for it on freelist_mutex.
+#define FREELIST_CLOSED (((size_t)1) << (sizeof(size_t) * 8 - 1))
+static size_t g_live_magazines = 0;
+
+// --- Per-thread magazines ---
+#define MAGAZINE_SIZE 256
+static __thread ListAtom* t_magazine_head = NULL;
+static __thread size_t t_magazine_count = 0;
+static __thread unsigned t_magazine_generation = 0;
+
+// Per-thread metric deltas, folded into the globals on the slow path.
+static __thread size_t t_pending_requests = 0;
+static __thread size_t t_pending_reused = 0;
+static __thread size_t t_pending_returns = 0;
+
+// Flushes the exiting thread's magazine back to the depot.
+static pthread_key_t g_magazine_key;
+static pthread_once_t g_magazine_key_once = PTHREAD_ONCE_INIT;
+
+static inline int magazine_is_live(void);
+size_t freelist_node_count(void);
+
 // --- Freelist metrics ---
-static size_t g_freelist_node_count = 0;
 static size_t g_total_nodes_allocated_from_heap = 0;
 static size_t g_nodes_reused_from_freelist = 0;
 static size_t g_total_node_requests = 0;
+static size_t g_total_node_returns = 0;
 
 // --- Constants ---
 #define INITIAL_FREELIST_CHUNK_SIZE 1024
@@ -101,6 +145,64 @@ static void track_header_chunk(void* chunk) {
     header_chunk_list_head = node;
 }
 
+// --- Depot operations ---
+static void depot_push_batch(ListAtom* head, size_t count) {
+    head->pad = (int32_t)count;
+    uintptr_t old = __atomic_load_n(&g_atom_depot, __ATOMIC_RELAXED);
+    uintptr_t desired;
+    do {
+        head->value.ptr_value = (void*)(old & DEPOT_PTR_MASK);
+        desired = (uintptr_t)head | ((old & ~DEPOT_PTR_MASK) + DEPOT_TAG_ONE);
+    } while (!__atomic_compare_exchange_n(&g_atom_depot, &old, desired, 1,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static ListAtom* depot_pop_batch(size_t* count_out) {
+    uintptr_t old = __atomic_load_n(&g_atom_depot, __ATOMIC_ACQUIRE);
+    for (;;) {
+        ListAtom* head = (ListAtom*)(old & DEPOT_PTR_MASK);
+        if (head == NULL) {
+            return NULL;
+        }
+        // Chunks are only freed by cleanup_freelists(), which refuses to run
+        // while another thread holds a magazine, so a node another thread
+        // has just popped is still mapped. Reading its stale link is
+        // harmless; the tag makes the CAS fail.
+        uintptr_t next = (uintptr_t)head->value.ptr_value;
+        uintptr_t desired = next | ((old & ~DEPOT_PTR_MASK) + DEPOT_TAG_ONE);
+        if (__atomic_compare_exchange_n(&g_atom_depot, &old, desired, 1,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            *count_out = (size_t)head->pad;
+            return head;
+        }
+    }
+}
+
+// Fold this thread's metric deltas into the global counters.
+static void flush_thread_metrics(void) {
+    if (t_pending_requests) __atomic_fetch_add(&g_total_node_requests, t_pending_requests, __ATOMIC_RELAXED);
+    if (t_pending_reused) __atomic_fetch_add(&g_nodes_reused_from_freelist, t_pending_reused, __ATOMIC_RELAXED);
+    if (t_pending_returns) __atomic_fetch_add(&g_total_node_returns, t_pending_returns, __ATOMIC_RELAXED);
+    t_pending_requests = t_pending_reused = t_pending_returns = 0;
+}
+
+static void magazine_thread_exit(void* unused) {
+    (void)unused;
+    if (magazine_is_live()) {
+        if (t_magazine_head) {
+            depot_push_batch(t_magazine_head, t_magazine_count);
+        }
+        __atomic_fetch_sub(&g_live_magazines, 1, __ATOMIC_RELEASE);
+    }
+    t_magazine_head = NULL;
+    t_magazine_count = 0;
+    flush_thread_metrics();
+}
+
+static void create_magazine_key(void) {
+    pthread_key_create(&g_magazine_key, magazine_thread_exit);
+}
+
 // --- Freelist replenishment ---
 static void replenishFreelist() {
     // Adaptive scaling: if we're replenishing frequently, scale up chunk size
@@ -151,10 +253,8 @@ static void replenishFreelist() {
     }
     new_chunk[nodes_to_alloc - 1].next = NULL;
 
-    // Prepend this new chunk to the (potentially empty) existing freelist.
-    new_chunk[nodes_to_alloc - 1].next = g_free_list_head;
-    g_free_list_head = new_chunk;
-    g_freelist_node_count += nodes_to_alloc;
+    // Publish the whole chunk to the depot as a single batch.
+    depot_push_batch(new_chunk, nodes_to_alloc);
 }
 
 static void replenishHeaderFreelist() {
@@ -206,35 +306,136 @@ static void replenishHeaderFreelist() {
 extern "C" {
 #endif
 
+static inline int magazine_is_live(void) {
+   return t_magazine_generation == __atomic_load_n(&g_freelist_generation, __ATOMIC_RELAXED);
+}
+
+// First use on this thread (or first use after cleanup_freelists): start an
+// empty magazine and register the thread-exit flush.
+static void start_magazine(void) {
+   pthread_once(&g_magazine_key_once, create_magazine_key);
+   pthread_setspecific(g_magazine_key, (void*)1);
+   size_t live = __atomic_load_n(&g_live_magazines, __ATOMIC_ACQUIRE);
+   for (;;) {
+       if (live & FREELIST_CLOSED) {
+           // cleanup_freelists() holds the mutex until it reopens
+           pthread_mutex_lock(&freelist_mutex);
+           pthread_mutex_unlock(&freelist_mutex);
+           live = __atomic_load_n(&g_live_magazines, __ATOMIC_ACQUIRE);
+           continue;
+       }
+       if (__atomic_compare_exchange_n(&g_live_magazines, &live, live + 1, 1,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+           break;
+       }
+   }
+   t_magazine_generation = __atomic_load_n(&g_freelist_generation, __ATOMIC_ACQUIRE);
+   t_magazine_head = NULL;
+   t_magazine_count = 0;
+}
+
+// Slow path: the thread's magazine is empty (or stale after cleanup).
+static ListAtom* refill_magazine(void) {
+   if (!magazine_is_live()) {
+       start_magazine();
+   }
+   flush_thread_metrics();
+
+   size_t count = 0;
+   ListAtom* batch = depot_pop_batch(&count);
+   if (batch == NULL) {
+       pthread_mutex_lock(&freelist_mutex);
+       // Another thread may have replenished while we waited for the lock.
+       batch = depot_pop_batch(&count);
+       if (batch == NULL) {
+           replenishFreelist();
+           batch = depot_pop_batch(&count);
+       }
+       pthread_mutex_unlock(&freelist_mutex);
+   } else {
+       t_pending_reused++;
+   }
+   t_magazine_head = batch;
+   t_magazine_count = count;
+   return batch;
+}
+
 ListAtom* getNodeFromFreelist() {
-   if (!freelist_initialized) {
+   if (!__atomic_load_n(&freelist_initialized, __ATOMIC_ACQUIRE)) {
        initialize_freelist();
    }
-   pthread_mutex_lock(&freelist_mutex);
-   g_total_node_requests++;
-   if (g_free_list_head == NULL) {
-       replenishFreelist();
+   t_pending_requests++;
+   ListAtom* node = t_magazine_head;
+   if (node == NULL || !magazine_is_live()) {
+       node = refill_magazine();
+       if (node == NULL) {
+           _BCPL_SET_ERROR(ERROR_OUT_OF_MEMORY, "getNodeFromFreelist", "Freelist depot empty after replenish");
+           return NULL;
+       }
    } else {
-       g_nodes_reused_from_freelist++;
+       t_pending_reused++;
    }
-   ListAtom* node = g_free_list_head;
-   g_free_list_head = g_free_list_head->next;
-   g_freelist_node_count--;
-   pthread_mutex_unlock(&freelist_mutex);
-   
+   t_magazine_head = node->next;
+   t_magazine_count--;
+
    // SAMM: Individual ListAtoms are not tracked in scope
    // Only ListHeaders are tracked since they own the entire list
-   
+
    return node;
 }
 
+// Keep MAGAZINE_SIZE nodes locally and push the rest to the depot as one batch.
+static void spill_magazine(void) {
+    ListAtom* keep_tail = t_magazine_head;
+    for (size_t i = 1; i < MAGAZINE_SIZE; ++i) {
+        keep_tail = keep_tail->next;
+    }
+    ListAtom* spill = keep_tail->next;
+    keep_tail->next = NULL;
+    depot_push_batch(spill, t_magazine_count - MAGAZINE_SIZE);
+    t_magazine_count = MAGAZINE_SIZE;
+}
+
 void returnNodeToFreelist(ListAtom* node) {
     if (!node) return;
-    pthread_mutex_lock(&freelist_mutex);
-    node->next = g_free_list_head;
-    g_free_list_head = node;
-    g_freelist_node_count++;
-    pthread_mutex_unlock(&freelist_mutex);
+    if (!magazine_is_live()) {
+        start_magazine();
+    }
+    node->next = t_magazine_head;
+    t_magazine_head = node;
+    t_pending_returns++;
+    if (++t_magazine_count >= 2 * MAGAZINE_SIZE) {
+        spill_magazine();
+    }
+}
+
+void returnNodeChainToFreelist(ListAtom* head, ListAtom* tail, size_t count) {
+    if (!head || !tail || count == 0) return;
+    t_pending_returns += count;
+    if (!magazine_is_live()) {
+        start_magazine();
+    }
+    if (t_magazine_count + count < 2 * MAGAZINE_SIZE) {
+        // Small chain: splice it into the local magazine
+        tail->next = t_magazine_head;
+        t_magazine_head = head;
+        t_magazine_count += count;
+        return;
+    }
+    // Large chain: publish it as one depot batch with a single CAS
+    tail->next = NULL;
+    depot_push_batch(head, count);
+}
+
+void returnNodeListToFreelist(ListAtom* head) {
+    if (!head) return;
+    ListAtom* tail = head;
+    size_t count = 1;
+    while (tail->next) {
+        tail = tail->next;
+        count++;
+    }
+    returnNodeChainToFreelist(head, tail, count);
 }
 
 // --- API: Get/Return ListHeader nodes ---
@@ -269,9 +470,23 @@ void returnHeaderToFreelist(ListHeader* header) {
 }
 
 // --- API: Freelist cleanup ---
+// Frees every chunk. If another thread holds a magazine it may be popping
+// from the depot or using nodes from the chunks, so nothing is freed and an
+// error is raised instead. Otherwise the freelist is closed while the chunks
+// go, so no thread can start a magazine meanwhile, and the generation bump
+// makes every older magazine stale.
 void cleanup_freelists() {
    pthread_mutex_lock(&freelist_mutex);
 
+   size_t own = magazine_is_live() ? 1 : 0;
+   size_t expected = own;
+   if (!__atomic_compare_exchange_n(&g_live_magazines, &expected, own | FREELIST_CLOSED, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+       pthread_mutex_unlock(&freelist_mutex);
+       _BCPL_SET_ERROR(ERROR_INVALID_ARGUMENT, "cleanup_freelists", "Freelist is in use by another thread");
+       return;
+   }
+
    // Free all atom chunks
    ChunkNode* node = atom_chunk_list_head;
    while (node) {
@@ -292,20 +507,27 @@ void cleanup_freelists() {
    }
    header_chunk_list_head = NULL;
 
-   // Reset freelist pointers
-   g_free_list_head = NULL;
+   // Reset freelist pointers; magazines held by any thread become stale
+   __atomic_store_n(&g_atom_depot, 0, __ATOMIC_RELEASE);
+   __atomic_fetch_add(&g_freelist_generation, 1, __ATOMIC_ACQ_REL);
+   t_magazine_head = NULL;
+   t_magazine_count = 0;
    g_header_free_list_head = NULL;
-   g_freelist_node_count = 0;
    g_total_nodes_allocated_from_heap = 0;
    g_nodes_reused_from_freelist = 0;
    g_total_node_requests = 0;
+   g_total_node_returns = 0;
+   t_pending_requests = t_pending_reused = t_pending_returns = 0;
    freelist_initialized = 0;
 
+   // Reopen: no magazine of the new generation exists yet
+   __atomic_store_n(&g_live_magazines, 0, __ATOMIC_RELEASE);
    pthread_mutex_unlock(&freelist_mutex);
 }
 
 // --- Metrics API ---
 void printFreelistMetrics() {
+    flush_thread_metrics();
     printf("\n=== Freelist Adaptive Scaling Metrics ===\n");
     printf("Atom replenishments: %zu\n", total_atom_replenishments);
     printf("Header replenishments: %zu\n", total_header_replenishments);
@@ -319,7 +541,7 @@ void printFreelistMetrics() {
     printf("Total node requests: %zu\n", g_total_node_requests);
     printf("Nodes reused from freelist: %zu\n", g_nodes_reused_from_freelist);
     printf("Freelist reuse rate: %.2f%%\n", g_total_node_requests > 0 ? (double)g_nodes_reused_from_freelist / g_total_node_requests * 100.0 : 0.0);
-    printf("Current freelist node count: %zu\n", g_freelist_node_count);
+    printf("Current freelist node count: %zu\n", freelist_node_count());
     printf("==========================================\n");
 }
 
@@ -342,7 +564,7 @@ void initialize_freelist(void) {
    if (!freelist_initialized) {
        replenishFreelist();
        replenishHeaderFreelist();
-       freelist_initialized = 1;
+       __atomic_store_n(&freelist_initialized, 1, __ATOMIC_RELEASE);
    }
    pthread_mutex_unlock(&freelist_mutex);
 }
@@ -352,11 +574,14 @@ void initialize_freelist(void) {
 #endif
 
 // --- Optional: Metrics accessors ---
+// Free nodes = nodes carved from the heap minus nodes still handed out.
+// Counts are folded in lazily from per-thread deltas, so this is approximate.
 size_t freelist_node_count() {
-    pthread_mutex_lock(&freelist_mutex);
-    size_t count = g_freelist_node_count;
-    pthread_mutex_unlock(&freelist_mutex);
-    return count;
+    size_t allocated = __atomic_load_n(&g_total_nodes_allocated_from_heap, __ATOMIC_RELAXED);
+    size_t requests = __atomic_load_n(&g_total_node_requests, __ATOMIC_RELAXED);
+    size_t returns = __atomic_load_n(&g_total_node_returns, __ATOMIC_RELAXED);
+    size_t outstanding = requests > returns ? requests - returns : 0;
+    return allocated > outstanding ? allocated - outstanding : 0;
 }
 
 size_t total_nodes_allocated() {
@@ -23,13 +23,19 @@ ListAtom* getNodeFromFreelist(void);
 // Return a ListAtom to the freelist
 void returnNodeToFreelist(ListAtom* node);
 
+// Return a whole chain of ListAtoms (head..tail, `count` nodes) in O(1)
+void returnNodeChainToFreelist(ListAtom* head, ListAtom* tail, size_t count);
+
+// Return a NULL-terminated chain of ListAtoms (walks it once to find the tail)
+void returnNodeListToFreelist(ListAtom* head);
+
 // Allocate a ListHeader from the freelist
 ListHeader* getHeaderFromFreelist(void);
 
 // Return a ListHeader to the freelist
 void returnHeaderToFreelist(ListHeader* header);
 
-// Cleanup all freelist memory (call at shutdown)
+// Cleanup all freelist memory; refused with an error while another thread holds a magazine
 void cleanup_freelists(void);
 
 #ifdef __cplusplus
@@ -7,64 +7,58 @@
 
 #include "runtime.h"         // For runtime function signatures and types
 #include "ListDataTypes.h"   // For ListHeader, ListAtom, etc.
-#include "heap_interface.h"  // For BCPL_LIST_CREATE_EMPTY, BCPL_LIST_APPEND_STRING, bcpl_alloc_chars
+#include "heap_interface.h"  // For BCPL_LIST_CREATE_EMPTY, BCPL_LIST_APPEND_STRING, bcpl_list_append_tokens
+#include "string_kernels.h"  // For bcpl_string_length, bcpl_string_find
+#include "string_class.h"    // For compact strings
+#include <stdlib.h>          // For malloc, free
 #include <string.h>          // For memcpy
 #include <stdint.h>
 #include <stddef.h>
 
 /**
- * @brief Calculate the length of a BCPL string payload.
- * @param s Pointer to the start of the character data.
- * @return The number of characters before the null terminator.
+ * @brief Narrows a string to Latin-1 bytes in a malloc'd buffer.
+ * Returns NULL if it has a wider character (or allocation fails).
  */
-static size_t bcpl_strlen(const uint32_t* s) {
-    if (!s) return 0;
-    size_t len = 0;
-    while (s[len] != 0) {
-        len++;
+static uint8_t* narrow_to_bytes(const uint32_t* s, size_t* len) {
+    uint32_t* temp;
+    const uint32_t* wide = bcpl_string_wide_view(s, len, &temp);
+    uint8_t* bytes = (uint8_t*)malloc(*len + 1);
+    if (bytes && ((s && !wide) || bcpl_latin1_narrow(wide, *len, bytes) != *len)) {
+        free(bytes);
+        bytes = NULL;
     }
-    return len;
-}
-
-/**
- * @brief Compare the start of a string with a delimiter.
- * @param s The string to check.
- * @param delimiter The delimiter to look for.
- * @param delimiter_len The length of the delimiter.
- * @return 1 if it matches, 0 otherwise.
- */
-static int bcpl_strncmp(const uint32_t* s, const uint32_t* delimiter, size_t delimiter_len) {
-    for (size_t i = 0; i < delimiter_len; ++i) {
-        if (s[i] != delimiter[i]) {
-            return 0; // No match
-        }
-        if (s[i] == 0) {
-            return 0; // Source is shorter than delimiter
-        }
-    }
-    return 1; // Match
+    free(temp);
+    return bytes;
 }
 
 /**
  * @brief Joins a list of BCPL strings into a single string using a delimiter.
  * This implementation relies on bcpl_alloc_chars handling 16-byte alignment.
+ * The result is compact when compact strings are enabled, every element is
+ * compact and the delimiter is Latin-1.
  */
 uint32_t* BCPL_JOIN_LIST(struct ListHeader* list_header, uint32_t* delimiter_payload) {
     if (!list_header || !list_header->head) {
         return (uint32_t*)bcpl_alloc_chars(0); // Return a new empty string
     }
 
-    size_t delimiter_len = bcpl_strlen(delimiter_payload);
+    size_t delimiter_len = 0;
+    uint32_t* delimiter_temp = NULL;
+    const uint32_t* delimiter = bcpl_string_wide_view(delimiter_payload, &delimiter_len, &delimiter_temp);
 
     // --- Pass 1: Calculate the total length required for the new string ---
     size_t total_char_len = 0;
     size_t element_count = 0;
+    int all_compact = bcpl_compact_strings_enabled;
     struct ListAtom* current = list_header->head;
 
     while (current) {
         if (current->type == ATOM_STRING && current->value.ptr_value != NULL) {
             uint64_t* base_ptr = (uint64_t*)current->value.ptr_value;
-            total_char_len += base_ptr[0]; // Add the length from the prefix
+            uint32_t* element_payload = (uint32_t*)(base_ptr + 1);
+            int element_class = bcpl_string_class(element_payload);
+            total_char_len += bcpl_string_any_length(element_payload);
+            all_compact = all_compact && element_class == BCPL_STRING_CLASS_COMPACT;
             element_count++;
         }
         current = current->next;
@@ -74,26 +68,51 @@ uint32_t* BCPL_JOIN_LIST(struct ListHeader* list_header, uint32_t* delimiter_pay
         total_char_len += delimiter_len * (element_count - 1);
     }
 
+    uint8_t* delimiter_bytes = NULL;
+    if (all_compact && element_count > 0) {
+        delimiter_bytes = narrow_to_bytes(delimiter, &delimiter_len);
+    }
+
     // --- Pass 2: Allocate memory and build the final string ---
-    uint32_t* result_payload = (uint32_t*)bcpl_alloc_chars(total_char_len);
-    if (!result_payload) return NULL;
+    uint32_t* result_payload = delimiter_bytes ? bcpl_alloc_compact_chars(total_char_len)
+                                               : (uint32_t*)bcpl_alloc_chars(total_char_len);
+    if (!result_payload) {
+        free(delimiter_bytes);
+        free(delimiter_temp);
+        return NULL;
+    }
 
     uint32_t* cursor = result_payload;
+    uint8_t* byte_cursor = (uint8_t*)result_payload;
     current = list_header->head;
     size_t i = 0;
 
     while (current) {
         if (current->type == ATOM_STRING && current->value.ptr_value != NULL) {
             uint64_t* base_ptr = (uint64_t*)current->value.ptr_value;
-            uint64_t element_len = base_ptr[0];
             uint32_t* element_payload = (uint32_t*)(base_ptr + 1);
-
-            memcpy(cursor, element_payload, element_len * sizeof(uint32_t));
-            cursor += element_len;
-
-            if (i < element_count - 1 && delimiter_len > 0) {
-                memcpy(cursor, delimiter_payload, delimiter_len * sizeof(uint32_t));
-                cursor += delimiter_len;
+            int element_class = bcpl_string_class(element_payload);
+            size_t element_len = bcpl_string_any_length(element_payload);
+
+            if (delimiter_bytes) {
+                memcpy(byte_cursor, bcpl_string_bytes(element_payload), element_len);
+                byte_cursor += element_len;
+                if (i < element_count - 1 && delimiter_len > 0) {
+                    memcpy(byte_cursor, delimiter_bytes, delimiter_len);
+                    byte_cursor += delimiter_len;
+                }
+            } else {
+                if (element_class == BCPL_STRING_CLASS_COMPACT) {
+                    bcpl_latin1_widen(bcpl_string_bytes(element_payload), element_len, cursor);
+                } else {
+                    if (element_class == BCPL_STRING_CLASS_PROMOTED) element_payload = bcpl_string_forward(element_payload);
+                    memcpy(cursor, element_payload, element_len * sizeof(uint32_t));
+                }
+                cursor += element_len;
+                if (i < element_count - 1 && delimiter_len > 0) {
+                    memcpy(cursor, delimiter, delimiter_len * sizeof(uint32_t));
+                    cursor += delimiter_len;
+                }
             }
             i++;
         }
@@ -101,12 +120,56 @@ uint32_t* BCPL_JOIN_LIST(struct ListHeader* list_header, uint32_t* delimiter_pay
     }
 
     // The null terminator is already set by bcpl_alloc_chars.
+    if (!delimiter_bytes) bcpl_string_set_exact_length(result_payload, total_char_len);
+    free(delimiter_bytes);
+    free(delimiter_temp);
     return result_payload;
 }
 
+/**
+ * @brief Splits a compact string into compact tokens. A delimiter with a
+ * character outside Latin-1 cannot occur in it, so the string is one token.
+ */
+static void split_compact_string(struct ListHeader* result_list, const uint32_t* source_payload,
+                                 const uint32_t* delimiter_payload) {
+    const uint8_t* source = bcpl_string_bytes(source_payload);
+    size_t source_len = bcpl_compact_length(source_payload);
+    size_t delimiter_len = 0;
+    uint8_t* delimiter = narrow_to_bytes(delimiter_payload, &delimiter_len);
+
+    size_t start = 0;
+    for (;;) {
+        size_t found = BCPL_STRING_NOT_FOUND;
+        size_t end;
+        if (delimiter && delimiter_len == 0) {
+            // Empty delimiter splits into single characters
+            if (start >= source_len) break;
+            end = start + 1;
+        } else {
+            if (delimiter) found = bcpl_compact_find(source, source_len, delimiter, delimiter_len, start);
+            end = found == BCPL_STRING_NOT_FOUND ? source_len : found;
+        }
+        uint32_t* token_payload = bcpl_alloc_compact_chars(end - start);
+        if (token_payload) {
+            memcpy(token_payload, source + start, end - start);
+            void* base_ptr = (uint64_t*)token_payload - 1;
+            BCPL_LIST_APPEND_STRING(result_list, (uint32_t*)base_ptr);
+        }
+
+        if (delimiter && delimiter_len == 0) {
+            start = end;
+            continue;
+        }
+        if (found == BCPL_STRING_NOT_FOUND) break;
+        start = found + delimiter_len;
+    }
+    free(delimiter);
+}
+
 /**
  * @brief Splits a BCPL string by a delimiter into a list of new BCPL strings.
- * This implementation relies on bcpl_alloc_chars handling 16-byte alignment.
+ * UTF-32 tokens share one allocation owned by the list (see
+ * bcpl_list_append_tokens in heap_interface.cpp).
  */
 struct ListHeader* BCPL_SPLIT_STRING(uint32_t* source_payload, uint32_t* delimiter_payload) {
     struct ListHeader* result_list = BCPL_LIST_CREATE_EMPTY();
@@ -114,48 +177,59 @@ struct ListHeader* BCPL_SPLIT_STRING(uint32_t* source_payload, uint32_t* delimit
         return result_list; // Return empty list on invalid input
     }
 
-    size_t delimiter_len = bcpl_strlen(delimiter_payload);
+    switch (bcpl_string_class(source_payload)) {
+        case BCPL_STRING_CLASS_COMPACT:
+            split_compact_string(result_list, source_payload, delimiter_payload);
+            return result_list;
+        case BCPL_STRING_CLASS_PROMOTED:
+            source_payload = bcpl_string_forward(source_payload);
+            break;
+        default:
+            break;
+    }
+    uint32_t* delimiter_temp = NULL;
+    size_t delimiter_len = 0;
+    if (bcpl_string_class(delimiter_payload) != BCPL_STRING_CLASS_UTF32) {
+        delimiter_payload = (uint32_t*)bcpl_string_wide_view(delimiter_payload, &delimiter_len, &delimiter_temp);
+        if (!delimiter_payload) return result_list;
+    }
 
-    // Edge case: empty delimiter splits into single characters
+    size_t source_len = bcpl_string_length(source_payload);
+    delimiter_len = bcpl_string_length(delimiter_payload);
+
+    // Token bounds first, so every token can be copied into one allocation
+    size_t* bounds = NULL;
+    size_t count = 0;
     if (delimiter_len == 0) {
-        for (const uint32_t* p = source_payload; *p != 0; ++p) {
-            uint32_t* char_payload = (uint32_t*)bcpl_alloc_chars(1);
-            if (char_payload) {
-                char_payload[0] = *p;
-                char_payload[1] = 0;
-                void* base_ptr = (uint64_t*)char_payload - 1;
-                BCPL_LIST_APPEND_STRING(result_list, (uint32_t*)base_ptr);
-            }
+        // Edge case: empty delimiter splits into single characters
+        bounds = (size_t*)malloc(2 * source_len * sizeof(size_t) + 1);
+        for (size_t i = 0; bounds && i < source_len; ++i) {
+            bounds[2 * count] = i;
+            bounds[2 * count + 1] = i + 1;
+            count++;
         }
-        return result_list;
-    }
-
-    const uint32_t* start = source_payload;
-    const uint32_t* end = source_payload;
-
-    while (*end != 0) {
-        if (bcpl_strncmp(end, delimiter_payload, delimiter_len)) {
-            size_t token_len = end - start;
-            uint32_t* token_payload = (uint32_t*)bcpl_alloc_chars(token_len);
-            if (token_payload) {
-                memcpy(token_payload, start, token_len * sizeof(uint32_t));
-                void* base_ptr = (uint64_t*)token_payload - 1;
-                BCPL_LIST_APPEND_STRING(result_list, (uint32_t*)base_ptr);
+    } else {
+        // One token per delimiter found, then the remainder
+        size_t capacity = 0;
+        size_t start = 0;
+        for (;;) {
+            size_t found = bcpl_string_find(source_payload, source_len, delimiter_payload, delimiter_len, start);
+            if (count == capacity) {
+                capacity = capacity ? 2 * capacity : 16;
+                size_t* grown = (size_t*)realloc(bounds, 2 * capacity * sizeof(size_t));
+                if (!grown) break;
+                bounds = grown;
             }
-            start = end + delimiter_len;
-            end = start;
-        } else {
-            end++;
+            bounds[2 * count] = start;
+            bounds[2 * count + 1] = found == BCPL_STRING_NOT_FOUND ? source_len : found;
+            count++;
+            if (found == BCPL_STRING_NOT_FOUND) break;
+            start = found + delimiter_len;
         }
     }
+    if (bounds) bcpl_list_append_tokens(result_list, source_payload, bounds, count);
 
-    size_t last_token_len = end - start;
-    uint32_t* last_token_payload = (uint32_t*)bcpl_alloc_chars(last_token_len);
-    if (last_token_payload) {
-        memcpy(last_token_payload, start, last_token_len * sizeof(uint32_t));
-        void* base_ptr = (uint64_t*)last_token_payload - 1;
-        BCPL_LIST_APPEND_STRING(result_list, (uint32_t*)base_ptr);
-    }
-
+    free(bounds);
+    free(delimiter_temp);
     return result_list;
-}
\ No newline at end of file
+}
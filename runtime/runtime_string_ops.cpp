@@ -7,127 +7,211 @@
 #include "runtime.h"
 #include "ListDataTypes.h"
 #include "heap_interface.h"
+#include "string_kernels.h"
+#include "string_class.h"
+#include <cstdlib>
 #include <cstring>
 #include <cstdint>
 
 /**
- * @brief Calculate the length of a BCPL string payload (number of codepoints).
+ * @brief Narrow a string to Latin-1 bytes in a malloc'd buffer.
+ * Returns nullptr if it has a wider character (or allocation fails).
  */
-static size_t bcpl_strlen(const uint32_t* s) {
-    size_t len = 0;
-    while (s && s[len] != 0) ++len;
-    return len;
+static uint8_t* narrow_to_bytes(const uint32_t* s, size_t* len) {
+    uint32_t* temp;
+    const uint32_t* wide = bcpl_string_wide_view(s, len, &temp);
+    uint8_t* bytes = static_cast<uint8_t*>(std::malloc(*len + 1));
+    if (bytes && ((s && !wide) || bcpl_latin1_narrow(wide, *len, bytes) != *len)) {
+        std::free(bytes);
+        bytes = nullptr;
+    }
+    std::free(temp);
+    return bytes;
 }
 
 /**
- * @brief Compare two codepoint arrays for delimiter matching.
+ * @brief Split a compact string into compact tokens. A delimiter with a
+ * character outside Latin-1 cannot occur in it, so the string is one token.
  */
-static bool bcpl_codepoint_match(const uint32_t* s, const uint32_t* delimiter, size_t delimiter_len) {
-    for (size_t i = 0; i < delimiter_len; ++i) {
-        if (s[i] != delimiter[i]) return false;
-        if (s[i] == 0) return false;
+static void split_compact_string(ListHeader* result_list, const uint32_t* source_payload,
+                                 const uint32_t* delimiter_payload) {
+    const uint8_t* source = bcpl_string_bytes(source_payload);
+    size_t source_len = bcpl_compact_length(source_payload);
+    size_t delimiter_len = 0;
+    uint8_t* delimiter = narrow_to_bytes(delimiter_payload, &delimiter_len);
+    bool per_character = delimiter && delimiter_len == 0;
+
+    size_t start = 0;
+    for (;;) {
+        size_t found = BCPL_STRING_NOT_FOUND;
+        size_t end;
+        if (per_character) {
+            // Empty delimiter splits into single characters
+            if (start >= source_len) break;
+            end = start + 1;
+        } else {
+            if (delimiter) found = bcpl_compact_find(source, source_len, delimiter, delimiter_len, start);
+            end = found == BCPL_STRING_NOT_FOUND ? source_len : found;
+        }
+        uint32_t* token_payload = bcpl_alloc_compact_chars(end - start);
+        std::memcpy(token_payload, source + start, end - start);
+        void* base_ptr = (uint64_t*)token_payload - 1;
+        BCPL_LIST_APPEND_STRING(result_list, (uint32_t*)base_ptr);
+
+        if (per_character) {
+            start = end;
+            continue;
+        }
+        if (found == BCPL_STRING_NOT_FOUND) break;
+        start = found + delimiter_len;
     }
-    return true;
+    std::free(delimiter);
 }
 
 /**
  * @brief Split a BCPL string by a delimiter into a list of new BCPL strings.
- * This implementation is fully Unicode-safe.
+ * This implementation is fully Unicode-safe. UTF-32 tokens share one
+ * allocation owned by the list (see bcpl_list_append_tokens).
  */
 extern "C" ListHeader* BCPL_SPLIT_STRING(uint32_t* source_payload, uint32_t* delimiter_payload) {
     ListHeader* result_list = BCPL_LIST_CREATE_EMPTY();
     if (!source_payload || !delimiter_payload) return result_list;
 
-    size_t delimiter_len = bcpl_strlen(delimiter_payload);
-
-    // Edge case: empty delimiter splits into single codepoints
-    if (delimiter_len == 0) {
-        for (const uint32_t* p = source_payload; *p != 0; ++p) {
-            uint32_t* char_payload = (uint32_t*)bcpl_alloc_chars(1);
-            char_payload[0] = *p;
-            char_payload[1] = 0;
-            void* base_ptr = (uint64_t*)char_payload - 1;
-            BCPL_LIST_APPEND_STRING(result_list, (uint32_t*)base_ptr);
-        }
-        return result_list;
+    switch (bcpl_string_class(source_payload)) {
+        case BCPL_STRING_CLASS_COMPACT:
+            split_compact_string(result_list, source_payload, delimiter_payload);
+            return result_list;
+        case BCPL_STRING_CLASS_PROMOTED:
+            source_payload = bcpl_string_forward(source_payload);
+            break;
+        default:
+            break;
+    }
+    uint32_t* delimiter_temp = nullptr;
+    size_t delimiter_len = 0;
+    if (bcpl_string_class(delimiter_payload) != BCPL_STRING_CLASS_UTF32) {
+        delimiter_payload = const_cast<uint32_t*>(bcpl_string_wide_view(delimiter_payload, &delimiter_len, &delimiter_temp));
+        if (!delimiter_payload) return result_list;
     }
 
-    const uint32_t* start = source_payload;
-    const uint32_t* end = source_payload;
+    size_t source_len = bcpl_string_length(source_payload);
+    delimiter_len = bcpl_string_length(delimiter_payload);
 
-    while (*end != 0) {
-        if (bcpl_codepoint_match(end, delimiter_payload, delimiter_len)) {
-            size_t token_len = end - start;
-            uint32_t* token_payload = (uint32_t*)bcpl_alloc_chars(token_len);
-            if (token_len > 0) {
-                memcpy(token_payload, start, token_len * sizeof(uint32_t));
+    // Token bounds first, so every token can be copied into one allocation
+    size_t* bounds = nullptr;
+    size_t count = 0;
+    if (delimiter_len == 0) {
+        // Edge case: empty delimiter splits into single codepoints
+        bounds = static_cast<size_t*>(std::malloc(2 * source_len * sizeof(size_t) + 1));
+        for (size_t i = 0; bounds && i < source_len; ++i) {
+            bounds[2 * count] = i;
+            bounds[2 * count + 1] = i + 1;
+            ++count;
+        }
+    } else {
+        // One token per delimiter found, then the remainder
+        size_t capacity = 0;
+        size_t start = 0;
+        for (;;) {
+            size_t found = bcpl_string_find(source_payload, source_len, delimiter_payload, delimiter_len, start);
+            if (count == capacity) {
+                capacity = capacity ? 2 * capacity : 16;
+                size_t* grown = static_cast<size_t*>(std::realloc(bounds, 2 * capacity * sizeof(size_t)));
+                if (!grown) break;
+                bounds = grown;
             }
-            token_payload[token_len] = 0;
-            void* base_ptr = (uint64_t*)token_payload - 1;
-            BCPL_LIST_APPEND_STRING(result_list, (uint32_t*)base_ptr);
-
-            start = end + delimiter_len;
-            end = start;
-        } else {
-            ++end;
+            bounds[2 * count] = start;
+            bounds[2 * count + 1] = found == BCPL_STRING_NOT_FOUND ? source_len : found;
+            ++count;
+            if (found == BCPL_STRING_NOT_FOUND) break;
+            start = found + delimiter_len;
         }
     }
+    if (bounds) bcpl_list_append_tokens(result_list, source_payload, bounds, count);
 
-    // Add final token
-    size_t last_token_len = end - start;
-    uint32_t* last_token_payload = (uint32_t*)bcpl_alloc_chars(last_token_len);
-    if (last_token_len > 0) {
-        memcpy(last_token_payload, start, last_token_len * sizeof(uint32_t));
-    }
-    last_token_payload[last_token_len] = 0;
-    void* base_ptr = (uint64_t*)last_token_payload - 1;
-    BCPL_LIST_APPEND_STRING(result_list, (uint32_t*)base_ptr);
-
+    std::free(bounds);
+    std::free(delimiter_temp);
     return result_list;
 }
 
 /**
  * @brief Join a list of BCPL strings into a single string using a delimiter.
- * This implementation is fully Unicode-safe.
+ * This implementation is fully Unicode-safe. The result is compact when
+ * compact strings are enabled, every element is compact and the delimiter
+ * is Latin-1.
  */
 extern "C" uint32_t* BCPL_JOIN_LIST(ListHeader* list_header, uint32_t* delimiter_payload) {
     if (!list_header || !list_header->head) return (uint32_t*)bcpl_alloc_chars(0);
 
-    size_t delimiter_len = bcpl_strlen(delimiter_payload);
+    size_t delimiter_len = 0;
+    uint32_t* delimiter_temp = nullptr;
+    const uint32_t* delimiter = bcpl_string_wide_view(delimiter_payload, &delimiter_len, &delimiter_temp);
+
+    // Element lengths, by class; exact prefixes are read, not scanned.
+    auto element_length = [](uint64_t* base_ptr) -> size_t {
+        return bcpl_string_any_length((uint32_t*)(base_ptr + 1));
+    };
 
     // Pass 1: Calculate total length
     size_t total_len = 0, element_count = 0;
+    bool all_compact = bcpl_compact_strings_enabled != 0;
     ListAtom* current = list_header->head;
     while (current) {
         if (current->type == ATOM_STRING && current->value.ptr_value) {
             uint64_t* base_ptr = (uint64_t*)current->value.ptr_value;
-            total_len += base_ptr[0];
+            total_len += element_length(base_ptr);
+            all_compact = all_compact && bcpl_string_class(base_ptr + 1) == BCPL_STRING_CLASS_COMPACT;
             ++element_count;
         }
         current = current->next;
     }
     if (element_count > 1) total_len += delimiter_len * (element_count - 1);
 
+    uint8_t* delimiter_bytes = all_compact && element_count > 0 ? narrow_to_bytes(delimiter, &delimiter_len) : nullptr;
+
     // Pass 2: Allocate and build result
-    uint32_t* result_payload = (uint32_t*)bcpl_alloc_chars(total_len);
+    uint32_t* result_payload = delimiter_bytes ? bcpl_alloc_compact_chars(total_len)
+                                               : (uint32_t*)bcpl_alloc_chars(total_len);
     uint32_t* cursor = result_payload;
+    uint8_t* byte_cursor = (uint8_t*)result_payload;
     current = list_header->head;
     size_t i = 0;
     while (current) {
         if (current->type == ATOM_STRING && current->value.ptr_value) {
             uint64_t* base_ptr = (uint64_t*)current->value.ptr_value;
-            size_t element_len = base_ptr[0];
+            size_t element_len = element_length(base_ptr);
             uint32_t* element_payload = (uint32_t*)(base_ptr + 1);
-            memcpy(cursor, element_payload, element_len * sizeof(uint32_t));
-            cursor += element_len;
-            if (i < element_count - 1 && delimiter_len > 0) {
-                memcpy(cursor, delimiter_payload, delimiter_len * sizeof(uint32_t));
-                cursor += delimiter_len;
+            bool last = i == element_count - 1;
+            if (delimiter_bytes) {
+                std::memcpy(byte_cursor, bcpl_string_bytes(element_payload), element_len);
+                byte_cursor += element_len;
+                if (!last && delimiter_len > 0) {
+                    std::memcpy(byte_cursor, delimiter_bytes, delimiter_len);
+                    byte_cursor += delimiter_len;
+                }
+            } else {
+                int element_class = bcpl_string_class(element_payload);
+                if (element_class == BCPL_STRING_CLASS_COMPACT) {
+                    bcpl_latin1_widen(bcpl_string_bytes(element_payload), element_len, cursor);
+                } else {
+                    if (element_class == BCPL_STRING_CLASS_PROMOTED) element_payload = bcpl_string_forward(element_payload);
+                    std::memcpy(cursor, element_payload, element_len * sizeof(uint32_t));
+                }
+                cursor += element_len;
+                if (!last && delimiter_len > 0) {
+                    std::memcpy(cursor, delimiter, delimiter_len * sizeof(uint32_t));
+                    cursor += delimiter_len;
+                }
             }
             ++i;
         }
         current = current->next;
     }
-    result_payload[total_len] = 0;
+    if (!delimiter_bytes) {
+        result_payload[total_len] = 0;
+        bcpl_string_set_exact_length(result_payload, total_len);
+    }
+    std::free(delimiter_bytes);
+    std::free(delimiter_temp);
     return result_payload;
-}
\ No newline at end of file
+}
@@ -47,6 +47,11 @@ void* BCPL_ALLOC_CHARS(int64_t num_chars) {
     return (void*)payload;
 }
 
+// Scope-local string allocation; without SAMM scopes this is BCPL_ALLOC_CHARS.
+void* BCPL_ALLOC_CHARS_SCOPED(int64_t num_chars) {
+    return BCPL_ALLOC_CHARS(num_chars);
+}
+
 // Frees memory allocated by BCPL_ALLOC_WORDS or BCPL_ALLOC_CHARS.
 void FREEVEC(void* ptr) {
     if (!ptr) return;
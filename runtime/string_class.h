@@ -0,0 +1,301 @@
+/*
+ * string_class.h
+ * Storage classes for BCPL strings
+ *
+ * The uint64 before a string's payload holds its length in the low 62 bits.
+ * The top two bits select how the characters are stored:
+ *
+ *   00  UTF-32     one uint32_t code point per character. Everything the
+ *                  compiler allocates, and every string literal.
+ *   10  compact    one byte per character (Latin-1, U+0000..U+00FF) and a
+ *                  0 byte. The runtime hands these out for text it reads or
+ *                  builds when compact strings are enabled (--compact-strings).
+ *   01  promoted   a compact string that had a wider code point stored into
+ *                  it. Its characters now live in a UTF-32 copy, and the
+ *                  first 8 payload bytes point to that copy's payload.
+ *
+ * A string cannot move, because BCPL code holds its address, so promotion
+ * leaves the compact block in place as a forwarding header. The copy is
+ * malloc'd, owned by the compact block, and released with it
+ * (bcpl_string_release_promoted, called by the heap's free paths). Its
+ * block starts with one word before the length prefix: 0 for a promoted
+ * string, BCPL_FORWARD_BUILDER and the capacity for a string builder (see
+ * runtime_string_utils.inc), which is the only way to tell the two apart.
+ *
+ * The length bits are the same in every class, so LEN only has to mask.
+ * A UTF-32 prefix never has either top bit set (bit 61, which marks an
+ * exact length, is below them; see string_kernels.h), and neither has a
+ * vector's length, so reading the class of a pointer that is not a string
+ * is safe.
+ *
+ * Shared by runtime.c (C), the JIT runtime (C++) and HeapManager, so
+ * everything here is C99 and static inline.
+ */
+
+#ifndef BCPL_STRING_CLASS_H
+#define BCPL_STRING_CLASS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "string_kernels.h"
+
+#if !defined(BCPL_STRING_KERNELS_PORTABLE) && defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BCPL_STRING_CLASS_NEON 1
+#elif !defined(BCPL_STRING_KERNELS_PORTABLE) && defined(__SSE2__)
+#include <emmintrin.h>
+#define BCPL_STRING_CLASS_SSE2 1
+#endif
+
+#define BCPL_STRING_COMPACT     ((uint64_t)1 << 63)
+#define BCPL_STRING_PROMOTED    ((uint64_t)1 << 62)
+#define BCPL_STRING_CLASS_MASK  (BCPL_STRING_COMPACT | BCPL_STRING_PROMOTED)
+#define BCPL_STRING_LENGTH_MASK (~(BCPL_STRING_CLASS_MASK | BCPL_STRING_EXACT_LENGTH))
+
+/* Storage class values, as returned by bcpl_string_class(). */
+#define BCPL_STRING_CLASS_UTF32    0
+#define BCPL_STRING_CLASS_COMPACT  2
+#define BCPL_STRING_CLASS_PROMOTED 1
+
+/* A compact payload is never shorter than this, so promotion has room for its pointer. */
+#define BCPL_COMPACT_MIN_PAYLOAD 8
+
+/*
+ * Storage class of a string. NULL and pointers that are not 8-byte aligned
+ * (so cannot be the start of an allocated payload) are UTF-32 character
+ * buffers. Unlike bcpl_string_prefix_bound, a payload at a page boundary
+ * is not special: compiled code reads the prefix of every string it indexes,
+ * and the two must agree on the class.
+ */
+static inline int bcpl_string_class(const void* s) {
+    if (!s || ((uintptr_t)s & 7) != 0) return BCPL_STRING_CLASS_UTF32;
+    return (int)(((const uint64_t*)s)[-1] >> 62);
+}
+
+/* The prefix without its class and exact-length bits: LEN. */
+static inline size_t bcpl_string_tagged_length(const void* s) {
+    return (size_t)(((const uint64_t*)s)[-1] & BCPL_STRING_LENGTH_MASK);
+}
+
+static inline const uint8_t* bcpl_string_bytes(const void* s) {
+    return (const uint8_t*)s;
+}
+
+/* The UTF-32 copy a promoted string forwards to. */
+static inline uint32_t* bcpl_string_forward(const void* s) {
+    uint32_t* forward;
+    memcpy(&forward, s, sizeof(forward));
+    return forward;
+}
+
+/* Set in the first word of a string builder's forward block. */
+#define BCPL_FORWARD_BUILDER ((uint64_t)1 << 63)
+
+/* The malloc'd block of a forward copy: header word, length prefix, payload. */
+static inline uint64_t* bcpl_forward_block(const uint32_t* forward) {
+    return (uint64_t*)forward - 2;
+}
+
+/* Bytes of payload to allocate for a compact string of `len` characters. */
+static inline size_t bcpl_compact_payload_bytes(size_t len) {
+    return len + 1 < BCPL_COMPACT_MIN_PAYLOAD ? BCPL_COMPACT_MIN_PAYLOAD : len + 1;
+}
+
+/*
+ * Frees the UTF-32 copy of a promoted string. `base` is the block address
+ * (the length prefix); blocks of any other class are left alone.
+ */
+static inline void bcpl_string_release_promoted(void* base) {
+    uint64_t prefix = *(const uint64_t*)base;
+    if ((prefix & BCPL_STRING_CLASS_MASK) == BCPL_STRING_PROMOTED) {
+        uint32_t* forward = bcpl_string_forward((const uint64_t*)base + 1);
+        if (forward) free(bcpl_forward_block(forward));
+        *(uint64_t*)base = prefix & BCPL_STRING_LENGTH_MASK;
+    }
+}
+
+/* Widens `n` Latin-1 bytes to code points. */
+static inline void bcpl_latin1_widen(const uint8_t* src, size_t n, uint32_t* dst) {
+    size_t i = 0;
+#if defined(BCPL_STRING_CLASS_NEON)
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t bytes = vld1q_u8(src + i);
+        uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+        uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+        vst1q_u32(dst + i, vmovl_u16(vget_low_u16(lo)));
+        vst1q_u32(dst + i + 4, vmovl_u16(vget_high_u16(lo)));
+        vst1q_u32(dst + i + 8, vmovl_u16(vget_low_u16(hi)));
+        vst1q_u32(dst + i + 12, vmovl_u16(vget_high_u16(hi)));
+    }
+#elif defined(BCPL_STRING_CLASS_SSE2)
+    __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+    }
+#endif
+    for (; i < n; i++) dst[i] = src[i];
+}
+
+/*
+ * Narrows code points to Latin-1 bytes, stopping at the first one above
+ * U+00FF. Returns the number narrowed (n if they all fit).
+ */
+static inline size_t bcpl_latin1_narrow(const uint32_t* src, size_t n, uint8_t* dst) {
+    size_t i = 0;
+#if defined(BCPL_STRING_CLASS_NEON)
+    for (; i + 8 <= n; i += 8) {
+        uint32x4_t lo = vld1q_u32(src + i);
+        uint32x4_t hi = vld1q_u32(src + i + 4);
+        if (vmaxvq_u32(vorrq_u32(lo, hi)) > 0xFF) break;
+        vst1_u8(dst + i, vmovn_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi))));
+    }
+#elif defined(BCPL_STRING_CLASS_SSE2)
+    for (; i + 8 <= n; i += 8) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(src + i + 4));
+        __m128i wide = _mm_and_si128(_mm_or_si128(lo, hi), _mm_set1_epi32(~0xFF));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(wide, _mm_setzero_si128())) != 0xFFFF) break;
+        __m128i narrow = _mm_packs_epi32(lo, hi);
+        _mm_storel_epi64((__m128i*)(dst + i), _mm_packus_epi16(narrow, narrow));
+    }
+#endif
+    for (; i < n && src[i] <= 0xFF; i++) dst[i] = (uint8_t)src[i];
+    return i;
+}
+
+/* Number of leading bytes below 0x80. */
+static inline size_t bcpl_latin1_ascii_prefix(const uint8_t* src, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t word;
+        memcpy(&word, src + i, 8);
+        if (word & 0x8080808080808080ull) break;
+    }
+    while (i < n && src[i] < 0x80) i++;
+    return i;
+}
+
+/*
+ * Encodes `n` Latin-1 bytes as UTF-8 into dst, which needs room for 2 * n
+ * bytes. ASCII runs are copied as they are. Returns the bytes written.
+ */
+static inline size_t bcpl_latin1_to_utf8(const uint8_t* src, size_t n, unsigned char* dst) {
+    size_t i = 0, out = 0;
+    while (i < n) {
+        size_t run = bcpl_latin1_ascii_prefix(src + i, n - i);
+        memcpy(dst + out, src + i, run);
+        i += run;
+        out += run;
+        for (; i < n && src[i] >= 0x80; i++) {
+            dst[out++] = (unsigned char)(0xC0 | (src[i] >> 6));
+            dst[out++] = (unsigned char)(0x80 | (src[i] & 0x3F));
+        }
+    }
+    return out;
+}
+
+/*
+ * Characters in a compact string: up to the terminator. STRCOPY leaves the
+ * prefix alone (as it does for UTF-32 strings), so the prefix is only a
+ * bound for memchr; a terminator past it is found with strlen.
+ */
+static inline size_t bcpl_compact_length(const void* s) {
+    const uint8_t* bytes = bcpl_string_bytes(s);
+    size_t bound = bcpl_string_tagged_length(s);
+    const uint8_t* end = (const uint8_t*)memchr(bytes, 0, bound);
+    if (end) return (size_t)(end - bytes);
+    return bound + strlen((const char*)bytes + bound);
+}
+
+/* Length of a string of any class. */
+static inline size_t bcpl_string_any_length(const uint32_t* s) {
+    switch (bcpl_string_class(s)) {
+        case BCPL_STRING_CLASS_COMPACT: return bcpl_compact_length(s);
+        case BCPL_STRING_CLASS_PROMOTED: return bcpl_string_length(bcpl_string_forward(s));
+        default: return bcpl_string_length(s);
+    }
+}
+
+/*
+ * STRCMP for two compact strings, and for a compact string against a UTF-32
+ * one: like bcpl_string_compare_terminated, it stops at the first difference
+ * or the shared terminator and never measures either string.
+ */
+static inline int64_t bcpl_compact_compare_terminated(const uint8_t* a, const uint8_t* b) {
+    size_t i = 0;
+    while (a[i] == b[i] && a[i] != 0) i++;
+    return (int64_t)a[i] - (int64_t)b[i];
+}
+
+static inline int64_t bcpl_compact_wide_compare_terminated(const uint8_t* a, const uint32_t* b) {
+    size_t i = 0;
+    while ((uint32_t)a[i] == b[i] && a[i] != 0) i++;
+    return (int64_t)a[i] - (int64_t)b[i];
+}
+
+/* bcpl_string_find for compact strings: memchr finds the candidates. */
+static inline size_t bcpl_compact_find(const uint8_t* haystack, size_t haystack_len,
+                                       const uint8_t* needle, size_t needle_len, size_t from) {
+    size_t last;
+    if (needle_len == 0) return from <= haystack_len ? from : BCPL_STRING_NOT_FOUND;
+    if (needle_len > haystack_len || from > haystack_len - needle_len) return BCPL_STRING_NOT_FOUND;
+    last = haystack_len - needle_len;
+    while (from <= last) {
+        const uint8_t* hit = (const uint8_t*)memchr(haystack + from, needle[0], last - from + 1);
+        if (!hit) break;
+        from = (size_t)(hit - haystack);
+        if (memcmp(hit + 1, needle + 1, needle_len - 1) == 0) return from;
+        from++;
+    }
+    return BCPL_STRING_NOT_FOUND;
+}
+
+/*
+ * A UTF-32 view of a string of any class, for code that walks code points.
+ * A compact string is widened into a malloc'd copy that *temp receives, for
+ * the caller to free; *temp is NULL otherwise. Returns NULL, with *len 0,
+ * for a NULL string or if that allocation fails.
+ */
+static inline const uint32_t* bcpl_string_wide_view(const uint32_t* s, size_t* len, uint32_t** temp) {
+    *temp = NULL;
+    *len = 0;
+    if (!s) return NULL;
+    switch (bcpl_string_class(s)) {
+        case BCPL_STRING_CLASS_COMPACT: {
+            size_t n = bcpl_compact_length(s);
+            uint32_t* wide = (uint32_t*)malloc((n + 1) * sizeof(uint32_t));
+            if (!wide) return NULL;
+            bcpl_latin1_widen(bcpl_string_bytes(s), n, wide);
+            wide[n] = 0;
+            *temp = wide;
+            *len = n;
+            return wide;
+        }
+        case BCPL_STRING_CLASS_PROMOTED:
+            s = bcpl_string_forward(s);
+            break;
+        default:
+            break;
+    }
+    *len = bcpl_string_length(s);
+    return s;
+}
+
+/* Character `i` of a string of any class. */
+static inline uint32_t bcpl_string_char_at(const uint32_t* s, size_t i) {
+    switch (bcpl_string_class(s)) {
+        case BCPL_STRING_CLASS_COMPACT: return bcpl_string_bytes(s)[i];
+        case BCPL_STRING_CLASS_PROMOTED: return bcpl_string_forward(s)[i];
+        default: return s[i];
+    }
+}
+
+#endif /* BCPL_STRING_CLASS_H */
@@ -0,0 +1,320 @@
+/*
+ * string_kernels.h
+ * Length-aware kernels for BCPL strings (UTF-32 code point arrays)
+ *
+ * A string ends at its terminator. Every string the runtime hands out also
+ * has its allocated length in the uint64 that precedes the payload
+ * (HeapManager::allocString, the embedded string pool and string literals
+ * in .rodata all use that layout), but the payload is not cleared when it is
+ * allocated, so a shorter string stored into it ends earlier. The prefix is
+ * only the length when bit 61 (BCPL_STRING_EXACT_LENGTH) says so:
+ *
+ *   - it is set on strings whose every character was written by whoever set
+ *     it, with none of them 0: string literals (DataGenerator), SPLIT tokens
+ *     and JOIN results, and copies of those;
+ *   - it is cleared by anything that can move the terminator below the
+ *     prefix: STRCOPY into the string, and compiled stores of 0 through S%i
+ *     (NewCodeGenerator::generate_exact_length_clear). A store of any other
+ *     code point below LEN leaves the length alone; one at or past LEN is
+ *     outside the string.
+ *
+ * bcpl_string_length() returns such a length without reading the payload,
+ * and scans for the terminator otherwise, with the prefix bounding the
+ * vectorized part of the scan. LEN and the bounds checks mask the bit off,
+ * as they do the storage class bits of string_class.h.
+ *
+ * The compare, find and copy kernels take explicit lengths, except
+ * bcpl_string_compare_terminated, which stops at the first difference and
+ * needs none. All use NEON on AArch64, SSE2 on x86-64 and plain C
+ * elsewhere. Define
+ * BCPL_STRING_KERNELS_PORTABLE to force the plain C versions.
+ *
+ * Shared by runtime.c (C) and the JIT runtime (C++), so everything here is
+ * C99 and static inline.
+ */
+
+#ifndef BCPL_STRING_KERNELS_H
+#define BCPL_STRING_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if !defined(BCPL_STRING_KERNELS_PORTABLE) && defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BCPL_STRING_KERNELS_NEON 1
+#elif !defined(BCPL_STRING_KERNELS_PORTABLE) && defined(__SSE2__)
+#include <emmintrin.h>
+#define BCPL_STRING_KERNELS_SSE2 1
+#endif
+
+#define BCPL_STRING_NOT_FOUND ((size_t)-1)
+
+/* The terminator scan reads whole aligned vectors, which may extend past the
+ * end of the allocation (never past the page). AddressSanitizer would report
+ * that, as it would for an uninstrumented libc strlen. */
+#if defined(__GNUC__) || defined(__clang__)
+#define BCPL_STRING_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define BCPL_STRING_NO_ASAN
+#endif
+
+/*
+ * Counts code points up to the terminator, or up to `limit` if no
+ * terminator comes first. Vector loads are aligned, so they never cross into
+ * an unmapped page past the terminator, and the scan reads nothing that a
+ * scalar loop stopping at the terminator would not reach.
+ */
+BCPL_STRING_NO_ASAN static inline size_t bcpl_string_scan_bounded(const uint32_t* s, size_t limit) {
+    size_t i = 0;
+    if (!s) return 0;
+#if defined(BCPL_STRING_KERNELS_NEON) || defined(BCPL_STRING_KERNELS_SSE2)
+    if (((uintptr_t)s & 3) == 0) {
+        while (i < limit && ((uintptr_t)(s + i) & 31) != 0) {
+            if (s[i] == 0) return i;
+            i++;
+        }
+        for (; i + 8 <= limit; i += 8) {
+#if defined(BCPL_STRING_KERNELS_NEON)
+            uint32x4_t zero_lo = vceqzq_u32(vld1q_u32(s + i));
+            uint32x4_t zero_hi = vceqzq_u32(vld1q_u32(s + i + 4));
+            if (vmaxvq_u32(vorrq_u32(zero_lo, zero_hi)) != 0) break;
+#else
+            __m128i zero = _mm_setzero_si128();
+            __m128i lo = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)(s + i)), zero);
+            __m128i hi = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)(s + i + 4)), zero);
+            if (_mm_movemask_epi8(_mm_or_si128(lo, hi)) != 0) break;
+#endif
+        }
+    }
+#endif
+    while (i < limit && s[i] != 0) i++;
+    return i;
+}
+
+/* Counts code points up to the terminator by scanning. */
+static inline size_t bcpl_string_scan_length(const uint32_t* s) {
+    return bcpl_string_scan_bounded(s, SIZE_MAX);
+}
+
+#define BCPL_STRING_EXACT_LENGTH ((uint64_t)1 << 61)
+
+/* Prefixes of exact lengths: bit 61 over a length below 2^31. */
+#define BCPL_STRING_EXACT_PREFIX(prefix) (((prefix) >> 31) == (BCPL_STRING_EXACT_LENGTH >> 31))
+
+/*
+ * Reads the prefix of a BCPL string if the pointer is where a payload can
+ * start: 8-byte aligned and not at a page boundary, so the prefix is
+ * readable. Returns 0 if it is not.
+ */
+static inline int bcpl_string_read_prefix(const uint32_t* s, uint64_t* prefix) {
+    if (!s || ((uintptr_t)s & 7) != 0 || ((uintptr_t)s & 0xFFF) == 0) return 0;
+    *prefix = ((const uint64_t*)s)[-1];
+    return 1;
+}
+
+/*
+ * Reads the length prefix of a BCPL string as an upper bound on its length,
+ * if there is one and it is in range. Returns 0 if it cannot. Like LEN, this
+ * is the allocated length: unless it is exact, the string itself ends at its
+ * terminator, which may come earlier.
+ */
+static inline int bcpl_string_prefix_bound(const uint32_t* s, size_t* bound) {
+    uint64_t prefix;
+    if (!bcpl_string_read_prefix(s, &prefix)) return 0;
+    if (BCPL_STRING_EXACT_PREFIX(prefix)) prefix &= ~BCPL_STRING_EXACT_LENGTH;
+    if (prefix >= 0x80000000u) return 0;
+    *bound = (size_t)prefix;
+    return 1;
+}
+
+/* The length in the prefix of `s`, if the prefix is marked exact. */
+static inline int bcpl_string_exact_length(const uint32_t* s, size_t* len) {
+    uint64_t prefix;
+    if (!bcpl_string_read_prefix(s, &prefix) || !BCPL_STRING_EXACT_PREFIX(prefix)) return 0;
+    *len = (size_t)(prefix & ~BCPL_STRING_EXACT_LENGTH);
+    return 1;
+}
+
+/*
+ * Marks the length prefix of a freshly filled UTF-32 string exact: `len`
+ * code points, none of them 0, then the terminator. Lengths too long to be
+ * trusted keep a plain prefix.
+ */
+static inline void bcpl_string_set_exact_length(uint32_t* s, size_t len) {
+    ((uint64_t*)s)[-1] = len < 0x80000000u ? (BCPL_STRING_EXACT_LENGTH | (uint64_t)len) : (uint64_t)len;
+}
+
+/* Drops the exact mark from a string whose terminator may have moved. */
+static inline void bcpl_string_clear_exact_length(uint32_t* s) {
+    uint64_t prefix;
+    if (bcpl_string_read_prefix(s, &prefix) && BCPL_STRING_EXACT_PREFIX(prefix)) {
+        ((uint64_t*)s)[-1] = prefix & ~BCPL_STRING_EXACT_LENGTH;
+    }
+}
+
+/*
+ * Length of a BCPL string: the prefix when it is exact, otherwise a scan for
+ * the terminator, bounded by the prefix when there is one. A string whose
+ * prefix is wrong (a vector used as a character buffer, a pointer into the
+ * middle of a string) runs past the bound, and the scan carries on from
+ * there.
+ */
+static inline size_t bcpl_string_length(const uint32_t* s) {
+    size_t bound, len;
+    if (bcpl_string_exact_length(s, &len)) return len;
+    if (!bcpl_string_prefix_bound(s, &bound)) return bcpl_string_scan_length(s);
+    len = bcpl_string_scan_bounded(s, bound);
+    if (len < bound) return len;
+    return len + bcpl_string_scan_length(s + len);
+}
+
+/* Index of the first position below `count` where a and b differ, or `count`. */
+static inline size_t bcpl_string_mismatch(const uint32_t* a, const uint32_t* b, size_t count) {
+    size_t i = 0;
+#if defined(BCPL_STRING_KERNELS_NEON)
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t same = vceqq_u32(vld1q_u32(a + i), vld1q_u32(b + i));
+        if (vminvq_u32(same) == 0) break;
+    }
+#elif defined(BCPL_STRING_KERNELS_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128i same = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a + i)),
+                                       _mm_loadu_si128((const __m128i*)(b + i)));
+        if (_mm_movemask_epi8(same) != 0xFFFF) break;
+    }
+#endif
+    while (i < count && a[i] == b[i]) i++;
+    return i;
+}
+
+/*
+ * Three-way comparison with the result STRCMP has always returned: the
+ * difference of the first differing code points, where the shorter string
+ * contributes its terminator (0).
+ */
+static inline int64_t bcpl_string_compare(const uint32_t* a, size_t a_len, const uint32_t* b, size_t b_len) {
+    size_t common = a_len < b_len ? a_len : b_len;
+    size_t i = bcpl_string_mismatch(a, b, common);
+    uint32_t ca = i < a_len ? a[i] : 0;
+    uint32_t cb = i < b_len ? b[i] : 0;
+    return (int64_t)ca - (int64_t)cb;
+}
+
+/*
+ * STRCMP on two terminated strings without measuring either: stops at the
+ * first differing code point or the shared terminator, so a pair that
+ * differs early costs a few loads whatever their lengths. The first four
+ * code points are compared one at a time (most unequal strings differ
+ * there); after that, four at a time in runs that keep both 16-byte loads
+ * inside their pages. The first code point of a block is always one the
+ * scalar loop would read too, so a load that stays in its page never
+ * faults, even when it reads past the terminator.
+ */
+BCPL_STRING_NO_ASAN static inline int64_t bcpl_string_compare_terminated(const uint32_t* a, const uint32_t* b) {
+    size_t i = 0;
+    for (; i < 4; i++) {
+        if (a[i] != b[i] || a[i] == 0) return (int64_t)a[i] - (int64_t)b[i];
+    }
+#if defined(BCPL_STRING_KERNELS_NEON) || defined(BCPL_STRING_KERNELS_SSE2)
+    if ((((uintptr_t)a | (uintptr_t)b) & 3) == 0) {
+        for (;;) {
+            size_t room_a = (0x1000 - ((uintptr_t)(a + i) & 0xFFF)) / 16;
+            size_t room_b = (0x1000 - ((uintptr_t)(b + i) & 0xFFF)) / 16;
+            size_t blocks = room_a < room_b ? room_a : room_b;
+            if (blocks == 0) {
+                /* A load here would straddle a page: step one code point */
+                if (a[i] != b[i] || a[i] == 0) break;
+                i++;
+                continue;
+            }
+            for (; blocks > 0; blocks--, i += 4) {
+#if defined(BCPL_STRING_KERNELS_NEON)
+                uint32x4_t va = vld1q_u32(a + i);
+                uint32x4_t stop = vorrq_u32(vmvnq_u32(vceqq_u32(va, vld1q_u32(b + i))), vceqzq_u32(va));
+                if (vmaxvq_u32(stop) != 0) goto finish;
+#else
+                __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+                __m128i differ_or_end = _mm_or_si128(
+                    _mm_xor_si128(_mm_cmpeq_epi32(va, _mm_loadu_si128((const __m128i*)(b + i))), _mm_set1_epi32(-1)),
+                    _mm_cmpeq_epi32(va, _mm_setzero_si128()));
+                if (_mm_movemask_epi8(differ_or_end) != 0) goto finish;
+#endif
+            }
+        }
+    }
+finish:
+#endif
+    while (a[i] == b[i]) {
+        if (a[i] == 0) return 0;
+        i++;
+    }
+    return (int64_t)a[i] - (int64_t)b[i];
+}
+
+/*
+ * First occurrence of needle in haystack at or after `from`, or
+ * BCPL_STRING_NOT_FOUND. Candidates are found by comparing the needle's
+ * first code point against four haystack positions at a time.
+ */
+static inline size_t bcpl_string_find(const uint32_t* haystack, size_t haystack_len,
+                                      const uint32_t* needle, size_t needle_len, size_t from) {
+    size_t last, i;
+    if (needle_len == 0) return from <= haystack_len ? from : BCPL_STRING_NOT_FOUND;
+    if (needle_len > haystack_len || from > haystack_len - needle_len) return BCPL_STRING_NOT_FOUND;
+    last = haystack_len - needle_len; /* last candidate position */
+    i = from;
+#if defined(BCPL_STRING_KERNELS_NEON)
+    {
+        uint32x4_t first = vdupq_n_u32(needle[0]);
+        for (; i + 4 <= last + 1; i += 4) {
+            uint32x4_t hits = vceqq_u32(vld1q_u32(haystack + i), first);
+            if (vmaxvq_u32(hits) == 0) continue;
+            for (size_t k = i; k < i + 4; k++) {
+                if (haystack[k] == needle[0] &&
+                    bcpl_string_mismatch(haystack + k + 1, needle + 1, needle_len - 1) == needle_len - 1) {
+                    return k;
+                }
+            }
+        }
+    }
+#elif defined(BCPL_STRING_KERNELS_SSE2)
+    {
+        __m128i first = _mm_set1_epi32((int)needle[0]);
+        for (; i + 4 <= last + 1; i += 4) {
+            int mask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(haystack + i)), first));
+            if (mask == 0) continue;
+            for (size_t k = i; k < i + 4; k++) {
+                if (haystack[k] == needle[0] &&
+                    bcpl_string_mismatch(haystack + k + 1, needle + 1, needle_len - 1) == needle_len - 1) {
+                    return k;
+                }
+            }
+        }
+    }
+#endif
+    for (; i <= last; i++) {
+        if (haystack[i] == needle[0] &&
+            bcpl_string_mismatch(haystack + i + 1, needle + 1, needle_len - 1) == needle_len - 1) {
+            return i;
+        }
+    }
+    return BCPL_STRING_NOT_FOUND;
+}
+
+/*
+ * Copies `len` code points and the terminator. memmove is already
+ * vectorized by every libc the runtime targets, so the gain over the old
+ * loop is knowing the length up front; short words (JOIN, SPLIT tokens) are
+ * cheaper copied inline than through the call.
+ */
+static inline void bcpl_string_copy(uint32_t* dst, const uint32_t* src, size_t len) {
+    if (len <= 8 && (dst + len <= src || src + len <= dst)) {
+        for (size_t i = 0; i < len; i++) dst[i] = src[i];
+    } else {
+        memmove(dst, src, len * sizeof(uint32_t));
+    }
+    dst[len] = 0;
+}
+
+#endif /* BCPL_STRING_KERNELS_H */
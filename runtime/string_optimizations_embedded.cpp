@@ -16,6 +16,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <pthread.h>
+#include "string_class.h"
 
 // SAMM integration
 extern "C" {
@@ -94,8 +95,11 @@ static size_t get_size_class_index(size_t num_chars) {
     return FAST_STRING_SIZE_CLASSES; // Oversized
 }
 
+// Rounded to 8 bytes so every payload in a chunk is 8-byte aligned, as
+// bcpl_string_class() expects of a string with a storage class.
 static size_t calculate_entry_size(size_t string_capacity) {
-    return sizeof(FastStringEntry) + sizeof(uint64_t) + (string_capacity + 1) * sizeof(uint32_t);
+    size_t size = sizeof(FastStringEntry) + sizeof(uint64_t) + (string_capacity + 1) * sizeof(uint32_t);
+    return (size + 7) & ~(size_t)7;
 }
 
 static uint32_t* get_string_data_from_entry(FastStringEntry* entry) {
@@ -280,12 +284,16 @@ extern "C" void* embedded_fast_bcpl_alloc_chars(int64_t num_chars) {
         g_string_allocator.heap_fallbacks++;
         pthread_mutex_unlock(&g_string_allocator.mutex);
         
-        size_t total_size = sizeof(uint64_t) + (char_count + 1) * sizeof(uint32_t);
-        uint64_t* ptr = (uint64_t*)malloc(total_size);
-        if (!ptr) return NULL;
+        // Oversized strings carry an entry header too, so free can tell
+        // them from pooled ones by capacity: the length prefix may have been
+        // shortened since, or carry storage class bits.
+        FastStringEntry* entry = (FastStringEntry*)malloc(calculate_entry_size(char_count));
+        if (!entry) return NULL;
         
-        ptr[0] = char_count;
-        uint32_t* payload = (uint32_t*)(ptr + 1);
+        entry->next = NULL;
+        entry->capacity = char_count;
+        uint32_t* payload = get_string_data_from_entry(entry);
+        ((uint64_t*)payload)[-1] = char_count;
         payload[char_count] = 0;
         
         // Track large strings in SAMM scope too
@@ -404,23 +412,24 @@ extern "C" void embedded_fast_bcpl_free_chars(void* string_payload) {
     }
     
     uint32_t* string_data = (uint32_t*)string_payload;
-    uint64_t* length_ptr = ((uint64_t*)string_data) - 1;
-    size_t string_length = *length_ptr;
+    FastStringEntry* entry = get_entry_from_string_data(string_data);
+    
+    // A promoted compact string owns the UTF-32 copy it forwards to.
+    bcpl_string_release_promoted(((uint64_t*)string_data) - 1);
     
     pthread_mutex_lock(&g_string_allocator.mutex);
     
     // Check if this was a heap fallback allocation
-    size_t size_class_index = get_size_class_index(string_length);
+    size_t size_class_index = get_size_class_index(entry->capacity);
     if (size_class_index >= FAST_STRING_SIZE_CLASSES) {
         // Direct heap allocation - free directly
-        free(length_ptr);
+        free(entry);
         g_string_allocator.total_strings_freed++;
         pthread_mutex_unlock(&g_string_allocator.mutex);
         return;
     }
     
     // Return to appropriate size class pool
-    FastStringEntry* entry = get_entry_from_string_data(string_data);
     FastStringPool* pool = &g_string_allocator.size_pools[size_class_index];
     
     entry->next = pool->free_head;
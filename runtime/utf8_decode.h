@@ -0,0 +1,216 @@
+/*
+ * utf8_decode.h
+ * UTF-8 to UTF-32 decoding for file input
+ *
+ * bcpl_utf8_decode() validates and transcodes in a single pass, so callers
+ * no longer count code points first and decode second: a UTF-8 byte never
+ * produces more than one code point, so an output buffer with one slot per
+ * input byte is always large enough. Sixteen bytes are taken at a time while
+ * they are ASCII (NEON on AArch64, SSE2 on x86-64, plain C elsewhere, or with
+ * BCPL_STRING_KERNELS_PORTABLE defined).
+ *
+ * Malformed input decodes exactly as decode_utf8_char() does: each bad
+ * sequence becomes one U+FFFD.
+ *
+ * Shared by runtime.c (C) and the JIT runtime (C++), so everything here is
+ * C99 and static inline.
+ */
+
+#ifndef BCPL_UTF8_DECODE_H
+#define BCPL_UTF8_DECODE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(BCPL_STRING_KERNELS_PORTABLE) && defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BCPL_UTF8_DECODE_NEON 1
+#elif !defined(BCPL_STRING_KERNELS_PORTABLE) && defined(__SSE2__)
+#include <emmintrin.h>
+#define BCPL_UTF8_DECODE_SSE2 1
+#endif
+
+#define BCPL_UTF8_REPLACEMENT 0xFFFD
+
+/*
+ * Widens sixteen bytes to code points if they are all ASCII and returns 1;
+ * otherwise returns 0 and writes nothing.
+ */
+static inline int bcpl_utf8_decode_ascii16(const unsigned char* src, uint32_t* dst) {
+#if defined(BCPL_UTF8_DECODE_NEON)
+    uint8x16_t bytes = vld1q_u8(src);
+    if (vmaxvq_u8(bytes) >= 0x80) return 0;
+    uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+    uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+    vst1q_u32(dst, vmovl_u16(vget_low_u16(lo)));
+    vst1q_u32(dst + 4, vmovl_u16(vget_high_u16(lo)));
+    vst1q_u32(dst + 8, vmovl_u16(vget_low_u16(hi)));
+    vst1q_u32(dst + 12, vmovl_u16(vget_high_u16(hi)));
+    return 1;
+#elif defined(BCPL_UTF8_DECODE_SSE2)
+    __m128i bytes = _mm_loadu_si128((const __m128i*)src);
+    if (_mm_movemask_epi8(bytes) != 0) return 0;
+    __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+    __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+    _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128((__m128i*)(dst + 4), _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128((__m128i*)(dst + 8), _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128((__m128i*)(dst + 12), _mm_unpackhi_epi16(hi, zero));
+    return 1;
+#else
+    uint64_t a, b;
+    memcpy(&a, src, 8);
+    memcpy(&b, src + 8, 8);
+    if (((a | b) & 0x8080808080808080ull) != 0) return 0;
+    for (int i = 0; i < 16; i++) dst[i] = src[i];
+    return 1;
+#endif
+}
+
+/*
+ * Decodes `len` bytes of UTF-8 from src into dst, which must have room for
+ * `len` code points. Returns the number of code points written and sets
+ * *consumed to the number of bytes used.
+ *
+ * When `final` is 0 the input is one chunk of a longer stream: a sequence
+ * cut off by the end of the chunk is left unconsumed (at most three bytes)
+ * for the caller to carry into the next chunk. When `final` is 1 it becomes
+ * U+FFFD like any other truncated sequence.
+ */
+static inline size_t bcpl_utf8_decode(const unsigned char* src, size_t len, uint32_t* dst,
+                                      size_t* consumed, int final) {
+    size_t i = 0, out = 0;
+    while (i < len) {
+        if (i + 16 <= len && bcpl_utf8_decode_ascii16(src + i, dst + out)) {
+            i += 16;
+            out += 16;
+            continue;
+        }
+
+        uint32_t c = src[i];
+        if (c < 0x80) {
+            dst[out++] = c;
+            i++;
+            continue;
+        }
+
+        size_t extra;
+        uint32_t min_code;
+        if ((c & 0xE0) == 0xC0) {
+            extra = 1; min_code = 0x80; c &= 0x1F;
+        } else if ((c & 0xF0) == 0xE0) {
+            extra = 2; min_code = 0x800; c &= 0x0F;
+        } else if ((c & 0xF8) == 0xF0) {
+            extra = 3; min_code = 0x10000; c &= 0x07;
+        } else {
+            dst[out++] = BCPL_UTF8_REPLACEMENT; /* not a lead byte */
+            i++;
+            continue;
+        }
+
+        size_t j = i + 1, k;
+        for (k = 0; k < extra; k++, j++) {
+            if (j >= len || (src[j] & 0xC0) != 0x80) break;
+            c = (c << 6) | (src[j] & 0x3F);
+        }
+        if (k < extra) {
+            if (j >= len && !final) break; /* wait for the rest of the sequence */
+            dst[out++] = BCPL_UTF8_REPLACEMENT;  /* the bad byte starts the next one */
+        } else if (c < min_code || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+            dst[out++] = BCPL_UTF8_REPLACEMENT;  /* overlong, surrogate or too large */
+        } else {
+            dst[out++] = c;
+        }
+        i = j;
+    }
+    *consumed = i;
+    return out;
+}
+
+/*
+ * Reads up to `max_bytes` bytes from a stream through `chunk` (chunk_size
+ * bytes, at least 4) and decodes them into dst, which must have room for
+ * max_bytes code points. Memory use is the chunk, whatever the file size.
+ * Returns the number of code points written; *bytes_read gets the bytes.
+ */
+static inline size_t bcpl_utf8_decode_stream(FILE* file, size_t max_bytes, uint32_t* dst,
+                                             unsigned char* chunk, size_t chunk_size,
+                                             size_t* bytes_read) {
+    size_t out = 0, total = 0, carry = 0;
+    for (;;) {
+        size_t want = chunk_size - carry;
+        if (want > max_bytes - total) want = max_bytes - total;
+        size_t got = want > 0 ? fread(chunk + carry, 1, want, file) : 0;
+        total += got;
+        int final = got == 0 || total == max_bytes;
+        size_t consumed = 0;
+        out += bcpl_utf8_decode(chunk, carry + got, dst + out, &consumed, final);
+        carry = carry + got - consumed;
+        if (final) break;
+        memmove(chunk, chunk + consumed, carry); /* a sequence split by the chunk */
+    }
+    *bytes_read = total;
+    return out;
+}
+
+/*
+ * Returns 1 if `len` bytes of UTF-8 are well formed and every character is
+ * Latin-1 (ASCII, or C2/C3 and a continuation byte), and sets *count to the
+ * number of characters. Returns 0 at the first byte that rules it out.
+ */
+static inline int bcpl_utf8_is_latin1(const unsigned char* src, size_t len, size_t* count) {
+    size_t i = 0, chars = 0;
+    while (i < len) {
+        if (i + 8 <= len) {
+            uint64_t word;
+            memcpy(&word, src + i, 8);
+            if ((word & 0x8080808080808080ull) == 0) {
+                i += 8;
+                chars += 8;
+                continue;
+            }
+        }
+        if (src[i] < 0x80) {
+            i++;
+        } else if ((src[i] == 0xC2 || src[i] == 0xC3) && i + 1 < len && (src[i + 1] & 0xC0) == 0x80) {
+            i += 2;
+        } else {
+            return 0;
+        }
+        chars++;
+    }
+    *count = chars;
+    return 1;
+}
+
+/*
+ * Decodes UTF-8 that bcpl_utf8_is_latin1() accepted into one byte per
+ * character. Returns the number of bytes written.
+ */
+static inline size_t bcpl_utf8_decode_latin1(const unsigned char* src, size_t len, uint8_t* dst) {
+    size_t i = 0, out = 0;
+    while (i < len) {
+        if (i + 8 <= len) {
+            uint64_t word;
+            memcpy(&word, src + i, 8);
+            if ((word & 0x8080808080808080ull) == 0) {
+                memcpy(dst + out, &word, 8);
+                i += 8;
+                out += 8;
+                continue;
+            }
+        }
+        if (src[i] < 0x80) {
+            dst[out++] = src[i++];
+        } else {
+            dst[out++] = (uint8_t)(((src[i] & 0x03) << 6) | (src[i + 1] & 0x3F));
+            i += 2;
+        }
+    }
+    return out;
+}
+
+#endif /* BCPL_UTF8_DECODE_H */
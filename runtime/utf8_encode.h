@@ -0,0 +1,139 @@
+/*
+ * utf8_encode.h
+ * UTF-32 to UTF-8 encoding for the runtime's output buffer
+ *
+ * BCPL strings are arrays of UTF-32 code points; the console wants UTF-8.
+ * bcpl_utf8_encode_run() converts a run of code points in one pass, taking
+ * eight at a time when they are all ASCII (NEON on AArch64, SSE2 on x86-64,
+ * plain C elsewhere, or with BCPL_STRING_KERNELS_PORTABLE defined). It stops
+ * at the characters WRITES and WRITEF give a meaning to ('*', '\\' and '%')
+ * so the caller can handle escapes and format specifiers itself.
+ *
+ * Shared by runtime.c (C) and the JIT runtime (C++), so everything here is
+ * C99 and static inline.
+ */
+
+#ifndef BCPL_UTF8_ENCODE_H
+#define BCPL_UTF8_ENCODE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if !defined(BCPL_STRING_KERNELS_PORTABLE) && defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BCPL_UTF8_ENCODE_NEON 1
+#elif !defined(BCPL_STRING_KERNELS_PORTABLE) && defined(__SSE2__)
+#include <emmintrin.h>
+#define BCPL_UTF8_ENCODE_SSE2 1
+#endif
+
+/* Longest UTF-8 encoding of one code point. */
+#define BCPL_UTF8_MAX_BYTES 4
+
+/*
+ * Encodes one code point into dst (room for BCPL_UTF8_MAX_BYTES) and returns
+ * the number of bytes written. Values outside Unicode are written as '?'.
+ */
+static inline size_t bcpl_utf8_encode_char(int64_t ch, unsigned char* dst) {
+    if (ch < 0 || ch > 0x10FFFF) {
+        dst[0] = '?';
+        return 1;
+    }
+    if (ch < 0x80) {
+        dst[0] = (unsigned char)ch;
+        return 1;
+    }
+    if (ch < 0x800) {
+        dst[0] = (unsigned char)(0xC0 | ((ch >> 6) & 0x1F));
+        dst[1] = (unsigned char)(0x80 | (ch & 0x3F));
+        return 2;
+    }
+    if (ch < 0x10000) {
+        dst[0] = (unsigned char)(0xE0 | ((ch >> 12) & 0x0F));
+        dst[1] = (unsigned char)(0x80 | ((ch >> 6) & 0x3F));
+        dst[2] = (unsigned char)(0x80 | (ch & 0x3F));
+        return 3;
+    }
+    dst[0] = (unsigned char)(0xF0 | ((ch >> 18) & 0x07));
+    dst[1] = (unsigned char)(0x80 | ((ch >> 12) & 0x3F));
+    dst[2] = (unsigned char)(0x80 | ((ch >> 6) & 0x3F));
+    dst[3] = (unsigned char)(0x80 | (ch & 0x3F));
+    return 4;
+}
+
+static inline int bcpl_utf8_is_special(uint32_t ch) {
+    return ch == '*' || ch == '\\' || ch == '%';
+}
+
+#if defined(BCPL_UTF8_ENCODE_NEON) || defined(BCPL_UTF8_ENCODE_SSE2)
+/*
+ * If the eight code points at src are all ASCII and none is special, writes
+ * them as eight bytes to dst and returns 1; otherwise returns 0.
+ */
+static inline int bcpl_utf8_encode_ascii8(const uint32_t* src, unsigned char* dst) {
+#if defined(BCPL_UTF8_ENCODE_NEON)
+    uint32x4_t lo = vld1q_u32(src);
+    uint32x4_t hi = vld1q_u32(src + 4);
+    uint32x4_t star = vdupq_n_u32('*'), backslash = vdupq_n_u32('\\'), percent = vdupq_n_u32('%');
+    uint32x4_t special = vorrq_u32(vorrq_u32(vceqq_u32(lo, star), vceqq_u32(hi, star)),
+                                   vorrq_u32(vorrq_u32(vceqq_u32(lo, backslash), vceqq_u32(hi, backslash)),
+                                             vorrq_u32(vceqq_u32(lo, percent), vceqq_u32(hi, percent))));
+    if (vmaxvq_u32(vorrq_u32(lo, hi)) >= 0x80 || vmaxvq_u32(special) != 0) return 0;
+    vst1_u8(dst, vmovn_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi))));
+#else
+    __m128i lo = _mm_loadu_si128((const __m128i*)src);
+    __m128i hi = _mm_loadu_si128((const __m128i*)(src + 4));
+    __m128i star = _mm_set1_epi32('*'), backslash = _mm_set1_epi32('\\'), percent = _mm_set1_epi32('%');
+    __m128i ascii = _mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(lo, hi), _mm_set1_epi32(~0x7F)),
+                                    _mm_setzero_si128());
+    __m128i special = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi32(lo, star), _mm_cmpeq_epi32(hi, star)),
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(lo, backslash), _mm_cmpeq_epi32(hi, backslash)),
+                     _mm_or_si128(_mm_cmpeq_epi32(lo, percent), _mm_cmpeq_epi32(hi, percent))));
+    if (_mm_movemask_epi8(ascii) != 0xFFFF || _mm_movemask_epi8(special) != 0) return 0;
+    __m128i narrow = _mm_packs_epi32(lo, hi);
+    _mm_storel_epi64((__m128i*)dst, _mm_packus_epi16(narrow, narrow));
+#endif
+    return 1;
+}
+#endif
+
+/*
+ * Encodes up to `count` code points from src into dst, which must have room
+ * for BCPL_UTF8_MAX_BYTES * count bytes, stopping before the first '*', '\\'
+ * or '%'. Sets *consumed to the number of code points encoded and returns the
+ * number of bytes written.
+ */
+static inline size_t bcpl_utf8_encode_run(const uint32_t* src, size_t count,
+                                          unsigned char* dst, size_t* consumed) {
+    size_t i = 0, out = 0;
+    while (i < count) {
+        size_t block_end = count;
+#if defined(BCPL_UTF8_ENCODE_NEON) || defined(BCPL_UTF8_ENCODE_SSE2)
+        if (i + 8 <= count) {
+            if (bcpl_utf8_encode_ascii8(src + i, dst + out)) {
+                i += 8;
+                out += 8;
+                continue;
+            }
+            block_end = i + 8; /* this block needs the scalar path */
+        }
+#endif
+        for (; i < block_end; i++) {
+            uint32_t ch = src[i];
+            if (ch < 0x80) {
+                if (bcpl_utf8_is_special(ch)) {
+                    *consumed = i;
+                    return out;
+                }
+                dst[out++] = (unsigned char)ch;
+            } else {
+                out += bcpl_utf8_encode_char(ch, dst + out);
+            }
+        }
+    }
+    *consumed = i;
+    return out;
+}
+
+#endif /* BCPL_UTF8_ENCODE_H */
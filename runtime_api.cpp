@@ -48,12 +48,20 @@ extern "C" {
     int UNPACKSTRING(int packed_ptr);
     int SLURP(int filename_ptr);
     int SPIT(int filename_ptr, int content_ptr);
+    int SB_NEW(int capacity);
+    int SB_APPEND(int builder_ptr, int string_ptr);
+    int SB_APPENDC(int builder_ptr, int char_value);
+    int SB_APPENDN(int builder_ptr, int value);
+    int SB_CLEAR(int builder_ptr);
+    int SB_STRING(int builder_ptr);
     
     // Memory management
     int bcpl_alloc_words(int count, int size, int type);
     int bcpl_alloc_chars(int count);
     int bcpl_getvec(int size);
     int bcpl_fgetvec(int size);
+    int bcpl_getvec_scoped(int size);
+    int bcpl_alloc_chars_scoped(int count);
     void bcpl_free(int ptr);
     void bcpl_free_list(int list_ptr);
     void bcpl_free_list_safe(int list_ptr);
@@ -61,6 +69,7 @@ extern "C" {
     void BCPL_CLEAR_ERRORS();
     void BCPL_CHECK_AND_DISPLAY_ERRORS();
     void BCPL_BOUNDS_ERROR(int index, int size, int context);
+    int BCPL_STRING_PROMOTE(int string_ptr);
     void BCPL_FREE_CELLS();
     int get_g_free_list_head_address();
     
@@ -104,6 +113,7 @@ extern "C" {
     int FILE_CLOSE(int handle);
     int FILE_WRITES(int handle, int string_ptr);
     int FILE_READS(int handle);
+    int FILE_READLINE(int handle);
     int FILE_READ(int handle, int buffer_ptr, int size);
     int FILE_WRITE(int handle, int buffer_ptr, int size);
     int FILE_SEEK(int handle, int offset, int origin);
@@ -295,6 +305,36 @@ static const RuntimeFunctionDescriptor g_runtime_manifest[] = {
         RuntimeFunctionType::ROUTINE, RuntimeReturnType::VOID,
         "Write string to file", "String"
     },
+    {
+        "SB_NEW", "_SB_NEW", reinterpret_cast<RuntimeFunctionPtr>(SB_NEW), 1,
+        RuntimeFunctionType::STANDARD, RuntimeReturnType::INTEGER,
+        "Create a string builder", "String"
+    },
+    {
+        "SB_APPEND", "_SB_APPEND", reinterpret_cast<RuntimeFunctionPtr>(SB_APPEND), 2,
+        RuntimeFunctionType::STANDARD, RuntimeReturnType::INTEGER,
+        "Append a string to a string builder", "String"
+    },
+    {
+        "SB_APPENDC", "_SB_APPENDC", reinterpret_cast<RuntimeFunctionPtr>(SB_APPENDC), 2,
+        RuntimeFunctionType::STANDARD, RuntimeReturnType::INTEGER,
+        "Append a character to a string builder", "String"
+    },
+    {
+        "SB_APPENDN", "_SB_APPENDN", reinterpret_cast<RuntimeFunctionPtr>(SB_APPENDN), 2,
+        RuntimeFunctionType::STANDARD, RuntimeReturnType::INTEGER,
+        "Append a decimal integer to a string builder", "String"
+    },
+    {
+        "SB_CLEAR", "_SB_CLEAR", reinterpret_cast<RuntimeFunctionPtr>(SB_CLEAR), 1,
+        RuntimeFunctionType::STANDARD, RuntimeReturnType::INTEGER,
+        "Empty a string builder", "String"
+    },
+    {
+        "SB_STRING", "_SB_STRING", reinterpret_cast<RuntimeFunctionPtr>(SB_STRING), 1,
+        RuntimeFunctionType::STANDARD, RuntimeReturnType::STRING,
+        "Copy a string builder's contents into a new string", "String"
+    },
 
     // -------------------------------------------------------------------------
     // MEMORY MANAGEMENT
@@ -309,6 +349,16 @@ static const RuntimeFunctionDescriptor g_runtime_manifest[] = {
         RuntimeFunctionType::STANDARD, RuntimeReturnType::FLOAT_VECTOR,
         "Allocate float vector", "Memory"
     },
+    {
+        "GETVEC_SCOPED", "_GETVEC_SCOPED", reinterpret_cast<RuntimeFunctionPtr>(bcpl_getvec_scoped), 1,
+        RuntimeFunctionType::STANDARD, RuntimeReturnType::INT_VECTOR,
+        "Allocate scope-local integer vector (released at SAMM scope exit)", "Memory"
+    },
+    {
+        "BCPL_ALLOC_CHARS_SCOPED", "_BCPL_ALLOC_CHARS_SCOPED", reinterpret_cast<RuntimeFunctionPtr>(bcpl_alloc_chars_scoped), 1,
+        RuntimeFunctionType::STANDARD, RuntimeReturnType::INTEGER,
+        "Allocate scope-local character buffer (released at SAMM scope exit)", "Memory"
+    },
     {
         "FREEVEC", "_FREEVEC", reinterpret_cast<RuntimeFunctionPtr>(bcpl_free), 1,
         RuntimeFunctionType::ROUTINE, RuntimeReturnType::VOID,
@@ -359,6 +409,11 @@ static const RuntimeFunctionDescriptor g_runtime_manifest[] = {
         RuntimeFunctionType::ROUTINE, RuntimeReturnType::VOID,
         "Report bounds checking error", "Memory"
     },
+    {
+        "BCPL_STRING_PROMOTE", "_BCPL_STRING_PROMOTE", reinterpret_cast<RuntimeFunctionPtr>(BCPL_STRING_PROMOTE), 1,
+        RuntimeFunctionType::STANDARD, RuntimeReturnType::STRING,
+        "Widen a compact string to UTF-32 before a wide character is stored", "String"
+    },
     {
         "BCPL_FREE_CELLS", "_BCPL_FREE_CELLS", reinterpret_cast<RuntimeFunctionPtr>(BCPL_FREE_CELLS), 0,
         RuntimeFunctionType::ROUTINE, RuntimeReturnType::VOID,
@@ -586,6 +641,11 @@ static const RuntimeFunctionDescriptor g_runtime_manifest[] = {
         RuntimeFunctionType::STANDARD, RuntimeReturnType::STRING,
         "Read string from file", "File"
     },
+    {
+        "FILE_READLINE", "_FILE_READLINE", reinterpret_cast<RuntimeFunctionPtr>(FILE_READLINE), 1,
+        RuntimeFunctionType::STANDARD, RuntimeReturnType::STRING,
+        "Read next line from file", "File"
+    },
     {
         "FILE_READ", "_FILE_READ", reinterpret_cast<RuntimeFunctionPtr>(FILE_READ), 3,
         RuntimeFunctionType::STANDARD, RuntimeReturnType::INTEGER,
@@ -0,0 +1,65 @@
+#!/bin/bash
+# bench_calls.sh - Call-overhead benchmark for FunctionInliningPass
+#
+# Runs a BCPL benchmark under the JIT with --opt, once with function inlining
+# and once with --no-inline, checks that both print the same result, and
+# reports the wall-clock time of each run and the time saved by inlining.
+#
+# Usage: ./scripts/bench_calls.sh [program] [compiler] [runs]
+#   program  - BCPL source (default tests/bcl_tests/bench_calls.bcl)
+#   compiler - compiler binary (default ./build/bin/NewBCPL)
+#   runs     - timed runs per configuration; the fastest is kept (default 3)
+
+PROGRAM="${1:-tests/bcl_tests/bench_calls.bcl}"
+COMPILER="${2:-./build/bin/NewBCPL}"
+RUNS="${3:-3}"
+OUT_DIR="${TMPDIR:-/tmp}/bcpl_call_bench"
+
+if [ ! -x "$COMPILER" ]; then
+    echo "Compiler not found at $COMPILER (run ./build.sh first)"
+    exit 1
+fi
+if [ ! -f "$PROGRAM" ]; then
+    echo "Benchmark program not found: $PROGRAM"
+    exit 1
+fi
+
+mkdir -p "$OUT_DIR"
+
+# Milliseconds since the epoch. BSD date (macOS) has no %N, so use perl.
+now_ms() {
+    perl -MTime::HiRes=time -e 'printf "%d\n", time() * 1000'
+}
+
+# Prints the fastest of RUNS runs in ms; output goes to $OUT_DIR/<label>.out
+best_time() {
+    local label="$1"
+    shift
+    local best=""
+    for ((i = 0; i < RUNS; i++)); do
+        local start_ms end_ms elapsed
+        start_ms=$(now_ms)
+        "$COMPILER" --opt --run "$@" "$PROGRAM" > "${OUT_DIR}/${label}.out" 2>&1 || return 1
+        end_ms=$(now_ms)
+        elapsed=$((end_ms - start_ms))
+        if [ -z "$best" ] || [ "$elapsed" -lt "$best" ]; then best=$elapsed; fi
+    done
+    echo "$best"
+}
+
+echo "Timing $PROGRAM ($RUNS runs each, fastest kept)"
+
+INLINED=$(best_time inlined) || { echo "Run with inlining failed; see ${OUT_DIR}/inlined.out"; exit 1; }
+CALLED=$(best_time called --no-inline) || { echo "Run with --no-inline failed; see ${OUT_DIR}/called.out"; exit 1; }
+
+if ! diff -q "${OUT_DIR}/inlined.out" "${OUT_DIR}/called.out" > /dev/null; then
+    echo "Output differs between inlined and --no-inline runs:"
+    diff "${OUT_DIR}/called.out" "${OUT_DIR}/inlined.out"
+    exit 1
+fi
+
+echo "  --no-inline: ${CALLED} ms"
+echo "  inlined:     ${INLINED} ms"
+if [ "$CALLED" -gt 0 ]; then
+    echo "  call overhead removed: $((CALLED - INLINED)) ms ($(( (CALLED - INLINED) * 100 / CALLED ))%)"
+fi
@@ -0,0 +1,93 @@
+#!/bin/bash
+# bench_compile.sh - Compile-time benchmark for the NewBCPL front and back end
+#
+# Generates a synthetic BCPL program of roughly LINES lines (many small
+# functions with locals, loops and calls) and compiles it to assembly with
+# --time-passes, which prints the wall-clock time spent in each pass, and
+# reports the compiler's peak resident memory.
+#
+# Usage: ./scripts/bench_compile.sh [lines] [compiler] [jobs]
+#   lines    - approximate program size (default 50000)
+#   compiler - compiler binary (default ./build/bin/NewBCPL)
+#   jobs     - threads for liveness, live intervals, allocation and codegen (default 1)
+
+LINES="${1:-50000}"
+COMPILER="${2:-./build/bin/NewBCPL}"
+JOBS="${3:-1}"
+OUT_DIR="${TMPDIR:-/tmp}/bcpl_compile_bench"
+SOURCE="${OUT_DIR}/bench_${LINES}.bcl"
+
+if [ ! -x "$COMPILER" ]; then
+    echo "Compiler not found at $COMPILER (run ./build.sh first)"
+    exit 1
+fi
+
+mkdir -p "$OUT_DIR"
+
+# Each generated function is 25 lines; START calls a sample of them.
+awk -v lines="$LINES" 'BEGIN {
+    funcs = int(lines / 25)
+    if (funcs < 1) funcs = 1
+    for (f = 0; f < funcs; f++) {
+        printf "LET Fn%d(a, b) = VALOF\n{\n", f
+        printf "    LET total = 0\n"
+        printf "    LET x%d = a + %d\n", f, f
+        printf "    LET y%d = b * 3\n", f
+        printf "    LET z%d = x%d - y%d\n", f, f, f
+        printf "    FOR i = 1 TO 10 DO\n    {\n"
+        printf "        total := total + i * x%d\n", f
+        printf "        IF total > 1000 THEN total := total - y%d\n", f
+        printf "    }\n"
+        printf "    IF z%d < 0 THEN z%d := -z%d\n", f, f, f
+        printf "    TEST a > b THEN total := total + a ELSE total := total + b\n"
+        printf "    WHILE z%d > 100 DO z%d := z%d / 2\n", f, f, f
+        if (f > 0) {
+            printf "    total := total + Fn%d(a - 1, z%d)\n", f - 1, f
+        } else {
+            printf "    total := total + z%d\n", f
+        }
+        printf "    SWITCHON a REM 4 INTO\n    {\n"
+        printf "        CASE 0: total := total + 1\n"
+        printf "        CASE 1: total := total + 2\n"
+        printf "        DEFAULT: total := total + 3\n"
+        printf "    }\n"
+        printf "    RESULTIS total + x%d\n", f
+        printf "}\n\n"
+    }
+    printf "LET START() BE\n{\n"
+    for (f = 0; f < funcs; f += 100) {
+        printf "    WRITEN(Fn%d(%d, 2))\n", f, f
+    }
+    printf "    WRITES(\"*N\")\n}\n"
+}' > "$SOURCE"
+
+echo "Generated $(wc -l < "$SOURCE") lines in $SOURCE"
+echo "Compiling with $COMPILER --asm --time-passes --jobs $JOBS"
+
+# Peak RSS comes from /usr/bin/time: -l on macOS (bytes), -v on Linux (KB)
+TIME_CMD=()
+if [ -x /usr/bin/time ]; then
+    if [ "$(uname)" = "Darwin" ]; then TIME_CMD=(/usr/bin/time -l); else TIME_CMD=(/usr/bin/time -v); fi
+fi
+
+# Milliseconds since the epoch. BSD date (macOS) has no %N, so use perl.
+now_ms() {
+    perl -MTime::HiRes=time -e 'printf "%d\n", time() * 1000'
+}
+
+START_MS=$(now_ms)
+"${TIME_CMD[@]}" "$COMPILER" --asm --time-passes --jobs "$JOBS" "$SOURCE" > "${OUT_DIR}/compile.log" 2> "${OUT_DIR}/timings.txt"
+STATUS=$?
+END_MS=$(now_ms)
+
+sed -n '/=== Pass Timings ===/,/Total/p' "${OUT_DIR}/timings.txt"
+PEAK=$(grep -i "maximum resident set size" "${OUT_DIR}/timings.txt" | grep -o -E "[0-9]+" | head -1)
+if [ -n "$PEAK" ]; then
+    if [ "$(uname)" = "Darwin" ]; then PEAK=$((PEAK / 1024)); fi
+    echo "Peak resident memory: $((PEAK / 1024)) MB"
+fi
+echo "Wall clock (including process start): $((END_MS - START_MS)) ms"
+if [ $STATUS -ne 0 ]; then
+    echo "Compilation failed (exit $STATUS); see ${OUT_DIR}/compile.log"
+    exit $STATUS
+fi
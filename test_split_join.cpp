@@ -509,9 +509,10 @@ bool test_samm_memory_management() {
     
     auto& hm = HeapManager::getInstance();
     hm.setSAMMEnabled(true);
+    hm.setHeapBlockTrackingEnabled(true); // Count slab arena blocks as live blocks too
     
-    // Get initial metrics
-    size_t initial_allocations = hm.heap_blocks_.size();
+    // Get initial metrics (live blocks; freed tombstones are not counted)
+    size_t initial_allocations = hm.getLiveBlockCount();
     
     // Perform many SPLIT/JOIN operations
     for (int i = 0; i < 100; i++) {
@@ -533,12 +534,12 @@ bool test_samm_memory_management() {
     }
     
     // Check final metrics
-    size_t final_allocations = hm.heap_blocks_.size();
+    size_t final_allocations = hm.getLiveBlockCount();
     
     if (ENABLE_VERBOSE) {
         std::cout << "Initial allocations: " << initial_allocations << std::endl;
         std::cout << "Final allocations: " << final_allocations << std::endl;
-        std::cout << "Net allocation increase: " << (final_allocations - initial_allocations) << std::endl;
+        std::cout << "Net allocation increase: " << (static_cast<long long>(final_allocations) - static_cast<long long>(initial_allocations)) << std::endl;
     }
     
     return true; // Just verify we didn't crash
@@ -864,6 +864,13 @@ void EncoderTester::initialize_test_map() {
     encoder_test_map["enc_create_ldr_fp_imm"] = [this]() { return this->test_enc_create_ldr_fp_imm(); };
     encoder_test_map["enc_create_ldr_imm"] = [this]() { return this->test_enc_create_ldr_imm(); };
     encoder_test_map["enc_create_ldr_scaled_reg_64bit"] = [this]() { return this->test_enc_create_ldr_scaled_reg_64bit(); };
+    encoder_test_map["enc_create_str_scaled_reg_64bit"] = [this]() { return this->test_enc_create_str_scaled_reg_64bit(); };
+    encoder_test_map["enc_create_ldr_word_scaled_reg"] = [this]() { return this->test_enc_create_ldr_word_scaled_reg(); };
+    encoder_test_map["enc_create_str_word_scaled_reg"] = [this]() { return this->test_enc_create_str_word_scaled_reg(); };
+    encoder_test_map["enc_create_ldr_fp_scaled_reg"] = [this]() { return this->test_enc_create_ldr_fp_scaled_reg(); };
+    encoder_test_map["enc_create_str_fp_scaled_reg"] = [this]() { return this->test_enc_create_str_fp_scaled_reg(); };
+    encoder_test_map["enc_create_ldrb_reg"] = [this]() { return this->test_enc_create_ldrb_reg(); };
+    encoder_test_map["enc_create_strb_reg"] = [this]() { return this->test_enc_create_strb_reg(); };
     encoder_test_map["enc_create_ldr_vec_imm"] = [this]() { return this->test_enc_create_ldr_vec_imm(); };
     encoder_test_map["enc_create_ldr_word_imm"] = [this]() { return this->test_enc_create_ldr_word_imm(); };
     encoder_test_map["enc_create_ldrb_imm"] = [this]() { return this->test_enc_create_ldrb_imm(); };
@@ -1172,6 +1179,41 @@ bool EncoderTester::test_enc_create_ldr_scaled_reg_64bit() {
     return runValidation("enc_create_ldr_scaled_reg_64bit", instr);
 }
 
+bool EncoderTester::test_enc_create_str_scaled_reg_64bit() {
+    Instruction instr = ::test_enc_create_str_scaled_reg_64bit(); // Calls wrapper in TestableEncoders.cpp
+    return runValidation("enc_create_str_scaled_reg_64bit", instr);
+}
+
+bool EncoderTester::test_enc_create_ldr_word_scaled_reg() {
+    Instruction instr = ::test_enc_create_ldr_word_scaled_reg(); // Calls wrapper in TestableEncoders.cpp
+    return runValidation("enc_create_ldr_word_scaled_reg", instr);
+}
+
+bool EncoderTester::test_enc_create_str_word_scaled_reg() {
+    Instruction instr = ::test_enc_create_str_word_scaled_reg(); // Calls wrapper in TestableEncoders.cpp
+    return runValidation("enc_create_str_word_scaled_reg", instr);
+}
+
+bool EncoderTester::test_enc_create_ldr_fp_scaled_reg() {
+    Instruction instr = ::test_enc_create_ldr_fp_scaled_reg(); // Calls wrapper in TestableEncoders.cpp
+    return runValidation("enc_create_ldr_fp_scaled_reg", instr);
+}
+
+bool EncoderTester::test_enc_create_str_fp_scaled_reg() {
+    Instruction instr = ::test_enc_create_str_fp_scaled_reg(); // Calls wrapper in TestableEncoders.cpp
+    return runValidation("enc_create_str_fp_scaled_reg", instr);
+}
+
+bool EncoderTester::test_enc_create_ldrb_reg() {
+    Instruction instr = ::test_enc_create_ldrb_reg(); // Calls wrapper in TestableEncoders.cpp
+    return runValidation("enc_create_ldrb_reg", instr);
+}
+
+bool EncoderTester::test_enc_create_strb_reg() {
+    Instruction instr = ::test_enc_create_strb_reg(); // Calls wrapper in TestableEncoders.cpp
+    return runValidation("enc_create_strb_reg", instr);
+}
+
 bool EncoderTester::test_enc_create_ldr_vec_imm() {
     Instruction instr = ::test_enc_create_ldr_vec_imm(); // Calls wrapper in TestableEncoders.cpp
     return runValidation("enc_create_ldr_vec_imm", instr);
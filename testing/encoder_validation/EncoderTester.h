@@ -259,6 +259,13 @@ public:
     bool test_enc_create_ldr_fp_imm();
     bool test_enc_create_ldr_imm();
     bool test_enc_create_ldr_scaled_reg_64bit();
+    bool test_enc_create_str_scaled_reg_64bit();
+    bool test_enc_create_ldr_word_scaled_reg();
+    bool test_enc_create_str_word_scaled_reg();
+    bool test_enc_create_ldr_fp_scaled_reg();
+    bool test_enc_create_str_fp_scaled_reg();
+    bool test_enc_create_ldrb_reg();
+    bool test_enc_create_strb_reg();
     bool test_enc_create_ldr_vec_imm();
     bool test_enc_create_ldr_word_imm();
     bool test_enc_create_ldrb_imm();
@@ -585,6 +585,55 @@ Instruction test_enc_create_ldr_scaled_reg_64bit() {
     return Encoder::create_ldr_scaled_reg_64bit("x0", "x1", "x2", 0);
 }
 
+/**
+ * @brief Wrapper for Encoder::create_str_scaled_reg_64bit for direct testing.
+ */
+Instruction test_enc_create_str_scaled_reg_64bit() {
+    return Encoder::create_str_scaled_reg_64bit("x3", "x4", "x5", 3);
+}
+
+/**
+ * @brief Wrapper for Encoder::create_ldr_word_scaled_reg for direct testing.
+ */
+Instruction test_enc_create_ldr_word_scaled_reg() {
+    return Encoder::create_ldr_word_scaled_reg("w0", "x1", "x2", 2);
+}
+
+/**
+ * @brief Wrapper for Encoder::create_str_word_scaled_reg for direct testing.
+ */
+Instruction test_enc_create_str_word_scaled_reg() {
+    return Encoder::create_str_word_scaled_reg("w6", "x7", "x8", 2);
+}
+
+/**
+ * @brief Wrapper for Encoder::create_ldr_fp_scaled_reg for direct testing.
+ */
+Instruction test_enc_create_ldr_fp_scaled_reg() {
+    return Encoder::create_ldr_fp_scaled_reg("d0", "x1", "x2", 3);
+}
+
+/**
+ * @brief Wrapper for Encoder::create_str_fp_scaled_reg for direct testing.
+ */
+Instruction test_enc_create_str_fp_scaled_reg() {
+    return Encoder::create_str_fp_scaled_reg("d1", "x2", "x3", 3);
+}
+
+/**
+ * @brief Wrapper for Encoder::create_ldrb_reg for direct testing.
+ */
+Instruction test_enc_create_ldrb_reg() {
+    return Encoder::create_ldrb_reg("w0", "x1", "x2");
+}
+
+/**
+ * @brief Wrapper for Encoder::create_strb_reg for direct testing.
+ */
+Instruction test_enc_create_strb_reg() {
+    return Encoder::create_strb_reg("w3", "x4", "x5");
+}
+
 /**
  * @brief Wrapper for Encoder::create_ldr_vec_imm for direct testing.
  */
@@ -61,6 +61,13 @@ Instruction test_enc_create_ldp_pre_imm();
 Instruction test_enc_create_ldr_fp_imm();
 Instruction test_enc_create_ldr_imm();
 Instruction test_enc_create_ldr_scaled_reg_64bit();
+Instruction test_enc_create_str_scaled_reg_64bit();
+Instruction test_enc_create_ldr_word_scaled_reg();
+Instruction test_enc_create_str_word_scaled_reg();
+Instruction test_enc_create_ldr_fp_scaled_reg();
+Instruction test_enc_create_str_fp_scaled_reg();
+Instruction test_enc_create_ldrb_reg();
+Instruction test_enc_create_strb_reg();
 Instruction test_enc_create_ldr_vec_imm();
 Instruction test_enc_create_ldr_word_imm();
 Instruction test_enc_create_ldrb_imm();
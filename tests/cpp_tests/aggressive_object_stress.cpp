@@ -1,6 +1,7 @@
 // aggressive_object_stress.cpp
 // Aggressive stress test for BCPL object lists with SAMM memory management
 // Tests high volume, complex patterns, memory pressure, and cleanup efficiency
+// Run with --compare-arena to benchmark the slab arena against the legacy path
 
 #include <iostream>
 #include <chrono>
@@ -24,6 +25,8 @@ extern "C" {
     void HeapManager_exitScope(void);
     void HeapManager_setSAMMEnabled(int enabled);
     int HeapManager_isSAMMEnabled(void);
+    void HeapManager_setSlabArenaEnabled(int enabled);
+    void HeapManager_waitForSAMM(void);
 }
 
 // Mock function implementations
@@ -422,7 +425,58 @@ bool test_nested_scope_stress() {
     return true;
 }
 
-int main() {
+// Benchmark: run every stress workload on the legacy posix_memalign +
+// heap_blocks_ path and on the slab arena path, then compare wall time.
+int run_arena_comparison() {
+    std::cout << "=== SLAB ARENA vs LEGACY ALLOCATOR BENCHMARK ===\n\n";
+
+    HeapManager_setSAMMEnabled(1);
+    HeapManager::getInstance().setTraceEnabled(false);
+
+    struct Workload { const char* name; bool (*fn)(); };
+    const Workload workloads[] = {
+        { "High Volume Creation", test_high_volume_creation },
+        { "Memory Pressure",      test_memory_pressure },
+        { "Rapid Scope Cycling",  test_rapid_scope_cycling },
+        { "Mixed Size Stress",    test_mixed_size_stress },
+        { "Nested Scope Stress",  test_nested_scope_stress },
+    };
+    const size_t num_workloads = sizeof(workloads) / sizeof(workloads[0]);
+    std::vector<double> legacy_ms(num_workloads), arena_ms(num_workloads);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        bool use_arena = (pass == 1);
+        HeapManager_setSlabArenaEnabled(use_arena ? 1 : 0);
+        std::cout << "--- Pass " << (pass + 1) << ": " << (use_arena ? "slab arena" : "legacy posix_memalign") << " ---\n";
+        for (size_t i = 0; i < num_workloads; ++i) {
+            Timer timer;
+            timer.start();
+            workloads[i].fn();
+            HeapManager_waitForSAMM(); // Include cleanup cost in the measurement
+            (use_arena ? arena_ms : legacy_ms)[i] = timer.stop();
+        }
+    }
+
+    std::cout << "\n=== ALLOCATOR COMPARISON (ms, includes SAMM cleanup) ===\n";
+    double legacy_total = 0.0, arena_total = 0.0;
+    for (size_t i = 0; i < num_workloads; ++i) {
+        legacy_total += legacy_ms[i];
+        arena_total += arena_ms[i];
+        std::cout << workloads[i].name << ": legacy " << legacy_ms[i] << " ms, arena " << arena_ms[i]
+                  << " ms, speedup " << (arena_ms[i] > 0 ? legacy_ms[i] / arena_ms[i] : 0.0) << "x\n";
+    }
+    std::cout << "TOTAL: legacy " << legacy_total << " ms, arena " << arena_total
+              << " ms, speedup " << (arena_total > 0 ? legacy_total / arena_total : 0.0) << "x\n";
+    std::cout << "Slabs carved: " << SlabArena::getInstance().getSlabCount()
+              << ", arena committed bytes: " << SlabArena::getInstance().getCommittedBytes() << "\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--compare-arena") {
+        return run_arena_comparison();
+    }
+
     std::cout << "=== AGGRESSIVE OBJECT LIST STRESS TEST ===\n\n";
     
     // Enable SAMM
@@ -0,0 +1,156 @@
+// Memory and throughput benchmark for compact strings.
+//
+// Reads a Latin-1 text file with SLURP and FILE_READLINE, compares the lines
+// with STRCMP and writes the text back with SPIT, first with UTF-32 strings
+// (the default) and then with --compact-strings, and reports the string
+// memory and the time of each step. Run it as
+//
+//   bench_compact_strings [megabytes]      (default 64)
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../../runtime/runtime.h"
+#include "../../runtime/BCPLError.h"
+
+// The runtime's allocator, counting the bytes it hands out.
+static uint64_t string_bytes = 0;
+
+extern "C" {
+void* bcpl_alloc_chars(int64_t num_chars) {
+    size_t size = sizeof(uint64_t) + (num_chars + 1) * sizeof(uint32_t);
+    string_bytes += size;
+    uint64_t* block = static_cast<uint64_t*>(std::malloc(size));
+    block[0] = num_chars;
+    uint32_t* payload = reinterpret_cast<uint32_t*>(block + 1);
+    payload[num_chars] = 0;
+    return payload;
+}
+void update_io_metrics_read(size_t) {}
+void update_io_metrics_write(size_t) {}
+void update_io_metrics_file_opened(void) {}
+void update_io_metrics_file_closed(void) {}
+void bcpl_free(void* ptr) { std::free(static_cast<uint64_t*>(ptr) - 1); }
+void _BCPL_SET_ERROR(BCPLErrorCode, const char*, const char*) {}
+}
+
+#include "../../runtime/runtime_core.inc"
+#include "../../runtime/runtime_file_api.inc"
+#include "../../runtime/runtime_io.inc"
+
+static uint32_t* path_string(const std::string& path) {
+    uint32_t* s = static_cast<uint32_t*>(bcpl_alloc_chars(path.size()));
+    for (size_t i = 0; i < path.size(); ++i) s[i] = (unsigned char)path[i];
+    return s;
+}
+
+static void free_string(uint32_t* s) {
+    uint64_t* base = reinterpret_cast<uint64_t*>(s) - 1;
+    bcpl_string_release_promoted(base);
+    std::free(base);
+}
+
+template <typename Body>
+static double seconds(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Run {
+    double slurp, readline, compare, spit;
+    uint64_t slurp_bytes, line_bytes;
+};
+
+static Run run(bool compact, uint32_t* in, uint32_t* out) {
+    Run r{};
+    bcpl_set_compact_strings(compact);
+
+    uint32_t* text = nullptr;
+    string_bytes = 0;
+    r.slurp = seconds([&] { text = SLURP(in); });
+    r.slurp_bytes = string_bytes;
+    r.spit = seconds([&] { SPIT(text, out); });
+    free_string(text);
+
+    std::vector<uint32_t*> lines;
+    string_bytes = 0;
+    r.readline = seconds([&] {
+        uintptr_t handle = FILE_OPEN_READ(in);
+        while (uint32_t* line = FILE_READLINE(handle)) lines.push_back(line);
+        FILE_CLOSE(handle);
+    });
+    r.line_bytes = string_bytes;
+
+    int64_t matches = 0;
+    r.compare = seconds([&] {
+        for (size_t i = 1; i < lines.size(); ++i) matches += STRCMP(lines[i - 1], lines[i]) == 0;
+    });
+    if (matches < 0) std::cerr << matches;
+    for (uint32_t* line : lines) free_string(line);
+    return r;
+}
+
+// `ratio` is how many times better compact is: less memory, more throughput.
+static void row(const std::string& name, double before, double after, double ratio, const std::string& unit) {
+    std::cerr << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << before << std::setw(12) << after << std::setw(10) << ratio << "x  "
+              << unit << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+
+    // Lines of Western European text: mostly ASCII with accented letters.
+    const char* words[] = {"caf\xC3\xA9", "na\xC3\xAFve", "stra\xC3\x9F" "e", "ni\xC3\xB1o", "the", "of",
+                           "warehouse", "shipped", "r\xC3\xA9sum\xC3\xA9", "and", "Z\xC3\xBCrich", "12345"};
+    char in_template[] = "/tmp/bcpl_compact_in_XXXXXX";
+    char out_template[] = "/tmp/bcpl_compact_out_XXXXXX";
+    close(mkstemp(in_template));
+    close(mkstemp(out_template));
+    {
+        FILE* f = std::fopen(in_template, "wb");
+        uint64_t written = 0, n = 0;
+        std::string line;
+        while (written < megabytes << 20) {
+            line.clear();
+            for (int w = 0; w < 10; ++w) {
+                line += words[(n * 7 + w * 3) % 12];
+                line += w == 9 ? '\n' : ' ';
+            }
+            n++;
+            std::fwrite(line.data(), 1, line.size(), f);
+            written += line.size();
+        }
+        std::fclose(f);
+    }
+    uint32_t* in = path_string(in_template);
+    uint32_t* out = path_string(out_template);
+
+    Run wide = run(false, in, out);
+    Run compact = run(true, in, out);
+    double mb = static_cast<double>(megabytes);
+
+    std::cerr << "Compact strings, " << megabytes << " MB of Latin-1 text" << std::endl;
+    std::cerr << std::left << std::setw(24) << "case" << std::right << std::setw(12) << "UTF-32"
+              << std::setw(12) << "compact" << std::setw(11) << "gain" << std::endl;
+    row("SLURP string memory", wide.slurp_bytes / 1048576.0, compact.slurp_bytes / 1048576.0,
+        static_cast<double>(wide.slurp_bytes) / compact.slurp_bytes, "MB");
+    row("FILE_READLINE memory", wide.line_bytes / 1048576.0, compact.line_bytes / 1048576.0,
+        static_cast<double>(wide.line_bytes) / compact.line_bytes, "MB");
+    row("SLURP", mb / wide.slurp, mb / compact.slurp, wide.slurp / compact.slurp, "MB/s");
+    row("FILE_READLINE", mb / wide.readline, mb / compact.readline, wide.readline / compact.readline, "MB/s");
+    row("STRCMP adjacent lines", mb / wide.compare, mb / compact.compare, wide.compare / compact.compare, "MB/s");
+    row("SPIT", mb / wide.spit, mb / compact.spit, wide.spit / compact.spit, "MB/s");
+
+    std::remove(in_template);
+    std::remove(out_template);
+    return 0;
+}
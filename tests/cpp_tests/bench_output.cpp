@@ -0,0 +1,142 @@
+// I/O throughput benchmark for console output.
+//
+// Writes the same text three ways with the runtime's buffered WRITES, WRITEC
+// and WRITEF (runtime/runtime_core.inc), and with the putchar-per-byte,
+// fflush-per-call versions they replaced, and reports characters per second.
+// Program output goes to stdout, results to stderr, so run it as
+//
+//   bench_output [characters] > /dev/null      (default 100000000)
+//
+// or redirect stdout to a file or a pipe to see those costs. The WRITEC row
+// makes one call per character, so the old version makes one write(2) per
+// character; give a smaller count for a quick run.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../runtime/runtime.h"
+#include "../../runtime/runtime_core.inc"
+
+// --- The output path before buffering ---
+
+static void old_write_utf8_char(int64_t ch) {
+    if (ch < 0 || ch > 0x10FFFF) {
+        putchar('?');
+    } else if (ch < 0x80) {
+        putchar((char)ch);
+    } else if (ch < 0x800) {
+        putchar(0xC0 | ((ch >> 6) & 0x1F));
+        putchar(0x80 | (ch & 0x3F));
+    } else if (ch < 0x10000) {
+        putchar(0xE0 | ((ch >> 12) & 0x0F));
+        putchar(0x80 | ((ch >> 6) & 0x3F));
+        putchar(0x80 | (ch & 0x3F));
+    } else {
+        putchar(0xF0 | ((ch >> 18) & 0x07));
+        putchar(0x80 | ((ch >> 12) & 0x3F));
+        putchar(0x80 | ((ch >> 6) & 0x3F));
+        putchar(0x80 | (ch & 0x3F));
+    }
+}
+
+static void old_writes(const uint32_t* s) {
+    for (const uint32_t* p = s; *p != 0; ++p) {
+        if (*p == '*' && p[1] == 'N') {
+            putchar('\n');
+            ++p;
+        } else {
+            old_write_utf8_char(*p);
+        }
+    }
+    fflush(stdout);
+}
+
+static void old_writec(int64_t ch) {
+    old_write_utf8_char(ch);
+    fflush(stdout);
+}
+
+// "%N: %s*N" the way WRITEF_impl printed it.
+static void old_writef_line(int64_t n, const uint32_t* s) {
+    printf("%lld", (long long)n);
+    putchar(':');
+    putchar(' ');
+    for (const uint32_t* p = s; *p != 0; ++p) old_write_utf8_char(*p);
+    putchar('\n');
+    fflush(stdout);
+}
+
+// A heap-layout BCPL string: length prefix, code points, terminator.
+struct BcplString {
+    std::vector<uint64_t> storage;
+    explicit BcplString(const std::vector<uint32_t>& chars) : storage(2 + (chars.size() + 2) / 2, 0) {
+        storage[0] = chars.size();
+        std::memcpy(payload(), chars.data(), chars.size() * sizeof(uint32_t));
+    }
+    uint32_t* payload() { return reinterpret_cast<uint32_t*>(storage.data() + 1); }
+};
+
+static std::vector<uint32_t> chars_of(const std::string& ascii) {
+    return std::vector<uint32_t>(ascii.begin(), ascii.end());
+}
+
+template <typename Body>
+static double seconds(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    bcpl_output_flush();
+    fflush(stdout);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void row(const std::string& name, uint64_t chars, double before, double after) {
+    std::cerr << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << chars / before / 1e6 << std::setw(14) << chars / after / 1e6
+              << std::setw(10) << before / after << "x" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t total = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000ULL;
+
+    // A 72-character report line, ASCII and with a few accented letters.
+    const std::string ascii_line = "The quick brown fox jumps over the lazy dog; 0123456789 ABCDEFGHIJKLM*N";
+    std::vector<uint32_t> accented = chars_of(ascii_line);
+    accented[4] = 0xE9;
+    accented[20] = 0x20AC;
+    BcplString ascii(chars_of(ascii_line)), mixed(accented);
+    BcplString field(chars_of("widgets shipped to the warehouse"));
+    BcplString format(chars_of("%N: %s*N"));
+    const uint64_t line_chars = ascii_line.size() - 1; // *N prints one character
+
+    std::cerr << "Console output, " << total << " characters (million characters per second)" << std::endl;
+    std::cerr << std::left << std::setw(22) << "case" << std::right << std::setw(14) << "putchar"
+              << std::setw(14) << "buffered" << std::setw(11) << "speedup" << std::endl;
+
+    uint64_t lines = total / line_chars;
+    row("WRITES ASCII lines", lines * line_chars,
+        seconds([&] { for (uint64_t i = 0; i < lines; ++i) old_writes(ascii.payload()); }),
+        seconds([&] { for (uint64_t i = 0; i < lines; ++i) WRITES(ascii.payload()); }));
+    row("WRITES UTF-8 lines", lines * line_chars,
+        seconds([&] { for (uint64_t i = 0; i < lines; ++i) old_writes(mixed.payload()); }),
+        seconds([&] { for (uint64_t i = 0; i < lines; ++i) WRITES(mixed.payload()); }));
+
+    uint64_t report_lines = total / 40;
+    row("WRITEF report lines", report_lines * 40,
+        seconds([&] { for (uint64_t i = 0; i < report_lines; ++i) old_writef_line(100000 + i % 900000, field.payload()); }),
+        seconds([&] {
+            for (uint64_t i = 0; i < report_lines; ++i) {
+                WRITEF2(format.payload(), 100000 + i % 900000, (int64_t)field.payload());
+            }
+        }));
+
+    row("WRITEC characters", total,
+        seconds([&] { for (uint64_t i = 0; i < total; ++i) old_writec(i % 64 == 63 ? '\n' : 'a' + i % 26); }),
+        seconds([&] { for (uint64_t i = 0; i < total; ++i) WRITEC(i % 64 == 63 ? '\n' : 'a' + i % 26); }));
+    return 0;
+}
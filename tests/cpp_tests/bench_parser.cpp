@@ -0,0 +1,99 @@
+// Throughput benchmark for the Lexer and Parser.
+//
+// Generates a large BCPL program (many small functions with locals, loops,
+// labels, SWITCHON and calls; the statement forms that make the parser look
+// one token ahead) and reports tokens/second for lexing alone and
+// lines/second for a full parse, at several sizes. Throughput that drops
+// as the program grows means some step is not linear in the source size.
+//
+// Usage: bench_parser [max_megabytes]   (default 8)
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "../../Lexer.h"
+#include "../../Parser.h"
+
+static std::string generateProgram(size_t target_bytes, size_t& lines) {
+    std::ostringstream out;
+    lines = 0;
+    size_t f = 0;
+    while (static_cast<size_t>(out.tellp()) < target_bytes) {
+        out << "LET Fn" << f << "(a, b) = VALOF\n{\n"
+            << "    LET total = 0\n"
+            << "    LET x = a + " << f << "\n"
+            << "    LET y = b * 3\n"
+            << "    FOR i = 1 TO 10 DO\n    {\n"
+            << "        total := total + i * x\n"
+            << "        IF total > 1000 THEN total := total - y\n"
+            << "    }\n"
+            << "    x := x + 1\n"
+            << "    y := y - 1\n"
+            << "    L" << f << ": total := total + x\n"
+            << "    WHILE y > 100 DO y := y / 2\n"
+            << "    SWITCHON a REM 4 INTO\n    {\n"
+            << "        CASE 0: total := total + 1\n"
+            << "        CASE 1: total := total + 2\n"
+            << "        DEFAULT: total := total + 3\n"
+            << "    }\n"
+            << "    WRITEF(\"Fn" << f << " %N*N\", total)\n"
+            << "    RESULTIS total + Fn" << (f ? f - 1 : 0) << "(x, y)\n"
+            << "}\n\n";
+        lines += 23;
+        ++f;
+    }
+    out << "LET START() BE\n{\n    WRITEN(Fn0(1, 2))\n}\n";
+    lines += 4;
+    return out.str();
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_mb = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8;
+    if (max_mb == 0) max_mb = 1;
+
+    std::cout << "Lexer/Parser throughput" << std::endl;
+    std::cout << std::setw(8) << "MB" << std::setw(10) << "lines" << std::setw(12) << "tokens"
+              << std::setw(14) << "tokens/sec" << std::setw(12) << "parse ms"
+              << std::setw(14) << "lines/sec" << std::endl;
+
+    for (size_t mb = 1; mb <= max_mb; mb *= 2) {
+        size_t lines = 0;
+        std::string source = generateProgram(mb * 1024 * 1024, lines);
+
+        // Lexing alone
+        size_t tokens = 0;
+        auto lex_start = std::chrono::steady_clock::now();
+        {
+            Lexer lexer(source, false);
+            while (lexer.get_next_token().type != TokenType::Eof) ++tokens;
+        }
+        auto lex_end = std::chrono::steady_clock::now();
+
+        // Full parse (lexing included)
+        auto parse_start = std::chrono::steady_clock::now();
+        Lexer lexer(source, false);
+        Parser parser(lexer, false);
+        ProgramPtr program = parser.parse_program();
+        auto parse_end = std::chrono::steady_clock::now();
+
+        if (!program || !parser.getErrors().empty()) {
+            std::cerr << "Parse failed with " << parser.getErrors().size() << " error(s)" << std::endl;
+            return 1;
+        }
+
+        double lex_ms = std::chrono::duration<double, std::milli>(lex_end - lex_start).count();
+        double parse_ms = std::chrono::duration<double, std::milli>(parse_end - parse_start).count();
+        std::cout << std::setw(8) << mb << std::setw(10) << lines << std::setw(12) << tokens
+                  << std::setw(14) << std::fixed << std::setprecision(0)
+                  << (lex_ms > 0.0 ? tokens / (lex_ms / 1000.0) : 0.0)
+                  << std::setw(12) << std::setprecision(2) << parse_ms
+                  << std::setw(14) << std::setprecision(0)
+                  << (parse_ms > 0.0 ? lines / (parse_ms / 1000.0) : 0.0) << std::endl;
+
+        if (mb < max_mb && mb * 2 > max_mb) mb = max_mb / 2;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Throughput benchmark for PeepholeOptimizer::optimize().
+//
+// Generates a large, code-like instruction stream (loads, stores, moves,
+// compares, branches and labels, with some optimizable pairs mixed in)
+// and reports instructions/second for optimize() at several sizes, so a
+// pass that is not linear in the stream length shows up as falling
+// throughput as the size grows.
+//
+// Usage: bench_peephole_optimizer [max_instructions]   (default 400000)
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "../../PeepholeOptimizer.h"
+#include "../../InstructionStream.h"
+#include "../../LabelManager.h"
+
+static std::string xreg(int n) { return "X" + std::to_string(n); }
+
+// One "basic block" of about 20 instructions, a few of which match patterns.
+static void emitBlock(InstructionStream& stream, int block) {
+    std::string label = "L_bench_" + std::to_string(block);
+    std::string next_label = "L_bench_" + std::to_string(block + 1);
+    int r = 19 + (block % 8);
+
+    stream.define_label(label);
+    stream.add(Encoder::create_ldr_imm(xreg(r), "X29", 16 + 8 * (block % 4)));
+    stream.add(Encoder::create_mov_reg("X9", xreg(r)));              // load through scratch
+    stream.add(Encoder::create_add_imm("X10", "X9", block % 32 + 1));
+    stream.add(Encoder::create_mov_reg("X11", "X11"));               // self move
+    stream.add(Encoder::create_add_imm("X12", "X10", 0));            // identity add
+    stream.add(Encoder::create_str_imm("X12", "X29", 48));
+    stream.add(Encoder::create_ldr_imm("X12", "X29", 48));           // load after store
+    stream.add(Encoder::create_mul_reg("X13", "X12", "X10"));
+    stream.add(Encoder::create_sub_imm("X14", "X13", 3));
+    stream.add(Encoder::create_str_imm("X14", "X29", 56));
+    stream.add(Encoder::create_str_imm("X14", "X29", 56));           // redundant store
+    stream.add(Encoder::create_ldr_imm("X15", "X29", 64));
+    stream.add(Encoder::create_ldr_imm("X1", "X29", 72));
+    stream.add(Encoder::create_add_reg("X0", "X15", "X1"));
+    stream.add(Encoder::create_cmp_imm("X0", 0));
+    stream.add(Encoder::create_branch_conditional("EQ", next_label));
+    stream.add(Encoder::create_sub_imm("X0", "X0", 1));
+    stream.add(Encoder::create_mov_reg(xreg(r), "X0"));
+    stream.add(Encoder::create_branch_unconditional(next_label));
+}
+
+static size_t buildStream(InstructionStream& stream, size_t target) {
+    int block = 0;
+    while (stream.size() < target) {
+        emitBlock(stream, block++);
+    }
+    stream.define_label("L_bench_" + std::to_string(block));
+    return stream.size();
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_instructions = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 400000;
+
+    std::cout << "PeepholeOptimizer::optimize() throughput" << std::endl;
+    std::cout << std::setw(12) << "instrs" << std::setw(12) << "after"
+              << std::setw(10) << "rewrites" << std::setw(12) << "ms"
+              << std::setw(16) << "instrs/sec" << std::endl;
+
+    for (size_t size = max_instructions / 16; size <= max_instructions; size *= 2) {
+        InstructionStream stream(LabelManager::instance(), false);
+        size_t count = buildStream(stream, size);
+
+        PeepholeOptimizer optimizer(false);
+        auto start = std::chrono::steady_clock::now();
+        optimizer.optimize(stream);
+        auto end = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        double rate = ms > 0.0 ? count / (ms / 1000.0) : 0.0;
+        const auto& stats = optimizer.getStats();
+        std::cout << std::setw(12) << count << std::setw(12) << stats.total_instructions_after
+                  << std::setw(10) << stats.optimizations_applied
+                  << std::setw(12) << std::fixed << std::setprecision(2) << ms
+                  << std::setw(16) << std::setprecision(0) << rate << std::endl;
+        if (size == max_instructions) break;
+        if (size * 2 > max_instructions) size = max_instructions / 2;
+    }
+    return 0;
+}
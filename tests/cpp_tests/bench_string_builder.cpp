@@ -0,0 +1,124 @@
+// Benchmark for string builders against building a string by copying.
+//
+// Builds a report of N lines ("item <n>: <name>, ") the way BCPL programs
+// had to before SB_NEW: a fresh string holding the old contents plus the
+// next piece at every step, so the total copying grows with the square of
+// the length. The builder appends in place and copies once at SB_STRING.
+// Results go to stderr:
+//
+//   bench_string_builder [lines]      (default 5000)
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "../../runtime/runtime.h"
+#include "../../runtime/BCPLError.h"
+
+extern "C" {
+void* bcpl_alloc_chars(int64_t num_chars) {
+    uint64_t* block = static_cast<uint64_t*>(std::malloc(sizeof(uint64_t) + (num_chars + 1) * sizeof(uint32_t)));
+    block[0] = num_chars;
+    uint32_t* payload = reinterpret_cast<uint32_t*>(block + 1);
+    payload[num_chars] = 0;
+    return payload;
+}
+void* bcpl_alloc_words(int64_t num_words, const char*, const char*) {
+    uint64_t* block = static_cast<uint64_t*>(std::malloc(sizeof(uint64_t) * (num_words + 1)));
+    block[0] = num_words;
+    return block + 1;
+}
+void update_io_metrics_read(size_t) {}
+void update_io_metrics_write(size_t) {}
+void update_io_metrics_file_opened(void) {}
+void update_io_metrics_file_closed(void) {}
+void bcpl_free(void* ptr) { std::free(static_cast<uint64_t*>(ptr) - 1); }
+void _BCPL_SET_ERROR(BCPLErrorCode, const char*, const char*) {}
+}
+
+#include "../../runtime/runtime_core.inc"
+#include "../../runtime/runtime_string_utils.inc"
+#include "../../runtime/runtime_io.inc"
+#include "../../runtime/runtime_file_api.inc"
+
+static void free_string(uint32_t* s) {
+    uint64_t* base = reinterpret_cast<uint64_t*>(s) - 1;
+    bcpl_string_release_promoted(base);
+    std::free(base);
+}
+
+static uint32_t* wide_string(const std::string& ascii) {
+    uint32_t* s = static_cast<uint32_t*>(bcpl_alloc_chars(ascii.size()));
+    for (size_t i = 0; i < ascii.size(); ++i) s[i] = (unsigned char)ascii[i];
+    return s;
+}
+
+// The old way: a new string of both lengths, both copied in.
+static uint32_t* concat(uint32_t* a, uint32_t* b) {
+    size_t a_len = STRLEN(a), b_len = STRLEN(b);
+    uint32_t* s = static_cast<uint32_t*>(bcpl_alloc_chars(a_len + b_len));
+    std::memcpy(s, a, a_len * sizeof(uint32_t));
+    std::memcpy(s + a_len, b, b_len * sizeof(uint32_t));
+    return s;
+}
+
+template <typename Body>
+static double seconds(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000;
+    uint32_t* item = wide_string("item ");
+    uint32_t* colon = wide_string(": ");
+    uint32_t* name = wide_string("widget, ");
+
+    size_t copied_length = 0, built_length = 0;
+    double copying = seconds([&] {
+        uint32_t* report = wide_string("");
+        char digits[24];
+        for (uint64_t i = 0; i < lines; ++i) {
+            std::snprintf(digits, sizeof(digits), "%llu", (unsigned long long)i);
+            uint32_t* number = wide_string(digits);
+            for (uint32_t* piece : {item, number, colon, name}) {
+                uint32_t* next = concat(report, piece);
+                free_string(report);
+                report = next;
+            }
+            free_string(number);
+        }
+        copied_length = STRLEN(report);
+        free_string(report);
+    });
+    double building = seconds([&] {
+        uint32_t* sb = SB_NEW(0);
+        for (uint64_t i = 0; i < lines; ++i) {
+            SB_APPEND(sb, item);
+            SB_APPENDN(sb, (int64_t)i);
+            SB_APPEND(sb, colon);
+            SB_APPEND(sb, name);
+        }
+        uint32_t* report = SB_STRING(sb);
+        built_length = STRLEN(report);
+        free_string(report);
+        free_string(sb);
+    });
+    if (copied_length != built_length) {
+        std::cerr << "length mismatch: " << copied_length << " vs " << built_length << std::endl;
+        return 1;
+    }
+
+    std::cerr << "Report of " << lines << " lines, " << built_length << " characters" << std::endl;
+    std::cerr << std::left << std::setw(22) << "copy per append" << std::right << std::fixed
+              << std::setprecision(3) << std::setw(12) << copying * 1000 << " ms" << std::endl;
+    std::cerr << std::left << std::setw(22) << "string builder" << std::right << std::setw(12)
+              << building * 1000 << " ms" << std::setw(10) << std::setprecision(1) << copying / building << "x"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,201 @@
+// Microbenchmark for the BCPL string kernels (runtime/string_kernels.h).
+//
+// Times the loops STRLEN, STRCMP, STRCOPY and SPLIT ran before (walk the
+// UTF-32 code points to the terminator; try the delimiter at every
+// position) against the length-aware kernels, on heap-layout strings
+// (uint64 length prefix) of several lengths. The SPLIT and JOIN rows
+// tokenize a line of words and rebuild it, without the list allocation the
+// runtime adds on top. For whole programs see tests/bcl_tests/bench_strings.bcl.
+//
+// Usage: bench_string_kernels [max_length]   (default 65536)
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../runtime/string_kernels.h"
+
+// --- The loops the runtime used before ---
+
+static size_t scalar_strlen(const uint32_t* s) {
+    size_t len = 0;
+    while (s[len] != 0) len++;
+    return len;
+}
+
+static int64_t scalar_strcmp(const uint32_t* s1, const uint32_t* s2) {
+    size_t i = 0;
+    while (s1[i] == s2[i]) {
+        if (s1[i] == 0) return 0;
+        i++;
+    }
+    return (int64_t)s1[i] - (int64_t)s2[i];
+}
+
+static void scalar_strcopy(uint32_t* dst, const uint32_t* src) {
+    size_t i = 0;
+    while (src[i] != 0) {
+        dst[i] = src[i];
+        i++;
+    }
+    dst[i] = 0;
+}
+
+static bool scalar_match(const uint32_t* s, const uint32_t* delimiter, size_t delimiter_len) {
+    for (size_t i = 0; i < delimiter_len; ++i) {
+        if (s[i] != delimiter[i] || s[i] == 0) return false;
+    }
+    return true;
+}
+
+static size_t scalar_split(const uint32_t* source, const uint32_t* delimiter, std::vector<size_t>& tokens) {
+    size_t delimiter_len = scalar_strlen(delimiter);
+    const uint32_t* start = source;
+    const uint32_t* end = source;
+    while (*end != 0) {
+        if (scalar_match(end, delimiter, delimiter_len)) {
+            tokens.push_back(end - start);
+            start = end + delimiter_len;
+            end = start;
+        } else {
+            ++end;
+        }
+    }
+    tokens.push_back(end - start);
+    return tokens.size();
+}
+
+// --- The same operations with the kernels ---
+
+static size_t kernel_split(const uint32_t* source, const uint32_t* delimiter, std::vector<size_t>& tokens) {
+    size_t source_len = bcpl_string_length(source);
+    size_t delimiter_len = bcpl_string_length(delimiter);
+    size_t start = 0;
+    for (;;) {
+        size_t found = bcpl_string_find(source, source_len, delimiter, delimiter_len, start);
+        size_t end = found == BCPL_STRING_NOT_FOUND ? source_len : found;
+        tokens.push_back(end - start);
+        if (found == BCPL_STRING_NOT_FOUND) break;
+        start = found + delimiter_len;
+    }
+    return tokens.size();
+}
+
+// A heap-layout string: uint64 length, code points, terminator.
+struct HeapString {
+    std::vector<uint64_t> storage;
+    explicit HeapString(const std::u32string& text) : storage(2 + (text.size() + 2) / 2, 0) {
+        storage[0] = text.size();
+        std::memcpy(payload(), text.data(), text.size() * sizeof(uint32_t));
+    }
+    uint32_t* payload() { return reinterpret_cast<uint32_t*>(storage.data() + 1); }
+};
+
+template <typename Body>
+static double ns_per_call(size_t iterations, Body body) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) body();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+static volatile int64_t sink;
+
+static void row(const std::string& name, size_t length, double before, double after) {
+    std::cout << std::left << std::setw(10) << name << std::right << std::setw(10) << length
+              << std::setw(14) << std::fixed << std::setprecision(1) << before
+              << std::setw(14) << after << std::setw(10) << std::setprecision(1)
+              << (after > 0.0 ? before / after : 0.0) << "x" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_length = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 65536;
+    if (max_length < 16) max_length = 16;
+
+    std::cout << "BCPL string kernels (ns per call, scalar loop vs kernel)" << std::endl;
+    std::cout << std::left << std::setw(10) << "op" << std::right << std::setw(10) << "chars"
+              << std::setw(14) << "scalar ns" << std::setw(14) << "kernel ns" << std::setw(11) << "speedup"
+              << std::endl;
+
+    for (size_t length = 16; length <= max_length; length *= 4) {
+        // "the age of the train " repeated: words of 2-5 letters, a space between
+        std::u32string text;
+        const std::u32string phrase = U"the age of the train ";
+        while (text.size() < length) text += phrase;
+        text.resize(length);
+        HeapString a(text), b(text), c(text), dst(text);
+        HeapString delimiter(U" ");
+        size_t iterations = std::max<size_t>(200, (size_t(1) << 24) / length);
+
+        row("STRLEN", length,
+            ns_per_call(iterations, [&] { sink = scalar_strlen(a.payload()); }),
+            ns_per_call(iterations, [&] { sink = bcpl_string_length(a.payload()); }));
+        // A string the runtime built (a SPLIT token, a JOIN result, a
+        // literal): the prefix is the length
+        HeapString exact(text);
+        bcpl_string_set_exact_length(exact.payload(), length);
+        row("STRLEN/ex", length,
+            ns_per_call(iterations, [&] { sink = scalar_strlen(exact.payload()); }),
+            ns_per_call(iterations, [&] { sink = bcpl_string_length(exact.payload()); }));
+        row("STRCMP", length,
+            ns_per_call(iterations, [&] { sink = scalar_strcmp(a.payload(), b.payload()); }),
+            ns_per_call(iterations, [&] { sink = bcpl_string_compare_terminated(a.payload(), b.payload()); }));
+        // Strings that differ in their second character: STRCMP must not
+        // cost more than the two characters it looks at
+        c.payload()[1] = U'!';
+        row("STRCMP/2", length,
+            ns_per_call(iterations, [&] { sink = scalar_strcmp(a.payload(), c.payload()); }),
+            ns_per_call(iterations, [&] { sink = bcpl_string_compare_terminated(a.payload(), c.payload()); }));
+        row("STRCOPY", length,
+            ns_per_call(iterations, [&] { scalar_strcopy(dst.payload(), a.payload()); sink = dst.payload()[0]; }),
+            ns_per_call(iterations, [&] {
+                bcpl_string_copy(dst.payload(), a.payload(), bcpl_string_length(a.payload()));
+                sink = dst.payload()[0];
+            }));
+
+        std::vector<size_t> tokens;
+        tokens.reserve(length);
+        double split_before = ns_per_call(iterations / 4 + 1, [&] {
+            tokens.clear();
+            sink = scalar_split(a.payload(), delimiter.payload(), tokens);
+        });
+        double split_after = ns_per_call(iterations / 4 + 1, [&] {
+            tokens.clear();
+            sink = kernel_split(a.payload(), delimiter.payload(), tokens);
+        });
+        row("SPLIT", length, split_before, split_after);
+
+        // JOIN: every token's length is in its exact prefix, so each is one copy.
+        std::vector<HeapString> words;
+        for (size_t start = 0, i = 0; i < tokens.size(); ++i) {
+            words.emplace_back(text.substr(start, tokens[i]));
+            bcpl_string_set_exact_length(words.back().payload(), tokens[i]);
+            start += tokens[i] + 1;
+        }
+        std::vector<uint32_t> joined(length + 1);
+        double join_before = ns_per_call(iterations / 4 + 1, [&] {
+            uint32_t* cursor = joined.data();
+            for (auto& word : words) {
+                scalar_strcopy(cursor, word.payload());
+                cursor += scalar_strlen(cursor);
+                *cursor++ = ' ';
+            }
+            sink = cursor - joined.data();
+        });
+        double join_after = ns_per_call(iterations / 4 + 1, [&] {
+            uint32_t* cursor = joined.data();
+            for (auto& word : words) {
+                size_t len = bcpl_string_length(word.payload());
+                bcpl_string_copy(cursor, word.payload(), len);
+                cursor += len;
+                *cursor++ = ' ';
+            }
+            sink = cursor - joined.data();
+        });
+        row("JOIN", length, join_before, join_after);
+    }
+    return 0;
+}
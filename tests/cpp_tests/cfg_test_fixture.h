@@ -0,0 +1,91 @@
+// Shared fixture for the AST and CFG pass tests: factories for the AST
+// nodes the tests build by hand, and one function's CFG with the symbols the
+// passes look up, including FOR loops in the shape CFGBuilderPass gives them
+// (preheader ending in "i := start", a header holding the ForStatement, body
+// blocks and an increment block "i := i + step").
+
+#ifndef CFG_TEST_FIXTURE_H
+#define CFG_TEST_FIXTURE_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../../AST.h"
+#include "../../ControlFlowGraph.h"
+#include "../../SymbolTable.h"
+
+inline ExprPtr var(const std::string& name) { return std::make_unique<VariableAccess>(name); }
+inline ExprPtr num(int64_t value) { return std::make_unique<NumberLiteral>(value); }
+inline ExprPtr fnum(double value) { return std::make_unique<NumberLiteral>(value); }
+inline ExprPtr bin(BinaryOp::Operator op, ExprPtr left, ExprPtr right) {
+    return std::make_unique<BinaryOp>(op, std::move(left), std::move(right));
+}
+inline ExprPtr len(const std::string& name) {
+    return std::make_unique<UnaryOp>(UnaryOp::Operator::LengthOf, var(name));
+}
+
+inline StmtPtr assign(ExprPtr lhs, ExprPtr rhs) {
+    std::vector<ExprPtr> lhs_vec, rhs_vec;
+    lhs_vec.push_back(std::move(lhs));
+    rhs_vec.push_back(std::move(rhs));
+    return std::make_unique<AssignmentStatement>(std::move(lhs_vec), std::move(rhs_vec));
+}
+
+// One function's CFG and the symbols the passes look up
+struct CfgFunction {
+    using CfgMap = std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>;
+
+    std::string name = "F";
+    ControlFlowGraph cfg{"F"};
+    SymbolTable symbols;
+    BasicBlock* current;
+
+    CfgFunction() {
+        current = cfg.create_block("Entry_");
+        current->is_entry = true;
+    }
+
+    void declare(const std::string& variable, SymbolKind kind, VarType type) {
+        symbols.addSymbol(Symbol(variable, kind, type, 1, name));
+    }
+
+    // FOR variable = start TO end BY step DO body, where body fills the
+    // loop's first block and returns the block that falls into the increment
+    BasicBlock* for_loop(const std::string& variable, ExprPtr start, ExprPtr end, int64_t step,
+                         const std::function<BasicBlock*(BasicBlock*)>& body) {
+        declare(variable, SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        BasicBlock* preheader = current;
+        preheader->add_statement(assign(var(variable), std::move(start)));
+        BasicBlock* header = cfg.create_block("ForHeader_");
+        cfg.add_edge(preheader, header);
+        BasicBlock* body_block = cfg.create_block("ForBody_");
+        BasicBlock* increment = cfg.create_block("ForIncrement_");
+        BasicBlock* exit = cfg.create_block("ForExit_");
+        header->add_statement(std::make_unique<ForStatement>(variable, num(0), std::move(end), nullptr, num(step)));
+        header->is_loop_header = true;
+        header->loop_variable = variable;
+        cfg.add_edge(header, body_block);
+        cfg.add_edge(header, exit);
+        BasicBlock* last = body(body_block);
+        if (last) cfg.add_edge(last, increment);
+        increment->is_increment_block = true;
+        increment->loop_variable = variable;
+        increment->add_statement(assign(var(variable), bin(BinaryOp::Operator::Add, var(variable), num(step))));
+        cfg.add_edge(increment, header);
+        current = exit;
+        return preheader;
+    }
+
+    // Calls pass(cfgs) with the map the CFG builder would own, lending it
+    // this CFG for the duration of the call
+    void run(const std::function<void(CfgMap&)>& pass) {
+        CfgMap cfgs;
+        cfgs[name].reset(&cfg);
+        pass(cfgs);
+        cfgs[name].release();
+    }
+};
+
+#endif // CFG_TEST_FIXTURE_H
@@ -0,0 +1,237 @@
+// Shared fixture for the code generator tests: runs a BCPL source through
+// the same passes main.cpp does (without tracing, the caches or the JIT) and
+// returns the generated instructions, plus helpers for finding instructions
+// in them by their assembly text.
+//
+// The passes keep their state in singletons (ASTAnalyzer, LabelManager,
+// RegisterManager), so a test compiles one program per process; put every
+// case in its own function of that program.
+//
+// Link against the compiler's objects with main.cpp's main() left out.
+
+#ifndef CODEGEN_TEST_FIXTURE_H
+#define CODEGEN_TEST_FIXTURE_H
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../../AST.h"
+#include "../../AssemblerData.h"
+#include "../../CFGBuilderPass.h"
+#include "../../ClassPass.h"
+#include "../../ClassTable.h"
+#include "../../CodeBuffer.h"
+#include "../../ConstantFoldingPass.h"
+#include "../../DataGenerator.h"
+#include "../../InstructionStream.h"
+#include "../../LabelManager.h"
+#include "../../Lexer.h"
+#include "../../LivenessAnalysisPass.h"
+#include "../../LocalOptimizationPass.h"
+#include "../../NewCodeGenerator.h"
+#include "../../Parser.h"
+#include "../../RegisterManager.h"
+#include "../../RuntimeImporter.h"
+#include "../../StrengthReductionPass.h"
+#include "../../StringLiteralLiftingPass.h"
+#include "../../StringTable.h"
+#include "../../SymbolTable.h"
+#include "../../runtime_api.h"
+#include "../../analysis/ASTAnalyzer.h"
+#include "../../analysis/LinearScanAllocator.h"
+#include "../../analysis/LiveIntervalPass.h"
+#include "../../analysis/SignatureAnalysisVisitor.h"
+#include "../../analysis/SymbolDiscoveryPass.h"
+#include "../../passes/BoundsCheckEliminationPass.h"
+#include "../../passes/CFGSimplificationPass.h"
+#include "../../passes/GlobalInitializerPass.h"
+#include "../../passes/LoopVectorizationPass.h"
+#include "../../passes/ManifestResolutionPass.h"
+
+extern const char* g_source_code;
+extern std::unique_ptr<JITMemoryManager> g_jit_data_manager;
+
+struct CodegenOptions {
+    bool optimize = true;
+    bool bounds_checking = true;
+    bool neon = true;
+    bool fast_float_reductions = false;
+};
+
+// Empties the FOR loop bookkeeping the analyzer carries between passes, as
+// main.cpp does before each pass that walks FOR loops
+inline void clear_for_loop_state(ASTAnalyzer& analyzer) {
+    while (!analyzer.active_for_loop_scopes_.empty()) analyzer.active_for_loop_scopes_.pop();
+    analyzer.for_variable_unique_aliases_.clear();
+    while (!analyzer.loop_context_stack_.empty()) analyzer.loop_context_stack_.pop();
+}
+
+// Compiles `source` and returns its instructions before the peephole pass.
+// Throws std::runtime_error on a syntax or semantic error.
+inline std::vector<Instruction> compile_to_instructions(const std::string& source,
+                                                        const CodegenOptions& options = CodegenOptions()) {
+    static std::string source_text;
+    source_text = source;
+    g_source_code = source_text.c_str();
+
+    Lexer lexer(source_text, false);
+    Parser parser(lexer, false);
+    ProgramPtr ast = parser.parse_program();
+    if (!ast || !parser.getErrors().empty() || parser.hasFatalError()) {
+        throw std::runtime_error("syntax error: " + (parser.getErrors().empty() ? std::string("?") : parser.getErrors()[0]));
+    }
+
+    auto symbol_table = std::make_unique<SymbolTable>();
+    auto class_table = std::make_unique<ClassTable>();
+    initialize_runtime_system();
+    RuntimeImporter::import_all_runtime_functions(*symbol_table, false);
+    ClassPass class_pass(*class_table, *symbol_table);
+    class_pass.run(*ast);
+
+    static std::unordered_map<std::string, int64_t> manifests;
+    ManifestResolutionPass manifest_pass(manifests);
+    ast = manifest_pass.apply(std::move(ast));
+    GlobalInitializerPass global_init_pass;
+    global_init_pass.run(*ast);
+    SymbolDiscoveryPass symbol_discovery_pass(false);
+    symbol_discovery_pass.build_into(*ast, *symbol_table, *class_table);
+
+    StringTable string_table;
+    ASTAnalyzer& analyzer = ASTAnalyzer::getInstance();
+    if (options.optimize) {
+        ConstantFoldingPass constant_folding_pass(manifests, symbol_table.get(), false);
+        ast = constant_folding_pass.apply(std::move(ast));
+        clear_for_loop_state(analyzer);
+        StrengthReductionPass strength_reduction_pass(false);
+        strength_reduction_pass.run(*ast);
+    }
+
+    SignatureAnalysisVisitor signature_visitor(symbol_table.get(), analyzer, false);
+    signature_visitor.analyze_signatures(*ast);
+    clear_for_loop_state(analyzer);
+    analyzer.analyze(*ast, symbol_table.get(), class_table.get());
+    if (!analyzer.getSemanticErrors().empty()) {
+        throw std::runtime_error("semantic error: " + analyzer.getSemanticErrors()[0]);
+    }
+
+    StringLiteralLiftingPass string_lifting_pass(&string_table);
+    string_lifting_pass.run(*ast, *symbol_table, analyzer);
+    if (options.optimize) {
+        LocalOptimizationPass local_opt_pass(&string_table, false);
+        local_opt_pass.run(*ast, *symbol_table, analyzer);
+    }
+    clear_for_loop_state(analyzer);
+    analyzer.transform(*ast);
+
+    clear_for_loop_state(analyzer);
+    CFGBuilderPass cfg_builder(symbol_table.get(), false);
+    cfg_builder.build(*ast);
+    auto& cfgs = const_cast<std::unordered_map<std::string, std::unique_ptr<ControlFlowGraph>>&>(cfg_builder.get_cfgs());
+    if (options.optimize) {
+        CFGSimplificationPass cfg_simplification_pass(false);
+        cfg_simplification_pass.run(cfgs);
+        if (options.bounds_checking) {
+            BoundsCheckEliminationPass bounds_check_elimination_pass(symbol_table.get(), false);
+            bounds_check_elimination_pass.run(cfgs);
+        }
+        if (options.neon) {
+            LoopVectorizationPass loop_vectorization_pass(symbol_table.get(), options.bounds_checking, false,
+                                                          options.fast_float_reductions);
+            loop_vectorization_pass.run(cfgs);
+        }
+    }
+
+    LivenessAnalysisPass liveness(cfg_builder.get_cfgs(), symbol_table.get(), false);
+    liveness.run();
+    auto& function_metrics = analyzer.get_function_metrics_mut();
+    for (const auto& pair : liveness.calculate_register_pressure()) {
+        auto it = function_metrics.find(pair.first);
+        if (it != function_metrics.end()) it->second.max_live_variables = pair.second;
+    }
+
+    LiveIntervalPass interval_pass(symbol_table.get(), false);
+    interval_pass.runAll(cfg_builder.get_cfgs(), liveness, 1);
+    std::map<std::string, std::map<std::string, LiveInterval>> all_allocations;
+    for (const auto& pair : cfg_builder.get_cfgs()) {
+        LinearScanAllocator register_allocator(analyzer, false);
+        all_allocations[pair.first] = register_allocator.allocate(
+            interval_pass.getIntervalsFor(pair.first), RegisterManager::VARIABLE_REGS,
+            RegisterManager::FP_VARIABLE_REGS, pair.first);
+    }
+
+    InstructionStream instruction_stream(LabelManager::instance(), false);
+    DataGenerator data_generator(false, false);
+    data_generator.set_class_table(class_table.get());
+    data_generator.set_string_table(&string_table);
+    g_jit_data_manager = std::make_unique<JITMemoryManager>();
+    g_jit_data_manager->allocate(1024 * 1024);
+
+    NewCodeGenerator code_generator(
+        instruction_stream, RegisterManager::getInstance(), LabelManager::instance(), false, 0, data_generator,
+        reinterpret_cast<uint64_t>(g_jit_data_manager->getMemoryPointer()), cfg_builder, analyzer,
+        std::move(symbol_table), all_allocations, false, class_table.get(), liveness,
+        options.bounds_checking, options.neon);
+    code_generator.generate_code(*ast);
+    return instruction_stream.get_instructions();
+}
+
+// The assembly text of `instr`, lower-cased with runs of blanks squeezed to
+// one space, so "STR  D0, [X1, X2, LSL #3]" matches "str d0, [x1, x2, lsl #3]"
+inline std::string normalized_text(const Instruction& instr) {
+    std::string out;
+    for (char c : std::string(instr.assembly_text)) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            if (!out.empty() && out.back() != ' ') out += ' ';
+        } else {
+            out += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+    }
+    while (!out.empty() && out.back() == ' ') out.pop_back();
+    return out;
+}
+
+// The code of function `name`: the instructions from its entry label up to
+// and including the epilogue's RET
+inline std::vector<Instruction> function_body(const std::vector<Instruction>& code, const std::string& name) {
+    std::vector<Instruction> body;
+    bool inside = false;
+    for (const Instruction& instr : code) {
+        if (instr.is_label_definition && std::string(instr.target_label) == name) inside = true;
+        if (!inside || instr.segment != SegmentType::CODE) continue;
+        body.push_back(instr);
+        if (!instr.is_label_definition && normalized_text(instr) == "ret") break;
+    }
+    return body;
+}
+
+// Index of the first instruction at or after `from` whose normalized text
+// starts with `prefix` and contains every one of `parts`, or -1
+inline int find_instruction(const std::vector<Instruction>& code, const std::string& prefix,
+                            std::initializer_list<const char*> parts = {}, int from = 0) {
+    for (int i = std::max(from, 0); i < static_cast<int>(code.size()); ++i) {
+        if (code[i].is_label_definition) continue;
+        std::string text = normalized_text(code[i]);
+        if (text.compare(0, prefix.size(), prefix) != 0) continue;
+        bool all = std::all_of(parts.begin(), parts.end(), [&](const char* part) {
+            return text.find(part) != std::string::npos;
+        });
+        if (all) return i;
+    }
+    return -1;
+}
+
+// Index of the definition of a label whose name contains `part`, or -1
+inline int find_label(const std::vector<Instruction>& code, const std::string& part, int from = 0) {
+    for (int i = std::max(from, 0); i < static_cast<int>(code.size()); ++i) {
+        if (code[i].is_label_definition && std::string(code[i].target_label).find(part) != std::string::npos) return i;
+    }
+    return -1;
+}
+
+#endif // CODEGEN_TEST_FIXTURE_H
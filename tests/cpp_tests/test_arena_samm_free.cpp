@@ -0,0 +1,93 @@
+// Tests for explicit frees of SAMM-tracked slab arena blocks
+// (HeapManager::freeArenaBlock, forgetScopeEntries and the SAMM bit in
+// SlabArena).
+//
+// The thread cache hands a freed block straight back to the next allocation
+// of its size class. Checks that a scope exiting after free -> re-allocate
+// -> retain leaves the new owner's block alone, that a vector moved out of
+// the arena by resizeVec is the block its scope releases, and that a block
+// freed after its scope exited is released once, by the cleanup queue.
+//
+// Link against the HeapManager sources, SignalSafeUtils.cpp and
+// runtime/runtime_freelist.c.
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include "../../HeapManager/HeapManager.h"
+#include "../../HeapManager/SlabArena.h"
+#include "../../runtime/BCPLError.h"
+
+bool g_enable_heap_trace = false;
+
+void* resizeVec(void* payload, size_t newNumElements);
+
+static int g_errors = 0;
+extern "C" {
+void _BCPL_SET_ERROR(BCPLErrorCode, const char*, const char*) { g_errors++; }
+void embedded_fast_bcpl_free_chars(void*) {}
+}
+
+static bool arena_block_live(void* payload) {
+    AllocType type = ALLOC_FREE;
+    void* base = SlabArena::getInstance().blockFor(payload, &type);
+    return base != nullptr && type != ALLOC_FREE;
+}
+
+int main() {
+    HeapManager& hm = HeapManager::getInstance();
+    hm.setSAMMEnabled(true);
+    // Cleanup then runs on this thread, inside waitForSAMM()
+    hm.stopBackgroundWorker();
+
+    // --- free -> re-allocate -> retain -> scope exit ---
+    hm.enterScope();                       // outer
+    hm.enterScope();                       // inner
+    uint64_t* a = static_cast<uint64_t*>(hm.allocVec(4));
+    assert(SlabArena::getInstance().owns(a));
+    hm.free(a);
+    uint64_t* b = static_cast<uint64_t*>(hm.allocVec(4));
+    assert(b == a && "the thread cache reuses the freed block");
+    b[0] = 42;
+    hm.retainPointer(b - 1, 1);
+    hm.exitScope();                        // inner
+    hm.waitForSAMM();
+    assert(arena_block_live(b) && b[0] == 42);
+    assert(g_errors == 0);
+    hm.exitScope();                        // outer
+    hm.waitForSAMM();
+    assert(!arena_block_live(b) && "the outer scope releases the retained block");
+    assert(g_errors == 0);
+
+    // --- a vector moved out of the arena ---
+    hm.enterScope();                       // outer
+    hm.enterScope();                       // inner
+    uint64_t* v = static_cast<uint64_t*>(hm.allocVec(2));
+    uint64_t* moved = static_cast<uint64_t*>(resizeVec(v, 200));
+    assert(!SlabArena::getInstance().owns(moved));
+    uint64_t* w = static_cast<uint64_t*>(hm.allocVec(2));
+    assert(w == v && "the old arena block is reused");
+    w[0] = 7;
+    hm.retainPointer(w - 1, 1);
+    hm.exitScope();                        // inner: releases `moved`, not `w`
+    hm.waitForSAMM();
+    assert(arena_block_live(w) && w[0] == 7);
+    assert(g_errors == 0);
+    hm.exitScope();                        // outer
+    hm.waitForSAMM();
+    assert(!arena_block_live(w));
+    assert(g_errors == 0);
+
+    // --- free after the scope exited, before cleanup ran ---
+    hm.enterScope();
+    uint64_t* late = static_cast<uint64_t*>(hm.allocVec(4));
+    hm.exitScope();
+    hm.free(late);                         // deferred to the queued cleanup
+    assert(arena_block_live(late));
+    hm.waitForSAMM();
+    assert(!arena_block_live(late));
+    assert(g_errors == 0 && "released exactly once");
+
+    std::cout << "All arena SAMM free tests passed." << std::endl;
+    return 0;
+}
@@ -255,6 +255,8 @@ int main() {
     
     // Disable HeapManager tracing initially
     HeapManager::getInstance().setTraceEnabled(false);
+    // The Bloom filter is an opt-in diagnostic; this test exercises it
+    HeapManager_setBloomFilterEnabled(1);
     
     bool all_passed = true;
     
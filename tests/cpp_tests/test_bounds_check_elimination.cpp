@@ -0,0 +1,189 @@
+// Tests for BoundsCheckEliminationPass (passes/BoundsCheckEliminationPass.cpp).
+//
+// Builds FOR loops in the shape CFGBuilderPass gives them (see
+// cfg_test_fixture.h) and checks which vector reads lose their bounds check,
+// which are checked once in the preheader, and which keep it.
+
+#include <cassert>
+#include <iostream>
+#include "../../passes/BoundsCheckEliminationPass.h"
+#include "cfg_test_fixture.h"
+
+bool g_enable_symbols_trace = false;
+
+// "x := v!index", returning the read
+static VectorAccess* read_into(BasicBlock* block, const std::string& x, const std::string& v, ExprPtr index) {
+    auto access = std::make_unique<VectorAccess>(var(v), std::move(index));
+    VectorAccess* raw = access.get();
+    block->add_statement(assign(var(x), std::move(access)));
+    return raw;
+}
+
+static void run_pass(CfgFunction& f) {
+    f.run([&](CfgFunction::CfgMap& cfgs) {
+        BoundsCheckEliminationPass pass(&f.symbols, false);
+        pass.run(cfgs);
+    });
+}
+
+using Op = BinaryOp::Operator;
+
+int main() {
+    // --- FOR i = 0 TO LEN(v) - 1: every read is proven in range ---
+    {
+        CfgFunction f;
+        f.declare("v", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("x", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        VectorAccess *plain, *ahead, *behind, *past;
+        BasicBlock* preheader = f.for_loop("i", num(0), bin(Op::Subtract, len("v"), num(1)), 1, [&](BasicBlock* b) {
+            plain = read_into(b, "x", "v", var("i"));
+            behind = read_into(b, "x", "v", bin(Op::Subtract, var("i"), num(1))); // reads v!(-1) first
+            past = read_into(b, "x", "v", bin(Op::Add, var("i"), num(1)));      // reads v!LEN(v) last
+            return b;
+        });
+        BasicBlock* preheader2 = f.for_loop("j", num(1), bin(Op::Subtract, len("v"), num(2)), 3, [&](BasicBlock* b) {
+            ahead = read_into(b, "x", "v", bin(Op::Add, num(1), var("j")));
+            return b;
+        });
+        run_pass(f);
+        assert(plain->bounds_check_elided && "v!i for i = 0 TO LEN(v) - 1");
+        assert(ahead->bounds_check_elided && "v!(1 + j) for j = 1 TO LEN(v) - 2 BY 3");
+        // v!(i - 1) and v!(i + 1) can go out of range, but the limit is
+        // invariant and the step 1, so they are checked in the preheader
+        assert(past->bounds_check_elided && behind->bounds_check_elided && "v!(i - 1) and v!(i + 1) are covered");
+        assert(preheader->hoisted_bounds_checks.size() == 1 && "one guard for v");
+        if (preheader->hoisted_bounds_checks.size() == 1) {
+            const HoistedBoundsCheck& guard = preheader->hoisted_bounds_checks[0];
+            assert(guard.vector_name == "v" && guard.min_offset == -1 && guard.max_offset == 1 && guard.check_start && "guard covers v!(i - 1) .. v!(i + 1) and checks the start");
+            assert(preheader->hoisted_loop_variable == "i" && preheader->hoisted_loop_end != nullptr && "guard knows the loop variable and limit");
+        }
+        assert(preheader2->hoisted_bounds_checks.empty() && "no guard for a loop with every read proven");
+    }
+
+    // --- FOR i = 1 TO n - 2: a stencil, checked once before the loop ---
+    {
+        CfgFunction f;
+        f.declare("v", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("w", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("n", SymbolKind::PARAMETER, VarType::INTEGER);
+        f.declare("x", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        std::vector<VectorAccess*> reads;
+        BasicBlock* preheader = f.for_loop("i", num(1), bin(Op::Subtract, var("n"), num(2)), 1, [&](BasicBlock* b) {
+            for (int c = -1; c <= 1; ++c) {
+                reads.push_back(read_into(b, "x", "v", bin(Op::Add, var("i"), num(c))));
+            }
+            reads.push_back(read_into(b, "x", "w", var("i")));
+            return b;
+        });
+        run_pass(f);
+        bool all = true;
+        for (VectorAccess* read : reads) all = all && read->bounds_check_elided;
+        assert(all && "stencil reads are all covered");
+        assert(preheader->hoisted_bounds_checks.size() == 2 && "one guard per vector");
+        for (const HoistedBoundsCheck& guard : preheader->hoisted_bounds_checks) {
+            assert(!guard.check_start);
+        }
+    }
+
+    // --- Reads that must keep their checks ---
+    {
+        CfgFunction f;
+        f.declare("v", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("u", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("n", SymbolKind::PARAMETER, VarType::INTEGER);
+        f.declare("x", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        f.declare("c", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        VectorAccess *conditional, *after_call, *reassigned, *stepped, *changing_limit, *index_of_index;
+
+        // IF c THEN x := v!i
+        f.for_loop("i", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(std::make_unique<IfStatement>(var("c"), nullptr));
+            BasicBlock* then_block = f.cfg.create_block("Then_");
+            BasicBlock* join = f.cfg.create_block("Join_");
+            f.cfg.add_edge(b, then_block);
+            f.cfg.add_edge(b, join);
+            conditional = read_into(then_block, "x", "v", var("i"));
+            f.cfg.add_edge(then_block, join);
+            return join;
+        });
+        // x := v!i; WRITEN(x)
+        f.for_loop("j", num(0), var("n"), 1, [&](BasicBlock* b) {
+            after_call = read_into(b, "x", "v", var("j"));
+            std::vector<ExprPtr> args;
+            args.push_back(var("x"));
+            b->add_statement(std::make_unique<RoutineCallStatement>(var("WRITEN"), std::move(args)));
+            return b;
+        });
+        // x := u!k; u := v
+        f.for_loop("k", num(0), bin(Op::Subtract, len("u"), num(1)), 1, [&](BasicBlock* b) {
+            reassigned = read_into(b, "x", "u", var("k"));
+            b->add_statement(assign(var("u"), var("v")));
+            return b;
+        });
+        // FOR m = 0 TO n BY 2: the last index need not be n
+        f.for_loop("m", num(0), var("n"), 2, [&](BasicBlock* b) {
+            stepped = read_into(b, "x", "v", var("m"));
+            return b;
+        });
+        // FOR p = 0 TO c DO $( x := v!p; c := c - 1 $)
+        f.for_loop("p", num(0), var("c"), 1, [&](BasicBlock* b) {
+            changing_limit = read_into(b, "x", "v", var("p"));
+            b->add_statement(assign(var("c"), bin(Op::Subtract, var("c"), num(1))));
+            return b;
+        });
+        // x := v!(v!q)
+        f.for_loop("q", num(0), bin(Op::Subtract, len("v"), num(1)), 1, [&](BasicBlock* b) {
+            auto inner = std::make_unique<VectorAccess>(var("v"), var("q"));
+            index_of_index = read_into(b, "x", "v", std::move(inner));
+            return b;
+        });
+        run_pass(f);
+        assert(!conditional->bounds_check_elided && "a read under IF keeps its check");
+        assert(!after_call->bounds_check_elided && "a loop with a call keeps its checks");
+        assert(!reassigned->bounds_check_elided && "a vector reassigned in the loop keeps its check");
+        assert(!stepped->bounds_check_elided && "a stepped loop to n keeps its check");
+        assert(!changing_limit->bounds_check_elided && "a loop whose limit changes keeps its check");
+        assert(!index_of_index->bounds_check_elided && "v!(v!q) keeps its check");
+    }
+
+    // --- Taking a vector's address anywhere in the function keeps its checks ---
+    {
+        CfgFunction f;
+        f.declare("v", SymbolKind::LOCAL_VAR, VarType::POINTER_TO_INT_VEC);
+        f.declare("p", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        f.declare("x", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        f.current->add_statement(assign(var("p"), std::make_unique<UnaryOp>(UnaryOp::Operator::AddressOf, var("v"))));
+        VectorAccess* read;
+        f.for_loop("i", num(0), bin(Op::Subtract, len("v"), num(1)), 1, [&](BasicBlock* b) {
+            read = read_into(b, "x", "v", var("i"));
+            return b;
+        });
+        run_pass(f);
+        assert(!read->bounds_check_elided && "@v keeps the checks on v");
+    }
+
+    // --- Globals can change behind the loop's back ---
+    {
+        CfgFunction f;
+        f.declare("g", SymbolKind::GLOBAL_VAR, VarType::POINTER_TO_INT_VEC);
+        f.declare("x", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        VectorAccess* read;
+        f.for_loop("i", num(0), bin(Op::Subtract, len("g"), num(1)), 1, [&](BasicBlock* b) {
+            read = read_into(b, "x", "g", var("i"));
+            return b;
+        });
+        run_pass(f);
+        assert(!read->bounds_check_elided && "a global vector keeps its checks");
+    }
+
+    // --- The flag survives cloning ---
+    {
+        VectorAccess access(var("v"), var("i"));
+        access.bounds_check_elided = true;
+        auto copy = access.clone();
+        assert(static_cast<VectorAccess*>(copy.get())->bounds_check_elided && "clone keeps bounds_check_elided");
+    }
+
+    std::cout << "All bounds check elimination tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,337 @@
+// Tests for compact strings (runtime/string_class.h and --compact-strings).
+//
+// Checks the Latin-1 kernels against plain loops, that the file input
+// functions choose the storage class from the text they read, that
+// promotion leaves a string forwarding to an equal UTF-32 copy, and that
+// STRLEN, STRCMP, STRCOPY, WRITES, FILE_WRITES and SPIT treat every class
+// alike.
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../../runtime/runtime.h"
+#include "../../runtime/BCPLError.h"
+
+// The runtime's allocator and metrics hooks, reduced to what the file API needs.
+extern "C" {
+void* bcpl_alloc_chars(int64_t num_chars) {
+    uint64_t* block = static_cast<uint64_t*>(std::malloc(sizeof(uint64_t) + (num_chars + 1) * sizeof(uint32_t)));
+    block[0] = num_chars;
+    uint32_t* payload = reinterpret_cast<uint32_t*>(block + 1);
+    payload[num_chars] = 0;
+    return payload;
+}
+void update_io_metrics_read(size_t) {}
+void update_io_metrics_write(size_t) {}
+void update_io_metrics_file_opened(void) {}
+void update_io_metrics_file_closed(void) {}
+void bcpl_free(void* ptr) { std::free(static_cast<uint64_t*>(ptr) - 1); }
+void _BCPL_SET_ERROR(BCPLErrorCode, const char*, const char*) {}
+}
+
+#include "../../runtime/runtime_core.inc"
+#include "../../runtime/runtime_file_api.inc"
+#include "../../runtime/runtime_io.inc"
+
+// The characters of a string of any class.
+static std::vector<uint32_t> chars_of(const uint32_t* s) {
+    std::vector<uint32_t> out;
+    if (!s) return out;
+    size_t len = bcpl_string_any_length(s);
+    for (size_t i = 0; i < len; ++i) out.push_back(bcpl_string_char_at(s, i));
+    return out;
+}
+
+static std::vector<uint32_t> codepoints(const std::u32string& text) {
+    return std::vector<uint32_t>(text.begin(), text.end());
+}
+
+static uint32_t* wide_string(const std::vector<uint32_t>& chars) {
+    uint32_t* s = static_cast<uint32_t*>(bcpl_alloc_chars(chars.size()));
+    for (size_t i = 0; i < chars.size(); ++i) s[i] = chars[i];
+    return s;
+}
+
+static uint32_t* compact_string(const std::string& latin1) {
+    uint32_t* s = bcpl_alloc_compact_chars(latin1.size());
+    std::memcpy(s, latin1.data(), latin1.size());
+    return s;
+}
+
+static void free_string(uint32_t* s) {
+    uint64_t* base = reinterpret_cast<uint64_t*>(s) - 1;
+    bcpl_string_release_promoted(base);
+    std::free(base);
+}
+
+static void write_file(const std::string& path, const std::string& bytes) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), f);
+    std::fclose(f);
+}
+
+static std::string read_file(const std::string& path) {
+    std::string bytes;
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return bytes;
+    char buffer[4096];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), f)) > 0) bytes.append(buffer, n);
+    std::fclose(f);
+    return bytes;
+}
+
+// What WRITES prints for a string, captured through a temporary file.
+static std::string captured_writes(uint32_t* s) {
+    bcpl_output_flush();
+    std::fflush(stdout);
+    FILE* capture = std::tmpfile();
+    int saved = dup(STDOUT_FILENO);
+    dup2(fileno(capture), STDOUT_FILENO);
+    WRITES(s);
+    bcpl_output_flush();
+    std::fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    std::string bytes;
+    std::rewind(capture);
+    char buffer[4096];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), capture)) > 0) bytes.append(buffer, n);
+    std::fclose(capture);
+    return bytes;
+}
+
+static int sign(int64_t v) { return (v > 0) - (v < 0); }
+
+int main() {
+    std::mt19937 rng(18);
+    bcpl_set_compact_strings(1);
+
+    // --- Kernels against plain loops ---
+    for (int trial = 0; trial < 2000; ++trial) {
+        size_t n = rng() % 70;
+        bool ascii = trial % 3 == 0;
+        std::vector<uint8_t> bytes(n + 1);
+        for (size_t i = 0; i < n; ++i) bytes[i] = static_cast<uint8_t>(ascii ? rng() % 0x80 : rng() % 0x100);
+        std::vector<uint32_t> wide(n + 1, 0xDEAD);
+        bcpl_latin1_widen(bytes.data(), n, wide.data());
+        bool widened = wide[n] == 0xDEAD;
+        for (size_t i = 0; i < n; ++i) widened = widened && wide[i] == bytes[i];
+        assert(widened);
+
+        std::vector<uint8_t> narrow(n + 1, 0xAA);
+        size_t narrowed = bcpl_latin1_narrow(wide.data(), n, narrow.data());
+        assert(narrowed == n && std::memcmp(narrow.data(), bytes.data(), n) == 0);
+        if (n > 0) {
+            size_t at = rng() % n;
+            wide[at] = 0x100 + rng() % 0x10000;
+            narrowed = bcpl_latin1_narrow(wide.data(), n, narrow.data());
+            assert(narrowed == at);
+        }
+
+        size_t prefix = 0;
+        while (prefix < n && bytes[prefix] < 0x80) ++prefix;
+        assert(bcpl_latin1_ascii_prefix(bytes.data(), n) == prefix);
+
+        std::string expected;
+        for (size_t i = 0; i < n; ++i) {
+            uint8_t b = bytes[i];
+            if (b < 0x80) {
+                expected += static_cast<char>(b);
+            } else {
+                expected += static_cast<char>(0xC0 | (b >> 6));
+                expected += static_cast<char>(0x80 | (b & 0x3F));
+            }
+        }
+        std::vector<unsigned char> utf8(2 * n + 1);
+        size_t utf8_len = bcpl_latin1_to_utf8(bytes.data(), n, utf8.data());
+        assert(std::string(utf8.begin(), utf8.begin() + utf8_len) == expected);
+
+        size_t count = 0;
+        bool latin1 = bcpl_utf8_is_latin1(reinterpret_cast<const unsigned char*>(expected.data()), expected.size(), &count);
+        assert(latin1 && count == n);
+        std::vector<uint8_t> decoded(n + 1);
+        size_t decoded_len = bcpl_utf8_decode_latin1(reinterpret_cast<const unsigned char*>(expected.data()),
+                                                     expected.size(), decoded.data());
+        assert(decoded_len == n && std::memcmp(decoded.data(), bytes.data(), n) == 0);
+    }
+    {
+        size_t count = 0;
+        const unsigned char euro[] = "price: \xE2\x82\xAC" "5";
+        const unsigned char truncated[] = "caf\xC3";
+        bool euro_latin1 = bcpl_utf8_is_latin1(euro, sizeof(euro) - 1, &count);
+        bool truncated_latin1 = bcpl_utf8_is_latin1(truncated, sizeof(truncated) - 1, &count);
+        assert(!euro_latin1 && "euro sign is not Latin-1");
+        assert(!truncated_latin1 && "truncated sequence is not Latin-1");
+        const std::string text = "abcabcabd";
+        const uint8_t* h = reinterpret_cast<const uint8_t*>(text.data());
+        assert(bcpl_compact_find(h, text.size(), reinterpret_cast<const uint8_t*>("abd"), 3, 0) == 6 && "find");
+        assert(bcpl_compact_find(h, text.size(), reinterpret_cast<const uint8_t*>("abc"), 3, 1) == 3 && "find from");
+        assert(bcpl_compact_find(h, text.size(), reinterpret_cast<const uint8_t*>("abe"), 3, 0) == BCPL_STRING_NOT_FOUND && "find missing");
+    }
+
+    // --- Storage classes and promotion ---
+    {
+        uint32_t* s = compact_string("caf\xE9 au lait");
+        assert(bcpl_string_class(s) == BCPL_STRING_CLASS_COMPACT && "compact class");
+        assert(STRLEN(s) == 12 && "compact STRLEN");
+        assert(chars_of(s) == codepoints(U"café au lait") && "compact characters");
+        uint32_t* empty = compact_string("");
+        assert(bcpl_string_class(empty) == BCPL_STRING_CLASS_COMPACT && STRLEN(empty) == 0 && "empty compact string");
+
+        uint32_t* wide = BCPL_STRING_PROMOTE(s);
+        assert(bcpl_string_class(s) == BCPL_STRING_CLASS_PROMOTED && "promoted class");
+        assert(bcpl_string_forward(s) == wide && bcpl_string_class(wide) == BCPL_STRING_CLASS_UTF32 && "forward pointer");
+        uint32_t* again = BCPL_STRING_PROMOTE(s);
+        assert(again == wide && "promoting twice gives the same copy");
+        assert(chars_of(s) == codepoints(U"café au lait") && STRLEN(wide) == 12 && "promoted characters");
+        wide[3] = 0x20AC;
+        assert(chars_of(s) == codepoints(U"caf€ au lait") && "store through the forward pointer");
+
+        uint32_t* utf32 = wide_string(codepoints(U"plain"));
+        uint32_t* not_promoted = BCPL_STRING_PROMOTE(utf32);
+        assert(not_promoted == utf32 && "UTF-32 strings are not promoted");
+        free_string(s);
+        free_string(utf32);
+    }
+
+    // --- STRCMP and STRCOPY across classes ---
+    {
+        const std::u32string words[] = {U"", U"a", U"abc", U"abd", U"ab", U"été", U"étés", U"zz"};
+        for (const auto& x : words) {
+            for (const auto& y : words) {
+                std::string xl(x.begin(), x.end()), yl(y.begin(), y.end());
+                uint32_t* wx = wide_string(codepoints(x));
+                uint32_t* wy = wide_string(codepoints(y));
+                uint32_t* cx = compact_string(xl);
+                uint32_t* cy = compact_string(yl);
+                uint32_t* px = compact_string(xl);
+                BCPL_STRING_PROMOTE(px);
+                // Every class gives the same difference of code points
+                int64_t expected = STRCMP(wx, wy);
+                assert(sign(expected) == sign(int64_t(x.compare(y))));
+                assert(STRCMP(cx, cy) == expected);
+                assert(STRCMP(cx, wy) == expected);
+                assert(STRCMP(wx, cy) == expected);
+                assert(STRCMP(px, cy) == expected);
+                free_string(wx);
+                free_string(wy);
+                free_string(cx);
+                free_string(cy);
+                free_string(px);
+            }
+        }
+
+        uint32_t* dst = compact_string("xxxxxxxxxxxxxxxxxxxx");
+        STRCOPY(dst, compact_string("short"));
+        assert(bcpl_string_class(dst) == BCPL_STRING_CLASS_COMPACT && chars_of(dst) == codepoints(U"short") && "compact to compact STRCOPY");
+        assert(STRLEN(dst) == 5 && "the copy's terminator ends a longer compact buffer");
+        STRCOPY(dst, wide_string(codepoints(U"naïve")));
+        assert(bcpl_string_class(dst) == BCPL_STRING_CLASS_COMPACT && chars_of(dst) == codepoints(U"naïve") && "Latin-1 UTF-32 into compact STRCOPY");
+        STRCOPY(dst, wide_string(codepoints(U"€1")));
+        assert(bcpl_string_class(dst) == BCPL_STRING_CLASS_PROMOTED && chars_of(dst) == codepoints(U"€1") && "wide text into compact STRCOPY promotes");
+        STRCOPY(dst, compact_string("back"));
+        assert(chars_of(dst) == codepoints(U"back") && "compact into promoted STRCOPY");
+
+        uint32_t* wide_dst = wide_string(codepoints(U"............"));
+        STRCOPY(wide_dst, compact_string("gr\xFC\xDF"));
+        assert(bcpl_string_class(wide_dst) == BCPL_STRING_CLASS_UTF32 && chars_of(wide_dst) == codepoints(U"grüß") && "compact into UTF-32 STRCOPY");
+
+        // An exact length survives a copy that fills it, and only that
+        uint32_t* exact = wide_string(codepoints(U"twelve chars"));
+        bcpl_string_set_exact_length(exact, 12);
+        STRCOPY(exact, wide_string(codepoints(U"twelve CHARS")));
+        size_t len = 0;
+        assert(bcpl_string_exact_length(exact, &len) && len == 12 && STRLEN(exact) == 12);
+        STRCOPY(exact, compact_string("six ch"));
+        assert(!bcpl_string_exact_length(exact, &len) && STRLEN(exact) == 6 && "a shorter copy clears the mark");
+        assert(bcpl_string_class(exact) == BCPL_STRING_CLASS_UTF32 && bcpl_string_tagged_length(exact) == 12);
+    }
+
+    // --- WRITES ---
+    {
+        std::string written = captured_writes(compact_string("caf\xE9*Nnext"));
+        assert(written == "caf\xC3\xA9\nnext" && "WRITES compact with escape");
+        std::string long_text;
+        for (int i = 0; i < 5000; ++i) long_text += static_cast<char>(i % 7 == 0 ? 0xE9 : 'a' + i % 26);
+        std::string expected;
+        for (unsigned char c : long_text) {
+            if (c < 0x80) {
+                expected += static_cast<char>(c);
+            } else {
+                expected += "\xC3\xA9";
+            }
+        }
+        uint32_t* s = compact_string(long_text);
+        written = captured_writes(s);
+        assert(written == expected && "WRITES long compact string");
+        BCPL_STRING_PROMOTE(s);
+        written = captured_writes(s);
+        assert(written == expected && "WRITES promoted string");
+    }
+
+    // --- File input chooses the class; output round-trips ---
+    char path_template[] = "/tmp/bcpl_compact_strings_XXXXXX";
+    int fd = mkstemp(path_template);
+    close(fd);
+    std::string path = path_template;
+    uint32_t* path_str = compact_string(path);
+    {
+        std::string text = "na\xC3\xAFve caf\xC3\xA9\nsecond line\r\n\nlast";
+        write_file(path, text);
+        uint32_t* slurped = SLURP(path_str);
+        assert(bcpl_string_class(slurped) == BCPL_STRING_CLASS_COMPACT && "SLURP Latin-1 is compact");
+        assert(chars_of(slurped) == codepoints(U"naïve café\nsecond line\r\n\nlast") && "SLURP Latin-1 text");
+
+        uintptr_t handle = FILE_OPEN_READ(path_str);
+        uint32_t* line = FILE_READLINE(handle);
+        assert(bcpl_string_class(line) == BCPL_STRING_CLASS_COMPACT && chars_of(line) == codepoints(U"naïve café") && "FILE_READLINE Latin-1");
+        uint32_t* rest = FILE_READS(handle);
+        assert(bcpl_string_class(rest) == BCPL_STRING_CLASS_COMPACT &&
+                  chars_of(rest) == codepoints(U"second line\r\n\nlast") && "FILE_READS Latin-1");
+        FILE_CLOSE(handle);
+
+        handle = FILE_OPEN_WRITE(path_str);
+        FILE_WRITES(handle, slurped);
+        FILE_CLOSE(handle);
+        assert(read_file(path) == text && "FILE_WRITES compact round trip");
+        BCPL_STRING_PROMOTE(slurped);
+        SPIT(slurped, path_str);
+        assert(read_file(path) == text && "SPIT promoted round trip");
+    }
+    {
+        std::string text = "one \xE2\x82\xAC and \xC3\xA9";
+        write_file(path, text);
+        uint32_t* slurped = SLURP(path_str);
+        assert(bcpl_string_class(slurped) == BCPL_STRING_CLASS_UTF32 && chars_of(slurped) == codepoints(U"one € and é") && "SLURP wide text is UTF-32");
+        uintptr_t handle = FILE_OPEN_READ(path_str);
+        uint32_t* read = FILE_READS(handle);
+        assert(bcpl_string_class(read) == BCPL_STRING_CLASS_UTF32 && "FILE_READS wide text is UTF-32");
+        FILE_CLOSE(handle);
+        SPIT(compact_string("x\xFFy"), path_str);
+        assert(read_file(path) == "x\xC3\xBFy" && "SPIT compact");
+    }
+    {
+        bcpl_set_compact_strings(0);
+        write_file(path, "plain ascii");
+        uint32_t* slurped = SLURP(path_str);
+        assert(bcpl_string_class(slurped) == BCPL_STRING_CLASS_UTF32 && "SLURP without the flag is UTF-32");
+        uintptr_t handle = FILE_OPEN_READ(path_str);
+        uint32_t* line = FILE_READLINE(handle);
+        assert(bcpl_string_class(line) == BCPL_STRING_CLASS_UTF32 && "FILE_READLINE without the flag is UTF-32");
+        FILE_CLOSE(handle);
+        bcpl_set_compact_strings(1);
+    }
+    std::remove(path.c_str());
+
+    std::cout << "All compact string tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,132 @@
+// Round-trip test for the on-disk compilation cache.
+//
+// Stores a small unlinked instruction stream, loads it back and checks that
+// every field the Linker and AssemblyWriter read survives, that the JIT data
+// pool base load (X28) is rebased, and that stale, damaged or colliding
+// entries miss.
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include "../../CompilationCache.h"
+
+static Instruction move_wide_x28(bool keep, uint16_t imm16, int shift) {
+    uint32_t base = keep ? 0xF2800000 : 0xD2800000; // MOVK / MOVZ, 64-bit
+    Instruction instr(base | (static_cast<uint32_t>(shift / 16) << 21) | (static_cast<uint32_t>(imm16) << 5) | 28,
+                      keep ? "MOVK X28" : "MOVZ X28");
+    instr.jit_attribute = JITAttribute::JitAddress;
+    return instr;
+}
+
+int main() {
+    char dir_template[] = "/tmp/nbcpl_cache_test_XXXXXX";
+    const char* dir = mkdtemp(dir_template);
+    if (!dir) {
+        std::cout << "Could not create a temporary directory" << std::endl;
+        return 1;
+    }
+    CompilationCache cache(dir);
+
+    // --- Keys ---
+    CompilationCache::Key key = CompilationCache::make_key("LET START() BE WRITES(\"hi\")", "jit=1");
+    assert(key.id.size() == 32 && "key is 128 bits of hex");
+    assert(key.id == CompilationCache::make_key("LET START() BE WRITES(\"hi\")", "jit=1").id && "key is deterministic");
+    assert(key.id != CompilationCache::make_key("LET START() BE WRITES(\"ho\")", "jit=1").id && "source changes the key");
+    assert(key.id != CompilationCache::make_key("LET START() BE WRITES(\"hi\")", "jit=0").id && "flags change the key");
+    assert(key.material.find("jit=1") != std::string::npos && key.material.find("WRITES(\"hi\")") != std::string::npos &&
+           "the material holds the flags and the source");
+
+    // --- A small program: code, a veneer call, rodata and data ---
+    const uint64_t old_base = 0x0000000123450000ULL;
+    std::vector<Instruction> program;
+    program.push_back(Instruction::as_label("START", SegmentType::CODE));
+    program.push_back(move_wide_x28(false, old_base & 0xFFFF, 0));
+    program.push_back(move_wide_x28(true, (old_base >> 16) & 0xFFFF, 16));
+    program.push_back(move_wide_x28(true, (old_base >> 32) & 0xFFFF, 32));
+    program.push_back(move_wide_x28(true, (old_base >> 48) & 0xFFFF, 48));
+    program.push_back(Instruction(0x94000000, "BL WRITES_veneer", RelocationType::PC_RELATIVE_26_BIT_OFFSET,
+                                  "WRITES_veneer", false));
+    program.push_back(Instruction(0xD65F03C0, "RET"));
+    program.back().nopeep = true;
+    program.push_back(Instruction::as_label("L_str0", SegmentType::RODATA));
+    program.push_back(Instruction(0x00000068, ".long 0x68", RelocationType::NONE, "", true));
+    program.back().segment = SegmentType::RODATA;
+    program.push_back(Instruction::as_relocatable_data("L_str0", SegmentType::DATA));
+    std::unordered_map<std::string, std::string> veneers = { { "WRITES", "WRITES_veneer" } };
+
+    CompilationCache::Entry missing;
+    bool hit = cache.load(key, missing);
+    assert(!hit && "empty cache misses");
+    bool stored = cache.store(key, program, veneers);
+    assert(stored && "store succeeds");
+
+    CompilationCache::Entry entry;
+    hit = cache.load(key, entry);
+    assert(hit && "stored entry hits");
+    assert(entry.instructions.size() == program.size() && "instruction count");
+    for (size_t i = 0; i < program.size() && i < entry.instructions.size(); ++i) {
+        const Instruction& a = program[i];
+        const Instruction& b = entry.instructions[i];
+        assert(a.encoding == b.encoding);
+        assert(a.relocation == b.relocation);
+        assert(a.segment == b.segment);
+        assert(a.jit_attribute == b.jit_attribute);
+        assert(a.is_data_value == b.is_data_value);
+        assert(a.is_label_definition == b.is_label_definition);
+        assert(a.nopeep == b.nopeep);
+        assert(a.assembly_text == b.assembly_text);
+        assert(a.target_label == b.target_label);
+    }
+    assert(entry.veneer_labels == veneers && "veneer labels");
+    assert(entry.data_base_loads.size() == 4 && "X28 loads recorded as data base fixups");
+
+    // --- Rebasing onto a new data pool ---
+    const uint64_t new_base = 0x00000001ABCD0000ULL;
+    entry.set_data_base(new_base);
+    uint64_t loaded = 0;
+    for (size_t index : entry.data_base_loads) {
+        uint32_t encoding = entry.instructions[index].encoding;
+        assert((encoding & 0x1F) == 28 && "rebased instruction still targets X28");
+        loaded |= static_cast<uint64_t>((encoding >> 5) & 0xFFFF) << (((encoding >> 21) & 0x3) * 16);
+    }
+    assert(loaded == new_base && "X28 sequence loads the new pool base");
+
+    // --- Entries that must miss ---
+    CompilationCache::Key other_key = CompilationCache::make_key("other", "jit=1");
+    std::string path = std::string(dir) + "/" + key.id + ".jitc";
+    std::string renamed = std::string(dir) + "/" + other_key.id + ".jitc";
+    int renamed_status = std::rename(path.c_str(), renamed.c_str());
+    assert(renamed_status == 0 && "rename entry");
+    hit = cache.load(other_key, missing);
+    assert(!hit && "entry stored under another key misses");
+
+    // A hash collision: another program stored under this key's file name
+    CompilationCache::Key colliding = other_key;
+    colliding.id = key.id;
+    stored = cache.store(colliding, program, veneers);
+    assert(stored && "store the colliding entry");
+    hit = cache.load(key, missing);
+    assert(!hit && "an entry whose key material differs misses despite the same hash");
+
+    stored = cache.store(key, program, veneers);
+    assert(stored && "store again");
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size() / 2));
+    }
+    hit = cache.load(key, missing);
+    assert(!hit && "truncated entry misses");
+
+    std::remove(path.c_str());
+    std::remove(renamed.c_str());
+    rmdir(dir);
+
+    std::cout << "All compilation cache tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,126 @@
+// Tests for class-hierarchy devirtualization: ClassTable::unique_method_target
+// and DevirtualizationPass (passes/DevirtualizationPass.cpp).
+//
+// Builds a small hierarchy by hand, then one function's CFG holding method
+// calls on receivers the pass can and cannot pin to a single class.
+
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../passes/DevirtualizationPass.h"
+#include "../../ClassTable.h"
+#include "cfg_test_fixture.h"
+
+bool g_enable_symbols_trace = false;
+
+static ExprPtr make_new(const std::string& class_name) {
+    return std::make_unique<NewExpression>(class_name, std::vector<ExprPtr>{});
+}
+static ExprPtr address_of(const std::string& name) {
+    return std::make_unique<UnaryOp>(UnaryOp::Operator::AddressOf, var(name));
+}
+
+// receiver.method(), returning the callee so the test can read its annotation
+static MemberAccessExpression* call(BasicBlock* block, ExprPtr receiver, const std::string& method) {
+    auto callee = std::make_unique<MemberAccessExpression>(std::move(receiver), method);
+    MemberAccessExpression* raw = callee.get();
+    block->add_statement(std::make_unique<RoutineCallStatement>(std::move(callee), std::vector<ExprPtr>{}));
+    return raw;
+}
+
+static void add_method(ClassTableEntry* entry, const std::string& name, size_t slot) {
+    ClassMethodInfo info;
+    info.name = name;
+    info.qualified_name = entry->name + "::" + name;
+    info.vtable_slot = slot;
+    info.type = FunctionType::STANDARD;
+    info.is_virtual = true;
+    entry->add_member_method(info);
+    if (entry->vtable_blueprint.size() <= slot) entry->vtable_blueprint.resize(slot + 1);
+    entry->vtable_blueprint[slot] = info.qualified_name;
+}
+
+// Shape has area and name; Circle overrides area; Square overrides nothing
+static void build_hierarchy(ClassTable& classes) {
+    classes.add_class("Shape");
+    add_method(classes.get_class("Shape"), "area", 0);
+    add_method(classes.get_class("Shape"), "name", 1);
+    for (const std::string& child : {"Circle", "Square"}) {
+        classes.add_class(child, "Shape");
+        classes.get_class(child)->vtable_blueprint = classes.get_class("Shape")->vtable_blueprint;
+    }
+    add_method(classes.get_class("Circle"), "area", 0);
+}
+
+static void run_pass(CfgFunction& f, ClassTable& classes) {
+    f.run([&](CfgFunction::CfgMap& cfgs) {
+        DevirtualizationPass pass(&f.symbols, &classes, false);
+        pass.run(cfgs);
+    });
+}
+
+int main() {
+    ClassTable classes;
+    build_hierarchy(classes);
+
+    // --- Class hierarchy analysis ---
+    assert(classes.unique_method_target("Shape", 0).empty() && "Circle overrides Shape::area");
+    assert(classes.unique_method_target("Shape", 1) == "Shape::name" && "nothing overrides Shape::name");
+    assert(classes.unique_method_target("Circle", 0) == "Circle::area" && "Circle has no subclasses");
+    assert(classes.unique_method_target("Square", 0) == "Shape::area" && "Square inherits Shape::area");
+    assert(classes.unique_method_target("Shape", 2).empty() && "slot past the vtable");
+    assert(classes.unique_method_target("Triangle", 0).empty() && "unknown class");
+
+    // --- Receivers the pass pins to one class ---
+    {
+        CfgFunction f;
+        f.declare("c", SymbolKind::LOCAL_VAR, VarType::POINTER_TO_OBJECT);
+        f.declare("s", SymbolKind::LOCAL_VAR, VarType::POINTER_TO_OBJECT);
+        f.declare("q", SymbolKind::LOCAL_VAR, VarType::POINTER_TO_OBJECT);
+        f.declare("p", SymbolKind::PARAMETER, VarType::POINTER_TO_OBJECT);
+        f.declare("g", SymbolKind::GLOBAL_VAR, VarType::POINTER_TO_OBJECT);
+
+        // LET c = NEW Circle; c := NEW Circle
+        f.current->add_statement(assign(var("c"), make_new("Circle")));
+        f.current->add_statement(assign(var("c"), make_new("Circle")));
+        // s holds a Shape and then a Circle
+        f.current->add_statement(assign(var("s"), make_new("Shape")));
+        f.current->add_statement(assign(var("s"), make_new("Circle")));
+        // q escapes through @q
+        f.current->add_statement(assign(var("q"), make_new("Circle")));
+        f.current->add_statement(assign(var("g"), address_of("q")));
+        f.current->add_statement(assign(var("g"), make_new("Square")));
+
+        MemberAccessExpression* on_c = call(f.current, var("c"), "area");
+        MemberAccessExpression* on_s = call(f.current, var("s"), "area");
+        MemberAccessExpression* on_q = call(f.current, var("q"), "area");
+        MemberAccessExpression* on_p = call(f.current, var("p"), "area");
+        MemberAccessExpression* on_g = call(f.current, var("g"), "area");
+        MemberAccessExpression* on_new = call(f.current, make_new("Square"), "area");
+        run_pass(f, classes);
+
+        assert(on_c->exact_class_name == "Circle" && "local only ever assigned NEW Circle");
+        assert(on_s->exact_class_name.empty() && "local assigned two classes");
+        assert(on_q->exact_class_name.empty() && "local whose address is taken");
+        assert(on_p->exact_class_name.empty() && "parameter");
+        assert(on_g->exact_class_name.empty() && "global");
+        assert(on_new->exact_class_name == "Square" && "NEW receiver");
+    }
+
+    // --- A function the walk does not understand is left alone ---
+    {
+        CfgFunction f;
+        f.declare("c", SymbolKind::LOCAL_VAR, VarType::POINTER_TO_OBJECT);
+        f.declare("x", SymbolKind::LOCAL_VAR, VarType::POINTER_TO_OBJECT);
+        f.current->add_statement(assign(var("c"), make_new("Circle")));
+        f.current->add_statement(assign(var("x"), std::make_unique<ValofExpression>(nullptr)));
+        MemberAccessExpression* on_c = call(f.current, var("c"), "area");
+        run_pass(f, classes);
+        assert(on_c->exact_class_name.empty() && "opaque function is skipped");
+    }
+
+    std::cout << "All devirtualization tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Tests for cleanup_freelists() in runtime/runtime_freelist.c.
+//
+// Checks that cleanup is refused while another thread holds a magazine,
+// that it runs once that thread has exited, and that the freelist serves
+// nodes again afterwards.
+//
+// Build with runtime/runtime_freelist.c compiled as C.
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <condition_variable>
+#include <mutex>
+#include "../../runtime/BCPLError.h"
+#include "../../runtime/runtime_freelist.h"
+
+// The runtime's error and SAMM hooks, reduced to what the freelist needs.
+static int g_errors = 0;
+static const char* g_last_error_func = nullptr;
+extern "C" {
+void _BCPL_SET_ERROR(BCPLErrorCode, const char* func, const char*) {
+    g_errors++;
+    g_last_error_func = func;
+}
+int HeapManager_isSAMMEnabled(void) { return 0; }
+void HeapManager_trackFreelistAllocation(void*) {}
+size_t freelist_node_count(void);
+}
+
+int main() {
+    // --- The caller's own magazine does not block cleanup ---
+    ListAtom* node = getNodeFromFreelist();
+    assert(node != nullptr);
+    returnNodeToFreelist(node);
+    cleanup_freelists();
+    assert(g_errors == 0);
+
+    // --- Another thread's magazine does ---
+    std::mutex m;
+    std::condition_variable cv;
+    bool holding = false, release = false;
+    std::thread worker([&] {
+        ListAtom* n = getNodeFromFreelist();
+        returnNodeToFreelist(n);
+        std::unique_lock<std::mutex> lock(m);
+        holding = true;
+        cv.notify_all();
+        cv.wait(lock, [&] { return release; });
+    });
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&] { return holding; });
+    }
+    cleanup_freelists();
+    assert(g_errors == 1 && std::strcmp(g_last_error_func, "cleanup_freelists") == 0);
+    // The refused cleanup left the freelist usable
+    node = getNodeFromFreelist();
+    assert(node != nullptr);
+    returnNodeToFreelist(node);
+
+    {
+        std::lock_guard<std::mutex> lock(m);
+        release = true;
+    }
+    cv.notify_all();
+    worker.join();
+
+    // --- Once the worker has exited, cleanup runs ---
+    cleanup_freelists();
+    assert(g_errors == 1);
+    assert(freelist_node_count() == 0);
+
+    // --- And the freelist starts again afterwards ---
+    node = getNodeFromFreelist();
+    assert(node != nullptr);
+    node->value.int_value = 42;
+    returnNodeToFreelist(node);
+    cleanup_freelists();
+    assert(g_errors == 1);
+
+    std::cout << "All freelist cleanup tests passed." << std::endl;
+    return 0;
+}
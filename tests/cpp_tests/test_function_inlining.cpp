@@ -0,0 +1,267 @@
+// Tests for the cost-model function inliner (passes/FunctionInliningPass.cpp).
+//
+// Each case builds a small program by hand, in the shape the parser gives
+// it (a block's LET is a declaration plus an assignment), runs the pass, and
+// checks which calls were substituted, inlined as statements, or kept.
+
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../passes/FunctionInliningPass.h"
+#include "cfg_test_fixture.h"
+
+bool g_enable_symbols_trace = false;
+
+static std::vector<ExprPtr> args(ExprPtr a) {
+    std::vector<ExprPtr> result;
+    result.push_back(std::move(a));
+    return result;
+}
+static std::vector<ExprPtr> args(ExprPtr a, ExprPtr b) {
+    std::vector<ExprPtr> result = args(std::move(a));
+    result.push_back(std::move(b));
+    return result;
+}
+
+static ExprPtr call(const std::string& name, std::vector<ExprPtr> arguments) {
+    return std::make_unique<FunctionCall>(var(name), std::move(arguments));
+}
+static StmtPtr call_stmt(const std::string& name, std::vector<ExprPtr> arguments) {
+    return std::make_unique<RoutineCallStatement>(var(name), std::move(arguments));
+}
+
+static StmtPtr resultis(ExprPtr value) { return std::make_unique<ResultisStatement>(std::move(value)); }
+static StmtPtr if_then(ExprPtr condition, StmtPtr then_branch) {
+    return std::make_unique<IfStatement>(std::move(condition), std::move(then_branch));
+}
+
+// { LET <locals>; <statements> }
+static StmtPtr block(const std::vector<std::string>& locals, std::vector<StmtPtr> statements) {
+    std::vector<DeclPtr> declarations;
+    if (!locals.empty()) {
+        declarations.push_back(std::make_unique<LetDeclaration>(locals, std::vector<ExprPtr>{}));
+    }
+    return std::make_unique<BlockStatement>(std::move(declarations), std::move(statements));
+}
+
+template <typename... Stmts>
+static std::vector<StmtPtr> stmts(Stmts... items) {
+    std::vector<StmtPtr> result;
+    (result.push_back(std::move(items)), ...);
+    return result;
+}
+
+static ExprPtr valof(StmtPtr body) { return std::make_unique<ValofExpression>(std::move(body)); }
+
+static DeclPtr function(const std::string& name, std::vector<std::string> params, ExprPtr body) {
+    return std::make_unique<FunctionDeclaration>(name, std::move(params), std::move(body));
+}
+static DeclPtr routine(const std::string& name, std::vector<std::string> params, StmtPtr body) {
+    return std::make_unique<RoutineDeclaration>(name, std::move(params), std::move(body));
+}
+
+static BlockStatement* body_of(Program& program, const std::string& name) {
+    for (auto& decl : program.declarations) {
+        if (auto* r = dynamic_cast<RoutineDeclaration*>(decl.get())) {
+            if (r->name == name) return dynamic_cast<BlockStatement*>(r->body.get());
+        }
+        if (auto* f = dynamic_cast<FunctionDeclaration*>(decl.get())) {
+            auto* v = dynamic_cast<ValofExpression*>(f->body.get());
+            if (f->name == name && v) return dynamic_cast<BlockStatement*>(v->body.get());
+        }
+    }
+    return nullptr;
+}
+
+static bool declares(const BlockStatement* block, const std::string& name) {
+    for (const auto& decl : block->declarations) {
+        if (auto* let = dynamic_cast<LetDeclaration*>(decl.get())) {
+            for (const auto& n : let->names) {
+                if (n == name) return true;
+            }
+        }
+    }
+    return false;
+}
+
+struct Run {
+    std::unordered_map<std::string, int64_t> manifests;
+    SymbolTable symbols;
+    ProgramPtr program = std::make_unique<Program>();
+    FunctionInliningPass::Statistics stats;
+
+    void run() {
+        FunctionInliningPass pass(manifests, &symbols, ASTAnalyzer::getInstance(), false);
+        program = pass.apply(std::move(program));
+        stats = pass.statistics();
+    }
+};
+
+int main() {
+    using Op = BinaryOp::Operator;
+
+    // --- A call-free expression function is substituted in place ---
+    {
+        Run r;
+        // LET sq(x) = x * x
+        r.program->declarations.push_back(function("sq", {"x"}, bin(Op::Multiply, var("x"), var("x"))));
+        // LET start() BE { LET a = 0; FOR i = 1 TO 10 DO a := a + sq(i) }
+        auto loop = std::make_unique<ForStatement>("i", num(1), num(10),
+                                                   assign(var("a"), bin(Op::Add, var("a"), call("sq", args(var("i"))))));
+        r.program->declarations.push_back(routine("start", {}, block({"a"}, stmts(assign(var("a"), num(0)), std::move(loop)))));
+        r.run();
+
+        assert(r.stats.candidates == 2 && "sq and start are candidates");
+        assert(r.stats.calls_substituted == 1 && "sq(i) substituted");
+        auto* loop_stmt = dynamic_cast<ForStatement*>(body_of(*r.program, "start")->statements[1].get());
+        auto* sum = dynamic_cast<AssignmentStatement*>(loop_stmt->body.get());
+        auto* add = dynamic_cast<BinaryOp*>(sum->rhs[0].get());
+        auto* product = dynamic_cast<BinaryOp*>(add->right.get());
+        assert(product && product->op == Op::Multiply && "a + sq(i) became a + i * i");
+        auto* left = product ? dynamic_cast<VariableAccess*>(product->left.get()) : nullptr;
+        assert(left && left->name == "i" && "parameter replaced by the argument");
+    }
+
+    // --- A guarded VALOF is inlined as statements with renamed parameters ---
+    {
+        Run r;
+        // LET clamp(v, lo) = VALOF { IF v < lo RESULTIS lo; RESULTIS v }
+        r.program->declarations.push_back(function("clamp", {"v", "lo"},
+            valof(block({}, stmts(if_then(bin(Op::Less, var("v"), var("lo")), resultis(var("lo"))),
+                                  resultis(var("v")))))));
+        // LET start() BE { LET y = 5; y := clamp(y - 9, 0) }
+        r.program->declarations.push_back(routine("start", {}, block({"y"}, stmts(
+            assign(var("y"), num(5)),
+            assign(var("y"), call("clamp", args(bin(Op::Subtract, var("y"), num(9)), num(0))))))));
+        r.run();
+
+        assert(r.stats.calls_inlined == 1 && "clamp inlined as statements");
+        BlockStatement* start = body_of(*r.program, "start");
+        auto* inlined = dynamic_cast<CompoundStatement*>(start->statements[1].get());
+        assert(inlined != nullptr && "call replaced by a compound statement");
+        assert(declares(start, "_inl0_v") && declares(start, "_inl0_lo") && "renamed parameters declared in the caller");
+        if (inlined) {
+            assert(inlined->statements.size() == 3 && "two parameter assignments and the lowered body");
+            auto* guard = dynamic_cast<TestStatement*>(inlined->statements.back().get());
+            assert(guard != nullptr && "IF ... RESULTIS; RESULTIS became TEST");
+            auto* then_arm = guard ? dynamic_cast<CompoundStatement*>(guard->then_branch.get()) : nullptr;
+            auto* store = then_arm ? dynamic_cast<AssignmentStatement*>(then_arm->statements[0].get()) : nullptr;
+            auto* target = store ? dynamic_cast<VariableAccess*>(store->lhs[0].get()) : nullptr;
+            auto* value = store ? dynamic_cast<VariableAccess*>(store->rhs[0].get()) : nullptr;
+            assert(target && target->name == "y" && value && value->name == "_inl0_lo" && "RESULTIS lo became y := _inl0_lo");
+        }
+    }
+
+    // --- RESULTIS f(...) stays a RESULTIS of the caller; a routine's RETURN is dropped ---
+    {
+        Run r;
+        // LET twice(n) = VALOF { LET t = n + n; RESULTIS t }
+        r.program->declarations.push_back(function("twice", {"n"},
+            valof(block({"t"}, stmts(assign(var("t"), bin(Op::Add, var("n"), var("n"))), resultis(var("t")))))));
+        // LET bump(v) BE { IF v = 0 RETURN; total := total + v }
+        r.program->declarations.push_back(routine("bump", {"v"}, block({}, stmts(
+            if_then(bin(Op::Equal, var("v"), num(0)), std::make_unique<ReturnStatement>()),
+            assign(var("total"), bin(Op::Add, var("total"), var("v")))))));
+        // LET f(k) = VALOF { bump(k); RESULTIS twice(k) }
+        r.program->declarations.push_back(function("f", {"k"},
+            valof(block({}, stmts(call_stmt("bump", args(var("k"))), resultis(call("twice", args(var("k")))))))));
+        r.run();
+
+        assert(r.stats.calls_inlined == 2 && "bump and twice inlined");
+        BlockStatement* f = body_of(*r.program, "f");
+        assert(declares(f, "_inl1_t") && "callee local renamed and declared in the caller");
+        auto* bumped = dynamic_cast<CompoundStatement*>(f->statements[0].get());
+        auto* guard = bumped ? dynamic_cast<TestStatement*>(bumped->statements.back().get()) : nullptr;
+        auto* returned = guard ? dynamic_cast<CompoundStatement*>(guard->then_branch.get()) : nullptr;
+        assert(returned && returned->statements.empty() && "IF v = 0 RETURN ends the inlined routine");
+        auto* doubled = dynamic_cast<CompoundStatement*>(f->statements[1].get());
+        assert(doubled && dynamic_cast<ResultisStatement*>(doubled->statements.back().get()) && "RESULTIS twice(k) ends in a RESULTIS");
+    }
+
+    // --- A VALOF inside an expression body takes the declarations itself ---
+    {
+        Run r;
+        // LET clamp(v, lo) = VALOF { IF v < lo RESULTIS lo; RESULTIS v }
+        r.program->declarations.push_back(function("clamp", {"v", "lo"},
+            valof(block({}, stmts(if_then(bin(Op::Less, var("v"), var("lo")), resultis(var("lo"))),
+                                  resultis(var("v")))))));
+        // LET g(x) = x + VALOF { LET y = 0; y := clamp(x, 0); RESULTIS y }
+        r.program->declarations.push_back(function("g", {"x"}, bin(Op::Add, var("x"), valof(block({"y"}, stmts(
+            assign(var("y"), num(0)),
+            assign(var("y"), call("clamp", args(var("x"), num(0)))),
+            resultis(var("y"))))))));
+        r.run();
+
+        assert(r.stats.calls_inlined == 1 && "clamp inlined inside the nested VALOF");
+        FunctionDeclaration* g = nullptr;
+        for (auto& decl : r.program->declarations) {
+            if (auto* f = dynamic_cast<FunctionDeclaration*>(decl.get())) {
+                if (f->name == "g") g = f;
+            }
+        }
+        auto* sum = g ? dynamic_cast<BinaryOp*>(g->body.get()) : nullptr;
+        auto* nested = sum ? dynamic_cast<ValofExpression*>(sum->right.get()) : nullptr;
+        auto* nested_block = nested ? dynamic_cast<BlockStatement*>(nested->body.get()) : nullptr;
+        assert(nested_block && declares(nested_block, "_inl0_v") && declares(nested_block, "_inl0_lo") && "renamed parameters declared in the nested VALOF's block");
+    }
+
+    // --- Functions the pass leaves alone ---
+    {
+        Run r;
+        // LET fib(n) = n < 2 -> n, fib(n - 1) + fib(n - 2)
+        r.program->declarations.push_back(function("fib", {"n"},
+            std::make_unique<ConditionalExpression>(bin(Op::Less, var("n"), num(2)), var("n"),
+                bin(Op::Add, call("fib", args(bin(Op::Subtract, var("n"), num(1)))),
+                             call("fib", args(bin(Op::Subtract, var("n"), num(2))))))));
+        // LET find(v, n) = VALOF { FOR i = 0 TO n DO IF v!i = 0 RESULTIS i; RESULTIS -1 }
+        auto scan = std::make_unique<ForStatement>("i", num(0), var("n"),
+            if_then(bin(Op::Equal, std::make_unique<VectorAccess>(var("v"), var("i")), num(0)), resultis(var("i"))));
+        r.program->declarations.push_back(function("find", {"v", "n"},
+            valof(block({}, stmts(std::move(scan), resultis(num(-1)))))));
+        // LET half(x) = x * 0.5
+        r.program->declarations.push_back(function("half", {"x"},
+            bin(Op::Multiply, var("x"), std::make_unique<NumberLiteral>(0.5))));
+        // LET scaled(x) = x * g, with g a local of the caller
+        r.program->declarations.push_back(function("scaled", {"x"}, bin(Op::Multiply, var("x"), var("g"))));
+        r.program->declarations.push_back(routine("start", {}, block({"g", "r"}, stmts(
+            assign(var("g"), num(3)),
+            assign(var("r"), call("scaled", args(num(2))))))));
+        r.run();
+
+        assert(r.stats.candidates == 2 && "fib, find and half are not candidates (recursive, RESULTIS in a loop, float)");
+        assert(r.stats.calls_substituted == 0 && r.stats.calls_inlined == 0 && "local g would capture the global g");
+        auto* kept = dynamic_cast<AssignmentStatement*>(body_of(*r.program, "start")->statements[1].get());
+        assert(kept && dynamic_cast<FunctionCall*>(kept->rhs[0].get()) && "scaled(2) is still a call");
+    }
+
+    // --- Cost model: a medium body is inlined in a loop but not at a third straight-line site ---
+    {
+        Run r;
+        // LET mix(a, b) = VALOF { LET t = a * 31 + b; t := t NEQV (t >> 7); t := t + (t << 3); RESULTIS t REM 1000 }
+        r.program->declarations.push_back(function("mix", {"a", "b"}, valof(block({"t"}, stmts(
+            assign(var("t"), bin(Op::Add, bin(Op::Multiply, var("a"), num(31)), var("b"))),
+            assign(var("t"), bin(Op::NotEquivalence, var("t"), bin(Op::RightShift, var("t"), num(7)))),
+            assign(var("t"), bin(Op::Add, var("t"), bin(Op::LeftShift, var("t"), num(3)))),
+            resultis(bin(Op::Remainder, var("t"), num(1000))))))));
+        // LET start() BE { LET h = 0; h := mix(h, 1); h := mix(h, 2); h := mix(h, 3);
+        //                  FOR i = 1 TO 100 DO h := mix(h, i) }
+        auto loop = std::make_unique<ForStatement>("i", num(1), num(100), assign(var("h"), call("mix", args(var("h"), var("i")))));
+        r.program->declarations.push_back(routine("start", {}, block({"h"}, stmts(
+            assign(var("h"), num(0)),
+            assign(var("h"), call("mix", args(var("h"), num(1)))),
+            assign(var("h"), call("mix", args(var("h"), num(2)))),
+            assign(var("h"), call("mix", args(var("h"), num(3)))),
+            std::move(loop)))));
+        r.run();
+
+        assert(r.stats.calls_inlined == 1 && "only the call in the loop is inlined");
+        assert(r.stats.calls_rejected == 3 && "three straight-line calls kept");
+        auto* loop_stmt = dynamic_cast<ForStatement*>(body_of(*r.program, "start")->statements[4].get());
+        assert(loop_stmt && dynamic_cast<CompoundStatement*>(loop_stmt->body.get()) && "loop body is the inlined mix");
+    }
+
+    std::cout << "All function inlining tests passed." << std::endl;
+    return 0;
+}
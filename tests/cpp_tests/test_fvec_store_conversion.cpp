@@ -0,0 +1,97 @@
+// Tests for integer values stored into FVEC elements
+// (generators/gen_AssignmentStatement.cpp and gen_VectorAccess.cpp).
+//
+// An FVEC element holds a double, so an integer stored into one, through
+// v#%i or v!i, must be converted with SCVTF and stored from a D register
+// with STR D [base, index, LSL #3]. Storing the X register's bits would
+// leave an integer bit pattern that reads back as a tiny denormal. A float
+// value needs no conversion.
+
+#include <cassert>
+#include <iostream>
+#include "codegen_test_fixture.h"
+
+static const char* kSource = R"BCPL(
+LET fvec_int_literal(v, i) BE
+$(
+  v#%i := 3
+$)
+
+LET fvec_int_variable(v, i, n) BE
+$(
+  v#%i := n + 1
+$)
+
+LET fvec_float_value(v, i) BE
+$(
+  v#%i := 2.5
+$)
+
+LET fvec_bang_int(i, n) BE
+$(
+  LET w = FVEC 8
+  w!i := n
+$)
+
+LET START() BE
+$(
+  LET v = FVEC 8
+  fvec_int_literal(v, 1)
+  fvec_int_variable(v, 2, 7)
+  fvec_float_value(v, 3)
+  fvec_bang_int(4, 9)
+$)
+)BCPL";
+
+// Index of the scaled D-register store in `code`, or -1
+static int scaled_fp_store(const std::vector<Instruction>& code) {
+    return find_instruction(code, "str d", { "lsl #3" });
+}
+
+// True if the store at `store` is fed by an SCVTF into the register it stores
+static bool converted_before(const std::vector<Instruction>& code, int store) {
+    if (store < 0) return false;
+    std::string stored = normalized_text(code[store]).substr(4, 3); // "dN," or "dNN"
+    stored = stored.substr(0, stored.find(','));
+    int convert = find_instruction(code, "scvtf " + stored + ",");
+    return convert >= 0 && convert < store;
+}
+
+int main() {
+    std::vector<Instruction> code = compile_to_instructions(kSource);
+
+    // --- v#%i := 3 ---
+    {
+        std::vector<Instruction> f = function_body(code, "fvec_int_literal");
+        int store = scaled_fp_store(f);
+        assert(store >= 0 && "v#%i stores from a D register, scaled by 8");
+        assert(converted_before(f, store) && "the integer literal is converted with SCVTF first");
+    }
+
+    // --- v#%i := n + 1 ---
+    {
+        std::vector<Instruction> f = function_body(code, "fvec_int_variable");
+        int store = scaled_fp_store(f);
+        assert(store >= 0 && "v#%i stores from a D register, scaled by 8");
+        assert(converted_before(f, store) && "the integer expression is converted with SCVTF first");
+    }
+
+    // --- v#%i := 2.5 ---
+    {
+        std::vector<Instruction> f = function_body(code, "fvec_float_value");
+        assert(scaled_fp_store(f) >= 0 && "a float value is stored from a D register");
+        assert(find_instruction(f, "scvtf") < 0 && "a float value is not converted");
+    }
+
+    // --- w!i := n on an FVEC ---
+    {
+        std::vector<Instruction> f = function_body(code, "fvec_bang_int");
+        int store = scaled_fp_store(f);
+        assert(store >= 0 && "w!i on an FVEC stores from a D register, scaled by 8");
+        assert(converted_before(f, store) && "the integer is converted with SCVTF first");
+        assert(find_instruction(f, "str x", { "lsl #3" }) < 0 && "the integer bits are never stored directly");
+    }
+
+    std::cout << "All FVEC store conversion tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,77 @@
+// Tests for InternedString (InternedString.h).
+//
+// Checks that equal text interns to the same pooled string, that values
+// behave like the std::string they stand for, and that threads interning
+// the same names at once all get the same pooled string, with one pool
+// entry per distinct name.
+
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "../../InternedString.h"
+
+int main() {
+    // --- Identity ---
+    {
+        size_t before = InternedString::pool_size();
+        InternedString a("L_loop_head");
+        InternedString b(std::string("L_loop") + "_head");
+        InternedString c("L_loop_exit");
+        assert(&a.str() == &b.str() && "equal text shares one pooled string");
+        assert(a == b && a != c);
+        assert(InternedString::pool_size() == before + 2 && "one entry per distinct string");
+        assert(std::hash<InternedString>()(a) == std::hash<InternedString>()(b));
+
+        InternedString empty, also_empty(""), null_text(static_cast<const char*>(nullptr));
+        assert(empty.empty() && &empty.str() == &also_empty.str() && &empty.str() == &null_text.str());
+        assert(InternedString::pool_size() == before + 2 && "the empty string is not pooled");
+    }
+
+    // --- Reads like a std::string ---
+    {
+        InternedString text("    ADD X0, X1, X2");
+        const std::string& view = text;
+        assert(view == "    ADD X0, X1, X2");
+        assert(text.find("X1") == 12 && text.substr(4, 3) == "ADD" && text.back() == '2');
+        assert(text + " ; sum" == "    ADD X0, X1, X2 ; sum");
+
+        InternedString label("L_");
+        const std::string* old = &label.str();
+        label += "42";
+        assert(label == "L_42" && &label.str() == &InternedString("L_42").str() && "+= interns the result");
+        assert(*old == "L_" && "the old string stays pooled");
+    }
+
+    // --- Concurrent interning ---
+    {
+        const size_t threads = 8, names = 2000;
+        size_t before = InternedString::pool_size();
+        std::vector<std::vector<const std::string*>> seen(threads, std::vector<const std::string*>(names));
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                // Each thread walks the names in a different order
+                for (size_t k = 0; k < names; ++k) {
+                    size_t i = (k * 7 + t * 131) % names;
+                    seen[t][i] = &InternedString("L_thread_name_" + std::to_string(i)).str();
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        std::unordered_set<const std::string*> distinct;
+        for (size_t i = 0; i < names; ++i) {
+            for (size_t t = 1; t < threads; ++t) assert(seen[t][i] == seen[0][i]);
+            assert(*seen[0][i] == "L_thread_name_" + std::to_string(i));
+            distinct.insert(seen[0][i]);
+        }
+        assert(distinct.size() == names);
+        assert(InternedString::pool_size() == before + names && "no name is pooled twice");
+    }
+
+    std::cout << "All interned string tests passed." << std::endl;
+    return 0;
+}
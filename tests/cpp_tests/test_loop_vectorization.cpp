@@ -0,0 +1,219 @@
+// Tests for LoopVectorizationPass (passes/LoopVectorizationPass.cpp).
+//
+// Builds FOR loops in the shape CFGBuilderPass gives them, runs
+// BoundsCheckEliminationPass and then the vectorizer over them, and checks
+// which loops get a NEON body in their preheader and what it holds.
+
+#include <cassert>
+#include <iostream>
+#include "../../passes/BoundsCheckEliminationPass.h"
+#include "../../passes/LoopVectorizationPass.h"
+#include "cfg_test_fixture.h"
+
+bool g_enable_symbols_trace = false;
+
+static ExprPtr elem(const std::string& vector, const std::string& index) {
+    return std::make_unique<VectorAccess>(var(vector), var(index));
+}
+
+// Runs the passes over f in the order main.cpp does
+static void run_passes(CfgFunction& f, bool bounds_checking = true, bool fast_float_reductions = false) {
+    f.run([&](CfgFunction::CfgMap& cfgs) {
+        if (bounds_checking) {
+            BoundsCheckEliminationPass bce(&f.symbols, false);
+            bce.run(cfgs);
+        }
+        LoopVectorizationPass pass(&f.symbols, bounds_checking, false, fast_float_reductions);
+        pass.run(cfgs);
+    });
+}
+
+using Op = BinaryOp::Operator;
+
+int main() {
+    // --- SUM := SUM + v!i over LEN(v): an integer reduction ---
+    {
+        CfgFunction f;
+        f.declare("v", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("sum", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        BasicBlock* preheader = f.for_loop("i", num(0), bin(Op::Subtract, len("v"), num(1)), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(var("sum"), bin(Op::Add, var("sum"), elem("v", "i"))));
+            return b;
+        });
+        run_passes(f);
+        assert(preheader->vectorized_statements.size() == 1 && "array sum is vectorized");
+        if (preheader->vectorized_statements.size() == 1) {
+            const VectorizedStatement& stmt = preheader->vectorized_statements[0];
+            assert(stmt.target == "sum" && stmt.is_reduction && !stmt.is_float && "an integer reduction into sum");
+            assert(dynamic_cast<VectorAccess*>(stmt.value.get()) != nullptr && "the reduction adds v!i");
+        }
+        assert(preheader->vectorized_loop_variable == "i" && preheader->vectorized_loop_end != nullptr && "the NEON loop knows the loop variable and limit");
+    }
+
+    // --- w!i := a!i - w!i + c and d := x!i * y!i + d: element-wise and float (opted in) ---
+    {
+        CfgFunction f;
+        f.declare("a", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("w", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("x", SymbolKind::PARAMETER, VarType::POINTER_TO_FLOAT_VEC);
+        f.declare("y", SymbolKind::PARAMETER, VarType::POINTER_TO_FLOAT_VEC);
+        f.declare("n", SymbolKind::PARAMETER, VarType::INTEGER);
+        f.declare("c", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        f.declare("d", SymbolKind::LOCAL_VAR, VarType::FLOAT);
+        BasicBlock* preheader = f.for_loop("i", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(elem("w", "i"), bin(Op::Add, bin(Op::Subtract, elem("a", "i"), elem("w", "i")), var("c"))));
+            b->add_statement(assign(var("d"), bin(Op::Add, bin(Op::Multiply, elem("x", "i"), elem("y", "i")), var("d"))));
+            return b;
+        });
+        BasicBlock* fill = f.for_loop("j", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(elem("x", "j"), fnum(0.5)));
+            return b;
+        });
+        run_passes(f, true, true);
+        assert(preheader->vectorized_statements.size() == 2 && "element-wise loop is vectorized");
+        if (preheader->vectorized_statements.size() == 2) {
+            const VectorizedStatement& store = preheader->vectorized_statements[0];
+            const VectorizedStatement& dot = preheader->vectorized_statements[1];
+            assert(store.target == "w" && !store.is_reduction && !store.is_float && "first a store to w!i");
+            assert(dot.target == "d" && dot.is_reduction && dot.is_float && "then a float reduction into d");
+            auto* product = dynamic_cast<BinaryOp*>(dot.value.get());
+            assert(product && product->op == Op::Multiply && "the reduction adds x!i * y!i, not d");
+        }
+        assert(fill->vectorized_statements.size() == 1 && fill->vectorized_statements[0].is_float && "x!j := 0.5 fills an FVEC");
+    }
+
+    // --- Float reductions need --fast-float-reductions; float stores do not ---
+    {
+        CfgFunction f;
+        f.declare("x", SymbolKind::PARAMETER, VarType::POINTER_TO_FLOAT_VEC);
+        f.declare("n", SymbolKind::PARAMETER, VarType::INTEGER);
+        f.declare("d", SymbolKind::LOCAL_VAR, VarType::FLOAT);
+        BasicBlock* sum = f.for_loop("i", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(var("d"), bin(Op::Add, var("d"), elem("x", "i"))));
+            return b;
+        });
+        BasicBlock* scale = f.for_loop("j", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(elem("x", "j"), bin(Op::Multiply, elem("x", "j"), fnum(2.0))));
+            return b;
+        });
+        run_passes(f);
+        assert(sum->vectorized_statements.empty() && "a float sum stays scalar by default");
+        assert(scale->vectorized_statements.size() == 1 && "an element-wise float loop is vectorized by default");
+    }
+
+    // --- Without bounds checking, reads need no proof ---
+    {
+        CfgFunction f;
+        f.declare("v", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("n", SymbolKind::PARAMETER, VarType::INTEGER);
+        f.declare("sum", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        BasicBlock* preheader = f.for_loop("i", var("n"), bin(Op::Multiply, var("n"), num(2)), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(var("sum"), bin(Op::Add, var("sum"), elem("v", "i"))));
+            return b;
+        });
+        run_passes(f, false);
+        assert(preheader->vectorized_statements.size() == 1 && "unchecked reads vectorize with bounds checking off");
+    }
+
+    // --- Loops that stay scalar ---
+    {
+        CfgFunction f;
+        f.declare("a", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("w", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("u", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("v", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("q", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("x", SymbolKind::PARAMETER, VarType::POINTER_TO_FLOAT_VEC);
+        f.declare("n", SymbolKind::PARAMETER, VarType::INTEGER);
+        f.declare("s", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        f.declare("t", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        f.declare("c", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        std::vector<std::pair<BasicBlock*, std::string>> scalar;
+
+        scalar.push_back({f.for_loop("i1", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(elem("w", "i1"), bin(Op::Multiply, elem("a", "i1"), elem("a", "i1"))));
+            return b;
+        }), "an integer multiply"});
+        scalar.push_back({f.for_loop("i2", num(0), var("n"), 2, [&](BasicBlock* b) {
+            b->add_statement(assign(elem("w", "i2"), elem("a", "i2")));
+            return b;
+        }), "a step of 2"});
+        scalar.push_back({f.for_loop("i3", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(elem("w", "i3"), var("i3")));
+            return b;
+        }), "the loop variable as a value"});
+        scalar.push_back({f.for_loop("i4", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(elem("w", "i4"), elem("x", "i4")));
+            return b;
+        }), "an FVEC read stored to a VEC"});
+        scalar.push_back({f.for_loop("i5", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(elem("w", "i5"), bin(Op::Add, elem("a", "i5"), num(1))));
+            std::vector<ExprPtr> args;
+            args.push_back(var("n"));
+            b->add_statement(std::make_unique<RoutineCallStatement>(var("WRITEN"), std::move(args)));
+            return b;
+        }), "a call in the body"});
+        scalar.push_back({f.for_loop("i6", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(var("s"), bin(Op::Add, var("s"), elem("a", "i6"))));
+            b->add_statement(assign(var("s"), bin(Op::Add, var("s"), num(1))));
+            return b;
+        }), "a reduction variable assigned twice"});
+        scalar.push_back({f.for_loop("i7", num(0), var("n"), 1, [&](BasicBlock* b) {
+            auto shifted = std::make_unique<VectorAccess>(var("a"), bin(Op::Add, var("i7"), num(1)));
+            b->add_statement(assign(elem("w", "i7"), std::move(shifted)));
+            return b;
+        }), "a read of a!(i + 1)"});
+        scalar.push_back({f.for_loop("i8", num(0), var("c"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(elem("w", "i8"), elem("a", "i8")));
+            b->add_statement(assign(var("c"), bin(Op::Subtract, var("c"), num(1))));
+            return b;
+        }), "a limit that changes"});
+        scalar.push_back({f.for_loop("i9", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(std::make_unique<IfStatement>(var("c"), nullptr));
+            BasicBlock* then_block = f.cfg.create_block("Then_");
+            BasicBlock* join = f.cfg.create_block("Join_");
+            f.cfg.add_edge(b, then_block);
+            f.cfg.add_edge(b, join);
+            then_block->add_statement(assign(elem("w", "i9"), elem("a", "i9")));
+            f.cfg.add_edge(then_block, join);
+            return join;
+        }), "a store under IF"});
+        scalar.push_back({f.for_loop("i10", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(var("t"), bin(Op::Subtract, var("t"), elem("a", "i10"))));
+            return b;
+        }), "a subtracting reduction"});
+        scalar.push_back({f.for_loop("i11", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(elem("w", "i11"), bin(Op::Add, elem("a", "i11"), elem("u", "i11"))));
+            b->add_statement(assign(elem("v", "i11"), bin(Op::Add, elem("q", "i11"), num(1))));
+            return b;
+        }), "more vectors than the NEON loop keeps pointers for"});
+        run_passes(f);
+        for (const auto& loop : scalar) {
+            assert(loop.first->vectorized_statements.empty());
+        }
+    }
+
+    // --- A read that keeps its bounds check stays scalar ---
+    {
+        CfgFunction f;
+        f.declare("v", SymbolKind::PARAMETER, VarType::POINTER_TO_INT_VEC);
+        f.declare("n", SymbolKind::PARAMETER, VarType::INTEGER);
+        f.declare("sum", SymbolKind::LOCAL_VAR, VarType::INTEGER);
+        BasicBlock* preheader = f.for_loop("i", num(0), var("n"), 1, [&](BasicBlock* b) {
+            b->add_statement(assign(var("sum"), bin(Op::Add, var("sum"), elem("v", "i"))));
+            return b;
+        });
+        // Check the read the way an unproven one would be
+        BasicBlock* body = preheader->successors[0]->successors[0];
+        auto* sum_stmt = static_cast<AssignmentStatement*>(body->statements[0].get());
+        auto* read = static_cast<VectorAccess*>(static_cast<BinaryOp*>(sum_stmt->rhs[0].get())->right.get());
+        f.run([&](CfgFunction::CfgMap& cfgs) {
+            LoopVectorizationPass pass(&f.symbols, true, false);
+            pass.run(cfgs);
+        });
+        assert(!read->bounds_check_elided && preheader->vectorized_statements.empty() && "a checked read is left to the scalar loop");
+    }
+
+    std::cout << "All loop vectorization tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,263 @@
+// Test for the ELF object writer.
+//
+// Writes a small program (calls through a veneer and directly to a runtime
+// function, branches, ADRP/ADD to .rodata and .data, 64-bit pointers in
+// data) as an ELF64 object, then reads the object back: checks the headers,
+// places .text/.rodata/.data at the addresses the JIT Linker uses, resolves
+// the symbols, applies the RELA entries with the AArch64 ELF ABI formulas
+// and compares every section byte for byte with Linker::process().
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../../Linker.h"
+#include "../../ObjectWriter.h"
+
+static uint64_t read_le(const std::vector<uint8_t>& bytes, size_t offset, int size) {
+    uint64_t value = 0;
+    for (int i = 0; i < size; ++i) value |= static_cast<uint64_t>(bytes.at(offset + i)) << (8 * i);
+    return value;
+}
+
+static void write_le(std::vector<uint8_t>& bytes, size_t offset, uint64_t value, int size) {
+    for (int i = 0; i < size; ++i) bytes.at(offset + i) = static_cast<uint8_t>(value >> (8 * i));
+}
+
+static uint32_t patch(uint32_t word, uint64_t value, int shift, int width) {
+    uint32_t mask = ((1u << width) - 1) << shift;
+    return (word & ~mask) | ((static_cast<uint32_t>(value) << shift) & mask);
+}
+
+struct Section {
+    std::string name;
+    uint32_t type;
+    uint64_t offset, size;
+    uint32_t link, info;
+};
+
+static Instruction code(uint32_t encoding, const std::string& text,
+                        RelocationType relocation = RelocationType::NONE, const std::string& target = "") {
+    return Instruction(encoding, text, relocation, target, false);
+}
+
+static Instruction data(uint32_t value, SegmentType segment,
+                        RelocationType relocation = RelocationType::NONE, const std::string& target = "") {
+    Instruction instr(value, ".long", relocation, target, true);
+    instr.segment = segment;
+    return instr;
+}
+
+int main() {
+    // Within BL range of the code, so the Linker patches the direct call
+    // rather than adding one of its own veneers.
+    RuntimeManager::instance().register_function("WRITES", 1, reinterpret_cast<void*>(0x0000000101234560ULL));
+
+    // --- The program, as it leaves the peephole optimizer ---
+    std::vector<Instruction> program;
+    program.push_back(Instruction::as_label("START", SegmentType::CODE));
+    program.push_back(code(0xA9BF7BFD, "STP X29, X30, [SP, #-16]!"));
+    program.push_back(code(0x90000000, "ADRP X0, L_str", RelocationType::PAGE_21_BIT_PC_RELATIVE, "L_str"));
+    program.push_back(code(0x91000000, "ADD X0, X0, #:lo12:L_str", RelocationType::ADD_12_BIT_UNSIGNED_OFFSET, "L_str"));
+    program.push_back(code(0x90000001, "ADRP X1, L_table", RelocationType::PAGE_21_BIT_PC_RELATIVE, "L_table"));
+    program.push_back(code(0x91000021, "ADD X1, X1, #:lo12:L_table+8",
+                           RelocationType::ADD_12_BIT_UNSIGNED_OFFSET_PLUS_8, "L_table"));
+    program.push_back(code(0x9000001C, "ADRP X28, L_globals", RelocationType::PAGE_21_BIT_PC_RELATIVE, "L_globals"));
+    program.push_back(code(0x9100039C, "ADD X28, X28, #:lo12:L_globals", RelocationType::ADD_12_BIT_UNSIGNED_OFFSET, "L_globals"));
+    program.push_back(code(0x94000000, "BL WRITES_veneer", RelocationType::PC_RELATIVE_26_BIT_OFFSET, "WRITES_veneer"));
+    program.push_back(code(0x94000000, "BL WRITES", RelocationType::PC_RELATIVE_26_BIT_OFFSET, "WRITES"));
+    program.push_back(Instruction::as_label("L_loop", SegmentType::CODE));
+    program.push_back(code(0xB4000000, "CBZ X0, L_done", RelocationType::PC_RELATIVE_19_BIT_OFFSET, "L_done"));
+    program.push_back(code(0x54000000, "B.EQ L_done", RelocationType::PC_RELATIVE_19_BIT_OFFSET, "L_done"));
+    program.push_back(code(0xD1000400, "SUB X0, X0, #1"));
+    program.push_back(code(0x00000000, "; loop back"));
+    program.push_back(code(0x14000000, "B L_loop", RelocationType::PC_RELATIVE_26_BIT_OFFSET, "L_loop"));
+    program.push_back(Instruction::as_label("L_done", SegmentType::CODE));
+    program.push_back(code(0xA8C17BFD, "LDP X29, X30, [SP], #16"));
+    program.push_back(code(0xD65F03C0, "RET"));
+    program.push_back(Instruction::as_label("WRITES_veneer", SegmentType::CODE));
+    program.push_back(code(0xD2800010, "MOVZ X16, #0", RelocationType::MOVZ_MOVK_IMM_0, "WRITES"));
+    program.push_back(code(0xF2A00010, "MOVK X16, #0, LSL #16", RelocationType::MOVZ_MOVK_IMM_16, "WRITES"));
+    program.push_back(code(0xF2C00010, "MOVK X16, #0, LSL #32", RelocationType::MOVZ_MOVK_IMM_32, "WRITES"));
+    program.push_back(code(0xF2E00010, "MOVK X16, #0, LSL #48", RelocationType::MOVZ_MOVK_IMM_48, "WRITES"));
+    program.push_back(code(0xD61F0200, "BR X16"));
+    program.push_back(Instruction::as_label("L_str", SegmentType::RODATA));
+    program.push_back(data(2, SegmentType::RODATA));
+    program.push_back(data(0x69, SegmentType::RODATA));
+    program.push_back(data(0x21, SegmentType::RODATA));
+    program.push_back(Instruction::as_label("L_table", SegmentType::RODATA));
+    program.push_back(data(0, SegmentType::RODATA, RelocationType::ABSOLUTE_ADDRESS_LO32, "START"));
+    program.push_back(data(0, SegmentType::RODATA, RelocationType::ABSOLUTE_ADDRESS_HI32, "START"));
+    program.push_back(data(0, SegmentType::RODATA, RelocationType::ABSOLUTE_ADDRESS_LO32, "L_done"));
+    program.push_back(data(0, SegmentType::RODATA, RelocationType::ABSOLUTE_ADDRESS_HI32, "L_done"));
+    program.push_back(Instruction::as_label("L_globals", SegmentType::DATA));
+    program.push_back(data(42, SegmentType::DATA));
+    program.push_back(data(0, SegmentType::DATA));
+    program.push_back(data(0, SegmentType::DATA, RelocationType::ABSOLUTE_ADDRESS_LO32, "L_str"));
+    program.push_back(data(0, SegmentType::DATA, RelocationType::ABSOLUTE_ADDRESS_HI32, "L_str"));
+
+    // --- What the JIT runs ---
+    const size_t code_base = 0x0000000100040000ULL;
+    const size_t data_base = 0x0000000200000000ULL;
+    InstructionStream stream(LabelManager::instance(), false);
+    for (const auto& instr : program) stream.add(instr);
+    Linker linker;
+    std::vector<Instruction> linked = linker.process(stream, LabelManager::instance(), RuntimeManager::instance(),
+                                                     code_base, nullptr, reinterpret_cast<void*>(data_base));
+    std::map<std::string, std::vector<uint8_t>> expected;
+    for (const auto& instr : linked) {
+        if (instr.assembly_text.empty() && !instr.is_data_value) continue;
+        const char* name = instr.segment == SegmentType::CODE ? ".text"
+                         : instr.segment == SegmentType::RODATA ? ".rodata" : ".data";
+        std::vector<uint8_t>& bytes = expected[name];
+        bytes.resize(bytes.size() + 4);
+        write_le(bytes, bytes.size() - 4, instr.encoding, 4);
+    }
+    std::map<std::string, uint64_t> base = {
+        { ".text", code_base },
+        { ".rodata", LabelManager::instance().get_label_address("L_str") },
+        { ".data", data_base },
+    };
+
+    // --- The object file ---
+    std::vector<uint8_t> elf = ObjectWriter().build(program);
+    assert(elf.size() > 64 && std::memcmp(elf.data(), "\x7F" "ELF", 4) == 0 && "ELF magic");
+    assert(elf[4] == 2 && elf[5] == 1 && "ELFCLASS64, little-endian");
+    assert(read_le(elf, 16, 2) == 1 && "relocatable object");
+    assert(read_le(elf, 18, 2) == 183 && "AArch64");
+
+    uint64_t shoff = read_le(elf, 40, 8);
+    size_t shnum = read_le(elf, 60, 2);
+    size_t shstrndx = read_le(elf, 62, 2);
+    std::vector<Section> sections(shnum);
+    std::vector<uint32_t> name_offsets(shnum);
+    for (size_t i = 0; i < shnum; ++i) {
+        size_t h = shoff + i * 64;
+        name_offsets[i] = static_cast<uint32_t>(read_le(elf, h, 4));
+        sections[i] = { "", static_cast<uint32_t>(read_le(elf, h + 4, 4)), read_le(elf, h + 24, 8),
+                        read_le(elf, h + 32, 8), static_cast<uint32_t>(read_le(elf, h + 40, 4)),
+                        static_cast<uint32_t>(read_le(elf, h + 44, 4)) };
+    }
+    auto c_string = [&](uint64_t offset) { return std::string(reinterpret_cast<const char*>(&elf.at(offset))); };
+    for (size_t i = 0; i < shnum; ++i) sections[i].name = c_string(sections[shstrndx].offset + name_offsets[i]);
+
+    // Section contents, placed where the Linker puts them
+    std::map<std::string, std::vector<uint8_t>> image;
+    std::vector<uint64_t> section_address(shnum, 0);
+    size_t symtab = 0;
+    for (size_t i = 0; i < shnum; ++i) {
+        const Section& s = sections[i];
+        if (base.count(s.name)) {
+            image[s.name].assign(elf.begin() + s.offset, elf.begin() + s.offset + s.size);
+            section_address[i] = base[s.name];
+        }
+        if (s.type == 2) symtab = i;
+    }
+    assert(symtab != 0 && "symbol table present");
+
+    // Symbols: defined ones at their section's address, undefined ones from the runtime
+    struct Sym { std::string name; uint64_t value; int binding; bool defined; };
+    std::vector<Sym> symbols;
+    for (uint64_t off = sections[symtab].offset; off < sections[symtab].offset + sections[symtab].size; off += 24) {
+        uint32_t name = static_cast<uint32_t>(read_le(elf, off, 4));
+        uint8_t info = elf[off + 4];
+        uint16_t shndx = static_cast<uint16_t>(read_le(elf, off + 6, 2));
+        std::string sym_name = name ? c_string(sections[sections[symtab].link].offset + name) : "";
+        uint64_t value = read_le(elf, off + 8, 8);
+        if (shndx != 0) {
+            symbols.push_back({ sym_name, section_address[shndx] + value, info >> 4, true });
+        } else if (!sym_name.empty()) {
+            bool known = RuntimeManager::instance().is_function_registered(sym_name);
+            assert(known);
+            symbols.push_back({ sym_name, known ? reinterpret_cast<uint64_t>(
+                                                      RuntimeManager::instance().get_function(sym_name).address) : 0,
+                                info >> 4, false });
+        } else {
+            symbols.push_back({ "", 0, 0, true });
+        }
+    }
+    bool start_global = false, writes_undefined = false;
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        if (symbols[i].name == "START") start_global = symbols[i].binding == 1 && symbols[i].defined;
+        if (symbols[i].name == "WRITES") writes_undefined = symbols[i].binding == 1 && !symbols[i].defined;
+        if (i < sections[symtab].info) assert(symbols[i].binding == 0 && "locals precede globals");
+    }
+    assert(start_global && "START is a defined global");
+    assert(writes_undefined && "WRITES is an undefined global");
+
+    // Relocations (AArch64 ELF ABI: S + A, P is the place)
+    size_t relocation_count = 0;
+    for (const Section& s : sections) {
+        if (s.type != 4) continue;
+        const std::string& target = sections[s.info].name;
+        std::vector<uint8_t>& bytes = image[target];
+        for (uint64_t off = s.offset; off < s.offset + s.size; off += 24) {
+            uint64_t r_offset = read_le(elf, off, 8);
+            uint64_t r_info = read_le(elf, off + 8, 8);
+            int64_t addend = static_cast<int64_t>(read_le(elf, off + 16, 8));
+            uint64_t S = symbols.at(r_info >> 32).value;
+            uint64_t P = base[target] + r_offset;
+            uint64_t X = S + addend;
+            uint32_t word = static_cast<uint32_t>(read_le(bytes, r_offset, 4));
+            switch (r_info & 0xFFFFFFFF) {
+                case 257: write_le(bytes, r_offset, X, 8); break;                            // ABS64
+                case 258: write_le(bytes, r_offset, X, 4); break;                            // ABS32
+                case 264: word = patch(word, X, 5, 16); break;                               // MOVW_UABS_G0_NC
+                case 266: word = patch(word, X >> 16, 5, 16); break;                         // MOVW_UABS_G1_NC
+                case 268: word = patch(word, X >> 32, 5, 16); break;                         // MOVW_UABS_G2_NC
+                case 269: word = patch(word, X >> 48, 5, 16); break;                         // MOVW_UABS_G3
+                case 275: {                                                                  // ADR_PREL_PG_HI21
+                    uint64_t pages = ((X & ~0xFFFULL) - (P & ~0xFFFULL)) >> 12;
+                    word = patch(patch(word, pages & 3, 29, 2), pages >> 2, 5, 19);
+                    break;
+                }
+                case 277: word = patch(word, X & 0xFFF, 10, 12); break;                      // ADD_ABS_LO12_NC
+                case 273:                                                                    // LD_PREL_LO19
+                case 280: word = patch(word, (X - P) >> 2, 5, 19); break;                    // CONDBR19
+                case 282:                                                                    // JUMP26
+                case 283: word = patch(word, (X - P) >> 2, 0, 26); break;                    // CALL26
+                default: assert(false);
+            }
+            if ((r_info & 0xFFFFFFFF) != 257 && (r_info & 0xFFFFFFFF) != 258) write_le(bytes, r_offset, word, 4);
+            ++relocation_count;
+        }
+    }
+    // 3 ADRP/ADD pairs, 2 BLs, 3 branches, 4 veneer MOVs and 3 pointers
+    assert(relocation_count == 18);
+
+    for (const auto& section : expected) {
+        const std::vector<uint8_t>& got = image[section.first];
+        assert(got.size() == section.second.size());
+        for (size_t i = 0; i + 4 <= got.size() && i + 4 <= section.second.size(); i += 4) {
+            uint32_t want = static_cast<uint32_t>(read_le(section.second, i, 4));
+            uint32_t have = static_cast<uint32_t>(read_le(got, i, 4));
+            if (want != have) {
+                char buffer[96];
+                std::snprintf(buffer, sizeof(buffer), "%s+0x%zx: linked object 0x%08x, JIT 0x%08x",
+                              section.first.c_str(), i, have, want);
+                assert(false);
+            }
+        }
+    }
+
+    // --- Relocations ELF cannot express are rejected, not dropped ---
+    for (RelocationType relocation : { RelocationType::Jump, RelocationType::Label }) {
+        std::vector<Instruction> bad;
+        bad.push_back(Instruction::as_label("START", SegmentType::CODE));
+        bad.push_back(code(0x14000000, "B L_somewhere", relocation, "L_somewhere"));
+        bool rejected = false;
+        try {
+            ObjectWriter().build(bad);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        assert(rejected);
+    }
+
+    std::cout << "All object writer tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Tests for the peephole optimizer's label check (PeepholeOptimizer.cpp).
+//
+// A pattern is refused any window holding an instruction that names a
+// label: a branch or other reference (a rewrite could drop or retarget it),
+// or a label definition (a rewrite across it would merge code that other
+// branches jump into the middle of). Windows without either are rewritten.
+
+#include <cassert>
+#include <iostream>
+#include "../../PeepholeOptimizer.h"
+#include "../../InstructionStream.h"
+#include "../../LabelManager.h"
+
+static const uint32_t NOP = 0xD503201F;
+
+// Matches "NOP ; drop" followed by any instruction and drops the NOP
+static std::unique_ptr<InstructionPattern> dropMarkedNop() {
+    return std::make_unique<InstructionPattern>(
+        2,
+        [](const std::vector<Instruction>& instrs, size_t pos) -> MatchResult {
+            if (pos + 1 < instrs.size() && instrs[pos].assembly_text == "NOP ; drop") return { true, 2 };
+            return { false, 0 };
+        },
+        [](const std::vector<Instruction>& instrs, size_t pos) -> std::vector<Instruction> {
+            return { instrs[pos + 1] };
+        },
+        "Drop marked NOP");
+}
+
+static size_t countText(const InstructionStream& stream, const std::string& text) {
+    size_t n = 0;
+    for (const auto& instr : stream.get_instructions()) {
+        if (instr.assembly_text == text) n++;
+    }
+    return n;
+}
+
+int main() {
+    // --- A window without labels is rewritten ---
+    {
+        InstructionStream stream(LabelManager::instance(), false);
+        stream.add(Instruction(NOP, "NOP ; drop"));
+        stream.add(Instruction(0xD65F03C0, "RET"));
+        PeepholeOptimizer optimizer;
+        optimizer.addPattern(dropMarkedNop());
+        optimizer.optimize(stream);
+        assert(countText(stream, "NOP ; drop") == 0 && countText(stream, "RET") == 1 && "the NOP is dropped");
+    }
+
+    // --- A window spanning a label definition is left alone ---
+    {
+        InstructionStream stream(LabelManager::instance(), false);
+        stream.add(Instruction(NOP, "NOP ; drop"));
+        stream.define_label("L_peep_target");
+        stream.add(Instruction(0xD65F03C0, "RET"));
+        PeepholeOptimizer optimizer;
+        optimizer.addPattern(dropMarkedNop());
+        optimizer.optimize(stream);
+        assert(countText(stream, "NOP ; drop") == 1 && "a window holding a label definition is not rewritten");
+        assert(stream.size() == 3 && "the label definition survives");
+    }
+
+    // --- A window holding a label reference is left alone ---
+    {
+        InstructionStream stream(LabelManager::instance(), false);
+        stream.add(Instruction(NOP, "NOP ; drop"));
+        stream.add(Instruction(0x14000000, "B L_peep_target", RelocationType::PC_RELATIVE_26_BIT_OFFSET,
+                               "L_peep_target", false));
+        stream.define_label("L_peep_target");
+        PeepholeOptimizer optimizer;
+        optimizer.addPattern(dropMarkedNop());
+        optimizer.optimize(stream);
+        assert(countText(stream, "NOP ; drop") == 1 && "a window with a branch to a label is not rewritten");
+    }
+
+    std::cout << "All peephole label check tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,178 @@
+// Tests for the Preprocessor's include cache (Preprocessor.cpp).
+//
+// A root file GETs a header that GETs a second header. Checks the expanded
+// text, that a second Preprocessor in the same process takes all three
+// files from the in-memory cache, and that changing a header's mtime (at the
+// same size) makes only that header be read again. Then checks the on-disk
+// output cache: an expansion stored by a child process is reused by this
+// one, and a changed header or a newly created file earlier in the search
+// path makes it miss.
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../../Preprocessor.h"
+
+static void write_file(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << text;
+}
+
+// Moves the file's mtime `seconds` into the future, whatever the
+// filesystem's timestamp granularity
+static void touch_forward(const std::string& path, int seconds) {
+    struct stat st;
+    int stat_result = stat(path.c_str(), &st);
+    assert(stat_result == 0);
+    struct timespec times[2];
+    times[0].tv_sec = st.st_atime;
+    times[0].tv_nsec = 0;
+    times[1].tv_sec = st.st_mtime + seconds;
+    times[1].tv_nsec = 0;
+    int touch_result = utimensat(AT_FDCWD, path.c_str(), times, 0);
+    assert(touch_result == 0);
+    (void)stat_result;
+    (void)touch_result;
+}
+
+static int count(const std::string& text, const std::string& what) {
+    int n = 0;
+    for (size_t pos = text.find(what); pos != std::string::npos; pos = text.find(what, pos + 1)) n++;
+    return n;
+}
+
+// Runs a fresh Preprocessor over `root` with debug output on and returns the
+// expanded text; `hits` gets the number of include cache hits it reported and
+// `output_hit` whether it took the whole expansion from `cache_dir`
+static std::string run(const std::string& root, int& hits, const std::string& cache_dir = "",
+                       bool* output_hit = nullptr) {
+    std::ostringstream log;
+    std::streambuf* saved = std::cout.rdbuf(log.rdbuf());
+    Preprocessor preprocessor;
+    preprocessor.enableDebug();
+    preprocessor.setCacheDirectory(cache_dir);
+    std::string text = preprocessor.process(root);
+    std::cout.rdbuf(saved);
+
+    hits = count(log.str(), "Include cache hit");
+    if (output_hit) *output_hit = count(log.str(), "Output cache hit") == 1;
+    return text;
+}
+
+// True if `parts` occur in `text` in this order
+static bool in_order(const std::string& text, std::initializer_list<const char*> parts) {
+    size_t pos = 0;
+    for (const char* part : parts) {
+        pos = text.find(part, pos);
+        if (pos == std::string::npos) return false;
+        pos += std::string(part).size();
+    }
+    return true;
+}
+
+int main() {
+    char dir_template[] = "/tmp/bcpl_preprocessor_XXXXXX";
+    char* made = mkdtemp(dir_template);
+    assert(made != nullptr);
+    std::string dir = made;
+    std::string root = dir + "/main.bcl", outer = dir + "/outer.h", inner = dir + "/inner.h";
+    write_file(root, "LET a = 1\nGET \"outer.h\"\nLET z = 26\n");
+    write_file(outer, "LET b = 2\nGET \"inner.h\"\nLET y = 25\n");
+    write_file(inner, "LET c = 3\n");
+
+    // --- Nested includes expand in place ---
+    int hits = 0;
+    std::string first = run(root, hits);
+    assert(in_order(first, { "LET a = 1", "LET b = 2", "LET c = 3", "LET y = 25", "LET z = 26" }));
+    assert(hits == 0 && "nothing is cached before the first run");
+
+    // --- A second Preprocessor takes every file from the cache ---
+    std::string second = run(root, hits);
+    assert(second == first);
+    assert(hits == 3 && "root, outer and inner are cache hits");
+
+    // --- A changed mtime invalidates only that file ---
+    write_file(inner, "LET c = 4\n"); // same size
+    touch_forward(inner, 10);
+    std::string third = run(root, hits);
+    assert(in_order(third, { "LET b = 2", "LET c = 4", "LET y = 25" }) && "the new inner.h is read");
+    assert(third.find("LET c = 3") == std::string::npos && "the stale inner.h is not used");
+    assert(hits == 2 && "root and outer are still cache hits");
+
+    std::string fourth = run(root, hits);
+    assert(fourth == third && hits == 3 && "the re-read inner.h is cached again");
+
+    // --- A header that shrinks is read again, not faulted on ---
+    write_file(inner, "\n");
+    std::string shrunk = run(root, hits);
+    assert(shrunk.find("LET c = ") == std::string::npos && hits == 2 && "the shrunk inner.h is read again");
+    write_file(inner, "LET c = 4\n");
+
+    // --- The output cache persists across processes ---
+    std::string cache_dir = dir + "/cache";
+    pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        int child_hits = 0;
+        bool child_output_hit = true;
+        run(root, child_hits, cache_dir, &child_output_hit);
+        _exit(child_output_hit ? 1 : 0);
+    }
+    int status = 0;
+    pid_t waited = waitpid(child, &status, 0);
+    assert(waited == child && WIFEXITED(status) && WEXITSTATUS(status) == 0 && "the child stored the expansion");
+
+    bool output_hit = false;
+    std::string from_disk = run(root, hits, cache_dir, &output_hit);
+    assert(output_hit && hits == 0 && "the child's expansion is used without reading any file");
+    std::string expected = run(root, hits);
+    assert(from_disk == expected && "the stored expansion matches a fresh one");
+
+    write_file(inner, "LET c = 5\n"); // same size
+    touch_forward(inner, 20);
+    std::string changed = run(root, hits, cache_dir, &output_hit);
+    assert(!output_hit && changed.find("LET c = 5") != std::string::npos && "a changed header misses");
+    run(root, hits, cache_dir, &output_hit);
+    assert(output_hit && "the new expansion is stored");
+
+    // inner.h is found next to outer.h; a copy appearing in the working
+    // directory, which is searched first, takes over
+    char saved_cwd[PATH_MAX];
+    char* got_cwd = getcwd(saved_cwd, sizeof(saved_cwd));
+    assert(got_cwd != nullptr);
+    std::string shadow_dir = dir + "/work";
+    mkdir(shadow_dir.c_str(), 0700);
+    int changed_dir = chdir(shadow_dir.c_str());
+    assert(changed_dir == 0);
+    run(root, hits, cache_dir, &output_hit);
+    run(root, hits, cache_dir, &output_hit);
+    assert(output_hit && "stored for this working directory");
+    write_file(shadow_dir + "/inner.h", "LET c = 6\n");
+    std::string shadowed = run(root, hits, cache_dir, &output_hit);
+    assert(!output_hit && shadowed.find("LET c = 6") != std::string::npos && "a new file earlier in the search misses");
+    changed_dir = chdir(saved_cwd);
+    assert(changed_dir == 0);
+    (void)got_cwd;
+    (void)changed_dir;
+    (void)waited;
+
+    std::remove((shadow_dir + "/inner.h").c_str());
+    rmdir(shadow_dir.c_str());
+    std::filesystem::remove_all(cache_dir);
+    std::remove(root.c_str());
+    std::remove(outer.c_str());
+    std::remove(inner.c_str());
+    rmdir(dir.c_str());
+
+    std::cout << "All preprocessor cache tests passed." << std::endl;
+    return 0;
+}
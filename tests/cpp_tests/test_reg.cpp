@@ -0,0 +1,74 @@
+// Tests for the typed register value Reg (Reg.h).
+//
+// Checks parsing of every register family, canonical names, class and
+// width queries, that invalid names are rejected, and RegSet membership.
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "../../Reg.h"
+
+static bool throws(const std::string& name) {
+    try {
+        Reg::parse(name);
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    // --- Parsing and canonical names ---
+    assert(Reg::parse("X19") == Reg::x(19));
+    assert(Reg::parse("w0") == Reg::w(0));
+    assert(Reg::parse("sp") == Reg::sp() && Reg::parse("WSP") == Reg::wsp());
+    assert(Reg::parse("xzr") == Reg::xzr() && Reg::parse("WZR") == Reg::wzr());
+    assert(Reg::parse("D3") == Reg::d(3) && Reg::parse("s31") == Reg::s(31));
+    assert(Reg::parse("V0.4S") == Reg::v(0) && "the arrangement suffix is ignored");
+    assert(Reg::parse("q7") == Reg::q(7));
+
+    assert(Reg::x(19).name() == "X19" && Reg::sp().name() == "SP");
+    assert(Reg::wzr().name() == "WZR" && Reg::d(0).name() == "D0");
+    for (unsigned n = 0; n < 31; ++n) {
+        assert(Reg::parse(Reg::x(n).name()) == Reg::x(n));
+        assert(Reg::parse(Reg::w(n).name()) == Reg::w(n));
+    }
+
+    // --- Class, width and number ---
+    assert(Reg::x(5).is_gpr() && Reg::x(5).is_64bit() && Reg::x(5).number() == 5);
+    assert(Reg::w(5).width() == 32 && !Reg::w(5).is_64bit());
+    assert(Reg::sp().is_sp() && Reg::sp().number() == 31 && !Reg::sp().is_zr());
+    assert(Reg::xzr().is_zr() && Reg::xzr().number() == 31);
+    assert(Reg::d(1).reg_class() == RegClass::FP && Reg::s(1).width() == 32);
+    assert(Reg::q(2).reg_class() == RegClass::VEC && Reg::q(2).width() == 128);
+
+    // --- Invalid names ---
+    assert(throws("") && throws("X") && throws("X32") && throws("R0") && throws("spx"));
+    Reg out = Reg::x(1);
+    bool parsed = Reg::try_parse("foo", out);
+    assert(!parsed && out == Reg::x(1) && "a failed parse leaves out alone");
+    parsed = Reg::try_parse("x2", out);
+    assert(parsed && out == Reg::x(2));
+    bool range_error = false;
+    try {
+        Reg::x(32);
+    } catch (const std::invalid_argument&) {
+        range_error = true;
+    }
+    assert(range_error);
+
+    // --- RegSet ---
+    RegSet set;
+    assert(set.empty());
+    set.insert(Reg::x(5));
+    set.insert(Reg::q(31));
+    assert(set.contains(Reg::x(5)) && set.contains(Reg::q(31)));
+    assert(!set.contains(Reg::w(5)) && !set.contains(Reg::d(5)) && "kinds are kept apart");
+    set.erase(Reg::x(5));
+    set.erase(Reg::q(31));
+    assert(set.empty());
+
+    std::cout << "All Reg tests passed." << std::endl;
+    return 0;
+}
@@ -391,13 +391,131 @@ public:
         }
     }
 
+    // Scope-local temporaries: the same tight loop served from the tracked
+    // heap (per-pointer SAMM cleanup) and from the scope region (O(1) reset).
+    bool runScopeRegionTest() {
+        constexpr int ITERATIONS = 20000;
+        constexpr int VECS_PER_ITERATION = 8;
+        constexpr int STRINGS_PER_ITERATION = 4;
+
+        std::cout << "\n=== SCOPE REGION TEST ===" << std::endl;
+        bool ok = true;
+
+        auto run_loop = [&](bool scoped) {
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < ITERATIONS; i++) {
+                hm_.enterScope();
+                for (int v = 0; v < VECS_PER_ITERATION; v++) {
+                    uint64_t* vec = static_cast<uint64_t*>(scoped ? hm_.allocVecScoped(16) : hm_.allocVec(16));
+                    vec[15] = static_cast<uint64_t>(i);
+                    if (scoped && !ScopeRegion::getInstance().owns(vec)) ok = false;
+                }
+                for (int c = 0; c < STRINGS_PER_ITERATION; c++) {
+                    uint32_t* str = static_cast<uint32_t*>(scoped ? hm_.allocStringScoped(24) : hm_.allocString(24));
+                    str[0] = 'A';
+                }
+                hm_.exitScope();
+            }
+            hm_.waitForSAMM();
+            auto end = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double, std::milli>(end - start).count();
+        };
+
+        size_t bytes_before = ScopeRegion::getInstance().getBytesInUse();
+        auto stats_before = hm_.getSAMMStats();
+
+        double tracked_ms = run_loop(false);
+        double region_ms = run_loop(true);
+
+        auto stats_after = hm_.getSAMMStats();
+        uint64_t region_allocs = stats_after.region_allocations - stats_before.region_allocations;
+        uint64_t region_resets = stats_after.region_resets - stats_before.region_resets;
+
+        // free() on region storage is ignored rather than reported
+        size_t double_frees_before = hm_.getDoubleFreeAttempts();
+        hm_.enterScope();
+        void* temp = hm_.allocVecScoped(4);
+        hm_.free(temp);
+        hm_.free(temp);
+        hm_.exitScope();
+
+        std::cout << "  Tracked heap loop: " << tracked_ms << " ms" << std::endl;
+        std::cout << "  Scope region loop: " << region_ms << " ms" << std::endl;
+        std::cout << "  Speedup: " << (tracked_ms / region_ms) << "x" << std::endl;
+        std::cout << "  Region allocations: " << region_allocs << ", resets: " << region_resets << std::endl;
+
+        if (region_allocs != static_cast<uint64_t>(ITERATIONS) * (VECS_PER_ITERATION + STRINGS_PER_ITERATION)) {
+            std::cout << "❌ Scoped allocations did not come from the region" << std::endl;
+            ok = false;
+        }
+        if (region_resets != static_cast<uint64_t>(ITERATIONS)) {
+            std::cout << "❌ Expected one region reset per scope exit" << std::endl;
+            ok = false;
+        }
+        if (ScopeRegion::getInstance().getBytesInUse() != bytes_before) {
+            std::cout << "❌ Region not back to its starting mark" << std::endl;
+            ok = false;
+        }
+        if (hm_.getDoubleFreeAttempts() != double_frees_before) {
+            std::cout << "❌ free() on region storage reported a double free" << std::endl;
+            ok = false;
+        }
+        std::cout << (ok ? "✅ SCOPE REGION TEST PASSED!" : "❌ SCOPE REGION TEST FAILED!") << std::endl;
+        return ok;
+    }
+
+    bool runDoubleFreeTagTest() {
+        constexpr size_t LARGE_VEC_ELEMENTS = 1024; // Past the slab arena, so posix_memalign + heap_blocks_
+
+        std::cout << "\n=== DOUBLE-FREE TAG TEST ===" << std::endl;
+        bool ok = true;
+        bool samm_was_enabled = hm_.isSAMMEnabled();
+        hm_.setSAMMEnabled(false); // Only manual frees in this test
+
+        if (hm_.getBloomFilterMemoryUsage() != 0) {
+            std::cout << "❌ Bloom filter allocated without opting in" << std::endl;
+            ok = false;
+        }
+
+        // A second free of the same block hits its tombstone
+        size_t before = hm_.getDoubleFreeAttempts();
+        void* vec = hm_.allocVec(LARGE_VEC_ELEMENTS);
+        void* str = hm_.allocString(LARGE_VEC_ELEMENTS);
+        hm_.free(vec);
+        hm_.free(str);
+        hm_.free(vec);
+        hm_.free(str);
+        if (hm_.getDoubleFreeAttempts() != before + 2) {
+            std::cout << "❌ Expected 2 double frees, saw " << (hm_.getDoubleFreeAttempts() - before) << std::endl;
+            ok = false;
+        }
+
+        // Reusing a freed address revives the record instead of flagging the new block
+        before = hm_.getDoubleFreeAttempts();
+        for (int i = 0; i < 1000; i++) {
+            void* p = hm_.allocVec(LARGE_VEC_ELEMENTS);
+            hm_.free(p);
+        }
+        if (hm_.getDoubleFreeAttempts() != before) {
+            std::cout << "❌ Address reuse was reported as a double free" << std::endl;
+            ok = false;
+        }
+
+        std::cout << "  Tombstones: " << hm_.getFreedTombstoneCount()
+                  << ", Bloom filter bytes: " << hm_.getBloomFilterMemoryUsage() << std::endl;
+        hm_.setSAMMEnabled(samm_was_enabled);
+        std::cout << (ok ? "✅ DOUBLE-FREE TAG TEST PASSED!" : "❌ DOUBLE-FREE TAG TEST FAILED!") << std::endl;
+        return ok;
+    }
+
     bool run() {
         try {
             setup();
             runStressTest();
             analyzeResults();
             verifyNoDoubleFrees();
-            return true;
+            bool tags_ok = runDoubleFreeTagTest();
+            return runScopeRegionTest() && tags_ok;
         } catch (const std::exception& e) {
             std::cout << "❌ SAMM ROBUSTNESS TEST CRASHED!" << std::endl;
             std::cout << "Exception: " << e.what() << std::endl;
@@ -0,0 +1,208 @@
+// Tests for SPLIT tokens sharing one allocation (bcpl_list_append_tokens in
+// runtime/heap_interface.cpp).
+//
+// Checks random UTF-32 splits against a reference split, that every token
+// is a terminated string with an exact length inside a single block, that
+// only the last token's atom owns the block, and that list copies, frees
+// and resizes leave the shared block to its owner: a shallow copy borrows,
+// a deep copy owns its own strings, and freeing or resizing a token other
+// than through its list does not release its neighbours. A SAMM scope
+// releases the block once, whether or not the list was freed first.
+//
+// Link against runtime/heap_interface.cpp, runtime/runtime_string_ops.cpp,
+// runtime/runtime_c_globals.cpp, the HeapManager sources, SignalSafeUtils.cpp
+// and runtime/runtime_freelist.c.
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../../HeapManager/HeapManager.h"
+#include "../../HeapManager/SlabArena.h"
+#include "../../runtime/runtime.h"
+#include "../../runtime/heap_interface.h"
+#include "../../runtime/string_kernels.h"
+#include "../../runtime/BCPLError.h"
+
+bool g_enable_heap_trace = false;
+
+void* resizeString(void* payload, size_t newNumChars);
+
+// The runtime's allocator, error and compact string hooks, with strings
+// on the HeapManager so that bcpl_free can release them. Only UTF-32
+// strings are split here.
+static int g_errors = 0;
+extern "C" {
+void _BCPL_SET_ERROR(BCPLErrorCode, const char*, const char*) { g_errors++; }
+void* bcpl_alloc_chars(int64_t num_chars) { return HeapManager::getInstance().allocString(num_chars); }
+void bcpl_free(void* ptr) { HeapManager::getInstance().free(ptr); }
+void embedded_fast_bcpl_free_chars(void*) {}
+int bcpl_compact_strings_enabled = 0;
+uint32_t* bcpl_alloc_compact_chars(int64_t) { return nullptr; }
+void bcpl_free_list(void* header_ptr);
+void returnNodeToFreelist_runtime(void* node);
+}
+
+using Chars = std::vector<uint32_t>;
+
+static uint32_t* make_string(const Chars& chars) {
+    uint32_t* s = static_cast<uint32_t*>(bcpl_alloc_chars(static_cast<int64_t>(chars.size())));
+    for (size_t i = 0; i < chars.size(); ++i) s[i] = chars[i];
+    s[chars.size()] = 0;
+    return s;
+}
+
+static std::vector<Chars> reference_split(const Chars& source, const Chars& delimiter) {
+    std::vector<Chars> tokens;
+    if (delimiter.empty()) {
+        for (uint32_t c : source) tokens.push_back({c});
+        return tokens;
+    }
+    size_t start = 0;
+    for (size_t i = 0; i + delimiter.size() <= source.size();) {
+        if (std::equal(delimiter.begin(), delimiter.end(), source.begin() + i)) {
+            tokens.emplace_back(source.begin() + start, source.begin() + i);
+            i += delimiter.size();
+            start = i;
+        } else {
+            ++i;
+        }
+    }
+    tokens.emplace_back(source.begin() + start, source.end());
+    return tokens;
+}
+
+static uint32_t* token_chars(const ListAtom* atom) {
+    return reinterpret_cast<uint32_t*>(static_cast<uint64_t*>(atom->value.ptr_value) + 1);
+}
+
+int main() {
+    std::mt19937 rng(2020);
+
+    // --- Tokens match a reference split and share one block ---
+    for (int trial = 0; trial < 2000; ++trial) {
+        Chars source(rng() % 60), delimiter(rng() % 3);
+        for (auto& c : source) c = 1 + rng() % 3;
+        for (auto& c : delimiter) c = 1 + rng() % 3;
+        uint32_t* s = make_string(source);
+        uint32_t* d = make_string(delimiter);
+        ListHeader* list = BCPL_SPLIT_STRING(s, d);
+        std::vector<Chars> want = reference_split(source, delimiter);
+        assert(list->length == static_cast<int64_t>(want.size()));
+
+        const ListAtom* atom = list->head;
+        uint8_t* block = want.empty() ? nullptr : static_cast<uint8_t*>(list->tail->value.ptr_value);
+        for (size_t i = 0; i < want.size(); ++i, atom = atom->next) {
+            uint32_t* chars = token_chars(atom);
+            size_t len = 0;
+            assert(bcpl_string_exact_length(chars, &len) || reinterpret_cast<uintptr_t>(chars) % 4096 == 0);
+            assert(bcpl_string_length(chars) == want[i].size());
+            assert(Chars(chars, chars + want[i].size()) == want[i] && chars[want[i].size()] == 0);
+            bool last = i + 1 == want.size();
+            assert(atom->pad == (last ? ATOM_OWNS_SPLIT : ATOM_BORROWS_STRING));
+            assert(static_cast<uint8_t*>(atom->value.ptr_value) >= block && "tokens follow the last one");
+        }
+        bcpl_free_list(list);
+        assert(g_errors == 0 && "the block is freed once");
+    }
+
+    // --- Copies ---
+    Chars csv = {'a', ',', 'b', 'b', ',', ',', 'c'};
+    uint32_t* comma = make_string({','});
+    {
+        ListHeader* list = BCPL_SPLIT_STRING(make_string(csv), comma);
+        ListHeader* shallow = BCPL_SHALLOW_COPY_LIST(list);
+        ListHeader* reversed = BCPL_REVERSE_LIST(list);
+        for (ListAtom* a = shallow->head; a; a = a->next) assert(a->pad == ATOM_BORROWS_STRING);
+        for (ListAtom* a = reversed->head; a; a = a->next) assert(a->pad == ATOM_BORROWS_STRING);
+        bcpl_free_list(shallow);
+        bcpl_free_list(reversed);
+        assert(g_errors == 0);
+        assert(bcpl_string_length(token_chars(list->head->next)) == 2 && "the original still has its tokens");
+
+        ListHeader* deep = BCPL_DEEP_COPY_LIST(list);
+        bcpl_free_list(list);
+        assert(g_errors == 0);
+        const char* want[] = {"a", "bb", "", "c"};
+        ListAtom* a = deep->head;
+        for (const char* w : want) {
+            assert(a->pad == ATOM_OWNS_STRING);
+            uint32_t* chars = token_chars(a);
+            size_t n = std::strlen(w);
+            assert(bcpl_string_length(chars) == n);
+            for (size_t i = 0; i < n; ++i) assert(chars[i] == static_cast<uint32_t>(w[i]));
+            a = a->next;
+        }
+        bcpl_free_list(deep);
+        assert(g_errors == 0);
+    }
+
+    // --- Dropping atoms from the front keeps the owner ---
+    {
+        ListHeader* list = BCPL_SPLIT_STRING(make_string(csv), comma);
+        while (list->head != list->tail) {
+            ListAtom* old = list->head;
+            list->head = old->next;
+            list->length--;
+            returnNodeToFreelist_runtime(old);
+        }
+        assert(list->head->pad == ATOM_OWNS_SPLIT);
+        assert(bcpl_string_length(token_chars(list->head)) == 1);
+        bcpl_free_list(list);
+        assert(g_errors == 0);
+    }
+
+    // --- Freeing or resizing one token leaves the block alone ---
+    {
+        ListHeader* list = BCPL_SPLIT_STRING(make_string(csv), comma);
+        uint32_t* bb = token_chars(list->head->next);
+        bcpl_free(bb);
+        assert(g_errors == 1 && "a token after the first is not a block");
+        g_errors = 0;
+        assert(bcpl_string_length(bb) == 2 && bb[0] == 'b');
+        bcpl_free_list(list);
+        assert(g_errors == 0);
+
+        // The same in a slab arena block
+        HeapManager& hm = HeapManager::getInstance();
+        uint32_t* block = static_cast<uint32_t*>(hm.allocString(32));
+        uint32_t* inner = block + 8;
+        inner[0] = 'x';
+        inner[1] = 0;
+        bcpl_string_set_exact_length(inner, 1);
+        hm.free(inner);
+        assert(g_errors == 1);
+        g_errors = 0;
+        uint32_t* grown = static_cast<uint32_t*>(resizeString(inner, 100));
+        assert(grown != inner && grown[0] == 'x' && "resizing copies the token out");
+        assert(inner[0] == 'x' && bcpl_string_length(inner) == 1);
+        hm.free(grown);
+        hm.free(block);
+        assert(g_errors == 0);
+    }
+
+    // --- SAMM releases the block once, with or without the list ---
+    {
+        HeapManager& hm = HeapManager::getInstance();
+        hm.setSAMMEnabled(true);
+        hm.stopBackgroundWorker();
+        hm.enterScope();
+        ListHeader* freed = BCPL_SPLIT_STRING(make_string(csv), comma);
+        bcpl_free_list(freed);
+        ListHeader* kept = BCPL_SPLIT_STRING(make_string(csv), comma);
+        void* block = kept->tail->value.ptr_value;
+        assert(SlabArena::getInstance().blockFor(block) != nullptr);
+        hm.exitScope();
+        hm.waitForSAMM();
+        AllocType type = ALLOC_UNKNOWN;
+        SlabArena::getInstance().blockFor(block, &type);
+        assert(type == ALLOC_FREE && "the scope releases the tokens' block");
+        assert(g_errors == 0);
+    }
+
+    std::cout << "All SPLIT arena tests passed." << std::endl;
+    return 0;
+}
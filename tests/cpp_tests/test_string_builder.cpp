@@ -0,0 +1,251 @@
+// Tests for string builders (SB_NEW, SB_APPEND, SB_APPENDC, SB_APPENDN,
+// SB_CLEAR and SB_STRING in runtime/runtime_string_utils.inc).
+//
+// Builds strings from random pieces of every storage class and checks the
+// result against std::u32string, checks that the string functions read a
+// builder's contents, and that freeing a builder releases its buffer (run
+// under AddressSanitizer for the leak check).
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../../runtime/runtime.h"
+#include "../../runtime/BCPLError.h"
+
+// The runtime's allocators and metrics hooks, reduced to what the string
+// functions need.
+extern "C" {
+void* bcpl_alloc_chars(int64_t num_chars) {
+    uint64_t* block = static_cast<uint64_t*>(std::malloc(sizeof(uint64_t) + (num_chars + 1) * sizeof(uint32_t)));
+    block[0] = num_chars;
+    uint32_t* payload = reinterpret_cast<uint32_t*>(block + 1);
+    payload[num_chars] = 0;
+    return payload;
+}
+void* bcpl_alloc_words(int64_t num_words, const char*, const char*) {
+    uint64_t* block = static_cast<uint64_t*>(std::malloc(sizeof(uint64_t) * (num_words + 1)));
+    block[0] = num_words;
+    return block + 1;
+}
+void update_io_metrics_read(size_t) {}
+void update_io_metrics_write(size_t) {}
+void update_io_metrics_file_opened(void) {}
+void update_io_metrics_file_closed(void) {}
+void bcpl_free(void* ptr) { std::free(static_cast<uint64_t*>(ptr) - 1); }
+void _BCPL_SET_ERROR(BCPLErrorCode, const char*, const char*) {}
+}
+
+#include "../../runtime/runtime_core.inc"
+#include "../../runtime/runtime_string_utils.inc"
+#include "../../runtime/runtime_io.inc"
+#include "../../runtime/runtime_file_api.inc"
+
+// The characters of a string of any class.
+static std::u32string chars_of(const uint32_t* s) {
+    std::u32string out;
+    if (!s) return out;
+    size_t len = bcpl_string_any_length(s);
+    for (size_t i = 0; i < len; ++i) out.push_back(bcpl_string_char_at(s, i));
+    return out;
+}
+
+static uint32_t* wide_string(const std::u32string& chars) {
+    uint32_t* s = static_cast<uint32_t*>(bcpl_alloc_chars(chars.size()));
+    for (size_t i = 0; i < chars.size(); ++i) s[i] = chars[i];
+    return s;
+}
+
+static uint32_t* compact_string(const std::u32string& latin1) {
+    uint32_t* s = bcpl_alloc_compact_chars(latin1.size());
+    for (size_t i = 0; i < latin1.size(); ++i) reinterpret_cast<uint8_t*>(s)[i] = static_cast<uint8_t>(latin1[i]);
+    return s;
+}
+
+// What the heap does when a string block is freed.
+static void free_string(uint32_t* s) {
+    if (!s) return;
+    uint64_t* base = reinterpret_cast<uint64_t*>(s) - 1;
+    bcpl_string_release_promoted(base);
+    std::free(base);
+}
+
+static std::string captured_writes(uint32_t* s) {
+    bcpl_output_flush();
+    std::fflush(stdout);
+    FILE* capture = std::tmpfile();
+    int saved = dup(STDOUT_FILENO);
+    dup2(fileno(capture), STDOUT_FILENO);
+    WRITES(s);
+    bcpl_output_flush();
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    std::string bytes;
+    std::rewind(capture);
+    char buffer[4096];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), capture)) > 0) bytes.append(buffer, n);
+    std::fclose(capture);
+    return bytes;
+}
+
+int main() {
+    std::mt19937 rng(19);
+    const std::u32string pieces[] = {U"", U"a", U"hello, ", U"world", U"café", U"naïve ", U"€", U"😀 ok",
+                                     U"a longer piece of text that crosses the minimum capacity"};
+
+    // --- Random pieces of every class agree with std::u32string ---
+    for (int compact_flag = 0; compact_flag <= 1; ++compact_flag) {
+        bcpl_set_compact_strings(compact_flag);
+        for (int trial = 0; trial < 300; ++trial) {
+            uint32_t* sb = SB_NEW(trial % 3 == 0 ? 0 : rng() % 100);
+            std::u32string expected;
+            int steps = rng() % 60;
+            for (int step = 0; step < steps; ++step) {
+                const std::u32string& piece = pieces[rng() % 9];
+                switch (rng() % 6) {
+                    case 0: {
+                        uint32_t* s = wide_string(piece);
+                        uint32_t* appended = SB_APPEND(sb, s);
+                        assert(appended == sb && "SB_APPEND returns the builder");
+                        free_string(s);
+                        expected += piece;
+                        break;
+                    }
+                    case 1: {
+                        bool latin1 = true;
+                        for (char32_t c : piece) latin1 = latin1 && c <= 0xFF;
+                        uint32_t* s = latin1 ? compact_string(piece) : wide_string(piece);
+                        if (rng() % 2) BCPL_STRING_PROMOTE(s);
+                        SB_APPEND(sb, s);
+                        free_string(s);
+                        expected += piece;
+                        break;
+                    }
+                    case 2: {
+                        char32_t c = piece.empty() ? U'x' : piece[rng() % piece.size()];
+                        SB_APPENDC(sb, c);
+                        expected += c;
+                        break;
+                    }
+                    case 3: {
+                        int64_t n = static_cast<int64_t>(rng()) - 0x7FFFFFFF;
+                        if (step % 7 == 0) n = INT64_MIN;
+                        SB_APPENDN(sb, n);
+                        std::string digits = std::to_string(n);
+                        expected += std::u32string(digits.begin(), digits.end());
+                        break;
+                    }
+                    case 4:
+                        if (expected.size() < 2000) {
+                            SB_APPEND(sb, sb); // a builder appends its own contents
+                            expected += expected;
+                        }
+                        break;
+                    default:
+                        if (rng() % 8 == 0) {
+                            SB_CLEAR(sb);
+                            expected.clear();
+                        }
+                        break;
+                }
+            }
+            std::string what = "trial " + std::to_string(trial) + (compact_flag ? " (compact)" : "");
+            assert(chars_of(sb) == expected);
+            assert(STRLEN(sb) == static_cast<int64_t>(expected.size()));
+
+            uint32_t* result = SB_STRING(sb);
+            assert(chars_of(result) == expected);
+            bool latin1 = true;
+            for (char32_t c : expected) latin1 = latin1 && c <= 0xFF;
+            int expected_class = compact_flag && latin1 ? BCPL_STRING_CLASS_COMPACT : BCPL_STRING_CLASS_UTF32;
+            assert(bcpl_string_class(result) == expected_class);
+            assert(STRCMP(result, sb) == 0);
+            free_string(result);
+            free_string(sb);
+        }
+    }
+    bcpl_set_compact_strings(0);
+
+    // --- The string functions read a builder ---
+    {
+        uint32_t* sb = SB_NEW(0);
+        uint32_t* hello = wide_string(U"Total: ");
+        SB_APPEND(sb, hello);
+        SB_APPENDN(sb, 42);
+        SB_APPENDC(sb, U'é');
+        std::string written = captured_writes(sb);
+        assert(written == "Total: 42\xC3\xA9" && "WRITES of a builder");
+        assert(STRCMP(sb, hello) > 0 && "STRCMP builder against a string");
+        uint32_t* copy = wide_string(U"...............");
+        STRCOPY(copy, sb);
+        assert(chars_of(copy) == U"Total: 42é" && "STRCOPY from a builder");
+
+        uint32_t* result = SB_STRING(sb);
+        SB_APPENDC(sb, U'!');
+        assert(chars_of(result) == U"Total: 42é" && "SB_STRING is a copy");
+        SB_CLEAR(sb);
+        assert(STRLEN(sb) == 0 && chars_of(sb).empty() && "SB_CLEAR");
+        uint32_t* empty = SB_STRING(sb);
+        assert(empty != nullptr && STRLEN(empty) == 0 && "SB_STRING of an empty builder");
+        free_string(empty);
+        free_string(result);
+        free_string(copy);
+        free_string(hello);
+        free_string(sb);
+    }
+
+    // --- Handles that are not builders are left alone ---
+    {
+        uint32_t* s = wide_string(U"plain");
+        uint32_t* appended = SB_APPEND(s, s);
+        uint32_t* appended_char = SB_APPENDC(nullptr, 'x');
+        uint32_t* built = SB_STRING(s);
+        assert(appended == s && chars_of(s) == U"plain" && "SB_APPEND to a plain string");
+        assert(appended_char == nullptr && "SB_APPENDC to NULL");
+        assert(built == nullptr && "SB_STRING of a plain string");
+        uint32_t* sb = SB_NEW(4);
+        uint32_t* appended_null = SB_APPEND(sb, nullptr);
+        assert(appended_null == sb && STRLEN(sb) == 0 && "SB_APPEND of NULL");
+        free_string(sb);
+        free_string(s);
+
+        // A promoted compact string has the builder's class but only the
+        // 8-byte minimum payload; nothing may be read or written past it.
+        bcpl_set_compact_strings(1);
+        uint32_t* promoted = compact_string(U"ab");
+        BCPL_STRING_PROMOTE(promoted);
+        uint32_t* piece = wide_string(U"xyz");
+        uint32_t* after_append = SB_APPEND(promoted, piece);
+        uint32_t* after_char = SB_APPENDC(promoted, 'c');
+        uint32_t* after_number = SB_APPENDN(promoted, 12345);
+        uint32_t* after_clear = SB_CLEAR(promoted);
+        uint32_t* promoted_built = SB_STRING(promoted);
+        assert(after_append == promoted && after_char == promoted && after_number == promoted &&
+               after_clear == promoted && "SB_* return a promoted string unchanged");
+        assert(promoted_built == nullptr && "SB_STRING of a promoted string");
+        assert(chars_of(promoted) == U"ab" && STRLEN(promoted) == 2 && "promoted string keeps its characters");
+        free_string(piece);
+        free_string(promoted);
+        bcpl_set_compact_strings(0);
+    }
+
+    // --- Growth: a large build keeps every character ---
+    {
+        uint32_t* sb = SB_NEW(0);
+        for (int i = 0; i < 100000; ++i) SB_APPENDC(sb, U'a' + i % 26);
+        bool same = STRLEN(sb) == 100000;
+        for (int i = 0; same && i < 100000; ++i) same = bcpl_string_char_at(sb, i) == static_cast<uint32_t>(U'a' + i % 26);
+        assert(same && "100000 appended characters");
+        free_string(sb);
+    }
+
+    std::cout << "All string builder tests passed." << std::endl;
+    return 0;
+}
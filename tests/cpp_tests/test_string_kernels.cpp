@@ -0,0 +1,259 @@
+// Tests for the BCPL string kernels (runtime/string_kernels.h).
+//
+// Checks the length, compare, find and copy kernels against the plain
+// loops STRCMP and SPLIT used before, over many lengths and alignments,
+// that the length prefix only bounds the scan for the terminator unless it
+// is marked exact, that STRCOPY from NULL drops the mark, and that scanning
+// or comparing strings which end at the end of a page does not read the
+// unmapped page after it.
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+#include "../../runtime/runtime.h"
+#include "../../runtime/BCPLError.h"
+
+// The runtime's allocator and metrics hooks, reduced to what STRCOPY needs.
+extern "C" {
+void* bcpl_alloc_chars(int64_t num_chars) {
+    uint64_t* block = static_cast<uint64_t*>(std::malloc(sizeof(uint64_t) + (num_chars + 1) * sizeof(uint32_t)));
+    block[0] = num_chars;
+    uint32_t* payload = reinterpret_cast<uint32_t*>(block + 1);
+    payload[num_chars] = 0;
+    return payload;
+}
+void update_io_metrics_read(size_t) {}
+void update_io_metrics_write(size_t) {}
+void update_io_metrics_file_opened(void) {}
+void update_io_metrics_file_closed(void) {}
+void bcpl_free(void* ptr) { std::free(static_cast<uint64_t*>(ptr) - 1); }
+void _BCPL_SET_ERROR(BCPLErrorCode, const char*, const char*) {}
+}
+
+#include "../../runtime/runtime_core.inc"
+#include "../../runtime/runtime_file_api.inc"
+#include "../../runtime/runtime_io.inc"
+
+static int64_t reference_compare(const uint32_t* a, const uint32_t* b) {
+    size_t i = 0;
+    while (a[i] == b[i]) {
+        if (a[i] == 0) return 0;
+        ++i;
+    }
+    return (int64_t)a[i] - (int64_t)b[i];
+}
+
+static size_t reference_find(const uint32_t* h, size_t hn, const uint32_t* n, size_t nn, size_t from) {
+    for (size_t i = from; i + nn <= hn; ++i) {
+        if (std::memcmp(h + i, n, nn * sizeof(uint32_t)) == 0) return i;
+    }
+    return BCPL_STRING_NOT_FOUND;
+}
+
+// A heap-style string: uint64 length prefix, payload, terminator.
+struct PrefixedString {
+    std::vector<uint64_t> storage;
+    uint32_t* payload() { return reinterpret_cast<uint32_t*>(storage.data() + 1); }
+
+    explicit PrefixedString(const std::vector<uint32_t>& chars) : storage(2 + (chars.size() + 2) / 2, 0) {
+        storage[0] = chars.size();
+        if (!chars.empty()) std::memcpy(payload(), chars.data(), chars.size() * sizeof(uint32_t));
+    }
+};
+
+int main() {
+    std::mt19937 rng(12345);
+    auto random_chars = [&](size_t n, uint32_t alphabet) {
+        std::vector<uint32_t> chars(n);
+        for (auto& c : chars) c = 1 + rng() % alphabet;
+        return chars;
+    };
+
+    // --- Length: prefix and scan agree with the terminator ---
+    for (size_t n = 0; n < 300; ++n) {
+        PrefixedString str(random_chars(n, 0x10FFFF));
+        size_t len = 0;
+        bool trusted = bcpl_string_prefix_bound(str.payload(), &len);
+        assert(trusted && len == n);
+        assert(bcpl_string_length(str.payload()) == n);
+        for (size_t offset = 0; offset < 4 && offset <= n; ++offset) {
+            assert(bcpl_string_scan_length(str.payload() + offset) == n - offset);
+            assert(bcpl_string_length(str.payload() + offset) == n - offset);
+        }
+    }
+    assert(bcpl_string_length(nullptr) == 0 && "null string has length 0");
+
+    // --- Prefixes that are not the length ---
+    {
+        // A buffer allocated for 12 characters holding a 3-character string,
+        // over recycled characters that are not cleared.
+        PrefixedString buffer(random_chars(12, 26));
+        buffer.payload()[3] = 0;
+        assert(bcpl_string_length(buffer.payload()) == 3 && "shorter string in a longer buffer");
+        buffer.payload()[0] = 0;
+        assert(bcpl_string_length(buffer.payload()) == 0 && "empty string in a longer buffer");
+
+        // A vector used as a character buffer: the prefix counts words.
+        std::vector<uint64_t> vec(1 + 8, 0);
+        vec[0] = 8;
+        uint32_t* chars = reinterpret_cast<uint32_t*>(vec.data() + 1);
+        chars[0] = 'a';
+        chars[1] = 'b';
+        assert(bcpl_string_length(chars) == 2 && "vector buffer is scanned");
+
+        // A prefix that disagrees with the terminator.
+        PrefixedString str(random_chars(10, 26));
+        str.storage[0] = 5;
+        assert(bcpl_string_length(str.payload()) == 10 && "short prefix is scanned past");
+        str.storage[0] = uint64_t(1) << 40;
+        assert(bcpl_string_length(str.payload()) == 10 && "huge prefix is ignored");
+    }
+
+    // --- Exact lengths are read, not scanned ---
+    {
+        PrefixedString str(random_chars(10, 26));
+        bcpl_string_set_exact_length(str.payload(), 10);
+        size_t len = 0;
+        assert(bcpl_string_exact_length(str.payload(), &len) && len == 10);
+        assert(bcpl_string_prefix_bound(str.payload(), &len) && len == 10 && "the bound drops the bit");
+        assert(bcpl_string_length(str.payload()) == 10);
+
+        // The payload is not read: a prefix marked exact is believed
+        str.storage[0] = BCPL_STRING_EXACT_LENGTH | 4;
+        assert(bcpl_string_length(str.payload()) == 4);
+
+        // Clearing the mark goes back to scanning
+        str.payload()[3] = 0;
+        bcpl_string_clear_exact_length(str.payload());
+        assert(str.storage[0] == 4 && bcpl_string_length(str.payload()) == 3);
+        bcpl_string_clear_exact_length(str.payload());
+        assert(str.storage[0] == 4 && "a plain prefix is left alone");
+
+        // Words that only look like exact prefixes are not
+        str.storage[0] = BCPL_STRING_EXACT_LENGTH | (uint64_t(1) << 40);
+        assert(!bcpl_string_exact_length(str.payload(), &len));
+        assert(bcpl_string_length(str.payload()) == 3);
+        str.storage[0] = ~uint64_t(0) - 5; // a negative vector element
+        assert(!bcpl_string_exact_length(str.payload(), &len));
+        bcpl_string_clear_exact_length(str.payload());
+        assert(str.storage[0] == ~uint64_t(0) - 5);
+        assert(!bcpl_string_exact_length(str.payload() + 1, &len) && "unaligned");
+
+        // Lengths too long to trust keep a plain prefix
+        bcpl_string_set_exact_length(str.payload(), size_t(1) << 32);
+        assert(str.storage[0] == uint64_t(1) << 32);
+    }
+
+    // --- STRCOPY from NULL empties the string and drops the mark ---
+    {
+        PrefixedString dst(random_chars(10, 26));
+        bcpl_string_set_exact_length(dst.payload(), 10);
+        STRCOPY(dst.payload(), nullptr);
+        size_t len = 0;
+        assert(!bcpl_string_exact_length(dst.payload(), &len) && STRLEN(dst.payload()) == 0 && "STRCOPY(dst, NULL)");
+
+        PrefixedString empty(random_chars(0, 26));
+        bcpl_string_set_exact_length(empty.payload(), 0);
+        STRCOPY(empty.payload(), nullptr);
+        assert(bcpl_string_exact_length(empty.payload(), &len) && len == 0 && "an empty exact string stays exact");
+    }
+
+    // --- Scanning up to the end of a page ---
+    {
+        long page = sysconf(_SC_PAGESIZE);
+        void* region = mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        assert(region != MAP_FAILED && "mmap");
+        if (region != MAP_FAILED) {
+            char* guard = static_cast<char*>(region) + page;
+            mprotect(guard, page, PROT_NONE);
+            for (size_t n = 0; n < 40; ++n) {
+                uint32_t* end = reinterpret_cast<uint32_t*>(guard) - 1; // terminator is the last word
+                uint32_t* s = end - n;
+                for (size_t i = 0; i < n; ++i) s[i] = 'x';
+                *end = 0;
+                assert(bcpl_string_scan_length(s) == n);
+                assert(bcpl_string_length(s) == n);
+            }
+            munmap(region, 2 * page);
+        }
+    }
+
+    // --- Compare ---
+    for (int trial = 0; trial < 5000; ++trial) {
+        size_t n = rng() % 70;
+        std::vector<uint32_t> a = random_chars(n, 3);
+        std::vector<uint32_t> b = a;
+        switch (rng() % 4) {
+            case 0: break;                                                  // equal
+            case 1: if (n) b[rng() % n] = 1 + rng() % 3; break;             // maybe differ
+            case 2: b.resize(rng() % (n + 1)); break;                       // prefix
+            case 3: b.push_back(1 + rng() % 3); break;                      // longer
+        }
+        PrefixedString sa(a), sb(b);
+        int64_t want = reference_compare(sa.payload(), sb.payload());
+        int64_t got = bcpl_string_compare(sa.payload(), a.size(), sb.payload(), b.size());
+        assert(want == got);
+        // The terminated compare, also at every relative alignment
+        size_t shift = rng() % 4;
+        std::vector<uint32_t> shifted(shift + b.size() + 1, 0);
+        std::copy(b.begin(), b.end(), shifted.begin() + shift);
+        int64_t terminated = bcpl_string_compare_terminated(sa.payload(), shifted.data() + shift);
+        assert(want == terminated);
+    }
+
+    // --- A terminated compare stops at the first difference ---
+    {
+        // Both strings run on into the guard page; only a compare that stops
+        // at the difference (or at the end of the page) stays readable.
+        long page = sysconf(_SC_PAGESIZE);
+        void* region = mmap(nullptr, 4 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region != MAP_FAILED) {
+            char* base = static_cast<char*>(region);
+            mprotect(base + page, page, PROT_NONE);
+            mprotect(base + 3 * page, page, PROT_NONE);
+            for (size_t n = 1; n < 40; ++n) {
+                uint32_t* a = reinterpret_cast<uint32_t*>(base + page) - n;
+                uint32_t* b = reinterpret_cast<uint32_t*>(base + 3 * page) - n;
+                for (size_t i = 0; i < n; ++i) a[i] = b[i] = 'x';
+                a[n - 1] = 'y'; // the last word of the page differs; no terminator anywhere
+                int64_t at_end = bcpl_string_compare_terminated(a, b);
+                assert(at_end == 'y' - 'x');
+                a[n - 1] = 0;   // a ends at the end of the page; b runs on
+                int64_t shorter = bcpl_string_compare_terminated(a, b);
+                assert(shorter == -int64_t('x'));
+            }
+            munmap(region, 4 * page);
+        }
+    }
+
+    // --- Find ---
+    for (int trial = 0; trial < 5000; ++trial) {
+        std::vector<uint32_t> hay = random_chars(rng() % 80, 3);
+        std::vector<uint32_t> needle = random_chars(rng() % 4, 3);
+        size_t from = rng() % (hay.size() + 2);
+        size_t want = needle.empty() ? (from <= hay.size() ? from : BCPL_STRING_NOT_FOUND)
+                                     : reference_find(hay.data(), hay.size(), needle.data(), needle.size(), from);
+        size_t got = bcpl_string_find(hay.data(), hay.size(), needle.data(), needle.size(), from);
+        assert(want == got);
+    }
+
+    // --- Copy ---
+    for (size_t n = 0; n < 100; ++n) {
+        PrefixedString src(random_chars(n, 0x10FFFF));
+        std::vector<uint32_t> dst(n + 4, 0xDEADBEEF);
+        bcpl_string_copy(dst.data(), src.payload(), n);
+        assert(std::memcmp(dst.data(), src.payload(), n * sizeof(uint32_t)) == 0 && dst[n] == 0 &&
+              dst[n + 1] == 0xDEADBEEF);
+    }
+
+    std::cout << "All string kernel tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,263 @@
+// Tests for UTF-8 file input (runtime/utf8_decode.h, FILE_READS,
+// FILE_READLINE and SLURP).
+//
+// Checks the one-pass decoder against decode_utf8_char() on valid and
+// malformed input, that a stream decoded through small chunks matches the
+// whole-buffer result wherever the chunk boundaries fall, and reads files
+// back through the runtime functions.
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../runtime/runtime.h"
+#include "../../runtime/BCPLError.h"
+
+// The runtime's allocator and metrics hooks, reduced to what the file API needs.
+extern "C" {
+void* bcpl_alloc_chars(int64_t num_chars) {
+    uint64_t* block = static_cast<uint64_t*>(std::malloc(sizeof(uint64_t) + (num_chars + 1) * sizeof(uint32_t)));
+    block[0] = num_chars;
+    uint32_t* payload = reinterpret_cast<uint32_t*>(block + 1);
+    payload[num_chars] = 0;
+    return payload;
+}
+void update_io_metrics_read(size_t) {}
+void update_io_metrics_write(size_t) {}
+void update_io_metrics_file_opened(void) {}
+void update_io_metrics_file_closed(void) {}
+void bcpl_free(void* ptr) { std::free(static_cast<uint64_t*>(ptr) - 1); }
+void _BCPL_SET_ERROR(BCPLErrorCode, const char*, const char*) {}
+}
+
+#include "../../runtime/runtime_core.inc"
+#include "../../runtime/runtime_file_api.inc"
+#include "../../runtime/runtime_io.inc"
+
+static std::vector<uint32_t> reference_decode(const std::string& bytes) {
+    std::vector<uint32_t> out;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(bytes.data());
+    const unsigned char* end = p + bytes.size();
+    while (p < end) out.push_back(decode_utf8_char(&p, end));
+    return out;
+}
+
+static std::vector<uint32_t> one_pass_decode(const std::string& bytes) {
+    std::vector<uint32_t> out(bytes.size() + 1);
+    size_t consumed = 0;
+    size_t n = bcpl_utf8_decode(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size(), out.data(),
+                                &consumed, 1);
+    out.resize(n);
+    return out;
+}
+
+static std::vector<uint32_t> payload_of(const uint32_t* s) {
+    std::vector<uint32_t> out;
+    if (!s) return out;
+    size_t len = reinterpret_cast<const uint64_t*>(s)[-1];
+    out.assign(s, s + len);
+    return out;
+}
+
+// The characters of a string of any class.
+static std::vector<uint32_t> chars_of(const uint32_t* s) {
+    std::vector<uint32_t> out;
+    if (!s) return out;
+    size_t len = bcpl_string_any_length(s);
+    for (size_t i = 0; i < len; ++i) out.push_back(bcpl_string_char_at(s, i));
+    return out;
+}
+
+static std::vector<uint32_t> codepoints(const std::u32string& text) {
+    return std::vector<uint32_t>(text.begin(), text.end());
+}
+
+static uint32_t* bcpl_string(const std::string& ascii) {
+    uint32_t* s = static_cast<uint32_t*>(bcpl_alloc_chars(ascii.size()));
+    for (size_t i = 0; i < ascii.size(); ++i) s[i] = (unsigned char)ascii[i];
+    return s;
+}
+
+static void write_file(const std::string& path, const std::string& bytes) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), f);
+    std::fclose(f);
+}
+
+int main() {
+    std::mt19937 rng(99);
+    // Pieces of valid and malformed UTF-8.
+    const char* pieces[] = {
+        "a", "hello world, this is ascii text ", "\n", "\r\n", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+        "\x80", "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xC0\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xFF",
+    };
+    auto random_text = [&](size_t pieces_count, bool valid_only) {
+        std::string text;
+        for (size_t i = 0; i < pieces_count; ++i) text += pieces[rng() % (valid_only ? 7 : 15)];
+        return text;
+    };
+
+    // --- One pass agrees with decode_utf8_char ---
+    for (int trial = 0; trial < 3000; ++trial) {
+        std::string text = random_text(rng() % 40, trial % 2 == 0);
+        assert(one_pass_decode(text) == reference_decode(text));
+    }
+
+    // --- Chunked streams agree with the whole buffer ---
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string text = random_text(50 + rng() % 200, trial % 2 == 0);
+        FILE* f = std::tmpfile();
+        std::fwrite(text.data(), 1, text.size(), f);
+        std::rewind(f);
+        size_t chunk_size = 4 + rng() % 40;
+        std::vector<unsigned char> chunk(chunk_size);
+        std::vector<uint32_t> out(text.size() + 1);
+        size_t bytes_read = 0;
+        size_t n = bcpl_utf8_decode_stream(f, text.size(), out.data(), chunk.data(), chunk_size, &bytes_read);
+        std::fclose(f);
+        out.resize(n);
+        assert(bytes_read == text.size() && out == reference_decode(text));
+    }
+
+    // --- FILE_READS, FILE_READLINE and SLURP ---
+    char path_template[] = "/tmp/bcpl_file_input_XXXXXX";
+    int fd = mkstemp(path_template);
+    close(fd);
+    std::string path = path_template;
+    uint32_t* path_str = bcpl_string(path);
+    {
+        std::string text = "first line\nsecond \xE2\x82\xAC line\r\n\nlast line without newline";
+        write_file(path, text);
+        std::vector<uint32_t> slurped = payload_of(SLURP(path_str));
+        assert(slurped == reference_decode(text) && "SLURP");
+
+        uintptr_t handle = FILE_OPEN_READ(path_str);
+        std::vector<uint32_t> line = payload_of(FILE_READLINE(handle));
+        std::vector<uint32_t> rest = payload_of(FILE_READS(handle));
+        assert(line == codepoints(U"first line") && "line 1");
+        assert(rest == reference_decode(text.substr(11)) && "FILE_READS after a line");
+        FILE_CLOSE(handle);
+
+        handle = FILE_OPEN_READ(path_str);
+        std::vector<std::vector<uint32_t>> lines;
+        while (uint32_t* line = FILE_READLINE(handle)) lines.push_back(payload_of(line));
+        FILE_CLOSE(handle);
+        assert(lines.size() == 4 && "four lines");
+        if (lines.size() == 4) {
+            assert(lines[1] == codepoints(U"second € line") && "CRLF line");
+            assert(lines[2].empty() && "empty line");
+            assert(lines[3] == codepoints(U"last line without newline") && "last line");
+        }
+    }
+    {
+        // Lines longer than FILE_READLINE's starting buffer and than a chunk.
+        std::string long_line(3 * BCPL_FILE_CHUNK_SIZE + 17, 'x');
+        long_line[1000] = '\xC3';
+        long_line[1001] = '\xA9';
+        write_file(path, long_line + "\nshort\n");
+        uintptr_t handle = FILE_OPEN_READ(path_str);
+        std::vector<uint32_t> first = payload_of(FILE_READLINE(handle));
+        std::vector<uint32_t> second = payload_of(FILE_READLINE(handle));
+        uint32_t* past_end = FILE_READLINE(handle);
+        assert(first == reference_decode(long_line) && "long line");
+        assert(second == codepoints(U"short") && "line after long line");
+        assert(past_end == nullptr && "end of file");
+        FILE_CLOSE(handle);
+
+        handle = FILE_OPEN_READ(path_str);
+        std::vector<uint32_t> whole = payload_of(FILE_READS(handle));
+        assert(whole == reference_decode(long_line + "\nshort\n") && "FILE_READS multi-chunk");
+        FILE_CLOSE(handle);
+    }
+    {
+        // With compact strings the text is narrowed a chunk at a time. It
+        // stays compact while it is Latin-1 and switches to UTF-32 at the
+        // first wider character, here a euro sign split by a chunk boundary.
+        bcpl_set_compact_strings(1);
+        std::string latin1;
+        for (size_t i = 0; latin1.size() < 3 * BCPL_FILE_CHUNK_SIZE; ++i) latin1 += i % 7 ? "ab" : "\xC3\xA9";
+        std::string wider = latin1;
+        wider.replace(2 * BCPL_FILE_CHUNK_SIZE - 1, 3, "\xE2\x82\xAC");
+
+        write_file(path, latin1);
+        uint32_t* slurped = SLURP(path_str);
+        assert(bcpl_string_class(slurped) == BCPL_STRING_CLASS_COMPACT && chars_of(slurped) == reference_decode(latin1) &&
+               "SLURP compact multi-chunk");
+        uintptr_t handle = FILE_OPEN_READ(path_str);
+        uint32_t* read = FILE_READS(handle);
+        FILE_CLOSE(handle);
+        assert(bcpl_string_class(read) == BCPL_STRING_CLASS_COMPACT && chars_of(read) == reference_decode(latin1) &&
+               "FILE_READS compact multi-chunk");
+
+        write_file(path, wider);
+        slurped = SLURP(path_str);
+        assert(bcpl_string_class(slurped) == BCPL_STRING_CLASS_UTF32 && chars_of(slurped) == reference_decode(wider) &&
+               "SLURP switches to UTF-32 mid-file");
+        handle = FILE_OPEN_READ(path_str);
+        read = FILE_READS(handle);
+        FILE_CLOSE(handle);
+        assert(bcpl_string_class(read) == BCPL_STRING_CLASS_UTF32 && chars_of(read) == reference_decode(wider) &&
+               "FILE_READS switches to UTF-32 mid-file");
+        bcpl_set_compact_strings(0);
+    }
+    {
+        // A NUL byte is part of the line, not its end.
+        write_file(path, std::string("a\0b\nnext\n", 9));
+        uintptr_t handle = FILE_OPEN_READ(path_str);
+        std::vector<uint32_t> with_nul = payload_of(FILE_READLINE(handle));
+        std::vector<uint32_t> next = payload_of(FILE_READLINE(handle));
+        assert(with_nul == std::vector<uint32_t>({'a', 0, 'b'}) && "line with a NUL byte");
+        assert(next == codepoints(U"next") && "line after a NUL byte");
+        FILE_CLOSE(handle);
+    }
+    {
+        // Threads reading different files do not share a line buffer.
+        const int threads = 4, line_count = 2000;
+        std::vector<std::string> paths(threads);
+        for (int t = 0; t < threads; ++t) {
+            char thread_template[] = "/tmp/bcpl_file_input_XXXXXX";
+            close(mkstemp(thread_template));
+            paths[t] = thread_template;
+            std::string text;
+            for (int i = 0; i < line_count; ++i) text += std::to_string(t) + ":" + std::to_string(i) + "\n";
+            write_file(paths[t], text);
+        }
+        std::vector<int> matched(threads, 0);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < threads; ++t) {
+            readers.emplace_back([&, t] {
+                uintptr_t handle = FILE_OPEN_READ(bcpl_string(paths[t]));
+                for (int i = 0; i < line_count; ++i) {
+                    std::string expected = std::to_string(t) + ":" + std::to_string(i);
+                    std::vector<uint32_t> want(expected.begin(), expected.end());
+                    if (payload_of(FILE_READLINE(handle)) == want) matched[t]++;
+                }
+                FILE_CLOSE(handle);
+            });
+        }
+        for (auto& reader : readers) reader.join();
+        for (int t = 0; t < threads; ++t) {
+            assert(matched[t] == line_count && "concurrent FILE_READLINE");
+            std::remove(paths[t].c_str());
+        }
+    }
+    {
+        write_file(path, "");
+        uint32_t* empty = SLURP(path_str);
+        assert(empty != nullptr && payload_of(empty).empty() && "SLURP empty file");
+        uintptr_t handle = FILE_OPEN_READ(path_str);
+        uint32_t* no_line = FILE_READLINE(handle);
+        assert(no_line == nullptr && "FILE_READLINE on empty file");
+        FILE_CLOSE(handle);
+    }
+    std::remove(path.c_str());
+
+    std::cout << "All UTF-8 file input tests passed." << std::endl;
+    return 0;
+}
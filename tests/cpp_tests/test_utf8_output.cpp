@@ -0,0 +1,172 @@
+// Tests for buffered console output (runtime/utf8_encode.h and the output
+// buffer in runtime/runtime_core.inc).
+//
+// Checks the run encoder against a one-code-point-at-a-time reference,
+// including where it stops for '*', '\\' and '%', then sends WRITES, WRITEF,
+// WRITEN and WRITEC output to a temporary file and compares the bytes with
+// what the unbuffered putchar versions printed, including strings longer
+// than the buffer.
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../runtime/runtime.h"
+#include "../../runtime/runtime_core.inc"
+
+static std::string reference_utf8(const std::vector<uint32_t>& chars) {
+    std::string out;
+    for (uint32_t ch : chars) {
+        unsigned char bytes[BCPL_UTF8_MAX_BYTES];
+        size_t n = bcpl_utf8_encode_char(ch, bytes);
+        out.append(reinterpret_cast<char*>(bytes), n);
+    }
+    return out;
+}
+
+// A heap-layout BCPL string: length prefix, code points, terminator.
+struct BcplString {
+    std::vector<uint64_t> storage;
+    explicit BcplString(const std::vector<uint32_t>& chars) : storage(2 + (chars.size() + 2) / 2, 0) {
+        storage[0] = chars.size();
+        if (!chars.empty()) std::memcpy(payload(), chars.data(), chars.size() * sizeof(uint32_t));
+    }
+    explicit BcplString(const std::string& ascii) : BcplString(std::vector<uint32_t>(ascii.begin(), ascii.end())) {}
+    uint32_t* payload() { return reinterpret_cast<uint32_t*>(storage.data() + 1); }
+};
+
+// Runs `body` with stdout sent to a temporary file and returns what it wrote.
+template <typename Body>
+static std::string capture(Body body) {
+    fflush(stdout);
+    FILE* file = tmpfile();
+    int saved = dup(STDOUT_FILENO);
+    dup2(fileno(file), STDOUT_FILENO);
+    body();
+    bcpl_output_flush();
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    std::string text;
+    rewind(file);
+    char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) text.append(chunk, n);
+    fclose(file);
+    return text;
+}
+
+int main() {
+    std::mt19937 rng(2024);
+
+    // --- Run encoder against the reference ---
+    const uint32_t samples[] = {'a', 'Z', ' ', 0x7F, 0x80, 0xE9, 0x7FF, 0x800, 0x20AC, 0xFFFF, 0x10000, 0x1F600};
+    for (int trial = 0; trial < 3000; ++trial) {
+        size_t n = rng() % 64;
+        std::vector<uint32_t> chars(n);
+        bool mostly_ascii = trial % 2 == 0;
+        for (auto& c : chars) {
+            c = mostly_ascii && rng() % 16 != 0 ? 'a' + rng() % 26 : samples[rng() % (sizeof(samples) / sizeof(samples[0]))];
+        }
+        size_t stop = n;
+        if (n > 0 && trial % 3 == 0) {
+            stop = rng() % n;
+            const uint32_t specials[] = {'*', '\\', '%'};
+            chars[stop] = specials[rng() % 3];
+            for (size_t i = 0; i < stop; ++i) {
+                if (bcpl_utf8_is_special(chars[i])) chars[i] = 'x';
+            }
+        }
+        std::vector<unsigned char> out(BCPL_UTF8_MAX_BYTES * n + 1);
+        size_t consumed = 0;
+        size_t bytes = bcpl_utf8_encode_run(chars.data(), n, out.data(), &consumed);
+        std::vector<uint32_t> head(chars.begin(), chars.begin() + stop);
+        assert(consumed == stop);
+        assert(std::string(reinterpret_cast<char*>(out.data()), bytes) == reference_utf8(head));
+    }
+    {
+        unsigned char out[4];
+        size_t negative = bcpl_utf8_encode_char(-1, out);
+        assert((negative == 1 && out[0] == '?') && "negative code point is '?'");
+        size_t past_unicode = bcpl_utf8_encode_char(0x110000, out);
+        assert((past_unicode == 1 && out[0] == '?') && "code point past Unicode is '?'");
+    }
+
+    // --- WRITES escapes and encoding ---
+    {
+        BcplString s("Tab*Tx*Ny\\tz*S100% \\q *");
+        std::string got = capture([&] { WRITES(s.payload()); });
+        assert(got == "Tab\tx\ny\tz 100% \\q *");
+
+        BcplString euro(std::vector<uint32_t>{'c', 0x20AC, 0x1F600, 'd'});
+        got = capture([&] { WRITES(euro.payload()); });
+        assert(got == "c\xE2\x82\xAC\xF0\x9F\x98\x80" "d" && "WRITES UTF-8");
+        got = capture([&] { WRITES(nullptr); });
+        assert(got == "(null)" && "WRITES null");
+
+        // A 0 stored into the middle ends the output there.
+        BcplString cut("abcdef");
+        cut.payload()[3] = 0;
+        got = capture([&] { WRITES(cut.payload()); });
+        assert(got == "abc" && "WRITES stops at first 0");
+    }
+
+    // --- Strings larger than the buffer ---
+    {
+        std::vector<uint32_t> chars(3 * BCPL_OUTPUT_BUFFER_SIZE / 2 + 7);
+        for (size_t i = 0; i < chars.size(); ++i) chars[i] = i % 97 == 0 ? 0xE9 : 'a' + i % 26;
+        BcplString big(chars);
+        std::string got = capture([&] {
+            WRITES(big.payload());
+            WRITES(big.payload());
+        });
+        assert(got == reference_utf8(chars) + reference_utf8(chars) && "WRITES longer than the buffer");
+    }
+
+    // --- WRITEF formatting into the buffer ---
+    {
+        BcplString fmt("%N items, %s at %x*N");
+        BcplString name("widgets");
+        std::string got = capture([&] { WRITEF3(fmt.payload(), -42, (int64_t)name.payload(), 255); });
+        assert(got == "-42 items, widgets at ff\n");
+
+        BcplString percent("100%% done %c");
+        got = capture([&] { WRITEF1(percent.payload(), 0x20AC); });
+        assert(got == "100% done \xE2\x82\xAC");
+
+        double big = 1e300;
+        int64_t bits;
+        std::memcpy(&bits, &big, sizeof(bits));
+        BcplString ffmt("%f");
+        char expected[400];
+        snprintf(expected, sizeof(expected), "%f", big);
+        got = capture([&] {
+            // Nearly fill the buffer first so the long %f has to spill.
+            std::vector<uint32_t> pad(BCPL_OUTPUT_BUFFER_SIZE - 20, 'p');
+            BcplString padding(pad);
+            WRITES(padding.payload());
+            WRITEF1(ffmt.payload(), bits);
+        });
+        assert(got == std::string(BCPL_OUTPUT_BUFFER_SIZE - 20, 'p') + expected && "WRITEF long %f across a flush");
+    }
+
+    // --- WRITEN and WRITEC ---
+    {
+        std::string got = capture([&] {
+            WRITEN(0);
+            WRITEC(' ');
+            WRITEN(INT64_MIN);
+            WRITEC(' ');
+            WRITEN(INT64_MAX);
+            WRITEC(0xE9);
+            WRITEC(-5);
+        });
+        assert(got == "0 -9223372036854775808 9223372036854775807\xC3\xA9?");
+    }
+
+    std::cerr << "All UTF-8 output tests passed." << std::endl;
+    return 0;
+}
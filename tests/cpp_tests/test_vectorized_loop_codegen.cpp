@@ -0,0 +1,217 @@
+// Tests for the code NewCodeGenerator::generate_vectorized_loop emits for
+// FOR loops LoopVectorizationPass marked (NewCodeGenerator.cpp).
+//
+// Compiles an integer sum, an element-wise store and a float dot product and
+// checks the shape of each NEON loop: the guard that sends fewer than two
+// elements to the scalar loop, the alias check between a stored vector and
+// the others, the LDR/STR Q accesses through pointers advanced 16 bytes per
+// pair, the ADDP/FADDP that folds a reduction's lanes, and the write-back of
+// the index to the loop variable before control reaches the scalar loop,
+// which finishes any odd element. The program is compiled with
+// --fast-float-reductions so the dot product is vectorized too.
+
+#include <cassert>
+#include <iostream>
+#include "codegen_test_fixture.h"
+
+static const char* kSource = R"BCPL(
+LET int_sum() = VALOF
+$(
+  LET v = VEC 9
+  LET sum = 0
+  FOR i = 0 TO 9 DO sum := sum + v!i
+  RESULTIS sum
+$)
+
+LET add_into(n) BE
+$(
+  LET a = VEC 9
+  LET w = VEC 9
+  FOR i = 0 TO n DO w!i := a!i + w!i
+$)
+
+LET dot() = VALOF
+$(
+  LET x = FVEC 9
+  LET y = FVEC 9
+  FLET d = 0.0
+  FOR i = 0 TO 9 DO d := d + x!i * y!i
+  RESULTIS d
+$)
+
+LET START() BE
+$(
+  int_sum()
+  add_into(7)
+  dot()
+$)
+)BCPL";
+
+// Index of the definition of exactly `label`, or -1
+static int definition_of(const std::vector<Instruction>& code, const std::string& label) {
+    for (int i = 0; i < static_cast<int>(code.size()); ++i) {
+        if (code[i].is_label_definition && std::string(code[i].target_label) == label) return i;
+    }
+    return -1;
+}
+
+// True if an instruction strictly between `after` and `before` starts with
+// `prefix` and contains every one of `parts`
+static bool between(const std::vector<Instruction>& code, int after, int before, const std::string& prefix,
+                    std::initializer_list<const char*> parts = {}) {
+    int i = find_instruction(code, prefix, parts, after + 1);
+    return i >= 0 && i < before;
+}
+
+// The register operands of a "mnemonic xA, xB..." instruction's text
+static std::vector<std::string> operands(const Instruction& instr) {
+    std::vector<std::string> out;
+    std::string text = normalized_text(instr);
+    size_t pos = text.find(' ');
+    while (pos != std::string::npos) {
+        size_t end = text.find(',', pos + 1);
+        std::string part = text.substr(pos + 1, end == std::string::npos ? std::string::npos : end - pos - 1);
+        while (!part.empty() && part[0] == ' ') part.erase(0, 1);
+        out.push_back(part);
+        pos = end;
+    }
+    return out;
+}
+
+// The pieces of one NEON loop, as instruction indices into its function
+struct VectorLoop {
+    int guard = -1;      // B.GE to `done` when fewer than two elements remain
+    int loop = -1;       // the loop label's definition
+    int back_edge = -1;  // B.LT back to `loop`
+    int done = -1;       // the done label's definition
+    std::string index;   // the index register
+    std::string loop_variable; // the loop variable's register
+};
+
+// Finds the NEON loop in `f` from its first LDR Q
+static VectorLoop find_vector_loop(const std::vector<Instruction>& f) {
+    VectorLoop v;
+    int first_load = find_instruction(f, "ldr q");
+    if (first_load < 0) return v;
+    for (int i = first_load; i >= 0 && v.loop < 0; --i) {
+        if (f[i].is_label_definition) v.loop = i;
+    }
+    if (v.loop < 0) return v;
+    std::string loop_label = f[v.loop].target_label;
+    for (int i = v.loop; i < static_cast<int>(f.size()) && v.back_edge < 0; ++i) {
+        if (normalized_text(f[i]).rfind("b.lt", 0) == 0 && std::string(f[i].target_label) == loop_label) v.back_edge = i;
+    }
+    // The guard is the last B.GE before the loop; its target is `done`
+    for (int i = 0; i < v.loop; ++i) {
+        if (normalized_text(f[i]).rfind("b.ge", 0) == 0) v.guard = i;
+    }
+    if (v.guard < 0) return v;
+    v.done = definition_of(f, f[v.guard].target_label);
+    // The loop starts with MOV index, loop_variable
+    for (int i = v.guard; i >= 0; --i) {
+        if (normalized_text(f[i]).rfind("mov x", 0) == 0) {
+            std::vector<std::string> ops = operands(f[i]);
+            if (ops.size() == 2) {
+                v.index = ops[0];
+                v.loop_variable = ops[1];
+            }
+            break;
+        }
+    }
+    return v;
+}
+
+// True if the loop is well formed: guard, loop, back edge and done in that
+// order, and the index written back to the loop variable just before done
+static bool well_formed(const std::vector<Instruction>& f, const VectorLoop& v) {
+    if (v.guard < 0 || v.loop < 0 || v.back_edge < 0 || v.done < 0) return false;
+    if (!(v.guard < v.loop && v.loop < v.back_edge && v.back_edge < v.done)) return false;
+    std::vector<std::string> ops = operands(f[v.done - 1]);
+    return normalized_text(f[v.done - 1]).rfind("mov ", 0) == 0 && ops.size() == 2 &&
+           ops[0] == v.loop_variable && ops[1] == v.index;
+}
+
+// True if the pair step is there: each pointer and the index advance, then
+// the index is compared before the back edge
+static bool steps_by_pairs(const std::vector<Instruction>& f, const VectorLoop& v) {
+    int pointer_step = find_instruction(f, "add x", { "#16" }, v.loop);
+    int index_step = find_instruction(f, "add " + v.index + ", " + v.index + ", #2", {}, v.loop);
+    int compare = find_instruction(f, "cmp " + v.index + ",", {}, index_step);
+    return pointer_step >= 0 && pointer_step < index_step && index_step < compare && compare == v.back_edge - 1;
+}
+
+// True if control reaches the scalar FOR loop after `done`
+static bool falls_into_scalar_loop(const std::vector<Instruction>& f, const VectorLoop& v) {
+    int branch = find_instruction(f, "b ", {}, v.done);
+    return branch == v.done + 1 && std::string(f[branch].target_label).find("ForHeader") != std::string::npos;
+}
+
+int main() {
+    CodegenOptions options;
+    options.fast_float_reductions = true;
+    std::vector<Instruction> code = compile_to_instructions(kSource, options);
+
+    // --- sum := sum + v!i: integer reduction ---
+    {
+        std::vector<Instruction> f = function_body(code, "int_sum");
+        VectorLoop v = find_vector_loop(f);
+        assert(v.loop >= 0 && "the reduction gets a NEON loop");
+        assert(well_formed(f, v) && "guard, loop, back edge, write-back and done in order");
+        assert(steps_by_pairs(f, v) && "pointers step 16 bytes and the index 2 per iteration");
+        assert(falls_into_scalar_loop(f, v) && "the scalar loop finishes the odd element");
+        assert(between(f, v.guard, v.loop, "dup v", { "xzr" }) && "the partial sums start at zero");
+        assert(between(f, v.loop, v.back_edge, "ldr q") && "the elements are loaded as Q pairs");
+        assert(between(f, v.loop, v.back_edge, "add v", { ".2d" }) && "the pair is added to the partial sums");
+        int fold = find_instruction(f, "addp v", { ".2d" }, v.back_edge);
+        assert(fold > v.back_edge && fold < v.done && "ADDP folds the two lanes after the loop");
+        assert(between(f, fold, v.done, "fmov x") && "the folded sum moves to an X register");
+        assert(!between(f, v.guard, v.loop, "sub x") && "nothing is stored, so no alias check");
+        assert(find_instruction(f, "str q") < 0 && "a reduction stores nothing");
+    }
+
+    // --- w!i := a!i + w!i: element-wise store ---
+    {
+        std::vector<Instruction> f = function_body(code, "add_into");
+        VectorLoop v = find_vector_loop(f);
+        assert(v.loop >= 0 && "the store gets a NEON loop");
+        assert(well_formed(f, v) && "guard, loop, back edge, write-back and done in order");
+        assert(steps_by_pairs(f, v) && "pointers step 16 bytes and the index 2 per iteration");
+        assert(falls_into_scalar_loop(f, v) && "the scalar loop finishes the odd element");
+
+        // w and a one element apart, either way round, go to the scalar loop
+        int checks = 0;
+        for (int i = find_instruction(f, "sub x", {}, v.guard); i >= 0 && i < v.loop; i = find_instruction(f, "sub x", {}, i + 1)) {
+            bool compares = normalized_text(f[i + 1]).rfind("cmp", 0) == 0 && normalized_text(f[i + 1]).find("#8") != std::string::npos;
+            bool bails = normalized_text(f[i + 2]).rfind("b.eq", 0) == 0 && f[i + 2].target_label == f[v.guard].target_label;
+            if (compares && bails) checks++;
+        }
+        assert(checks == 2 && "the alias check compares the pointers 8 bytes apart both ways");
+
+        int load = find_instruction(f, "ldr q", { "#0]" }, v.loop);
+        int store = find_instruction(f, "str q", { "#0]" }, v.loop);
+        assert(load > v.loop && store > load && store < v.back_edge && "loads, then a store, inside the loop");
+        assert(between(f, load, store, "ldr q") && "both elements are loaded as Q pairs");
+        assert(between(f, load, store, "add v", { ".2d" }) && "the pairs are added");
+        assert(find_instruction(f, "addp") < 0 && "no reduction to fold");
+    }
+
+    // --- d := d + x!i * y!i: float reduction ---
+    {
+        std::vector<Instruction> f = function_body(code, "dot");
+        VectorLoop v = find_vector_loop(f);
+        assert(v.loop >= 0 && "the dot product gets a NEON loop");
+        assert(well_formed(f, v) && "guard, loop, back edge, write-back and done in order");
+        assert(falls_into_scalar_loop(f, v) && "the scalar loop finishes the odd element");
+        assert(between(f, v.loop, v.back_edge, "ldr q") && "the elements are loaded as Q pairs");
+        int product = find_instruction(f, "fmul v", { ".2d" }, v.loop);
+        assert(product > v.loop && product < v.back_edge && "the pairs are multiplied");
+        assert(between(f, product, v.back_edge, "fadd v", { ".2d" }) && "the products are added to the partial sums");
+        int fold = find_instruction(f, "faddp v", { ".2d" }, v.back_edge);
+        assert(fold > v.back_edge && fold < v.done && "FADDP folds the two lanes after the loop");
+        assert(between(f, fold, v.done, "fadd d") && "the folded sum is added to d");
+        assert(!between(f, v.guard, v.loop, "sub x") && "nothing is stored, so no alias check");
+    }
+
+    std::cout << "All vectorized loop codegen tests passed." << std::endl;
+    return 0;
+}